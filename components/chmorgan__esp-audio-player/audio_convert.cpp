@@ -0,0 +1,218 @@
+#include <string.h>
+#include "audio_convert.h"
+
+/** 32-bit view of the 16-bit sample buffers, may_alias keeps the mixed accesses well defined */
+typedef uint32_t __attribute__((__may_alias__)) sample_pair_t;
+
+static inline int16_t saturate16(int32_t v) {
+    if(v > INT16_MAX) return INT16_MAX;
+    if(v < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(v);
+}
+
+static inline int16_t scale16(int16_t s, uint16_t gain) {
+    // 32767 * 65535 still fits in an int32
+    return saturate16((static_cast<int32_t>(s) * gain) >> 15);
+}
+
+static inline int16_t scale32(int32_t s, uint16_t gain) {
+    // high word of a 32x32 multiply, a single mulsh on xtensa
+    return saturate16(static_cast<int32_t>((static_cast<int64_t>(s) * (static_cast<int32_t>(gain) << 1)) >> 32));
+}
+
+static inline int32_t load_s24(const uint8_t *p) {
+    return static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 8) |
+                                (static_cast<uint32_t>(p[1]) << 16) |
+                                (static_cast<uint32_t>(p[2]) << 24));
+}
+
+/** left in the low half word, matching the little endian sample order */
+static inline uint32_t pack(int16_t left, int16_t right) {
+    return static_cast<uint16_t>(left) | (static_cast<uint32_t>(static_cast<uint16_t>(right)) << 16);
+}
+
+static inline bool is_word_aligned(const void *p) {
+    return (reinterpret_cast<uintptr_t>(p) & 3) == 0;
+}
+
+void audio_convert_mono_to_stereo(int16_t *dst, const int16_t *src, size_t frames, uint16_t gain)
+{
+    if(!is_word_aligned(dst)) {
+        audio_convert_mono_to_stereo_ref(dst, src, frames, gain);
+        return;
+    }
+
+    // each output frame is one 32-bit word, work from the end so dst may overlap src
+    sample_pair_t *out = static_cast<sample_pair_t*>(__builtin_assume_aligned(dst, 4)) + frames;
+    const int16_t *in = src + frames;
+
+    if(gain == AUDIO_CONVERT_GAIN_UNITY) {
+        while(frames >= 2) {
+            uint32_t s1 = static_cast<uint16_t>(in[-1]);
+            uint32_t s0 = static_cast<uint16_t>(in[-2]);
+            out[-1] = s1 * 0x00010001u;
+            out[-2] = s0 * 0x00010001u;
+            in -= 2;
+            out -= 2;
+            frames -= 2;
+        }
+    } else {
+        while(frames >= 2) {
+            uint32_t s1 = static_cast<uint16_t>(scale16(in[-1], gain));
+            uint32_t s0 = static_cast<uint16_t>(scale16(in[-2], gain));
+            out[-1] = s1 * 0x00010001u;
+            out[-2] = s0 * 0x00010001u;
+            in -= 2;
+            out -= 2;
+            frames -= 2;
+        }
+    }
+
+    if(frames) {
+        uint32_t s = static_cast<uint16_t>(scale16(in[-1], gain));
+        out[-1] = s * 0x00010001u;
+    }
+}
+
+void audio_convert_gain(int16_t *buf, size_t samples, uint16_t gain)
+{
+    if(gain == AUDIO_CONVERT_GAIN_UNITY || samples == 0) {
+        return;
+    }
+
+    if(!is_word_aligned(buf)) {
+        *buf = scale16(*buf, gain);
+        buf++;
+        samples--;
+    }
+
+    sample_pair_t *words = static_cast<sample_pair_t*>(__builtin_assume_aligned(buf, 4));
+    size_t pairs = samples / 2;
+    while(pairs--) {
+        uint32_t w = *words;
+        *words++ = pack(scale16(static_cast<int16_t>(w), gain),
+                        scale16(static_cast<int16_t>(w >> 16), gain));
+    }
+
+    if(samples & 1) {
+        buf[samples - 1] = scale16(buf[samples - 1], gain);
+    }
+}
+
+void audio_convert_s24_to_s16(int16_t *dst, const uint8_t *src, size_t samples, uint16_t gain)
+{
+    if(!is_word_aligned(dst)) {
+        audio_convert_s24_to_s16_ref(dst, src, samples, gain);
+        return;
+    }
+
+    // both samples are read before the word is written, dst never overtakes src
+    sample_pair_t *out = static_cast<sample_pair_t*>(__builtin_assume_aligned(dst, 4));
+    size_t pairs = samples / 2;
+    while(pairs--) {
+        int32_t s0 = load_s24(src);
+        int32_t s1 = load_s24(src + 3);
+        *out++ = pack(scale32(s0, gain), scale32(s1, gain));
+        src += 6;
+    }
+
+    if(samples & 1) {
+        dst[samples - 1] = scale32(load_s24(src), gain);
+    }
+}
+
+void audio_convert_s32_to_s16(int16_t *dst, const int32_t *src, size_t samples, uint16_t gain)
+{
+    if(!is_word_aligned(dst)) {
+        audio_convert_s32_to_s16_ref(dst, src, samples, gain);
+        return;
+    }
+
+    sample_pair_t *out = static_cast<sample_pair_t*>(__builtin_assume_aligned(dst, 4));
+    size_t pairs = samples / 2;
+    while(pairs--) {
+        int32_t s0 = src[0];
+        int32_t s1 = src[1];
+        *out++ = pack(scale32(s0, gain), scale32(s1, gain));
+        src += 2;
+    }
+
+    if(samples & 1) {
+        dst[samples - 1] = scale32(*src, gain);
+    }
+}
+
+void audio_convert_interleave(int16_t *dst, const int16_t *left, const int16_t *right, size_t frames)
+{
+    if(!is_word_aligned(dst)) {
+        audio_convert_interleave_ref(dst, left, right, frames);
+        return;
+    }
+
+    sample_pair_t *out = static_cast<sample_pair_t*>(__builtin_assume_aligned(dst, 4));
+    while(frames--) {
+        *out++ = pack(*left++, *right++);
+    }
+}
+
+void audio_convert_deinterleave(int16_t *left, int16_t *right, const int16_t *src, size_t frames)
+{
+    if(!is_word_aligned(src)) {
+        audio_convert_deinterleave_ref(left, right, src, frames);
+        return;
+    }
+
+    const sample_pair_t *in = static_cast<const sample_pair_t*>(__builtin_assume_aligned(src, 4));
+    while(frames--) {
+        uint32_t w = *in++;
+        *left++ = static_cast<int16_t>(w);
+        *right++ = static_cast<int16_t>(w >> 16);
+    }
+}
+
+void audio_convert_mono_to_stereo_ref(int16_t *dst, const int16_t *src, size_t frames, uint16_t gain)
+{
+    while(frames) {
+        frames--;
+        int16_t s = scale16(src[frames], gain);
+        dst[frames * 2 + 1] = s;
+        dst[frames * 2] = s;
+    }
+}
+
+void audio_convert_gain_ref(int16_t *buf, size_t samples, uint16_t gain)
+{
+    for(size_t n = 0; n < samples; n++) {
+        buf[n] = scale16(buf[n], gain);
+    }
+}
+
+void audio_convert_s24_to_s16_ref(int16_t *dst, const uint8_t *src, size_t samples, uint16_t gain)
+{
+    for(size_t n = 0; n < samples; n++) {
+        dst[n] = scale32(load_s24(src + n * 3), gain);
+    }
+}
+
+void audio_convert_s32_to_s16_ref(int16_t *dst, const int32_t *src, size_t samples, uint16_t gain)
+{
+    for(size_t n = 0; n < samples; n++) {
+        dst[n] = scale32(src[n], gain);
+    }
+}
+
+void audio_convert_interleave_ref(int16_t *dst, const int16_t *left, const int16_t *right, size_t frames)
+{
+    for(size_t n = 0; n < frames; n++) {
+        dst[n * 2] = left[n];
+        dst[n * 2 + 1] = right[n];
+    }
+}
+
+void audio_convert_deinterleave_ref(int16_t *left, int16_t *right, const int16_t *src, size_t frames)
+{
+    for(size_t n = 0; n < frames; n++) {
+        left[n] = src[n * 2];
+        right[n] = src[n * 2 + 1];
+    }
+}
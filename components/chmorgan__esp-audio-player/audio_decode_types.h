@@ -32,14 +32,11 @@ typedef struct {
      */
     uint8_t *samples;
 
-    /** capacity of samples */
-    size_t samples_capacity;
-
     /**
-     * 2x samples_capacity to allow for in-place conversion of
-     * mono to stereo
+     * capacity of samples in bytes, one decoded frame once converted to
+     * stereo 16-bit, so mono is converted in place without spare room
      */
-    size_t samples_capacity_max;
+    size_t samples_capacity;
 
     /**
      * Number of frames in samples,
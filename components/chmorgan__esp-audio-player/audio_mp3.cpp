@@ -4,14 +4,27 @@
 
 static const char *TAG = "mp3";
 
-bool is_mp3(FILE *fp) {
+bool is_mp3(FILE *fp, mp3_metadata_t *metadata) {
     bool is_mp3_file = false;
 
-    fseek(fp, 0, SEEK_SET);
+    // step over any ID3v2 tags in one seek, rather than leaving the decoder to
+    // drop them a buffer at a time while searching for a sync word
+    uint32_t audio_offset;
+    if(metadata) {
+        mp3_metadata_read(fp, metadata);
+        audio_offset = metadata->audio_offset;
+    } else {
+        audio_offset = mp3_metadata_skip_id3v2(fp);
+    }
+
+    fseek(fp, audio_offset, SEEK_SET);
 
     // see https://en.wikipedia.org/wiki/List_of_file_signatures
-    uint8_t magic[3];
-    if(sizeof(magic) == fread(magic, 1, sizeof(magic), fp)) {
+    uint8_t magic[2];
+    if(audio_offset > 0) {
+        // an ID3v2 tag is enough, the first frame may be preceded by padding
+        is_mp3_file = true;
+    } else if(sizeof(magic) == fread(magic, 1, sizeof(magic), fp)) {
         if((magic[0] == 0xFF) &&
             (magic[1] == 0xFB))
         {
@@ -24,25 +37,12 @@ bool is_mp3(FILE *fp) {
                   (magic[1] == 0xF2))
         {
             is_mp3_file = true;
-        } else if((magic[0] == 0x49) &&
-                  (magic[1] == 0x44) &&
-                  (magic[2] == 0x33)) /* 'ID3' */
-        {
-            fseek(fp, 0, SEEK_SET);
-
-            /* Get ID3 head */
-            mp3_id3_header_v2_t tag;
-            if (sizeof(mp3_id3_header_v2_t) == fread(&tag, 1, sizeof(mp3_id3_header_v2_t), fp)) {
-                if (memcmp("ID3", (const void *) &tag, sizeof(tag.header)) == 0) {
-                    is_mp3_file = true;
-                }
-            }
         }
     }
 
-    // seek back to the start of the file to avoid
+    // seek back to the start of the audio to avoid
     // missing frames upon decode
-    fseek(fp, 0, SEEK_SET);
+    fseek(fp, audio_offset, SEEK_SET);
 
     return is_mp3_file;
 }
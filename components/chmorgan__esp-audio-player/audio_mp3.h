@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include "audio_decode_types.h"
 #include "mp3dec.h"
+#include "mp3_metadata.h"
 
 typedef struct {
     char header[3];     /*!< Always "TAG" */
@@ -44,5 +45,11 @@ typedef struct {
     bool eof_reached;
 } mp3_instance;
 
-bool is_mp3(FILE *fp);
+/**
+ * @brief Check for an mp3 file and skip its ID3v2 tags
+ *
+ * @param metadata - [out] optional, title, artist and album from the tags, NULL to only skip them
+ * @return true if the file is an mp3, the file is left positioned at the first byte after the tags
+ */
+bool is_mp3(FILE *fp, mp3_metadata_t *metadata);
 DECODE_STATUS decode_mp3(HMP3Decoder mp3_decoder, FILE *fp, decode_data *pData, mp3_instance *pInstance);
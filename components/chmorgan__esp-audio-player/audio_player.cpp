@@ -31,6 +31,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 
 #include "sdkconfig.h"
 
@@ -38,15 +39,31 @@
 
 #include "audio_wav.h"
 #include "audio_mp3.h"
+#include "audio_resample.h"
+#include "audio_convert.h"
+#include "esp_timer.h"
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
+#include "mp3_index.h"
+#endif
 
 static const char *TAG = "audio";
 
+/** frames decoded and dropped ahead of a seek target to refill the bit reservoir */
+#define AUDIO_PLAYER_SEEK_PREROLL_FRAMES    2
+
+/**
+ * frame headers a seek may walk when the seek table is a constant bitrate guess, about
+ * 100s at 44.1kHz, further seeks wait for audio_player_set_mp3_index()
+ */
+#define AUDIO_PLAYER_SEEK_WALK_MAX_FRAMES   4096
+
 typedef enum {
     AUDIO_PLAYER_REQUEST_NONE = 0,
     AUDIO_PLAYER_REQUEST_PAUSE,              /**< pause playback */
     AUDIO_PLAYER_REQUEST_RESUME,             /**< resumed paused playback */
     AUDIO_PLAYER_REQUEST_PLAY,               /**< initiate playing a new file */
     AUDIO_PLAYER_REQUEST_STOP,               /**< stop playback */
+    AUDIO_PLAYER_REQUEST_SEEK,               /**< reposition playback */
     AUDIO_PLAYER_REQUEST_SHUTDOWN_THREAD,    /**< shutdown audio playback thread */
     AUDIO_PLAYER_REQUEST_MAX
 } audio_player_event_type_t;
@@ -56,6 +73,9 @@ typedef struct {
 
     // valid if type == AUDIO_PLAYER_EVENT_TYPE_PLAY
     FILE* fp;
+
+    // valid if type == AUDIO_PLAYER_REQUEST_SEEK
+    uint32_t position_ms;
 } audio_player_event_t;
 
 typedef enum {
@@ -86,6 +106,19 @@ typedef struct audio_instance {
 
     audio_player_config_t config;
 
+    /** Q15 output gain, applied while converting decoded samples to stereo 16-bit */
+    volatile uint16_t gain;
+
+    /** samples per channel played from the current file, at position_rate */
+    volatile uint32_t position_samples;
+    volatile uint32_t position_rate;
+
+    /** decoded frames to drop after a seek, they only refill the bit reservoir */
+    uint32_t discard_frames;
+
+    /** when the last seek started, 0 once its first samples have been written */
+    int64_t seek_start_us;
+
 #if defined(CONFIG_AUDIO_PLAYER_ENABLE_WAV)
     wav_instance wav_data;
 #endif
@@ -93,6 +126,40 @@ typedef struct audio_instance {
 #if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
     HMP3Decoder mp3_decoder;
     mp3_instance mp3_data;
+
+    /**
+     * seek table from the Xing/VBRI header, or a constant bitrate estimate, until an
+     * exact one is handed over with audio_player_set_mp3_index()
+     */
+    mp3_index_t mp3_index;
+
+    /**
+     * offsets of the table entries of an estimated mp3_index that have been reached by
+     * walking frame headers, so they are exact, 0 where not known yet
+     */
+    uint32_t mp3_walked[MP3_INDEX_MAX_ENTRIES];
+
+    /** from audio_player_set_mp3_index(), taken up by the audio task if pending_index_fp is playing */
+    SemaphoreHandle_t pending_index_lock;
+    FILE *pending_index_fp;
+    mp3_index_t pending_index;
+
+    /** tags of the current file */
+    mp3_metadata_t mp3_metadata;
+#endif
+
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+    /**
+     * Format the i2s peripheral was last configured with, kept across files
+     * so the clock is only configured once
+     */
+    format i2s_format;
+
+    audio_resampler_t resampler;
+
+    /** stereo 16-bit frames at CONFIG_AUDIO_PLAYER_OUTPUT_SAMPLE_RATE */
+    int16_t *resample_buf;
+    size_t resample_buf_frames;
 #endif
 } audio_instance_t;
 
@@ -191,45 +258,290 @@ static void audio_instance_init(audio_instance_t &i) {
     i.s_audio_cb = NULL;
     i.audio_cb_usrt_ctx = NULL;
     i.state = AUDIO_PLAYER_STATE_IDLE;
+    i.gain = AUDIO_CONVERT_GAIN_UNITY;
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
+    i.pending_index_lock = NULL;
+    i.pending_index_fp = NULL;
+#endif
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+    memset(&i.i2s_format, 0, sizeof(i.i2s_format));
+#endif
+}
+
+/**
+ * Convert decoded samples in place to stereo 16-bit, applying the output gain in the
+ * same pass as the conversion.
+ */
+static esp_err_t convert_output(decode_data &adata, uint16_t gain)
+{
+    size_t sample_count = adata.frame_count * adata.fmt.channels;
+    int16_t *samples = reinterpret_cast<int16_t*>(adata.samples);
+
+    switch(adata.fmt.bits_per_sample) {
+        case 16:
+            break;
+        case 24:
+            audio_convert_s24_to_s16(samples, adata.samples, sample_count, gain);
+            gain = AUDIO_CONVERT_GAIN_UNITY;
+            break;
+        case 32:
+            audio_convert_s32_to_s16(samples, reinterpret_cast<int32_t*>(adata.samples), sample_count, gain);
+            gain = AUDIO_CONVERT_GAIN_UNITY;
+            break;
+        default:
+            ESP_LOGE(TAG, "unsupported bits per sample %d", (int)adata.fmt.bits_per_sample);
+            return ESP_ERR_NOT_SUPPORTED;
+    }
+    adata.fmt.bits_per_sample = 16;
+
+    // if mono, convert to stereo as es8311 requires stereo input
+    // even though it is mono output
+    if(adata.fmt.channels == 1) {
+        LOGI_3("c == 1, mono -> stereo");
+
+        // do we have enough space in the output buffer to convert mono to stereo?
+        size_t data = adata.frame_count * 2 * sizeof(int16_t);
+        if(data > adata.samples_capacity) {
+            ESP_LOGE(TAG, "insufficient space in output.samples to convert mono to stereo, need %d, have %d", data, adata.samples_capacity);
+            return ESP_ERR_NO_MEM;
+        }
+
+        audio_convert_mono_to_stereo(samples, samples, adata.frame_count, gain);
+        adata.fmt.channels = 2;
+    } else {
+        audio_convert_gain(samples, sample_count, gain);
+    }
+
+    return ESP_OK;
+}
+
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+/**
+ * Convert the decoded stereo 16-bit frames in i->output to the fixed output rate and
+ * write them to i2s, configuring the i2s clock the first time through.
+ */
+static esp_err_t write_resampled(audio_instance_t *i)
+{
+    esp_err_t ret = ESP_OK;
+    decode_data &adata = i->output;
+
+    if((i->i2s_format.sample_rate != CONFIG_AUDIO_PLAYER_OUTPUT_SAMPLE_RATE) ||
+       (i->i2s_format.bits_per_sample != 16) ||
+       (i->i2s_format.channels != 2)) {
+        LOGI_1("configuring fixed output: sr=%d", CONFIG_AUDIO_PLAYER_OUTPUT_SAMPLE_RATE);
+        ret = i->config.clk_set_fn(CONFIG_AUDIO_PLAYER_OUTPUT_SAMPLE_RATE, 16, I2S_SLOT_MODE_STEREO);
+        ESP_RETURN_ON_ERROR(ret, TAG, "i2s_set_clk");
+
+        i->i2s_format.sample_rate = CONFIG_AUDIO_PLAYER_OUTPUT_SAMPLE_RATE;
+        i->i2s_format.bits_per_sample = 16;
+        i->i2s_format.channels = 2;
+    }
+
+    ret = audio_resampler_set_input_rate(&i->resampler, adata.fmt.sample_rate);
+    ESP_RETURN_ON_ERROR(ret, TAG, "resampler %d Hz", adata.fmt.sample_rate);
+
+    size_t i2s_bytes_written = 0;
+
+    if(audio_resampler_is_passthrough(&i->resampler)) {
+        size_t bytes_to_write = adata.frame_count * 2 * sizeof(int16_t);
+        i->config.write_fn(adata.samples, bytes_to_write, &i2s_bytes_written, portMAX_DELAY);
+        if(bytes_to_write != i2s_bytes_written) {
+            ESP_LOGE(TAG, "to write %d != written %d", bytes_to_write, i2s_bytes_written);
+        }
+        return ESP_OK;
+    }
+
+    const int16_t *in = reinterpret_cast<int16_t*>(adata.samples);
+    size_t remaining = adata.frame_count;
+    while(remaining) {
+        size_t consumed = remaining;
+        size_t produced = audio_resampler_process(&i->resampler, in, &consumed,
+                                                  i->resample_buf, i->resample_buf_frames);
+        in += consumed * 2;
+        remaining -= consumed;
+
+        if(produced) {
+            size_t bytes_to_write = produced * 2 * sizeof(int16_t);
+            i->config.write_fn(i->resample_buf, bytes_to_write, &i2s_bytes_written, portMAX_DELAY);
+            if(bytes_to_write != i2s_bytes_written) {
+                ESP_LOGE(TAG, "to write %d != written %d", bytes_to_write, i2s_bytes_written);
+            }
+        }
+    }
+
+    return ESP_OK;
+}
+#endif
+
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
+/**
+ * Take up an exact index handed over for fp, see audio_player_set_mp3_index()
+ */
+static void adopt_mp3_index(audio_instance_t *i, FILE *fp)
+{
+    if(!i->pending_index_lock) {
+        return;
+    }
+
+    xSemaphoreTake(i->pending_index_lock, portMAX_DELAY);
+    if(i->pending_index_fp == fp) {
+        i->mp3_index = i->pending_index;
+        i->pending_index_fp = NULL;
+        LOGI_1("exact index, %d frames", (int)i->mp3_index.total_frames);
+    }
+    xSemaphoreGive(i->pending_index_lock);
 }
 
-static esp_err_t mono_to_stereo(uint32_t output_bits_per_sample, decode_data &adata)
+/**
+ * Offset of frame 'wanted' when the seek table is only a constant bitrate estimate.
+ *
+ * Frame headers are walked from the closest table entry already reached this way, the first
+ * frame being one, and every entry passed is recorded so later seeks start closer. The frame
+ * reached is exact, fewer than wanted at the end of the stream.
+ *
+ * @return UINT32_MAX if no frame was found or the walk would be longer than
+ *         AUDIO_PLAYER_SEEK_WALK_MAX_FRAMES
+ */
+static uint32_t walk_to_frame(audio_instance_t *i, FILE *fp, uint32_t wanted, uint32_t *reached)
 {
-    size_t data = adata.frame_count * (output_bits_per_sample / BITS_PER_BYTE);
-    data *= 2;
+    const mp3_index_t &index = i->mp3_index;
+    const uint32_t per_entry = index.frames_per_entry;
+
+    uint32_t entry = wanted / per_entry;
+    if(entry >= index.entry_count) {
+        entry = index.entry_count - 1;
+    }
+    while(entry > 0 && i->mp3_walked[entry] == 0) {
+        entry--;
+    }
 
-    // do we have enough space in the output buffer to convert mono to stereo?
-    if(data > adata.samples_capacity_max) {
-        ESP_LOGE(TAG, "insufficient space in output.samples to convert mono to stereo, need %d, have %d", data, adata.samples_capacity_max);
-        return ESP_ERR_NO_MEM;
+    uint32_t frame = entry * per_entry;
+    uint32_t offset = (entry == 0) ? index.audio_start : i->mp3_walked[entry];
+    *reached = frame;
+    if(wanted - frame > AUDIO_PLAYER_SEEK_WALK_MAX_FRAMES) {
+        ESP_LOGW(TAG, "frame %d is %d frames from the nearest known offset, no exact index yet",
+                 (int)wanted, (int)(wanted - frame));
+        return UINT32_MAX;
     }
 
-    size_t new_sample_count = adata.frame_count * 2;
-
-    // convert from back to front to allow conversion in-place
-    //
-    // NOTE: -1 is because we want to shift to the sample at position X
-    //       but if we do (ptr + X) we end up at the sample at index X instead
-    //       which is one further
-    int16_t *out = reinterpret_cast<int16_t*>(adata.samples) + (new_sample_count - 1);
-    int16_t *in = reinterpret_cast<int16_t*>(adata.samples) + (adata.frame_count - 1);
-    size_t samples = adata.frame_count;
-    while(samples) {
-        // write right channel
-        *out = *in;
-        out--;
-
-        // write left channel
-        *out = *in;
-        out--;
-
-        // move input buffer back and decrement samples
-        in--;
-        samples--;
+    while(frame < wanted) {
+        uint32_t next_entry = frame / per_entry + 1;
+        uint32_t stop = (next_entry * per_entry < wanted) ? next_entry * per_entry : wanted;
+        uint32_t asked = stop - frame;
+        uint32_t skip = asked;
+        offset = mp3_index_skip_frames(fp, offset, &skip, i->mp3_data.data_buf, i->mp3_data.data_buf_size);
+        if(offset == UINT32_MAX) {
+            return UINT32_MAX;
+        }
+        frame += skip;
+        if(skip < asked) {
+            break;
+        }
+        if((frame == next_entry * per_entry) && (next_entry < index.entry_count)) {
+            i->mp3_walked[next_entry] = offset;
+        }
+    }
+
+    *reached = frame;
+    return offset;
+}
+#endif
+
+/**
+ * Reposition fp so that the next samples written are those at position_ms.
+ *
+ * MP3 decoding restarts AUDIO_PLAYER_SEEK_PREROLL_FRAMES before the target frame with the
+ * bit reservoir flushed, the preroll frames are decoded but not played so the target frame
+ * has the main data it refers back to.
+ */
+static esp_err_t seek_file(audio_instance_t *i, FILE *fp, FILE_TYPE file_type, uint32_t position_ms)
+{
+    i->seek_start_us = esp_timer_get_time();
+
+    switch(file_type) {
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
+        case FILE_TYPE_MP3: {
+            adopt_mp3_index(i, fp);
+            const mp3_index_t &index = i->mp3_index;
+            ESP_RETURN_ON_FALSE(index.total_frames != 0, ESP_ERR_NOT_SUPPORTED, TAG, "no mp3 index");
+
+            uint32_t target = static_cast<uint64_t>(position_ms) * index.sample_rate /
+                              (1000ULL * index.samples_per_frame);
+            if(target >= index.total_frames) {
+                target = index.total_frames - 1;
+            }
+            uint32_t first = (target > AUDIO_PLAYER_SEEK_PREROLL_FRAMES) ? target - AUDIO_PLAYER_SEEK_PREROLL_FRAMES : 0;
+
+            // headers are walked in data_buf, decoding carries on from here if no frame is found
+            size_t unread = i->mp3_data.bytes_in_data_buf - (i->mp3_data.read_ptr - i->mp3_data.data_buf);
+            uint32_t resume = static_cast<uint32_t>(ftell(fp) - static_cast<long>(unread));
+
+            uint32_t frame;
+            uint32_t offset;
+            if(index.source == MP3_INDEX_SOURCE_ESTIMATE) {
+                // the table is a guess, only a walk from a known frame says which frame an offset holds
+                offset = walk_to_frame(i, fp, first, &frame);
+            } else {
+                // walk frame headers from the table entry to the first preroll frame
+                offset = mp3_index_seek(&index, position_ms, &frame);
+                uint32_t skip = (first > frame) ? first - frame : 0;
+                offset = mp3_index_skip_frames(fp, offset, &skip, i->mp3_data.data_buf, i->mp3_data.data_buf_size);
+                frame += skip;
+            }
+            bool found = (offset != UINT32_MAX);
+            if(!found) {
+                ESP_LOGW(TAG, "no frame near %d ms", (int)position_ms);
+                offset = resume;
+            } else if(target > frame + AUDIO_PLAYER_SEEK_PREROLL_FRAMES) {
+                // the stream ended early, play from where the walk stopped
+                target = frame;
+            }
+
+            ESP_RETURN_ON_FALSE(fseek(fp, offset, SEEK_SET) == 0, ESP_FAIL, TAG, "fseek %d", (int)offset);
+
+            // drop buffered data from the old position along with the bit reservoir
+            i->mp3_data.bytes_in_data_buf = 0;
+            i->mp3_data.read_ptr = i->mp3_data.data_buf;
+            i->mp3_data.eof_reached = false;
+            MP3ResetDecoder(i->mp3_decoder);
+            if(!found) {
+                return ESP_ERR_NOT_FOUND;
+            }
+
+            i->discard_frames = (target > frame) ? target - frame : 0;
+            i->position_samples = target * index.samples_per_frame;
+            i->position_rate = index.sample_rate;
+            LOGI_1("seek %d ms: frame %d at %d, preroll %d", (int)position_ms, (int)target, (int)offset, (int)i->discard_frames);
+            break;
+        }
+#endif
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_WAV)
+        case FILE_TYPE_WAV: {
+            const wav_header_t &header = i->wav_data.header;
+            ESP_RETURN_ON_FALSE(header.BlockAlign > 0, ESP_ERR_NOT_SUPPORTED, TAG, "bad wav block align");
+
+            uint32_t frames = i->wav_data.data_size / header.BlockAlign;
+            uint32_t frame = static_cast<uint64_t>(position_ms) * header.SampleRate / 1000;
+            if(frame > frames) {
+                frame = frames;
+            }
+
+            ESP_RETURN_ON_FALSE(fseek(fp, i->wav_data.data_offset + frame * header.BlockAlign, SEEK_SET) == 0,
+                ESP_FAIL, TAG, "fseek");
+
+            i->discard_frames = 0;
+            i->position_samples = frame;
+            i->position_rate = header.SampleRate;
+            break;
+        }
+#endif
+        default:
+            return ESP_ERR_NOT_SUPPORTED;
     }
 
-    // adjust channels to 2
-    adata.fmt.channels = 2;
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+    audio_resampler_reset(&i->resampler);
+#endif
 
     return ESP_OK;
 }
@@ -244,10 +556,13 @@ static esp_err_t aplay_file(audio_instance_t *i, FILE *fp)
     esp_err_t ret = ESP_OK;
     audio_player_event_t audio_event = { .type = AUDIO_PLAYER_REQUEST_NONE, .fp = NULL };
 
+    /** cleared once the first samples have been written */
+    int64_t start_us = esp_timer_get_time();
+
     FILE_TYPE file_type = FILE_TYPE_UNKNOWN;
 
 #if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
-    if(is_mp3(fp)) {
+    if(is_mp3(fp, &i->mp3_metadata)) {
         file_type = FILE_TYPE_MP3;
         LOGI_1("file is mp3");
 
@@ -255,6 +570,16 @@ static esp_err_t aplay_file(audio_instance_t *i, FILE *fp)
         i->mp3_data.bytes_in_data_buf = 0;
         i->mp3_data.read_ptr = i->mp3_data.data_buf;
         i->mp3_data.eof_reached = false;
+
+        // only the first frame is read, an exact index may follow from audio_player_set_mp3_index()
+        if(mp3_index_build_from_header(fp, &i->mp3_index) != ESP_OK) {
+            memset(&i->mp3_index, 0, sizeof(i->mp3_index));
+        }
+        memset(i->mp3_walked, 0, sizeof(i->mp3_walked));
+        adopt_mp3_index(i, fp);
+        fseek(fp, i->mp3_metadata.audio_offset, SEEK_SET);
+    } else {
+        memset(&i->mp3_metadata, 0, sizeof(i->mp3_metadata));
     }
 #endif
 
@@ -277,6 +602,16 @@ static esp_err_t aplay_file(audio_instance_t *i, FILE *fp)
         goto clean_up;
     }
 
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+    // don't carry the tail of the previous file into this one
+    audio_resampler_reset(&i->resampler);
+#endif
+
+    i->position_samples = 0;
+    i->position_rate = 0;
+    i->discard_frames = 0;
+    i->seek_start_us = 0;
+
     do {
         /* Process audio event sent from other task */
         if (pdPASS == xQueuePeek(i->event_queue, &audio_event, 0)) {
@@ -292,7 +627,13 @@ static esp_err_t aplay_file(audio_instance_t *i, FILE *fp)
                 while(1) {
                     xQueuePeek(i->event_queue, &audio_event, portMAX_DELAY);
 
-                    if((AUDIO_PLAYER_REQUEST_PLAY != audio_event.type) &&
+                    if(AUDIO_PLAYER_REQUEST_SEEK == audio_event.type) {
+                        // reposition now and stay paused, resume plays from the new position
+                        xQueueReceive(i->event_queue, &audio_event, 0);
+                        if(seek_file(i, fp, file_type, audio_event.position_ms) != ESP_OK) {
+                            ESP_LOGW(TAG, "seek to %d ms ignored", (int)audio_event.position_ms);
+                        }
+                    } else if((AUDIO_PLAYER_REQUEST_PLAY != audio_event.type) &&
                        (AUDIO_PLAYER_REQUEST_STOP != audio_event.type) &&
                        (AUDIO_PLAYER_REQUEST_RESUME != audio_event.type))
                     {
@@ -313,6 +654,14 @@ static esp_err_t aplay_file(audio_instance_t *i, FILE *fp)
                 // handle the other event types
             }
 
+            if(AUDIO_PLAYER_REQUEST_SEEK == audio_event.type) {
+                xQueueReceive(i->event_queue, &audio_event, 0);
+                if(seek_file(i, fp, file_type, audio_event.position_ms) != ESP_OK) {
+                    ESP_LOGW(TAG, "seek to %d ms ignored", (int)audio_event.position_ms);
+                }
+                continue;
+            }
+
             if ((AUDIO_PLAYER_REQUEST_STOP == audio_event.type) ||
                 (AUDIO_PLAYER_REQUEST_PLAY == audio_event.type)) {
                 ret = ESP_OK;
@@ -346,18 +695,23 @@ static esp_err_t aplay_file(audio_instance_t *i, FILE *fp)
         }
 
         // break out and exit if we aren't supposed to continue decoding
-        if(decode_status == DECODE_STATUS_CONTINUE)
+        if((decode_status == DECODE_STATUS_CONTINUE) && i->discard_frames) {
+            i->discard_frames--;
+        } else if(decode_status == DECODE_STATUS_CONTINUE)
         {
-            // if mono, convert to stereo as es8311 requires stereo input
-            // even though it is mono output
-            if(i->output.fmt.channels ==  1) {
-                LOGI_3("c == 1, mono -> stereo");
-                ret = mono_to_stereo(i->output.fmt.bits_per_sample, i->output);
-                if(ret != ESP_OK) {
-                    goto clean_up;
-                }
+            i->position_rate = i->output.fmt.sample_rate;
+
+            ret = convert_output(i->output, i->gain);
+            if(ret != ESP_OK) {
+                goto clean_up;
             }
 
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+            ret = write_resampled(i);
+            ESP_GOTO_ON_ERROR(ret, clean_up, TAG, "write_resampled");
+            // i2s_format is unused when the output rate is fixed
+            (void)i2s_format;
+#else
             /* Configure I2S clock if the output format changed */
             if ((i2s_format.sample_rate != i->output.fmt.sample_rate) ||
                     (i2s_format.channels != i->output.fmt.channels) ||
@@ -392,9 +746,26 @@ static esp_err_t aplay_file(audio_instance_t *i, FILE *fp)
             if(bytes_to_write != i2s_bytes_written) {
                 ESP_LOGE(TAG, "to write %d != written %d", bytes_to_write, i2s_bytes_written);
             }
+#endif
+
+            i->position_samples += i->output.frame_count;
+
+            if(i->seek_start_us) {
+                LOGI_1("seek latency %d us", (int)(esp_timer_get_time() - i->seek_start_us));
+                i->seek_start_us = 0;
+            }
+            if(start_us) {
+                LOGI_1("first samples %d us after the start of the file", (int)(esp_timer_get_time() - start_us));
+                start_us = 0;
+            }
         } else if(decode_status == DECODE_STATUS_NO_DATA_CONTINUE)
         {
             LOGI_2("no data");
+
+            // a frame that underflowed the freshly flushed bit reservoir
+            if(i->discard_frames) {
+                i->discard_frames--;
+            }
         } else { // DECODE_STATUS_DONE || DECODE_STATUS_ERROR
             LOGI_1("breaking out of playback");
             break;
@@ -459,6 +830,16 @@ static void audio_task(void *pvParam)
         }
         i->config.mute_fn(AUDIO_PLAYER_MUTE);
 
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
+        // an index still pending for this file must not be taken up by a file reusing the FILE
+        if(audio_event.fp && i->pending_index_lock) {
+            xSemaphoreTake(i->pending_index_lock, portMAX_DELAY);
+            if(i->pending_index_fp == audio_event.fp) {
+                i->pending_index_fp = NULL;
+            }
+            xSemaphoreGive(i->pending_index_lock);
+        }
+#endif
         if(audio_event.fp) fclose(audio_event.fp);
     }
 }
@@ -504,6 +885,72 @@ esp_err_t audio_player_stop(void)
     return audio_send_event(&instance, event);
 }
 
+esp_err_t audio_player_seek(uint32_t position_ms)
+{
+    LOGI_1("%s", __FUNCTION__);
+    audio_player_event_t event = { .type = AUDIO_PLAYER_REQUEST_SEEK, .fp = NULL, .position_ms = position_ms };
+    return audio_send_event(&instance, event);
+}
+
+esp_err_t audio_player_set_mp3_index(FILE *fp, const mp3_index_t *index)
+{
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
+    ESP_RETURN_ON_FALSE(!fp || (index && index->total_frames), ESP_ERR_INVALID_ARG, TAG, "no index");
+    ESP_RETURN_ON_FALSE(NULL != instance.pending_index_lock, ESP_ERR_INVALID_STATE,
+        TAG, "Audio task not started yet");
+
+    // copied, the audio task takes it up at the start of the file or the next seek
+    xSemaphoreTake(instance.pending_index_lock, portMAX_DELAY);
+    if(fp) {
+        instance.pending_index = *index;
+    }
+    instance.pending_index_fp = fp;
+    xSemaphoreGive(instance.pending_index_lock);
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t audio_player_get_position(uint32_t *samples, uint32_t *sample_rate)
+{
+    ESP_RETURN_ON_FALSE(samples && sample_rate, ESP_ERR_INVALID_ARG, TAG, "null argument");
+
+    // the audio task may be between updating the two, read until they are consistent
+    uint32_t rate;
+    do {
+        rate = instance.position_rate;
+        *samples = instance.position_samples;
+    } while(rate != instance.position_rate);
+    *sample_rate = rate;
+
+    return (rate != 0) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t audio_player_get_metadata(mp3_metadata_t *metadata)
+{
+    ESP_RETURN_ON_FALSE(metadata, ESP_ERR_INVALID_ARG, TAG, "null argument");
+
+#if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
+    *metadata = instance.mp3_metadata;
+    if(metadata->title[0] || metadata->artist[0] || metadata->album[0]) {
+        return ESP_OK;
+    }
+#else
+    memset(metadata, 0, sizeof(*metadata));
+#endif
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t audio_player_set_gain(uint16_t gain)
+{
+    // a single 16-bit store, picked up by the audio task on the next decoded frame
+    instance.gain = gain;
+    return ESP_OK;
+}
+
 /**
  * Can only shut down the playback thread if the thread is not presently playing audio.
  * Call audio_player_stop()
@@ -520,8 +967,14 @@ static void cleanup_memory(audio_instance_t &i)
 #if defined(CONFIG_AUDIO_PLAYER_ENABLE_MP3)
     if(i.mp3_decoder) MP3FreeDecoder(i.mp3_decoder);
     if(i.mp3_data.data_buf) free(i.mp3_data.data_buf);
+    if(i.pending_index_lock) vSemaphoreDelete(i.pending_index_lock);
+    i.pending_index_lock = NULL;
 #endif
     if(i.output.samples) free(i.output.samples);
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+    if(i.resample_buf) free(i.resample_buf);
+    audio_resampler_free(&i.resampler);
+#endif
 
     vQueueDelete(i.event_queue);
 }
@@ -539,10 +992,9 @@ esp_err_t audio_player_new(audio_player_config_t config)
     ESP_RETURN_ON_FALSE(NULL != instance.event_queue, -1, TAG, "xQueueCreate");
 
     /** See https://github.com/ultraembedded/libhelix-mp3/blob/0a0e0673f82bc6804e5a3ddb15fb6efdcde747cd/testwrap/main.c#L74 */
-    instance.output.samples_capacity = MAX_NCHAN * MAX_NGRAN * MAX_NSAMP;
-    instance.output.samples_capacity_max = instance.output.samples_capacity * 2;
-    instance.output.samples = static_cast<uint8_t*>(malloc(instance.output.samples_capacity_max));
-    LOGI_1("samples_capacity %d bytes", instance.output.samples_capacity_max);
+    instance.output.samples_capacity = MAX_NCHAN * MAX_NGRAN * MAX_NSAMP * sizeof(int16_t);
+    instance.output.samples = static_cast<uint8_t*>(malloc(instance.output.samples_capacity));
+    LOGI_1("samples_capacity %d bytes", instance.output.samples_capacity);
     int ret = ESP_OK;
     ESP_GOTO_ON_FALSE(NULL != instance.output.samples, ESP_ERR_NO_MEM, cleanup,
         TAG, "Failed allocate output buffer");
@@ -556,6 +1008,21 @@ esp_err_t audio_player_new(audio_player_config_t config)
     instance.mp3_decoder = MP3InitDecoder();
     ESP_GOTO_ON_FALSE(NULL != instance.mp3_decoder, ESP_ERR_NO_MEM, cleanup,
         TAG, "Failed create MP3 decoder");
+
+    instance.pending_index_lock = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(NULL != instance.pending_index_lock, ESP_ERR_NO_MEM, cleanup,
+        TAG, "Failed create index lock");
+#endif
+
+#if defined(CONFIG_AUDIO_PLAYER_FIXED_OUTPUT_RATE)
+    ret = audio_resampler_init(&instance.resampler, 2, CONFIG_AUDIO_PLAYER_OUTPUT_SAMPLE_RATE);
+    ESP_GOTO_ON_ERROR(ret, cleanup, TAG, "Failed init resampler");
+
+    // one decoded frame per write, the resampler is called again if it needs more room
+    instance.resample_buf_frames = MAX_NGRAN * MAX_NSAMP;
+    instance.resample_buf = static_cast<int16_t*>(malloc(instance.resample_buf_frames * 2 * sizeof(int16_t)));
+    ESP_GOTO_ON_FALSE(NULL != instance.resample_buf, ESP_ERR_NO_MEM, cleanup,
+        TAG, "Failed allocate resample buffer");
 #endif
 
     instance.running = true;
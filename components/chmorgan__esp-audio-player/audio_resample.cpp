@@ -0,0 +1,207 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_log.h"
+#include "audio_resample.h"
+
+static const char *TAG = "resample";
+
+/** fraction of the narrower Nyquist band that is passed, the rest is the transition band */
+#define RESAMPLE_ROLLOFF        0.90f
+
+/** Kaiser window beta, roughly 80dB of stop band attenuation */
+#define RESAMPLE_KAISER_BETA    8.0f
+
+static uint32_t gcd(uint32_t a, uint32_t b) {
+    while(b) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/** zeroth order modified Bessel function of the first kind, series expansion */
+static float bessel_i0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    float half_x = x / 2.0f;
+    for(int k = 1; k < 32; k++) {
+        term *= (half_x / k) * (half_x / k);
+        sum += term;
+        if(term < sum * 1e-9f) {
+            break;
+        }
+    }
+    return sum;
+}
+
+static inline int16_t saturate16(int32_t v) {
+    if(v > INT16_MAX) return INT16_MAX;
+    if(v < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(v);
+}
+
+/**
+ * Design the prototype low-pass at the upsampled rate and split it into up branches.
+ *
+ * Branch p holds h[k * up + p] for k = 0..TAPS-1, stored in reverse order so that it lines
+ * up with the delay line, which is ordered oldest to newest.
+ */
+static void design_filter(audio_resampler_t *r) {
+    const uint32_t up = r->up;
+    const uint32_t length = up * AUDIO_RESAMPLE_TAPS;
+    const float center = (length - 1) / 2.0f;
+    const float cutoff = RESAMPLE_ROLLOFF * 0.5f / ((up > r->down) ? up : r->down);
+    const float window_norm = bessel_i0(RESAMPLE_KAISER_BETA);
+
+    for(uint32_t n = 0; n < length; n++) {
+        float t = n - center;
+        float sinc = (t == 0.0f) ? 1.0f : sinf(2.0f * (float)M_PI * cutoff * t) / (2.0f * (float)M_PI * cutoff * t);
+        float w = t / center;
+        float window = bessel_i0(RESAMPLE_KAISER_BETA * sqrtf(fmaxf(0.0f, 1.0f - w * w))) / window_norm;
+
+        // the factor of 'up' restores the gain lost by zero stuffing
+        float h = 2.0f * cutoff * sinc * window * up;
+
+        uint32_t phase = n % up;
+        uint32_t tap = n / up;
+        r->coeffs[phase * AUDIO_RESAMPLE_TAPS + (AUDIO_RESAMPLE_TAPS - 1 - tap)] =
+            saturate16(static_cast<int32_t>(lrintf(h * (1 << AUDIO_RESAMPLE_COEF_SHIFT))));
+    }
+}
+
+esp_err_t audio_resampler_init(audio_resampler_t *r, uint32_t channels, uint32_t out_rate) {
+    if((channels == 0) || (channels > AUDIO_RESAMPLE_MAX_CHANNELS) || (out_rate == 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(r, 0, sizeof(*r));
+    r->channels = channels;
+    r->out_rate = out_rate;
+
+    return ESP_OK;
+}
+
+esp_err_t audio_resampler_set_input_rate(audio_resampler_t *r, uint32_t in_rate) {
+    if(in_rate == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if(in_rate == r->in_rate) {
+        return ESP_OK;
+    }
+
+    uint32_t divisor = gcd(in_rate, r->out_rate);
+    uint32_t up = r->out_rate / divisor;
+    uint32_t down = in_rate / divisor;
+
+    if(up > AUDIO_RESAMPLE_MAX_PHASES) {
+        ESP_LOGE(TAG, "%d -> %d Hz needs %d phases, max %d",
+                 (int)in_rate, (int)r->out_rate, (int)up, AUDIO_RESAMPLE_MAX_PHASES);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    if(up > r->coeffs_phases) {
+        int16_t *coeffs = static_cast<int16_t*>(realloc(r->coeffs, up * AUDIO_RESAMPLE_TAPS * sizeof(int16_t)));
+        if(coeffs == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+        r->coeffs = coeffs;
+        r->coeffs_phases = up;
+    }
+
+    r->in_rate = in_rate;
+    r->up = up;
+    r->down = down;
+
+    if(!audio_resampler_is_passthrough(r)) {
+        design_filter(r);
+    }
+
+    LOGI_1("%d -> %d Hz, L %d, M %d", (int)in_rate, (int)r->out_rate, (int)up, (int)down);
+
+    audio_resampler_reset(r);
+
+    return ESP_OK;
+}
+
+void audio_resampler_reset(audio_resampler_t *r) {
+    memset(r->history, 0, sizeof(r->history));
+    r->history_pos = 0;
+
+    // no input sample has been pushed yet
+    r->phase = r->up;
+}
+
+bool audio_resampler_is_passthrough(const audio_resampler_t *r) {
+    return r->up == r->down;
+}
+
+static inline void history_push(audio_resampler_t *r, const int16_t *frame) {
+    uint32_t pos = r->history_pos;
+    for(uint32_t c = 0; c < r->channels; c++) {
+        r->history[c][pos] = frame[c];
+        r->history[c][pos + AUDIO_RESAMPLE_TAPS] = frame[c];
+    }
+    r->history_pos = (pos + 1 == AUDIO_RESAMPLE_TAPS) ? 0 : pos + 1;
+}
+
+static inline int16_t dot(const int16_t *x, const int16_t *h) {
+    // the coefficients of each branch sum to ~1.0 in Q14 so an int32 accumulator
+    // has more than enough headroom for AUDIO_RESAMPLE_TAPS full scale products
+    int32_t acc = 1 << (AUDIO_RESAMPLE_COEF_SHIFT - 1);
+    for(int k = 0; k < AUDIO_RESAMPLE_TAPS; k++) {
+        acc += static_cast<int32_t>(x[k]) * h[k];
+    }
+    return saturate16(acc >> AUDIO_RESAMPLE_COEF_SHIFT);
+}
+
+size_t audio_resampler_process(audio_resampler_t *r, const int16_t *in, size_t *in_frames,
+                               int16_t *out, size_t out_frames) {
+    const uint32_t channels = r->channels;
+    size_t in_available = *in_frames;
+    size_t in_used = 0;
+    size_t out_used = 0;
+
+    if(audio_resampler_is_passthrough(r)) {
+        size_t frames = (in_available < out_frames) ? in_available : out_frames;
+        memcpy(out, in, frames * channels * sizeof(int16_t));
+        *in_frames = frames;
+        return frames;
+    }
+
+    while(true) {
+        // emit every output sample that falls between the newest input sample and the next one
+        while(r->phase < r->up) {
+            if(out_used == out_frames) {
+                goto done;
+            }
+
+            const int16_t *h = r->coeffs + r->phase * AUDIO_RESAMPLE_TAPS;
+            for(uint32_t c = 0; c < channels; c++) {
+                out[out_used * channels + c] = dot(&r->history[c][r->history_pos], h);
+            }
+            out_used++;
+            r->phase += r->down;
+        }
+
+        if(in_used == in_available) {
+            break;
+        }
+
+        r->phase -= r->up;
+        history_push(r, in + in_used * channels);
+        in_used++;
+    }
+
+done:
+    *in_frames = in_used;
+    return out_used;
+}
+
+void audio_resampler_free(audio_resampler_t *r) {
+    free(r->coeffs);
+    r->coeffs = NULL;
+    r->coeffs_phases = 0;
+}
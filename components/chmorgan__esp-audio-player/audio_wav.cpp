@@ -35,6 +35,8 @@ bool is_wav(FILE *fp, wav_instance *pInstance) {
 
         if(memcmp(subchunk.SubchunkID, "data", 4) == 0)
         {
+            pInstance->data_offset = ftell(fp);
+            pInstance->data_size = subchunk.SubchunkSize;
             break;
         } else {
             // advance beyond this subchunk, it could be a 'LIST' chunk with file info or some other unhandled subchunk
@@ -55,9 +57,11 @@ bool is_wav(FILE *fp, wav_instance *pInstance) {
  */
 DECODE_STATUS decode_wav(FILE *fp, decode_data *pData, wav_instance *pInstance) {
     // read an even multiple of frames that can fit into output_samples buffer, otherwise
-    // we would have to manage what happens with partial frames in the output buffer
+    // we would have to manage what happens with partial frames in the output buffer.
+    // Frames grow to stereo 16-bit in place, so mono takes as much room as stereo
     size_t bytes_per_frame = (pInstance->header.BitsPerSample / BITS_PER_BYTE) * pInstance->header.NumChannels;
-    size_t frames_to_read = pData->samples_capacity / bytes_per_frame;
+    size_t bytes_per_output_frame = bytes_per_frame > 2 * sizeof(int16_t) ? bytes_per_frame : 2 * sizeof(int16_t);
+    size_t frames_to_read = pData->samples_capacity / bytes_per_output_frame;
     size_t bytes_to_read = frames_to_read * bytes_per_frame;
 
     size_t bytes_read = fread(pData->samples, 1, bytes_to_read, fp);
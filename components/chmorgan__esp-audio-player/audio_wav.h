@@ -28,6 +28,10 @@ typedef struct {
 
 typedef struct {
     wav_header_t header;
+
+    /** file offset and size of the 'data' chunk payload */
+    long data_offset;
+    uint32_t data_size;
 } wav_instance;
 
 bool is_wav(FILE *fp, wav_instance *pInstance);
@@ -0,0 +1,268 @@
+/**
+ * @file
+ *
+ * Host benchmark for the audio_convert kernels.
+ *
+ * Every kernel is first checked bit for bit against its scalar reference over random input
+ * at several gains, odd and even lengths and word aligned and unaligned buffers, with the
+ * mono conversion done in place as the player does it. Then each kernel and its reference
+ * are timed over one decoded mp3 frame, along with the two pass version of every conversion
+ * that the fused gain replaces.
+ *
+ * The host compiler vectorizes differently from the xtensa one, so the speedups here are a
+ * regression check rather than a prediction, see test/audio_convert_test.c for cycle counts.
+ *
+ * usage: convert_bench [-r repeat]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "audio_convert.h"
+
+#define BENCH_FRAMES    1152    /**< one mp3 frame */
+#define BENCH_GAIN      0x5a82  /**< -3dB */
+
+static const uint16_t check_gains[] = { 0, 0x2000, BENCH_GAIN, AUDIO_CONVERT_GAIN_UNITY, 0xffff };
+
+static size_t failures = 0;
+
+#define CHECK_SAME(what, ref, out, n) do { \
+        if(memcmp((ref), (out), (n) * sizeof(int16_t)) != 0) { \
+            fprintf(stderr, "%s differs from the reference, gain 0x%04x, offset %zu, frames %zu\n", \
+                    what, gain, offset, frames); \
+            failures++; \
+        } \
+    } while(0)
+
+static void fill_random(void *buf, size_t bytes)
+{
+    uint8_t *p = static_cast<uint8_t*>(buf);
+    for(size_t n = 0; n < bytes; n++) {
+        p[n] = static_cast<uint8_t>(rand());
+    }
+}
+
+static void check(void)
+{
+    // +2 leaves room to test unaligned buffers
+    const size_t words = BENCH_FRAMES * 2 + 2;
+    std::vector<int32_t> src_words(words), out_words(words), ref_words(words);
+    int16_t *src = reinterpret_cast<int16_t*>(src_words.data());
+    int16_t *out = reinterpret_cast<int16_t*>(out_words.data());
+    int16_t *ref = reinterpret_cast<int16_t*>(ref_words.data());
+    std::vector<int16_t> left(BENCH_FRAMES + 1), right(BENCH_FRAMES + 1);
+
+    for(uint16_t gain : check_gains) {
+        for(size_t offset = 0; offset < 2; offset++) {
+            for(size_t frames = BENCH_FRAMES - 1; frames <= BENCH_FRAMES; frames++) {
+                fill_random(src, words * sizeof(int32_t));
+
+                memcpy(out, src, frames * sizeof(int16_t) + offset * 2);
+                audio_convert_mono_to_stereo(out + offset, out + offset, frames, gain);
+                audio_convert_mono_to_stereo_ref(ref, src + offset, frames, gain);
+                CHECK_SAME("mono->stereo", ref, out + offset, frames * 2);
+
+                memcpy(out, src, frames * 2 * sizeof(int16_t) + offset * 2);
+                memcpy(ref, src, frames * 2 * sizeof(int16_t) + offset * 2);
+                audio_convert_gain(out + offset, frames * 2, gain);
+                audio_convert_gain_ref(ref + offset, frames * 2, gain);
+                CHECK_SAME("gain", ref + offset, out + offset, frames * 2);
+
+                audio_convert_s24_to_s16(out + offset, reinterpret_cast<const uint8_t*>(src), frames * 2, gain);
+                audio_convert_s24_to_s16_ref(ref, reinterpret_cast<const uint8_t*>(src), frames * 2, gain);
+                CHECK_SAME("s24->s16", ref, out + offset, frames * 2);
+
+                audio_convert_s32_to_s16(out + offset, reinterpret_cast<const int32_t*>(src), frames * 2, gain);
+                audio_convert_s32_to_s16_ref(ref, reinterpret_cast<const int32_t*>(src), frames * 2, gain);
+                CHECK_SAME("s32->s16", ref, out + offset, frames * 2);
+            }
+        }
+    }
+
+    const uint16_t gain = AUDIO_CONVERT_GAIN_UNITY;
+    const size_t frames = BENCH_FRAMES;
+    for(size_t offset = 0; offset < 2; offset++) {
+        fill_random(src, words * sizeof(int32_t));
+        audio_convert_deinterleave(left.data(), right.data(), src + offset, frames);
+        audio_convert_interleave(out + offset, left.data(), right.data(), frames);
+        CHECK_SAME("deinterleave+interleave", src + offset, out + offset, frames * 2);
+        audio_convert_interleave_ref(ref, left.data(), right.data(), frames);
+        CHECK_SAME("interleave", src + offset, ref, frames * 2);
+    }
+}
+
+/*-------------------- timing --------------------*/
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+typedef struct {
+    int32_t src[BENCH_FRAMES * 2];
+    int32_t dst[BENCH_FRAMES * 2];
+    int16_t left[BENCH_FRAMES];
+    int16_t right[BENCH_FRAMES];
+} bench_buffers_t;
+
+typedef void (*kernel_fn)(bench_buffers_t *b);
+
+static void mono_to_stereo(bench_buffers_t *b)
+{
+    audio_convert_mono_to_stereo(reinterpret_cast<int16_t*>(b->dst), reinterpret_cast<int16_t*>(b->src), BENCH_FRAMES, BENCH_GAIN);
+}
+
+static void mono_to_stereo_ref(bench_buffers_t *b)
+{
+    audio_convert_mono_to_stereo_ref(reinterpret_cast<int16_t*>(b->dst), reinterpret_cast<int16_t*>(b->src), BENCH_FRAMES, BENCH_GAIN);
+}
+
+static void mono_to_stereo_two_pass(bench_buffers_t *b)
+{
+    int16_t *dst = reinterpret_cast<int16_t*>(b->dst);
+    audio_convert_mono_to_stereo(dst, reinterpret_cast<int16_t*>(b->src), BENCH_FRAMES, AUDIO_CONVERT_GAIN_UNITY);
+    audio_convert_gain(dst, BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void gain(bench_buffers_t *b)
+{
+    audio_convert_gain(reinterpret_cast<int16_t*>(b->dst), BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void gain_ref(bench_buffers_t *b)
+{
+    audio_convert_gain_ref(reinterpret_cast<int16_t*>(b->dst), BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void s24(bench_buffers_t *b)
+{
+    audio_convert_s24_to_s16(reinterpret_cast<int16_t*>(b->dst), reinterpret_cast<uint8_t*>(b->src), BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void s24_ref(bench_buffers_t *b)
+{
+    audio_convert_s24_to_s16_ref(reinterpret_cast<int16_t*>(b->dst), reinterpret_cast<uint8_t*>(b->src), BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void s24_two_pass(bench_buffers_t *b)
+{
+    int16_t *dst = reinterpret_cast<int16_t*>(b->dst);
+    audio_convert_s24_to_s16(dst, reinterpret_cast<uint8_t*>(b->src), BENCH_FRAMES * 2, AUDIO_CONVERT_GAIN_UNITY);
+    audio_convert_gain(dst, BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void s32(bench_buffers_t *b)
+{
+    audio_convert_s32_to_s16(reinterpret_cast<int16_t*>(b->dst), b->src, BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void s32_ref(bench_buffers_t *b)
+{
+    audio_convert_s32_to_s16_ref(reinterpret_cast<int16_t*>(b->dst), b->src, BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void s32_two_pass(bench_buffers_t *b)
+{
+    int16_t *dst = reinterpret_cast<int16_t*>(b->dst);
+    audio_convert_s32_to_s16(dst, b->src, BENCH_FRAMES * 2, AUDIO_CONVERT_GAIN_UNITY);
+    audio_convert_gain(dst, BENCH_FRAMES * 2, BENCH_GAIN);
+}
+
+static void interleave(bench_buffers_t *b)
+{
+    audio_convert_interleave(reinterpret_cast<int16_t*>(b->dst), b->left, b->right, BENCH_FRAMES);
+}
+
+static void interleave_ref(bench_buffers_t *b)
+{
+    audio_convert_interleave_ref(reinterpret_cast<int16_t*>(b->dst), b->left, b->right, BENCH_FRAMES);
+}
+
+static void deinterleave(bench_buffers_t *b)
+{
+    audio_convert_deinterleave(b->left, b->right, reinterpret_cast<int16_t*>(b->src), BENCH_FRAMES);
+}
+
+static void deinterleave_ref(bench_buffers_t *b)
+{
+    audio_convert_deinterleave_ref(b->left, b->right, reinterpret_cast<int16_t*>(b->src), BENCH_FRAMES);
+}
+
+typedef struct {
+    const char *name;
+    size_t samples;             /**< output samples per call */
+    kernel_fn fast;
+    kernel_fn ref;
+    kernel_fn two_pass;         /**< NULL where there is no gain to fuse */
+} bench_kernel_t;
+
+static const bench_kernel_t kernels[] = {
+    { "mono->stereo+gain", BENCH_FRAMES * 2, mono_to_stereo, mono_to_stereo_ref, mono_to_stereo_two_pass },
+    { "gain", BENCH_FRAMES * 2, gain, gain_ref, NULL },
+    { "s24->s16+gain", BENCH_FRAMES * 2, s24, s24_ref, s24_two_pass },
+    { "s32->s16+gain", BENCH_FRAMES * 2, s32, s32_ref, s32_two_pass },
+    { "interleave", BENCH_FRAMES * 2, interleave, interleave_ref, NULL },
+    { "deinterleave", BENCH_FRAMES * 2, deinterleave, deinterleave_ref, NULL },
+};
+
+/** best of repeat runs, in ns per output sample */
+static double time_kernel(kernel_fn fn, bench_buffers_t *b, int repeat)
+{
+    const int calls = 200;
+    uint64_t best = UINT64_MAX;
+    for(int r = 0; r < repeat; r++) {
+        uint64_t start = now_ns();
+        for(int c = 0; c < calls; c++) {
+            fn(b);
+            // keep the compiler from dropping calls whose output isn't read
+            __asm__ __volatile__("" : : "r"(b) : "memory");
+        }
+        best = std::min(best, now_ns() - start);
+    }
+    return static_cast<double>(best) / calls;
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = 20;
+    for(int a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "-r") == 0 && a + 1 < argc) {
+            repeat = std::max(1, atoi(argv[++a]));
+        } else {
+            fprintf(stderr, "usage: convert_bench [-r repeat]\n");
+            return 2;
+        }
+    }
+
+    srand(1);
+    check();
+
+    static bench_buffers_t buffers;
+    fill_random(&buffers, sizeof(buffers));
+
+    printf("%-18s %10s %10s %10s %8s %11s\n", "kernel", "ns/frame", "ref", "two pass", "vs ref", "vs 2 pass");
+    for(const bench_kernel_t &k : kernels) {
+        double fast = time_kernel(k.fast, &buffers, repeat);
+        double ref = time_kernel(k.ref, &buffers, repeat);
+        double frames = k.samples / 2.0;
+        char two_pass[16] = "-";
+        char saved[16] = "-";
+        if(k.two_pass) {
+            double split = time_kernel(k.two_pass, &buffers, repeat);
+            snprintf(two_pass, sizeof(two_pass), "%.2f", split / frames);
+            snprintf(saved, sizeof(saved), "%.2fx", split / fast);
+        }
+        printf("%-18s %10.2f %10.2f %10s %7.2fx %11s\n", k.name, fast / frames, ref / frames, two_pass, ref / fast, saved);
+    }
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file
+ *
+ * Host benchmark for decode_mp3() and decode_wav().
+ *
+ * Each file is decoded the way aplay_file() does it, with the same buffer sizes, and
+ * timed per decode call. Allocations are counted by wrapping malloc and friends at link
+ * time so changes to the decoders or the player's buffering show up without hardware.
+ *
+ * usage: audio_bench [-r repeat] file|directory...
+ */
+
+#include <dirent.h>
+#include <malloc.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "audio_mp3.h"
+#include "audio_wav.h"
+
+/*-------------------- allocation tracking --------------------*/
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+void __real_free(void *p);
+}
+
+static struct {
+    bool enabled;
+    size_t allocs;
+    size_t live_bytes;
+    size_t peak_bytes;
+} mem;
+
+static void mem_add(void *p)
+{
+    if(p && mem.enabled) {
+        mem.allocs++;
+        mem.live_bytes += malloc_usable_size(p);
+        mem.peak_bytes = std::max(mem.peak_bytes, mem.live_bytes);
+    }
+}
+
+static void mem_remove(void *p)
+{
+    if(p && mem.enabled) {
+        size_t size = malloc_usable_size(p);
+        mem.live_bytes -= std::min(size, mem.live_bytes);
+    }
+}
+
+extern "C" void *__wrap_malloc(size_t size)
+{
+    void *p = __real_malloc(size);
+    mem_add(p);
+    return p;
+}
+
+extern "C" void *__wrap_calloc(size_t n, size_t size)
+{
+    void *p = __real_calloc(n, size);
+    mem_add(p);
+    return p;
+}
+
+extern "C" void *__wrap_realloc(void *old, size_t size)
+{
+    mem_remove(old);
+    void *p = __real_realloc(old, size);
+    mem_add(p);
+    return p;
+}
+
+extern "C" void __wrap_free(void *p)
+{
+    mem_remove(p);
+    __real_free(p);
+}
+
+/*-------------------- logging --------------------*/
+
+static bool verbose = false;
+static size_t error_logs = 0;
+
+extern "C" void host_bench_log(char level, const char *tag, const char *fmt, ...)
+{
+    if(level == 'E') {
+        error_logs++;
+    }
+    if(verbose) {
+        va_list args;
+        va_start(args, fmt);
+        fprintf(stderr, "%c %s: ", level, tag);
+        vfprintf(stderr, fmt, args);
+        fputc('\n', stderr);
+        va_end(args);
+    }
+}
+
+/*-------------------- benchmark --------------------*/
+
+typedef struct {
+    const char *type;
+    int sample_rate;
+    int channels;
+    size_t frames;              /**< decode calls that produced samples */
+    size_t samples;             /**< per channel */
+    uint64_t total_ns;
+    uint64_t worst_ns;
+    uint64_t first_ns;          /**< from the start of file detection to the first samples */
+    size_t allocs;
+    size_t peak_bytes;
+    size_t errors;
+} bench_result_t;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool bench_file(const char *path, bench_result_t *result)
+{
+    memset(result, 0, sizeof(*result));
+
+    FILE *fp = fopen(path, "rb");
+    if(!fp) {
+        return false;
+    }
+
+    mem = {};
+    mem.enabled = true;
+    error_logs = 0;
+
+    // as audio_player_new()
+    decode_data output = {};
+    output.samples_capacity = MAX_NCHAN * MAX_NGRAN * MAX_NSAMP * sizeof(int16_t);
+    output.samples = static_cast<uint8_t*>(malloc(output.samples_capacity));
+
+    mp3_instance mp3_data = {};
+    mp3_data.data_buf_size = MAINBUF_SIZE * 3;
+    mp3_data.data_buf = static_cast<uint8_t*>(malloc(mp3_data.data_buf_size));
+    mp3_data.read_ptr = mp3_data.data_buf;
+    HMP3Decoder mp3_decoder = MP3InitDecoder();
+
+    wav_instance wav_data = {};
+
+    // as aplay_file()
+    uint64_t open = now_ns();
+    mp3_metadata_t metadata;
+    bool mp3 = is_mp3(fp, &metadata);
+    bool wav = !mp3 && is_wav(fp, &wav_data);
+    result->type = mp3 ? "mp3" : (wav ? "wav" : "?");
+
+    while(mp3 || wav) {
+        uint64_t start = now_ns();
+        DECODE_STATUS status = mp3 ? decode_mp3(mp3_decoder, fp, &output, &mp3_data) :
+                                     decode_wav(fp, &output, &wav_data);
+        uint64_t elapsed = now_ns() - start;
+
+        if(status == DECODE_STATUS_DONE || status == DECODE_STATUS_ERROR) {
+            break;
+        }
+
+        result->total_ns += elapsed;
+        if(status == DECODE_STATUS_CONTINUE && output.frame_count) {
+            result->frames++;
+            result->samples += output.frame_count;
+            result->worst_ns = std::max(result->worst_ns, elapsed);
+            if(result->frames == 1) {
+                result->first_ns = now_ns() - open;
+            }
+            result->sample_rate = output.fmt.sample_rate;
+            result->channels = output.fmt.channels;
+        }
+    }
+
+    MP3FreeDecoder(mp3_decoder);
+    free(mp3_data.data_buf);
+    free(output.samples);
+    fclose(fp);
+
+    mem.enabled = false;
+    result->allocs = mem.allocs;
+    result->peak_bytes = mem.peak_bytes;
+    result->errors = error_logs;
+
+    return mp3 || wav;
+}
+
+static void collect(const char *path, std::vector<std::string> &files)
+{
+    struct stat st;
+    if(stat(path, &st) != 0) {
+        fprintf(stderr, "can't open %s\n", path);
+        return;
+    }
+    if(!S_ISDIR(st.st_mode)) {
+        files.push_back(path);
+        return;
+    }
+
+    DIR *dir = opendir(path);
+    std::vector<std::string> entries;
+    while(dirent *e = readdir(dir)) {
+        std::string name = e->d_name;
+        if(name.size() > 4 && (name.compare(name.size() - 4, 4, ".mp3") == 0 ||
+                               name.compare(name.size() - 4, 4, ".wav") == 0)) {
+            entries.push_back(std::string(path) + "/" + name);
+        }
+    }
+    closedir(dir);
+
+    std::sort(entries.begin(), entries.end());
+    files.insert(files.end(), entries.begin(), entries.end());
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = 1;
+    std::vector<std::string> files;
+
+    for(int a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "-r") == 0 && a + 1 < argc) {
+            repeat = std::max(1, atoi(argv[++a]));
+        } else if(strcmp(argv[a], "-v") == 0) {
+            verbose = true;
+        } else {
+            collect(argv[a], files);
+        }
+    }
+    if(files.empty()) {
+        fprintf(stderr, "usage: audio_bench [-r repeat] [-v] file|directory...\n");
+        return 2;
+    }
+
+    printf("%-32s %4s %6s %2s %7s %10s %9s %9s %8s %6s %8s %6s\n",
+           "file", "type", "rate", "ch", "frames", "frames/s", "worst us", "first us", "xRT", "allocs", "peak KB", "errors");
+
+    int failed = 0;
+    for(const std::string &file : files) {
+        // best of repeat runs to filter out scheduling noise, allocation counts don't vary
+        bench_result_t best = {};
+        uint64_t worst_ns = UINT64_MAX;
+        uint64_t first_ns = UINT64_MAX;
+        bool ok = false;
+        for(int r = 0; r < repeat; r++) {
+            bench_result_t result;
+            ok = bench_file(file.c_str(), &result);
+            worst_ns = std::min(worst_ns, result.worst_ns);
+            first_ns = std::min(first_ns, result.first_ns);
+            if(r == 0 || result.total_ns < best.total_ns) {
+                best = result;
+            }
+        }
+        best.worst_ns = worst_ns;
+        best.first_ns = first_ns;
+
+        const char *name = strrchr(file.c_str(), '/') ? strrchr(file.c_str(), '/') + 1 : file.c_str();
+        if(!ok || best.frames == 0) {
+            printf("%-32.32s %4s  not decoded\n", name, best.type ? best.type : "?");
+            failed++;
+            continue;
+        }
+
+        double seconds = best.total_ns / 1e9;
+        double audio_seconds = static_cast<double>(best.samples) / best.sample_rate;
+        printf("%-32.32s %4s %6d %2d %7zu %10.0f %9.1f %9.1f %8.0f %6zu %8.1f %6zu\n",
+               name, best.type, best.sample_rate, best.channels, best.frames,
+               best.frames / seconds, best.worst_ns / 1e3, best.first_ns / 1e3, audio_seconds / seconds,
+               best.allocs, best.peak_bytes / 1024.0, best.errors);
+    }
+
+    return failed ? 1 : 0;
+}
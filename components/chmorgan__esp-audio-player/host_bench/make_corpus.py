@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Generate the benchmark corpus for audio_bench.
+
+    make_corpus.py <output dir> [seconds]
+
+WAV files and ID3-heavy copies of the test mp3 are always written. MP3 bitrate,
+sample rate and VBR variants need ffmpeg (built with libmp3lame) on the PATH and are
+skipped without it.
+"""
+
+import math
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import wave
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+TEST_MP3 = os.path.join(HERE, '..', 'test', 'gs-16b-1c-44100hz.mp3')
+
+WAV_VARIANTS = [
+    # rate, channels, bits
+    (8000, 1, 16),
+    (16000, 1, 16),
+    (22050, 2, 16),
+    (44100, 1, 16),
+    (44100, 2, 16),
+    (48000, 2, 16),
+    (48000, 2, 24),
+    (44100, 2, 32),
+]
+
+MP3_VARIANTS = [
+    # name, ffmpeg arguments
+    ('cbr-32k-22050-1c', ['-ar', '22050', '-ac', '1', '-b:a', '32k']),
+    ('cbr-64k-32000-1c', ['-ar', '32000', '-ac', '1', '-b:a', '64k']),
+    ('cbr-128k-44100-2c', ['-ar', '44100', '-ac', '2', '-b:a', '128k']),
+    ('cbr-192k-48000-2c', ['-ar', '48000', '-ac', '2', '-b:a', '192k']),
+    ('cbr-320k-44100-2c', ['-ar', '44100', '-ac', '2', '-b:a', '320k']),
+    ('vbr-q0-44100-2c', ['-ar', '44100', '-ac', '2', '-q:a', '0']),
+    ('vbr-q5-44100-2c', ['-ar', '44100', '-ac', '2', '-q:a', '5']),
+    ('vbr-q9-16000-1c', ['-ar', '16000', '-ac', '1', '-q:a', '9']),
+]
+
+# sizes of the ID3v2 tag put in front of the test mp3, the larger ones are typical of
+# embedded cover art
+ID3_SIZES = [4 * 1024, 256 * 1024, 1024 * 1024]
+
+
+def signal(n, rate, channel):
+    """A sweep plus a fixed tone per channel, so the decoders see changing content."""
+    t = n / rate
+    sweep = math.sin(2 * math.pi * (100 + 2000 * t) * t)
+    tone = math.sin(2 * math.pi * (440 + 110 * channel) * t)
+    return 0.45 * sweep + 0.35 * tone
+
+
+def write_wav(path, rate, channels, bits, seconds):
+    full_scale = (1 << (bits - 1)) - 1
+    frames = bytearray()
+    for n in range(int(rate * seconds)):
+        for c in range(channels):
+            value = int(signal(n, rate, c) * full_scale)
+            frames += value.to_bytes(4, 'little', signed=True)[:bits // 8]
+    with wave.open(path, 'wb') as w:
+        w.setnchannels(channels)
+        w.setsampwidth(bits // 8)
+        w.setframerate(rate)
+        w.writeframes(bytes(frames))
+
+
+def synchsafe(size):
+    return bytes([(size >> 21) & 0x7f, (size >> 14) & 0x7f, (size >> 7) & 0x7f, size & 0x7f])
+
+
+def id3v2_tag(size):
+    """An ID3v2.3 tag of the given total size, a title frame followed by an APIC frame."""
+    title = b'\x00' + b'host bench'
+    frames = b'TIT2' + struct.pack('>I', len(title)) + b'\x00\x00' + title
+    apic_header = b'\x00' + b'image/jpeg\x00' + b'\x03' + b'\x00'
+    picture = bytes(max(0, size - 10 - len(frames) - 10 - len(apic_header)))
+    apic = apic_header + picture
+    frames += b'APIC' + struct.pack('>I', len(apic)) + b'\x00\x00' + apic
+    return b'ID3\x03\x00\x00' + synchsafe(len(frames)) + frames
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip())
+        return 2
+    out = sys.argv[1]
+    seconds = float(sys.argv[2]) if len(sys.argv) > 2 else 10.0
+    os.makedirs(out, exist_ok=True)
+
+    for rate, channels, bits in WAV_VARIANTS:
+        write_wav(os.path.join(out, 'wav-%d-%dc-%db.wav' % (rate, channels, bits)),
+                  rate, channels, bits, seconds)
+
+    with open(TEST_MP3, 'rb') as f:
+        mp3 = f.read()
+    shutil.copy(TEST_MP3, os.path.join(out, 'gs-16b-1c-44100hz.mp3'))
+    for size in ID3_SIZES:
+        with open(os.path.join(out, 'id3-%dk-44100-1c.mp3' % (size // 1024)), 'wb') as f:
+            f.write(id3v2_tag(size) + mp3)
+
+    ffmpeg = shutil.which('ffmpeg')
+    if not ffmpeg:
+        print('ffmpeg not found, mp3 bitrate and VBR variants skipped')
+        return 0
+    source = os.path.join(out, 'wav-48000-2c-16b.wav')
+    for name, args in MP3_VARIANTS:
+        subprocess.run([ffmpeg, '-loglevel', 'error', '-y', '-i', source, '-codec:a', 'libmp3lame']
+                       + args + [os.path.join(out, name + '.mp3')], check=True)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
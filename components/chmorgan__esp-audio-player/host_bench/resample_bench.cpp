@@ -0,0 +1,258 @@
+/**
+ * @file
+ *
+ * Host benchmark for audio_resampler_process() against a float reference.
+ *
+ * The reference is the same L/M polyphase structure evaluated in double precision with
+ * unquantized coefficients, so the SNR of the fixed point output against it measures what
+ * the Q14 coefficients and 16-bit rounding cost and nothing else. The reference itself is
+ * also scored against the ideal tone, which is the quality of the filter design.
+ *
+ * Each input rate the player meets is converted to the output rate for a tone, a pair of
+ * tones in stereo and white noise, and the fixed point converter is timed per output frame.
+ *
+ * usage: resample_bench [-o rate] [-s seconds] [-t min_snr_db]
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "audio_resample.h"
+
+extern "C" void host_bench_log(char level, const char *tag, const char *fmt, ...)
+{
+    if(level == 'E') {
+        va_list args;
+        va_start(args, fmt);
+        fprintf(stderr, "%c %s: ", level, tag);
+        vfprintf(stderr, fmt, args);
+        fputc('\n', stderr);
+        va_end(args);
+    }
+}
+
+/*-------------------- float reference --------------------*/
+
+/** as design_filter() in audio_resample.cpp, without the Q14 rounding */
+#define REF_ROLLOFF         0.90
+#define REF_KAISER_BETA     8.0
+
+static double bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for(int k = 1; k < 64; k++) {
+        term *= (x / 2.0 / k) * (x / 2.0 / k);
+        sum += term;
+        if(term < sum * 1e-15) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * Output frame j falls j * down / up input samples after the first input sample and is the
+ * dot product of the prototype taps h[tap * up + phase] with the input samples before it.
+ */
+static std::vector<double> reference_resample(const std::vector<int16_t> &in, uint32_t channels,
+                                              uint32_t up, uint32_t down, size_t out_frames)
+{
+    if(up == down) {
+        // audio_resampler_process() copies at equal rates
+        return std::vector<double>(in.begin(), in.begin() + std::min(in.size(), out_frames * channels));
+    }
+
+    const uint32_t length = up * AUDIO_RESAMPLE_TAPS;
+    const double center = (length - 1) / 2.0;
+    const double cutoff = REF_ROLLOFF * 0.5 / std::max(up, down);
+
+    std::vector<double> h(length);
+    for(uint32_t n = 0; n < length; n++) {
+        double t = n - center;
+        double sinc = (t == 0.0) ? 1.0 : sin(2.0 * M_PI * cutoff * t) / (2.0 * M_PI * cutoff * t);
+        double w = t / center;
+        h[n] = 2.0 * cutoff * sinc * bessel_i0(REF_KAISER_BETA * sqrt(std::max(0.0, 1.0 - w * w))) /
+               bessel_i0(REF_KAISER_BETA) * up;
+    }
+
+    const size_t in_frames = in.size() / channels;
+    std::vector<double> out(out_frames * channels);
+    for(size_t j = 0; j < out_frames; j++) {
+        uint64_t position = static_cast<uint64_t>(j) * down;
+        size_t newest = position / up;
+        uint32_t phase = position % up;
+        for(uint32_t c = 0; c < channels; c++) {
+            double acc = 0;
+            for(uint32_t tap = 0; tap < AUDIO_RESAMPLE_TAPS && tap <= newest; tap++) {
+                size_t n = newest - tap;
+                if(n < in_frames) {
+                    acc += in[n * channels + c] * h[tap * up + phase];
+                }
+            }
+            out[j * channels + c] = acc;
+        }
+    }
+    return out;
+}
+
+/*-------------------- benchmark --------------------*/
+
+typedef enum {
+    SIGNAL_TONE,        /**< 1 kHz mono at -6 dBFS */
+    SIGNAL_STEREO,      /**< 440 Hz left, 2 kHz right */
+    SIGNAL_NOISE,       /**< white, -12 dBFS rms, stereo */
+} signal_t;
+
+static const char *signal_names[] = { "tone", "stereo", "noise" };
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+static double snr_db(double signal, double noise)
+{
+    return noise > 0 ? 10.0 * log10(signal / noise) : 200.0;
+}
+
+static std::vector<int16_t> make_signal(signal_t signal, uint32_t rate, size_t frames, uint32_t *channels)
+{
+    *channels = (signal == SIGNAL_TONE) ? 1 : 2;
+    std::vector<int16_t> in(frames * *channels);
+    srand(1);
+    for(size_t n = 0; n < frames; n++) {
+        switch(signal) {
+            case SIGNAL_TONE:
+                in[n] = static_cast<int16_t>(lrint(16384 * sin(2 * M_PI * 1000.0 * n / rate)));
+                break;
+            case SIGNAL_STEREO:
+                in[n * 2] = static_cast<int16_t>(lrint(16384 * sin(2 * M_PI * 440.0 * n / rate)));
+                in[n * 2 + 1] = static_cast<int16_t>(lrint(16384 * sin(2 * M_PI * 2000.0 * n / rate)));
+                break;
+            case SIGNAL_NOISE:
+                // sum of uniforms, close enough to gaussian and never clips
+                for(int c = 0; c < 2; c++) {
+                    int32_t s = 0;
+                    for(int k = 0; k < 4; k++) {
+                        s += rand() % 8192 - 4096;
+                    }
+                    in[n * 2 + c] = static_cast<int16_t>(s);
+                }
+                break;
+        }
+    }
+    return in;
+}
+
+static bool bench(uint32_t in_rate, uint32_t out_rate, signal_t signal, double seconds, double min_snr)
+{
+    uint32_t channels;
+    const size_t in_frames = static_cast<size_t>(seconds * in_rate);
+    std::vector<int16_t> in = make_signal(signal, in_rate, in_frames, &channels);
+
+    audio_resampler_t r;
+    if(audio_resampler_init(&r, channels, out_rate) != ESP_OK ||
+       audio_resampler_set_input_rate(&r, in_rate) != ESP_OK) {
+        printf("%6u %6u %-7s not supported\n", (unsigned)in_rate, (unsigned)out_rate, signal_names[signal]);
+        return false;
+    }
+
+    // the player's buffers, one decoded frame in and a resample_buf out
+    const size_t block_frames = 1152;
+    std::vector<int16_t> out;
+    std::vector<int16_t> block(block_frames * channels);
+    uint64_t start = now_ns();
+    for(size_t pos = 0; pos < in_frames;) {
+        size_t consumed = std::min(block_frames, in_frames - pos);
+        size_t produced = audio_resampler_process(&r, in.data() + pos * channels, &consumed, block.data(), block_frames);
+        out.insert(out.end(), block.begin(), block.begin() + produced * channels);
+        pos += consumed;
+    }
+    uint64_t elapsed = now_ns() - start;
+    const uint32_t up = r.up;
+    const uint32_t down = r.down;
+    audio_resampler_free(&r);
+
+    const size_t out_frames = out.size() / channels;
+    std::vector<double> ref = reference_resample(in, channels, up, down, out_frames);
+
+    // skip the filter filling up, and score the reference against the ideal tone too
+    const size_t settle = 2 * AUDIO_RESAMPLE_TAPS * up / down + 1;
+    const double delay = (up == down) ? 0 : (up * AUDIO_RESAMPLE_TAPS - 1) / 2.0;
+    double signal_power = 0, fixed_noise = 0, ideal_signal = 0, ideal_noise = 0;
+    for(size_t j = settle; j < out_frames; j++) {
+        double t = (j * static_cast<double>(down) - delay) / up / in_rate;
+        for(uint32_t c = 0; c < channels; c++) {
+            double y = ref[j * channels + c];
+            double e = out[j * channels + c] - y;
+            signal_power += y * y;
+            fixed_noise += e * e;
+            if(signal != SIGNAL_NOISE) {
+                double hz = (signal == SIGNAL_TONE) ? 1000.0 : (c == 0 ? 440.0 : 2000.0);
+                double ideal = 16384 * sin(2 * M_PI * hz * t);
+                ideal_signal += ideal * ideal;
+                ideal_noise += (y - ideal) * (y - ideal);
+            }
+        }
+    }
+
+    double fixed_snr = snr_db(signal_power, fixed_noise);
+    double ns_per_frame = static_cast<double>(elapsed) / out_frames;
+    double xrt = (static_cast<double>(out_frames) / out_rate) / (elapsed / 1e9);
+    bool ok = fixed_snr >= min_snr;
+    char ideal[16] = "-";
+    if(signal != SIGNAL_NOISE) {
+        snprintf(ideal, sizeof(ideal), "%.1f", snr_db(ideal_signal, ideal_noise));
+    }
+    printf("%6u %6u %-7s %4u %4u %9.1f %9s %9.1f %8.0f %s\n", (unsigned)in_rate, (unsigned)out_rate,
+           signal_names[signal], (unsigned)up, (unsigned)down, fixed_snr, ideal, ns_per_frame, xrt, ok ? "" : "FAIL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t out_rate = 44100;
+    double seconds = 2.0;
+    double min_snr = 70.0;
+
+    for(int a = 1; a < argc; a++) {
+        if(strcmp(argv[a], "-o") == 0 && a + 1 < argc) {
+            out_rate = strtoul(argv[++a], NULL, 0);
+        } else if(strcmp(argv[a], "-s") == 0 && a + 1 < argc) {
+            seconds = atof(argv[++a]);
+        } else if(strcmp(argv[a], "-t") == 0 && a + 1 < argc) {
+            min_snr = atof(argv[++a]);
+        } else {
+            fprintf(stderr, "usage: resample_bench [-o rate] [-s seconds] [-t min_snr_db]\n");
+            return 2;
+        }
+    }
+    if(out_rate == 0 || seconds <= 0) {
+        fprintf(stderr, "usage: resample_bench [-o rate] [-s seconds] [-t min_snr_db]\n");
+        return 2;
+    }
+
+    static const uint32_t in_rates[] = { 8000, 11025, 16000, 22050, 24000, 32000, 44100, 48000 };
+
+    printf("%6s %6s %-7s %4s %4s %9s %9s %9s %8s\n",
+           "in", "out", "signal", "L", "M", "SNR dB", "ideal dB", "ns/frame", "xRT");
+    int failed = 0;
+    for(uint32_t in_rate : in_rates) {
+        for(int s = SIGNAL_TONE; s <= SIGNAL_NOISE; s++) {
+            failed += !bench(in_rate, out_rate, static_cast<signal_t>(s), seconds, min_snr);
+        }
+    }
+
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed ? 1 : 0;
+}
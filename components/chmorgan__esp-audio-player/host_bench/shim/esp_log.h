@@ -0,0 +1,19 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF logger, shared by the host benches under main/ as well. Each bench defines
+// host_bench_log(), see host_bench.cpp
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void host_bench_log(char level, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#define ESP_LOGE(tag, fmt, ...) host_bench_log('E', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) host_bench_log('W', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) host_bench_log('I', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) host_bench_log('D', tag, fmt, ##__VA_ARGS__)
@@ -0,0 +1,75 @@
+/**
+ * @file
+ *
+ * PCM format conversion kernels.
+ *
+ * Every kernel produces signed 16-bit output and takes a Q15 gain so that volume
+ * scaling is applied in the same pass as the conversion instead of in a separate
+ * pass over the buffer. AUDIO_CONVERT_GAIN_UNITY leaves the level unchanged.
+ *
+ * The kernels move two 16-bit samples per 32-bit load/store where the buffers are
+ * suitably aligned. A plain scalar reference of each kernel is provided to check
+ * the optimized versions against.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_CONVERT_GAIN_UNITY    0x8000  /**< 1.0 in Q15 */
+
+/**
+ * @brief Duplicate each mono sample into a left/right pair, applying gain
+ *
+ * dst may equal src, the conversion runs back to front so it works in place.
+ *
+ * @param dst - frames * 2 samples
+ * @param src - frames samples
+ */
+void audio_convert_mono_to_stereo(int16_t *dst, const int16_t *src, size_t frames, uint16_t gain);
+
+/**
+ * @brief Apply gain to samples in place
+ */
+void audio_convert_gain(int16_t *buf, size_t samples, uint16_t gain);
+
+/**
+ * @brief Convert packed little endian 24-bit samples to 16-bit, applying gain
+ *
+ * dst may equal src.
+ */
+void audio_convert_s24_to_s16(int16_t *dst, const uint8_t *src, size_t samples, uint16_t gain);
+
+/**
+ * @brief Convert 32-bit samples to 16-bit, applying gain
+ *
+ * dst may equal src.
+ */
+void audio_convert_s32_to_s16(int16_t *dst, const int32_t *src, size_t samples, uint16_t gain);
+
+/**
+ * @brief Interleave two planar channels into left/right pairs
+ */
+void audio_convert_interleave(int16_t *dst, const int16_t *left, const int16_t *right, size_t frames);
+
+/**
+ * @brief Split left/right pairs into two planar channels
+ */
+void audio_convert_deinterleave(int16_t *left, int16_t *right, const int16_t *src, size_t frames);
+
+/* Scalar reference implementations with identical results */
+void audio_convert_mono_to_stereo_ref(int16_t *dst, const int16_t *src, size_t frames, uint16_t gain);
+void audio_convert_gain_ref(int16_t *buf, size_t samples, uint16_t gain);
+void audio_convert_s24_to_s16_ref(int16_t *dst, const uint8_t *src, size_t samples, uint16_t gain);
+void audio_convert_s32_to_s16_ref(int16_t *dst, const int32_t *src, size_t samples, uint16_t gain);
+void audio_convert_interleave_ref(int16_t *dst, const int16_t *left, const int16_t *right, size_t frames);
+void audio_convert_deinterleave_ref(int16_t *left, int16_t *right, const int16_t *src, size_t frames);
+
+#ifdef __cplusplus
+}
+#endif
@@ -52,6 +52,9 @@
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "driver/i2s_std.h"
+#include "audio_convert.h"
+#include "mp3_index.h"
+#include "mp3_metadata.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -133,6 +136,78 @@ esp_err_t audio_player_resume(void);
  */
 esp_err_t audio_player_stop(void);
 
+/**
+ * @brief Seek within the file being played
+ *
+ * MP3 seeks use the index handed over with audio_player_set_mp3_index(), otherwise the
+ * Xing/VBRI table of contents. Without either, frame headers are walked from the nearest
+ * frame already known, so the position reached is exact, and seeks further than that walk
+ * allows fail until an index is handed over. A seek while paused repositions playback
+ * without resuming it. Has no effect if playback is stopped.
+ *
+ * @param position_ms - from the start of the file, clamped to its end
+ * @return
+ *    - ESP_OK: Success in queuing seek request
+ *    - Others: Fail
+ */
+esp_err_t audio_player_seek(uint32_t position_ms);
+
+/**
+ * @brief Hand over an exact index for a file, for example one from mp3_index_get()
+ *
+ * The index is copied and used for the seeks and duration of fp from the start of its
+ * playback or the next seek. It is dropped if fp is closed before it is used.
+ *
+ * @param fp - the file as passed to audio_player_play(), NULL drops an index not used yet
+ * @param index - built from the same file, ignored if fp is NULL
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: fp without an index
+ *    - ESP_ERR_INVALID_STATE: the player has not been created
+ *    - ESP_ERR_NOT_SUPPORTED: mp3 support is disabled
+ */
+esp_err_t audio_player_set_mp3_index(FILE *fp, const mp3_index_t *index);
+
+/**
+ * @brief Get the playback position of the current file
+ *
+ * The position counts samples handed to the output, it runs ahead of the speaker by
+ * the i2s DMA buffering.
+ *
+ * @param samples - [out] samples per channel since the start of the file
+ * @param sample_rate - [out] sample rate of the file
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_STATE: nothing has been decoded yet
+ */
+esp_err_t audio_player_get_position(uint32_t *samples, uint32_t *sample_rate);
+
+/**
+ * @brief Get the title, artist and album of the file being played
+ *
+ * Read from the ID3 tags when playback of an mp3 starts, valid from its PLAYING
+ * callback until the next file starts.
+ *
+ * @param metadata - [out] missing fields are empty strings
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_NOT_FOUND: the file has no tags, or is not an mp3
+ */
+esp_err_t audio_player_get_metadata(mp3_metadata_t *metadata);
+
+/**
+ * @brief Set the digital output gain
+ *
+ * The gain is applied by the audio task while converting decoded samples to stereo
+ * 16-bit, so it costs no extra pass over the samples. Takes effect from the next
+ * decoded frame.
+ *
+ * @param gain - Q15 fixed point, AUDIO_CONVERT_GAIN_UNITY (0x8000) is 0dB, 0 is silence
+ * @return
+ *    - ESP_OK: Success
+ */
+esp_err_t audio_player_set_gain(uint16_t gain);
+
 /**
  * @brief Register callback for audio event
  *
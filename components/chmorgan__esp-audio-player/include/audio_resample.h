@@ -0,0 +1,115 @@
+/**
+ * @file
+ *
+ * Polyphase sample-rate converter for interleaved 16-bit PCM.
+ *
+ * The converter implements a rational L/M resampler. The prototype low-pass
+ * filter is designed once per input rate (windowed sinc, Kaiser window) and
+ * stored as L branches of AUDIO_RESAMPLE_TAPS Q14 coefficients, so each output
+ * sample costs a single AUDIO_RESAMPLE_TAPS long 16x16->32 dot product over
+ * contiguous memory per channel.
+ *
+ * The delay line is kept twice as long as the filter and written at two
+ * positions so that the most recent AUDIO_RESAMPLE_TAPS samples are always
+ * contiguous, which keeps the inner loop free of modulo arithmetic.
+ *
+ * Each branch spans AUDIO_RESAMPLE_TAPS input samples, which suits up-conversion and
+ * near-unity ratios (for example 48 kHz -> 44.1 kHz). Large decimation ratios get a
+ * correspondingly wide transition band.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_RESAMPLE_TAPS             16      /**< taps per polyphase branch */
+#define AUDIO_RESAMPLE_MAX_PHASES       512     /**< largest supported interpolation factor L */
+#define AUDIO_RESAMPLE_MAX_CHANNELS     2
+#define AUDIO_RESAMPLE_COEF_SHIFT       14      /**< coefficients are stored in Q14 */
+
+typedef struct {
+    uint32_t in_rate;
+    uint32_t out_rate;
+    uint32_t channels;
+
+    uint32_t up;        /**< interpolation factor L */
+    uint32_t down;      /**< decimation factor M */
+
+    /**
+     * Position of the next output sample, in units of 1/L input samples, past the newest
+     * input sample in the delay line. Values >= up mean another input sample is required.
+     */
+    uint32_t phase;
+
+    /** up * AUDIO_RESAMPLE_TAPS coefficients, one time-reversed branch per phase */
+    int16_t *coeffs;
+    size_t coeffs_phases;   /**< number of branches coeffs has room for */
+
+    int16_t history[AUDIO_RESAMPLE_MAX_CHANNELS][2 * AUDIO_RESAMPLE_TAPS];
+    uint32_t history_pos;
+} audio_resampler_t;
+
+/**
+ * @brief Prepare a resampler that produces out_rate output
+ *
+ * @param r - resampler to initialize
+ * @param channels - interleaved channel count of both input and output (1 or 2)
+ * @param out_rate - output sample rate in Hz
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: unsupported channel count or rate
+ */
+esp_err_t audio_resampler_init(audio_resampler_t *r, uint32_t channels, uint32_t out_rate);
+
+/**
+ * @brief Set the input rate, designing the polyphase filter bank if it changed
+ *
+ * The delay line is cleared whenever the filter is redesigned.
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_NOT_SUPPORTED: the reduced ratio needs more than AUDIO_RESAMPLE_MAX_PHASES branches
+ *    - ESP_ERR_NO_MEM: coefficient table could not be allocated
+ */
+esp_err_t audio_resampler_set_input_rate(audio_resampler_t *r, uint32_t in_rate);
+
+/**
+ * @brief Clear the delay line, for example when a new stream starts
+ */
+void audio_resampler_reset(audio_resampler_t *r);
+
+/**
+ * @return true if the input and output rates are identical and samples can be passed through unchanged
+ */
+bool audio_resampler_is_passthrough(const audio_resampler_t *r);
+
+/**
+ * @brief Convert as many frames as fit in the output buffer
+ *
+ * Processing stops when either all input frames have been consumed or the output buffer is
+ * full, call again with the remaining input in the latter case.
+ *
+ * @param in - interleaved input frames
+ * @param in_frames - [in] number of input frames, [out] number of input frames consumed
+ * @param out - interleaved output frames
+ * @param out_frames - capacity of out in frames
+ * @return number of frames written to out
+ */
+size_t audio_resampler_process(audio_resampler_t *r, const int16_t *in, size_t *in_frames,
+                               int16_t *out, size_t out_frames);
+
+/**
+ * @brief Release the coefficient table
+ */
+void audio_resampler_free(audio_resampler_t *r);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file
+ *
+ * MP3 track indexing without decoding.
+ *
+ * Duration, average bitrate and a time to byte offset seek table are taken from
+ * the Xing/Info (with LAME extension) or VBRI header of the first frame when one
+ * is present. Otherwise the frame headers are walked, which needs only the 4 byte
+ * header of each frame and no Huffman decoding.
+ *
+ * The seek table holds the byte offset of every frames_per_entry'th frame, so
+ * mapping a time to an offset is a single division. Indexes can be cached on the
+ * SD card keyed by path, size and modification time so the walk only happens once
+ * per file. A walk through mp3_index_get() can be cancelled between reads, for a
+ * track that is no longer wanted or a card that is going.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MP3_INDEX_MAX_ENTRIES   256
+
+typedef struct {
+    uint8_t version;            /**< 1 MPEG-1, 2 MPEG-2, 3 MPEG-2.5 */
+    uint8_t channels;
+    uint16_t samples_per_frame;
+    uint32_t sample_rate;
+    uint32_t bitrate;           /**< bits per second */
+    uint32_t frame_bytes;       /**< including the header and padding */
+    uint8_t side_info_bytes;
+} mp3_frame_header_t;
+
+typedef enum {
+    MP3_INDEX_SOURCE_NONE,
+    MP3_INDEX_SOURCE_XING,      /**< Xing or Info header, TOC interpolated */
+    MP3_INDEX_SOURCE_VBRI,      /**< Fraunhofer VBRI header, TOC interpolated */
+    MP3_INDEX_SOURCE_SCAN,      /**< every frame header walked, exact */
+    MP3_INDEX_SOURCE_ESTIMATE,  /**< no header, constant bitrate assumed from the first frame */
+} mp3_index_source_t;
+
+typedef struct {
+    uint32_t sample_rate;
+    uint8_t channels;
+    uint8_t source;             /**< mp3_index_source_t */
+    uint16_t samples_per_frame;
+
+    uint32_t total_frames;
+    uint32_t duration_ms;       /**< excludes LAME encoder delay and padding when known */
+    uint32_t bitrate;           /**< average, bits per second */
+
+    uint32_t audio_start;       /**< offset of the first audio frame, after any ID3v2 tag and Xing/VBRI frame */
+    uint32_t audio_end;         /**< offset past the last audio frame, before any ID3v1 tag */
+
+    uint16_t encoder_delay;     /**< samples, from the LAME tag */
+    uint16_t encoder_padding;   /**< samples, from the LAME tag */
+
+    uint32_t frames_per_entry;
+    uint32_t entry_count;
+    uint32_t entries[MP3_INDEX_MAX_ENTRIES];    /**< offset of frame (n * frames_per_entry) */
+} mp3_index_t;
+
+/**
+ * @brief Decode a 4 byte MPEG audio layer III frame header
+ *
+ * @return true if the header is valid, free format bitrates are rejected
+ */
+bool mp3_parse_frame_header(const uint8_t *data, mp3_frame_header_t *header);
+
+/**
+ * @brief Size of an ID3v2 tag including its header and optional footer
+ *
+ * @param data - at least the first 10 bytes of the file
+ * @return tag size in bytes, 0 if data does not start with an ID3v2 tag
+ */
+uint32_t mp3_id3v2_size(const uint8_t *data);
+
+/**
+ * @brief Build the index of an open mp3 file
+ *
+ * The file position is left undefined.
+ *
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_NOT_FOUND: no mp3 frames found
+ *    - ESP_ERR_NO_MEM: read buffer could not be allocated
+ */
+esp_err_t mp3_index_build(FILE *fp, mp3_index_t *index);
+
+/**
+ * @brief Build the index from the Xing/VBRI header only, never walking the file
+ *
+ * Without a header the duration and seek table are estimated from the bitrate of the
+ * first frame (MP3_INDEX_SOURCE_ESTIMATE), which is exact for constant bitrate files.
+ */
+esp_err_t mp3_index_build_from_header(FILE *fp, mp3_index_t *index);
+
+/**
+ * @brief Synchronize to the first frame at or after offset and step over frames
+ *
+ * Only frame headers are read, the file position is left undefined.
+ *
+ * @param frames - [in] frames to skip, [out] frames actually skipped, fewer at the end of the file
+ * @param work - read buffer, at least one maximum size frame (1441 bytes), larger is faster
+ * @return offset of the frame reached, UINT32_MAX if no frame was found
+ */
+uint32_t mp3_index_skip_frames(FILE *fp, uint32_t offset, uint32_t *frames, uint8_t *work, size_t work_size);
+
+/**
+ * @brief Find the byte offset to start decoding from to reach position_ms
+ *
+ * @param frame - [out] optional, the frame number at offset, use it to work out the
+ *                position actually reached as the table is not frame accurate
+ * @return byte offset of a frame at or before position_ms
+ */
+uint32_t mp3_index_seek(const mp3_index_t *index, uint32_t position_ms, uint32_t *frame);
+
+/**
+ * @brief Load the index for path from cache_dir, or build and cache it
+ *
+ * The cache entry is ignored if the size or modification time of path changed.
+ * cancel is checked before every read of the file, once it is set the walk stops
+ * and nothing is written to the cache.
+ *
+ * @param cache_dir - directory to cache indexes in, created if missing, NULL disables caching
+ * @param cancel - set from another task to stop the walk, NULL if it is never cancelled
+ * @return as mp3_index_build(), ESP_ERR_NOT_FOUND also if path can't be opened,
+ *         ESP_ERR_INVALID_STATE if cancelled
+ */
+esp_err_t mp3_index_get(const char *path, const char *cache_dir, const volatile bool *cancel, mp3_index_t *index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file
+ *
+ * MP3 tag reading.
+ *
+ * ID3v2.2, 2.3 and 2.4 tags at the start of the file are walked frame by frame,
+ * only the text frames of interest are read, anything else is skipped with a single
+ * fseek(). Cover art is located but not read, the caller can read or decode it in place. ID3v1 at the end of the file fills in any field
+ * the ID3v2 tags didn't have.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MP3_METADATA_TEXT_SIZE  64
+
+typedef struct {
+    char title[MP3_METADATA_TEXT_SIZE];     /**< UTF-8, truncated on a character boundary, empty if not tagged */
+    char artist[MP3_METADATA_TEXT_SIZE];
+    char album[MP3_METADATA_TEXT_SIZE];
+
+    uint32_t audio_offset;      /**< bytes of ID3v2 tags at the start of the file, where the audio starts */
+
+    uint32_t picture_offset;    /**< image data of the front cover, or of the first picture if there is none */
+    uint32_t picture_size;      /**< 0 if the tags have no picture */
+    uint8_t picture_type;       /**< ID3v2 picture type, 3 is the front cover */
+} mp3_metadata_t;
+
+/**
+ * @brief Read the tags of an mp3 file
+ *
+ * The file position is left undefined.
+ *
+ * @param metadata - [out] fields not present in the tags are empty strings
+ * @return true if any tag was found
+ */
+bool mp3_metadata_read(FILE *fp, mp3_metadata_t *metadata);
+
+/**
+ * @brief Skip the ID3v2 tags at the start of the file
+ *
+ * Only the 10 byte header of each tag is read.
+ *
+ * @return offset of the first byte after the tags, the file is left positioned there
+ */
+uint32_t mp3_metadata_skip_id3v2(FILE *fp);
+
+#ifdef __cplusplus
+}
+#endif
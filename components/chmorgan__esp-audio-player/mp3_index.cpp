@@ -0,0 +1,689 @@
+#include <inttypes.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "audio_log.h"
+#include "mp3_index.h"
+
+static const char *TAG = "mp3_index";
+
+/** read window, a whole frame (at most 1441 bytes) always fits */
+#define INDEX_READ_BUF_SIZE     4096
+
+/** how far to search for the first frame, or for the next one after lost sync */
+#define INDEX_SYNC_SEARCH_LIMIT (64 * 1024)
+
+#define INDEX_CACHE_MAGIC       0x5849334d  // "M3IX"
+#define INDEX_CACHE_VERSION     1
+
+static const uint16_t bitrates_mpeg1[15] = { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 };
+static const uint16_t bitrates_mpeg2[15] = { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 };
+static const uint32_t sample_rates[3] = { 44100, 48000, 32000 };
+
+bool mp3_parse_frame_header(const uint8_t *data, mp3_frame_header_t *header)
+{
+    if((data[0] != 0xFF) || ((data[1] & 0xE0) != 0xE0)) {
+        return false;
+    }
+
+    uint8_t version_bits = (data[1] >> 3) & 0x03;
+    uint8_t layer_bits = (data[1] >> 1) & 0x03;
+    uint8_t bitrate_index = data[2] >> 4;
+    uint8_t sample_rate_index = (data[2] >> 2) & 0x03;
+
+    // reserved version, not layer III, free format or bad bitrate, reserved sample rate
+    if((version_bits == 1) || (layer_bits != 1) ||
+       (bitrate_index == 0) || (bitrate_index == 15) || (sample_rate_index == 3)) {
+        return false;
+    }
+
+    header->version = (version_bits == 3) ? 1 : ((version_bits == 2) ? 2 : 3);
+    bool mpeg1 = (header->version == 1);
+    bool mono = ((data[3] >> 6) == 3);
+
+    header->channels = mono ? 1 : 2;
+    header->samples_per_frame = mpeg1 ? 1152 : 576;
+    header->sample_rate = sample_rates[sample_rate_index] >> (header->version - 1);
+    header->bitrate = (mpeg1 ? bitrates_mpeg1 : bitrates_mpeg2)[bitrate_index] * 1000;
+    header->frame_bytes = (header->samples_per_frame / 8) * header->bitrate / header->sample_rate +
+                          ((data[2] >> 1) & 0x01);
+    header->side_info_bytes = mpeg1 ? (mono ? 17 : 32) : (mono ? 9 : 17);
+
+    return true;
+}
+
+uint32_t mp3_id3v2_size(const uint8_t *data)
+{
+    if((data[0] != 'I') || (data[1] != 'D') || (data[2] != '3') ||
+       (data[3] == 0xFF) || (data[4] == 0xFF)) {
+        return 0;
+    }
+
+    // size is 'synchsafe', 7 bits per byte
+    if((data[6] | data[7] | data[8] | data[9]) & 0x80) {
+        return 0;
+    }
+
+    uint32_t size = (static_cast<uint32_t>(data[6]) << 21) | (static_cast<uint32_t>(data[7]) << 14) |
+                    (static_cast<uint32_t>(data[8]) << 7) | data[9];
+    size += 10;
+
+    // footer present
+    if(data[5] & 0x10) {
+        size += 10;
+    }
+
+    return size;
+}
+
+static inline uint32_t read_be32(const uint8_t *p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+static inline uint32_t read_be(const uint8_t *p, size_t bytes)
+{
+    uint32_t v = 0;
+    while(bytes--) {
+        v = (v << 8) | *p++;
+    }
+    return v;
+}
+
+typedef struct {
+    FILE *fp;
+    uint8_t *buf;
+    size_t buf_size;
+    uint32_t buf_pos;   /**< file offset of buf[0] */
+    size_t buf_len;
+    uint32_t file_size;
+    const volatile bool *cancel;    /**< checked before every read, NULL if the walk can't be cancelled */
+    bool cancelled;
+} index_reader_t;
+
+/**
+ * @return pointer to bytes [pos, pos + len) of the file, NULL if past the end of the file or cancelled
+ */
+static const uint8_t *reader_get(index_reader_t *r, uint32_t pos, size_t len)
+{
+    if((pos + len > r->file_size) || (len > r->buf_size)) {
+        return NULL;
+    }
+
+    if((pos < r->buf_pos) || (pos + len > r->buf_pos + r->buf_len)) {
+        if(r->cancel && *r->cancel) {
+            r->cancelled = true;
+            return NULL;
+        }
+        if(fseek(r->fp, pos, SEEK_SET) != 0) {
+            return NULL;
+        }
+        r->buf_pos = pos;
+        r->buf_len = fread(r->buf, 1, r->buf_size, r->fp);
+        if(len > r->buf_len) {
+            return NULL;
+        }
+    }
+
+    return r->buf + (pos - r->buf_pos);
+}
+
+static bool same_stream(const mp3_frame_header_t *a, const mp3_frame_header_t *b)
+{
+    return (a->version == b->version) && (a->sample_rate == b->sample_rate);
+}
+
+/**
+ * Search forward from pos for a frame header that is followed by another valid header,
+ * which makes false syncs on random data unlikely.
+ *
+ * @param match - if not NULL the frame must belong to the same stream
+ * @return offset of the frame, UINT32_MAX if none found
+ */
+static uint32_t find_frame(index_reader_t *r, uint32_t pos, uint32_t end,
+                           const mp3_frame_header_t *match, mp3_frame_header_t *header)
+{
+    uint32_t limit = (end - pos > INDEX_SYNC_SEARCH_LIMIT) ? pos + INDEX_SYNC_SEARCH_LIMIT : end;
+
+    for(; pos + 4 <= limit; pos++) {
+        const uint8_t *data = reader_get(r, pos, 4);
+        if(!data) {
+            break;
+        }
+        if(!mp3_parse_frame_header(data, header)) {
+            continue;
+        }
+        if(match && !same_stream(match, header)) {
+            continue;
+        }
+
+        uint32_t next = pos + header->frame_bytes;
+        if(next + 4 > end) {
+            // last frame in the file, nothing to confirm it with
+            if(next <= end) {
+                return pos;
+            }
+            continue;
+        }
+
+        mp3_frame_header_t next_header;
+        data = reader_get(r, next, 4);
+        if(data && mp3_parse_frame_header(data, &next_header) && same_stream(header, &next_header)) {
+            return pos;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+static void set_grid(mp3_index_t *index)
+{
+    index->frames_per_entry = (index->total_frames + MP3_INDEX_MAX_ENTRIES - 1) / MP3_INDEX_MAX_ENTRIES;
+    if(index->frames_per_entry == 0) {
+        index->frames_per_entry = 1;
+    }
+    index->entry_count = (index->total_frames + index->frames_per_entry - 1) / index->frames_per_entry;
+    if(index->entry_count == 0) {
+        index->entry_count = 1;
+    }
+}
+
+/**
+ * Xing TOC, toc[n] is the position at n% of the duration in 1/256ths of stream_bytes
+ */
+static void fill_from_xing_toc(mp3_index_t *index, const uint8_t *toc, uint32_t stream_start, uint32_t stream_bytes)
+{
+    for(uint32_t e = 0; e < index->entry_count; e++) {
+        float percent = (e * index->frames_per_entry) * 100.0f / index->total_frames;
+        uint32_t n = static_cast<uint32_t>(percent);
+        if(n > 99) {
+            n = 99;
+        }
+        float a = toc[n];
+        float b = (n < 99) ? toc[n + 1] : 256.0f;
+        float position = a + (b - a) * (percent - n);
+        uint32_t offset = stream_start + static_cast<uint32_t>(position * stream_bytes / 256.0f);
+
+        index->entries[e] = (offset < index->audio_start) ? index->audio_start : offset;
+    }
+}
+
+/**
+ * No TOC, assume a constant bitrate between audio_start and audio_end
+ */
+static void fill_linear(mp3_index_t *index)
+{
+    uint32_t bytes = index->audio_end - index->audio_start;
+    for(uint32_t e = 0; e < index->entry_count; e++) {
+        index->entries[e] = index->audio_start +
+            static_cast<uint32_t>(static_cast<uint64_t>(e) * index->frames_per_entry * bytes / index->total_frames);
+    }
+}
+
+/**
+ * @return true if a Xing/Info header with a frame count was found
+ */
+static bool parse_xing(mp3_index_t *index, const uint8_t *frame, const mp3_frame_header_t *header, uint32_t frame_pos)
+{
+    uint32_t xing_offset = 4 + header->side_info_bytes;
+    if(xing_offset + 8 > header->frame_bytes) {
+        return false;
+    }
+
+    const uint8_t *xing = frame + xing_offset;
+    if(memcmp(xing, "Xing", 4) != 0 && memcmp(xing, "Info", 4) != 0) {
+        return false;
+    }
+
+    uint32_t flags = read_be32(xing + 4);
+    const uint8_t *p = xing + 8;
+    const uint8_t *frame_end = frame + header->frame_bytes;
+
+    uint32_t frames = 0;
+    uint32_t bytes = 0;
+    const uint8_t *toc = NULL;
+
+    if(flags & 0x01) {
+        if(p + 4 > frame_end) return false;
+        frames = read_be32(p);
+        p += 4;
+    }
+    if(flags & 0x02) {
+        if(p + 4 > frame_end) return false;
+        bytes = read_be32(p);
+        p += 4;
+    }
+    if(flags & 0x04) {
+        if(p + 100 > frame_end) return false;
+        toc = p;
+        p += 100;
+    }
+    if(flags & 0x08) {
+        p += 4;
+    }
+
+    // the Xing frame itself is silent, audio starts after it
+    index->audio_start = frame_pos + header->frame_bytes;
+
+    // LAME (and libavcodec) extension, encoder delay and padding are 12 bits each
+    if((p + 24 <= frame_end) &&
+       (memcmp(p, "LAME", 4) == 0 || memcmp(p, "Lavf", 4) == 0 || memcmp(p, "Lavc", 4) == 0)) {
+        index->encoder_delay = (p[21] << 4) | (p[22] >> 4);
+        index->encoder_padding = ((p[22] & 0x0F) << 8) | p[23];
+    }
+
+    if(frames == 0) {
+        // without a frame count the header is no use for the duration
+        return false;
+    }
+
+    index->total_frames = frames;
+    index->source = MP3_INDEX_SOURCE_XING;
+    set_grid(index);
+
+    if(toc && bytes > header->frame_bytes) {
+        fill_from_xing_toc(index, toc, frame_pos, bytes);
+    } else {
+        fill_linear(index);
+    }
+
+    return true;
+}
+
+/**
+ * @return true if a VBRI header was found
+ */
+static bool parse_vbri(mp3_index_t *index, const uint8_t *frame, const mp3_frame_header_t *header, uint32_t frame_pos)
+{
+    // always 32 bytes after the frame header regardless of the side info size
+    const uint32_t vbri_offset = 4 + 32;
+    if(vbri_offset + 26 > header->frame_bytes) {
+        return false;
+    }
+
+    const uint8_t *vbri = frame + vbri_offset;
+    if(memcmp(vbri, "VBRI", 4) != 0) {
+        return false;
+    }
+
+    uint32_t frames = read_be32(vbri + 14);
+    uint32_t toc_entries = read_be(vbri + 18, 2);
+    uint32_t toc_scale = read_be(vbri + 20, 2);
+    uint32_t toc_entry_bytes = read_be(vbri + 22, 2);
+    uint32_t toc_frames_per_entry = read_be(vbri + 24, 2);
+    const uint8_t *toc = vbri + 26;
+
+    if(frames == 0) {
+        return false;
+    }
+
+    index->audio_start = frame_pos + header->frame_bytes;
+    index->total_frames = frames;
+    index->source = MP3_INDEX_SOURCE_VBRI;
+    set_grid(index);
+
+    bool toc_valid = (toc_entries > 0) && (toc_frames_per_entry > 0) &&
+                     (toc_entry_bytes >= 1) && (toc_entry_bytes <= 4) &&
+                     (vbri_offset + 26 + toc_entries * toc_entry_bytes <= header->frame_bytes);
+    if(!toc_valid) {
+        fill_linear(index);
+        return true;
+    }
+
+    // each TOC entry is the size of the next toc_frames_per_entry frames, walk it alongside the grid
+    uint32_t toc_index = 0;
+    uint32_t toc_offset = index->audio_start;
+    for(uint32_t e = 0; e < index->entry_count; e++) {
+        uint32_t frame_number = e * index->frames_per_entry;
+
+        while((toc_index < toc_entries) && ((toc_index + 1) * toc_frames_per_entry <= frame_number)) {
+            toc_offset += read_be(toc + toc_index * toc_entry_bytes, toc_entry_bytes) * toc_scale;
+            toc_index++;
+        }
+
+        uint32_t offset = toc_offset;
+        if(toc_index < toc_entries) {
+            uint32_t span = read_be(toc + toc_index * toc_entry_bytes, toc_entry_bytes) * toc_scale;
+            offset += static_cast<uint64_t>(span) * (frame_number - toc_index * toc_frames_per_entry) / toc_frames_per_entry;
+        }
+        index->entries[e] = offset;
+    }
+
+    return true;
+}
+
+/**
+ * Walk every frame header from pos, recording each frames_per_entry'th offset. The
+ * spacing doubles whenever the table fills up so it is independent of the file length.
+ */
+static esp_err_t scan_frames(index_reader_t *r, mp3_index_t *index, uint32_t pos, const mp3_frame_header_t *first)
+{
+    uint32_t frames = 0;
+    uint32_t last_frame_end = pos;
+
+    index->frames_per_entry = 1;
+    index->entry_count = 0;
+
+    while(pos + 4 <= index->audio_end) {
+        mp3_frame_header_t header;
+        const uint8_t *data = reader_get(r, pos, 4);
+        if(!data) {
+            break;
+        }
+
+        if(!mp3_parse_frame_header(data, &header) || !same_stream(first, &header)) {
+            LOGI_1("lost sync at %" PRIu32 ", frame %" PRIu32, pos, frames);
+            pos = find_frame(r, pos + 1, index->audio_end, first, &header);
+            if(pos == UINT32_MAX) {
+                break;
+            }
+        }
+
+        if(pos + header.frame_bytes > index->audio_end) {
+            // truncated final frame
+            break;
+        }
+
+        if((frames % index->frames_per_entry) == 0) {
+            if(index->entry_count == MP3_INDEX_MAX_ENTRIES) {
+                for(uint32_t e = 0; e < MP3_INDEX_MAX_ENTRIES / 2; e++) {
+                    index->entries[e] = index->entries[e * 2];
+                }
+                index->entry_count = MP3_INDEX_MAX_ENTRIES / 2;
+                index->frames_per_entry *= 2;
+            }
+            if((frames % index->frames_per_entry) == 0) {
+                index->entries[index->entry_count++] = pos;
+            }
+        }
+
+        pos += header.frame_bytes;
+        last_frame_end = pos;
+        frames++;
+    }
+
+    if(frames == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    index->total_frames = frames;
+    index->audio_end = last_frame_end;
+    index->source = MP3_INDEX_SOURCE_SCAN;
+
+    return ESP_OK;
+}
+
+static esp_err_t index_file(FILE *fp, mp3_index_t *index, bool walk, const volatile bool *cancel)
+{
+    esp_err_t ret = ESP_OK;
+    index_reader_t reader = {};
+    mp3_frame_header_t header;
+    const uint8_t *data;
+    uint32_t pos = 0;
+    uint32_t first;
+
+    memset(index, 0, sizeof(*index));
+
+    if(fseek(fp, 0, SEEK_END) != 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    long file_size = ftell(fp);
+    if(file_size <= 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    reader.fp = fp;
+    reader.file_size = static_cast<uint32_t>(file_size);
+    reader.cancel = cancel;
+    reader.buf_size = INDEX_READ_BUF_SIZE;
+    reader.buf = static_cast<uint8_t*>(malloc(reader.buf_size));
+    if(!reader.buf) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // skip any ID3v2 tags, some files have more than one
+    while((data = reader_get(&reader, pos, 10)) != NULL) {
+        uint32_t tag_size = mp3_id3v2_size(data);
+        if(tag_size == 0) {
+            break;
+        }
+        pos += tag_size;
+    }
+
+    index->audio_end = reader.file_size;
+    if((reader.file_size >= pos + 128) &&
+       (data = reader_get(&reader, reader.file_size - 128, 3)) != NULL &&
+       (memcmp(data, "TAG", 3) == 0)) {
+        index->audio_end -= 128;
+    }
+
+    first = find_frame(&reader, pos, index->audio_end, NULL, &header);
+    if(first == UINT32_MAX) {
+        ESP_LOGE(TAG, "no mp3 frames found");
+        ret = ESP_ERR_NOT_FOUND;
+        goto clean_up;
+    }
+
+    index->sample_rate = header.sample_rate;
+    index->channels = header.channels;
+    index->samples_per_frame = header.samples_per_frame;
+    index->audio_start = first;
+
+    data = reader_get(&reader, first, header.frame_bytes);
+    if(data && (parse_xing(index, data, &header, first) || parse_vbri(index, data, &header, first))) {
+        LOGI_1("%s header, %" PRIu32 " frames",
+               (index->source == MP3_INDEX_SOURCE_XING) ? "xing" : "vbri", index->total_frames);
+    } else if(!walk) {
+        // assume the bitrate of the first frame holds for the whole file
+        uint32_t bytes = index->audio_end - index->audio_start;
+        index->total_frames = bytes / header.frame_bytes;
+        if(index->total_frames == 0) {
+            index->total_frames = 1;
+        }
+        index->source = MP3_INDEX_SOURCE_ESTIMATE;
+        set_grid(index);
+        fill_linear(index);
+        LOGI_1("estimated %" PRIu32 " frames", index->total_frames);
+    } else {
+        // audio_start moves past an Info frame that had no frame count
+        ret = scan_frames(&reader, index, index->audio_start, &header);
+        if(ret != ESP_OK) {
+            goto clean_up;
+        }
+        LOGI_1("scanned %" PRIu32 " frames", index->total_frames);
+    }
+
+    {
+        uint64_t total_samples = static_cast<uint64_t>(index->total_frames) * index->samples_per_frame;
+        uint32_t trimmed = index->encoder_delay + index->encoder_padding;
+        if(total_samples > trimmed) {
+            total_samples -= trimmed;
+        }
+        index->duration_ms = static_cast<uint32_t>(total_samples * 1000 / index->sample_rate);
+        if(index->duration_ms) {
+            index->bitrate = static_cast<uint32_t>(
+                static_cast<uint64_t>(index->audio_end - index->audio_start) * 8 * 1000 / index->duration_ms);
+        }
+    }
+
+clean_up:
+    free(reader.buf);
+    if(reader.cancelled) {
+        // a read that didn't happen looks like the end of the file, the index is short
+        LOGI_1("cancelled at %" PRIu32, reader.buf_pos);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ret;
+}
+
+esp_err_t mp3_index_build(FILE *fp, mp3_index_t *index)
+{
+    return index_file(fp, index, true, NULL);
+}
+
+esp_err_t mp3_index_build_from_header(FILE *fp, mp3_index_t *index)
+{
+    return index_file(fp, index, false, NULL);
+}
+
+uint32_t mp3_index_skip_frames(FILE *fp, uint32_t offset, uint32_t *frames, uint8_t *work, size_t work_size)
+{
+    index_reader_t reader = {};
+    mp3_frame_header_t current, next;
+
+    if(fseek(fp, 0, SEEK_END) != 0) {
+        return UINT32_MAX;
+    }
+    long file_size = ftell(fp);
+    if(file_size <= 0) {
+        return UINT32_MAX;
+    }
+
+    reader.fp = fp;
+    reader.buf = work;
+    reader.buf_size = work_size;
+    reader.file_size = static_cast<uint32_t>(file_size);
+
+    uint32_t pos = find_frame(&reader, offset, reader.file_size, NULL, &current);
+    if(pos == UINT32_MAX) {
+        return UINT32_MAX;
+    }
+
+    uint32_t skipped = 0;
+    while(skipped < *frames) {
+        const uint8_t *data = reader_get(&reader, pos + current.frame_bytes, 4);
+        if(!data || !mp3_parse_frame_header(data, &next) || !same_stream(&current, &next)) {
+            break;
+        }
+        pos += current.frame_bytes;
+        current = next;
+        skipped++;
+    }
+
+    *frames = skipped;
+    return pos;
+}
+
+uint32_t mp3_index_seek(const mp3_index_t *index, uint32_t position_ms, uint32_t *frame)
+{
+    if((index->entry_count == 0) || (index->sample_rate == 0)) {
+        if(frame) *frame = 0;
+        return index->audio_start;
+    }
+
+    uint64_t target = static_cast<uint64_t>(position_ms) * index->sample_rate /
+                      (1000ULL * index->samples_per_frame);
+    uint32_t entry = target / index->frames_per_entry;
+    if(entry >= index->entry_count) {
+        entry = index->entry_count - 1;
+    }
+
+    if(frame) *frame = entry * index->frames_per_entry;
+    return index->entries[entry];
+}
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t path_hash;
+    uint32_t file_size;
+    uint32_t file_mtime;
+} index_cache_key_t;
+
+/** FNV-1a */
+static uint32_t hash_path(const char *path)
+{
+    uint32_t hash = 2166136261u;
+    while(*path) {
+        hash ^= static_cast<uint8_t>(*path++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool cache_load(const char *cache_path, const index_cache_key_t *key, mp3_index_t *index)
+{
+    FILE *fp = fopen(cache_path, "rb");
+    if(!fp) {
+        return false;
+    }
+
+    index_cache_key_t stored;
+    bool hit = (fread(&stored, 1, sizeof(stored), fp) == sizeof(stored)) &&
+               (memcmp(&stored, key, sizeof(stored)) == 0) &&
+               (fread(index, 1, sizeof(*index), fp) == sizeof(*index)) &&
+               (index->entry_count <= MP3_INDEX_MAX_ENTRIES);
+    fclose(fp);
+
+    return hit;
+}
+
+static void cache_save(const char *cache_dir, const char *cache_path, const index_cache_key_t *key,
+                       const mp3_index_t *index)
+{
+    if((mkdir(cache_dir, 0775) != 0) && (errno != EEXIST)) {
+        ESP_LOGW(TAG, "can't create %s, errno %d", cache_dir, errno);
+        return;
+    }
+
+    FILE *fp = fopen(cache_path, "wb");
+    if(!fp) {
+        ESP_LOGW(TAG, "can't write %s, errno %d", cache_path, errno);
+        return;
+    }
+
+    bool ok = (fwrite(key, 1, sizeof(*key), fp) == sizeof(*key)) &&
+              (fwrite(index, 1, sizeof(*index), fp) == sizeof(*index));
+    ok = (fclose(fp) == 0) && ok;
+
+    if(!ok) {
+        // don't leave a truncated entry behind, it would fail the size check anyway
+        remove(cache_path);
+    }
+}
+
+esp_err_t mp3_index_get(const char *path, const char *cache_dir, const volatile bool *cancel, mp3_index_t *index)
+{
+    struct stat st;
+    if(stat(path, &st) != 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    index_cache_key_t key = {
+        .magic = INDEX_CACHE_MAGIC,
+        .version = INDEX_CACHE_VERSION,
+        .path_hash = hash_path(path),
+        .file_size = static_cast<uint32_t>(st.st_size),
+        .file_mtime = static_cast<uint32_t>(st.st_mtime),
+    };
+
+    char cache_path[128];
+    bool use_cache = false;
+    if(cache_dir) {
+        int len = snprintf(cache_path, sizeof(cache_path), "%s/%08" PRIx32 ".idx", cache_dir, key.path_hash);
+        use_cache = (len > 0) && (static_cast<size_t>(len) < sizeof(cache_path));
+    }
+
+    if(use_cache && cache_load(cache_path, &key, index)) {
+        LOGI_1("cached index for %s", path);
+        return ESP_OK;
+    }
+
+    if(cancel && *cancel) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    FILE *fp = fopen(path, "rb");
+    if(!fp) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    esp_err_t ret = index_file(fp, index, true, cancel);
+    fclose(fp);
+
+    if((ret == ESP_OK) && use_cache) {
+        cache_save(cache_dir, cache_path, &key, index);
+    }
+
+    return ret;
+}
@@ -0,0 +1,386 @@
+#include <stddef.h>
+#include <string.h>
+#include "audio_log.h"
+#include "audio_mp3.h"
+#include "mp3_index.h"
+#include "mp3_metadata.h"
+
+static const char *TAG = "mp3_metadata";
+
+/** most of a text frame that is read, enough for any value that fits MP3_METADATA_TEXT_SIZE as UTF-16 */
+#define METADATA_FRAME_READ_MAX     (MP3_METADATA_TEXT_SIZE * 2 + 8)
+
+typedef struct {
+    char id[5];                 /**< ID3v2.3 and 2.4 */
+    char id_v22[4];             /**< ID3v2.2 */
+    size_t field;               /**< offset in mp3_metadata_t */
+} text_frame_t;
+
+static const text_frame_t text_frames[] = {
+    { "TIT2", "TT2", offsetof(mp3_metadata_t, title) },
+    { "TPE1", "TP1", offsetof(mp3_metadata_t, artist) },
+    { "TALB", "TAL", offsetof(mp3_metadata_t, album) },
+};
+
+static uint32_t be32(const uint8_t *data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+static uint32_t synchsafe32(const uint8_t *data)
+{
+    return (static_cast<uint32_t>(data[0] & 0x7F) << 21) | (static_cast<uint32_t>(data[1] & 0x7F) << 14) |
+           (static_cast<uint32_t>(data[2] & 0x7F) << 7) | (data[3] & 0x7F);
+}
+
+/**
+ * Append a code point to a UTF-8 string
+ *
+ * @return false once the string is full, a character that doesn't fit whole is dropped
+ */
+static bool put_utf8(char *out, size_t *len, uint32_t cp)
+{
+    uint8_t bytes[4];
+    size_t n;
+    if(cp < 0x80) {
+        bytes[0] = cp;
+        n = 1;
+    } else if(cp < 0x800) {
+        bytes[0] = 0xC0 | (cp >> 6);
+        bytes[1] = 0x80 | (cp & 0x3F);
+        n = 2;
+    } else if(cp < 0x10000) {
+        bytes[0] = 0xE0 | (cp >> 12);
+        bytes[1] = 0x80 | ((cp >> 6) & 0x3F);
+        bytes[2] = 0x80 | (cp & 0x3F);
+        n = 3;
+    } else {
+        bytes[0] = 0xF0 | (cp >> 18);
+        bytes[1] = 0x80 | ((cp >> 12) & 0x3F);
+        bytes[2] = 0x80 | ((cp >> 6) & 0x3F);
+        bytes[3] = 0x80 | (cp & 0x3F);
+        n = 4;
+    }
+
+    if(*len + n >= MP3_METADATA_TEXT_SIZE) {
+        return false;
+    }
+    memcpy(out + *len, bytes, n);
+    *len += n;
+    return true;
+}
+
+static void decode_latin1(const uint8_t *data, size_t size, char *out, size_t *len)
+{
+    for(size_t n = 0; (n < size) && data[n]; n++) {
+        if(!put_utf8(out, len, data[n])) {
+            break;
+        }
+    }
+}
+
+static void decode_utf16(const uint8_t *data, size_t size, bool big_endian, char *out, size_t *len)
+{
+    for(size_t n = 0; n + 1 < size; n += 2) {
+        uint32_t cp = big_endian ? (data[n] << 8) | data[n + 1] : (data[n + 1] << 8) | data[n];
+        if(cp == 0) {
+            break;
+        }
+        if((cp >= 0xD800) && (cp < 0xDC00) && (n + 3 < size)) {
+            uint32_t low = big_endian ? (data[n + 2] << 8) | data[n + 3] : (data[n + 3] << 8) | data[n + 2];
+            if((low >= 0xDC00) && (low < 0xE000)) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                n += 2;
+            }
+        }
+        if((cp >= 0xD800) && (cp < 0xE000)) {
+            cp = 0xFFFD;    // unpaired surrogate
+        }
+        if(!put_utf8(out, len, cp)) {
+            break;
+        }
+    }
+}
+
+static void decode_utf8(const uint8_t *data, size_t size, char *out, size_t *len)
+{
+    size_t n = 0;
+    while((n < size) && data[n]) {
+        size_t bytes = (data[n] < 0x80) ? 1 : ((data[n] >> 5) == 0x06) ? 2 : ((data[n] >> 4) == 0x0E) ? 3 : 4;
+        if((n + bytes > size) || (*len + bytes >= MP3_METADATA_TEXT_SIZE)) {
+            break;
+        }
+        memcpy(out + *len, data + n, bytes);
+        *len += bytes;
+        n += bytes;
+    }
+}
+
+/**
+ * Convert the text of a frame, or of an ID3v1 field when encoding is 0, to UTF-8
+ *
+ * Only the first value of an ID3v2.4 multi value frame is kept.
+ */
+static void decode_text(uint8_t encoding, const uint8_t *data, size_t size, char *out)
+{
+    size_t len = 0;
+    switch(encoding) {
+        case 0:     // ISO-8859-1
+            decode_latin1(data, size, out, &len);
+            break;
+        case 1:     // UTF-16 with byte order mark
+            if((size >= 2) && (data[0] == 0xFE) && (data[1] == 0xFF)) {
+                decode_utf16(data + 2, size - 2, true, out, &len);
+            } else if((size >= 2) && (data[0] == 0xFF) && (data[1] == 0xFE)) {
+                decode_utf16(data + 2, size - 2, false, out, &len);
+            } else {
+                decode_utf16(data, size, false, out, &len);
+            }
+            break;
+        case 2:     // UTF-16BE
+            decode_utf16(data, size, true, out, &len);
+            break;
+        case 3:     // UTF-8
+            decode_utf8(data, size, out, &len);
+            break;
+        default:
+            break;
+    }
+
+    // ID3v1 fields and some taggers pad with spaces
+    while((len > 0) && (out[len - 1] == ' ')) {
+        len--;
+    }
+    out[len] = '\0';
+}
+
+/** undo ID3v2.4 frame unsynchronisation in place, 0xFF 0x00 becomes 0xFF */
+static size_t resynchronise(uint8_t *data, size_t size)
+{
+    size_t out = 0;
+    for(size_t n = 0; n < size; n++) {
+        data[out++] = data[n];
+        if((data[n] == 0xFF) && (n + 1 < size) && (data[n + 1] == 0x00)) {
+            n++;
+        }
+    }
+    return out;
+}
+
+static char *find_field(mp3_metadata_t *metadata, const uint8_t *id, uint8_t version)
+{
+    for(size_t t = 0; t < sizeof(text_frames) / sizeof(text_frames[0]); t++) {
+        const text_frame_t &frame = text_frames[t];
+        if((version == 2) ? (memcmp(id, frame.id_v22, 3) == 0) : (memcmp(id, frame.id, 4) == 0)) {
+            return reinterpret_cast<char*>(metadata) + frame.field;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Locate the image data of an APIC (PIC in 2.2) frame, the image itself is not read
+ *
+ * @param data - the start of the frame, size bytes of it
+ * @param frame_size - the whole frame
+ */
+static void find_picture(const uint8_t *data, size_t size, uint8_t version, uint32_t data_pos, uint32_t frame_size,
+                         mp3_metadata_t *metadata)
+{
+    // text encoding, MIME type (a 3 character format in 2.2), picture type, description
+    uint8_t encoding = data[0];
+    size_t n = 1;
+    if(version == 2) {
+        n += 3;
+    } else {
+        while((n < size) && data[n]) {
+            n++;
+        }
+        n++;
+    }
+    if(n >= size) {
+        return;
+    }
+    uint8_t type = data[n++];
+
+    bool wide = (encoding == 1) || (encoding == 2);
+    while(wide ? ((n + 1 < size) && (data[n] || data[n + 1])) : ((n < size) && data[n])) {
+        n += wide ? 2 : 1;
+    }
+    n += wide ? 2 : 1;
+    if(n >= size) {
+        return;
+    }
+
+    // the front cover wins over any other picture
+    if(!metadata->picture_size || ((type == 3) && (metadata->picture_type != 3))) {
+        metadata->picture_offset = data_pos + n;
+        metadata->picture_size = frame_size - n;
+        metadata->picture_type = type;
+    }
+}
+
+/**
+ * Read the text frames of one ID3v2 tag and locate its picture, every other frame is
+ * skipped without reading it
+ *
+ * @param header - the 10 byte tag header at tag_start
+ */
+static void read_id3v2(FILE *fp, uint32_t tag_start, const uint8_t *header, mp3_metadata_t *metadata)
+{
+    uint8_t version = header[3];
+    uint8_t flags = header[5];
+    uint32_t tag_end = tag_start + 10 + synchsafe32(header + 6);
+
+    // whole tag unsynchronisation (2.2 and 2.3) and 2.2 compression change the frame layout,
+    // these are rare enough that the tag is skipped rather than read byte by byte
+    if((version < 2) || (version > 4) || ((version < 4) && (flags & 0x80)) || ((version == 2) && (flags & 0x40))) {
+        LOGI_1("ID3v2.%d flags 0x%02x, tag skipped", version, flags);
+        return;
+    }
+
+    uint32_t pos = tag_start + 10;
+    uint8_t frame[METADATA_FRAME_READ_MAX];
+
+    // extended header, its size excludes itself in 2.3
+    if((version >= 3) && (flags & 0x40)) {
+        if((fseek(fp, pos, SEEK_SET) != 0) || (fread(frame, 1, 4, fp) != 4)) {
+            return;
+        }
+        pos += (version == 3) ? be32(frame) + 4 : synchsafe32(frame);
+    }
+
+    size_t header_size = (version == 2) ? 6 : 10;
+    while(pos + header_size <= tag_end) {
+        if((fseek(fp, pos, SEEK_SET) != 0) || (fread(frame, 1, header_size, fp) != header_size)) {
+            return;
+        }
+
+        // padding
+        if(frame[0] == 0) {
+            return;
+        }
+
+        uint32_t size;
+        uint16_t frame_flags = 0;
+        if(version == 2) {
+            size = (static_cast<uint32_t>(frame[3]) << 16) | (frame[4] << 8) | frame[5];
+        } else if(version == 3) {
+            size = be32(frame + 4);
+            frame_flags = (frame[8] << 8) | frame[9];
+        } else {
+            // some writers put a plain 32-bit size in 2.4 tags
+            size = ((frame[4] | frame[5] | frame[6] | frame[7]) & 0x80) ? be32(frame + 4) : synchsafe32(frame + 4);
+            frame_flags = (frame[8] << 8) | frame[9];
+        }
+
+        uint32_t data_pos = pos + header_size;
+        if((size == 0) || (size > tag_end - data_pos)) {
+            return;
+        }
+
+        // compressed or encrypted frames can't be read in place
+        bool readable = (version == 2) || ((version == 3) ? !(frame_flags & 0x00C0) : !(frame_flags & 0x000C));
+        char *field = find_field(metadata, frame, version);
+        bool picture = (version == 2) ? (memcmp(frame, "PIC", 3) == 0) : (memcmp(frame, "APIC", 4) == 0);
+
+        // the offset of an unsynchronised picture wouldn't point at the image
+        if(picture && readable && !((version == 4) && (frame_flags & 0x0002))) {
+            size_t n = (size < sizeof(frame)) ? size : sizeof(frame);
+            if(fread(frame, 1, n, fp) != n) {
+                return;
+            }
+            uint32_t skip = ((version == 4) && (frame_flags & 0x0001)) ? 4 : 0;
+            if(n > skip) {
+                find_picture(frame + skip, n - skip, version, data_pos + skip, size - skip, metadata);
+            }
+        } else if(field && !field[0] && readable) {
+            size_t n = (size < sizeof(frame)) ? size : sizeof(frame);
+            if(fread(frame, 1, n, fp) != n) {
+                return;
+            }
+
+            uint8_t *data = frame;
+            if((version == 4) && (frame_flags & 0x0001) && (n >= 4)) {
+                // data length indicator
+                data += 4;
+                n -= 4;
+            }
+            if((version == 4) && (frame_flags & 0x0002)) {
+                n = resynchronise(data, n);
+            }
+            if(n > 1) {
+                decode_text(data[0], data + 1, n - 1, field);
+            }
+        }
+
+        pos = data_pos + size;
+    }
+}
+
+static bool read_id3v1(FILE *fp, mp3_metadata_t *metadata)
+{
+    mp3_id3_header_v1_t tag;
+    if((fseek(fp, -static_cast<long>(sizeof(tag)), SEEK_END) != 0) || (fread(&tag, 1, sizeof(tag), fp) != sizeof(tag)) ||
+       (memcmp(tag.header, "TAG", sizeof(tag.header)) != 0)) {
+        return false;
+    }
+
+    if(!metadata->title[0]) {
+        decode_text(0, reinterpret_cast<const uint8_t*>(tag.title), sizeof(tag.title), metadata->title);
+    }
+    if(!metadata->artist[0]) {
+        decode_text(0, reinterpret_cast<const uint8_t*>(tag.artist), sizeof(tag.artist), metadata->artist);
+    }
+    if(!metadata->album[0]) {
+        decode_text(0, reinterpret_cast<const uint8_t*>(tag.album), sizeof(tag.album), metadata->album);
+    }
+    return true;
+}
+
+uint32_t mp3_metadata_skip_id3v2(FILE *fp)
+{
+    uint32_t pos = 0;
+    uint8_t header[10];
+
+    // some files have more than one tag
+    while((fseek(fp, pos, SEEK_SET) == 0) && (fread(header, 1, sizeof(header), fp) == sizeof(header))) {
+        uint32_t tag_size = mp3_id3v2_size(header);
+        if(tag_size == 0) {
+            break;
+        }
+        pos += tag_size;
+    }
+
+    fseek(fp, pos, SEEK_SET);
+    return pos;
+}
+
+bool mp3_metadata_read(FILE *fp, mp3_metadata_t *metadata)
+{
+    memset(metadata, 0, sizeof(*metadata));
+
+    bool found = false;
+    uint32_t pos = 0;
+    uint8_t header[10];
+    while((fseek(fp, pos, SEEK_SET) == 0) && (fread(header, 1, sizeof(header), fp) == sizeof(header))) {
+        uint32_t tag_size = mp3_id3v2_size(header);
+        if(tag_size == 0) {
+            break;
+        }
+        read_id3v2(fp, pos, header, metadata);
+        found = true;
+        pos += tag_size;
+    }
+    metadata->audio_offset = pos;
+
+    if(!metadata->title[0] || !metadata->artist[0] || !metadata->album[0]) {
+        found |= read_id3v1(fp, metadata);
+    }
+
+    LOGI_1("audio at %d, title '%s', artist '%s', album '%s'",
+           (int)metadata->audio_offset, metadata->title, metadata->artist, metadata->album);
+
+    return found;
+}
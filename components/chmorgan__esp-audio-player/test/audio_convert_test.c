@@ -0,0 +1,145 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_cpu.h"
+#include "unity.h"
+#include "audio_convert.h"
+
+static const char *TAG = "CONVERT TEST";
+
+#define TEST_FRAMES     1152    // one mp3 frame
+#define TEST_GAIN       0x5a82  // -3dB
+
+static const uint16_t test_gains[] = { 0, 0x2000, TEST_GAIN, AUDIO_CONVERT_GAIN_UNITY, 0xffff };
+
+static void fill_random(void *buf, size_t bytes)
+{
+    uint8_t *p = (uint8_t*)buf;
+    for(size_t n = 0; n < bytes; n++) {
+        p[n] = (uint8_t)rand();
+    }
+}
+
+TEST_CASE("audio convert kernels match the scalar references", "[audio convert]")
+{
+    // +2 leaves room to test unaligned buffers
+    int16_t *src = malloc((TEST_FRAMES * 2 + 2) * sizeof(int32_t));
+    int16_t *out = malloc((TEST_FRAMES * 2 + 2) * sizeof(int32_t));
+    int16_t *ref = malloc((TEST_FRAMES * 2 + 2) * sizeof(int32_t));
+    int16_t *left = malloc((TEST_FRAMES + 1) * sizeof(int16_t));
+    int16_t *right = malloc((TEST_FRAMES + 1) * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(out);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(left);
+    TEST_ASSERT_NOT_NULL(right);
+
+    for(size_t g = 0; g < sizeof(test_gains) / sizeof(test_gains[0]); g++) {
+        uint16_t gain = test_gains[g];
+        for(size_t offset = 0; offset < 2; offset++) {
+            for(size_t frames = TEST_FRAMES - 1; frames <= TEST_FRAMES; frames++) {
+                fill_random(src, (TEST_FRAMES * 2 + 2) * sizeof(int32_t));
+
+                // mono -> stereo, in place as the player uses it
+                memcpy(out, src, frames * sizeof(int16_t) + offset * 2);
+                audio_convert_mono_to_stereo(out + offset, out + offset, frames, gain);
+                audio_convert_mono_to_stereo_ref(ref, src + offset, frames, gain);
+                TEST_ASSERT_EQUAL_INT16_ARRAY(ref, out + offset, frames * 2);
+
+                memcpy(out, src, frames * 2 * sizeof(int16_t) + offset * 2);
+                memcpy(ref, src, frames * 2 * sizeof(int16_t) + offset * 2);
+                audio_convert_gain(out + offset, frames * 2, gain);
+                audio_convert_gain_ref(ref + offset, frames * 2, gain);
+                TEST_ASSERT_EQUAL_INT16_ARRAY(ref + offset, out + offset, frames * 2);
+
+                audio_convert_s24_to_s16(out + offset, (const uint8_t*)src, frames * 2, gain);
+                audio_convert_s24_to_s16_ref(ref, (const uint8_t*)src, frames * 2, gain);
+                TEST_ASSERT_EQUAL_INT16_ARRAY(ref, out + offset, frames * 2);
+
+                audio_convert_s32_to_s16(out + offset, (const int32_t*)src, frames * 2, gain);
+                audio_convert_s32_to_s16_ref(ref, (const int32_t*)src, frames * 2, gain);
+                TEST_ASSERT_EQUAL_INT16_ARRAY(ref, out + offset, frames * 2);
+            }
+        }
+    }
+
+    for(size_t offset = 0; offset < 2; offset++) {
+        fill_random(src, (TEST_FRAMES * 2 + 2) * sizeof(int32_t));
+        audio_convert_deinterleave(left, right, src + offset, TEST_FRAMES);
+        audio_convert_interleave(out + offset, left, right, TEST_FRAMES);
+        TEST_ASSERT_EQUAL_INT16_ARRAY(src + offset, out + offset, TEST_FRAMES * 2);
+
+        audio_convert_interleave_ref(ref, left, right, TEST_FRAMES);
+        TEST_ASSERT_EQUAL_INT16_ARRAY(src + offset, ref, TEST_FRAMES * 2);
+    }
+
+    free(src);
+    free(out);
+    free(ref);
+    free(left);
+    free(right);
+}
+
+TEST_CASE("audio convert kernels saturate and scale", "[audio convert]")
+{
+    int16_t s16[4] = { INT16_MAX, INT16_MIN, 1000, -1000 };
+    audio_convert_gain(s16, 4, 0xffff);
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, s16[0]);
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, s16[1]);
+    TEST_ASSERT_EQUAL_INT16(1999, s16[2]);
+
+    int32_t s32[2] = { INT32_MAX, INT32_MIN };
+    int16_t out[2];
+    audio_convert_s32_to_s16(out, s32, 2, AUDIO_CONVERT_GAIN_UNITY);
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, out[0]);
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, out[1]);
+
+    // 0x123456 and -0x123456
+    const uint8_t s24[6] = { 0x56, 0x34, 0x12, 0xaa, 0xcb, 0xed };
+    audio_convert_s24_to_s16(out, s24, 2, AUDIO_CONVERT_GAIN_UNITY);
+    TEST_ASSERT_EQUAL_INT16(0x1234, out[0]);
+    TEST_ASSERT_EQUAL_INT16(-0x1235, out[1]);
+}
+
+TEST_CASE("audio convert kernels benchmark", "[audio convert]")
+{
+    int16_t *buf = malloc(TEST_FRAMES * 2 * sizeof(int32_t));
+    TEST_ASSERT_NOT_NULL(buf);
+    fill_random(buf, TEST_FRAMES * 2 * sizeof(int32_t));
+
+    uint32_t start, ref_cycles, fast_cycles;
+
+    start = esp_cpu_get_cycle_count();
+    audio_convert_mono_to_stereo_ref(buf, buf, TEST_FRAMES, TEST_GAIN);
+    ref_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    audio_convert_mono_to_stereo(buf, buf, TEST_FRAMES, TEST_GAIN);
+    fast_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "mono->stereo+gain: ref %d, fast %d cycles / %d frames", (int)ref_cycles, (int)fast_cycles, TEST_FRAMES);
+
+    start = esp_cpu_get_cycle_count();
+    audio_convert_gain_ref(buf, TEST_FRAMES * 2, TEST_GAIN);
+    ref_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    audio_convert_gain(buf, TEST_FRAMES * 2, TEST_GAIN);
+    fast_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "gain: ref %d, fast %d cycles / %d samples", (int)ref_cycles, (int)fast_cycles, TEST_FRAMES * 2);
+
+    start = esp_cpu_get_cycle_count();
+    audio_convert_s32_to_s16_ref(buf, (const int32_t*)buf, TEST_FRAMES * 2, TEST_GAIN);
+    ref_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    audio_convert_s32_to_s16(buf, (const int32_t*)buf, TEST_FRAMES * 2, TEST_GAIN);
+    fast_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "s32->s16+gain: ref %d, fast %d cycles / %d samples", (int)ref_cycles, (int)fast_cycles, TEST_FRAMES * 2);
+
+    start = esp_cpu_get_cycle_count();
+    audio_convert_s24_to_s16_ref(buf, (const uint8_t*)buf, TEST_FRAMES * 2, TEST_GAIN);
+    ref_cycles = esp_cpu_get_cycle_count() - start;
+    start = esp_cpu_get_cycle_count();
+    audio_convert_s24_to_s16(buf, (const uint8_t*)buf, TEST_FRAMES * 2, TEST_GAIN);
+    fast_cycles = esp_cpu_get_cycle_count() - start;
+    ESP_LOGI(TAG, "s24->s16+gain: ref %d, fast %d cycles / %d samples", (int)ref_cycles, (int)fast_cycles, TEST_FRAMES * 2);
+
+    free(buf);
+}
@@ -0,0 +1,122 @@
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "audio_player.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "AUDIO PLAYER SEEK TEST";
+
+#define TEST_SEEK_MS            10000
+#define TEST_SEEK_TOLERANCE_MS  100     // position granularity is one frame, 26ms at 44.1kHz
+#define TEST_SEEK_LATENCY_MS    200
+
+extern const char mp3_start[] asm("_binary_gs_16b_1c_44100hz_mp3_start");
+extern const char mp3_end[]   asm("_binary_gs_16b_1c_44100hz_mp3_end");
+
+// stands in for i2s, roughly paced so playback doesn't race to the end of the file
+static esp_err_t paced_write(void *audio_buffer, size_t len, size_t *bytes_written, uint32_t timeout_ms)
+{
+    vTaskDelay(1);
+    *bytes_written = len;
+    return ESP_OK;
+}
+
+static esp_err_t null_clk_set(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch)
+{
+    return ESP_OK;
+}
+
+static esp_err_t null_mute(AUDIO_PLAYER_MUTE_SETTING setting)
+{
+    return ESP_OK;
+}
+
+static uint32_t position_ms(void)
+{
+    uint32_t samples, rate;
+    if(audio_player_get_position(&samples, &rate) != ESP_OK) {
+        return 0;
+    }
+    return (uint64_t)samples * 1000 / rate;
+}
+
+// returns the time until the position first lands at or after target_ms
+static int64_t wait_for_position(uint32_t target_ms)
+{
+    int64_t start = esp_timer_get_time();
+    while(position_ms() < target_ms) {
+        TEST_ASSERT_LESS_THAN(1000 * 1000, esp_timer_get_time() - start);
+        vTaskDelay(1);
+    }
+    return esp_timer_get_time() - start;
+}
+
+TEST_CASE("audio player seeks and reports position", "[audio player]")
+{
+    audio_player_config_t config = { .mute_fn = null_mute,
+                                     .write_fn = paced_write,
+                                     .clk_set_fn = null_clk_set,
+                                     .priority = 0,
+                                     .coreID = 0 };
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_new(config));
+
+    // cppcheck-suppress comparePointers
+    size_t mp3_size = (mp3_end - mp3_start) - 1;
+    FILE *fp = fmemopen((void*)mp3_start, mp3_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_play(fp));
+    wait_for_position(1);
+
+    // forward while playing
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_seek(TEST_SEEK_MS));
+    int64_t latency_us = wait_for_position(TEST_SEEK_MS);
+    uint32_t reached = position_ms();
+    ESP_LOGI(TAG, "seek to %d ms reached %d ms after %d us", TEST_SEEK_MS, (int)reached, (int)latency_us);
+    TEST_ASSERT_UINT32_WITHIN(TEST_SEEK_TOLERANCE_MS, TEST_SEEK_MS, reached);
+    TEST_ASSERT_LESS_THAN(TEST_SEEK_LATENCY_MS * 1000, latency_us);
+
+    // backward while paused, the position moves but playback stays paused
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_pause());
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_seek(TEST_SEEK_MS / 2));
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ASSERT_EQUAL(AUDIO_PLAYER_STATE_PAUSE, audio_player_get_state());
+    TEST_ASSERT_UINT32_WITHIN(TEST_SEEK_TOLERANCE_MS, TEST_SEEK_MS / 2, position_ms());
+
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_resume());
+    wait_for_position(TEST_SEEK_MS / 2 + TEST_SEEK_TOLERANCE_MS);
+
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_delete());
+}
+
+TEST_CASE("audio player seeks with an exact index handed over", "[audio player]")
+{
+    audio_player_config_t config = { .mute_fn = null_mute,
+                                     .write_fn = paced_write,
+                                     .clk_set_fn = null_clk_set,
+                                     .priority = 0,
+                                     .coreID = 0 };
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_new(config));
+
+    // cppcheck-suppress comparePointers
+    size_t mp3_size = (mp3_end - mp3_start) - 1;
+    static mp3_index_t index;
+    FILE *fp = fmemopen((void*)mp3_start, mp3_size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    TEST_ASSERT_EQUAL(ESP_OK, mp3_index_build(fp, &index));
+    rewind(fp);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, audio_player_set_mp3_index(fp, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_set_mp3_index(fp, &index));
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_play(fp));
+    wait_for_position(1);
+
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_seek(TEST_SEEK_MS));
+    wait_for_position(TEST_SEEK_MS);
+    TEST_ASSERT_UINT32_WITHIN(TEST_SEEK_TOLERANCE_MS, TEST_SEEK_MS, position_ms());
+
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, audio_player_delete());
+}
@@ -0,0 +1,98 @@
+#include <math.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "unity.h"
+#include "audio_resample.h"
+
+static const char *TAG = "RESAMPLE TEST";
+
+#define TEST_TONE_HZ        1000.0
+#define TEST_AMPLITUDE      16000.0
+#define TEST_IN_FRAMES      4096
+#define TEST_OUT_FRAMES     512
+
+/**
+ * Resample a mono sine from in_rate to out_rate and return the SNR in dB of the
+ * output against the ideal sine, skipping the filter start up.
+ */
+static double resample_sine_snr(uint32_t in_rate, uint32_t out_rate)
+{
+    audio_resampler_t r;
+    TEST_ASSERT_EQUAL(ESP_OK, audio_resampler_init(&r, 1, out_rate));
+    TEST_ASSERT_EQUAL(ESP_OK, audio_resampler_set_input_rate(&r, in_rate));
+
+    int16_t *in = malloc(TEST_IN_FRAMES * sizeof(int16_t));
+    int16_t *out = malloc(TEST_OUT_FRAMES * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+
+    for(int n = 0; n < TEST_IN_FRAMES; n++) {
+        in[n] = (int16_t)lrint(TEST_AMPLITUDE * sin(2.0 * M_PI * TEST_TONE_HZ * n / in_rate));
+    }
+
+    // group delay of the linear phase prototype, in units of 1/up input samples
+    const double delay = (r.up * AUDIO_RESAMPLE_TAPS - 1) / 2.0;
+
+    double signal = 0, noise = 0;
+    size_t in_pos = 0;
+    size_t out_index = 0;
+    while(in_pos < TEST_IN_FRAMES) {
+        size_t consumed = TEST_IN_FRAMES - in_pos;
+        size_t produced = audio_resampler_process(&r, in + in_pos, &consumed, out, TEST_OUT_FRAMES);
+        in_pos += consumed;
+
+        for(size_t k = 0; k < produced; k++, out_index++) {
+            if(out_index < 2 * AUDIO_RESAMPLE_TAPS * out_rate / in_rate + 1) {
+                continue;
+            }
+            double t = (out_index * (double)r.down - delay) / r.up / in_rate;
+            double expected = TEST_AMPLITUDE * sin(2.0 * M_PI * TEST_TONE_HZ * t);
+            signal += expected * expected;
+            noise += (out[k] - expected) * (out[k] - expected);
+        }
+    }
+
+    free(in);
+    free(out);
+    audio_resampler_free(&r);
+
+    double snr = 10.0 * log10(signal / noise);
+    ESP_LOGI(TAG, "%d -> %d Hz, SNR %.1f dB", (int)in_rate, (int)out_rate, snr);
+    return snr;
+}
+
+TEST_CASE("audio resampler passes through at equal rates", "[audio resample]")
+{
+    audio_resampler_t r;
+    TEST_ASSERT_EQUAL(ESP_OK, audio_resampler_init(&r, 2, 44100));
+    TEST_ASSERT_EQUAL(ESP_OK, audio_resampler_set_input_rate(&r, 44100));
+    TEST_ASSERT_TRUE(audio_resampler_is_passthrough(&r));
+
+    int16_t in[8] = {1, -1, 2, -2, 3, -3, 4, -4};
+    int16_t out[8] = {0};
+    size_t frames = 4;
+    TEST_ASSERT_EQUAL(4, audio_resampler_process(&r, in, &frames, out, 4));
+    TEST_ASSERT_EQUAL(4, frames);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(in, out, 8);
+
+    audio_resampler_free(&r);
+}
+
+TEST_CASE("audio resampler rejects unsupported ratios", "[audio resample]")
+{
+    audio_resampler_t r;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, audio_resampler_init(&r, 3, 44100));
+    TEST_ASSERT_EQUAL(ESP_OK, audio_resampler_init(&r, 2, 44100));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, audio_resampler_set_input_rate(&r, 0));
+    // 44100 / 44101 can't be reduced
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, audio_resampler_set_input_rate(&r, 44101));
+    audio_resampler_free(&r);
+}
+
+TEST_CASE("audio resampler converts common rates to 44.1kHz", "[audio resample]")
+{
+    TEST_ASSERT_GREATER_THAN(70, (int)resample_sine_snr(8000, 44100));
+    TEST_ASSERT_GREATER_THAN(70, (int)resample_sine_snr(22050, 44100));
+    TEST_ASSERT_GREATER_THAN(70, (int)resample_sine_snr(32000, 44100));
+    TEST_ASSERT_GREATER_THAN(70, (int)resample_sine_snr(48000, 44100));
+}
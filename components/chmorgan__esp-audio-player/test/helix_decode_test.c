@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_cpu.h"
+#include "esp_rom_crc.h"
+#include "unity.h"
+#include "mp3dec.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "HELIX DECODE TEST";
+
+// From the host build of libhelix-mp3/testwrap, which uses the portable C kernels:
+//   bitexact.sh mp3dec reference.txt gs-16b-1c-44100hz.mp3
+#define TEST_REFERENCE_FRAMES   609
+#define TEST_REFERENCE_CRC32    0xeb57f942
+
+extern const char mp3_start[] asm("_binary_gs_16b_1c_44100hz_mp3_start");
+extern const char mp3_end[]   asm("_binary_gs_16b_1c_44100hz_mp3_end");
+
+TEST_CASE("helix mp3 decoder is bit-exact with the portable C build", "[helix]")
+{
+    // cppcheck-suppress comparePointers
+    int bytes_left = (mp3_end - mp3_start) - 1;
+    unsigned char *read_ptr = (unsigned char*)mp3_start;
+
+    HMP3Decoder decoder = MP3InitDecoder();
+    TEST_ASSERT_NOT_NULL(decoder);
+    short *pcm = malloc(MAX_NCHAN * MAX_NGRAN * MAX_NSAMP * sizeof(short));
+    TEST_ASSERT_NOT_NULL(pcm);
+
+    MP3FrameInfo info = { 0 };
+    uint32_t crc = 0;
+    int frames = 0;
+    uint32_t samples = 0;
+    uint64_t bits = 0;
+    uint64_t cycles = 0;
+
+    while(1) {
+        int offset = MP3FindSyncWord(read_ptr, bytes_left);
+        if(offset < 0) {
+            break;
+        }
+        read_ptr += offset;
+        bytes_left -= offset;
+
+        uint32_t start = esp_cpu_get_cycle_count();
+        int err = MP3Decode(decoder, &read_ptr, &bytes_left, pcm, 0);
+        cycles += esp_cpu_get_cycle_count() - start;
+
+        if(err == ERR_MP3_MAINDATA_UNDERFLOW) {
+            continue;
+        } else if(err) {
+            break;
+        }
+
+        MP3GetLastFrameInfo(decoder, &info);
+        // same CRC-32 as testwrap, esp_rom_crc32_le() does the pre and post inversion
+        crc = esp_rom_crc32_le(crc, (const uint8_t*)pcm, info.outputSamps * sizeof(short));
+        frames++;
+        samples += info.outputSamps;
+        bits += info.bitrate;
+    }
+
+    float pcm_seconds = (float)samples / (info.samprate * info.nChans);
+    ESP_LOGI(TAG, "%d frames, %d kbps, crc32 %08x, %.2f MCPS at %d MHz",
+             frames, (int)(bits / frames / 1000), (unsigned)crc,
+             cycles / pcm_seconds / 1e6f, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+
+    TEST_ASSERT_EQUAL(TEST_REFERENCE_FRAMES, frames);
+    TEST_ASSERT_EQUAL_HEX32(TEST_REFERENCE_CRC32, crc);
+
+    free(pcm);
+    MP3FreeDecoder(decoder);
+}
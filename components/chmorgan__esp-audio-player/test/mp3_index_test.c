@@ -0,0 +1,159 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "mp3_index.h"
+
+static const char *TAG = "MP3 INDEX TEST";
+
+#define TEST_VBR_SECONDS    60
+#define TEST_VBR_FRAMES     (TEST_VBR_SECONDS * 44100 / 1152)
+
+extern const char mp3_start[] asm("_binary_gs_16b_1c_44100hz_mp3_start");
+extern const char mp3_end[]   asm("_binary_gs_16b_1c_44100hz_mp3_end");
+
+static esp_err_t index_buffer(const void *data, size_t size, mp3_index_t *index, int64_t *elapsed_us)
+{
+    FILE *fp = fmemopen((void*)data, size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = mp3_index_build(fp, index);
+    *elapsed_us = esp_timer_get_time() - start;
+
+    fclose(fp);
+    return ret;
+}
+
+TEST_CASE("mp3 index parses frame headers", "[mp3 index]")
+{
+    mp3_frame_header_t header;
+
+    // MPEG-1 layer III, 128kbps, 44.1kHz, no padding, joint stereo
+    const uint8_t mpeg1[4] = { 0xFF, 0xFB, 0x90, 0x64 };
+    TEST_ASSERT_TRUE(mp3_parse_frame_header(mpeg1, &header));
+    TEST_ASSERT_EQUAL(1, header.version);
+    TEST_ASSERT_EQUAL(2, header.channels);
+    TEST_ASSERT_EQUAL(44100, header.sample_rate);
+    TEST_ASSERT_EQUAL(128000, header.bitrate);
+    TEST_ASSERT_EQUAL(417, header.frame_bytes);
+    TEST_ASSERT_EQUAL(1152, header.samples_per_frame);
+
+    // MPEG-2 layer III, 64kbps, 22.05kHz, padded, mono
+    const uint8_t mpeg2[4] = { 0xFF, 0xF3, 0x82, 0xC4 };
+    TEST_ASSERT_TRUE(mp3_parse_frame_header(mpeg2, &header));
+    TEST_ASSERT_EQUAL(2, header.version);
+    TEST_ASSERT_EQUAL(1, header.channels);
+    TEST_ASSERT_EQUAL(22050, header.sample_rate);
+    TEST_ASSERT_EQUAL(209, header.frame_bytes);
+    TEST_ASSERT_EQUAL(576, header.samples_per_frame);
+
+    // layer II, free format and reserved sample rate are rejected
+    const uint8_t layer2[4] = { 0xFF, 0xFD, 0x90, 0x64 };
+    const uint8_t free_format[4] = { 0xFF, 0xFB, 0x00, 0x64 };
+    const uint8_t bad_rate[4] = { 0xFF, 0xFB, 0x9C, 0x64 };
+    TEST_ASSERT_FALSE(mp3_parse_frame_header(layer2, &header));
+    TEST_ASSERT_FALSE(mp3_parse_frame_header(free_format, &header));
+    TEST_ASSERT_FALSE(mp3_parse_frame_header(bad_rate, &header));
+
+    // synchsafe ID3v2 size, 0x101 + 10 byte header
+    const uint8_t id3[10] = { 'I', 'D', '3', 4, 0, 0, 0, 0, 0x02, 0x01 };
+    TEST_ASSERT_EQUAL(0x101 + 10, mp3_id3v2_size(id3));
+}
+
+TEST_CASE("mp3 index header and frame walk agree", "[mp3 index]")
+{
+    size_t mp3_size = (mp3_end - mp3_start) - 1;
+    mp3_index_t *from_header = malloc(sizeof(mp3_index_t));
+    mp3_index_t *from_scan = malloc(sizeof(mp3_index_t));
+    uint8_t *copy = malloc(mp3_size);
+    TEST_ASSERT_NOT_NULL(from_header);
+    TEST_ASSERT_NOT_NULL(from_scan);
+    TEST_ASSERT_NOT_NULL(copy);
+
+    int64_t header_us, scan_us;
+    TEST_ASSERT_EQUAL(ESP_OK, index_buffer(mp3_start, mp3_size, from_header, &header_us));
+    TEST_ASSERT_EQUAL(MP3_INDEX_SOURCE_XING, from_header->source);
+
+    // hide the Info header to force a walk of every frame
+    memcpy(copy, mp3_start, mp3_size);
+    uint8_t *info = NULL;
+    for(size_t n = 0; n < 1024 && !info; n++) {
+        if(memcmp(copy + n, "Info", 4) == 0) {
+            info = copy + n;
+        }
+    }
+    TEST_ASSERT_NOT_NULL(info);
+    memcpy(info, "XXXX", 4);
+    TEST_ASSERT_EQUAL(ESP_OK, index_buffer(copy, mp3_size, from_scan, &scan_us));
+    TEST_ASSERT_EQUAL(MP3_INDEX_SOURCE_SCAN, from_scan->source);
+
+    ESP_LOGI(TAG, "header: %d frames, %d ms in %d us, scan: %d frames, %d ms in %d us",
+             (int)from_header->total_frames, (int)from_header->duration_ms, (int)header_us,
+             (int)from_scan->total_frames, (int)from_scan->duration_ms, (int)scan_us);
+
+    // the Info frame is silent and not counted, the walk includes it as an ordinary frame
+    TEST_ASSERT_UINT32_WITHIN(1, from_header->total_frames, from_scan->total_frames);
+    TEST_ASSERT_EQUAL(44100, from_scan->sample_rate);
+    TEST_ASSERT_EQUAL(1, from_scan->channels);
+
+    free(copy);
+    free(from_header);
+    free(from_scan);
+}
+
+TEST_CASE("mp3 index walks large vbr files", "[mp3 index]")
+{
+    static const uint8_t bitrate_indexes[] = { 5, 7, 9, 11, 13, 14 };  // 64k to 320k
+
+    // generate a header-only VBR stream, the walk never looks at the frame payload
+    uint32_t *offsets = malloc(TEST_VBR_FRAMES * sizeof(uint32_t));
+    uint8_t *stream = malloc(TEST_VBR_FRAMES * 1045);
+    TEST_ASSERT_NOT_NULL(offsets);
+    if(!stream) {
+        free(offsets);
+        TEST_IGNORE_MESSAGE("not enough memory for the vbr stream");
+    }
+
+    uint32_t pos = 0;
+    srand(1);
+    for(int n = 0; n < TEST_VBR_FRAMES; n++) {
+        uint8_t header[4] = { 0xFF, 0xFB, (uint8_t)(bitrate_indexes[rand() % sizeof(bitrate_indexes)] << 4), 0x64 };
+        mp3_frame_header_t parsed;
+        TEST_ASSERT_TRUE(mp3_parse_frame_header(header, &parsed));
+
+        offsets[n] = pos;
+        memset(stream + pos, 0, parsed.frame_bytes);
+        memcpy(stream + pos, header, sizeof(header));
+        pos += parsed.frame_bytes;
+    }
+
+    mp3_index_t *index = malloc(sizeof(mp3_index_t));
+    TEST_ASSERT_NOT_NULL(index);
+
+    int64_t scan_us;
+    TEST_ASSERT_EQUAL(ESP_OK, index_buffer(stream, pos, index, &scan_us));
+    ESP_LOGI(TAG, "vbr walk: %d frames, %d bytes in %d us, %d entries of %d frames",
+             (int)index->total_frames, (int)pos, (int)scan_us,
+             (int)index->entry_count, (int)index->frames_per_entry);
+
+    TEST_ASSERT_EQUAL(MP3_INDEX_SOURCE_SCAN, index->source);
+    TEST_ASSERT_EQUAL(TEST_VBR_FRAMES, index->total_frames);
+    TEST_ASSERT_UINT32_WITHIN(1, TEST_VBR_FRAMES * 1152ULL * 1000 / 44100, index->duration_ms);
+    TEST_ASSERT_LESS_OR_EQUAL(MP3_INDEX_MAX_ENTRIES, index->entry_count);
+
+    // the walk records exact frame offsets
+    for(uint32_t e = 0; e < index->entry_count; e++) {
+        TEST_ASSERT_EQUAL(offsets[e * index->frames_per_entry], index->entries[e]);
+    }
+
+    uint32_t frame;
+    uint32_t offset = mp3_index_seek(index, TEST_VBR_SECONDS * 1000 / 2, &frame);
+    TEST_ASSERT_EQUAL(offsets[frame], offset);
+    TEST_ASSERT_UINT32_WITHIN(index->frames_per_entry, TEST_VBR_FRAMES / 2, frame);
+
+    free(index);
+    free(stream);
+    free(offsets);
+}
@@ -0,0 +1,146 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "unity.h"
+#include "mp3_index.h"
+#include "mp3_metadata.h"
+
+static const char *TAG = "MP3 METADATA TEST";
+
+#define TEST_PICTURE_SIZE   (512 * 1024)
+
+extern const char mp3_start[] asm("_binary_gs_16b_1c_44100hz_mp3_start");
+extern const char mp3_end[]   asm("_binary_gs_16b_1c_44100hz_mp3_end");
+
+static size_t put_frame(uint8_t *out, uint8_t version, const char *id, const void *data, size_t size)
+{
+    memcpy(out, id, 4);
+    if(version == 4) {
+        out[4] = (size >> 21) & 0x7F;
+        out[5] = (size >> 14) & 0x7F;
+        out[6] = (size >> 7) & 0x7F;
+        out[7] = size & 0x7F;
+    } else {
+        out[4] = size >> 24;
+        out[5] = size >> 16;
+        out[6] = size >> 8;
+        out[7] = size;
+    }
+    out[8] = 0;
+    out[9] = 0;
+    if(data) {
+        memcpy(out + 10, data, size);
+    } else {
+        memset(out + 10, 0xA5, size);
+    }
+    return 10 + size;
+}
+
+static size_t put_header(uint8_t *out, uint8_t version, size_t size)
+{
+    const uint8_t header[10] = { 'I', 'D', '3', version, 0, 0,
+                                 (size >> 21) & 0x7F, (size >> 14) & 0x7F, (size >> 7) & 0x7F, size & 0x7F };
+    memcpy(out, header, sizeof(header));
+    return sizeof(header);
+}
+
+static bool read_buffer(const void *data, size_t size, mp3_metadata_t *metadata)
+{
+    FILE *fp = fmemopen((void*)data, size, "rb");
+    TEST_ASSERT_NOT_NULL(fp);
+    bool found = mp3_metadata_read(fp, metadata);
+    fclose(fp);
+    return found;
+}
+
+TEST_CASE("mp3 metadata reads text frames and locates pictures", "[mp3 metadata]")
+{
+    size_t mp3_size = (mp3_end - mp3_start) - 1;
+    uint8_t *file = malloc(TEST_PICTURE_SIZE + 1024 + mp3_size);
+    TEST_ASSERT_NOT_NULL(file);
+
+    // ID3v2.3, ISO-8859-1 title, UTF-16 artist, a large picture ahead of the album and padding
+    const uint8_t title[] = { 0, 'C', 'a', 'f', 0xE9 };
+    const uint8_t artist[] = { 1, 0xFF, 0xFE, 0x2C, 0x54, 0x35, 0x75, 0x00, 0x00 };     // "听电" little endian
+    const uint8_t album[] = { 0, 'L', 'i', 'v', 'e', ' ', ' ' };
+
+    size_t pos = 10;
+    pos += put_frame(file + pos, 3, "TIT2", title, sizeof(title));
+    pos += put_frame(file + pos, 3, "TPE1", artist, sizeof(artist));
+    size_t picture_frame = pos;
+    pos += put_frame(file + pos, 3, "APIC", NULL, TEST_PICTURE_SIZE);
+    const char picture_header[] = "\0image/jpeg\0\3cover";      // the string literal ends the description
+    memcpy(file + picture_frame + 10, picture_header, sizeof(picture_header));
+    pos += put_frame(file + pos, 3, "TALB", album, sizeof(album));
+    memset(file + pos, 0, 256);
+    pos += 256;
+    put_header(file, 3, pos - 10);
+
+    // the test file has a tag of its own, so the audio starts after a second tag
+    memcpy(file + pos, mp3_start, mp3_size);
+    uint32_t audio_offset = pos + mp3_id3v2_size((const uint8_t*)mp3_start);
+
+    mp3_metadata_t metadata;
+    int64_t start = esp_timer_get_time();
+    TEST_ASSERT_TRUE(read_buffer(file, pos + mp3_size, &metadata));
+    ESP_LOGI(TAG, "%d byte tag read in %d us", (int)pos, (int)(esp_timer_get_time() - start));
+
+    TEST_ASSERT_EQUAL_STRING("Caf\xC3\xA9", metadata.title);
+    TEST_ASSERT_EQUAL_STRING("\xE5\x90\xAC\xE7\x94\xB5", metadata.artist);
+    TEST_ASSERT_EQUAL_STRING("Live", metadata.album);
+    TEST_ASSERT_EQUAL(audio_offset, metadata.audio_offset);
+    TEST_ASSERT_EQUAL(picture_frame + 10 + sizeof(picture_header), metadata.picture_offset);
+    TEST_ASSERT_EQUAL(TEST_PICTURE_SIZE - sizeof(picture_header), metadata.picture_size);
+    TEST_ASSERT_EQUAL(3, metadata.picture_type);
+
+    // the index finds the Info frame where the metadata reader stopped, audio_start is the frame after it
+    mp3_index_t *index = malloc(sizeof(mp3_index_t));
+    TEST_ASSERT_NOT_NULL(index);
+    FILE *fp = fmemopen(file, pos + mp3_size, "rb");
+    TEST_ASSERT_EQUAL(ESP_OK, mp3_index_build_from_header(fp, index));
+    TEST_ASSERT_EQUAL(MP3_INDEX_SOURCE_XING, index->source);
+    TEST_ASSERT_GREATER_THAN(audio_offset, index->audio_start);
+    TEST_ASSERT_LESS_OR_EQUAL(audio_offset + 1441, index->audio_start);
+    fclose(fp);
+
+    free(index);
+    free(file);
+}
+
+TEST_CASE("mp3 metadata handles ID3v2.4, truncation and ID3v1", "[mp3 metadata]")
+{
+    uint8_t file[512];
+
+    // ID3v2.4 UTF-8 title longer than the field, truncated on a character boundary
+    uint8_t title[1 + 100];
+    title[0] = 3;
+    for(int n = 0; n < 50; n++) {
+        title[1 + n * 2] = 0xC3;
+        title[2 + n * 2] = 0xA9;
+    }
+    size_t pos = 10;
+    pos += put_frame(file + pos, 4, "TIT2", title, sizeof(title));
+    put_header(file, 4, pos - 10);
+
+    // ID3v1 at the end supplies the artist the ID3v2 tag didn't have
+    memset(file + pos, 0, 128);
+    memcpy(file + pos, "TAG", 3);
+    memcpy(file + pos + 3, "ignored", 7);
+    memcpy(file + pos + 33, "Band", 4);
+    pos += 128;
+
+    mp3_metadata_t metadata;
+    TEST_ASSERT_TRUE(read_buffer(file, pos, &metadata));
+    TEST_ASSERT_EQUAL(MP3_METADATA_TEXT_SIZE - 2, strlen(metadata.title));
+    TEST_ASSERT_EQUAL_STRING("Band", metadata.artist);
+    TEST_ASSERT_EQUAL_STRING("", metadata.album);
+
+    // ID3v2.4 as written by ffmpeg
+    size_t mp3_size = (mp3_end - mp3_start) - 1;
+    TEST_ASSERT_TRUE(read_buffer(mp3_start, mp3_size, &metadata));
+    TEST_ASSERT_EQUAL_STRING("Galway", metadata.title);
+    TEST_ASSERT_EQUAL_STRING("Kevin MacLeod", metadata.artist);
+    TEST_ASSERT_EQUAL(0, metadata.picture_size);
+    TEST_ASSERT_EQUAL(mp3_id3v2_size((const uint8_t*)mp3_start), metadata.audio_offset);
+}
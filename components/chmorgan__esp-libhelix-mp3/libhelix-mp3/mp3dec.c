@@ -94,6 +94,31 @@ void MP3FreeDecoder(HMP3Decoder hMP3Decoder)
 	FreeBuffers(mp3DecInfo);
 }
 
+/**************************************************************************************
+ * Function:    MP3ResetDecoder
+ *
+ * Description: discard the bit reservoir and all inter-frame filter state, as if the
+ *                decoder had just been created
+ *
+ * Inputs:      valid MP3 decoder instance pointer (HMP3Decoder)
+ *
+ * Outputs:     none
+ *
+ * Return:      none
+ *
+ * Notes:       call after repositioning in the stream (seeking) so that main data from
+ *                the old position is not combined with frames from the new one
+ **************************************************************************************/
+void MP3ResetDecoder(HMP3Decoder hMP3Decoder)
+{
+	MP3DecInfo *mp3DecInfo = (MP3DecInfo *)hMP3Decoder;
+
+	if (!mp3DecInfo)
+		return;
+
+	ResetBuffers(mp3DecInfo);
+}
+
 /**************************************************************************************
  * Function:    MP3FindSyncWord
  *
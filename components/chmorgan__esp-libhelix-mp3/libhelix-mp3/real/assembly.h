@@ -42,6 +42,8 @@
  *
  * - inline rountines with access to 64-bit multiply results 
  * - x86 (_WIN32) and ARM (ARM_ADS, _WIN32_WCE) versions included
+ * - RISC-V and Xtensa versions for ESP32 targets
+ * - portable C when HELIX_GENERIC_C is defined or building on a 64-bit host
  * - some inline functions are mix of asm and C for speed
  * - some functions are in native asm files, so only the prototype is given here
  *
@@ -352,7 +354,7 @@ static __inline int CLZ(int x)
 
 #else
 
-#ifdef __riscv
+#if defined(__riscv) && !defined(HELIX_GENERIC_C)
 
 typedef long long Word64;
 
@@ -414,12 +416,15 @@ static __inline Word64 SAR64(Word64 x, int n)
 	return (x >> n);
 }
 
-#elif defined(__xtensa__)
+#elif defined(__xtensa__) && !defined(HELIX_GENERIC_C)
 
 #include "xtensa/config/core-isa.h"
 
 typedef long long Word64;
 
+/* gcc emits a mull/mulsh pair and a carry add for this, there is no 64-bit
+ * accumulator on LX7 (MAC16 is 16x16 only) so hand written asm can't do better
+ */
 static __inline Word64 MADD64(Word64 sum64, int x, int y)
 {
     return (sum64 + ((long long)x * y));
@@ -440,7 +445,10 @@ static __inline int MULSHIFT32(int x, int y)
      *   require an extra "mov r0, r1")
      */
     int ret;
-    asm volatile ("mulsh %0, %1, %2" : "=r" (ret) : "r" (x), "r" (y));
+    /* not volatile, the result only depends on the inputs so the compiler may
+     * schedule it and drop unused calls
+     */
+    asm ("mulsh %0, %1, %2" : "=r" (ret) : "r" (x), "r" (y));
     return ret;
 }
 
@@ -455,7 +463,7 @@ static __inline int MULSHIFT32(int x, int y)
 static __inline int FASTABS(int x)
 {
     int ret;
-    asm volatile ("abs %0, %1" : "=r" (ret) : "r" (x));
+    asm ("abs %0, %1" : "=r" (ret) : "r" (x));
     return ret;
 }
 
@@ -470,9 +478,69 @@ static __inline Word64 SAR64(Word64 x, int n)
     return x >> n;
 }
 
+#if XCHAL_HAVE_NSA
+
+/* nsau gives 32 for 0, as CLZ does on the other platforms. __builtin_clz(0) is
+ * undefined and the dequantizer and IMDCT do call CLZ(0) on silent blocks
+ */
+static __inline int CLZ(int x)
+{
+    int ret;
+    asm ("nsau %0, %1" : "=r" (ret) : "r" (x));
+    return ret;
+}
+
+#else
+
 static __inline int CLZ(int x)
 {
-    return __builtin_clz(x);
+    return x ? __builtin_clz(x) : (sizeof(int) * 8);
+}
+
+#endif
+
+#elif defined(HELIX_GENERIC_C) || defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+
+/* portable C, used for host builds of testwrap and as the bit-exact reference
+ * for the target specific versions above
+ */
+
+typedef long long Word64;
+
+static __inline int MULSHIFT32(int x, int y)
+{
+    return (int)(((Word64)x * y) >> 32);
+}
+
+static __inline int FASTABS(int x)
+{
+    int sign;
+
+    sign = x >> (sizeof(int) * 8 - 1);
+    x ^= sign;
+    x -= sign;
+
+    return x;
+}
+
+static __inline int CLZ(int x)
+{
+    return x ? __builtin_clz(x) : (sizeof(int) * 8);
+}
+
+static __inline Word64 MADD64(Word64 sum, int x, int y)
+{
+    return (sum + ((Word64)x * y));
+}
+
+static __inline Word64 SHL64(Word64 x, int n)
+{
+    return (x << n);
+}
+
+static __inline Word64 SAR64(Word64 x, int n)
+{
+    return (x >> n);
 }
 
 #else
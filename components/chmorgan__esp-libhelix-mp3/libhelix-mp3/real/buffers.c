@@ -140,6 +140,35 @@ MP3DecInfo *AllocateBuffers(void)
 	return mp3DecInfo;
 }
 
+/**************************************************************************************
+ * Function:    ResetBuffers
+ *
+ * Description: return all decoder state to the values set by AllocateBuffers, without
+ *                freeing or reallocating anything
+ *
+ * Inputs:      pointer to initialized MP3DecInfo structure
+ *
+ * Outputs:     cleared bit reservoir, overlap-add and synthesis filter state
+ *
+ * Return:      none
+ **************************************************************************************/
+void ResetBuffers(MP3DecInfo *mp3DecInfo)
+{
+	if (!mp3DecInfo)
+		return;
+
+	ClearBuffer(mp3DecInfo->FrameHeaderPS,     sizeof(FrameHeader));
+	ClearBuffer(mp3DecInfo->SideInfoPS,        sizeof(SideInfo));
+	ClearBuffer(mp3DecInfo->ScaleFactorInfoPS, sizeof(ScaleFactorInfo));
+	ClearBuffer(mp3DecInfo->HuffmanInfoPS,     sizeof(HuffmanInfo));
+	ClearBuffer(mp3DecInfo->DequantInfoPS,     sizeof(DequantInfo));
+	ClearBuffer(mp3DecInfo->IMDCTInfoPS,       sizeof(IMDCTInfo));
+	ClearBuffer(mp3DecInfo->SubbandInfoPS,     sizeof(SubbandInfo));
+
+	mp3DecInfo->mainDataBegin = 0;
+	mp3DecInfo->mainDataBytes = 0;
+}
+
 #define SAFE_FREE(x)	{if (x)	free(x);	(x) = 0;}	/* helper macro */
 
 /**************************************************************************************
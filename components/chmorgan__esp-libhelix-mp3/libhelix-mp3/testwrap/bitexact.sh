@@ -0,0 +1,44 @@
+#!/bin/sh
+# Decode each stream and compare the PCM CRC-32 with a reference list.
+#
+#   bitexact.sh mp3dec reference.txt stream.mp3...          check
+#   bitexact.sh -u mp3dec reference.txt stream.mp3...       regenerate the reference
+#
+# Set CPU_MHZ to report the decode cost of each stream in MCPS.
+
+update=0
+if [ "$1" = "-u" ]; then
+    update=1
+    shift
+fi
+if [ $# -lt 3 ]; then
+    sed -n '2,7p' "$0"
+    exit 2
+fi
+
+mp3dec=$1
+reference=$2
+shift 2
+
+results=$(mktemp)
+trap 'rm -f "$results"' EXIT
+
+for stream in "$@"; do
+    line=$("$mp3dec" "$stream" nul $CPU_MHZ) || exit 1
+    echo "$line"
+    crc=$(echo "$line" | sed -n 's/.*crc32 \([0-9a-f]*\).*/\1/p')
+    echo "$(basename "$stream") $crc" >> "$results"
+done
+
+if [ $update -eq 1 ]; then
+    cp "$results" "$reference"
+    echo "wrote $reference"
+    exit 0
+fi
+
+if diff "$reference" "$results"; then
+    echo "bit-exact: $# streams"
+else
+    echo "MISMATCH against $reference"
+    exit 1
+fi
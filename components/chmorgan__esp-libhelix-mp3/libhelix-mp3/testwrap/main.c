@@ -53,6 +53,20 @@
 #define MAX_ARM_FRAMES		100
 #define ARMULATE_MUL_FACT	1
 
+/* CRC-32 (IEEE) of the PCM output, compared across builds to check they are bit-exact */
+static unsigned int UpdateCRC32(unsigned int crc, const unsigned char *buf, int len)
+{
+	int i;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *buf++;
+		for (i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+	}
+	return ~crc;
+}
+
 static int FillReadBuffer(unsigned char *readBuf, unsigned char *readPtr, int bufSize, int bytesLeft, FILE *infile)
 {
 	int nRead;
@@ -76,14 +90,19 @@ int main(int argc, char **argv)
 	MP3FrameInfo mp3FrameInfo;
 	HMP3Decoder hMP3Decoder;
 	int startTime, endTime, diffTime, totalDecTime, nFrames;
+	unsigned int crc, cpuMHz;
+	int nDecoded, totalSamps, sampRate, nChans;
+	double totalBitrate;
 #ifdef ARM_ADS	
 	float audioSecs;
 #endif
 
-	if (argc != 3) {
-		printf("usage: mp3dec infile.mp3 outfile.pcm\n");
+	if (argc != 3 && argc != 4) {
+		printf("usage: mp3dec infile.mp3 outfile.pcm [cpu_mhz]\n");
+		printf("  outfile nul discards the output, cpu_mhz scales the decode time to MCPS\n");
 		return -1;
 	}
+	cpuMHz = (argc == 4) ? (unsigned int)atoi(argv[3]) : 0;
 	infile = fopen(argv[1], "rb");
 	if (!infile) {
 		printf("file open error\n");
@@ -117,6 +136,12 @@ int main(int argc, char **argv)
 	nRead = 0;
 	totalDecTime = 0;
 	nFrames = 0;
+	crc = 0;
+	nDecoded = 0;
+	totalSamps = 0;
+	totalBitrate = 0;
+	sampRate = 0;
+	nChans = 0;
 	do {
 		/* somewhat arbitrary trigger to refill buffer - should always be enough for a full frame */
 		if (bytesLeft < 2*MAINBUF_SIZE && !eofReached) {
@@ -171,6 +196,12 @@ int main(int argc, char **argv)
 			MP3GetLastFrameInfo(hMP3Decoder, &mp3FrameInfo);
 			if (outfile)
 				fwrite(outBuf, mp3FrameInfo.bitsPerSample / 8, mp3FrameInfo.outputSamps, outfile);
+			crc = UpdateCRC32(crc, (unsigned char *)outBuf, mp3FrameInfo.outputSamps * mp3FrameInfo.bitsPerSample / 8);
+			nDecoded++;
+			totalSamps += mp3FrameInfo.outputSamps;
+			totalBitrate += mp3FrameInfo.bitrate;
+			sampRate = mp3FrameInfo.samprate;
+			nChans = mp3FrameInfo.nChans;
 		}
 
 #if defined ARM_ADS && defined MAX_ARM_FRAMES
@@ -187,6 +218,18 @@ int main(int argc, char **argv)
 	printf("nFrames = %d, output samps = %d, sampRate = %d, nChans = %d\n", nFrames, mp3FrameInfo.outputSamps, mp3FrameInfo.samprate, mp3FrameInfo.nChans);
 #endif
 
+	/* one line per stream so a script can diff the results of two builds */
+	if (nDecoded && sampRate && nChans) {
+		double decSecs = (double)totalDecTime * GetClockDivFactor() / GetClockFrequency();
+		double pcmSecs = (double)totalSamps / ((double)sampRate * nChans);
+
+		printf("%s: frames %d, %d Hz, %d ch, %.0f kbps, crc32 %08x, decode %.3f s for %.3f s",
+			argv[1], nDecoded, sampRate, nChans, totalBitrate / nDecoded / 1000, crc, decSecs, pcmSecs);
+		if (cpuMHz)
+			printf(", %.2f MCPS at %u MHz", cpuMHz * decSecs / pcmSecs, cpuMHz);
+		printf("\n");
+	}
+
 	MP3FreeDecoder(hMP3Decoder);
 
 	fclose(infile);
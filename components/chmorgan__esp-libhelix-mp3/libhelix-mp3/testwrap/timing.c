@@ -124,6 +124,45 @@ UINT CalcTimeDifference(UINT startTime, UINT endTime)
 		return (endTime - startTime);
 }
 
+#elif defined (__GNUC__)
+
+/* host builds, process CPU time in microseconds so other processes don't skew the result */
+#include <time.h>
+
+int InitTimer(void)
+{
+    return 0;
+}
+
+UINT ReadTimer(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (UINT)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+int FreeTimer(void)
+{
+    return 0;
+}
+
+UINT GetClockFrequency(void)
+{
+    return 1000000;
+}
+
+UINT GetClockDivFactor(void)
+{
+    return 1;
+}
+
+UINT CalcTimeDifference(UINT startTime, UINT endTime)
+{
+    /* unsigned wrap around gives the right answer for a 32-bit counter */
+    return (endTime - startTime);
+}
+
 #elif 0	/* if defined ARM_ADS - this uses simulated high-res hardware timers */
 
 /* see definitions in ADSv1_2/bin/peripherals.ami */
@@ -0,0 +1,386 @@
+#include "Album_Art.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "rom/tjpgd.h"                                    // ROM decoder, LV_USE_SJPG must stay off or its tjpgd replaces it
+#include "mp3_metadata.h"
+#include "File_IO.h"
+#include "SD_MMC.h"
+#include "Shutdown.h"
+
+static const char *TAG = "ALBUM ART";
+
+#define Album_Art_Cache_Magic   0x31545241                  // "ART1"
+#define Album_Art_Work_Size     3100                        // tjpgd work area, enough for any baseline JPEG
+#define Album_Art_Bytes         (Album_Art_Size * Album_Art_Size * sizeof(lv_color_t))
+
+typedef struct {
+    uint32_t Magic;
+    uint32_t Path_Hash;
+    uint32_t File_Size;                                     // Size and time of the track, a changed file is decoded again
+    uint32_t File_Mtime;
+    uint16_t Width;                                         // 0 if the track has no usable art
+    uint16_t Height;
+} Album_Art_Cache_Header;
+
+typedef struct {
+    FILE *File;
+    uint32_t Remaining;                                     // Picture bytes not yet read
+    uint32_t Crop_X;                                        // Centre square of the scaled image
+    uint32_t Crop_Y;
+    uint32_t Crop;
+    lv_color_t *Out;
+} Album_Art_Decoder;
+
+typedef struct {
+    const char *Path;
+    const Album_Art_Cache_Header *Header;
+    const lv_color_t *Pixels;
+} Album_Art_Cache_Entry;
+
+typedef struct {
+    const char *Path;
+    struct stat St;
+} Album_Art_Stat;
+
+static lv_img_dsc_t Slots[Album_Art_Slots];
+static uint32_t Slot_Next = 0;
+static uint8_t Work[Album_Art_Work_Size];                   // Only used by the art task
+
+static char Request_Path[Dir_Scan_Path_Max];                // Any path the card holds
+static uint32_t Request_Generation = 0;                     // Bumped per track so stale art is never shown
+static uint32_t Ready_Generation = 0;
+static uint32_t Taken_Generation = 0;
+static const lv_img_dsc_t *Ready_Art = NULL;
+static SemaphoreHandle_t Art_Mutex;
+static SemaphoreHandle_t Art_Card;                          // Held while the task has the card, a track or the cache
+static TaskHandle_t Art_Task_Handle;
+
+/** FNV-1a */
+static uint32_t Hash_Path(const char *Path)
+{
+    uint32_t hash = 2166136261u;
+    while (*Path) {
+        hash ^= (uint8_t)*Path++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static unsigned int Jpeg_Input(JDEC *Jd, uint8_t *Buffer, unsigned int Bytes)
+{
+    Album_Art_Decoder *decoder = (Album_Art_Decoder *)Jd->device;
+    if (Bytes > decoder->Remaining) {
+        Bytes = decoder->Remaining;
+    }
+    if (Buffer) {
+        Bytes = fread(Buffer, 1, Bytes, decoder->File);
+    } else if (fseek(decoder->File, Bytes, SEEK_CUR) != 0) {
+        Bytes = 0;
+    }
+    decoder->Remaining -= Bytes;
+    return Bytes;
+}
+
+// Range of thumbnail pixels [*First, *Last) taken from scaled pixel Pos, nearest neighbour
+static bool Map(const Album_Art_Decoder *Decoder, uint32_t Pos, uint32_t Origin, uint32_t *First, uint32_t *Last)
+{
+    if (Pos < Origin || Pos >= Origin + Decoder->Crop) {
+        return false;
+    }
+    Pos -= Origin;
+    *First = (Pos * Album_Art_Size + Decoder->Crop - 1) / Decoder->Crop;
+    *Last = ((Pos + 1) * Album_Art_Size + Decoder->Crop - 1) / Decoder->Crop;
+    if (*Last > Album_Art_Size) {
+        *Last = Album_Art_Size;
+    }
+    return *First < *Last;
+}
+
+// Called per MCU block with RGB888 pixels of the scaled image
+static unsigned int Jpeg_Output(JDEC *Jd, void *Bitmap, JRECT *Rect)
+{
+    Album_Art_Decoder *decoder = (Album_Art_Decoder *)Jd->device;
+    const uint8_t *rgb = (const uint8_t *)Bitmap;
+    uint32_t width = Rect->right - Rect->left + 1;
+
+    for (uint32_t y = Rect->top; y <= Rect->bottom; y++, rgb += width * 3) {
+        uint32_t y0, y1;
+        if (!Map(decoder, y, decoder->Crop_Y, &y0, &y1)) {
+            continue;
+        }
+        for (uint32_t x = Rect->left; x <= Rect->right; x++) {
+            uint32_t x0, x1;
+            if (!Map(decoder, x, decoder->Crop_X, &x0, &x1)) {
+                continue;
+            }
+            const uint8_t *p = rgb + (x - Rect->left) * 3;
+            lv_color_t color = lv_color_make(p[0], p[1], p[2]);
+            for (uint32_t dy = y0; dy < y1; dy++) {
+                for (uint32_t dx = x0; dx < x1; dx++) {
+                    decoder->Out[dy * Album_Art_Size + dx] = color;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// Decode straight to the thumbnail, the JPEG is scaled down by up to 8 while decoding so at most 2:1 is left
+static bool Decode(FILE *File, uint32_t Offset, uint32_t Size, lv_color_t *Out)
+{
+    Album_Art_Decoder decoder = { .File = File, .Remaining = Size, .Out = Out };
+    uint8_t magic[2];
+    if (fseek(File, Offset, SEEK_SET) != 0 || fread(magic, 1, 2, File) != 2 || magic[0] != 0xFF || magic[1] != 0xD8) {
+        ESP_LOGW(TAG, "Picture is not a JPEG");
+        return false;
+    }
+    fseek(File, Offset, SEEK_SET);
+
+    JDEC jd;
+    JRESULT res = jd_prepare(&jd, Jpeg_Input, Work, sizeof(Work), &decoder);
+    if (res != JDR_OK) {
+        ESP_LOGW(TAG, "Unsupported JPEG (progressive?), error %d", res);
+        return false;
+    }
+
+    uint32_t side = (jd.width < jd.height) ? jd.width : jd.height;
+    uint8_t scale = 0;
+    while (scale < 3 && (side >> (scale + 1)) >= Album_Art_Size) {
+        scale++;
+    }
+    decoder.Crop = side >> scale;
+    decoder.Crop_X = ((jd.width >> scale) - decoder.Crop) / 2;
+    decoder.Crop_Y = ((jd.height >> scale) - decoder.Crop) / 2;
+    if (decoder.Crop == 0) {
+        return false;
+    }
+
+    res = jd_decomp(&jd, Jpeg_Output, scale);
+    if (res != JDR_OK) {
+        ESP_LOGW(TAG, "JPEG decode error %d", res);
+        return false;
+    }
+    ESP_LOGI(TAG, "%lux%lu JPEG decoded at 1/%d", (uint32_t)jd.width, (uint32_t)jd.height, 1 << scale);
+    return true;
+}
+
+// On the I/O task, one thumbnail takes a few tens of milliseconds and the player reads ahead further than that
+static int32_t Cache_Save_Call(void *Context)
+{
+    const Album_Art_Cache_Entry *entry = Context;
+    if (mkdir(Album_Art_Cache_Dir, 0775) != 0 && errno != EEXIST) {
+        int error = errno;
+        ESP_LOGW(TAG, "Can't create %s, errno %d", Album_Art_Cache_Dir, error);
+        return -error;
+    }
+    FILE *fp = fopen(entry->Path, "wb");
+    if (!fp) {
+        int error = errno;
+        ESP_LOGW(TAG, "Can't write %s, errno %d", entry->Path, error);
+        return -error;
+    }
+    bool ok = fwrite(entry->Header, 1, sizeof(*entry->Header), fp) == sizeof(*entry->Header);
+    if (entry->Header->Width) {
+        ok = ok && fwrite(entry->Pixels, 1, Album_Art_Bytes, fp) == Album_Art_Bytes;
+    }
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok) {
+        remove(entry->Path);                                // A truncated entry would fail the read anyway
+        return -EIO;
+    }
+    return 0;
+}
+
+static void Cache_Save(const char *Cache_Path, const Album_Art_Cache_Header *Header, const lv_color_t *Pixels)
+{
+    Album_Art_Cache_Entry entry = { .Path = Cache_Path, .Header = Header, .Pixels = Pixels };
+    File_IO_Call_Wait(Io_Class_UI, Cache_Save_Call, &entry);
+}
+
+static int32_t Stat_Call(void *Context)
+{
+    Album_Art_Stat *track = Context;
+    return stat(track->Path, &track->St) == 0 ? 0 : -errno;
+}
+
+// Warm loads are one contiguous read of the thumbnail, cold loads decode the APIC frame and fill the cache
+static bool Load(const char *Path, lv_color_t *Out, bool *Cached)
+{
+    *Cached = false;
+    Album_Art_Stat track = { .Path = Path };
+    if (File_IO_Call_Wait(Io_Class_UI, Stat_Call, &track) != 0) {
+        return false;
+    }
+
+    Album_Art_Cache_Header key = {
+        .Magic = Album_Art_Cache_Magic,
+        .Path_Hash = Hash_Path(Path),
+        .File_Size = (uint32_t)track.St.st_size,
+        .File_Mtime = (uint32_t)track.St.st_mtime,
+    };
+    char cache_path[128];
+    snprintf(cache_path, sizeof(cache_path), "%s/%08lx.art", Album_Art_Cache_Dir, key.Path_Hash);
+
+    FILE *fp = File_IO_Open_Stream(cache_path, Io_Class_UI);
+    if (fp) {
+        Album_Art_Cache_Header stored;
+        bool hit = fread(&stored, 1, sizeof(stored), fp) == sizeof(stored) &&
+                   stored.Magic == key.Magic && stored.Path_Hash == key.Path_Hash &&
+                   stored.File_Size == key.File_Size && stored.File_Mtime == key.File_Mtime &&
+                   (stored.Width == 0 || (stored.Width == Album_Art_Size && stored.Height == Album_Art_Size));
+        bool art = hit && stored.Width && fread(Out, 1, Album_Art_Bytes, fp) == Album_Art_Bytes;
+        fclose(fp);
+        if (hit) {
+            *Cached = true;
+            return art;
+        }
+    }
+
+    fp = File_IO_Open_Stream(Path, Io_Class_UI);
+    if (!fp) {
+        return false;
+    }
+    mp3_metadata_t metadata;
+    bool art = mp3_metadata_read(fp, &metadata) && metadata.picture_size &&
+               Decode(fp, metadata.picture_offset, metadata.picture_size, Out);
+    fclose(fp);
+
+    // Tracks without art are cached too, so they aren't parsed again
+    key.Width = art ? Album_Art_Size : 0;
+    key.Height = art ? Album_Art_Size : 0;
+    Cache_Save(cache_path, &key, Out);
+    return art;
+}
+
+static void Album_Art_Task(void *arg)
+{
+    static char path[sizeof(Request_Path)];                 // Off the 4 KB task stack
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xSemaphoreTake(Art_Card, portMAX_DELAY);
+        xSemaphoreTake(Art_Mutex, portMAX_DELAY);
+        strcpy(path, Request_Path);
+        uint32_t generation = Request_Generation;
+        lv_img_dsc_t *slot = &Slots[Slot_Next];             // Neither shown nor fading out
+        xSemaphoreGive(Art_Mutex);
+        if (!path[0]) {
+            xSemaphoreGive(Art_Card);                       // Dropped, the card went
+            continue;
+        }
+
+        int64_t start = esp_timer_get_time();
+        bool cached;
+        bool art = Load(path, (lv_color_t *)slot->data, &cached);
+        xSemaphoreGive(Art_Card);
+        ESP_LOGI(TAG, "%s %s in %lld ms (%s)", art ? "Art for" : "No art in", path,
+                 (esp_timer_get_time() - start) / 1000, cached ? "warm" : "cold");
+
+        xSemaphoreTake(Art_Mutex, portMAX_DELAY);
+        if (generation == Request_Generation) {
+            Ready_Art = art ? slot : NULL;
+            Ready_Generation = generation;
+            if (art) {
+                Slot_Next = (Slot_Next + 1) % Album_Art_Slots;
+            }
+        }
+        xSemaphoreGive(Art_Mutex);
+    }
+}
+
+// Drops the request and waits for a load that is running, so no stream or cache write is left on the card
+static bool Album_Art_Stop(uint32_t Timeout_ms)
+{
+    xSemaphoreTake(Art_Mutex, portMAX_DELAY);
+    Request_Path[0] = '\0';
+    Request_Generation++;
+    xSemaphoreGive(Art_Mutex);
+    if (xSemaphoreTake(Art_Card, pdMS_TO_TICKS(Timeout_ms)) != pdTRUE) {
+        return false;
+    }
+    xSemaphoreGive(Art_Card);
+    return true;
+}
+
+// Before the flushes, a cache write of the art is not one of them
+static bool Album_Art_Shutdown(uint32_t Timeout_ms, void *Context)
+{
+    return Album_Art_Stop(Timeout_ms);
+}
+
+// On the SD monitor task
+static void Art_Card_Event(Card_Event Event, void *Context)
+{
+    if ((Event == Card_Event_Lost || Event == Card_Event_Ejecting) && !Album_Art_Stop(Album_Art_Stop_ms)) {
+        ESP_LOGW(TAG, "Still loading art when the card went");
+    }
+}
+
+void Album_Art_Init(void)
+{
+    for (int i = 0; i < Album_Art_Slots; i++) {
+        uint8_t *pixels = heap_caps_malloc(Album_Art_Bytes, MALLOC_CAP_SPIRAM);
+        if (!pixels) {
+            ESP_LOGE(TAG, "Failed to allocate album art");
+            while (i-- > 0) {
+                heap_caps_free((void *)Slots[i].data);
+                Slots[i].data = NULL;
+            }
+            return;
+        }
+        Slots[i].header.always_zero = 0;
+        Slots[i].header.w = Album_Art_Size;
+        Slots[i].header.h = Album_Art_Size;
+        Slots[i].header.cf = LV_IMG_CF_TRUE_COLOR;
+        Slots[i].data_size = Album_Art_Bytes;
+        Slots[i].data = pixels;
+    }
+
+    // JPEG decoding is a burst of a few tens of ms, keep it below the player and the UI
+    Art_Mutex = xSemaphoreCreateMutex();
+    Art_Card = xSemaphoreCreateMutex();
+    if (!Art_Mutex || !Art_Card ||
+        xTaskCreatePinnedToCore(Album_Art_Task, "Album Art", 4096, NULL, 2, &Art_Task_Handle, 1) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create album art task");
+        Art_Mutex = NULL;
+        return;
+    }
+    SD_Subscribe(Art_Card_Event, NULL);
+    Shutdown_Register("album art", Shutdown_Phase_Quiesce, Album_Art_Stop_ms, Album_Art_Shutdown, NULL);
+}
+
+void Album_Art_Request(const char *File_Path)
+{
+    if (!Art_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Art_Mutex, portMAX_DELAY);
+    snprintf(Request_Path, sizeof(Request_Path), "%s", File_Path);
+    Request_Generation++;
+    xSemaphoreGive(Art_Mutex);
+    xTaskNotifyGive(Art_Task_Handle);
+}
+
+bool Album_Art_Take(const lv_img_dsc_t **Art)
+{
+    if (!Art_Mutex) {
+        return false;
+    }
+    bool ready = false;
+    xSemaphoreTake(Art_Mutex, portMAX_DELAY);
+    if (Ready_Generation == Request_Generation && Taken_Generation != Ready_Generation) {
+        Taken_Generation = Ready_Generation;
+        *Art = Ready_Art;
+        ready = true;
+    }
+    xSemaphoreGive(Art_Mutex);
+    return ready;
+}
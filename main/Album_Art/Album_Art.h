@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+
+#define Album_Art_Size          176                         // Thumbnail side, the size of the built in covers
+#define Album_Art_Cache_Dir     "/sdcard/.cache"            // Thumbnails, keyed like the track indexes
+#define Album_Art_Slots         3                           // Shown, fading out, being loaded
+#define Album_Art_Stop_ms       150                         // For a load to finish when the card goes, a cold one decodes a JPEG
+
+void Album_Art_Init(void);
+void Album_Art_Request(const char *File_Path);              // Load the art of a track in the background
+bool Album_Art_Take(const lv_img_dsc_t **Art);              // True once per request, *Art is NULL if the track has no usable art
@@ -0,0 +1,212 @@
+#include "Asset_Store.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "esp_vfs_fat.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "Fat_Image.h"
+#include "File_IO.h"
+#include "SD_MMC.h"
+
+static const char *TAG = "ASSETS";
+
+#define Bench_Asset             "covers/cover_1.bin"
+#define Bench_Card_File         "/sdcard/.cache/asset_bench.bin"
+#define Bench_Evict_Bytes       (256 * 1024)                // More than the flash cache holds
+
+static const esp_partition_t *Partition;
+static esp_partition_mmap_handle_t Map_Handle;
+static const uint8_t *Mapped = NULL;
+static Fat_Image Image;
+static SemaphoreHandle_t Store_Mutex = NULL;                // Fat_Image_Find() is not reentrant
+static bool Mounted = false;
+
+static struct {
+    char Name[48];
+    lv_img_dsc_t Image;
+} Images[Asset_Store_Images_Max];
+static uint32_t Image_Count = 0;
+static volatile uint32_t Touch_Sum;                         // Keeps the benchmark reads from being optimized away
+
+typedef struct {
+    const uint8_t *Asset;
+    uint8_t *Buffer;
+    size_t Bytes;
+    int64_t Read_us;                                        // -1 if it failed
+} Card_Read;
+
+void Asset_Store_Init(void)
+{
+    Partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_FAT, Asset_Store_Partition);
+    if (!Partition) {
+        ESP_LOGW(TAG, "No %s partition", Asset_Store_Partition);
+        return;
+    }
+    const void *data;
+    esp_err_t ret = esp_partition_mmap(Partition, 0, Partition->size, ESP_PARTITION_MMAP_DATA, &data, &Map_Handle);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Can't map %s: %s", Asset_Store_Partition, esp_err_to_name(ret));
+        return;
+    }
+    if (!Fat_Image_Open(&Image, data, Partition->size)) {
+        ESP_LOGW(TAG, "No FAT image in %s, write it with idf.py flash", Asset_Store_Partition);
+        esp_partition_munmap(Map_Handle);
+        return;
+    }
+    Store_Mutex = xSemaphoreCreateMutex();
+    if (!Store_Mutex) {
+        esp_partition_munmap(Map_Handle);
+        return;
+    }
+    Mapped = data;
+
+    // For whatever wants stdio, the mapping needs no mount
+    esp_vfs_fat_mount_config_t config = {
+        .format_if_mount_failed = false,
+        .max_files = 2,
+    };
+    ret = esp_vfs_fat_spiflash_mount_ro(Asset_Store_Mount, Asset_Store_Partition, &config);
+    Mounted = ret == ESP_OK;
+    if (!Mounted) {
+        ESP_LOGW(TAG, "Can't mount %s: %s", Asset_Store_Mount, esp_err_to_name(ret));
+    }
+    ESP_LOGI(TAG, "FAT%d image, %lu KB mapped at %p", Image.Type, Partition->size / 1024, Mapped);
+#if CONFIG_ASSET_STORE_BENCHMARK
+    Asset_Store_Benchmark();
+#endif
+}
+
+bool Asset_Store_Map(const char *Name, const void **Data, size_t *Size)
+{
+    if (!Mapped) {
+        return false;
+    }
+    xSemaphoreTake(Store_Mutex, portMAX_DELAY);
+    const void *data = Fat_Image_Map(&Image, Name, Size);
+    xSemaphoreGive(Store_Mutex);
+    if (!data) {
+        ESP_LOGW(TAG, "%s is missing or fragmented", Name);
+        return false;
+    }
+    *Data = data;
+    return true;
+}
+
+const lv_img_dsc_t *Asset_Store_Image(const char *Name)
+{
+    for (uint32_t i = 0; i < Image_Count; i++) {
+        if (strcmp(Images[i].Name, Name) == 0) {
+            return &Images[i].Image;
+        }
+    }
+    const uint8_t *data;
+    size_t size;
+    if (Image_Count == Asset_Store_Images_Max || strlen(Name) >= sizeof(Images[0].Name) ||
+        !Asset_Store_Map(Name, (const void **)&data, &size) || size < sizeof(lv_img_header_t)) {
+        return NULL;
+    }
+    // A .bin image is the header as LVGL keeps it in memory, then the pixels
+    lv_img_dsc_t *image = &Images[Image_Count].Image;
+    memcpy(&image->header, data, sizeof(lv_img_header_t));
+    image->data = data + sizeof(lv_img_header_t);
+    image->data_size = size - sizeof(lv_img_header_t);
+    if (image->header.always_zero || image->data_size < lv_img_buf_get_img_size(image->header.w, image->header.h, image->header.cf)) {
+        ESP_LOGW(TAG, "%s is not an LVGL image", Name);
+        return NULL;
+    }
+    strcpy(Images[Image_Count].Name, Name);
+    return &Images[Image_Count++].Image;
+}
+
+// Reads every byte so the time covers getting all of it, not just a pointer
+static void Touch(const uint8_t *Data, size_t Bytes)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < Bytes; i += 4) {
+        sum += *(const uint32_t *)(Data + i);
+    }
+    Touch_Sum = sum;
+}
+
+static int64_t Read_File(const char *Path, uint8_t *Buffer, size_t Bytes)
+{
+    int64_t start = esp_timer_get_time();
+    FILE *f = fopen(Path, "rb");
+    if (!f) {
+        return -1;
+    }
+    size_t read = fread(Buffer, 1, Bytes, f);
+    fclose(f);
+    Touch(Buffer, Bytes);
+    return read == Bytes ? esp_timer_get_time() - start : -1;
+}
+
+// On the I/O task, so the read is timed without waiting behind the player's
+static int32_t Card_Read_Call(void *Context)
+{
+    Card_Read *job = Context;
+    FILE *f = fopen(Bench_Card_File, "wb");
+    if (!f) {
+        return -1;
+    }
+    fwrite(job->Asset, 1, job->Bytes, f);
+    fclose(f);
+    job->Read_us = Read_File(Bench_Card_File, job->Buffer, job->Bytes);
+    remove(Bench_Card_File);
+    return 0;
+}
+
+void Asset_Store_Benchmark(void)
+{
+    LV_IMG_DECLARE(img_lv_demo_music_wave_top);             // Still compiled in
+    const uint8_t *asset;
+    size_t size;
+    if (!Asset_Store_Map(Bench_Asset, (const void **)&asset, &size)) {
+        return;
+    }
+    const uint8_t *compiled = img_lv_demo_music_wave_top.data;
+    size_t bytes = img_lv_demo_music_wave_top.data_size < size ? img_lv_demo_music_wave_top.data_size : size;
+    bytes &= ~3;
+    uint8_t *buffer = heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL);
+    if (!buffer) {
+        return;
+    }
+    size_t evict = Partition->size > Bench_Evict_Bytes ? Bench_Evict_Bytes : Partition->size;
+    const uint8_t *evict_from = Mapped + Partition->size - evict;
+
+    // Cold reads miss the flash cache, the evicting read in between makes sure of it
+    int64_t start;
+    Touch(evict_from, evict);
+    start = esp_timer_get_time();
+    Touch(compiled, bytes);
+    int64_t compiled_cold = esp_timer_get_time() - start;
+    start = esp_timer_get_time();
+    Touch(compiled, bytes);
+    int64_t compiled_warm = esp_timer_get_time() - start;
+
+    Touch(evict_from, evict);
+    start = esp_timer_get_time();
+    Touch(asset, bytes);
+    int64_t mapped_cold = esp_timer_get_time() - start;
+    start = esp_timer_get_time();
+    Touch(asset, bytes);
+    int64_t mapped_warm = esp_timer_get_time() - start;
+
+    char path[64];
+    snprintf(path, sizeof(path), Asset_Store_Mount "/%s", Bench_Asset);
+    int64_t fat_read = Mounted ? Read_File(path, buffer, bytes) : -1;
+
+    Card_Read card = { .Asset = asset, .Buffer = buffer, .Bytes = bytes, .Read_us = -1 };
+    if (SD_Mode.Width) {
+        File_IO_Call_Wait(Io_Class_Log, Card_Read_Call, &card);
+    }
+    free(buffer);
+    ESP_LOGI(TAG, "%u bytes, us cold / warm: compiled in %lld / %lld, mapped %lld / %lld, fread from %s %lld, from the card %lld",
+             (unsigned)bytes, compiled_cold, compiled_warm, mapped_cold, mapped_warm, Asset_Store_Mount, fat_read, card.Read_us);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "lvgl.h"
+
+// The flash_test partition holds a read only FAT image of Asset_Store/image, built with the app and written by
+// idf.py flash (host_bench/make_assets.py makes the files). The partition is mapped into the address space once,
+// so an asset is used where it lies in flash, through the cache like data compiled into the app, with no copy
+// in RAM. The same files can be opened with stdio under Asset_Store_Mount.
+#define Asset_Store_Partition   "flash_test"
+#define Asset_Store_Mount       "/assets"
+#define Asset_Store_Images_Max  16                          // Image descriptors made, they live as long as the mapping
+
+void Asset_Store_Init(void);
+bool Asset_Store_Map(const char *Name, const void **Data, size_t *Size);   // Read only, valid until reboot
+const lv_img_dsc_t *Asset_Store_Image(const char *Name);    // An LVGL .bin image in place, NULL if missing. LVGL task only
+void Asset_Store_Benchmark(void);                           // Logs load times from the app, the partition and the card
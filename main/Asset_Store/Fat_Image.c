@@ -0,0 +1,270 @@
+#include "Fat_Image.h"
+
+#include <string.h>
+
+#define Entry_Bytes             32
+#define Attr_Long_Name          0x0F
+#define Attr_Volume             0x08
+#define Attr_Directory          0x10
+#define Long_Name_Max           255
+#define Entry_Name_Max          (Long_Name_Max * 3 + 1)    // UTF-8
+
+typedef struct {
+    char Long_Name[Entry_Name_Max];                         // Empty if the entry has none
+    char Short_Name[13];                                    // 8.3 with the dot
+    uint8_t Attributes;
+    uint32_t Cluster;
+    uint32_t Size;
+} Dir_Entry;
+
+static uint16_t Get16(const uint8_t *Data)
+{
+    return Data[0] | Data[1] << 8;
+}
+
+static uint32_t Get32(const uint8_t *Data)
+{
+    return Get16(Data) | (uint32_t)Get16(Data + 2) << 16;
+}
+
+// 0 past the end of the chain or on a cluster that can't be
+static uint32_t Next_Cluster(const Fat_Image *Image, uint32_t Cluster)
+{
+    if (Cluster < 2 || Cluster >= Image->Clusters + 2) {
+        return 0;
+    }
+    const uint8_t *fat = Image->Data + Image->Fat_Offset;
+    uint32_t next;
+    if (Image->Type == 12) {
+        uint16_t pair = Get16(fat + Cluster + Cluster / 2);
+        next = (Cluster & 1) ? pair >> 4 : pair & 0x0FFF;
+        next = next >= 0x0FF8 ? 0 : next;
+    } else if (Image->Type == 16) {
+        next = Get16(fat + Cluster * 2);
+        next = next >= 0xFFF8 ? 0 : next;
+    } else {
+        next = Get32(fat + Cluster * 4) & 0x0FFFFFFF;
+        next = next >= 0x0FFFFFF8 ? 0 : next;
+    }
+    return (next >= 2 && next < Image->Clusters + 2) ? next : 0;
+}
+
+static uint32_t Cluster_Offset(const Fat_Image *Image, uint32_t Cluster)
+{
+    return Image->Data_Offset + (Cluster - 2) * Image->Cluster_Bytes;
+}
+
+static bool Same_Name(const char *A, const char *B, size_t B_Length)
+{
+    for (size_t i = 0; i < B_Length; i++) {
+        char a = A[i], b = B[i];
+        if (a >= 'a' && a <= 'z') a -= 'a' - 'A';
+        if (b >= 'a' && b <= 'z') b -= 'a' - 'A';
+        if (a != b || !a) {
+            return false;
+        }
+    }
+    return A[B_Length] == '\0';
+}
+
+// Long name pieces come last part first, each holds 13 UCS-2 characters at these offsets
+static void Take_Long_Part(const uint8_t *Raw, uint16_t *Name)
+{
+    static const uint8_t Offsets[13] = { 1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30 };
+    uint32_t part = (Raw[0] & 0x1F) - 1;
+    if (part >= 20) {
+        return;
+    }
+    for (int i = 0; i < 13; i++) {
+        Name[part * 13 + i] = Get16(Raw + Offsets[i]);
+    }
+}
+
+static void Finish_Long_Name(const uint16_t *Name, char *Out)
+{
+    size_t at = 0;
+    for (int i = 0; i < Long_Name_Max && Name[i] && Name[i] != 0xFFFF; i++) {
+        uint16_t c = Name[i];
+        if (c < 0x80) {
+            Out[at++] = c;
+        } else if (c < 0x800) {
+            Out[at++] = 0xC0 | c >> 6;
+            Out[at++] = 0x80 | (c & 0x3F);
+        } else {
+            Out[at++] = 0xE0 | c >> 12;
+            Out[at++] = 0x80 | ((c >> 6) & 0x3F);
+            Out[at++] = 0x80 | (c & 0x3F);
+        }
+    }
+    Out[at] = '\0';
+}
+
+static void Take_Short_Name(const uint8_t *Raw, char *Out)
+{
+    size_t at = 0;
+    for (int i = 0; i < 8 && Raw[i] != ' '; i++) {
+        Out[at++] = (i == 0 && Raw[i] == 0x05) ? (char)0xE5 : Raw[i];
+    }
+    if (Raw[8] != ' ') {
+        Out[at++] = '.';
+        for (int i = 8; i < 11 && Raw[i] != ' '; i++) {
+            Out[at++] = Raw[i];
+        }
+    }
+    Out[at] = '\0';
+}
+
+// Walks a directory, the root when Cluster is 0 on FAT12 and FAT16, until Name matches
+static bool Find_In_Dir(const Fat_Image *Image, uint32_t Cluster, const char *Name, size_t Length, Dir_Entry *Found)
+{
+    uint16_t long_name[Long_Name_Max + 13];
+    bool have_long = false;
+    bool fixed_root = Cluster == 0 && Image->Type != 32;
+    if (Cluster == 0 && Image->Type == 32) {
+        Cluster = Image->Root_Cluster;
+    }
+    uint32_t offset = fixed_root ? Image->Root_Offset : Cluster_Offset(Image, Cluster);
+    uint32_t entries = fixed_root ? Image->Root_Entries : Image->Cluster_Bytes / Entry_Bytes;
+    uint32_t clusters_left = Image->Clusters;               // A looped chain ends here
+    while (1) {
+        for (uint32_t i = 0; i < entries; i++) {
+            const uint8_t *raw = Image->Data + offset + i * Entry_Bytes;
+            if (raw[0] == 0x00) {
+                return false;                               // End of the directory
+            }
+            if (raw[0] == 0xE5) {
+                have_long = false;
+                continue;
+            }
+            if (raw[11] == Attr_Long_Name) {
+                if (raw[0] & 0x40) {
+                    memset(long_name, 0, sizeof(long_name));
+                    have_long = true;
+                }
+                Take_Long_Part(raw, long_name);
+                continue;
+            }
+            if (raw[11] & Attr_Volume) {
+                have_long = false;
+                continue;
+            }
+            Dir_Entry *entry = Found;
+            Take_Short_Name(raw, entry->Short_Name);
+            if (have_long) {
+                Finish_Long_Name(long_name, entry->Long_Name);
+            } else {
+                entry->Long_Name[0] = '\0';
+            }
+            have_long = false;
+            if (Same_Name(entry->Long_Name, Name, Length) || Same_Name(entry->Short_Name, Name, Length)) {
+                entry->Attributes = raw[11];
+                entry->Cluster = Get16(raw + 26) | (Image->Type == 32 ? (uint32_t)Get16(raw + 20) << 16 : 0);
+                entry->Size = Get32(raw + 28);
+                return true;
+            }
+        }
+        if (fixed_root || !clusters_left--) {
+            return false;
+        }
+        Cluster = Next_Cluster(Image, Cluster);
+        if (!Cluster) {
+            return false;
+        }
+        offset = Cluster_Offset(Image, Cluster);
+    }
+}
+
+bool Fat_Image_Open(Fat_Image *Image, const void *Data, size_t Size)
+{
+    memset(Image, 0, sizeof(*Image));
+    const uint8_t *boot = Data;
+    if (Size < 512 || boot[510] != 0x55 || boot[511] != 0xAA) {
+        return false;
+    }
+    uint32_t sector = Get16(boot + 11);
+    uint32_t per_cluster = boot[13];
+    uint32_t reserved = Get16(boot + 14);
+    uint32_t fats = boot[16];
+    uint32_t root_entries = Get16(boot + 17);
+    uint32_t total = Get16(boot + 19) ? Get16(boot + 19) : Get32(boot + 32);
+    uint32_t fat_sectors = Get16(boot + 22) ? Get16(boot + 22) : Get32(boot + 36);
+    if (sector < 512 || (sector & (sector - 1)) || !per_cluster || (per_cluster & (per_cluster - 1)) || !fats ||
+        !fat_sectors || (uint64_t)total * sector > Size) {
+        return false;
+    }
+    uint32_t root_sectors = (root_entries * Entry_Bytes + sector - 1) / sector;
+    uint32_t data_sector = reserved + fats * fat_sectors + root_sectors;
+    if (data_sector >= total) {
+        return false;
+    }
+    Image->Data = Data;
+    Image->Size = Size;
+    Image->Cluster_Bytes = sector * per_cluster;
+    Image->Fat_Offset = reserved * sector;
+    Image->Root_Offset = (reserved + fats * fat_sectors) * sector;
+    Image->Root_Entries = root_entries;
+    Image->Data_Offset = data_sector * sector;
+    Image->Clusters = (total - data_sector) / per_cluster;
+    // The type follows from the cluster count alone, as the FAT specification has it
+    Image->Type = Image->Clusters < 4085 ? 12 : (Image->Clusters < 65525 ? 16 : 32);
+    if (Image->Type == 32) {
+        Image->Root_Cluster = Get32(boot + 44);
+    } else if (!root_entries) {
+        return false;
+    }
+    uint32_t fat_bytes = Image->Type == 12 ? (Image->Clusters + 2) * 3 / 2 + 1 : (Image->Clusters + 2) * Image->Type / 8;
+    return fat_bytes <= fat_sectors * sector;
+}
+
+bool Fat_Image_Find(const Fat_Image *Image, const char *Path, Fat_Entry *Entry)
+{
+    static Dir_Entry found;                                 // Long names make it big for a stack
+    uint32_t cluster = 0;
+    bool directory = true;
+    uint32_t size = 0;
+    while (*Path == '/') {
+        Path++;
+    }
+    while (*Path) {
+        const char *end = strchr(Path, '/');
+        size_t length = end ? (size_t)(end - Path) : strlen(Path);
+        if (!directory || !Find_In_Dir(Image, cluster, Path, length, &found)) {
+            return false;
+        }
+        cluster = found.Cluster;
+        directory = found.Attributes & Attr_Directory;
+        size = directory ? 0 : found.Size;
+        Path += length;
+        while (*Path == '/') {
+            Path++;
+        }
+    }
+    if (cluster == 0 && directory) {
+        cluster = Image->Type == 32 ? Image->Root_Cluster : 0;
+    }
+    Entry->Directory = directory;
+    Entry->Size = size;
+    Entry->Offset = cluster >= 2 ? Cluster_Offset(Image, cluster) : (directory ? Image->Root_Offset : 0);
+    Entry->Contiguous = true;
+    if (!directory && size) {
+        if (cluster < 2 || (uint64_t)Entry->Offset + size > Image->Size) {
+            Entry->Contiguous = false;
+        }
+        for (uint32_t left = (size - 1) / Image->Cluster_Bytes; left && Entry->Contiguous; left--) {
+            uint32_t next = Next_Cluster(Image, cluster);
+            Entry->Contiguous = next == cluster + 1;
+            cluster = next;
+        }
+    }
+    return true;
+}
+
+const void *Fat_Image_Map(const Fat_Image *Image, const char *Path, size_t *Size)
+{
+    Fat_Entry entry;
+    if (!Fat_Image_Find(Image, Path, &entry) || entry.Directory || !entry.Contiguous) {
+        return NULL;
+    }
+    *Size = entry.Size;
+    return Image->Data + entry.Offset;
+}
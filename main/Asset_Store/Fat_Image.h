@@ -0,0 +1,34 @@
+#pragma once
+
+// Files in a FAT volume that is mapped into memory, independent of FreeRTOS so it also builds on the host, see
+// host_bench/. Read only: FAT12, FAT16 and FAT32, long names included. A file whose clusters follow each other
+// can be used where it lies in the image, which is how Asset_Store serves assets from flash without a copy.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    const uint8_t *Data;
+    size_t Size;
+    uint32_t Cluster_Bytes;
+    uint32_t Fat_Offset;                                    // First FAT, the copies are not read
+    uint32_t Root_Offset;                                   // FAT12 and FAT16 keep the root directory apart
+    uint32_t Root_Entries;
+    uint32_t Root_Cluster;                                  // FAT32 keeps it in clusters like any directory
+    uint32_t Data_Offset;                                   // Cluster 2
+    uint32_t Clusters;                                      // Data clusters
+    uint8_t Type;                                           // 12, 16 or 32
+} Fat_Image;
+
+typedef struct {
+    uint32_t Offset;                                        // First byte in the image
+    uint32_t Size;
+    bool Contiguous;                                        // All of it at Offset, else only the first cluster is
+    bool Directory;
+} Fat_Entry;
+
+bool Fat_Image_Open(Fat_Image *Image, const void *Data, size_t Size);  // False if it is not a FAT volume
+// Path is '/' separated from the root, case ignored. Not reentrant, callers serialize
+bool Fat_Image_Find(const Fat_Image *Image, const char *Path, Fat_Entry *Entry);
+const void *Fat_Image_Map(const Fat_Image *Image, const char *Path, size_t *Size);  // NULL unless found and contiguous
@@ -0,0 +1,580 @@
+/**
+ * Host bench for Fat_Image, the reader Asset_Store serves assets from flash with.
+ *
+ * It builds FAT12, FAT16 and FAT32 volumes in memory the way a formatter would lay them out,
+ * with 512 byte sectors and with the 4096 byte ones of the images the firmware ships, with long names, an accented name, nested directories, a directory spread over clusters that
+ * don't follow each other, a deleted entry, an empty file and a fragmented file, and checks
+ * what Fat_Image_Find() and Fat_Image_Map() return for each: mapped files have to point at
+ * their own bytes in the image, the fragmented one has to be refused rather than read wrong.
+ * Names are looked up by long name and by 8.3 alias, with case ignored. Volumes that are not
+ * FAT, or are cut short, have to be refused by Fat_Image_Open().
+ *
+ * Lookups are timed on the largest directory, as Asset_Store_Map() does one per asset.
+ *
+ * -i checks a real image, such as build/flash_test.bin, against the directory it was made from:
+ * every file under it has to map, with the same bytes.
+ *
+ * usage: asset_bench [-n lookups] [-i image -d directory]
+ */
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "Fat_Image.h"
+
+#define USAGE "usage: %s [-n lookups] [-i image -d directory]\n"
+
+#define Many_Clusters           7                           // Of directory for the "many" test, one sector each
+
+static int failures = 0;
+
+#define CHECK(condition, ...)                                   \
+    do {                                                        \
+        if (!(condition)) {                                     \
+            printf("  failed: " __VA_ARGS__);                   \
+            printf("\n");                                       \
+            failures++;                                         \
+        }                                                       \
+    } while (0)
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* ---- Building an image ---- */
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    int type;
+    uint32_t sector_bytes;
+    uint32_t per_cluster;
+    uint32_t reserved;
+    uint32_t fats;
+    uint32_t fat_sectors;
+    uint32_t root_entries;
+    uint32_t clusters;
+    uint32_t fat_offset;
+    uint32_t root_offset;
+    uint32_t data_offset;
+    uint32_t next_free;
+    uint32_t alias_number;                                  // Last ~N handed out
+} image_t;
+
+typedef struct {
+    uint32_t cluster[16];                                   // Chain, none for the FAT12 and FAT16 root
+    uint32_t count;
+    uint32_t used;                                          // Entries written
+} dir_t;
+
+static void put16(uint8_t *p, uint32_t v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    put16(p, v);
+    put16(p + 2, v >> 16);
+}
+
+static void set_fat(image_t *img, uint32_t cluster, uint32_t value)
+{
+    for (uint32_t f = 0; f < img->fats; f++) {
+        uint8_t *fat = img->data + img->fat_offset + f * img->fat_sectors * img->sector_bytes;
+        if (img->type == 12) {
+            uint8_t *p = fat + cluster + cluster / 2;
+            uint32_t pair = p[0] | p[1] << 8;
+            pair = (cluster & 1) ? (pair & 0x000F) | value << 4 : (pair & 0xF000) | (value & 0x0FFF);
+            put16(p, pair);
+        } else if (img->type == 16) {
+            put16(fat + cluster * 2, value);
+        } else {
+            put32(fat + cluster * 4, value & 0x0FFFFFFF);
+        }
+    }
+}
+
+static uint32_t end_of_chain(const image_t *img)
+{
+    return img->type == 12 ? 0x0FFF : (img->type == 16 ? 0xFFFF : 0x0FFFFFFF);
+}
+
+static uint8_t *cluster_data(const image_t *img, uint32_t cluster)
+{
+    return img->data + img->data_offset + (size_t)(cluster - 2) * img->per_cluster * img->sector_bytes;
+}
+
+// Clusters for a chain, leaving a free one between each when fragmented
+static void alloc_chain(image_t *img, uint32_t count, bool fragmented, uint32_t *out)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = img->next_free;
+        img->next_free += fragmented ? 2 : 1;
+        if (img->next_free >= img->clusters + 2) {
+            fprintf(stderr, "image full\n");
+            exit(2);
+        }
+        if (i) {
+            set_fat(img, out[i - 1], out[i]);
+        }
+    }
+    if (count) {
+        set_fat(img, out[count - 1], end_of_chain(img));
+    }
+}
+
+// Laid out as mkfs.fat would: reserved sectors, FAT copies, the FAT12 and FAT16 root, then clusters
+static void image_init(image_t *img, int type, uint32_t sector_bytes, uint32_t total, uint32_t per_cluster)
+{
+    memset(img, 0, sizeof(*img));
+    img->type = type;
+    img->sector_bytes = sector_bytes;
+    img->per_cluster = per_cluster;
+    img->reserved = type == 32 ? 32 : 1;
+    img->fats = 2;
+    img->root_entries = type == 32 ? 0 : 512;
+    uint32_t root_sectors = img->root_entries * 32 / sector_bytes;
+    uint32_t estimate = (total - img->reserved - root_sectors) / per_cluster + 2;
+    uint32_t fat_bytes = type == 12 ? estimate * 3 / 2 + 1 : estimate * type / 8;
+    img->fat_sectors = (fat_bytes + sector_bytes - 1) / sector_bytes;
+    uint32_t data_sector = img->reserved + img->fats * img->fat_sectors + root_sectors;
+    img->clusters = (total - data_sector) / per_cluster;
+    img->fat_offset = img->reserved * sector_bytes;
+    img->root_offset = (img->reserved + img->fats * img->fat_sectors) * sector_bytes;
+    img->data_offset = data_sector * sector_bytes;
+    img->next_free = 2;
+    img->size = (size_t)total * sector_bytes;
+    img->data = calloc(1, img->size);
+
+    uint8_t *boot = img->data;
+    boot[0] = 0xEB;
+    boot[1] = 0x3C;
+    boot[2] = 0x90;
+    memcpy(boot + 3, "MSDOS5.0", 8);
+    put16(boot + 11, sector_bytes);
+    boot[13] = per_cluster;
+    put16(boot + 14, img->reserved);
+    boot[16] = img->fats;
+    put16(boot + 17, img->root_entries);
+    if (total < 0x10000 && type != 32) {
+        put16(boot + 19, total);
+    } else {
+        put32(boot + 32, total);
+    }
+    boot[21] = 0xF8;
+    if (type == 32) {
+        put32(boot + 36, img->fat_sectors);
+    } else {
+        put16(boot + 22, img->fat_sectors);
+    }
+    boot[510] = 0x55;
+    boot[511] = 0xAA;
+    set_fat(img, 0, 0x0FFFFFF8);
+    set_fat(img, 1, end_of_chain(img));
+}
+
+static dir_t make_root(image_t *img)
+{
+    dir_t root = { .count = 0 };
+    if (img->type == 32) {
+        root.count = 1;
+        alloc_chain(img, 1, false, root.cluster);
+        put32(img->data + 44, root.cluster[0]);
+    }
+    return root;
+}
+
+static uint8_t *dir_slot(const image_t *img, dir_t *dir)
+{
+    uint32_t per_cluster = img->per_cluster * img->sector_bytes / 32;
+    uint32_t capacity = dir->count ? dir->count * per_cluster : img->root_entries;
+    if (dir->used == capacity) {
+        fprintf(stderr, "directory full\n");
+        exit(2);
+    }
+    uint32_t i = dir->used++;
+    if (!dir->count) {
+        return img->data + img->root_offset + i * 32;
+    }
+    return cluster_data(img, dir->cluster[i / per_cluster]) + (i % per_cluster) * 32;
+}
+
+static uint8_t short_checksum(const uint8_t *name)
+{
+    uint8_t sum = 0;
+    for (int i = 0; i < 11; i++) {
+        sum = ((sum & 1) << 7) + (sum >> 1) + name[i];
+    }
+    return sum;
+}
+
+static size_t utf8_to_ucs2(const char *in, uint16_t *out)
+{
+    const uint8_t *s = (const uint8_t *)in;
+    size_t n = 0;
+    while (*s) {
+        if (*s < 0x80) {
+            out[n++] = *s++;
+        } else if ((*s & 0xE0) == 0xC0) {
+            out[n++] = (s[0] & 0x1F) << 6 | (s[1] & 0x3F);
+            s += 2;
+        } else {
+            out[n++] = (s[0] & 0x0F) << 12 | (s[1] & 0x3F) << 6 | (s[2] & 0x3F);
+            s += 3;
+        }
+    }
+    return n;
+}
+
+// The 11 byte short name. A name that isn't already upper case 8.3 gets an alias and a long name
+static bool short_name(const char *name, uint8_t *out, uint32_t *alias_number)
+{
+    memset(out, ' ', 11);
+    const char *dot = strrchr(name, '.');
+    size_t base = dot ? (size_t)(dot - name) : strlen(name);
+    size_t ext = dot ? strlen(dot + 1) : 0;
+    bool fits = base >= 1 && base <= 8 && ext <= 3;
+    for (const char *c = name; *c && fits; c++) {
+        fits = (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') || *c == '_' || c == dot;
+    }
+    if (fits) {
+        memcpy(out, name, base);
+        memcpy(out + 8, dot + 1, ext);
+        return false;
+    }
+    size_t at = 0;
+    for (const char *c = name; c < name + base && at < 6; c++) {
+        char u = *c >= 'a' && *c <= 'z' ? *c - 'a' + 'A' : *c;
+        if ((u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '_') {
+            out[at++] = u;
+        }
+    }
+    char tail[8];
+    snprintf(tail, sizeof(tail), "~%u", (unsigned)++*alias_number);
+    memcpy(out + at, tail, strlen(tail));
+    for (size_t i = 0; i < 3 && dot && dot[1 + i]; i++) {
+        char u = dot[1 + i] >= 'a' && dot[1 + i] <= 'z' ? dot[1 + i] - 'a' + 'A' : dot[1 + i];
+        out[8 + i] = u;
+    }
+    return true;
+}
+
+static void add_entry(image_t *img, dir_t *dir, const char *name, uint8_t attributes, uint32_t cluster, uint32_t size)
+{
+    uint8_t raw[11];
+    if (short_name(name, raw, &img->alias_number)) {
+        uint16_t ucs[260];
+        size_t length = utf8_to_ucs2(name, ucs);
+        size_t parts = (length + 12) / 13;
+        for (size_t i = length; i < parts * 13; i++) {
+            ucs[i] = i == length ? 0x0000 : 0xFFFF;
+        }
+        static const uint8_t offsets[13] = { 1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30 };
+        uint8_t sum = short_checksum(raw);
+        for (size_t part = parts; part > 0; part--) {
+            uint8_t *e = dir_slot(img, dir);
+            e[0] = part | (part == parts ? 0x40 : 0);
+            e[11] = 0x0F;
+            e[13] = sum;
+            for (int i = 0; i < 13; i++) {
+                put16(e + offsets[i], ucs[(part - 1) * 13 + i]);
+            }
+        }
+    }
+    uint8_t *e = dir_slot(img, dir);
+    memcpy(e, raw, 11);
+    e[11] = attributes;
+    put16(e + 20, cluster >> 16);
+    put16(e + 26, cluster);
+    put32(e + 28, size);
+}
+
+static uint32_t fill_byte(uint32_t seed, uint32_t i)
+{
+    return (seed * 2654435761u + i * 40503u) >> 13 & 0xFF;
+}
+
+// A file of recognizable bytes, its offset in the image returned
+static uint32_t add_file(image_t *img, dir_t *dir, const char *name, uint32_t size, bool fragmented, uint32_t seed)
+{
+    uint32_t cluster_bytes = img->per_cluster * img->sector_bytes;
+    uint32_t count = (size + cluster_bytes - 1) / cluster_bytes;
+    uint32_t *chain = malloc((count + 1) * sizeof(uint32_t));
+    alloc_chain(img, count, fragmented, chain);
+    for (uint32_t i = 0; i < size; i++) {
+        cluster_data(img, chain[i / cluster_bytes])[i % cluster_bytes] = fill_byte(seed, i);
+    }
+    uint32_t first = count ? chain[0] : 0;
+    free(chain);
+    add_entry(img, dir, name, 0x20, first, size);
+    return first ? (uint32_t)(cluster_data(img, first) - img->data) : 0;
+}
+
+static dir_t add_dir(image_t *img, dir_t *parent, const char *name, uint32_t clusters, bool fragmented)
+{
+    dir_t dir = { .count = clusters };
+    alloc_chain(img, clusters, fragmented, dir.cluster);
+    add_entry(img, parent, name, 0x10, dir.cluster[0], 0);
+    // "." and "..", a parent of 0 is the root
+    uint32_t parent_cluster = parent->count && !(img->type == 32 && parent->cluster[0] == 2) ? parent->cluster[0] : 0;
+    uint8_t *dot = dir_slot(img, &dir);
+    memcpy(dot, ".          ", 11);
+    dot[11] = 0x10;
+    put16(dot + 20, dir.cluster[0] >> 16);
+    put16(dot + 26, dir.cluster[0]);
+    uint8_t *dotdot = dir_slot(img, &dir);
+    memcpy(dotdot, "..         ", 11);
+    dotdot[11] = 0x10;
+    put16(dotdot + 20, parent_cluster >> 16);
+    put16(dotdot + 26, parent_cluster);
+    return dir;
+}
+
+/* ---- Checks ---- */
+
+static bool same_bytes(const uint8_t *data, uint32_t size, uint32_t seed)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        if (data[i] != fill_byte(seed, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check_mapped(const Fat_Image *fat, const image_t *img, const char *path, uint32_t offset, uint32_t size,
+                         uint32_t seed)
+{
+    size_t mapped_size = 0;
+    const uint8_t *data = Fat_Image_Map(fat, path, &mapped_size);
+    CHECK(data == img->data + offset, "FAT%d map %s at %ld, expected %u", img->type, path,
+          data ? (long)(data - img->data) : -1L, (unsigned)offset);
+    CHECK(mapped_size == size, "FAT%d map %s size %zu, expected %u", img->type, path, mapped_size, (unsigned)size);
+    if (data) {
+        CHECK(same_bytes(data, size, seed), "FAT%d map %s bytes differ", img->type, path);
+    }
+}
+
+static double check_volume(int type, uint32_t sector_bytes, uint32_t total, uint32_t per_cluster, long lookups)
+{
+    image_t img;
+    image_init(&img, type, sector_bytes, total, per_cluster);
+    dir_t root = make_root(&img);
+
+    uint32_t readme = add_file(&img, &root, "README.TXT", 700, false, 1);
+    uint32_t wave = add_file(&img, &root, "A long file name.bin", 40000, false, 2);
+    add_file(&img, &root, "empty.txt", 0, false, 3);
+    uint32_t accented = add_file(&img, &root, "caf\xc3\xa9 \xe9\x9f\xb3\xe4\xb9\x90.txt", 100, false, 4);
+    // A deleted entry in front of a live one with the same name must be passed over
+    add_file(&img, &root, "GONE.BIN", 100, false, 5);
+    uint8_t *root_entries = root.count ? cluster_data(&img, root.cluster[0]) : img.data + img.root_offset;
+    root_entries[(root.used - 1) * 32] = 0xE5;
+    uint32_t gone = add_file(&img, &root, "GONE.BIN", 300, false, 6);
+
+    dir_t covers = add_dir(&img, &root, "covers", 1, false);
+    uint32_t cover = add_file(&img, &covers, "cover_1.bin", 61604, false, 7);
+    add_file(&img, &covers, "Fragmented asset.bin", 5000, true, 8);
+    dir_t nested = add_dir(&img, &covers, "Nested Folder", 1, false);
+    uint32_t deep = add_file(&img, &nested, "deep.bin", 1000, false, 9);
+
+    // Enough entries to reach into the last cluster, after "." and ".."
+    int many_files = (Many_Clusters - 1) * per_cluster * sector_bytes / 32 + 4;
+    dir_t many = add_dir(&img, &root, "many", Many_Clusters, true);
+    char name[32];
+    char last_name[32] = "";
+    uint32_t last = 0;
+    for (int i = 0; i < many_files; i++) {
+        snprintf(name, sizeof(name), "N%04d.BIN", i);
+        snprintf(last_name, sizeof(last_name), "many/n%04d.bin", i);
+        last = add_file(&img, &many, name, 64, false, 100 + i);
+    }
+
+    Fat_Image fat;
+    CHECK(Fat_Image_Open(&fat, img.data, img.size), "FAT%d open", type);
+    CHECK(fat.Cluster_Bytes == per_cluster * sector_bytes, "FAT%d clusters of %u bytes, expected %u", type,
+          (unsigned)fat.Cluster_Bytes, (unsigned)(per_cluster * sector_bytes));
+    CHECK(fat.Type == type, "FAT%d read as FAT%d", type, fat.Type);
+
+    check_mapped(&fat, &img, "README.TXT", readme, 700, 1);
+    check_mapped(&fat, &img, "/readme.txt", readme, 700, 1);
+    check_mapped(&fat, &img, "A long file name.bin", wave, 40000, 2);
+    check_mapped(&fat, &img, "a LONG file NAME.BIN", wave, 40000, 2);
+    check_mapped(&fat, &img, "ALONGF~1.BIN", wave, 40000, 2);
+    check_mapped(&fat, &img, "caf\xc3\xa9 \xe9\x9f\xb3\xe4\xb9\x90.txt", accented, 100, 4);
+    check_mapped(&fat, &img, "GONE.BIN", gone, 300, 6);
+    check_mapped(&fat, &img, "covers/cover_1.bin", cover, 61604, 7);
+    check_mapped(&fat, &img, "COVERS//COVER_1.BIN", cover, 61604, 7);
+    check_mapped(&fat, &img, "covers/nested folder/deep.bin", deep, 1000, 9);
+    check_mapped(&fat, &img, last_name, last, 64, 100 + many_files - 1);
+
+    Fat_Entry entry;
+    CHECK(Fat_Image_Find(&fat, "empty.txt", &entry) && entry.Size == 0 && !entry.Directory,
+          "FAT%d empty file", type);
+    CHECK(Fat_Image_Find(&fat, "covers/Fragmented asset.bin", &entry) && entry.Size == 5000 && !entry.Contiguous,
+          "FAT%d fragmented file seen as contiguous", type);
+    size_t size;
+    CHECK(!Fat_Image_Map(&fat, "covers/Fragmented asset.bin", &size), "FAT%d fragmented file mapped", type);
+    CHECK(Fat_Image_Find(&fat, "covers", &entry) && entry.Directory, "FAT%d directory", type);
+    CHECK(!Fat_Image_Map(&fat, "covers", &size), "FAT%d directory mapped", type);
+    CHECK(Fat_Image_Find(&fat, "/", &entry) && entry.Directory, "FAT%d root", type);
+    CHECK(Fat_Image_Find(&fat, "covers/..", &entry) && entry.Directory, "FAT%d dot dot", type);
+
+    static const char *missing[] = {
+        "covers/none.bin", "none/cover_1.bin", "README.TXT/x", "cover_1.bin", "READM", "README.TXTX", "ALONGF~2.BIN",
+        "many/n9999.bin",
+    };
+    for (size_t i = 0; i < sizeof(missing) / sizeof(missing[0]); i++) {
+        CHECK(!Fat_Image_Find(&fat, missing[i], &entry), "FAT%d found %s", type, missing[i]);
+    }
+
+    Fat_Image cut;
+    CHECK(!Fat_Image_Open(&cut, img.data, img.size / 2), "FAT%d cut short opened", type);
+
+    double start = now_s();
+    for (long i = 0; i < lookups; i++) {
+        Fat_Image_Find(&fat, last_name, &entry);
+    }
+    double us = (now_s() - start) * 1e6 / lookups;
+    printf("  FAT%-2d %4u byte sectors, %6u clusters of %5u bytes, %5.2f us per lookup past %d entries\n", type,
+           (unsigned)sector_bytes, (unsigned)fat.Clusters, (unsigned)fat.Cluster_Bytes, us, many_files + 2);
+    free(img.data);
+    return us;
+}
+
+static void check_not_fat(void)
+{
+    uint8_t *junk = malloc(64 * 1024);
+    for (int i = 0; i < 64 * 1024; i++) {
+        junk[i] = fill_byte(99, i);
+    }
+    Fat_Image fat;
+    CHECK(!Fat_Image_Open(&fat, junk, 64 * 1024), "random bytes opened");
+    junk[510] = 0x55;
+    junk[511] = 0xAA;
+    CHECK(!Fat_Image_Open(&fat, junk, 64 * 1024), "random bytes with a signature opened");
+    memset(junk, 0, 64 * 1024);
+    CHECK(!Fat_Image_Open(&fat, junk, 64 * 1024), "erased flash opened");
+    CHECK(!Fat_Image_Open(&fat, junk, 100), "short buffer opened");
+    free(junk);
+}
+
+/* ---- A real image ---- */
+
+static uint8_t *read_all(const char *path, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = malloc(*size ? *size : 1);
+    if (fread(data, 1, *size, f) != *size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    return data;
+}
+
+static void check_tree(const Fat_Image *fat, const char *root, const char *relative, int *files)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", root, relative);
+    DIR *dir = opendir(path);
+    if (!dir) {
+        CHECK(0, "can't open %s", path);
+        return;
+    }
+    struct dirent *d;
+    while ((d = readdir(dir))) {
+        if (d->d_name[0] == '.') {
+            continue;
+        }
+        char child[512];
+        snprintf(child, sizeof(child), "%s%s%s", relative, *relative ? "/" : "", d->d_name);
+        snprintf(path, sizeof(path), "%s/%s", root, child);
+        struct stat st;
+        if (stat(path, &st)) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            check_tree(fat, root, child, files);
+            continue;
+        }
+        size_t expected_size, size = 0;
+        uint8_t *expected = read_all(path, &expected_size);
+        const void *data = Fat_Image_Map(fat, child, &size);
+        CHECK(data && expected && size == expected_size && !memcmp(data, expected, size), "%s differs or won't map",
+              child);
+        free(expected);
+        (*files)++;
+    }
+    closedir(dir);
+}
+
+static void check_image(const char *image_path, const char *source)
+{
+    size_t size;
+    uint8_t *data = read_all(image_path, &size);
+    Fat_Image fat;
+    if (!data || !Fat_Image_Open(&fat, data, size)) {
+        CHECK(0, "%s is not a FAT image", image_path);
+        free(data);
+        return;
+    }
+    int files = 0;
+    check_tree(&fat, source, "", &files);
+    printf("  %s: FAT%d, %d files of %s mapped\n", image_path, fat.Type, files, source);
+    free(data);
+}
+
+int main(int argc, char **argv)
+{
+    long lookups = 200000;
+    const char *image_path = NULL;
+    const char *source = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            lookups = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "-i") && i + 1 < argc) {
+            image_path = argv[++i];
+        } else if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+            source = argv[++i];
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (lookups < 1 || !image_path != !source) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+
+    printf("Volumes built in memory:\n");
+    static const uint32_t sector_sizes[] = { 512, 4096 };
+    for (size_t i = 0; i < sizeof(sector_sizes) / sizeof(sector_sizes[0]); i++) {
+        check_volume(12, sector_sizes[i], 4000, 1, lookups);
+        check_volume(16, sector_sizes[i], 40000, 1, lookups);
+        check_volume(32, sector_sizes[i], 70000, 1, lookups);
+    }
+    check_not_fat();
+    if (image_path) {
+        printf("Image:\n");
+        check_image(image_path, source);
+    }
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Builds the files of the asset partition, main/Asset_Store/image/, which the firmware build
+turns into the read only FAT image for flash_test.
+
+    make_assets.py [--lvgl components/lvgl__lvgl] [--out main/Asset_Store/image]
+
+covers/cover_N.bin  the music player's default covers, taken from the LVGL demo sources as
+                    LVGL binary images: the 4 byte lv_img_header_t, then RGB565 pixels for
+                    LV_COLOR_DEPTH 16 without LV_COLOR_16_SWAP, as sdkconfig has it
+earcons/*.wav       short cues, 16 bit mono at 16 kHz
+
+Run it again after changing either, the output is the same for the same input.
+"""
+
+import argparse
+import math
+import os
+import re
+import struct
+import wave
+
+REPO = os.path.normpath(os.path.join(os.path.dirname(__file__), "..", "..", ".."))
+COLOR_SECTION = "#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0"
+CF_TRUE_COLOR = 4
+RATE = 16000
+
+# Name, then (frequency Hz, ms) per note
+EARCONS = {
+    "listen": [(880, 70), (1320, 110)],                     # Rising, the microphone is open
+    "done": [(1320, 70), (880, 110)],                       # Falling, it closed
+    "error": [(330, 90), (0, 50), (330, 90)],               # Low and twice
+}
+
+
+def lvgl_image(source):
+    with open(source) as f:
+        text = f.read()
+    section = text[text.index(COLOR_SECTION) + len(COLOR_SECTION):]
+    section = section[:section.index("#endif")]
+    pixels = bytes(int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]{2}", section))
+    w = int(re.search(r"\.header\.w\s*=\s*(\d+)", text).group(1))
+    h = int(re.search(r"\.header\.h\s*=\s*(\d+)", text).group(1))
+    if len(pixels) != w * h * 2:
+        raise SystemExit(f"{source}: {len(pixels)} bytes for {w}x{h}")
+    header = CF_TRUE_COLOR | w << 10 | h << 21
+    return struct.pack("<I", header) + pixels
+
+
+def earcon(notes):
+    samples = []
+    for frequency, ms in notes:
+        count = RATE * ms // 1000
+        fade = min(count // 4, RATE * 8 // 1000)            # 8 ms ramps, no clicks
+        for i in range(count):
+            gain = min(1.0, i / fade, (count - 1 - i) / fade) if fade else 1.0
+            samples.append(int(12000 * gain * math.sin(2 * math.pi * frequency * i / RATE)))
+    return struct.pack(f"<{len(samples)}h", *samples)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the asset partition's files.")
+    parser.add_argument("--lvgl", default=os.path.join(REPO, "components", "lvgl__lvgl"))
+    parser.add_argument("--out", default=os.path.join(REPO, "main", "Asset_Store", "image"))
+    args = parser.parse_args()
+
+    os.makedirs(os.path.join(args.out, "covers"), exist_ok=True)
+    os.makedirs(os.path.join(args.out, "earcons"), exist_ok=True)
+    for n in (1, 2, 3):
+        source = os.path.join(args.lvgl, "demos", "music", "assets", f"img_lv_demo_music_cover_{n}.c")
+        path = os.path.join(args.out, "covers", f"cover_{n}.bin")
+        with open(path, "wb") as f:
+            f.write(lvgl_image(source))
+        print(f"{path}: {os.path.getsize(path)} bytes")
+    for name, notes in EARCONS.items():
+        path = os.path.join(args.out, "earcons", f"{name}.wav")
+        with wave.open(path, "wb") as w:
+            w.setnchannels(1)
+            w.setsampwidth(2)
+            w.setframerate(RATE)
+            w.writeframes(earcon(notes))
+        print(f"{path}: {os.path.getsize(path)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,250 @@
+#include "Audio_Spectrum.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_cpu.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "AUDIO SPECTRUM";
+
+#define Spectrum_Low_Hz         60
+#define Spectrum_High_Hz        16000
+#define Spectrum_Floor_Log2     6                   // Band power (log2) shown as an empty bar, about -60 dBFS
+#define Spectrum_Range_Log2     20                  // Band power range (log2) from empty to full, 3 dB per step
+#define Spectrum_Decay          12                  // Level fall per analysis, a full bar empties in ~0.7 s
+#define Spectrum_Load_Period    10                  // Seconds of audio per Audio_Spectrum_Get_Load() figure
+
+/*-------------------- Tables, the band edges follow the sample rate --------------------*/
+static int16_t Window[Spectrum_FFT_Size];                       // Hann, Q15
+static int16_t Twiddle_Cos[Spectrum_FFT_Size / 2];              // Q15
+static int16_t Twiddle_Sin[Spectrum_FFT_Size / 2];
+static uint16_t Band_Edge[Spectrum_Band_Count + 1];             // First bin of each band
+static uint32_t Rate = 0;
+static uint32_t Interval = 0;                                   // Samples between analyses
+
+/*-------------------- Audio task state --------------------*/
+static int16_t Ring[Spectrum_FFT_Size];                         // Mono mix of the most recent output
+static uint32_t Ring_Pos = 0;
+static uint32_t Ring_Fill = 0;
+static uint32_t Samples_Since = 0;
+static int16_t Re[Spectrum_FFT_Size];
+static int16_t Im[Spectrum_FFT_Size];
+static uint8_t Levels[Spectrum_Band_Count];
+static volatile bool Reset_Pending = false;
+
+static uint64_t Busy_Cycles = 0;
+static uint32_t Load_Samples = 0;
+
+/*-------------------- Published to other tasks --------------------*/
+static uint32_t Sequence = 0;                                   // Odd while Published is being written
+static uint8_t Published[Spectrum_Band_Count];
+static volatile uint16_t Energy = 0;
+static volatile uint16_t Load = 0;
+
+static void Build_Bands(void)
+{
+    float high = (Rate / 2 < Spectrum_High_Hz) ? Rate / 2 : Spectrum_High_Hz;
+    float ratio = powf(high / Spectrum_Low_Hz, 1.0f / Spectrum_Band_Count);
+    float freq = Spectrum_Low_Hz;
+    for (int b = 0; b <= Spectrum_Band_Count; b++) {
+        uint32_t bin = (uint32_t)(freq * Spectrum_FFT_Size / Rate + 0.5f);
+        if (bin < 1) bin = 1;                                   // Skip DC
+        if (b > 0 && bin <= Band_Edge[b - 1]) bin = Band_Edge[b - 1] + 1;   // At least one bin per band
+        if (bin > Spectrum_FFT_Size / 2) bin = Spectrum_FFT_Size / 2;
+        Band_Edge[b] = bin;
+        freq *= ratio;
+    }
+}
+
+void Audio_Spectrum_Init(uint32_t Sample_Rate)
+{
+    for (int n = 0; n < Spectrum_FFT_Size; n++) {
+        float w = 0.5f * (1.0f - cosf(2.0f * (float)M_PI * n / (Spectrum_FFT_Size - 1)));
+        Window[n] = (int16_t)(w * 32767.0f + 0.5f);
+    }
+    for (int k = 0; k < Spectrum_FFT_Size / 2; k++) {
+        float a = 2.0f * (float)M_PI * k / Spectrum_FFT_Size;
+        Twiddle_Cos[k] = (int16_t)lrintf(cosf(a) * 32767.0f);
+        Twiddle_Sin[k] = (int16_t)lrintf(sinf(a) * 32767.0f);
+    }
+    Audio_Spectrum_Set_Rate(Sample_Rate);
+}
+
+// Called from the audio task, the same task that feeds samples
+void Audio_Spectrum_Set_Rate(uint32_t Sample_Rate)
+{
+    if (Sample_Rate == 0 || Sample_Rate == Rate) {
+        return;
+    }
+    Rate = Sample_Rate;
+    Interval = Rate / Spectrum_Update_Rate;
+    Build_Bands();
+    Reset_Pending = true;
+}
+
+void Audio_Spectrum_Reset(void)
+{
+    Reset_Pending = true;                                       // Applied by the audio task on its next feed
+}
+
+// Radix-2 decimation in time, each stage halves the values so the output is X[k] / N and never overflows
+static void FFT_Q15(int16_t *re, int16_t *im)
+{
+    for (uint32_t i = 1, j = 0; i < Spectrum_FFT_Size; i++) {
+        uint32_t bit = Spectrum_FFT_Size >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            int16_t t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    for (uint32_t half = 1, step = Spectrum_FFT_Size / 2; half < Spectrum_FFT_Size; half <<= 1, step >>= 1) {
+        for (uint32_t k = 0; k < half; k++) {
+            int32_t wr = Twiddle_Cos[k * step];
+            int32_t wi = -Twiddle_Sin[k * step];
+            for (uint32_t a = k; a < Spectrum_FFT_Size; a += half << 1) {
+                uint32_t b = a + half;
+                int32_t tr = (wr * re[b] - wi * im[b]) >> 15;
+                int32_t ti = (wr * im[b] + wi * re[b]) >> 15;
+                int32_t ar = re[a];
+                int32_t ai = im[a];
+                re[b] = (int16_t)((ar - tr) >> 1);
+                im[b] = (int16_t)((ai - ti) >> 1);
+                re[a] = (int16_t)((ar + tr) >> 1);
+                im[a] = (int16_t)((ai + ti) >> 1);
+            }
+        }
+    }
+}
+
+// log2(x) in Q4
+static uint32_t Log2_Q4(uint32_t x)
+{
+    if (x == 0) {
+        return 0;
+    }
+    uint32_t e = 31 - __builtin_clz(x);
+    uint32_t frac = (e >= 4) ? (x >> (e - 4)) : (x << (4 - e));
+    return (e << 4) | (frac & 15);
+}
+
+static uint16_t Sqrt_U32(uint32_t x)
+{
+    uint32_t root = 0;
+    for (uint32_t bit = 1u << 30; bit; bit >>= 2) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+    }
+    return (uint16_t)root;
+}
+
+static void Publish(void)
+{
+    uint32_t seq = Sequence;
+    __atomic_store_n(&Sequence, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(Published, Levels, sizeof(Published));
+    __atomic_store_n(&Sequence, seq + 2, __ATOMIC_RELEASE);
+}
+
+static void Analyse(void)
+{
+    uint64_t sum_sq = 0;
+    for (uint32_t n = 0; n < Spectrum_FFT_Size; n++) {
+        int32_t s = Ring[(Ring_Pos + n) & (Spectrum_FFT_Size - 1)];    // Oldest sample first
+        sum_sq += (uint32_t)(s * s);
+        Re[n] = (int16_t)((s * Window[n]) >> 15);
+        Im[n] = 0;
+    }
+    Energy = Sqrt_U32((uint32_t)(sum_sq / Spectrum_FFT_Size));
+
+    FFT_Q15(Re, Im);
+
+    for (int b = 0; b < Spectrum_Band_Count; b++) {
+        uint64_t power = 0;
+        for (uint32_t k = Band_Edge[b]; k < Band_Edge[b + 1]; k++) {
+            power += (uint32_t)((int32_t)Re[k] * Re[k] + (int32_t)Im[k] * Im[k]);
+        }
+        int32_t level = (int32_t)Log2_Q4(power > UINT32_MAX ? UINT32_MAX : (uint32_t)power) - (Spectrum_Floor_Log2 << 4);
+        level = level * Spectrum_Level_MAX / (Spectrum_Range_Log2 << 4);
+        if (level < 0) level = 0;
+        if (level > Spectrum_Level_MAX) level = Spectrum_Level_MAX;
+
+        // Rise at once, fall slowly so short transients stay visible
+        int32_t fallen = (int32_t)Levels[b] - Spectrum_Decay;
+        Levels[b] = (uint8_t)((level > fallen) ? level : (fallen > 0 ? fallen : 0));
+    }
+    Publish();
+}
+
+void Audio_Spectrum_Feed(const int16_t *Stereo, size_t Frames)
+{
+    if (Rate == 0) {
+        return;
+    }
+    uint32_t start = esp_cpu_get_cycle_count();
+
+    if (Reset_Pending) {
+        Reset_Pending = false;
+        Ring_Fill = 0;
+        Samples_Since = 0;
+        memset(Levels, 0, sizeof(Levels));
+        Energy = 0;
+        Publish();
+    }
+
+    for (size_t f = 0; f < Frames; f++) {
+        Ring[Ring_Pos] = (int16_t)(((int32_t)Stereo[f * 2] + Stereo[f * 2 + 1]) >> 1);
+        Ring_Pos = (Ring_Pos + 1) & (Spectrum_FFT_Size - 1);
+    }
+    Ring_Fill = (Ring_Fill + Frames > Spectrum_FFT_Size) ? Spectrum_FFT_Size : Ring_Fill + Frames;
+    Samples_Since += Frames;
+
+    // At most one analysis per call, whatever the block size, and none faster than Spectrum_Update_Rate
+    if (Samples_Since >= Interval && Ring_Fill == Spectrum_FFT_Size) {
+        Samples_Since = 0;
+        Analyse();
+    }
+
+    Busy_Cycles += esp_cpu_get_cycle_count() - start;
+    Load_Samples += Frames;
+    if (Load_Samples >= Rate * Spectrum_Load_Period) {
+        // Cycles available to one core while the audio was played
+        uint64_t available = (uint64_t)CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000 * Load_Samples / Rate;
+        Load = (uint16_t)(Busy_Cycles * 1000 / available);
+        ESP_LOGD(TAG, "Analyser load %u.%u%% of one core at %lu Hz", Load / 10, Load % 10, Rate);
+        Busy_Cycles = 0;
+        Load_Samples = 0;
+    }
+}
+
+void Audio_Spectrum_Get_Bands(uint8_t Bands[Spectrum_Band_Count])
+{
+    uint32_t before, after;
+    do {
+        before = __atomic_load_n(&Sequence, __ATOMIC_ACQUIRE);
+        memcpy(Bands, Published, Spectrum_Band_Count);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&Sequence, __ATOMIC_RELAXED);
+    } while ((before & 1) || before != after);                  // The audio task was publishing, read again
+}
+
+uint16_t Audio_Spectrum_Get_Energy(void)
+{
+    return Energy;
+}
+
+uint16_t Audio_Spectrum_Get_Load(void)
+{
+    return Load;
+}
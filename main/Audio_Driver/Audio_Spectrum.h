@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define Spectrum_FFT_Size       512                 // 11.6 ms window at 44.1 kHz, 86 Hz per bin
+#define Spectrum_Band_Count     16                  // Log spaced, 60 Hz to 16 kHz
+#define Spectrum_Update_Rate    30                  // Analyses per second of audio, bounds the CPU cost
+#define Spectrum_Level_MAX      255
+
+void Audio_Spectrum_Init(uint32_t Sample_Rate);
+void Audio_Spectrum_Set_Rate(uint32_t Sample_Rate);
+void Audio_Spectrum_Feed(const int16_t *Stereo, size_t Frames);    // Called from the audio task with the output samples
+void Audio_Spectrum_Reset(void);
+
+void Audio_Spectrum_Get_Bands(uint8_t Bands[Spectrum_Band_Count]); // Lock free, safe from any task
+uint16_t Audio_Spectrum_Get_Energy(void);                          // RMS of the last window, 0 - 32767
+uint16_t Audio_Spectrum_Get_Load(void);                            // CPU used by the analyser, per mille of one core
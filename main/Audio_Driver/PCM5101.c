@@ -1,9 +1,14 @@
 #include "PCM5101.h"
+#include "esp_timer.h"
+#include "mp3_index.h"
 
 static const char *TAG = "AUDIO PCM5101"; 
 
 static i2s_chan_handle_t i2s_tx_chan; 
 static i2s_chan_handle_t i2s_rx_chan; 
+static volatile uint32_t i2s_rate = 44100;                  // RX shares the clock with TX, see Audio_Capture_Rate()
+static bool i2s_rx_enabled = false;
+static volatile Audio_Output_Tap output_tap = NULL;
 
 uint8_t Volume = Volume_MAX - 2;
 bool Music_Next_Flag = 0;
@@ -11,18 +16,14 @@ bool Music_Next_Flag = 0;
 //     return i2s_channel_write(i2s_tx_chan, (char *)audio_buffer, len, bytes_written, timeout_ms);
 // }
 static esp_err_t bsp_i2s_write(void *audio_buffer, size_t len, size_t *bytes_written, uint32_t timeout_ms) {
-    int16_t *samples = (int16_t *)audio_buffer;
-    size_t sample_count = len / sizeof(int16_t);
-    
-    // Calculate the volume scaling factor to convert the volume level from 0-100 to the 0.0-1.0 range
-    float volume_factor = Volume / 100.0f;
-
-
-    for (size_t i = 0; i < sample_count; i++) {
-        samples[i] = (int16_t)(samples[i] * volume_factor);
+    // Volume is applied by the player while it converts the decoded samples, see Volume_adjustment()
+    esp_err_t ret = i2s_channel_write(i2s_tx_chan, (char *)audio_buffer, len, bytes_written, timeout_ms);
+    Audio_Spectrum_Feed((const int16_t *)audio_buffer, *bytes_written / (2 * sizeof(int16_t)));    // The player always outputs stereo 16 bit
+    Audio_Output_Tap tap = output_tap;
+    if (tap) {
+        tap((const int16_t *)audio_buffer, *bytes_written / (2 * sizeof(int16_t)), i2s_rate);
     }
-
-    return i2s_channel_write(i2s_tx_chan, (char *)audio_buffer, len, bytes_written, timeout_ms);
+    return ret;
 }
 static esp_err_t bsp_i2s_reconfig_clk(uint32_t rate, uint32_t bits_cfg, i2s_slot_mode_t ch) {                                   // I2S Init
     esp_err_t ret = ESP_OK; 
@@ -35,6 +36,8 @@ static esp_err_t bsp_i2s_reconfig_clk(uint32_t rate, uint32_t bits_cfg, i2s_slot
     ret |= i2s_channel_reconfig_std_clock(i2s_tx_chan, &std_cfg.clk_cfg);
     ret |= i2s_channel_reconfig_std_slot(i2s_tx_chan, &std_cfg.slot_cfg);
     ret |= i2s_channel_enable(i2s_tx_chan); 
+    i2s_rate = rate;
+    Audio_Spectrum_Set_Rate(rate);
     return ret; 
 }
 
@@ -54,8 +57,7 @@ static esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config, i2s_chan_han
         ESP_ERROR_CHECK(i2s_channel_enable(*tx_channel)); 
     }
     if (rx_channel) {
-        ESP_ERROR_CHECK(i2s_channel_init_std_mode(*rx_channel, p_i2s_cfg)); 
-        ESP_ERROR_CHECK(i2s_channel_enable(*rx_channel));
+        ESP_ERROR_CHECK(i2s_channel_init_std_mode(*rx_channel, p_i2s_cfg));     // Enabled while capturing, see Audio_Capture_Enable()
     }
     return ESP_OK; 
 }
@@ -63,8 +65,94 @@ static esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config, i2s_chan_han
 static FILE * Music_File = NULL;
 static audio_player_callback_event_t expected_event; 
 static QueueHandle_t event_queue; 
+static SemaphoreHandle_t Music_Request_Mutex;   // One request and its wait for the event at a time, the UI and the voice reply both ask
 static audio_player_callback_event_t event; 
 
+static mp3_index_t Music_Index;                 // Index of the current track, valid when Music_Index_Valid
+static bool Music_Index_Valid = false;
+static char Music_Index_Path[Dir_Scan_Path_Max];
+static FILE *Music_Index_File;                  // Handed to the player with the index, it seeks exactly with it
+static uint32_t Music_Index_Generation = 0;     // Bumped per track so a stale index is never published
+static volatile bool Music_Index_Cancel = false;    // Stops the walk under way, a newer request or the card going
+static SemaphoreHandle_t Music_Index_Mutex;
+static SemaphoreHandle_t Music_Index_Card;      // Held while the task reads the track or writes the cache
+static TaskHandle_t Music_Index_Task_Handle;
+
+static void Music_Index_Task(void *arg) {
+    static mp3_index_t index;                   // Keep the seek table and the path off the task stack
+    static char path[sizeof(Music_Index_Path)];
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xSemaphoreTake(Music_Index_Card, portMAX_DELAY);
+        xSemaphoreTake(Music_Index_Mutex, portMAX_DELAY);
+        strcpy(path, Music_Index_Path);
+        uint32_t generation = Music_Index_Generation;
+        Music_Index_Cancel = false;
+        xSemaphoreGive(Music_Index_Mutex);
+        if (!path[0]) {
+            xSemaphoreGive(Music_Index_Card);           // Dropped, the track never started or the card went
+            continue;
+        }
+
+        int64_t start = esp_timer_get_time();
+        esp_err_t ret = mp3_index_get(path, Music_Index_Cache_Dir, &Music_Index_Cancel, &index);
+        xSemaphoreGive(Music_Index_Card);
+        if (ret == ESP_ERR_INVALID_STATE) {
+            ESP_LOGI(TAG, "Stopped indexing %s", path);      // Nothing cached, the next play walks it again
+            continue;
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to index %s: %s", path, esp_err_to_name(ret));
+            continue;
+        }
+        ESP_LOGI(TAG, "Indexed %s in %lld ms: %lu ms, %lu kbps, source %d", path,
+                 (esp_timer_get_time() - start) / 1000, index.duration_ms, index.bitrate / 1000, index.source);
+
+        xSemaphoreTake(Music_Index_Mutex, portMAX_DELAY);
+        if (generation == Music_Index_Generation) {
+            Music_Index = index;
+            Music_Index_Valid = true;
+            audio_player_set_mp3_index(Music_Index_File, &index);
+        }
+        xSemaphoreGive(Music_Index_Mutex);
+    }
+}
+
+// File NULL drops the request, for a track that never started
+static void Music_Index_Request(const char *filePath, FILE *File) {
+    if (!Music_Index_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Music_Index_Mutex, portMAX_DELAY);
+    snprintf(Music_Index_Path, sizeof(Music_Index_Path), "%s", filePath);
+    Music_Index_File = File;
+    Music_Index_Generation++;
+    Music_Index_Cancel = true;                              // The track being indexed is not wanted any more
+    Music_Index_Valid = false;
+    audio_player_set_mp3_index(NULL, NULL);                 // Not the index of the last track on a reused FILE
+    xSemaphoreGive(Music_Index_Mutex);
+    if (File) {
+        xTaskNotifyGive(Music_Index_Task_Handle);
+    }
+}
+
+// Drops the request, cancels a walk under way and waits for its last read, no seek table cache is left half written
+static bool Music_Index_Stop(uint32_t Timeout_ms) {
+    Music_Index_Request("", NULL);
+    if (xSemaphoreTake(Music_Index_Card, pdMS_TO_TICKS(Timeout_ms)) != pdTRUE) {
+        return false;
+    }
+    xSemaphoreGive(Music_Index_Card);
+    return true;
+}
+
+// On the SD monitor task
+static void Music_Index_Card_Event(Card_Event Event, void *Context) {
+    if ((Event == Card_Event_Lost || Event == Card_Event_Ejecting) && !Music_Index_Stop(Music_Index_Stop_ms)) {
+        ESP_LOGW(TAG, "Still indexing when the card went");
+    }
+}
+
 static void audio_player_callback(audio_player_cb_ctx_t *ctx) {
     if (ctx->audio_event == AUDIO_PLAYER_CALLBACK_EVENT_IDLE) {
         ESP_LOGI(TAG, "Playback finished");
@@ -75,6 +163,47 @@ static void audio_player_callback(audio_player_cb_ctx_t *ctx) {
     }
 }
 
+// The player closes the track on its way to idle, which has to happen before the unmount
+// True once the player has let go of the file
+static bool Music_Stop(uint32_t Timeout_ms) {
+    if (audio_player_get_state() == AUDIO_PLAYER_STATE_IDLE) {
+        return true;
+    }
+    audio_player_stop();
+    for (uint32_t i = 0; i < Timeout_ms / 10 && audio_player_get_state() != AUDIO_PLAYER_STATE_IDLE; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    Music_File = NULL;
+    Music_Next_Flag = 0;                                    // Not on to the next track of a card that is gone
+    return audio_player_get_state() == AUDIO_PLAYER_STATE_IDLE;
+}
+
+static void Music_Card_Event(Card_Event Event, void *Context) {
+    if ((Event != Card_Event_Lost && Event != Card_Event_Ejecting) || audio_player_get_state() == AUDIO_PLAYER_STATE_IDLE) {
+        return;
+    }
+    Music_Stop(Music_Stop_Wait_ms);
+    ESP_LOGI(TAG, "Stopped, the card is going");
+}
+
+// Once audio_player_play() took the track the player owns the FILE and closes it on its way to idle, a
+// File_IO stream closed here as well would be freed under its reads. Stopping is all that is left to do
+static void Music_Abandon(void) {
+    Music_Index_Request("", NULL);                          // No late index for a FILE that is going
+    Music_Stop(Music_Stop_Wait_ms);
+    Music_File = NULL;
+}
+
+// Quiet before the power goes and the card is free for the flushes after
+static bool Music_Shutdown(uint32_t Timeout_ms, void *Context) {
+    return Music_Stop(Timeout_ms);
+}
+
+// Nor a seek table cache half written
+static bool Music_Index_Shutdown(uint32_t Timeout_ms, void *Context) {
+    return Music_Index_Stop(Timeout_ms);
+}
+
 void Audio_Init(void) 
 {
     i2s_std_config_t std_cfg = {
@@ -83,10 +212,12 @@ void Audio_Init(void)
         .gpio_cfg = BSP_I2S_GPIO_CFG,
     };
     esp_err_t ret = bsp_audio_init(&std_cfg, &i2s_tx_chan, &i2s_rx_chan);
+    i2s_rate = 44100;
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to initialize audio: %s", esp_err_to_name(ret));
         return;
     }
+    Audio_Spectrum_Init(44100);
     audio_player_config_t config = { 
         .mute_fn = audio_mute_function,
         .write_fn = bsp_i2s_write,
@@ -99,8 +230,10 @@ void Audio_Init(void)
         ESP_LOGE(TAG, "Failed to create audio player: %s", esp_err_to_name(ret));
         return;
     }
+    Volume_adjustment(Settings_Get(Setting_Volume));
     event_queue = xQueueCreate(1, sizeof(audio_player_callback_event_t));
-    if (!event_queue) {
+    Music_Request_Mutex = xSemaphoreCreateMutex();
+    if (!event_queue || !Music_Request_Mutex) {
         ESP_LOGE(TAG, "Failed to create event queue");
         return;
     }
@@ -113,91 +246,241 @@ void Audio_Init(void)
         ESP_LOGE(TAG, "Expected state to be IDLE");                 // The player is not idle
         return;
     }
+    // Track indexing reads the whole file when there is no VBR header, keep it below the player
+    Music_Index_Mutex = xSemaphoreCreateMutex();
+    Music_Index_Card = xSemaphoreCreateMutex();
+    if (!Music_Index_Mutex || !Music_Index_Card ||
+        xTaskCreatePinnedToCore(Music_Index_Task, "Music Index", 4096, NULL, 2, &Music_Index_Task_Handle, 1) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create music index task");
+        return;
+    }
+    SD_Subscribe(Music_Card_Event, NULL);
+    SD_Subscribe(Music_Index_Card_Event, NULL);
+    Shutdown_Register("music", Shutdown_Phase_Quiesce, Music_Stop_Wait_ms, Music_Shutdown, NULL);
+    Shutdown_Register("mp3 index", Shutdown_Phase_Quiesce, Music_Index_Stop_ms, Music_Index_Shutdown, NULL);
 }
-void Play_Music(const char* directory, const char* fileName)
+static void Music_Pause_Locked(void);
+
+static void Music_Play_Locked(const char* directory, const char* fileName)
 {  
-    Music_pause();
-    const int maxPathLength = 100; 
-    char filePath[maxPathLength];
+    Music_Pause_Locked();
+    if (!SD_Mode.Width) {
+        ESP_LOGW(TAG, "No card to play %s from", fileName);
+        return;
+    }
+    static char filePath[Dir_Scan_Path_Max];                        // Under Music_Request_Mutex, keep it off the stack
+    int length;
     if (strcmp(directory, "/") == 0) {                                               
-        snprintf(filePath, maxPathLength, "%s%s", directory, fileName);   
+        length = snprintf(filePath, sizeof(filePath), "%s%s", directory, fileName);   
     } else {                                                            
-        snprintf(filePath, maxPathLength, "%s/%s", directory, fileName);
+        length = snprintf(filePath, sizeof(filePath), "%s/%s", directory, fileName);
+    }
+    if (length < 0 || length >= (int)sizeof(filePath)) {
+        ESP_LOGE(TAG, "Path too long to play: %s/%s", directory, fileName);
+        return;
     }
     Music_File = Open_File(filePath);
     if (!Music_File) {
         ESP_LOGE(TAG, "Failed to open MP3 file: %s", filePath);
         return;
     }
+    Music_Index_Request(filePath, Music_File);
+    Audio_Spectrum_Reset();
 
     expected_event = AUDIO_PLAYER_CALLBACK_EVENT_PLAYING;
+    xQueueReset(event_queue);                                   // Not the late event of a wait that timed out
     esp_err_t ret = audio_player_play(Music_File);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to play audio: %s", esp_err_to_name(ret));
-        fclose(Music_File);
+        Music_Index_Request("", NULL);
+        fclose(Music_File);                                         // Refused, so still ours
+        Music_File = NULL;
         return;
     }
     if (xQueueReceive(event_queue, &event, pdMS_TO_TICKS(100)) != pdPASS) {
         ESP_LOGE(TAG, "Failed to receive playing event");
-        fclose(Music_File);
+        Music_Abandon();
         return;
     }
     if (audio_player_get_state() != AUDIO_PLAYER_STATE_PLAYING) {
         ESP_LOGE(TAG, "Expected state to be PLAYING");
-        fclose(Music_File);
+        Music_Abandon();
         return;
     }
 }
-void Music_resume(void)
+static void Music_Resume_Locked(void)
 {
     if (audio_player_get_state() != AUDIO_PLAYER_STATE_PLAYING){
         expected_event = AUDIO_PLAYER_CALLBACK_EVENT_PLAYING;
+        xQueueReset(event_queue);                                   // Not the late event of a wait that timed out
         esp_err_t ret = audio_player_resume();
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to resume audio: %s", esp_err_to_name(ret));
-            fclose(Music_File);
+            Music_Abandon();
             return;
         }
         if (xQueueReceive(event_queue, &event, pdMS_TO_TICKS(100)) != pdPASS) {
             ESP_LOGE(TAG, "Failed to receive playing event after resume");
-            fclose(Music_File);
+            Music_Abandon();
             return;
         }
         if (audio_player_get_state() != AUDIO_PLAYER_STATE_PLAYING) {
             ESP_LOGE(TAG, "Expected state to be RESUME");
-            fclose(Music_File);
+            Music_Abandon();
             return;
         }
     }
 }
-void Music_pause(void) 
+static void Music_Pause_Locked(void)
 {
     if (audio_player_get_state() == AUDIO_PLAYER_STATE_PLAYING){
         expected_event = AUDIO_PLAYER_CALLBACK_EVENT_PAUSE;
+        xQueueReset(event_queue);                                   // Not the late event of a wait that timed out
         esp_err_t ret = audio_player_pause();
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to pause audio: %s", esp_err_to_name(ret));
-            fclose(Music_File);
+            Music_Abandon();
             return;
         }
         if (xQueueReceive(event_queue, &event, pdMS_TO_TICKS(100)) != pdPASS) {
             ESP_LOGE(TAG, "Failed to receive pause event");
-            fclose(Music_File);
+            Music_Abandon();
             return;
         }
         if (audio_player_get_state() != AUDIO_PLAYER_STATE_PAUSE) {
             ESP_LOGE(TAG, "Expected state to be PAUSE");
-            fclose(Music_File);
+            Music_Abandon();
             return;
         }
     }
 }
 
+// The UI and the voice reply both pause and resume, each request waits for the one before it to see its event
+void Play_Music(const char* directory, const char* fileName)
+{
+    if (!Music_Request_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Music_Request_Mutex, portMAX_DELAY);
+    Music_Play_Locked(directory, fileName);
+    xSemaphoreGive(Music_Request_Mutex);
+}
+void Music_resume(void)
+{
+    if (!Music_Request_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Music_Request_Mutex, portMAX_DELAY);
+    Music_Resume_Locked();
+    xSemaphoreGive(Music_Request_Mutex);
+}
+void Music_pause(void)
+{
+    if (!Music_Request_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Music_Request_Mutex, portMAX_DELAY);
+    Music_Pause_Locked();
+    xSemaphoreGive(Music_Request_Mutex);
+}
 
 void Volume_adjustment(uint8_t Vol) {
     if(Vol > Volume_MAX )
         printf("Audio : The volume value is incorrect. Please enter 0 to 21\r\n");
     else  
         Volume = Vol;
+    Settings_Set(Setting_Volume, Volume);                          // RAM only, saved once the slider stops
+    // 0-100 -> Q15 gain, Volume_MAX is unity
+    audio_player_set_gain((uint16_t)((uint32_t)Volume * AUDIO_CONVERT_GAIN_UNITY / Volume_MAX));
     ESP_LOGI(TAG, "Volume set to %d", Volume);
 }
+
+uint32_t Music_Duration(void)
+{
+    uint32_t duration_ms = 0;
+    if (!Music_Index_Mutex) {
+        return 0;
+    }
+    xSemaphoreTake(Music_Index_Mutex, portMAX_DELAY);
+    if (Music_Index_Valid) {
+        duration_ms = Music_Index.duration_ms;
+    }
+    xSemaphoreGive(Music_Index_Mutex);
+    return (duration_ms + 500) / 1000;                              // Seconds, 0 until the track has been indexed
+}
+
+uint32_t Music_Elapsed(void)
+{
+    uint32_t samples, sample_rate;
+    if (audio_player_get_position(&samples, &sample_rate) != ESP_OK) {
+        return 0;
+    }
+    return samples / sample_rate;                                   // Seconds
+}
+
+uint16_t Music_Energy(void)
+{
+    if (audio_player_get_state() != AUDIO_PLAYER_STATE_PLAYING) {
+        return 0;
+    }
+    return Audio_Spectrum_Get_Energy();
+}
+
+void Music_Spectrum(uint8_t Bands[Spectrum_Band_Count])
+{
+    if (audio_player_get_state() != AUDIO_PLAYER_STATE_PLAYING) {
+        memset(Bands, 0, Spectrum_Band_Count);                      // Paused or stopped, let the bars drop
+        return;
+    }
+    Audio_Spectrum_Get_Bands(Bands);
+}
+
+void Music_Seek(uint32_t Second)
+{
+    esp_err_t ret = audio_player_seek(Second * 1000);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to seek to %lus: %s", Second, esp_err_to_name(ret));
+    }
+}
+
+esp_err_t Audio_Capture_Enable(bool Enable)
+{
+    if (!i2s_rx_chan || Enable == i2s_rx_enabled) {
+        return i2s_rx_chan ? ESP_OK : ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t ret = Enable ? i2s_channel_enable(i2s_rx_chan) : i2s_channel_disable(i2s_rx_chan);
+    if (ret == ESP_OK) {
+        i2s_rx_enabled = Enable;
+    }
+    return ret;
+}
+
+esp_err_t Audio_Capture_Read(int16_t *Buffer, size_t Bytes, size_t *Bytes_Read, uint32_t Timeout_ms)
+{
+    return i2s_channel_read(i2s_rx_chan, Buffer, Bytes, Bytes_Read, Timeout_ms);
+}
+
+uint32_t Audio_Capture_Rate(void)
+{
+    return i2s_rate;
+}
+
+esp_err_t Audio_Stream_Write(const int16_t *Buffer, size_t Bytes, size_t *Bytes_Written, uint32_t Timeout_ms)
+{
+    esp_err_t ret = i2s_channel_write(i2s_tx_chan, Buffer, Bytes, Bytes_Written, Timeout_ms);
+    Audio_Output_Tap tap = output_tap;
+    if (tap) {
+        tap(Buffer, *Bytes_Written / (2 * sizeof(int16_t)), i2s_rate);
+    }
+    return ret;
+}
+
+uint32_t Audio_Stream_Rate(void)
+{
+    return i2s_rate;
+}
+
+void Audio_Set_Output_Tap(Audio_Output_Tap Tap)
+{
+    output_tap = Tap;
+}
@@ -8,6 +8,9 @@
 #include "freertos/semphr.h" 
 
 #include "SD_MMC.h"
+#include "Settings.h"
+#include "Shutdown.h"
+#include "Audio_Spectrum.h"
 
 #define CONFIG_BSP_I2S_NUM 1 
 
@@ -40,14 +43,35 @@
     }
 
 #define Volume_MAX  100
+#define Music_Index_Cache_Dir   "/sdcard/.cache"              // Per track seek tables, see mp3_index_get()
+#define Music_Stop_Wait_ms      400                           // For the player to let go of a card that is going
+#define Music_Index_Stop_ms     150                           // For the track index task, a walk stops at its next read
 extern bool Music_Next_Flag;
 extern uint8_t Volume;
 void Audio_Init(void);
+// From any task, the requests take turns waiting for the player to confirm them
 void Play_Music(const char* directory, const char* fileName);
 void Music_resume(void);
 void Music_pause(void);
 
 uint32_t Music_Duration(void);
 uint32_t Music_Elapsed(void);
+void Music_Seek(uint32_t Second);
 uint16_t Music_Energy(void);
-void Volume_adjustment(uint8_t Volume);
\ No newline at end of file
+void Music_Spectrum(uint8_t Bands[Spectrum_Band_Count]);
+void Volume_adjustment(uint8_t Volume);
+
+// Microphone side of the duplex port, stereo 16 bit at the rate the player set (Audio_Capture_Rate())
+#define Audio_Capture_Channels  2
+esp_err_t Audio_Capture_Enable(bool Enable);
+esp_err_t Audio_Capture_Read(int16_t *Buffer, size_t Bytes, size_t *Bytes_Read, uint32_t Timeout_ms);
+uint32_t Audio_Capture_Rate(void);
+
+// Speaker side for audio pushed from the network, stereo 16 bit at Audio_Stream_Rate(). Pause the player first.
+esp_err_t Audio_Stream_Write(const int16_t *Buffer, size_t Bytes, size_t *Bytes_Written, uint32_t Timeout_ms);
+uint32_t Audio_Stream_Rate(void);
+
+// Everything written to the speaker, player and stream alike, is handed to the tap from the writing task as
+// stereo 16 bit frames at Rate. The echo canceller takes its reference from here. NULL removes it.
+typedef void (*Audio_Output_Tap)(const int16_t *Samples, size_t Frames, uint32_t Rate);
+void Audio_Set_Output_Tap(Audio_Output_Tap Tap);
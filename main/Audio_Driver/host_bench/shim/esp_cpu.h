@@ -0,0 +1,15 @@
+#pragma once
+
+// Host stand-in, the cycles of a CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ core as long as the host took
+
+#include <stdint.h>
+#include <time.h>
+#include "sdkconfig.h"
+
+static inline uint32_t esp_cpu_get_cycle_count(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    return (uint32_t)(ns * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ / 1000);
+}
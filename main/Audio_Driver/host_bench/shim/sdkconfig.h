@@ -0,0 +1,5 @@
+#pragma once
+
+// Host stand-in, the clock the firmware runs at
+
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 240
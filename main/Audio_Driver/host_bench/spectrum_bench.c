@@ -0,0 +1,216 @@
+/**
+ * Host bench for Audio_Spectrum, the analyser the music page draws its bars from.
+ *
+ * The checks feed sines from 100 Hz to 12 kHz and expect the loudest band to be the one the
+ * frequency falls in, give or take the band next to it where a bin straddles the edge, with the
+ * bands a few apart from it well below. Silence has to leave every band empty, and a full scale
+ * sine an energy near 23170, its RMS.
+ *
+ * Then -s seconds of noise are fed in -b frame blocks, the size of one decoded mp3 frame by
+ * default, and timed. The shim's esp_cpu_get_cycle_count() turns host time into cycles of a
+ * 240 MHz core, so the load Audio_Spectrum_Get_Load() reports is what the firmware would show if
+ * the ESP32-S3 were as fast as this host. It is not, the numbers are for catching regressions and
+ * for scale, the figure for the device is Audio_Spectrum_Get_Load() there, or the debug log.
+ *
+ * usage: spectrum_bench [-r rate] [-b frames] [-s seconds]
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Audio_Spectrum.h"
+#include "sdkconfig.h"
+
+#define USAGE "usage: %s [-r rate] [-b frames] [-s seconds]\n"
+
+#define Low_Hz                  60          // As Spectrum_Low_Hz and Spectrum_High_Hz in Audio_Spectrum.c
+#define High_Hz                 16000
+#define Settle_Seconds          0.2
+#define Neighbour_Margin        40          // Levels a band two away from the tone stays below the peak
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            failures++; \
+        } \
+    } while (0)
+
+void host_bench_log(char level, const char *tag, const char *fmt, ...)
+{
+    if (level == 'E' || level == 'W') {
+        va_list args;
+        va_start(args, fmt);
+        printf("%c %s: ", level, tag);
+        vprintf(fmt, args);
+        printf("\n");
+        va_end(args);
+    }
+}
+
+static uint64_t Now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void Feed_Sine(uint32_t rate, double hz, double amplitude, double seconds, size_t block)
+{
+    int16_t *buf = malloc(block * 2 * sizeof(int16_t));
+    size_t total = (size_t)(seconds * rate);
+    for (size_t pos = 0; pos < total; pos += block) {
+        size_t frames = (total - pos < block) ? total - pos : block;
+        for (size_t f = 0; f < frames; f++) {
+            int16_t s = (int16_t)lrint(amplitude * sin(2 * M_PI * hz * (pos + f) / rate));
+            buf[f * 2] = s;
+            buf[f * 2 + 1] = s;
+        }
+        Audio_Spectrum_Feed(buf, frames);
+    }
+    free(buf);
+}
+
+// The band holding the tone's bin, with the edges worked out as Build_Bands() does
+static int Expected_Band(uint32_t rate, double hz)
+{
+    uint32_t edge[Spectrum_Band_Count + 1];
+    float high = (rate / 2 < High_Hz) ? rate / 2 : High_Hz;
+    float ratio = powf(high / Low_Hz, 1.0f / Spectrum_Band_Count);
+    float freq = Low_Hz;
+    for (int b = 0; b <= Spectrum_Band_Count; b++) {
+        uint32_t bin = (uint32_t)(freq * Spectrum_FFT_Size / rate + 0.5f);
+        if (bin < 1) bin = 1;
+        if (b > 0 && bin <= edge[b - 1]) bin = edge[b - 1] + 1;
+        if (bin > Spectrum_FFT_Size / 2) bin = Spectrum_FFT_Size / 2;
+        edge[b] = bin;
+        freq *= ratio;
+    }
+
+    uint32_t bin = (uint32_t)lrint(hz * Spectrum_FFT_Size / rate);
+    int band = 0;
+    while (band < Spectrum_Band_Count - 1 && bin >= edge[band + 1]) {
+        band++;
+    }
+    return band;
+}
+
+static void Check_Bands(uint32_t rate, size_t block)
+{
+    static const double tones[] = { 100, 250, 500, 1000, 2000, 4000, 8000, 12000 };
+    uint8_t bands[Spectrum_Band_Count];
+
+    Audio_Spectrum_Reset();
+    Feed_Sine(rate, 1000, 0, Settle_Seconds, block);
+    Audio_Spectrum_Get_Bands(bands);
+    for (int b = 0; b < Spectrum_Band_Count; b++) {
+        CHECK(bands[b] == 0, "silence left band %d at %u", b, bands[b]);
+    }
+    CHECK(Audio_Spectrum_Get_Energy() == 0, "silence has energy %u", Audio_Spectrum_Get_Energy());
+
+    printf("%8s %5s %5s %5s  bands\n", "tone Hz", "want", "peak", "level");
+    for (size_t t = 0; t < sizeof(tones) / sizeof(tones[0]); t++) {
+        if (tones[t] >= rate / 2) {
+            continue;
+        }
+        Audio_Spectrum_Reset();
+        Feed_Sine(rate, tones[t], 16384, Settle_Seconds, block);
+        Audio_Spectrum_Get_Bands(bands);
+
+        int want = Expected_Band(rate, tones[t]);
+        int peak = 0;
+        for (int b = 1; b < Spectrum_Band_Count; b++) {
+            if (bands[b] > bands[peak]) {
+                peak = b;
+            }
+        }
+        printf("%8.0f %5d %5d %5u  ", tones[t], want, peak, bands[peak]);
+        for (int b = 0; b < Spectrum_Band_Count; b++) {
+            printf("%4u", bands[b]);
+        }
+        printf("\n");
+
+        CHECK(abs(peak - want) <= 1, "%.0f Hz peaks in band %d, not %d", tones[t], peak, want);
+        CHECK(bands[peak] > 0, "%.0f Hz shows nothing", tones[t]);
+        for (int b = 0; b < Spectrum_Band_Count; b++) {
+            if (abs(b - peak) > 2) {
+                CHECK(bands[b] + Neighbour_Margin <= bands[peak], "%.0f Hz leaks into band %d, %u against %u",
+                      tones[t], b, bands[b], bands[peak]);
+            }
+        }
+    }
+
+    Audio_Spectrum_Reset();
+    Feed_Sine(rate, 1000, 32767, Settle_Seconds, block);
+    uint16_t energy = Audio_Spectrum_Get_Energy();
+    CHECK(abs((int)energy - 23170) < 300, "a full scale sine has energy %u", energy);
+}
+
+static void Time_Feed(uint32_t rate, size_t block, double seconds)
+{
+    size_t total = (size_t)(seconds * rate);
+    int16_t *noise = malloc(total * 2 * sizeof(int16_t));
+    srand(1);
+    for (size_t n = 0; n < total * 2; n++) {
+        noise[n] = (int16_t)(rand() % 16384 - 8192);
+    }
+
+    Audio_Spectrum_Reset();
+    uint64_t start = Now_ns();
+    for (size_t pos = 0; pos < total; pos += block) {
+        size_t frames = (total - pos < block) ? total - pos : block;
+        Audio_Spectrum_Feed(noise + pos * 2, frames);
+    }
+    uint64_t elapsed = Now_ns() - start;
+    free(noise);
+
+    double analyses = seconds * Spectrum_Update_Rate;
+    double per_analysis_us = elapsed / 1000.0 / analyses;
+    double load = elapsed / (seconds * 1e9) * 100.0;
+    uint16_t reported = Audio_Spectrum_Get_Load();
+    printf("\n%.0f s of audio at %u Hz in %zu frame blocks: %.1f ms, %.0f analyses\n",
+           seconds, rate, block, elapsed / 1e6, analyses);
+    printf("  %.2f us per analysis, %.0f cycles of a %d MHz core at host speed\n",
+           per_analysis_us, per_analysis_us * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+    printf("  load %.3f%% of one core, Audio_Spectrum_Get_Load() %u.%u%%\n", load, reported / 10, reported % 10);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rate = 44100;
+    size_t block = 1152;
+    double seconds = 20;
+
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "-r") == 0 && a + 1 < argc) {
+            rate = strtoul(argv[++a], NULL, 0);
+        } else if (strcmp(argv[a], "-b") == 0 && a + 1 < argc) {
+            block = strtoul(argv[++a], NULL, 0);
+        } else if (strcmp(argv[a], "-s") == 0 && a + 1 < argc) {
+            seconds = atof(argv[++a]);
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (rate < 8000 || block == 0 || seconds <= 0) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+
+    Audio_Spectrum_Init(rate);
+    Check_Bands(rate, block);
+    Time_Feed(rate, block, seconds);
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,424 @@
+#include "Data_Logger.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "BAT_Driver.h"
+#include "PCF85063.h"
+#include "QMI8658.h"
+#include "File_IO.h"
+#include "SD_MMC.h"
+#include "Shutdown.h"
+
+static const char *TAG = "DATA LOGGER";
+
+// Two blocks: callers fill one while the task writes the other
+static uint8_t *Buffers[2];
+static Log_Block Active;
+static uint8_t *Pending = NULL;                             // Finished, owned by the task until written
+static uint32_t Pending_Bytes;
+static uint32_t Sequence = 0;
+static uint32_t Dropped_Since = 0;                          // Not reported in a Log_Event_Dropped yet
+static bool Flush_Requested = false;
+static bool Card_Mounted = false;                           // The task may write, cleared before the card goes
+static bool Card_Changed = false;                           // A card was mounted, look at it before writing
+static Data_Logger_Stats Stats = { 0 };
+static SemaphoreHandle_t Logger_Mutex = NULL;
+static SemaphoreHandle_t Flushed;
+static SemaphoreHandle_t Closed;                            // The task holds no file after Card_Mounted was cleared
+static TaskHandle_t Logger_Task_Handle;
+static volatile bool Logger_Running = false;                // Callers do nothing until the task is there
+
+// Logger task only, or the I/O task while the logger task waits for it
+static int File = -1;
+static uint32_t File_Bytes;
+static uint32_t File_Number = 0;                            // LOG<number>.BIN, the one open
+static uint32_t Oldest_Number = 1;
+
+static const char *Reset_Reasons[] = {
+    "unknown", "power on", "external", "software", "panic", "interrupt watchdog", "task watchdog", "watchdog",
+    "deep sleep", "brownout", "sdio", "usb", "jtag", "efuse", "power glitch", "cpu lockup",
+};
+
+static uint32_t Now_ms(void)
+{
+    return esp_timer_get_time() / 1000;
+}
+
+// Seconds since 1970 from the RTC, as Driver_Loop last read it
+static uint32_t Unix_Time(void)
+{
+    datetime_t now = datetime;
+    if (now.month == 0) {
+        PCF85063_Read_Time(&now);                           // Driver_Loop has not read it yet
+    }
+    if (now.month < 1 || now.month > 12 || now.year < 1970) {
+        return 0;
+    }
+    // Days since 1970-01-01 of a proleptic Gregorian date, years counted from March
+    uint32_t year = now.year - (now.month <= 2);
+    uint32_t month = now.month > 2 ? now.month - 3 : now.month + 9;
+    uint32_t days = year * 365 + year / 4 - year / 100 + year / 400 + (153 * month + 2) / 5 + now.day - 1 - 719468;
+    return days * 86400 + now.hour * 3600 + now.minute * 60 + now.second;
+}
+
+static int16_t To_Int16(float Value)
+{
+    return Value > INT16_MAX ? INT16_MAX : (Value < INT16_MIN ? INT16_MIN : (int16_t)Value);
+}
+
+// Logger_Mutex held. Hands the active block to the task, false while it still writes the last one
+static bool Finish(void)
+{
+    if (Pending) {
+        return false;
+    }
+    Pending_Bytes = Log_Block_Finish(&Active, Sequence++);
+    Pending = Active.Data;
+    Active.Data = (Active.Data == Buffers[0]) ? Buffers[1] : Buffers[0];
+    Active.Count = 0;
+    xTaskNotifyGive(Logger_Task_Handle);
+    return true;
+}
+
+// Logger_Mutex held
+static bool Add_Locked(uint8_t Type, uint32_t Time_ms, const void *Payload, uint8_t Length)
+{
+    if (Log_Block_Empty(&Active)) {
+        Log_Block_Begin(&Active, Unix_Time(), Time_ms);
+        if (Dropped_Since) {
+            char text[12];
+            int length = snprintf(text, sizeof(text), "%lu", Dropped_Since);
+            uint8_t payload[1 + sizeof(text)] = { Log_Event_Dropped };
+            memcpy(payload + 1, text, length);
+            Log_Block_Add(&Active, Log_Record_Event, Time_ms, payload, 1 + length);
+            Dropped_Since = 0;
+        }
+    }
+    if (Log_Block_Add(&Active, Type, Time_ms, Payload, Length)) {
+        return true;
+    }
+    if (!Finish()) {
+        return false;
+    }
+    Log_Block_Begin(&Active, Unix_Time(), Time_ms);
+    return Log_Block_Add(&Active, Type, Time_ms, Payload, Length);
+}
+
+static void Add(uint8_t Type, const void *Payload, uint8_t Length)
+{
+    int64_t start = esp_timer_get_time();
+    xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+    if (Add_Locked(Type, start / 1000, Payload, Length)) {
+        Stats.Records++;
+    } else {
+        Stats.Dropped++;
+        Dropped_Since++;
+    }
+    Stats.Add_us += esp_timer_get_time() - start;
+    xSemaphoreGive(Logger_Mutex);
+}
+
+// Oldest first, until no more than Data_Logger_Files_Keep are left
+static void Trim(void)
+{
+    char path[40];
+    while (File_Number - Oldest_Number + 1 > Data_Logger_Files_Keep) {
+        snprintf(path, sizeof(path), Data_Logger_Dir "/LOG%05lu.BIN", Oldest_Number);
+        if (unlink(path) != 0 && errno != ENOENT) {
+            ESP_LOGW(TAG, "Can't delete %s, errno %d", path, errno);
+        }
+        Oldest_Number++;
+    }
+}
+
+// On the I/O task, the logger task waits for it
+static int32_t Open_Next_Call(void *Context)
+{
+    char path[40];
+    File_Number++;
+    snprintf(path, sizeof(path), Data_Logger_Dir "/LOG%05lu.BIN", File_Number);
+    File = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (File < 0) {
+        ESP_LOGW(TAG, "Can't create %s, errno %d", path, errno);
+        return -EIO;
+    }
+    Log_File_Header header;
+    Log_File_Header_Init(&header, Unix_Time(), Now_ms());
+    if (write(File, &header, sizeof(header)) != sizeof(header)) {
+        ESP_LOGW(TAG, "Can't write %s, errno %d", path, errno);
+        close(File);
+        File = -1;
+        return -EIO;
+    }
+    File_Bytes = sizeof(header);
+    Trim();
+    ESP_LOGI(TAG, "Logging to %s", path);
+    return 0;
+}
+
+// A block is one write() and one fsync(), so the card sees a few sectors every Data_Logger_Flush_ms. They run on
+// the I/O task behind any audio and UI reads, the other buffer takes records meanwhile
+static void Write_Block(const uint8_t *Block, uint32_t Bytes)
+{
+    int64_t start = esp_timer_get_time();
+    bool opened = false;
+    if (File >= 0 && File_Bytes + Bytes > Data_Logger_File_Max_Bytes) {
+        close(File);
+        File = -1;
+    }
+    if (File < 0) {
+        opened = File_IO_Call_Wait(Io_Class_Log, Open_Next_Call, NULL) == 0;
+    }
+    int32_t result = File >= 0 ? File_IO_Write_Wait(Io_Class_Log, File, Block, Bytes, true) : -EBADF;
+    bool written = result == (int32_t)Bytes;
+    if (written) {
+        File_Bytes += Bytes;
+    } else if (File >= 0) {
+        // Readers skip whatever part of the block made it, the next one starts a new file
+        ESP_LOGW(TAG, "Write failed: %ld", result);
+        close(File);
+        File = -1;
+    }
+    if (!written) {
+        SD_Check();                                         // The card may have been pulled
+    }
+
+    xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+    Stats.Files += opened;
+    if (written) {
+        Stats.Blocks++;
+        Stats.Bytes += Bytes;
+    } else {
+        Stats.Write_Errors++;
+    }
+    Stats.Write_us += esp_timer_get_time() - start;
+    Data_Logger_Stats stats = Stats;
+    xSemaphoreGive(Logger_Mutex);
+    if (opened) {
+        ESP_LOGI(TAG, "%lu records, %lu dropped, %lu KB in %lu blocks, %lu errors, %llu ms adding, %llu ms writing",
+                 stats.Records, stats.Dropped, stats.Bytes / 1024, stats.Blocks, stats.Write_Errors,
+                 stats.Add_us / 1000, stats.Write_us / 1000);
+    }
+}
+
+// Continues the numbering after the newest file on the card
+static void Find_Files(void)
+{
+    File_Number = 0;
+    DIR *dir = opendir(Data_Logger_Dir);
+    if (!dir) {
+        return;
+    }
+    uint32_t oldest = UINT32_MAX;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        char *end;
+        if (strncasecmp(entry->d_name, "LOG", 3) != 0) {
+            continue;
+        }
+        uint32_t number = strtoul(entry->d_name + 3, &end, 10);
+        if (end == entry->d_name + 3 || strcasecmp(end, ".BIN") != 0 || number == 0) {
+            continue;
+        }
+        if (number > File_Number) {
+            File_Number = number;
+        }
+        if (number < oldest) {
+            oldest = number;
+        }
+    }
+    closedir(dir);
+    Oldest_Number = (oldest == UINT32_MAX) ? File_Number + 1 : oldest;
+}
+
+// A card was mounted, maybe not the one before. On the I/O task
+static int32_t Open_Card_Call(void *Context)
+{
+    if (File >= 0) {
+        close(File);
+        File = -1;
+    }
+    if (mkdir(Data_Logger_Dir, 0775) != 0 && errno != EEXIST) {
+        ESP_LOGW(TAG, "Can't create %s, errno %d", Data_Logger_Dir, errno);
+    }
+    Find_Files();
+    return 0;
+}
+
+static void Data_Logger_Task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+        xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+        bool mounted = Card_Mounted;
+        bool changed = Card_Changed;
+        Card_Changed = false;
+        xSemaphoreGive(Logger_Mutex);
+        if (!mounted) {
+            // Records wait in the buffers meanwhile, once both are full they are counted as dropped
+            if (File >= 0) {
+                close(File);
+                File = -1;
+            }
+            xSemaphoreGive(Closed);
+            continue;
+        }
+        if (changed) {
+            File_IO_Call_Wait(Io_Class_Log, Open_Card_Call, NULL);
+        }
+        bool flush = false;
+        while (1) {
+            xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+            flush = flush || Flush_Requested;
+            Flush_Requested = false;
+            if (!Pending && !Log_Block_Empty(&Active) && (flush || Now_ms() - Active.Base_Ms >= Data_Logger_Flush_ms)) {
+                Finish();
+            }
+            uint8_t *block = Pending;
+            uint32_t bytes = Pending_Bytes;
+            xSemaphoreGive(Logger_Mutex);
+            if (!block) {
+                break;
+            }
+            Write_Block(block, bytes);
+            xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+            Pending = NULL;
+            xSemaphoreGive(Logger_Mutex);
+        }
+        if (flush) {
+            xSemaphoreGive(Flushed);
+        }
+    }
+}
+
+// On the SD monitor task. The file is closed before Lost or Ejecting returns, the unmount comes after
+static void Logger_Card_Event(Card_Event Event, void *Context)
+{
+    if (Event == Card_Event_Mounted) {
+        xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+        Card_Mounted = true;
+        Card_Changed = true;
+        xSemaphoreGive(Logger_Mutex);
+        Data_Logger_Event(Log_Event_Card, "mounted");
+        return;
+    }
+    if (Event != Card_Event_Lost && Event != Card_Event_Ejecting) {
+        return;
+    }
+    if (Event == Card_Event_Ejecting) {
+        Data_Logger_Event(Log_Event_Card, "ejected");
+        Data_Logger_Flush(Data_Logger_Eject_ms);
+    }
+    xSemaphoreTake(Closed, 0);
+    xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+    Card_Mounted = false;
+    xSemaphoreGive(Logger_Mutex);
+    xTaskNotifyGive(Logger_Task_Handle);
+    if (xSemaphoreTake(Closed, pdMS_TO_TICKS(Data_Logger_Eject_ms)) != pdTRUE) {
+        ESP_LOGW(TAG, "Still writing when the card went");
+    }
+}
+
+// What is buffered goes to the card before the power, the unmount after it finds nothing left to write
+static bool Logger_Shutdown(uint32_t Timeout_ms, void *Context)
+{
+    if (SD_State() != Card_State_Mounted) {
+        return true;                                        // No card, nothing buffered has anywhere to go
+    }
+    Data_Logger_Event(Log_Event_Shutdown, Context);
+    return Data_Logger_Flush(Timeout_ms);
+}
+
+void Data_Logger_Init(void)
+{
+    Buffers[0] = malloc(Log_Block_Max);
+    Buffers[1] = malloc(Log_Block_Max);
+    Flushed = xSemaphoreCreateBinary();
+    Closed = xSemaphoreCreateBinary();
+    Logger_Mutex = xSemaphoreCreateMutex();
+    if (!Buffers[0] || !Buffers[1] || !Flushed || !Closed || !Logger_Mutex) {
+        ESP_LOGE(TAG, "Out of memory");
+        return;
+    }
+    Active.Data = Buffers[0];
+    Active.Count = 0;
+    Card_Mounted = Card_Changed = SD_Mode.Width != 0;       // Otherwise the first Mounted sets them
+    if (!Card_Mounted) {
+        ESP_LOGW(TAG, "No card, logging once one is in");
+    }
+    if (xTaskCreatePinnedToCore(Data_Logger_Task, "Data Logger", 4096, NULL, 1, &Logger_Task_Handle, 0) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create data logger task");
+        return;
+    }
+    Logger_Running = true;
+    SD_Subscribe(Logger_Card_Event, NULL);
+    Shutdown_Register("logger", Shutdown_Phase_Flush, Data_Logger_Shutdown_ms, Logger_Shutdown, "power key");
+
+    esp_reset_reason_t reason = esp_reset_reason();
+    Data_Logger_Event(Log_Event_Boot, reason < sizeof(Reset_Reasons) / sizeof(Reset_Reasons[0]) ? Reset_Reasons[reason] : "unknown");
+}
+
+void Data_Logger_Sample(void)
+{
+    static uint32_t samples = 0;
+    if (!Logger_Running) {
+        return;
+    }
+    int16_t imu[6] = {
+        To_Int16(Accel.x * 1000), To_Int16(Accel.y * 1000), To_Int16(Accel.z * 1000),
+        To_Int16(Gyro.x * 10), To_Int16(Gyro.y * 10), To_Int16(Gyro.z * 10),
+    };
+    Add(Log_Record_Imu, imu, sizeof(imu));
+    if (samples++ % Data_Logger_Battery_Every == 0) {
+        uint16_t millivolts = BAT_analogVolts * 1000;
+        Add(Log_Record_Battery, &millivolts, sizeof(millivolts));
+    }
+}
+
+void Data_Logger_Event(Log_Event_Code Code, const char *Text)
+{
+    if (!Logger_Running) {
+        return;
+    }
+    uint8_t payload[UINT8_MAX];
+    size_t length = strnlen(Text, sizeof(payload) - 1);
+    payload[0] = Code;
+    memcpy(payload + 1, Text, length);
+    Add(Log_Record_Event, payload, 1 + length);
+}
+
+bool Data_Logger_Flush(uint32_t Timeout_ms)
+{
+    if (!Logger_Running) {
+        return false;
+    }
+    xSemaphoreTake(Flushed, 0);                             // Left over from an earlier flush
+    xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+    Flush_Requested = true;
+    xSemaphoreGive(Logger_Mutex);
+    xTaskNotifyGive(Logger_Task_Handle);
+    return xSemaphoreTake(Flushed, pdMS_TO_TICKS(Timeout_ms)) == pdTRUE;
+}
+
+void Data_Logger_Get_Stats(Data_Logger_Stats *Stats_Out)
+{
+    memset(Stats_Out, 0, sizeof(*Stats_Out));
+    if (!Logger_Running) {
+        return;
+    }
+    xSemaphoreTake(Logger_Mutex, portMAX_DELAY);
+    *Stats_Out = Stats;
+    xSemaphoreGive(Logger_Mutex);
+}
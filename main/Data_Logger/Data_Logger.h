@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Log_Format.h"
+
+#define Data_Logger_Dir             "/sdcard/logs"
+#define Data_Logger_File_Max_Bytes  (1024 * 1024)           // Then the next file is started
+#define Data_Logger_Files_Keep      64                      // The oldest beyond this are deleted
+#define Data_Logger_Flush_ms        5000                    // Longest a record waits in RAM, the most a power loss takes
+#define Data_Logger_Battery_Every   10                      // Samples per battery record
+#define Data_Logger_Eject_ms        2000                    // For the last block to reach a card that is ejected
+#define Data_Logger_Shutdown_ms     600                     // One block written and synced on a slow card
+
+typedef struct {
+    uint32_t Records;
+    uint32_t Dropped;                                       // Both buffers were full
+    uint32_t Blocks;                                        // Written and synced
+    uint32_t Bytes;
+    uint32_t Files;
+    uint32_t Write_Errors;                                  // Blocks lost to the card
+    uint64_t Add_us;                                        // Time spent adding records, on the callers
+    uint64_t Write_us;                                      // Time the logger task waited for write() and fsync()
+} Data_Logger_Stats;
+
+void Data_Logger_Init(void);                                // After SD_Init(), follows the card in and out
+void Data_Logger_Sample(void);                              // From Driver_Loop, after the sensors were read
+void Data_Logger_Event(Log_Event_Code Code, const char *Text);
+bool Data_Logger_Flush(uint32_t Timeout_ms);                // True once everything added before is on the card
+void Data_Logger_Get_Stats(Data_Logger_Stats *Stats);
@@ -0,0 +1,102 @@
+#include "Log_Format.h"
+
+#include <string.h>
+
+// Nibble table, 64 bytes instead of 1 KB for a byte table. Blocks are small, so this costs little
+static const uint32_t Crc_Table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t Log_Crc32(uint32_t Crc, const void *Data, size_t Bytes)
+{
+    const uint8_t *bytes = Data;
+    Crc = ~Crc;
+    while (Bytes--) {
+        Crc ^= *bytes++;
+        Crc = (Crc >> 4) ^ Crc_Table[Crc & 0x0F];
+        Crc = (Crc >> 4) ^ Crc_Table[Crc & 0x0F];
+    }
+    return ~Crc;
+}
+
+void Log_Block_Begin(Log_Block *Block, uint32_t Unix_Time, uint32_t Base_Ms)
+{
+    Block->Used = sizeof(Log_Block_Header);
+    Block->Count = 0;
+    Block->Unix_Time = Unix_Time;
+    Block->Base_Ms = Base_Ms;
+}
+
+bool Log_Block_Add(Log_Block *Block, uint8_t Type, uint32_t Time_Ms, const void *Payload, uint8_t Length)
+{
+    uint32_t delta = Time_Ms - Block->Base_Ms;              // Uptime wraps after 49 days, so does this
+    if (delta > Log_Delta_Max || Block->Used + Log_Record_Header + Length > Log_Block_Max || Block->Count == UINT16_MAX) {
+        return false;
+    }
+    uint8_t *record = Block->Data + Block->Used;
+    record[0] = Type;
+    record[1] = Length;
+    record[2] = delta & 0xFF;
+    record[3] = delta >> 8;
+    memcpy(record + Log_Record_Header, Payload, Length);
+    Block->Used += Log_Record_Header + Length;
+    Block->Count++;
+    return true;
+}
+
+uint32_t Log_Block_Finish(Log_Block *Block, uint32_t Sequence)
+{
+    Log_Block_Header header = {
+        .Magic = Log_Block_Magic,
+        .Sequence = Sequence,
+        .Unix_Time = Block->Unix_Time,
+        .Base_Ms = Block->Base_Ms,
+        .Length = Block->Used - sizeof(Log_Block_Header),
+        .Count = Block->Count,
+        .Crc = 0,
+    };
+    memcpy(Block->Data, &header, sizeof(header));
+    header.Crc = Log_Crc32(0, Block->Data, Block->Used);
+    memcpy(Block->Data + offsetof(Log_Block_Header, Crc), &header.Crc, sizeof(header.Crc));
+    return Block->Used;
+}
+
+uint32_t Log_Block_Check(const uint8_t *Data, size_t Bytes)
+{
+    Log_Block_Header header;
+    if (Bytes < sizeof(header)) {
+        return 0;
+    }
+    memcpy(&header, Data, sizeof(header));
+    uint32_t length = sizeof(header) + header.Length;
+    if (header.Magic != Log_Block_Magic || length > Log_Block_Max || length > Bytes) {
+        return 0;
+    }
+    header.Crc = 0;
+    uint32_t crc = Log_Crc32(0, &header, sizeof(header));
+    crc = Log_Crc32(crc, Data + sizeof(header), header.Length);
+    uint32_t stored;
+    memcpy(&stored, Data + offsetof(Log_Block_Header, Crc), sizeof(stored));
+    if (crc != stored) {
+        return 0;
+    }
+    // The records have to fill the block exactly
+    uint32_t at = sizeof(header);
+    for (uint16_t i = 0; i < header.Count; i++) {
+        if (at + Log_Record_Header > length) {
+            return 0;
+        }
+        at += Log_Record_Header + Data[at + 1];
+    }
+    return at == length ? length : 0;
+}
+
+void Log_File_Header_Init(Log_File_Header *Header, uint32_t Unix_Time, uint32_t Boot_Ms)
+{
+    Header->Magic = Log_File_Magic;
+    Header->Version = Log_Version;
+    Header->Header_Size = sizeof(Log_File_Header);
+    Header->Unix_Time = Unix_Time;
+    Header->Boot_Ms = Boot_Ms;
+}
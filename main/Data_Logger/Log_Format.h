@@ -0,0 +1,72 @@
+#pragma once
+
+// Binary log records, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// A log file is a Log_File_Header followed by blocks. A block is a Log_Block_Header and the records of one
+// batch, written with a single write(). The CRC covers the whole block, so a block torn by power loss or a
+// pulled card fails the check and a reader skips ahead to the next block magic. host_bench/log_decode.py
+// decodes the files, all fields are little endian.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Log_File_Magic          0x31474C44                  // "DLG1"
+#define Log_Block_Magic         0x4B4C4244                  // "DBLK"
+#define Log_Version             1
+#define Log_Block_Max           4096                        // Header included
+#define Log_Delta_Max           UINT16_MAX                  // Records are at most this many ms after their block
+
+typedef struct {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t Header_Size;                                   // sizeof(Log_File_Header)
+    uint32_t Unix_Time;                                     // RTC when the file was started
+    uint32_t Boot_Ms;                                       // Uptime then
+} Log_File_Header;
+
+typedef struct {
+    uint32_t Magic;
+    uint32_t Sequence;                                      // Blocks since boot, a gap is a lost block
+    uint32_t Unix_Time;                                     // RTC seconds at Base_Ms
+    uint32_t Base_Ms;                                       // Uptime the record deltas count from
+    uint16_t Length;                                        // Record bytes after this header
+    uint16_t Count;                                         // Records
+    uint32_t Crc;                                           // CRC-32 of the header with this field 0, then the records
+} Log_Block_Header;
+
+// Each record is Type, payload length, ms since Base_Ms (16 bit), then the payload
+#define Log_Record_Header       4
+
+typedef enum {
+    Log_Record_Event = 1,                                   // Code, then text without the terminator
+    Log_Record_Imu,                                         // int16 accel x y z in mg, gyro x y z in 0.1 dps
+    Log_Record_Battery,                                     // uint16 mV
+} Log_Record_Type;
+
+typedef enum {
+    Log_Event_Boot = 1,                                     // Text is the reset reason
+    Log_Event_Dropped,                                      // Text is the number of records lost to a full buffer
+    Log_Event_Card,                                         // Text is "mounted" or "ejected"
+    Log_Event_Shutdown,                                     // Text is what asked for it, the last record of a session
+} Log_Event_Code;
+
+typedef struct {
+    uint8_t *Data;                                          // Log_Block_Max bytes, header first
+    uint32_t Used;
+    uint16_t Count;
+    uint32_t Unix_Time;
+    uint32_t Base_Ms;
+} Log_Block;
+
+void Log_Block_Begin(Log_Block *Block, uint32_t Unix_Time, uint32_t Base_Ms);
+// False if the block is full or Time_Ms is too far past Base_Ms, finish it and begin a new one
+bool Log_Block_Add(Log_Block *Block, uint8_t Type, uint32_t Time_Ms, const void *Payload, uint8_t Length);
+uint32_t Log_Block_Finish(Log_Block *Block, uint32_t Sequence);    // Fills in the header, returns the bytes to write
+uint32_t Log_Block_Check(const uint8_t *Data, size_t Bytes);        // Length of the valid block at Data, 0 if none
+void Log_File_Header_Init(Log_File_Header *Header, uint32_t Unix_Time, uint32_t Boot_Ms);
+uint32_t Log_Crc32(uint32_t Crc, const void *Data, size_t Bytes);  // Start with 0
+
+static inline bool Log_Block_Empty(const Log_Block *Block)
+{
+    return Block->Count == 0;
+}
@@ -0,0 +1,527 @@
+/**
+ * Host bench for the data logger: what logging costs the card and the CPU, and whether a
+ * torn log still reads back.
+ *
+ * A run logs -H hours of what Driver_Loop produces: an IMU record every 100 ms and a battery
+ * record every second. It compares ways of writing the same samples:
+ *
+ *   text, close each    a CSV line per sample, fopen()/fprintf()/fclose() as the old s_example_write_file() did
+ *   binary, sync each   the binary records, write() and fsync() per record
+ *   batched 1 s / 5 s   Log_Format blocks, write() and fsync() per block, 5 s is Data_Logger_Flush_ms
+ *   batched, full       blocks written only once Log_Block_Max is reached
+ *
+ * The card is modeled as FatFs drives it, in 512 byte sectors: a sector is written when a write
+ * completes it, and a sync rewrites the partial last sector and the directory entry, plus the
+ * FAT copies and FSINFO when a cluster was allocated. Files rotate at Data_Logger_File_Max_Bytes,
+ * and past Data_Logger_Files_Keep each new file deletes the oldest. Amplification is the bytes
+ * the card writes per byte of sample data. The SD card's own flash pages are larger than
+ * sectors, so the real cost of small writes is higher still. The CPU cost is timed apart from
+ * the model: formatting a CSV line against adding a binary record, block CRC included.
+ *
+ * The torn write checks take an hour of blocks and cut it short at random points, flip random
+ * bits, and zero random sectors. The scan, the same one log_decode.py does, has to return every
+ * block that was left intact and nothing else.
+ *
+ * -o writes the batched 5 s log into a directory as LOG00001.BIN and on, the last file cut
+ * mid-block, for log_decode.py.
+ *
+ * usage: log_bench [-H hours] [-n trials] [-o directory]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Log_Format.h"
+
+#define USAGE "usage: %s [-H hours] [-n trials] [-o directory]\n"
+
+#define Sample_ms               100                     // Driver_Loop
+#define Battery_Every           10                      // Data_Logger_Battery_Every
+#define Flush_ms                5000                    // Data_Logger_Flush_ms
+#define Task_Wake_ms            1000                    // The logger task checks the block age this often
+#define File_Max_Bytes          (1024 * 1024)           // Data_Logger_File_Max_Bytes
+#define Files_Keep              64                      // Data_Logger_Files_Keep
+#define Start_Unix              1760000000u
+
+#define Sector_Bytes            512
+#define Cluster_Bytes           (16 * 1024)             // allocation_unit_size in SD_Init()
+#define Fat_Copies              2                       // As cards come formatted
+
+static uint32_t failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*-------------------- card model --------------------*/
+
+typedef struct {
+    uint64_t size;                                      // Of the open file
+    uint32_t files;
+    bool dirty;                                         // Partial sector in the file buffer
+    bool fat_dirty;                                     // Clusters allocated since the last sync
+    uint64_t sectors;
+    uint64_t syncs;
+} card_t;
+
+static void card_sync(card_t *card)
+{
+    if (card->dirty) {
+        card->sectors++;
+        card->dirty = false;
+    }
+    card->sectors++;                                    // Directory entry, size and time
+    if (card->fat_dirty) {
+        card->sectors += Fat_Copies + 1;                // And FSINFO
+        card->fat_dirty = false;
+    }
+    card->syncs++;
+}
+
+static void card_open(card_t *card)
+{
+    card->files++;
+    card->size = 0;
+    card->sectors++;                                    // New directory entry
+    if (card->files > Files_Keep) {
+        card->sectors += 1 + Fat_Copies + 1;            // The oldest file's entry, its chain and FSINFO
+    }
+}
+
+static void card_write(card_t *card, uint32_t bytes)
+{
+    if (card->files == 0 || card->size + bytes > File_Max_Bytes) {
+        if (card->files) {
+            card_sync(card);                            // close()
+        }
+        card_open(card);
+    }
+    uint64_t end = card->size + bytes;
+    if ((end + Cluster_Bytes - 1) / Cluster_Bytes > (card->size + Cluster_Bytes - 1) / Cluster_Bytes) {
+        card->fat_dirty = true;
+    }
+    card->sectors += end / Sector_Bytes - card->size / Sector_Bytes;   // Sectors this write completed
+    card->dirty = end % Sector_Bytes != 0;
+    card->size = end;
+}
+
+/*-------------------- samples --------------------*/
+
+typedef struct {
+    uint32_t ms;                                        // Uptime
+    bool battery;                                       // Else IMU
+    int16_t imu[6];
+    uint16_t millivolts;
+} sample_t;
+
+static void make_sample(uint64_t index, sample_t *sample)
+{
+    uint64_t tick = index / 2;                          // Each pass adds an IMU record, then maybe a battery one
+    sample->battery = index % 2;
+    for (int i = 0; i < 6; i++) {
+        sample->imu[i] = (int16_t)((i == 2 ? 1000 : 0) + (rand() % 41) - 20 + (int)(tick % 97) * (i - 3));
+    }
+    sample->millivolts = 4150 - tick * Sample_ms / 60000;
+    sample->ms = tick * Sample_ms;
+}
+
+static uint64_t sample_count(double hours)
+{
+    // Two entries per Driver_Loop pass, the battery one only every Battery_Every passes
+    return (uint64_t)(hours * 3600 * 1000 / Sample_ms) * 2;
+}
+
+/*-------------------- text --------------------*/
+
+static int format_text(const sample_t *s, char *line, size_t size)
+{
+    uint32_t t = Start_Unix + s->ms / 1000;
+    if (s->battery) {
+        return snprintf(line, size, "%lu.%03lu,bat,%.3f\n", (unsigned long)t, (unsigned long)(s->ms % 1000),
+                        s->millivolts / 1000.0);
+    }
+    return snprintf(line, size, "%lu.%03lu,imu,%.3f,%.3f,%.3f,%.1f,%.1f,%.1f\n", (unsigned long)t,
+                    (unsigned long)(s->ms % 1000), s->imu[0] / 1000.0, s->imu[1] / 1000.0, s->imu[2] / 1000.0,
+                    s->imu[3] / 10.0, s->imu[4] / 10.0, s->imu[5] / 10.0);
+}
+
+static void run_text(double hours, card_t *card, uint64_t *payload)
+{
+    char line[128];
+    for (uint64_t i = 0; i < sample_count(hours); i++) {
+        sample_t s;
+        make_sample(i, &s);
+        if (s.battery && (i / 2) % Battery_Every) {
+            continue;
+        }
+        int length = format_text(&s, line, sizeof(line));
+        *payload += s.battery ? 2 : 12;
+        card_write(card, length);
+        card_sync(card);                                // fclose()
+    }
+}
+
+/*-------------------- binary --------------------*/
+
+typedef struct {
+    uint32_t offset;
+    uint32_t bytes;
+    uint32_t sequence;
+} block_info_t;
+
+typedef struct {
+    uint8_t *data;                                      // Every block back to back, no file headers
+    size_t size;
+    size_t capacity;
+    block_info_t *blocks;
+    uint32_t count;
+    uint32_t capacity_blocks;
+} stream_t;
+
+static void stream_add(stream_t *stream, const uint8_t *data, uint32_t bytes, uint32_t sequence)
+{
+    if (stream->size + bytes > stream->capacity) {
+        stream->capacity = stream->capacity ? stream->capacity * 2 : 1 << 20;
+        stream->data = realloc(stream->data, stream->capacity);
+    }
+    if (stream->count == stream->capacity_blocks) {
+        stream->capacity_blocks = stream->capacity_blocks ? stream->capacity_blocks * 2 : 1024;
+        stream->blocks = realloc(stream->blocks, stream->capacity_blocks * sizeof(block_info_t));
+    }
+    memcpy(stream->data + stream->size, data, bytes);
+    stream->blocks[stream->count++] = (block_info_t){ stream->size, bytes, sequence };
+    stream->size += bytes;
+}
+
+// Flush_After 0 syncs every record, UINT32_MAX only full blocks. The stream may be NULL
+static void run_binary(double hours, uint32_t flush_after, card_t *card, stream_t *stream, uint64_t *payload)
+{
+    static uint8_t data[Log_Block_Max];
+    Log_Block block = { .Data = data };
+    uint32_t sequence = 0;
+
+    for (uint64_t i = 0; i < sample_count(hours); i++) {
+        sample_t s;
+        make_sample(i, &s);
+        if (s.battery && (i / 2) % Battery_Every) {
+            continue;
+        }
+        bool aged = !Log_Block_Empty(&block) && flush_after != UINT32_MAX && s.ms % Task_Wake_ms == 0 &&
+                    s.ms - block.Base_Ms >= flush_after;
+        if (aged) {
+            uint32_t finished = Log_Block_Finish(&block, sequence++);
+            block.Count = 0;
+            card_write(card, finished);
+            card_sync(card);
+            if (stream) {
+                stream_add(stream, data, finished, sequence - 1);
+            }
+        }
+        if (Log_Block_Empty(&block)) {
+            Log_Block_Begin(&block, Start_Unix + s.ms / 1000, s.ms);
+        }
+        bool added = s.battery ? Log_Block_Add(&block, Log_Record_Battery, s.ms, &s.millivolts, 2)
+                               : Log_Block_Add(&block, Log_Record_Imu, s.ms, s.imu, sizeof(s.imu));
+        uint32_t finished;
+        if (!added) {
+            finished = Log_Block_Finish(&block, sequence++);
+            card_write(card, finished);
+            card_sync(card);
+            if (stream) {
+                stream_add(stream, data, finished, sequence - 1);
+            }
+            Log_Block_Begin(&block, Start_Unix + s.ms / 1000, s.ms);
+            added = s.battery ? Log_Block_Add(&block, Log_Record_Battery, s.ms, &s.millivolts, 2)
+                              : Log_Block_Add(&block, Log_Record_Imu, s.ms, s.imu, sizeof(s.imu));
+        }
+        CHECK(added);
+        *payload += s.battery ? 2 : 12;
+        if (flush_after == 0) {
+            finished = Log_Block_Finish(&block, sequence++);
+            block.Count = 0;
+            card_write(card, finished - sizeof(Log_Block_Header));   // The bare record, no block around it
+            card_sync(card);
+        }
+    }
+    if (!Log_Block_Empty(&block)) {
+        uint32_t finished = Log_Block_Finish(&block, sequence++);
+        card_write(card, finished);
+        card_sync(card);
+        if (stream) {
+            stream_add(stream, data, finished, sequence - 1);
+        }
+    }
+}
+
+static void report(const char *name, double hours, const card_t *card, uint64_t payload)
+{
+    double scale = 24 / hours;
+    printf("  %-18s %8.1f MB  %9.0f  %6.1f x  %9.0f\n", name, card->sectors * Sector_Bytes * scale / 1e6,
+           card->sectors * scale, (double)card->sectors * Sector_Bytes / payload, card->syncs * scale);
+}
+
+/*-------------------- cpu --------------------*/
+
+// An hour of samples, formatted as text and encoded as the logger does, several times over
+static void cpu_cost(void)
+{
+    uint32_t count = 0;
+    sample_t *samples = malloc(sample_count(1) * sizeof(sample_t));
+    for (uint64_t i = 0; i < sample_count(1); i++) {
+        make_sample(i, &samples[count]);
+        if (!samples[count].battery || (i / 2) % Battery_Every == 0) {
+            count++;
+        }
+    }
+    enum { ROUNDS = 20 };
+    char line[128];
+    size_t text_bytes = 0;
+    double start = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (uint32_t i = 0; i < count; i++) {
+            text_bytes += format_text(&samples[i], line, sizeof(line));
+        }
+    }
+    double text_ns = (now_ns() - start) / ROUNDS / count;
+
+    static uint8_t data[Log_Block_Max];
+    Log_Block block = { .Data = data };
+    uint32_t sequence = 0;
+    size_t binary_bytes = 0;
+    start = now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (uint32_t i = 0; i < count; i++) {
+            const sample_t *s = &samples[i];
+            if (!Log_Block_Empty(&block) && s->ms % Task_Wake_ms == 0 && s->ms - block.Base_Ms >= Flush_ms) {
+                binary_bytes += Log_Block_Finish(&block, sequence++);
+                block.Count = 0;
+            }
+            if (Log_Block_Empty(&block)) {
+                Log_Block_Begin(&block, Start_Unix + s->ms / 1000, s->ms);
+            }
+            bool added = s->battery ? Log_Block_Add(&block, Log_Record_Battery, s->ms, &s->millivolts, 2)
+                                    : Log_Block_Add(&block, Log_Record_Imu, s->ms, s->imu, sizeof(s->imu));
+            if (!added) {
+                binary_bytes += Log_Block_Finish(&block, sequence++);
+                Log_Block_Begin(&block, Start_Unix + s->ms / 1000, s->ms);
+                Log_Block_Add(&block, s->battery ? Log_Record_Battery : Log_Record_Imu, s->ms,
+                              s->battery ? (const void *)&s->millivolts : (const void *)s->imu, s->battery ? 2 : 12);
+            }
+        }
+        block.Count = 0;
+    }
+    double binary_ns = (now_ns() - start) / ROUNDS / count;
+    printf("cpu per record: text %.0f ns, %.1f bytes  binary %.0f ns, %.1f bytes, block CRC included\n", text_ns,
+           (double)text_bytes / ROUNDS / count, binary_ns, (double)binary_bytes / ROUNDS / count);
+    CHECK(binary_ns < text_ns);
+    free(samples);
+}
+
+/*-------------------- torn writes --------------------*/
+
+// Every valid block, in order, stepping a byte at a time past anything that is not one
+static uint32_t scan(const uint8_t *data, size_t bytes, uint32_t *offsets, uint32_t max)
+{
+    uint32_t found = 0;
+    size_t at = 0;
+    while (at < bytes) {
+        uint32_t length = Log_Block_Check(data + at, bytes - at);
+        if (!length) {
+            at++;
+            continue;
+        }
+        if (found < max) {
+            offsets[found] = at;
+        }
+        found++;
+        at += length;
+    }
+    return found;
+}
+
+// The intact blocks are those not overlapping [From, To)
+static bool recovered_all(const stream_t *stream, const uint8_t *data, size_t bytes, size_t from, size_t to,
+                          uint32_t *offsets)
+{
+    uint32_t found = scan(data, bytes, offsets, stream->count);
+    uint32_t expected = 0;
+    for (uint32_t b = 0; b < stream->count; b++) {
+        const block_info_t *block = &stream->blocks[b];
+        bool intact = block->offset + block->bytes <= bytes && (block->offset + block->bytes <= from || block->offset >= to);
+        if (intact) {
+            if (expected >= found || offsets[expected] != block->offset) {
+                return false;
+            }
+            expected++;
+        }
+    }
+    return expected == found;
+}
+
+static void torn_checks(const stream_t *stream, uint32_t trials)
+{
+    uint8_t *copy = malloc(stream->size);
+    uint32_t *offsets = malloc(stream->count * sizeof(uint32_t));
+    uint32_t bad_cut = 0, bad_flip = 0, bad_sector = 0;
+    double start = now_ns();
+    CHECK(scan(stream->data, stream->size, offsets, stream->count) == stream->count);
+    double scan_ms = (now_ns() - start) / 1e6;
+
+    for (uint32_t t = 0; t < trials; t++) {
+        // Power lost during a write: the file ends anywhere
+        size_t cut = (size_t)rand() * rand() % (stream->size + 1);
+        bad_cut += !recovered_all(stream, stream->data, cut, cut, cut, offsets);
+
+        // A bit flipped in one block
+        memcpy(copy, stream->data, stream->size);
+        size_t at = (size_t)rand() * rand() % stream->size;
+        copy[at] ^= 1 << (rand() % 8);
+        bad_flip += !recovered_all(stream, copy, stream->size, at, at + 1, offsets);
+        copy[at] = stream->data[at];
+
+        // A sector that never reached the card
+        size_t sector = ((size_t)rand() * rand() % stream->size) / Sector_Bytes * Sector_Bytes;
+        size_t end = sector + Sector_Bytes < stream->size ? sector + Sector_Bytes : stream->size;
+        memset(copy + sector, 0, end - sector);
+        bad_sector += !recovered_all(stream, copy, stream->size, sector, end, offsets);
+    }
+    printf("torn writes: %u blocks, %zu bytes, full scan %.2f ms\n", stream->count, stream->size, scan_ms);
+    printf("  cut short        %u of %u trials lost an intact block or kept a broken one\n", bad_cut, trials);
+    printf("  bit flipped      %u of %u\n", bad_flip, trials);
+    printf("  sector zeroed    %u of %u\n", bad_sector, trials);
+    CHECK(bad_cut == 0 && bad_flip == 0 && bad_sector == 0);
+    free(copy);
+    free(offsets);
+}
+
+/*-------------------- files for log_decode.py --------------------*/
+
+static void write_files(const stream_t *stream, const char *directory)
+{
+    uint32_t number = 0;
+    FILE *file = NULL;
+    size_t file_bytes = 0;
+    char path[4096];
+    for (uint32_t b = 0; b < stream->count; b++) {
+        const block_info_t *block = &stream->blocks[b];
+        if (!file || file_bytes + block->bytes > File_Max_Bytes) {
+            if (file) {
+                fclose(file);
+            }
+            snprintf(path, sizeof(path), "%s/LOG%05u.BIN", directory, ++number);
+            file = fopen(path, "wb");
+            if (!file) {
+                perror(path);
+                failures++;
+                return;
+            }
+            Log_File_Header header;
+            uint32_t base;
+            memcpy(&base, stream->data + block->offset + offsetof(Log_Block_Header, Base_Ms), sizeof(base));
+            Log_File_Header_Init(&header, Start_Unix + base / 1000, base);
+            fwrite(&header, sizeof(header), 1, file);
+            file_bytes = sizeof(header);
+        }
+        // The last block is torn, as if the power went mid-write
+        uint32_t bytes = (b == stream->count - 1) ? block->bytes / 2 : block->bytes;
+        fwrite(stream->data + block->offset, bytes, 1, file);
+        file_bytes += bytes;
+    }
+    if (file) {
+        fclose(file);
+    }
+    printf("wrote %u files to %s, the last block of the last one torn\n", number, directory);
+}
+
+int main(int argc, char **argv)
+{
+    double hours = 24;
+    uint32_t trials = 1000;
+    const char *directory = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-H") && i + 1 < argc) {
+            hours = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            trials = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            directory = argv[++i];
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (hours <= 0) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+
+    printf("%.1f hours of samples, per day:\n", hours);
+    printf("  %-18s %11s  %9s  %8s  %9s\n", "", "card bytes", "sectors", "amplif.", "syncs");
+    struct {
+        const char *name;
+        uint32_t flush_after;
+    } policies[] = {
+        { "binary, sync each", 0 },
+        { "batched 1 s", 1000 },
+        { "batched 5 s", Flush_ms },
+        { "batched, full", UINT32_MAX },
+    };
+    card_t card = { 0 };
+    uint64_t payload = 0;
+    srand(1);
+    run_text(hours, &card, &payload);
+    report("text, close each", hours, &card, payload);
+    uint64_t text_sectors = card.sectors;
+
+    stream_t stream = { 0 };
+    uint64_t batched_sectors = 0;
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+        card = (card_t){ 0 };
+        payload = 0;
+        srand(1);
+        bool keep = policies[p].flush_after == Flush_ms;
+        run_binary(hours, policies[p].flush_after, &card, keep ? &stream : NULL, &payload);
+        report(policies[p].name, hours, &card, payload);
+        if (keep) {
+            batched_sectors = card.sectors;
+        }
+    }
+    printf("batched 5 s writes %.1fx fewer sectors than text\n", (double)text_sectors / batched_sectors);
+    CHECK(batched_sectors * 10 < text_sectors);
+    srand(1);
+    cpu_cost();
+
+    // An hour of it for the torn write checks
+    stream_t hour = { 0 };
+    uint32_t blocks = 0;
+    while (blocks < stream.count && hour.size < 600000) {
+        const block_info_t *block = &stream.blocks[blocks++];
+        stream_add(&hour, stream.data + block->offset, block->bytes, block->sequence);
+    }
+    srand(2);
+    torn_checks(&hour, trials);
+
+    if (directory) {
+        write_files(&stream, directory);
+    }
+    free(stream.data);
+    free(stream.blocks);
+    free(hour.data);
+    free(hour.blocks);
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Decoder for the data logger's files, LOG00001.BIN and on in /sdcard/logs.
+
+    log_decode.py [--csv out.csv] [--quiet] path...
+
+Each path is a log file or a directory of them, taken in file number order. Records are
+written as CSV, one per line:
+
+    time            UTC from the RTC, to the ms
+    uptime_ms       since the boot that wrote it
+    type            imu, battery or event
+    fields          ax ay az in g and gx gy gz in dps, volts, or the event and its text
+
+The layout is in Log_Format.h. A block that fails its CRC, was cut short by power loss or
+has records that do not add up to its length is skipped, and the scan resumes at the next
+block magic, as log_bench checks. A summary goes to stderr: blocks, records, bytes skipped,
+torn tails, and gaps in the block sequence, which count blocks that never reached the card.
+"""
+
+import argparse
+import csv
+import datetime
+import os
+import re
+import struct
+import sys
+import zlib
+
+FILE_MAGIC = 0x31474C44                                     # "DLG1"
+BLOCK_MAGIC = 0x4B4C4244                                    # "DBLK"
+BLOCK_MAX = 4096
+FILE_HEADER = struct.Struct("<IHHII")
+BLOCK_HEADER = struct.Struct("<IIIIHHI")
+RECORD_HEADER = struct.Struct("<BBH")
+
+RECORD_EVENT, RECORD_IMU, RECORD_BATTERY = 1, 2, 3
+EVENTS = {1: "boot", 2: "dropped", 3: "card", 4: "shutdown"}
+
+
+def check_block(data, at):
+    """Length of the valid block at data[at:], 0 if there is none."""
+    if len(data) - at < BLOCK_HEADER.size:
+        return 0
+    magic, sequence, unix_time, base_ms, length, count, crc = BLOCK_HEADER.unpack_from(data, at)
+    total = BLOCK_HEADER.size + length
+    if magic != BLOCK_MAGIC or total > BLOCK_MAX or at + total > len(data):
+        return 0
+    header = BLOCK_HEADER.pack(magic, sequence, unix_time, base_ms, length, count, 0)
+    if zlib.crc32(data[at + BLOCK_HEADER.size:at + total], zlib.crc32(header)) != crc:
+        return 0
+    offset = BLOCK_HEADER.size
+    for _ in range(count):
+        if offset + RECORD_HEADER.size > total:
+            return 0
+        offset += RECORD_HEADER.size + data[at + offset + 1]
+    return total if offset == total else 0
+
+
+def decode_record(kind, payload):
+    if kind == RECORD_IMU and len(payload) == 12:
+        values = struct.unpack("<6h", payload)
+        return "imu", [f"{v / 1000:.3f}" for v in values[:3]] + [f"{v / 10:.1f}" for v in values[3:]]
+    if kind == RECORD_BATTERY and len(payload) == 2:
+        return "battery", [f"{struct.unpack('<H', payload)[0] / 1000:.3f}"]
+    if kind == RECORD_EVENT and payload:
+        return "event", [EVENTS.get(payload[0], str(payload[0])), payload[1:].decode("utf-8", "replace")]
+    return f"type {kind}", [payload.hex()]
+
+
+class Summary:
+    def __init__(self):
+        self.files = self.blocks = self.records = self.skipped = self.torn = self.lost = 0
+        self.kinds = {}
+        self.sequence = None
+
+
+def decode_file(path, writer, summary):
+    with open(path, "rb") as f:
+        data = f.read()
+    summary.files += 1
+    at = 0
+    if len(data) >= FILE_HEADER.size:
+        magic, version, header_size, unix_time, boot_ms = FILE_HEADER.unpack_from(data)
+        if magic == FILE_MAGIC:
+            if version != 1:
+                print(f"{path}: version {version}, decoding as 1", file=sys.stderr)
+            at = header_size
+        else:
+            print(f"{path}: no file header, scanning for blocks", file=sys.stderr)
+
+    while at < len(data):
+        length = check_block(data, at)
+        if not length:
+            following = data.find(struct.pack("<I", BLOCK_MAGIC), at + 1)
+            if following < 0:
+                # Nothing valid after this, a block torn by power loss or a pulled card
+                summary.torn += len(data) - at
+                break
+            summary.skipped += following - at
+            at = following
+            continue
+
+        _, sequence, unix_time, base_ms, _, count, _ = BLOCK_HEADER.unpack_from(data, at)
+        # Sequences start over with each boot, so only a jump forward is a loss
+        if summary.sequence is not None and sequence > summary.sequence + 1:
+            summary.lost += sequence - summary.sequence - 1
+        summary.sequence = sequence
+        summary.blocks += 1
+        offset = at + BLOCK_HEADER.size
+        for _ in range(count):
+            kind, size, delta = RECORD_HEADER.unpack_from(data, offset)
+            payload = data[offset + RECORD_HEADER.size:offset + RECORD_HEADER.size + size]
+            offset += RECORD_HEADER.size + size
+            name, fields = decode_record(kind, payload)
+            summary.records += 1
+            summary.kinds[name] = summary.kinds.get(name, 0) + 1
+            if writer:
+                stamp = datetime.datetime.fromtimestamp(unix_time + delta / 1000, datetime.timezone.utc)
+                writer.writerow([stamp.isoformat(timespec="milliseconds").replace("+00:00", "Z"),
+                                 (base_ms + delta) & 0xFFFFFFFF, name] + fields)
+        at += length
+
+
+def log_files(paths):
+    for path in paths:
+        if os.path.isdir(path):
+            names = [n for n in os.listdir(path) if re.fullmatch(r"(?i)LOG\d+\.BIN", n)]
+            for name in sorted(names, key=lambda n: int(n[3:-4])):
+                yield os.path.join(path, name)
+        else:
+            yield path
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode data logger files.")
+    parser.add_argument("paths", nargs="+", help="log files or directories of them")
+    parser.add_argument("--csv", help="write the records here instead of stdout")
+    parser.add_argument("--quiet", action="store_true", help="only the summary")
+    args = parser.parse_args()
+
+    out = None
+    writer = None
+    if not args.quiet:
+        out = open(args.csv, "w", newline="") if args.csv else sys.stdout
+        writer = csv.writer(out)
+    summary = Summary()
+    try:
+        for path in log_files(args.paths):
+            decode_file(path, writer, summary)
+    except BrokenPipeError:
+        return 0
+    finally:
+        if out and out is not sys.stdout:
+            out.close()
+
+    kinds = ", ".join(f"{count} {name}" for name, count in sorted(summary.kinds.items()))
+    print(f"{summary.files} files, {summary.blocks} blocks, {summary.records} records ({kinds})", file=sys.stderr)
+    print(f"{summary.skipped} bytes skipped, {summary.torn} bytes torn at file ends, "
+          f"{summary.lost} blocks missing from the sequence", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
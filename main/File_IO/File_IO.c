@@ -0,0 +1,473 @@
+#define _GNU_SOURCE                                         // fopencookie()
+#include "File_IO.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+static const char *TAG = "FILE IO";
+
+#define No_Chunk                UINT32_MAX
+
+static Io_Queue Queue;
+static File_IO_Stats Stats = { 0 };
+static SemaphoreHandle_t Queue_Mutex = NULL;
+static SemaphoreHandle_t Free_Slots;                        // Counts the requests Io_Queue has left
+static TaskHandle_t IO_Task_Handle;
+
+static uint32_t Now_ms(void)
+{
+    return esp_timer_get_time() / 1000;
+}
+
+static void Run(Io_Request **Batch, uint32_t Count, int32_t *Results)
+{
+    Io_Request *first = Batch[0];
+    int32_t result;
+    if (first->Op == Io_Read) {
+        // Merged reads are one pread() into the buffers, which follow each other
+        uint32_t bytes = 0;
+        for (uint32_t i = 0; i < Count; i++) {
+            bytes += Batch[i]->Bytes;
+        }
+        ssize_t read = pread(first->Fd, first->Buffer, bytes, first->Offset);
+        result = read < 0 ? -errno : (int32_t)read;
+        for (uint32_t i = 0; i < Count; i++) {
+            if (result < 0) {
+                Results[i] = result;
+            } else {
+                Results[i] = result < (int32_t)Batch[i]->Bytes ? result : (int32_t)Batch[i]->Bytes;
+                result -= Results[i];
+            }
+        }
+        return;
+    }
+    if (first->Op == Io_Write) {
+        ssize_t written = write(first->Fd, first->Buffer, first->Bytes);
+        result = written < 0 ? -errno : (int32_t)written;
+        if (written >= 0 && first->Sync && fsync(first->Fd) != 0) {
+            result = -errno;
+        }
+    } else {
+        result = first->Function(first->Context);
+    }
+    Results[0] = result;
+}
+
+static void File_IO_Task(void *arg)
+{
+    Io_Request *batch[Io_Queue_Batch_Max];
+    int32_t results[Io_Queue_Batch_Max];
+    while (1) {
+        xSemaphoreTake(Queue_Mutex, portMAX_DELAY);
+        uint32_t count = Io_Queue_Pop(&Queue, Now_ms(), batch);
+        xSemaphoreGive(Queue_Mutex);
+        if (!count) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        int64_t start = esp_timer_get_time();
+        Run(batch, count, results);
+        int64_t busy = esp_timer_get_time() - start;
+        uint8_t op = batch[0]->Op;
+        for (uint32_t i = 0; i < count; i++) {
+            if (batch[i]->Done) {
+                batch[i]->Done(batch[i]->Context, results[i]);
+            }
+        }
+        xSemaphoreTake(Queue_Mutex, portMAX_DELAY);
+        Stats.Busy_us += busy;
+        for (uint32_t i = 0; i < count; i++) {
+            Stats.Errors += results[i] < 0;
+            if (results[i] > 0 && op == Io_Read) {
+                Stats.Read_Bytes += results[i];
+            } else if (results[i] > 0 && op == Io_Write) {
+                Stats.Write_Bytes += results[i];
+            }
+            Io_Queue_Release(&Queue, batch[i]);
+            xSemaphoreGive(Free_Slots);
+        }
+        xSemaphoreGive(Queue_Mutex);
+    }
+}
+
+void File_IO_Init(void)
+{
+    Io_Queue_Init(&Queue, File_IO_Starve_ms, File_IO_Merge_Max);
+    Free_Slots = xSemaphoreCreateCounting(Io_Queue_Depth, Io_Queue_Depth);
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    // Above the player, which waits on it, but the task spends its time waiting on the card
+    if (!Free_Slots || !mutex ||
+        xTaskCreatePinnedToCore(File_IO_Task, "File IO", 4096, NULL, 4, &IO_Task_Handle, 0) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create file I/O task");
+        return;
+    }
+    Queue_Mutex = mutex;                                    // Requests are refused until this is set
+}
+
+// Queued together, so reads that follow each other are there to be merged when the task looks
+static bool Submit_Batch(const Io_Request *Templates, uint32_t Count)
+{
+    if (!Queue_Mutex) {
+        return false;
+    }
+    for (uint32_t i = 0; i < Count; i++) {
+        xSemaphoreTake(Free_Slots, portMAX_DELAY);
+    }
+    xSemaphoreTake(Queue_Mutex, portMAX_DELAY);
+    for (uint32_t i = 0; i < Count; i++) {
+        Io_Request *request = Io_Queue_Alloc(&Queue);       // Never NULL with a slot taken
+        *request = Templates[i];
+        Io_Queue_Push(&Queue, request, Now_ms());
+    }
+    xSemaphoreGive(Queue_Mutex);
+    xTaskNotifyGive(IO_Task_Handle);
+    return true;
+}
+
+static bool Submit(const Io_Request *Template)
+{
+    return Submit_Batch(Template, 1);
+}
+
+bool File_IO_Read(Io_Class Class, int Fd, uint32_t Offset, void *Buffer, uint32_t Bytes, Io_Done Done, void *Context)
+{
+    Io_Request request = { .Op = Io_Read, .Class = Class, .Fd = Fd, .Offset = Offset, .Buffer = Buffer, .Bytes = Bytes,
+                           .Done = Done, .Context = Context };
+    return Submit(&request);
+}
+
+bool File_IO_Write(Io_Class Class, int Fd, const void *Buffer, uint32_t Bytes, bool Sync, Io_Done Done, void *Context)
+{
+    Io_Request request = { .Op = Io_Write, .Class = Class, .Sync = Sync, .Fd = Fd, .Buffer = (void *)Buffer,
+                           .Bytes = Bytes, .Done = Done, .Context = Context };
+    return Submit(&request);
+}
+
+bool File_IO_Call(Io_Class Class, Io_Function Function, void *Context, Io_Done Done)
+{
+    Io_Request request = { .Op = Io_Call, .Class = Class, .Function = Function, .Done = Done, .Context = Context };
+    return Submit(&request);
+}
+
+typedef struct {
+    SemaphoreHandle_t Done;
+    int32_t Result;
+} Waiter;
+
+static void Wake(void *Context, int32_t Result)
+{
+    Waiter *waiter = Context;
+    waiter->Result = Result;
+    xSemaphoreGive(waiter->Done);
+}
+
+static int32_t Submit_Wait(Io_Request *Request)
+{
+    StaticSemaphore_t storage;
+    Waiter waiter = { .Done = xSemaphoreCreateBinaryStatic(&storage), .Result = -ENOMEM };
+    Request->Done = Wake;
+    Request->Context = &waiter;
+    if (Submit(Request)) {
+        xSemaphoreTake(waiter.Done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(waiter.Done);
+    return waiter.Result;
+}
+
+int32_t File_IO_Read_Wait(Io_Class Class, int Fd, uint32_t Offset, void *Buffer, uint32_t Bytes)
+{
+    Io_Request request = { .Op = Io_Read, .Class = Class, .Fd = Fd, .Offset = Offset, .Buffer = Buffer, .Bytes = Bytes };
+    return Submit_Wait(&request);
+}
+
+int32_t File_IO_Write_Wait(Io_Class Class, int Fd, const void *Buffer, uint32_t Bytes, bool Sync)
+{
+    Io_Request request = { .Op = Io_Write, .Class = Class, .Sync = Sync, .Fd = Fd, .Buffer = (void *)Buffer,
+                           .Bytes = Bytes };
+    return Submit_Wait(&request);
+}
+
+int32_t File_IO_Call_Wait(Io_Class Class, Io_Function Function, void *Context)
+{
+    Io_Request request = { .Op = Io_Call, .Class = Class, .Function = Function, .Context = Context };
+    return Submit_Wait(&request);
+}
+
+void File_IO_Take_Stats(File_IO_Stats *Out)
+{
+    if (!Queue_Mutex) {
+        memset(Out, 0, sizeof(*Out));
+        return;
+    }
+    xSemaphoreTake(Queue_Mutex, portMAX_DELAY);
+    *Out = Stats;
+    Out->Queue = Queue.Stats;
+    memset(&Stats, 0, sizeof(Stats));
+    memset(&Queue.Stats, 0, sizeof(Queue.Stats));
+    xSemaphoreGive(Queue_Mutex);
+}
+
+/* ---- Streams ----
+ * The file is read in chunks, chunk N into half N % 2 of the buffer. Reading chunk N starts N + 1 in the other
+ * half, so the reader finds the next one there unless it outruns the card. After a seek to an even chunk both
+ * halves are started together, which Io_Queue merges into one read.
+ */
+
+typedef struct Stream Stream;
+
+typedef struct {
+    Stream *Owner;
+    uint32_t Chunk;                                         // No_Chunk for none
+    int32_t Length;                                         // Bytes in it, a negative errno if the read failed
+    bool Busy;                                              // Being read into
+} Stream_Slot;
+
+struct Stream {
+    int Fd;
+    int32_t Error;                                          // Of the open
+    bool Opened;
+    uint32_t Size;
+    uint32_t Position;
+    Io_Class Class;
+    uint8_t *Buffer;                                        // Two chunks
+    Stream_Slot Slots[2];
+    SemaphoreHandle_t Lock;
+    SemaphoreHandle_t Changed;                              // Given as each request for the stream completes
+    char Path[];
+};
+
+static void Stream_Wait(Stream *S)
+{
+    xSemaphoreGive(S->Lock);
+    xSemaphoreTake(S->Changed, portMAX_DELAY);
+    xSemaphoreTake(S->Lock, portMAX_DELAY);
+}
+
+// The open also reads chunk 0, which the stream was made waiting for
+static int32_t Stream_Open(void *Context)
+{
+    Stream *s = Context;
+    struct stat st;
+    int fd = open(s->Path, O_RDONLY);
+    int32_t error = 0;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        error = -errno;
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        ESP_LOGW(TAG, "Can't open %s, errno %ld", s->Path, -error);
+    }
+    ssize_t read = 0;
+    if (fd >= 0) {
+        read = pread(fd, s->Buffer, st.st_size < File_IO_Stream_Chunk ? st.st_size : File_IO_Stream_Chunk, 0);
+        read = read < 0 ? -errno : read;
+    }
+    xSemaphoreTake(s->Lock, portMAX_DELAY);
+    s->Fd = fd;
+    s->Error = error;
+    s->Size = fd >= 0 ? st.st_size : 0;
+    s->Opened = true;
+    s->Slots[0].Length = read;
+    s->Slots[0].Busy = false;
+    xSemaphoreGive(s->Lock);
+    xSemaphoreGive(s->Changed);
+    return error;
+}
+
+static void Stream_Read_Done(void *Context, int32_t Result)
+{
+    Stream_Slot *slot = Context;
+    Stream *s = slot->Owner;
+    xSemaphoreTake(s->Lock, portMAX_DELAY);
+    slot->Length = Result;
+    slot->Busy = false;
+    xSemaphoreGive(s->Lock);
+    xSemaphoreGive(s->Changed);
+}
+
+static uint32_t Chunk_Bytes(const Stream *S, uint32_t Chunk)
+{
+    uint32_t offset = Chunk * File_IO_Stream_Chunk;
+    return S->Size - offset < File_IO_Stream_Chunk ? S->Size - offset : File_IO_Stream_Chunk;
+}
+
+// Lock held. Claims the slot of Chunk for reading, false if it is busy, already holds it or it is past the end
+static bool Claim(Stream *S, uint32_t Chunk)
+{
+    Stream_Slot *slot = &S->Slots[Chunk & 1];
+    if (slot->Busy || slot->Chunk == Chunk || (uint64_t)Chunk * File_IO_Stream_Chunk >= S->Size) {
+        return false;
+    }
+    slot->Chunk = Chunk;
+    slot->Busy = true;
+    return true;
+}
+
+// Count claimed chunks from First. Lock not held: Done takes it on the I/O task, and a full queue waits for room
+static void Fetch(Stream *S, uint32_t First, uint32_t Count)
+{
+    Io_Request requests[2];
+    for (uint32_t i = 0; i < Count; i++) {
+        uint32_t chunk = First + i;
+        requests[i] = (Io_Request){ .Op = Io_Read, .Class = S->Class, .Fd = S->Fd,
+                                    .Offset = chunk * File_IO_Stream_Chunk,
+                                    .Buffer = S->Buffer + (chunk & 1) * File_IO_Stream_Chunk,
+                                    .Bytes = Chunk_Bytes(S, chunk), .Done = Stream_Read_Done,
+                                    .Context = &S->Slots[chunk & 1] };
+    }
+    if (!Submit_Batch(requests, Count)) {
+        for (uint32_t i = 0; i < Count; i++) {
+            Stream_Read_Done(requests[i].Context, -ENOMEM);
+        }
+    }
+}
+
+static ssize_t Stream_Read(void *Cookie, char *Buffer, size_t Bytes)
+{
+    Stream *s = Cookie;
+    size_t done = 0;
+    int32_t error = 0;
+    xSemaphoreTake(s->Lock, portMAX_DELAY);
+    while (!s->Opened) {
+        Stream_Wait(s);
+    }
+    error = s->Error;
+    while (!error && done < Bytes && s->Position < s->Size) {
+        uint32_t chunk = s->Position / File_IO_Stream_Chunk;
+        Stream_Slot *slot = &s->Slots[chunk & 1];
+        if (slot->Busy) {
+            Stream_Wait(s);
+            continue;
+        }
+        if (slot->Chunk != chunk) {
+            bool next = !(chunk & 1) && Claim(s, chunk + 1);
+            Claim(s, chunk);
+            xSemaphoreGive(s->Lock);
+            Fetch(s, chunk, next ? 2 : 1);
+            xSemaphoreTake(s->Lock, portMAX_DELAY);
+            continue;
+        }
+        if (slot->Length < 0) {
+            error = slot->Length;
+            slot->Chunk = No_Chunk;                         // Tried again on the next call
+            break;
+        }
+        uint32_t at = s->Position - chunk * File_IO_Stream_Chunk;
+        if (at >= (uint32_t)slot->Length) {
+            break;                                          // The file got shorter than it was at the open
+        }
+        uint32_t take = slot->Length - at < Bytes - done ? slot->Length - at : Bytes - done;
+        memcpy(Buffer + done, s->Buffer + (chunk & 1) * File_IO_Stream_Chunk + at, take);
+        done += take;
+        s->Position += take;
+        if (Claim(s, chunk + 1)) {
+            xSemaphoreGive(s->Lock);
+            Fetch(s, chunk + 1, 1);
+            xSemaphoreTake(s->Lock, portMAX_DELAY);
+        }
+    }
+    xSemaphoreGive(s->Lock);
+    if (error && !done) {
+        errno = -error;
+        return -1;
+    }
+    return done;
+}
+
+static int Stream_Seek(void *Cookie, off_t *Offset, int Whence)
+{
+    Stream *s = Cookie;
+    xSemaphoreTake(s->Lock, portMAX_DELAY);
+    while (!s->Opened) {
+        Stream_Wait(s);
+    }
+    int64_t base = Whence == SEEK_SET ? 0 : (Whence == SEEK_CUR ? s->Position : s->Size);
+    int64_t to = base + *Offset;
+    int32_t error = s->Error ? s->Error : ((to < 0 || to > UINT32_MAX || Whence > SEEK_END) ? -EINVAL : 0);
+    if (!error) {
+        s->Position = to;
+        *Offset = to;
+    }
+    xSemaphoreGive(s->Lock);
+    if (error) {
+        errno = -error;
+        return -1;
+    }
+    return 0;
+}
+
+static int32_t Stream_Free(void *Context)
+{
+    Stream *s = Context;
+    if (s->Fd >= 0) {
+        close(s->Fd);
+    }
+    vSemaphoreDelete(s->Lock);
+    vSemaphoreDelete(s->Changed);
+    heap_caps_free(s->Buffer);
+    free(s);
+    return 0;
+}
+
+// Reads still running write into the buffer, the close waits them out
+static int Stream_Close(void *Cookie)
+{
+    Stream *s = Cookie;
+    xSemaphoreTake(s->Lock, portMAX_DELAY);
+    while (!s->Opened || s->Slots[0].Busy || s->Slots[1].Busy) {
+        Stream_Wait(s);
+    }
+    xSemaphoreGive(s->Lock);
+    if (!File_IO_Call(s->Class, Stream_Free, s, NULL)) {
+        Stream_Free(s);
+    }
+    return 0;
+}
+
+FILE *File_IO_Open_Stream(const char *Path, Io_Class Class)
+{
+    size_t length = strlen(Path) + 1;
+    Stream *s = calloc(1, sizeof(Stream) + length);
+    if (!s) {
+        return NULL;
+    }
+    memcpy(s->Path, Path, length);
+    s->Fd = -1;
+    s->Class = Class;
+    s->Buffer = heap_caps_malloc(2 * File_IO_Stream_Chunk, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    s->Lock = xSemaphoreCreateMutex();
+    s->Changed = xSemaphoreCreateBinary();
+    for (int i = 0; i < 2; i++) {
+        s->Slots[i].Owner = s;
+        s->Slots[i].Chunk = No_Chunk;
+    }
+    s->Slots[0].Chunk = 0;                                  // Stream_Open() reads it
+    s->Slots[0].Busy = true;
+    cookie_io_functions_t functions = { .read = Stream_Read, .seek = Stream_Seek, .close = Stream_Close };
+    FILE *fp = (s->Buffer && s->Lock && s->Changed) ? fopencookie(s, "r", functions) : NULL;
+    if (!fp) {
+        if (s->Lock) vSemaphoreDelete(s->Lock);
+        if (s->Changed) vSemaphoreDelete(s->Changed);
+        heap_caps_free(s->Buffer);
+        free(s);
+        return NULL;
+    }
+    setvbuf(fp, NULL, _IONBF, 0);                           // The chunks are the buffer
+    if (!File_IO_Call(Class, Stream_Open, s, NULL)) {
+        s->Error = -ENOMEM;
+        s->Slots[0].Busy = false;
+        s->Opened = true;
+    }
+    return fp;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Card access for the player, the UI and the logger goes through one task that takes requests in the order
+// Io_Queue gives: audio before UI before logging, merged where reads follow each other. Whoever asks never
+// waits on FAT unless it chooses to, and a slow log sync no longer sits in front of the next audio read.
+// Done callbacks run on the I/O task, keep them short and don't wait for other requests from them.
+// Two readers don't, as either would hold the task for seconds: the library scan lists the card here in steps
+// (SD_Scan()) but reads the tags of every new track from its own task (Media_Index_Scan()), and the player's
+// index task walks a whole mp3 without a VBR header and reads and writes its seek table cache (mp3_index_get()).
+// Both run below the player.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "Io_Queue.h"
+
+#define File_IO_Starve_ms       250                         // Longest a lower class waits behind a busy higher one
+#define File_IO_Merge_Max       (32 * 1024)                 // Bytes in one merged read
+// Two per stream, DMA capable so the card reads straight in. One lasts 410 ms at 320 kbps, longer than a card
+// sync takes at its worst, which a read ahead may have to wait behind (host_bench/io_bench.c)
+#define File_IO_Stream_Chunk    (16 * 1024)
+
+typedef struct {
+    Io_Queue_Stats Queue;
+    uint32_t Read_Bytes;
+    uint32_t Write_Bytes;
+    uint32_t Errors;
+    uint64_t Busy_us;                                       // Time the task spent running requests
+} File_IO_Stats;
+
+void File_IO_Init(void);
+// False if the service isn't running. A full queue makes these wait for room
+bool File_IO_Read(Io_Class Class, int Fd, uint32_t Offset, void *Buffer, uint32_t Bytes, Io_Done Done, void *Context);
+bool File_IO_Write(Io_Class Class, int Fd, const void *Buffer, uint32_t Bytes, bool Sync, Io_Done Done, void *Context);
+bool File_IO_Call(Io_Class Class, Io_Function Function, void *Context, Io_Done Done);  // Done gets Context too
+// The same, waiting for the result: bytes or a negative errno
+int32_t File_IO_Read_Wait(Io_Class Class, int Fd, uint32_t Offset, void *Buffer, uint32_t Bytes);
+int32_t File_IO_Write_Wait(Io_Class Class, int Fd, const void *Buffer, uint32_t Bytes, bool Sync);
+int32_t File_IO_Call_Wait(Io_Class Class, Io_Function Function, void *Context);   // What Function returned
+// A read only stdio stream that reads ahead through the service. Returns at once, the open runs on the I/O task
+// and a file that can't be opened shows as a read error. Close it with fclose() from any task
+FILE *File_IO_Open_Stream(const char *Path, Io_Class Class);
+void File_IO_Take_Stats(File_IO_Stats *Stats);              // Since the last take
@@ -0,0 +1,103 @@
+#include "Io_Queue.h"
+
+#include <string.h>
+
+void Io_Queue_Init(Io_Queue *Queue, uint32_t Starve_ms, uint32_t Merge_Max)
+{
+    memset(Queue, 0, sizeof(*Queue));
+    for (int i = 0; i < Io_Queue_Depth - 1; i++) {
+        Queue->Pool[i].Next = &Queue->Pool[i + 1];
+    }
+    Queue->Free = &Queue->Pool[0];
+    Queue->Starve_ms = Starve_ms;
+    Queue->Merge_Max = Merge_Max;
+}
+
+Io_Request *Io_Queue_Alloc(Io_Queue *Queue)
+{
+    Io_Request *request = Queue->Free;
+    if (request) {
+        Queue->Free = request->Next;
+        memset(request, 0, sizeof(*request));
+        request->Fd = -1;
+    }
+    return request;
+}
+
+void Io_Queue_Push(Io_Queue *Queue, Io_Request *Request, uint32_t Now_ms)
+{
+    uint8_t class = Request->Class < Io_Classes ? Request->Class : Io_Class_Log;
+    Request->Class = class;
+    Request->Queued_ms = Now_ms;
+    Request->Next = NULL;
+    if (Queue->Tail[class]) {
+        Queue->Tail[class]->Next = Request;
+    } else {
+        Queue->Head[class] = Request;
+    }
+    Queue->Tail[class] = Request;
+    Queue->Stats.Requests[class]++;
+}
+
+static Io_Request *Take_Head(Io_Queue *Queue, int Class, uint32_t Now_ms)
+{
+    Io_Request *request = Queue->Head[Class];
+    Queue->Head[Class] = request->Next;
+    if (!Queue->Head[Class]) {
+        Queue->Tail[Class] = NULL;
+    }
+    request->Next = NULL;
+    uint32_t waited = Now_ms - request->Queued_ms;
+    if (waited > Queue->Stats.Wait_Max_ms[Class]) {
+        Queue->Stats.Wait_Max_ms[Class] = waited;
+    }
+    return request;
+}
+
+uint32_t Io_Queue_Pop(Io_Queue *Queue, uint32_t Now_ms, Io_Request **Batch)
+{
+    int class = -1;
+    for (int c = 0; c < Io_Classes; c++) {
+        if (Queue->Head[c]) {
+            class = c;
+            break;
+        }
+    }
+    if (class < 0) {
+        return 0;
+    }
+    // A lower class that has waited too long goes first, the longest waiting of them
+    uint32_t oldest = 0;
+    for (int c = class + 1; c < Io_Classes; c++) {
+        uint32_t waited = Queue->Head[c] ? Now_ms - Queue->Head[c]->Queued_ms : 0;
+        if (Queue->Head[c] && waited >= Queue->Starve_ms && waited > oldest) {
+            oldest = waited;
+            class = c;
+        }
+    }
+    if (oldest) {
+        Queue->Stats.Starved++;
+    }
+
+    Batch[0] = Take_Head(Queue, class, Now_ms);
+    uint32_t count = 1;
+    Io_Request *last = Batch[0];
+    uint32_t bytes = last->Bytes;
+    while (last->Op == Io_Read && count < Io_Queue_Batch_Max) {
+        Io_Request *next = Queue->Head[class];
+        if (!next || next->Op != Io_Read || next->Fd != last->Fd || next->Offset != last->Offset + last->Bytes ||
+            (uint8_t *)next->Buffer != (uint8_t *)last->Buffer + last->Bytes || bytes + next->Bytes > Queue->Merge_Max) {
+            break;
+        }
+        Batch[count++] = last = Take_Head(Queue, class, Now_ms);
+        bytes += last->Bytes;
+        Queue->Stats.Merged++;
+    }
+    return count;
+}
+
+void Io_Queue_Release(Io_Queue *Queue, Io_Request *Request)
+{
+    Request->Next = Queue->Free;
+    Queue->Free = Request;
+}
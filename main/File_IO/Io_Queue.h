@@ -0,0 +1,67 @@
+#pragma once
+
+// Ordering of file requests for File_IO, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// Requests wait in one FIFO per class and the highest class goes first, unless a lower one has waited
+// Starve_ms, then the one waiting longest goes. Reads at the head of a class that continue both the file and
+// the buffer of the one before are taken together, so the card sees one longer transfer.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define Io_Queue_Depth          16                          // Requests queued or running at once
+#define Io_Queue_Batch_Max      4                           // Reads merged into one
+
+typedef enum {
+    Io_Class_Audio,                                         // Served first, the player underruns otherwise
+    Io_Class_UI,                                            // Someone is looking at the screen for it
+    Io_Class_Log,                                           // Only has to get there
+    Io_Classes
+} Io_Class;
+
+typedef enum {
+    Io_Read,                                                // pread() at Offset
+    Io_Write,                                               // write() where the file is, fsync() after if Sync
+    Io_Call,                                                // Function, for open() and whatever else touches the card
+} Io_Op;
+
+typedef int32_t (*Io_Function)(void *Context);
+typedef void (*Io_Done)(void *Context, int32_t Result);    // Bytes or a negative errno, on the I/O task
+
+typedef struct Io_Request {
+    struct Io_Request *Next;
+    uint8_t Op;
+    uint8_t Class;
+    bool Sync;
+    int Fd;
+    uint32_t Offset;
+    void *Buffer;
+    uint32_t Bytes;
+    Io_Function Function;
+    Io_Done Done;                                           // May be NULL
+    void *Context;
+    uint32_t Queued_ms;
+} Io_Request;
+
+typedef struct {
+    uint32_t Requests[Io_Classes];
+    uint32_t Merged;                                        // Reads that went out with the one before
+    uint32_t Starved;                                       // Taken ahead of a higher class for having waited
+    uint32_t Wait_Max_ms[Io_Classes];                       // Longest from push to pop
+} Io_Queue_Stats;
+
+typedef struct {
+    Io_Request Pool[Io_Queue_Depth];
+    Io_Request *Free;
+    Io_Request *Head[Io_Classes];
+    Io_Request *Tail[Io_Classes];
+    uint32_t Starve_ms;
+    uint32_t Merge_Max;                                     // Bytes in a merged read
+    Io_Queue_Stats Stats;
+} Io_Queue;
+
+void Io_Queue_Init(Io_Queue *Queue, uint32_t Starve_ms, uint32_t Merge_Max);
+Io_Request *Io_Queue_Alloc(Io_Queue *Queue);                // NULL when all Io_Queue_Depth are in use
+void Io_Queue_Push(Io_Queue *Queue, Io_Request *Request, uint32_t Now_ms);
+// The next requests to run, several only for merged reads, 0 if none wait. Released after they ran
+uint32_t Io_Queue_Pop(Io_Queue *Queue, uint32_t Now_ms, Io_Request **Batch);
+void Io_Queue_Release(Io_Queue *Queue, Io_Request *Request);
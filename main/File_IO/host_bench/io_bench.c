@@ -0,0 +1,418 @@
+/**
+ * Host bench for Io_Queue, the ordering File_IO runs card requests in.
+ *
+ * The checks cover the rules: classes in order, FIFO within one, a starved lower class taken
+ * ahead, reads merged only where both the file and the buffer continue and only up to
+ * Merge_Max and Io_Queue_Batch_Max, writes and calls never merged, and the pool running out
+ * at Io_Queue_Depth.
+ *
+ * The simulation then runs an -s second mix through a card model, one request at a time as
+ * the I/O task does:
+ *
+ *   audio   an mp3 at 320 kbps read through a stream, 16 KB chunks with one read ahead,
+ *           so a chunk has to arrive within the 410 ms the one before it lasts
+ *   UI      a cold album art load every 4 s, 256 KB as 16 KB chunk reads, as many queued
+ *           at once as there is room for
+ *   log     a Data_Logger block every 5 s, 4 KB written and synced
+ *
+ * The card takes 1 ms per command plus 10 MB/s for reads. A sync takes 3 ms plus 5 to 30 ms,
+ * one in ten 100 to 300 ms, the busy times SD cards show while they garbage collect. Every
+ * request runs to the end once started, so nothing is preempted. It compares one FIFO for
+ * everything, as separate tasks calling stdio amount to, with the classes, and with the
+ * classes and merging. An underrun is an audio chunk that came after the player needed it.
+ *
+ * usage: io_bench [-s seconds]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Io_Queue.h"
+
+#define USAGE "usage: %s [-s seconds]\n"
+
+#define Chunk_Bytes             (16 * 1024)             // File_IO_Stream_Chunk
+#define Merge_Max               (32 * 1024)             // File_IO_Merge_Max
+#define Starve_ms               250                     // File_IO_Starve_ms
+#define Audio_Bytes_Per_s       40000                   // 320 kbps
+#define UI_Every_us             4000000
+#define UI_Chunks               16
+#define Log_Every_us            5000000
+#define Log_Bytes               4096
+#define Command_us              1000
+#define Read_ns_Per_Byte        100                     // 10 MB/s
+
+static uint32_t failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static uint8_t buffers[2][UI_Chunks * Chunk_Bytes];     // Only their addresses are used
+
+static Io_Request *push_read(Io_Queue *q, Io_Class class, int fd, uint32_t offset, uint8_t *buffer, uint32_t bytes,
+                             uint32_t now_ms)
+{
+    Io_Request *r = Io_Queue_Alloc(q);
+    r->Op = Io_Read;
+    r->Class = class;
+    r->Fd = fd;
+    r->Offset = offset;
+    r->Buffer = buffer;
+    r->Bytes = bytes;
+    Io_Queue_Push(q, r, now_ms);
+    return r;
+}
+
+static Io_Request *push_op(Io_Queue *q, Io_Class class, Io_Op op, uint32_t now_ms)
+{
+    Io_Request *r = Io_Queue_Alloc(q);
+    r->Op = op;
+    r->Class = class;
+    r->Fd = 3;
+    r->Buffer = buffers[1];
+    r->Bytes = 512;
+    Io_Queue_Push(q, r, now_ms);
+    return r;
+}
+
+static uint32_t pop_release(Io_Queue *q, uint32_t now_ms, Io_Request **batch)
+{
+    uint32_t n = Io_Queue_Pop(q, now_ms, batch);
+    for (uint32_t i = 0; i < n; i++) {
+        Io_Queue_Release(q, batch[i]);
+    }
+    return n;
+}
+
+static void checks(void)
+{
+    Io_Queue q;
+    Io_Request *batch[Io_Queue_Batch_Max];
+    uint8_t *b = buffers[0];
+
+    // Classes in order, FIFO within each
+    Io_Queue_Init(&q, Starve_ms, Merge_Max);
+    Io_Request *log1 = push_op(&q, Io_Class_Log, Io_Write, 0);
+    Io_Request *ui1 = push_op(&q, Io_Class_UI, Io_Call, 0);
+    Io_Request *log2 = push_op(&q, Io_Class_Log, Io_Write, 0);
+    Io_Request *audio = push_read(&q, Io_Class_Audio, 1, 0, b, Chunk_Bytes, 0);
+    Io_Request *ui2 = push_op(&q, Io_Class_UI, Io_Call, 0);
+    Io_Request *order[] = { audio, ui1, ui2, log1, log2 };
+    for (int i = 0; i < 5; i++) {
+        CHECK(Io_Queue_Pop(&q, 1, batch) == 1 && batch[0] == order[i]);
+        Io_Queue_Release(&q, batch[0]);
+    }
+    CHECK(Io_Queue_Pop(&q, 1, batch) == 0);
+    CHECK(q.Stats.Requests[Io_Class_Audio] == 1 && q.Stats.Requests[Io_Class_UI] == 2 &&
+          q.Stats.Requests[Io_Class_Log] == 2);
+
+    // A lower class waiting Starve_ms goes ahead, the one waiting longest first
+    Io_Queue_Init(&q, Starve_ms, Merge_Max);
+    log1 = push_op(&q, Io_Class_Log, Io_Write, 0);
+    ui1 = push_op(&q, Io_Class_UI, Io_Call, 100);
+    push_read(&q, Io_Class_Audio, 1, 0, b, Chunk_Bytes, 200);
+    push_read(&q, Io_Class_Audio, 1, 0, b, Chunk_Bytes, 200);
+    CHECK(Io_Queue_Pop(&q, Starve_ms - 1, batch) == 1 && batch[0]->Class == Io_Class_Audio);
+    Io_Queue_Release(&q, batch[0]);
+    CHECK(Io_Queue_Pop(&q, Starve_ms + 100, batch) == 1 && batch[0] == log1);
+    Io_Queue_Release(&q, batch[0]);
+    CHECK(Io_Queue_Pop(&q, Starve_ms + 100, batch) == 1 && batch[0] == ui1);
+    Io_Queue_Release(&q, batch[0]);
+    CHECK(q.Stats.Starved == 2 && q.Stats.Wait_Max_ms[Io_Class_Log] == Starve_ms + 100);
+    pop_release(&q, 400, batch);
+
+    // Merging: the file and the buffer both continue, same fd, same class, within the limits
+    Io_Queue_Init(&q, Starve_ms, Merge_Max);
+    push_read(&q, Io_Class_Audio, 1, 0, b, Merge_Max / 4, 0);
+    push_read(&q, Io_Class_Audio, 1, Merge_Max / 4, b + Merge_Max / 4, Merge_Max / 4, 0);
+    push_read(&q, Io_Class_Audio, 1, Merge_Max / 2, b + Merge_Max / 2, Merge_Max / 2, 0);
+    push_read(&q, Io_Class_Audio, 1, Merge_Max, b + Merge_Max, 512, 0);     // Past Merge_Max
+    CHECK(pop_release(&q, 0, batch) == 3 && q.Stats.Merged == 2);
+    CHECK(pop_release(&q, 0, batch) == 1);
+
+    push_read(&q, Io_Class_Audio, 1, 0, b, 512, 0);
+    push_read(&q, Io_Class_Audio, 2, 512, b + 512, 512, 0);                 // Another file
+    push_read(&q, Io_Class_Audio, 2, 1024, b + 2048, 512, 0);               // Buffer doesn't continue
+    push_read(&q, Io_Class_Audio, 2, 2048, b + 2560, 512, 0);               // File doesn't continue
+    push_read(&q, Io_Class_UI, 2, 2560, b + 3072, 512, 0);                  // Another class
+    for (int i = 0; i < 5; i++) {
+        CHECK(pop_release(&q, 0, batch) == 1);
+    }
+
+    for (int i = 0; i < Io_Queue_Batch_Max + 1; i++) {
+        push_read(&q, Io_Class_Audio, 1, i * 512, b + i * 512, 512, 0);
+    }
+    CHECK(pop_release(&q, 0, batch) == Io_Queue_Batch_Max);
+    CHECK(pop_release(&q, 0, batch) == 1);
+
+    push_read(&q, Io_Class_Log, 1, 0, b, 512, 0);
+    push_op(&q, Io_Class_Log, Io_Write, 0);
+    push_read(&q, Io_Class_Log, 1, 512, b + 512, 512, 0);                   // Not across the write
+    push_op(&q, Io_Class_Log, Io_Write, 0);
+    push_op(&q, Io_Class_Log, Io_Write, 0);
+    for (int i = 0; i < 5; i++) {
+        CHECK(pop_release(&q, 0, batch) == 1);
+    }
+
+    Io_Queue_Init(&q, Starve_ms, 0);                                        // Merging off
+    push_read(&q, Io_Class_Audio, 1, 0, b, 512, 0);
+    push_read(&q, Io_Class_Audio, 1, 512, b + 512, 512, 0);
+    CHECK(pop_release(&q, 0, batch) == 1);
+    CHECK(pop_release(&q, 0, batch) == 1);
+
+    // The pool
+    Io_Queue_Init(&q, Starve_ms, Merge_Max);
+    Io_Request *all[Io_Queue_Depth];
+    for (int i = 0; i < Io_Queue_Depth; i++) {
+        all[i] = Io_Queue_Alloc(&q);
+        CHECK(all[i] != NULL);
+    }
+    CHECK(Io_Queue_Alloc(&q) == NULL);
+    Io_Queue_Release(&q, all[3]);
+    CHECK(Io_Queue_Alloc(&q) == all[3]);
+    for (int i = 0; i < Io_Queue_Depth; i++) {
+        Io_Queue_Release(&q, all[i]);
+    }
+}
+
+/*-------------------- simulation --------------------*/
+
+typedef struct {
+    const char *name;
+    bool classes;
+    bool merge;
+} policy_t;
+
+typedef struct {
+    uint32_t count;
+    uint64_t sum;
+    uint64_t max;
+    uint32_t histogram[1000];                           // 1 ms each
+} waits_t;
+
+typedef struct {
+    waits_t audio;
+    waits_t ui;                                         // Whole art loads
+    waits_t log;
+    uint32_t underruns;
+    uint64_t stalled_us;
+    uint32_t commands;
+} result_t;
+
+static uint64_t rng = 1;
+
+static uint32_t random_below(uint32_t n)
+{
+    rng = rng * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(rng >> 33) % n;
+}
+
+static void wait_add(waits_t *w, uint64_t us)
+{
+    w->count++;
+    w->sum += us;
+    w->max = us > w->max ? us : w->max;
+    w->histogram[us / 1000 < 999 ? us / 1000 : 999]++;
+}
+
+static uint32_t wait_p99_ms(const waits_t *w)
+{
+    uint32_t seen = 0;
+    for (int i = 0; i < 1000; i++) {
+        seen += w->histogram[i];
+        if ((uint64_t)seen * 100 >= (uint64_t)w->count * 99) {
+            return i + 1;
+        }
+    }
+    return 1000;
+}
+
+static uint64_t service_us(Io_Request **batch, uint32_t n)
+{
+    if (batch[0]->Op == Io_Write) {
+        uint64_t busy = random_below(10) == 0 ? 100000 + random_below(200000) : 5000 + random_below(25000);
+        return Command_us + batch[0]->Bytes * Read_ns_Per_Byte / 1000 + 3000 + busy;
+    }
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        bytes += batch[i]->Bytes;
+    }
+    return Command_us + bytes * Read_ns_Per_Byte / 1000;
+}
+
+#define Never UINT64_MAX
+
+static void simulate(const policy_t *policy, uint64_t end_us, result_t *out)
+{
+    Io_Queue q;
+    Io_Queue_Init(&q, Starve_ms, policy->merge ? Merge_Max : 0);
+    memset(out, 0, sizeof(*out));
+    rng = 1;
+    uint64_t chunk_us = (uint64_t)Chunk_Bytes * 1000000 / Audio_Bytes_Per_s;
+
+    uint64_t audio_issue = 0, audio_need = 0;           // Of the chunk in flight, 0 is the first
+    uint32_t audio_chunk = 0;
+    bool audio_waiting = false;                         // For room in the queue, as submitters block on device
+    uint64_t audio_asked = 0;
+    uint64_t ui_next = UI_Every_us / 2, ui_started = 0;
+    uint32_t ui_left = 0, ui_unqueued = 0;
+    uint32_t ui_offset = 0;
+    uint64_t log_next = Log_Every_us / 3, log_asked = 0;
+    bool log_waiting = false;
+    uint64_t busy_until = Never;
+    Io_Request *running[Io_Queue_Batch_Max];
+    uint32_t running_count = 0;
+    uint64_t t = 0;
+
+    while (t < end_us) {
+        uint64_t next = busy_until;
+        next = audio_issue < next ? audio_issue : next;
+        next = ui_next < next ? ui_next : next;
+        next = log_next < next ? log_next : next;
+        t = next;
+        uint32_t now_ms = t / 1000;
+
+        if (t == busy_until) {
+            for (uint32_t i = 0; i < running_count; i++) {
+                Io_Request *r = running[i];
+                uint64_t waited = t - (uint64_t)(uintptr_t)r->Context;
+                if (r->Fd == 1) {
+                    wait_add(&out->audio, waited);
+                    uint64_t start = t > audio_need ? t : audio_need;
+                    if (audio_chunk && t > audio_need) {
+                        out->underruns++;
+                        out->stalled_us += t - audio_need;
+                    }
+                    // The next chunk is asked for as this one starts to play
+                    audio_chunk++;
+                    audio_issue = start;
+                    audio_need = start + chunk_us;
+                } else if (r->Fd == 2 && --ui_left == 0) {
+                    wait_add(&out->ui, t - ui_started);
+                } else if (r->Fd == 3) {
+                    wait_add(&out->log, waited);
+                }
+                Io_Queue_Release(&q, r);
+            }
+            running_count = 0;
+            busy_until = Never;
+        }
+        if (t == audio_issue) {
+            audio_waiting = true;
+            audio_asked = t;
+            audio_issue = Never;
+        }
+        if (t == ui_next) {
+            if (!ui_left) {
+                ui_started = t;
+                ui_left = ui_unqueued = UI_Chunks;
+            }
+            ui_next += UI_Every_us;
+        }
+        if (t == log_next) {
+            log_waiting = true;
+            log_asked = t;
+            log_next += Log_Every_us;
+        }
+        // Waiting submitters get room by task priority: the player, then the art task, then the logger
+        if (audio_waiting && q.Free) {
+            Io_Request *r = push_read(&q, Io_Class_Audio, 1, audio_chunk * Chunk_Bytes,
+                                      buffers[0] + (audio_chunk & 1) * Chunk_Bytes, Chunk_Bytes, now_ms);
+            r->Context = (void *)(uintptr_t)audio_asked;
+            audio_waiting = false;
+        }
+        while (ui_unqueued && q.Free) {
+            uint32_t i = UI_Chunks - ui_unqueued--;
+            Io_Request *r = push_read(&q, Io_Class_UI, 2, ui_offset + i * Chunk_Bytes, buffers[1] + i * Chunk_Bytes,
+                                      Chunk_Bytes, now_ms);
+            r->Context = (void *)(uintptr_t)ui_started;
+            if (!ui_unqueued) {
+                ui_offset += UI_Chunks * Chunk_Bytes;
+            }
+        }
+        if (log_waiting && q.Free) {
+            Io_Request *r = push_op(&q, Io_Class_Log, Io_Write, now_ms);
+            r->Bytes = Log_Bytes;
+            r->Context = (void *)(uintptr_t)log_asked;
+            log_waiting = false;
+        }
+        if (!policy->classes) {
+            // One FIFO: everything is moved into the audio class in arrival order
+            for (int c = 1; c < Io_Classes; c++) {
+                while (q.Head[c]) {
+                    Io_Request *r = q.Head[c];
+                    q.Head[c] = r->Next;
+                    r->Class = Io_Class_Audio;
+                    uint32_t queued = r->Queued_ms;
+                    Io_Queue_Push(&q, r, queued);
+                }
+                q.Tail[c] = NULL;
+            }
+        }
+        if (busy_until == Never && running_count == 0) {
+            running_count = Io_Queue_Pop(&q, now_ms, running);
+            if (running_count) {
+                busy_until = t + service_us(running, running_count);
+                out->commands++;
+            }
+        }
+    }
+}
+
+static void print_waits(const char *name, const waits_t *w)
+{
+    printf("  %s %5.1f / %3u / %4.0f", name, w->count ? w->sum / 1000.0 / w->count : 0.0, wait_p99_ms(w), w->max / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = 3600;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (seconds < 10) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+
+    checks();
+
+    policy_t policies[] = {
+        { "one FIFO", false, false },
+        { "classes", true, false },
+        { "classes, merged", true, true },
+    };
+    result_t results[3];
+    printf("%.0f s of audio, art loads and log blocks, waits in ms mean / p99 / max:\n", seconds);
+    printf("  %-16s %-22s %-22s %-22s %9s %9s\n", "", "audio read", "UI art load", "log block", "underruns", "commands");
+    for (int p = 0; p < 3; p++) {
+        simulate(&policies[p], (uint64_t)(seconds * 1e6), &results[p]);
+        printf("  %-16s", policies[p].name);
+        print_waits("", &results[p].audio);
+        print_waits("", &results[p].ui);
+        print_waits("", &results[p].log);
+        printf(" %9u %9u\n", results[p].underruns, results[p].commands);
+    }
+    // Classes put audio in front of art loads. Its longest wait stays the longest sync, which nothing preempts
+    printf("audio reads wait behind a sync already running, the read ahead has to cover the longest one\n");
+    CHECK(wait_p99_ms(&results[1].audio) * 2 < wait_p99_ms(&results[0].audio));
+    CHECK(results[1].underruns <= results[0].underruns);
+    // Merging shortens the art loads
+    CHECK(results[2].ui.sum < results[1].ui.sum && results[2].commands < results[1].commands);
+    CHECK(results[2].log.max < (Starve_ms + 2 * 320) * 1000);
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -87,6 +87,7 @@ void Backlight_Init(void)
     ledc_channel_config(&ledc_channel);
     ledc_fade_func_install(0);
     
+    LCD_Backlight = Settings_Get(Setting_Backlight);        // As it was left
     Set_Backlight(LCD_Backlight);      //0~100    
 }
 void Set_Backlight(uint8_t Light)
@@ -16,6 +16,7 @@
 #include "Vernon_ST7789T.h"
 #include "CST328.h"
 #include "LVGL_Driver.h"
+#include "Settings.h"
 // LCD SPI GPIO
 // Using SPI2 
 #define LCD_HOST  SPI3_HOST
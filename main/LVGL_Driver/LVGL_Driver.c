@@ -1,5 +1,7 @@
 #include "LVGL_Driver.h"
 
+#include <string.h>
+
 static const char *TAG_LVGL = "LVGL";
 
 void *buf1 = NULL;
@@ -134,3 +136,56 @@ void LVGL_Init(void)
     ESP_ERROR_CHECK(esp_timer_start_periodic(lvgl_tick_timer, EXAMPLE_LVGL_TICK_PERIOD_MS * 1000));
 
 }
+
+// Frame periods of the current window, LVGL task only
+static uint32_t Frame_Histogram[LVGL_Frame_Buckets];
+static uint32_t Frame_Count = 0;
+static uint64_t Frame_Sum_us = 0;
+static uint32_t Frame_Max_us = 0;
+static int64_t Frame_Last_us = 0;
+static const char *Frame_Window_Name = "idle";
+static const char *volatile Frame_Window_Next = NULL;
+
+static uint32_t Frame_Percentile_ms(uint32_t Percent)
+{
+    uint32_t seen = 0;
+    for (uint32_t ms = 0; ms < LVGL_Frame_Buckets; ms++) {
+        seen += Frame_Histogram[ms];
+        if (seen * 100 >= Frame_Count * Percent) {
+            return ms + 1;
+        }
+    }
+    return LVGL_Frame_Buckets;
+}
+
+void LVGL_Frame_Tick(void)
+{
+    int64_t now = esp_timer_get_time();
+    const char *next = Frame_Window_Next;
+    if (next) {
+        Frame_Window_Next = NULL;
+        if (Frame_Count) {
+            ESP_LOGI(TAG_LVGL, "Frames %s: %lu, period mean %llu us, p50 %lu ms, p99 %lu ms, max %lu us", Frame_Window_Name,
+                     Frame_Count, Frame_Sum_us / Frame_Count, Frame_Percentile_ms(50), Frame_Percentile_ms(99), Frame_Max_us);
+        }
+        memset(Frame_Histogram, 0, sizeof(Frame_Histogram));
+        Frame_Count = 0;
+        Frame_Sum_us = 0;
+        Frame_Max_us = 0;
+        Frame_Window_Name = next;
+    }
+    if (Frame_Last_us) {
+        uint32_t period = now - Frame_Last_us;
+        uint32_t bucket = period / 1000;
+        Frame_Histogram[bucket < LVGL_Frame_Buckets ? bucket : LVGL_Frame_Buckets - 1]++;
+        Frame_Count++;
+        Frame_Sum_us += period;
+        Frame_Max_us = period > Frame_Max_us ? period : Frame_Max_us;
+    }
+    Frame_Last_us = now;
+}
+
+void LVGL_Frame_Window(const char *Name)
+{
+    Frame_Window_Next = Name;
+}
@@ -23,4 +23,8 @@ void example_lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
 void example_lvgl_port_update_callback(lv_disp_drv_t *drv);
 void example_increase_lvgl_tick(void *arg);
 
-void LVGL_Init(void);                     // Call this function to initialize the screen (must be called in the main function) !!!!!
\ No newline at end of file
+#define LVGL_Frame_Buckets  100                                                     // Frame period histogram, 1 ms each, the last holds the rest
+
+void LVGL_Init(void);                     // Call this function to initialize the screen (must be called in the main function) !!!!!
+void LVGL_Frame_Tick(void);               // Once per pass of the loop running lv_timer_handler(), times the frames
+void LVGL_Frame_Window(const char *Name); // From any task: logs the frame periods since the last window, then starts one called Name
@@ -3,8 +3,10 @@
 #include "smart_ui_data.h"
 #include "room_ui.h"
 #include "ai_chat_ui.h"
+#include "Voice_Capture.h"
 #include "BAT_Driver.h"
 #include "QMI8658.h"
+#include "SD_MMC.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -58,10 +60,14 @@ static lv_obj_t *system_wifi_label;
 static lv_obj_t *system_fw_label;
 static lv_obj_t *system_power_label;
 static lv_obj_t *system_temp_label;  /* 系统温度标签 */
+static lv_obj_t *system_sd_label;  /* SD卡总线模式标签 */
+static lv_obj_t *sd_bench_btn;
+static lv_obj_t *sd_bench_label;  /* SD卡测速结果标签 */
 static lv_obj_t *backlight_value_label;
 static lv_obj_t *room_status_labels[6];  /* 房间状态标签数组 */
 static lv_obj_t *nav_wifi_text;  /* 导航栏 Wi-Fi 状态文本 */
 static lv_timer_t *ui_refresh_timer;
+static lv_timer_t *wake_word_timer;
 static const char *rooms[] = {"客厅", "主卧", "次卧", "厨房", "书房", "车库"};  // 房间列表
 
 /* UI 刷新互斥锁 - 保护多任务并发访问 LVGL */
@@ -78,10 +84,13 @@ static void create_system_panel(lv_obj_t * parent);
 static void configure_tab(lv_obj_t * tab);
 static lv_obj_t *create_card(lv_obj_t * parent, const char * title, const char * value);
 static void smart_ui_tick_cb(lv_timer_t * timer);
+static void refresh_sd_label(bool force);
 static void smart_ui_refresh_callback(void);  /* 数据更新时的无参数回调 */
 static void backlight_slider_event(lv_event_t * e);
 static void room_btn_event(lv_event_t * e);
 static void ai_chat_btn_event(lv_event_t * e);
+static void wake_word_timer_cb(lv_timer_t * timer);
+static void sd_bench_btn_event(lv_event_t * e);
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -131,11 +140,18 @@ void smart_ui_main(void)
     }
     /* 定时器用于定期检查数据更新 */
     ui_refresh_timer = lv_timer_create(smart_ui_tick_cb, 500, NULL);
+
+    /* 唤醒词在任何界面下都可以打开AI聊天 */
+    if (!wake_word_timer) {
+        wake_word_timer = lv_timer_create(wake_word_timer_cb, 50, NULL);
+    }
 }
 
 void LVGL_Backlight_adjustment(uint8_t brightness)
 {
     Set_Backlight(brightness);
+    LCD_Backlight = brightness;
+    Settings_Set(Setting_Backlight, brightness);            // 拖动时只改内存，停下后才写入 flash
 }
 
 /**********************
@@ -365,6 +381,29 @@ static void create_system_panel(lv_obj_t * parent)
     lv_obj_add_style(system_temp_label, &style_muted, 0);
     lv_label_set_text(system_temp_label, "温度: 暂无数据");
 
+    system_sd_label = lv_label_create(panel);
+    lv_obj_add_style(system_sd_label, &style_muted, 0);
+    refresh_sd_label(true);
+
+    lv_obj_t *sd_row = lv_obj_create(panel);
+    lv_obj_remove_style_all(sd_row);
+    lv_obj_set_width(sd_row, LV_PCT(100));
+    lv_obj_set_height(sd_row, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(sd_row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(sd_row, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_gap(sd_row, 10, 0);
+
+    sd_bench_btn = lv_btn_create(sd_row);
+    lv_obj_add_event_cb(sd_bench_btn, sd_bench_btn_event, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *sd_bench_btn_label = lv_label_create(sd_bench_btn);
+    lv_label_set_text(sd_bench_btn_label, "测速");
+
+    sd_bench_label = lv_label_create(sd_row);
+    lv_obj_add_style(sd_bench_label, &style_muted, 0);
+    lv_obj_set_flex_grow(sd_bench_label, 1);
+    lv_label_set_long_mode(sd_bench_label, LV_LABEL_LONG_WRAP);
+    lv_label_set_text(sd_bench_label, "点击测速测试SD卡读写速度");
+
     lv_obj_t *slider_row = lv_obj_create(panel);
     lv_obj_remove_style_all(slider_row);
     lv_obj_set_width(slider_row, LV_PCT(100));
@@ -417,6 +456,31 @@ static lv_obj_t *create_card(lv_obj_t * parent, const char * title, const char *
  * 刷新所有UI元素
  * 从数据层读取数据并更新UI显示
  */
+/**
+ * SD卡标签，卡被拔出或重新挂载后总线模式会变，只在变化时重设文字
+ */
+static void refresh_sd_label(bool force)
+{
+    static SD_Bus_Mode shown_mode;
+    static uint32_t shown_size;
+
+    if (!system_sd_label) {
+        return;
+    }
+    if (!force && shown_mode.Width == SD_Mode.Width && shown_mode.Freq_kHz == SD_Mode.Freq_kHz &&
+        shown_mode.DDR == SD_Mode.DDR && shown_size == SDCard_Size) {
+        return;
+    }
+    shown_mode = SD_Mode;
+    shown_size = SDCard_Size;
+    if (shown_mode.Width) {
+        lv_label_set_text_fmt(system_sd_label, "SD卡: %d线 %lu MHz%s, %lu MB",
+                              shown_mode.Width, shown_mode.Freq_kHz / 1000, shown_mode.DDR ? " DDR" : "", shown_size);
+    } else {
+        lv_label_set_text(system_sd_label, "SD卡: 未检测到");
+    }
+}
+
 static void refresh_all_ui_elements(void)
 {
     char buf[128];  /* 增加缓冲区大小以避免截断 */
@@ -508,6 +572,21 @@ static void refresh_all_ui_elements(void)
             lv_label_set_text(system_temp_label, "温度: 暂无数据");
         }
     }
+
+    refresh_sd_label(false);
+
+    /* SD卡测速在后台任务中运行，这里取回结果 */
+    SD_Bench_Result bench;
+    if (sd_bench_label && SD_Benchmark_Take(&bench)) {
+        if (bench.Result == ESP_OK) {
+            snprintf(buf, sizeof(buf), "顺序写 %.0f KB/s  读 %.0f KB/s\n随机写 %.0f IOPS  读 %.0f IOPS",
+                     bench.Seq_Write_KBps, bench.Seq_Read_KBps, bench.Random_Write_IOPS, bench.Random_Read_IOPS);
+            lv_label_set_text(sd_bench_label, buf);
+        } else {
+            lv_label_set_text_fmt(sd_bench_label, "测速失败: %s", esp_err_to_name(bench.Result));
+        }
+        lv_obj_clear_state(sd_bench_btn, LV_STATE_DISABLED);
+    }
     
     /* 更新房间设备状态 */
     for (uint8_t i = 0; i < 6; i++) {
@@ -614,5 +693,34 @@ static void ai_chat_btn_event(lv_event_t * e)
     ai_chat_ui_create(NULL);
 }
 
+/**
+ * SD卡测速按钮点击事件处理
+ * 测速需要数秒，放到后台任务中运行，结果由定时刷新取回
+ */
+static void sd_bench_btn_event(lv_event_t * e)
+{
+    LV_UNUSED(e);
+
+    if (!SD_Mode.Width) {
+        lv_label_set_text(sd_bench_label, "未检测到SD卡");
+        return;
+    }
+    lv_obj_add_state(sd_bench_btn, LV_STATE_DISABLED);
+    lv_label_set_text(sd_bench_label, "测速中...");
+    SD_Benchmark_Start();
+}
+
+/**
+ * 唤醒词检测 - 听到唤醒词后打开AI聊天界面并开始监听
+ */
+static void wake_word_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+
+    if (Voice_Capture_Take_Wake()) {
+        ai_chat_ui_wake();
+    }
+}
+
 
 
@@ -1,7 +1,4 @@
 #include "LVGL_Music.h"
-#include <demos/music/assets/spectrum_1.h>
-#include <demos/music/assets/spectrum_2.h>
-#include <demos/music/assets/spectrum_3.h>
 /*********************
  *      DEFINES
  *********************/
@@ -21,6 +18,8 @@
 #define DEG_STEP            (180/BAR_CNT)
 #define BAND_CNT            4
 #define BAR_PER_BAND_CNT    (BAR_CNT / BAND_CNT)
+#define SPECTRUM_BAR_H      70                                  // 频谱柱最大高度，画在专辑封面后面
+#define MUSIC_LIST_MAX      100                                 // LVGL 堆放不下上千个按钮，列表只列前 100 首，上一首/下一首遍历全部
 
 
 /**********************
@@ -42,16 +41,16 @@ static const lv_font_t * font_large;
 static bool Playing_Flag;                                     
 static uint32_t track_id;
 static lv_obj_t * play_obj;
-static const uint16_t (* spectrum)[4];
-static uint32_t spectrum_len;
+static lv_obj_t * progress_slider;                              // 播放进度，单位秒
+static lv_obj_t * time_label;
+static uint8_t spectrum_bands[Spectrum_Band_Count];            // 实时频谱，由音频任务分析得到
 
 lv_obj_t * Music_img;
 
 
-char SD_Name[100][100] ;    
-char File_Name[100][100] ;     
-char Audio_Name[100] ;         
-uint16_t ACTIVE_TRACK_CNT;      
+static const Media_Index * library;                             // 媒体库索引，曲目按路径排序
+static char track_path[Media_Path_Max];                         // 当前曲目相对 /sdcard 的路径，索引更新后据此找回
+uint32_t ACTIVE_TRACK_CNT;      
 uint16_t Audio_energy;         
 
 static lv_obj_t * list;
@@ -61,6 +60,8 @@ static lv_style_t style_btn_play;
 static lv_style_t style_btn_stop;
 static lv_style_t style_title;
 static bool first_Flag = false;
+static void set_track_name(lv_obj_t * label, uint32_t id);
+static void library_update(const Media_Index * updated);
 LV_IMG_DECLARE(img_lv_demo_music_btn_list_play);
 LV_IMG_DECLARE(img_lv_demo_music_btn_list_pause);
 
@@ -152,6 +153,7 @@ lv_obj_t * _lv_demo_music_main_create(lv_obj_t * parent)
 
 
     lv_timer_create(timer_cb, 100, NULL);
+    lv_timer_create(spectrum_timer_cb, 1000 / Spectrum_Update_Rate, NULL);     // 与分析频率一致
 
 
     lv_obj_fade_in(title_box, 500, INTRO_TIME - 1000);
@@ -187,7 +189,8 @@ lv_obj_t * create_title_box(lv_obj_t * parent)
   title_label = lv_label_create(cont);                                                            
   lv_obj_set_style_text_font(title_label, font_large, 0);                                                        
   lv_obj_set_style_text_color(title_label, lv_color_hex(0x504d6d), 0);                            
-  lv_label_set_text(title_label, Audio_Name);                                                    
+  if(ACTIVE_TRACK_CNT) set_track_name(title_label, track_id);
+  else lv_label_set_text(title_label, "");
   lv_obj_set_height(title_label, lv_font_get_line_height(font_large) );                         
   return cont;
 }
@@ -286,10 +289,57 @@ lv_obj_t * create_spectrum_obj(lv_obj_t * parent)
   lv_obj_set_height(obj, 250);                                                                  
   lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);                            
   lv_obj_refresh_ext_draw_size(obj);                                                              
+  lv_obj_add_event_cb(obj, spectrum_draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);                   
   album_img_obj = album_img_create(obj);                                                         
   return obj;
 }
 
+static void spectrum_bar_area(lv_obj_t * obj, uint32_t band, lv_area_t * area)
+{
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  lv_coord_t bar_w = lv_area_get_width(&coords) / Spectrum_Band_Count;
+  area->x1 = coords.x1 + band * bar_w + 1;
+  area->x2 = area->x1 + bar_w - 3;
+  area->y2 = coords.y2;
+  area->y1 = coords.y2 - SPECTRUM_BAR_H;
+}
+
+void spectrum_draw_event_cb(lv_event_t * e)
+{
+  lv_obj_t * obj = lv_event_get_target(e);
+  lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+  lv_draw_rect_dsc_t dsc;
+  lv_draw_rect_dsc_init(&dsc);
+  dsc.bg_color = BAR_COLOR2;
+  dsc.bg_opa = LV_OPA_40 + (uint32_t)Audio_energy * (LV_OPA_COVER - LV_OPA_40) / INT16_MAX;   // 越响越亮
+  dsc.radius = 2;
+
+  for(uint32_t b = 0; b < Spectrum_Band_Count; b++) {
+    lv_area_t area;
+    spectrum_bar_area(obj, b, &area);
+    area.y1 = area.y2 - LV_MAX(2, spectrum_bands[b] * SPECTRUM_BAR_H / Spectrum_Level_MAX);
+    lv_draw_rect(draw_ctx, &dsc, &area);
+  }
+}
+
+void spectrum_timer_cb(lv_timer_t * t)
+{
+  LV_UNUSED(t);
+  uint8_t bands[Spectrum_Band_Count];
+  Music_Spectrum(bands);
+  Audio_energy = Music_Energy();
+  if(memcmp(bands, spectrum_bands, sizeof(bands)) == 0) return;            // 静音或暂停时不重绘
+  memcpy(spectrum_bands, bands, sizeof(bands));
+
+  lv_area_t area, last;
+  spectrum_bar_area(spectrum_obj, 0, &area);
+  spectrum_bar_area(spectrum_obj, Spectrum_Band_Count - 1, &last);
+  area.x2 = last.x2;
+  lv_obj_invalidate_area(spectrum_obj, &area);                              // 只刷新频谱区域
+}
+
 lv_anim_t Music_img_animation;
 uint16_t Music_img_angle = 0;
 static void set_angle(void* img, int32_t v)
@@ -319,24 +369,11 @@ void Stop_animation() {
 }
 lv_obj_t * album_img_create(lv_obj_t * parent)
 {
-  LV_IMG_DECLARE(img_lv_demo_music_cover_1);                                  
-  LV_IMG_DECLARE(img_lv_demo_music_cover_2);                                  
-  LV_IMG_DECLARE(img_lv_demo_music_cover_3);                                  
+  static const char * covers[] = {"covers/cover_1.bin", "covers/cover_2.bin", "covers/cover_3.bin"};  // 在资源分区中，不占应用空间
 
   Music_img = lv_img_create(parent);                                                
-  switch(track_id % 3) {                                                     
-    case 2:                                                                   
-      lv_img_set_src(Music_img, &img_lv_demo_music_cover_3);                        
-      break;                                                                  
-    case 1:                                                                   
-      lv_img_set_src(Music_img, &img_lv_demo_music_cover_2);                        
-      break;                                                                  
-    case 0:                                                                   
-      lv_img_set_src(Music_img, &img_lv_demo_music_cover_1);                        
-      break;                                                                  
-  }  
-  spectrum = spectrum_3;                                                      
-  spectrum_len = sizeof(spectrum_3) / sizeof(spectrum_3[0]);                  
+  const lv_img_dsc_t * cover = Asset_Store_Image(covers[track_id % 3]);
+  if(cover) lv_img_set_src(Music_img, cover);                                       // 未烧录资源分区时不显示默认封面
   lv_img_set_antialias(Music_img, true);                                            
   lv_obj_align(Music_img, LV_ALIGN_CENTER, 0, 0);                                   
   lv_obj_add_event_cb(Music_img, album_gesture_event_cb, LV_EVENT_GESTURE, NULL);   
@@ -429,6 +466,18 @@ lv_obj_t * create_ctrl_box(lv_obj_t * parent)
   lv_obj_set_grid_cell(icon4, LV_GRID_ALIGN_CENTER, 7, 1, LV_GRID_ALIGN_CENTER, 0, 1);             
   lv_obj_add_event_cb(icon4, next_click_event_cb, LV_EVENT_CLICKED, NULL);                         
   lv_obj_add_flag(icon4, LV_OBJ_FLAG_CLICKABLE);                                                  
+
+  lv_obj_set_style_pad_row(cont, 10, 0);
+  progress_slider = lv_slider_create(cont);                                  // 拖动进度条，松手后跳转
+  lv_obj_set_height(progress_slider, 6);
+  lv_slider_set_range(progress_slider, 0, 1);
+  lv_obj_set_grid_cell(progress_slider, LV_GRID_ALIGN_STRETCH, 1, 7, LV_GRID_ALIGN_CENTER, 1, 1);
+  lv_obj_add_event_cb(progress_slider, progress_event_cb, LV_EVENT_RELEASED, NULL);
+
+  time_label = lv_label_create(cont);
+  lv_obj_set_style_text_font(time_label, font_small, 0);
+  lv_label_set_text(time_label, "0:00/0:00");
+  lv_obj_set_grid_cell(time_label, LV_GRID_ALIGN_CENTER, 9, 1, LV_GRID_ALIGN_CENTER, 1, 1);
           
 
   return cont;
@@ -449,7 +498,7 @@ void track_load(uint32_t id)
   }
   _lv_demo_music_list_btn_check(id, true);                                  
   first_Flag = true;                                                        
-  lv_label_set_text(title_label, Audio_Name);                               
+  set_track_name(title_label, id);
                                                                             
   lv_anim_t a;                                                              
   lv_anim_init(&a);                                                         
@@ -522,13 +571,42 @@ void next_click_event_cb(lv_event_t * e)
     _lv_demo_music_album_next(true);                                          
   }
 }
+void progress_event_cb(lv_event_t * e)
+{
+  Music_Seek(lv_slider_get_value(lv_event_get_target(e)));                  // 松手位置即目标秒数
+}
 void timer_cb(lv_timer_t * t)
 {
   LV_UNUSED(t);                                                             
+  const Media_Index * updated;
+  if(Media_Library_Take(&updated)) {                                        // 后台重新扫描后曲目有增删
+    library_update(updated);
+  }
+
   if(Music_Next_Flag){
     Music_Next_Flag = 0;                                      
     _lv_demo_music_album_next(true);  
   }                 
+
+  const lv_img_dsc_t * art;
+  if(Album_Art_Take(&art) && art) {                                         // 曲目自带封面时替换默认封面
+    lv_img_cache_invalidate_src(art);                                       // 封面缓冲轮换复用，丢弃旧的缓存
+    lv_img_set_src(album_img_obj, art);
+  }
+
+  static uint32_t last_elapsed = UINT32_MAX;
+  static uint32_t last_duration = UINT32_MAX;
+  uint32_t duration = Music_Duration();                                     // 索引完成前为 0
+  uint32_t elapsed = Music_Elapsed();
+  if(duration && elapsed > duration) elapsed = duration;
+  if(elapsed == last_elapsed && duration == last_duration) return;          // 每秒才变化一次，避免无谓重绘
+  if(lv_obj_has_state(progress_slider, LV_STATE_PRESSED)) return;           // 拖动中不覆盖用户位置
+  last_elapsed = elapsed;
+  last_duration = duration;
+
+  lv_slider_set_range(progress_slider, 0, duration ? duration : 1);
+  lv_slider_set_value(progress_slider, elapsed, LV_ANIM_OFF);
+  lv_label_set_text_fmt(time_label, "%lu:%02lu/%lu:%02lu", elapsed / 60, elapsed % 60, duration / 60, duration % 60);
 }
 static lv_obj_t * panel;
 static lv_obj_t * slider;        
@@ -648,7 +726,7 @@ lv_obj_t * create_List_box(lv_obj_t * parent)
   lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
 
   uint32_t List_id;
-  for(List_id = 0; List_id < ACTIVE_TRACK_CNT; List_id++) {                 
+  for(List_id = 0; List_id < ACTIVE_TRACK_CNT && List_id < MUSIC_LIST_MAX; List_id++) {
       add_list_btn(list,  List_id);                                         
   }
   lv_obj_set_scroll_snap_y(list, LV_SCROLL_SNAP_CENTER);                    
@@ -673,7 +751,7 @@ lv_obj_t * add_list_btn(lv_obj_t * parent, uint32_t List_id)
   lv_obj_set_grid_cell(icon, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_CENTER, 0, 2);  
 
   lv_obj_t * title_label = lv_label_create(btn);                           
-  lv_label_set_text(title_label, File_Name[List_id]);                       
+  set_track_name(title_label, List_id);
   lv_obj_set_grid_cell(title_label, LV_GRID_ALIGN_START, 1, 1, LV_GRID_ALIGN_CENTER, 0, 1);
   lv_obj_add_style(title_label, &style_title, 0);
                     
@@ -683,6 +761,7 @@ lv_obj_t * add_list_btn(lv_obj_t * parent, uint32_t List_id)
 void _lv_demo_music_list_btn_check(uint32_t List_id, bool state)
 {
   lv_obj_t * btn = lv_obj_get_child(list, List_id);                           
+  if(btn == NULL) return;                                                   // 超出 MUSIC_LIST_MAX 的曲目不在列表里
   lv_obj_t * icon = lv_obj_get_child(btn, 0);                                
 
   if(state) {
@@ -721,6 +800,7 @@ void _lv_demo_music_main_close(void)
 
 void _lv_demo_music_album_next(bool next)
 {
+  if(ACTIVE_TRACK_CNT == 0) return;                               // 索引更新后卡上已没有曲目
   uint32_t id = track_id;
   if(next) {                                                                         
     id++;                                                         
@@ -777,26 +857,53 @@ void _lv_demo_music_pause(void)
  *  Other         *  Other         *  Other         *  Other                   
 ************************************************************************************************************************************/
 
-void remove_file_extension(char *file_name) {
-  char *last_dot = strrchr(file_name, '.');
-  if (last_dot != NULL) {
-    *last_dot = '\0'; 
+/* 有标签时用标题，否则用去掉目录和扩展名的文件名。直接用索引里扫描时存入 String_Arena 的字符串，名字多长都不截断 */
+static void set_track_name(lv_obj_t * label, uint32_t id)
+{
+  const Media_Track * track = &library->Tracks[id];
+  const char * title = Media_Index_String(library, track->Title);
+  if(title[0]) {
+    lv_label_set_text(label, title);
+    return;
   }
+  const char * path = Media_Index_String(library, track->Path);
+  const char * name = strrchr(path, '/');
+  name = name ? name + 1 : path;
+  const char * dot = strrchr(name, '.');
+  lv_label_set_text_fmt(label, "%.*s", (int)(dot ? dot - name : strlen(name)), name);
 }
+
+/* 换用后台扫描出的新索引：重建列表，按路径找回正在播放的曲目 */
+static void library_update(const Media_Index * updated)
+{
+  const Media_Track * current = Media_Index_Find(updated, track_path);
+  library = updated;
+  ACTIVE_TRACK_CNT = library->Count;
+  track_id = current ? (uint32_t)(current - library->Tracks) : 0;
+
+  lv_obj_clean(list);
+  for(uint32_t List_id = 0; List_id < ACTIVE_TRACK_CNT && List_id < MUSIC_LIST_MAX; List_id++) {
+    add_list_btn(list, List_id);
+  }
+  if(ACTIVE_TRACK_CNT) {
+    _lv_demo_music_list_btn_check(track_id, true);
+  }
+}
+
 void LVGL_Search_Music() {        
-  ACTIVE_TRACK_CNT = Folder_retrieval("/sdcard",".mp3",SD_Name,100);
+  Media_Library_Take(&library);                                   // 启动时读入保存的索引，首次使用时由后台扫描建立
+  ACTIVE_TRACK_CNT = library ? library->Count : 0;
   if(ACTIVE_TRACK_CNT) {  
-    for (int i = 0; i < ACTIVE_TRACK_CNT; i++) {
-      strcpy(File_Name[i], SD_Name[i]);
-      remove_file_extension(File_Name[i]); 
-    }                
     LVGL_Play_Music(0);    
   }                                                             
 }
 void LVGL_Play_Music(uint32_t ID) {
-  Play_Music("/sdcard",SD_Name[ID]);
+  static char path[Media_Path_Max];                               // 主任务栈只有 3.5 KB
+  snprintf(track_path, sizeof(track_path), "%s", Media_Index_String(library, library->Tracks[ID].Path));
+  Play_Music(Media_Library_Root, track_path);
+  snprintf(path, sizeof(path), "%s/%s", Media_Library_Root, track_path);
+  Album_Art_Request(path);                                        // 后台读取封面，完成后在 timer_cb 中显示
   LVGL_Pause_Music();
-  strncpy(Audio_Name,File_Name[ID], sizeof(File_Name[ID]));       
 }
 
 void LVGL_Resume_Music() {
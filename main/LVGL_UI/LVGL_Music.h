@@ -13,12 +13,15 @@
 
 #include "SD_MMC.h"
 #include "PCM5101.h"
+#include "Album_Art.h"
+#include "Asset_Store.h"
+#include "Media_Library.h"
 
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
 
-extern uint16_t ACTIVE_TRACK_CNT;   
+extern uint32_t ACTIVE_TRACK_CNT;   
 /*
  * Callback adapter function to convert parameter types to avoid compile-time
  * warning. 
@@ -57,6 +60,9 @@ void album_gesture_event_cb(lv_event_t * e);
 void play_event_click_cb(lv_event_t * e);
 void prev_click_event_cb(lv_event_t * e);
 void next_click_event_cb(lv_event_t * e);
+void progress_event_cb(lv_event_t * e);
+void spectrum_draw_event_cb(lv_event_t * e);
+void spectrum_timer_cb(lv_timer_t * t);
 void volume_event_cb(lv_event_t * e);
 
 void album_fade_anim_cb(void * var, int32_t v);
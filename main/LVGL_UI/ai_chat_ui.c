@@ -1,5 +1,7 @@
 #include "ai_chat_ui.h"
 #include "my_font.h"
+#include "Voice_Capture.h"
+#include "Voice_Stream.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -29,6 +31,8 @@ static lv_obj_t *voice_state_label = NULL;
 
 /* 语音状态 */
 static ai_voice_state_t current_voice_state = AI_VOICE_IDLE;
+/* 语音活动检测事件轮询定时器 */
+static lv_timer_t *voice_event_timer = NULL;
 
 /* 语音事件回调函数 */
 static ai_voice_start_callback_t voice_start_callback = NULL;
@@ -115,7 +119,13 @@ static void ai_chat_ui_cleanup(void)
     if (voice_cleanup_callback && current_voice_state != AI_VOICE_IDLE) {
         voice_cleanup_callback();
     }
+    Voice_Stream_Abort();  /* 停止正在播放的回复 */
     
+    if (voice_event_timer) {
+        lv_timer_del(voice_event_timer);
+        voice_event_timer = NULL;
+    }
+
     /* 重置所有状态 */
     message_list = NULL;
     voice_btn = NULL;
@@ -135,6 +145,37 @@ static void chat_back_btn_event(lv_event_t *e)
     }
 }
 
+/**
+ * 语音活动检测事件 - 说话结束后自动停止监听，与再次点击按钮相同
+ * 回复播放事件 - 第一段声音播出时进入播放状态，播完回到空闲
+ */
+static void voice_event_timer_cb(lv_timer_t *t)
+{
+    Voice_Activity_Event event;
+    while (Voice_Capture_Take_Event(&event)) {
+        if (current_voice_state != AI_VOICE_LISTENING) {
+            continue;  /* 已手动停止 */
+        }
+        if (event == Voice_Activity_Speech_Start) {
+            ai_chat_ui_set_voice_state(AI_VOICE_LISTENING);
+        } else if (event == Voice_Activity_Speech_End) {
+            ai_chat_ui_set_voice_state(AI_VOICE_PROCESSING);
+            if (voice_stop_callback) {
+                voice_stop_callback();  /* 调用停止回调 */
+            }
+        }
+    }
+
+    Voice_Stream_Event stream_event;
+    while (Voice_Stream_Take_Event(&stream_event)) {
+        if (stream_event == Voice_Stream_Speaking) {
+            ai_chat_ui_set_voice_state(AI_VOICE_SPEAKING);
+        } else if (stream_event == Voice_Stream_Finished && current_voice_state == AI_VOICE_SPEAKING) {
+            ai_chat_ui_set_voice_state(AI_VOICE_IDLE);
+        }
+    }
+}
+
 /**
  * 语音按钮事件处理
  */
@@ -315,6 +356,11 @@ lv_obj_t *ai_chat_ui_create(lv_obj_t *parent)
     /* 创建语音区域 */
     ai_chat_ui_create_voice_area(chat_screen);
 
+    /* 轮询语音活动检测事件 */
+    if (!voice_event_timer) {
+        voice_event_timer = lv_timer_create(voice_event_timer_cb, 50, NULL);
+    }
+
     return chat_screen;
 }
 
@@ -415,6 +461,20 @@ void ai_chat_ui_set_voice_state(ai_voice_state_t state)
     }
 }
 
+/**
+ * 唤醒词触发
+ */
+void ai_chat_ui_wake(void)
+{
+    if (!message_list) {
+        ai_chat_ui_create(NULL);  /* 界面未打开时先打开 */
+    }
+    if (current_voice_state == AI_VOICE_SPEAKING) {
+        Voice_Stream_Abort();  /* 打断正在播放的回复 */
+    }
+    ai_chat_ui_set_voice_state(AI_VOICE_LISTENING);  /* 采集已随唤醒词开始，不再调用开始回调 */
+}
+
 /**
  * 获取当前语音状态
  */
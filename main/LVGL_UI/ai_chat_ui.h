@@ -80,6 +80,13 @@ void ai_chat_ui_register_voice_cleanup_callback(ai_voice_cleanup_callback_t call
  */
 void ai_chat_ui_set_voice_state(ai_voice_state_t state);
 
+/**
+ * 唤醒词触发
+ * 打开AI聊天界面（如未打开）并进入监听状态，正在播放的回复会被打断
+ * 采集已由唤醒词检测开始，不会再调用开始回调
+ */
+void ai_chat_ui_wake(void);
+
 /**
  * 获取当前语音状态
  * 
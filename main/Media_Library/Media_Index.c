@@ -0,0 +1,393 @@
+#include "Media_Index.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mp3_index.h"
+#include "mp3_metadata.h"
+#include "String_Arena.h"
+
+#define Tracks_Grow             256
+#define Strings_Initial         (16 * 1024)
+#define Found_Initial           (8 * 1024)
+
+// Buffers are plain malloc(), with SPIRAM_USE_MALLOC anything this large lands in PSRAM
+typedef struct {
+    const Media_Index *Previous;
+    Media_Scan_Stats *Stats;
+    esp_err_t Error;
+    size_t Root_Length;
+    char Path[Media_Path_Max];                              // The directory or track being looked at
+
+    Media_Track *Tracks;
+    uint32_t Count;
+    uint32_t Capacity;
+    String_Arena Strings;                                   // Artist and album interned, many tracks share them
+    String_Arena Found;                                     // Paths the listing handed over, relative to the root
+    uint32_t Found_Count;
+
+    mp3_metadata_t Tags;
+    mp3_index_t Frames;
+} Scan_State;
+
+typedef struct {
+    const char *Path;
+    Media_Track Track;
+} Sort_Entry;
+
+static uint32_t Checksum(const uint8_t *Data, size_t Bytes)
+{
+    uint32_t hash = 2166136261u;
+    while (Bytes--) {
+        hash ^= *Data++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t Add_String(Scan_State *State, const char *Text)
+{
+    String_Handle handle = String_Arena_Add(&State->Strings, Text);
+    if (handle == String_Arena_None) {
+        State->Error = ESP_ERR_NO_MEM;
+        return String_Arena_Empty;
+    }
+    return handle;
+}
+
+static uint32_t Add_Shared(Scan_State *State, const char *Text)
+{
+    String_Handle handle = String_Arena_Intern(&State->Strings, Text);
+    if (handle == String_Arena_None) {
+        State->Error = ESP_ERR_NO_MEM;
+        return String_Arena_Empty;
+    }
+    return handle;
+}
+
+// Tags and duration from the ID3 tags and the first frame, the file is never walked
+static void Parse(Scan_State *State, Media_Track *Track)
+{
+    memset(&State->Tags, 0, sizeof(State->Tags));
+    FILE *fp = fopen(State->Path, "rb");
+    if (fp) {
+        if (!mp3_metadata_read(fp, &State->Tags)) {
+            memset(&State->Tags, 0, sizeof(State->Tags));
+        }
+        if (mp3_index_build_from_header(fp, &State->Frames) == ESP_OK) {
+            Track->Duration_ms = State->Frames.duration_ms;
+        }
+        fclose(fp);
+    }
+    Track->Title = Add_String(State, State->Tags.title);
+    Track->Artist = Add_Shared(State, State->Tags.artist);
+    Track->Album = Add_Shared(State, State->Tags.album);
+}
+
+static void Add_Track(Scan_State *State)
+{
+    struct stat st;
+    if (stat(State->Path, &st) != 0) {
+        return;
+    }
+    if (State->Count == State->Capacity) {
+        Media_Track *tracks = realloc(State->Tracks, (State->Capacity + Tracks_Grow) * sizeof(Media_Track));
+        if (!tracks) {
+            State->Error = ESP_ERR_NO_MEM;
+            return;
+        }
+        State->Tracks = tracks;
+        State->Capacity += Tracks_Grow;
+    }
+
+    const char *relative = State->Path + State->Root_Length + 1;
+    Media_Track track = {
+        .Path = Add_String(State, relative),
+        .Size = (uint32_t)st.st_size,
+        .Mtime = (uint32_t)st.st_mtime,
+    };
+    const Media_Track *old = State->Previous ? Media_Index_Find(State->Previous, relative) : NULL;
+    if (old && old->Size == track.Size && old->Mtime == track.Mtime) {
+        track.Title = Add_String(State, Media_Index_String(State->Previous, old->Title));
+        track.Artist = Add_Shared(State, Media_Index_String(State->Previous, old->Artist));
+        track.Album = Add_Shared(State, Media_Index_String(State->Previous, old->Album));
+        track.Duration_ms = old->Duration_ms;
+    } else {
+        Parse(State, &track);
+        if (old) {
+            State->Stats->Changed++;
+        } else {
+            State->Stats->Added++;
+        }
+    }
+    State->Tracks[State->Count++] = track;
+}
+
+// Only copies, the listing may run on the I/O task. The tracks are looked at once it is done
+static bool Collect(const Dir_Entry *Entries, uint32_t Count, const Dir_Scan_Stats *Progress, void *Context)
+{
+    Scan_State *state = Context;
+    for (uint32_t i = 0; i < Count; i++) {
+        if (String_Arena_Add(&state->Found, Entries[i].Path) == String_Arena_None) {
+            state->Error = ESP_ERR_NO_MEM;
+            return false;
+        }
+        state->Found_Count++;
+    }
+    return true;
+}
+
+static esp_err_t List_Error(int Error)
+{
+    switch (Error) {
+    case -ENOENT:
+    case -ENOTDIR:
+        return ESP_ERR_NOT_FOUND;
+    case -ENAMETOOLONG:
+    case -EINVAL:
+        return ESP_ERR_INVALID_ARG;
+    case -ENOMEM:
+        return ESP_ERR_NO_MEM;
+    default:
+        return ESP_FAIL;
+    }
+}
+
+static int Compare_Paths(const void *A, const void *B)
+{
+    return strcasecmp(((const Sort_Entry *)A)->Path, ((const Sort_Entry *)B)->Path);
+}
+
+// Sorted into one buffer laid out as the file is, so saving it is one write
+static esp_err_t Finish(Scan_State *State, Media_Index *Index)
+{
+    Sort_Entry *sorted = malloc((State->Count ? State->Count : 1) * sizeof(Sort_Entry));
+    if (!sorted) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (uint32_t i = 0; i < State->Count; i++) {
+        sorted[i].Path = String_Arena_Get(&State->Strings, State->Tracks[i].Path);
+        sorted[i].Track = State->Tracks[i];
+    }
+    qsort(sorted, State->Count, sizeof(Sort_Entry), Compare_Paths);
+
+    size_t tracks_bytes = State->Count * sizeof(Media_Track);
+    uint8_t *data = malloc(sizeof(Media_Index_Header) + tracks_bytes + State->Strings.Used);
+    if (!data) {
+        free(sorted);
+        return ESP_ERR_NO_MEM;
+    }
+    Media_Track *tracks = (Media_Track *)(data + sizeof(Media_Index_Header));
+    for (uint32_t i = 0; i < State->Count; i++) {
+        tracks[i] = sorted[i].Track;
+    }
+    free(sorted);
+    memcpy(data + sizeof(Media_Index_Header) + tracks_bytes, State->Strings.Data, State->Strings.Used);
+
+    Media_Index_Header header = {
+        .Magic = Media_Index_Magic,
+        .Version = Media_Index_Version,
+        .Track_Size = sizeof(Media_Track),
+        .Count = State->Count,
+        .String_Bytes = State->Strings.Used,
+        .Checksum = Checksum(data + sizeof(Media_Index_Header), tracks_bytes + State->Strings.Used),
+    };
+    memcpy(data, &header, sizeof(header));
+
+    Index->Data = data;
+    Index->Tracks = tracks;
+    Index->Strings = (const char *)tracks + tracks_bytes;
+    Index->Count = State->Count;
+    Index->String_Bytes = State->Strings.Used;
+    return ESP_OK;
+}
+
+esp_err_t Media_Index_Scan(const char *Root, Media_Lister Lister, const Media_Index *Previous, Media_Index *Index,
+                           Media_Scan_Stats *Stats)
+{
+    memset(Index, 0, sizeof(*Index));
+    memset(Stats, 0, sizeof(*Stats));
+    size_t root_length = strlen(Root);
+    while (root_length > 1 && Root[root_length - 1] == '/') {
+        root_length--;
+    }
+    if (root_length + 2 > Media_Path_Max) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Scan_State *state = calloc(1, sizeof(Scan_State));
+    if (!state) {
+        return ESP_ERR_NO_MEM;
+    }
+    state->Previous = (Previous && Previous->Count) ? Previous : NULL;
+    state->Stats = Stats;
+    memcpy(state->Path, Root, root_length);
+    state->Root_Length = (root_length == 1 && Root[0] == '/') ? 0 : root_length;    // "/" joins as "/name"
+    if (!String_Arena_Init(&state->Strings, Strings_Initial, Media_Index_Max_Bytes)) {
+        free(state);
+        return ESP_ERR_NO_MEM;
+    }
+    if (!String_Arena_Init(&state->Found, Found_Initial, Media_Index_Max_Bytes)) {
+        String_Arena_Free(&state->Strings);
+        free(state);
+        return ESP_ERR_NO_MEM;
+    }
+
+    Dir_Filter filter = { .Extensions = Media_Track_Extension, .Depth = Media_Depth_Max };
+    Dir_Scan_Stats listed = { 0 };
+    int listed_ret = (Lister ? Lister : Dir_Scan_Run)(Root, &filter, Collect, state, &listed);
+    Stats->Directories = listed.Directories;
+    Stats->Skipped = listed.Skipped;
+    esp_err_t ret = state->Error;
+    if (ret == ESP_OK && listed_ret != 0) {
+        ret = List_Error(listed_ret);
+    }
+    // The paths follow each other after the empty string at offset 0
+    const char *relative = String_Arena_Get(&state->Found, String_Arena_Empty) + 1;
+    for (uint32_t i = 0; ret == ESP_OK && i < state->Found_Count; i++) {
+        size_t length = strlen(relative);
+        state->Path[state->Root_Length] = '/';
+        memcpy(state->Path + state->Root_Length + 1, relative, length + 1);
+        Add_Track(state);
+        ret = state->Error;
+        relative += length + 1;
+    }
+    String_Arena_Free(&state->Found);
+    if (ret == ESP_OK) {
+        ret = Finish(state, Index);
+    }
+    Stats->Tracks = state->Count;
+    Stats->Removed = (state->Previous ? state->Previous->Count : 0) + Stats->Added - state->Count;
+    free(state->Tracks);
+    String_Arena_Free(&state->Strings);
+    free(state);
+    return ret;
+}
+
+static esp_err_t Check(const uint8_t *Data, size_t Bytes, Media_Index *Index)
+{
+    Media_Index_Header header;
+    if (Bytes < sizeof(header)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(&header, Data, sizeof(header));
+    if (header.Magic != Media_Index_Magic || header.Version != Media_Index_Version || header.Track_Size != sizeof(Media_Track)) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (header.Count > Media_Index_Max_Bytes / sizeof(Media_Track) || header.String_Bytes == 0 ||
+        header.String_Bytes > Media_Index_Max_Bytes ||
+        sizeof(header) + header.Count * sizeof(Media_Track) + header.String_Bytes != Bytes) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    size_t tracks_bytes = header.Count * sizeof(Media_Track);
+    if (Checksum(Data + sizeof(header), tracks_bytes + header.String_Bytes) != header.Checksum) {
+        return ESP_ERR_INVALID_CRC;
+    }
+    const Media_Track *tracks = (const Media_Track *)(Data + sizeof(header));
+    const char *strings = (const char *)tracks + tracks_bytes;
+    if (strings[0] != '\0' || strings[header.String_Bytes - 1] != '\0') {
+        return ESP_ERR_INVALID_CRC;
+    }
+    for (uint32_t i = 0; i < header.Count; i++) {
+        const Media_Track *t = &tracks[i];
+        if (t->Path >= header.String_Bytes || t->Title >= header.String_Bytes ||
+            t->Artist >= header.String_Bytes || t->Album >= header.String_Bytes) {
+            return ESP_ERR_INVALID_CRC;
+        }
+    }
+    Index->Tracks = tracks;
+    Index->Strings = strings;
+    Index->Count = header.Count;
+    Index->String_Bytes = header.String_Bytes;
+    return ESP_OK;
+}
+
+esp_err_t Media_Index_Load(const char *File_Path, Media_Index *Index)
+{
+    memset(Index, 0, sizeof(*Index));
+    int fd = open(File_Path, O_RDONLY);
+    if (fd < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    esp_err_t ret;
+    uint8_t *data = NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Media_Index_Header) || st.st_size > Media_Index_Max_Bytes) {
+        ret = ESP_ERR_INVALID_SIZE;
+        goto done;
+    }
+    data = malloc(st.st_size);
+    if (!data) {
+        ret = ESP_ERR_NO_MEM;
+        goto done;
+    }
+    if (read(fd, data, st.st_size) != st.st_size) {
+        ret = ESP_FAIL;
+        goto done;
+    }
+    ret = Check(data, st.st_size, Index);
+    if (ret == ESP_OK) {
+        Index->Data = data;
+        data = NULL;
+    }
+
+done:
+    free(data);
+    close(fd);
+    return ret;
+}
+
+esp_err_t Media_Index_Save(const Media_Index *Index, const char *File_Path)
+{
+    char temp_path[Media_Path_Max + 8];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", File_Path);
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (fd < 0) {
+        return ESP_FAIL;
+    }
+    size_t bytes = sizeof(Media_Index_Header) + Index->Count * sizeof(Media_Track) + Index->String_Bytes;
+    bool ok = write(fd, Index->Data, bytes) == (ssize_t)bytes;
+    ok = (fsync(fd) == 0) && ok;
+    ok = (close(fd) == 0) && ok;
+    // Written aside so a failed write never replaces a good index. FAT rename does not replace, so a power cut
+    // between the two steps loses the index, and the next scan builds it again
+    if (ok) {
+        unlink(File_Path);
+        ok = (rename(temp_path, File_Path) == 0);
+    }
+    if (!ok) {
+        unlink(temp_path);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void Media_Index_Free(Media_Index *Index)
+{
+    free(Index->Data);
+    memset(Index, 0, sizeof(*Index));
+}
+
+const Media_Track *Media_Index_Find(const Media_Index *Index, const char *Path)
+{
+    uint32_t low = 0;
+    uint32_t high = Index->Count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int order = strcasecmp(Path, Index->Strings + Index->Tracks[mid].Path);
+        if (order == 0) {
+            return &Index->Tracks[mid];
+        }
+        if (order < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+// Index of the tracks on the card, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// The saved index is a header, a table of fixed size entries sorted by path and a block of the strings they
+// point into, so loading it is a single read with nothing to parse. A rescan lists the tracks with Dir_Scan and
+// stats every one, but only opens the ones that are new or whose size or modification time changed.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "Dir_Scan.h"
+
+#define Media_Index_Magic           0x3149444D              // "MDI1"
+#define Media_Index_Version         1
+#define Media_Index_Max_Bytes       (4 * 1024 * 1024)       // Larger files are taken as corrupt, about 25000 tracks
+#define Media_Track_Extension       ".mp3"
+#define Media_Path_Max              Dir_Scan_Path_Max       // Root included, the player takes as long
+#define Media_Depth_Max             Dir_Scan_Depth_Max      // Directories below the root that are walked
+
+typedef struct {
+    uint32_t Path;                                          // Offsets into the strings, the path is relative to the root
+    uint32_t Title;                                         // Tags, offset 0 is the empty string
+    uint32_t Artist;
+    uint32_t Album;
+    uint32_t Size;                                          // Of the file when it was parsed, a change parses it again
+    uint32_t Mtime;
+    uint32_t Duration_ms;                                   // 0 if no audio frame was found
+} Media_Track;
+
+typedef struct {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t Track_Size;                                    // sizeof(Media_Track), a layout change is a rebuild
+    uint32_t Count;
+    uint32_t String_Bytes;
+    uint32_t Checksum;                                      // FNV-1a of the tracks and strings
+} Media_Index_Header;
+
+typedef struct {
+    void *Data;                                             // Header, tracks and strings, laid out as in the file
+    const Media_Track *Tracks;                              // Sorted by path, case ignored
+    const char *Strings;
+    uint32_t Count;
+    uint32_t String_Bytes;
+} Media_Index;
+
+typedef struct {
+    uint32_t Directories;
+    uint32_t Tracks;
+    uint32_t Added;                                         // Not in the previous index
+    uint32_t Changed;                                       // Size or modification time differ
+    uint32_t Removed;                                       // In the previous index, gone now
+    uint32_t Skipped;                                       // Path longer than FAT takes or deeper than Media_Depth_Max
+} Media_Scan_Stats;
+
+// Lists the tracks under Root as Dir_Scan_Run() does, which is what NULL takes. The firmware lists through SD_Scan()
+typedef int (*Media_Lister)(const char *Root, const Dir_Filter *Filter, Dir_Batch Batch, void *Context, Dir_Scan_Stats *Stats);
+
+esp_err_t Media_Index_Load(const char *File_Path, Media_Index *Index);  // One read, then checked
+esp_err_t Media_Index_Save(const Media_Index *Index, const char *File_Path);
+esp_err_t Media_Index_Scan(const char *Root, Media_Lister Lister, const Media_Index *Previous, Media_Index *Index,
+                           Media_Scan_Stats *Stats);        // Lister and Previous may be NULL
+void Media_Index_Free(Media_Index *Index);
+const Media_Track *Media_Index_Find(const Media_Index *Index, const char *Path);     // NULL if the path is not indexed
+
+static inline const char *Media_Index_String(const Media_Index *Index, uint32_t Offset)
+{
+    return Index->Strings + Offset;
+}
@@ -0,0 +1,215 @@
+#include "Media_Library.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "File_IO.h"
+#include "LVGL_Driver.h"
+#include "SD_MMC.h"
+
+static const char *TAG = "MEDIA LIBRARY";
+
+// An index is freed once none of these point at it
+static Media_Index *Shown = NULL;                           // Taken by the UI
+static Media_Index *Ready = NULL;                           // Newest, not taken yet
+static Media_Index *Base = NULL;                            // What the running scan compares against
+static SemaphoreHandle_t Library_Mutex;
+static TaskHandle_t Library_Task_Handle;
+static uint32_t Card_Generation = 0;                        // Bumped when the card goes, so a scan of it is dropped
+static bool Load_Requested = false;                         // A card was mounted, start from its saved index
+
+// Library_Mutex held
+static void Release(Media_Index *Index)
+{
+    if (Index && Index != Shown && Index != Ready && Index != Base) {
+        Media_Index_Free(Index);
+        free(Index);
+    }
+}
+
+// On the I/O task, one write of the whole index
+static int32_t Save_Call(void *Context)
+{
+    if (mkdir(Media_Library_Dir, 0775) != 0 && errno != EEXIST) {
+        ESP_LOGW(TAG, "Can't create %s, errno %d", Media_Library_Dir, errno);
+        return ESP_FAIL;
+    }
+    if (Media_Index_Save(Context, Media_Library_File) != ESP_OK) {
+        ESP_LOGW(TAG, "Can't write %s, errno %d", Media_Library_File, errno);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static void Save(Media_Index *Index)
+{
+    int64_t start = esp_timer_get_time();
+    if (File_IO_Call_Wait(Io_Class_Log, Save_Call, Index) == ESP_OK) {
+        ESP_LOGI(TAG, "Saved in %lld ms", (esp_timer_get_time() - start) / 1000);
+    }
+}
+
+// On the I/O task, one read of the whole index
+static int32_t Load_Call(void *Context)
+{
+    return Media_Index_Load(Media_Library_File, Context);
+}
+
+// The saved index of the card, NULL if there is none
+static Media_Index *Load(void)
+{
+    Media_Index *index = calloc(1, sizeof(Media_Index));
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = index ? File_IO_Call_Wait(Io_Class_UI, Load_Call, index) : ESP_ERR_NO_MEM;
+    if (ret != ESP_OK) {
+        ESP_LOGI(TAG, "No saved index (%s), building one", esp_err_to_name(ret));
+        free(index);
+        return NULL;
+    }
+    ESP_LOGI(TAG, "Loaded %lu tracks in %lld ms", index->Count, (esp_timer_get_time() - start) / 1000);
+    return index;
+}
+
+// The listing goes through the I/O task in steps, what the player queues behind it goes in between
+static int List_Card(const char *Root, const Dir_Filter *Filter, Dir_Batch Batch, void *Context, Dir_Scan_Stats *Stats)
+{
+    return SD_Scan(Root, Filter, Io_Class_Log, Batch, Context, Stats);
+}
+
+static void Media_Library_Task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!SD_Mode.Width) {
+            continue;                                       // No card
+        }
+        xSemaphoreTake(Library_Mutex, portMAX_DELAY);
+        bool load = Load_Requested;
+        Load_Requested = false;
+        uint32_t generation = Card_Generation;
+        xSemaphoreGive(Library_Mutex);
+        Media_Index *loaded = load ? Load() : NULL;
+
+        xSemaphoreTake(Library_Mutex, portMAX_DELAY);
+        if (loaded && generation == Card_Generation) {
+            Media_Index *old = Ready;
+            Ready = loaded;
+            Release(old);
+        } else if (loaded) {
+            Release(loaded);
+        }
+        Base = Ready ? Ready : Shown;
+        Media_Index *base = Base;
+        xSemaphoreGive(Library_Mutex);
+
+        Media_Index *index = calloc(1, sizeof(Media_Index));
+        Media_Scan_Stats stats = { 0 };
+        File_IO_Stats io;
+        File_IO_Take_Stats(&io);
+        LVGL_Frame_Window("while scanning");                // What the scan does to the UI and the player
+        int64_t start = esp_timer_get_time();
+        esp_err_t ret = index ? Media_Index_Scan(Media_Library_Root, List_Card, base, index, &stats) : ESP_ERR_NO_MEM;
+        LVGL_Frame_Window("idle");
+        File_IO_Take_Stats(&io);
+        ESP_LOGI(TAG, "I/O while scanning: longest wait %lu ms audio, %lu ms UI, %lu ms log, %lu KB read",
+                 io.Queue.Wait_Max_ms[Io_Class_Audio], io.Queue.Wait_Max_ms[Io_Class_UI],
+                 io.Queue.Wait_Max_ms[Io_Class_Log], io.Read_Bytes / 1024);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Scan failed: %s", esp_err_to_name(ret));
+            free(index);
+            index = NULL;
+        } else {
+            ESP_LOGI(TAG, "Scanned %lu tracks in %lu directories in %lld ms: %lu added, %lu changed, %lu removed, %lu skipped",
+                     stats.Tracks, stats.Directories, (esp_timer_get_time() - start) / 1000,
+                     stats.Added, stats.Changed, stats.Removed, stats.Skipped);
+            if ((base && !stats.Added && !stats.Changed && !stats.Removed) || generation != Card_Generation) {
+                Media_Index_Free(index);                    // Same as the one saved, or of a card that is gone
+                free(index);
+                index = NULL;
+            } else {
+                Save(index);
+            }
+        }
+
+        xSemaphoreTake(Library_Mutex, portMAX_DELAY);
+        if (index && generation != Card_Generation) {
+            Media_Index_Free(index);                        // The card went while it was saved
+            free(index);
+        } else if (index) {
+            Media_Index *old = Ready;
+            Ready = index;
+            Release(old);
+        }
+        Base = NULL;
+        Release(base);
+        xSemaphoreGive(Library_Mutex);
+    }
+}
+
+// On the SD monitor task. A card that goes leaves an empty library, one that comes is loaded and rescanned
+static void Library_Card_Event(Card_Event Event, void *Context)
+{
+    xSemaphoreTake(Library_Mutex, portMAX_DELAY);
+    if (Event == Card_Event_Mounted) {
+        Load_Requested = true;
+        xTaskNotifyGive(Library_Task_Handle);
+    } else if (Event == Card_Event_Lost || Event == Card_Event_Ejecting) {
+        Media_Index *empty = calloc(1, sizeof(Media_Index));
+        Card_Generation++;
+        if (empty) {
+            Media_Index *old = Ready;
+            Ready = empty;
+            Release(old);
+        }
+    }
+    xSemaphoreGive(Library_Mutex);
+}
+
+void Media_Library_Init(void)
+{
+    // Scanning is mostly waiting on the card, keep it below everything else
+    Library_Mutex = xSemaphoreCreateMutex();
+    if (!Library_Mutex ||
+        xTaskCreatePinnedToCore(Media_Library_Task, "Media Library", 6144, NULL, 1, &Library_Task_Handle, 0) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create media library task");
+        Library_Mutex = NULL;
+        return;
+    }
+    SD_Subscribe(Library_Card_Event, NULL);
+    if (!SD_Mode.Width) {
+        return;
+    }
+    Ready = Load();                                         // Here so the UI has it from the start
+    xTaskNotifyGive(Library_Task_Handle);
+}
+
+void Media_Library_Rescan(void)
+{
+    if (Library_Mutex) {
+        xTaskNotifyGive(Library_Task_Handle);
+    }
+}
+
+bool Media_Library_Take(const Media_Index **Index)
+{
+    if (!Library_Mutex) {
+        return false;
+    }
+    bool ready = false;
+    xSemaphoreTake(Library_Mutex, portMAX_DELAY);
+    if (Ready) {
+        Media_Index *old = Shown;
+        Shown = Ready;
+        Ready = NULL;
+        Release(old);
+        *Index = Shown;
+        ready = true;
+    }
+    xSemaphoreGive(Library_Mutex);
+    return ready;
+}
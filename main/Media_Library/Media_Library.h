@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdbool.h>
+#include "Media_Index.h"
+
+#define Media_Library_Root      "/sdcard"
+#define Media_Library_Dir       "/sdcard/.cache"            // Shared with the track indexes and the album art
+#define Media_Library_File      Media_Library_Dir "/library.idx"
+
+void Media_Library_Init(void);                              // Loads the saved index, then rescans in the background
+void Media_Library_Rescan(void);                            // After tracks were copied to the card
+bool Media_Library_Take(const Media_Index **Index);         // True once per new index, frees the one taken before
@@ -0,0 +1,356 @@
+/**
+ * Host bench for the media library index, a directory stands in for the card.
+ *
+ * With -g the directory is first filled with a synthetic library: artist and album
+ * directories of small constant bitrate mp3 files, each with ID3v2 title, artist and
+ * album tags and a frame count that gives every track its own duration. The tags say
+ * which track it is, so every entry of the index can be checked against the file.
+ *
+ * The bench then times, like the library task does on the card:
+ *   - a cold scan with no previous index, every track opened and parsed
+ *   - saving the index, and loading it again (-r times, averaged), then compares it
+ *     byte for byte with the scanned one and checks a corrupted copy is refused
+ *   - a rescan against the loaded index with nothing changed, only stat() per track
+ *   - a rescan after 1% of the tracks were touched, one removed and one added
+ *   - a lookup of every path
+ * The host page cache makes every file system call far cheaper than on the card, so
+ * the opened and stat()ed counts are the figures that carry over, and the times show
+ * what the index itself costs.
+ *
+ * usage: media_bench [-g tracks] [-r loads] root
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+#include "Media_Index.h"
+
+#define USAGE "usage: %s [-g tracks] [-r loads] root\n"
+
+#define TRACKS_PER_ALBUM    10
+#define ALBUMS_PER_ARTIST   5
+#define LONG_NAME_SUFFIX    " (Live at the Royal Albert Hall, Remastered and Extended with the Previously Unreleased Encore)"
+#define FRAME_BYTES         417                     // MPEG-1 layer III, 128 kbps, 44.1 kHz, no padding
+#define SAMPLES_PER_FRAME   1152
+#define SAMPLE_RATE         44100
+
+static uint32_t opened = 0;
+static uint32_t stats_calls = 0;
+
+void host_bench_log(char level, const char *tag, const char *fmt, ...)
+{
+    if (level == 'I' || level == 'D') {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%c %s: ", level, tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+// Counted through the linker, see CMakeLists.txt
+FILE *__real_fopen(const char *path, const char *mode);
+int __real_stat(const char *path, struct stat *st);
+
+FILE *__wrap_fopen(const char *path, const char *mode)
+{
+    opened++;
+    return __real_fopen(path, mode);
+}
+
+int __wrap_stat(const char *path, struct stat *st)
+{
+    stats_calls++;
+    return __real_stat(path, st);
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*-------------------- synthetic library --------------------*/
+
+static uint32_t track_frames(uint32_t track)
+{
+    return 2 + track % 30;
+}
+
+static uint32_t track_duration_ms(uint32_t track)
+{
+    return (uint32_t)((uint64_t)track_frames(track) * SAMPLES_PER_FRAME * 1000 / SAMPLE_RATE);
+}
+
+static void track_path(const char *root, uint32_t track, char *path, size_t size)
+{
+    uint32_t album = track / TRACKS_PER_ALBUM;
+    uint32_t artist = album / ALBUMS_PER_ARTIST;
+    // Every 50th name runs past 100 characters, the old limit of the player, and must still be indexed
+    snprintf(path, size, "%s/Artist %03u/Album %04u/%02u Track %05u%s.mp3", root, artist, album,
+             track % TRACKS_PER_ALBUM + 1, track, track % 50 == 7 ? LONG_NAME_SUFFIX : "");
+}
+
+static void put_text_frame(uint8_t **p, const char *id, const char *text)
+{
+    uint32_t size = strlen(text) + 1;               // encoding byte, ISO-8859-1
+    memcpy(*p, id, 4);
+    uint8_t header[6] = { size >> 24, size >> 16, size >> 8, size, 0, 0 };
+    memcpy(*p + 4, header, 6);
+    (*p)[10] = 0;
+    memcpy(*p + 11, text, size - 1);
+    *p += 10 + size;
+}
+
+static bool write_track(const char *root, uint32_t track)
+{
+    char path[256];
+    track_path(root, track, path, sizeof(path));
+    for (char *slash = strchr(path + strlen(root) + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        if (mkdir(path, 0775) != 0 && errno != EEXIST) {
+            fprintf(stderr, "can't create %s: %s\n", path, strerror(errno));
+            return false;
+        }
+        *slash = '/';
+    }
+
+    char title[32], artist[32], album[32];
+    snprintf(title, sizeof(title), "Track %05u", track);
+    snprintf(artist, sizeof(artist), "Artist %03u", track / TRACKS_PER_ALBUM / ALBUMS_PER_ARTIST);
+    snprintf(album, sizeof(album), "Album %04u", track / TRACKS_PER_ALBUM);
+    uint8_t tag[256];
+    uint8_t *p = tag + 10;
+    put_text_frame(&p, "TIT2", title);
+    put_text_frame(&p, "TPE1", artist);
+    put_text_frame(&p, "TALB", album);
+    uint32_t body = p - tag - 10;
+    uint8_t header[10] = { 'I', 'D', '3', 3, 0, 0, (body >> 21) & 0x7F, (body >> 14) & 0x7F, (body >> 7) & 0x7F, body & 0x7F };
+    memcpy(tag, header, 10);
+
+    FILE *fp = __real_fopen(path, "wb");
+    if (!fp) {
+        fprintf(stderr, "can't write %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    fwrite(tag, 1, p - tag, fp);
+    uint8_t frame[FRAME_BYTES] = { 0xFF, 0xFB, 0x90, 0x00 };
+    for (uint32_t f = 0; f < track_frames(track); f++) {
+        fwrite(frame, 1, sizeof(frame), fp);
+    }
+    return fclose(fp) == 0;
+}
+
+static bool generate(const char *root, uint32_t tracks)
+{
+    if (mkdir(root, 0775) != 0 && errno != EEXIST) {
+        fprintf(stderr, "can't create %s: %s\n", root, strerror(errno));
+        return false;
+    }
+    for (uint32_t t = 0; t < tracks; t++) {
+        if (!write_track(root, t)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*-------------------- checks --------------------*/
+
+// Every entry against what its tags say it is, a generated library has nothing else
+static uint32_t check_index(const Media_Index *index, bool generated)
+{
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < index->Count; i++) {
+        const Media_Track *t = &index->Tracks[i];
+        const char *path = Media_Index_String(index, t->Path);
+        unsigned track;
+        if (sscanf(Media_Index_String(index, t->Title), "Track %05u", &track) != 1) {
+            if (generated && errors++ < 5) {
+                fprintf(stderr, "untagged entry %s\n", path);
+            }
+            continue;
+        }
+        char artist[32], album[32];
+        snprintf(artist, sizeof(artist), "Artist %03u", track / TRACKS_PER_ALBUM / ALBUMS_PER_ARTIST);
+        snprintf(album, sizeof(album), "Album %04u", track / TRACKS_PER_ALBUM);
+        if (strcmp(Media_Index_String(index, t->Artist), artist) || strcmp(Media_Index_String(index, t->Album), album) ||
+            t->Duration_ms != track_duration_ms(track) || Media_Index_Find(index, path) != t ||
+            (i && strcasecmp(Media_Index_String(index, index->Tracks[i - 1].Path), path) >= 0)) {
+            if (errors++ < 5) {
+                fprintf(stderr, "bad entry %s: %s, %s, %u ms\n", path, Media_Index_String(index, t->Artist),
+                        Media_Index_String(index, t->Album), t->Duration_ms);
+            }
+        }
+    }
+    return errors;
+}
+
+static bool scan(const char *label, const char *root, const Media_Index *previous, Media_Index *index, Media_Scan_Stats *stats)
+{
+    opened = 0;
+    stats_calls = 0;
+    double start = now_us();
+    esp_err_t ret = Media_Index_Scan(root, NULL, previous, index, stats);
+    double elapsed = now_us() - start;
+    if (ret != ESP_OK) {
+        fprintf(stderr, "%s scan failed: %d\n", label, ret);
+        return false;
+    }
+    printf("%-10s %6u tracks %4u dirs  %8.1f ms  %6u opened %6u stat  +%u ~%u -%u skipped %u\n", label, stats->Tracks,
+           stats->Directories, elapsed / 1000, opened, stats_calls, stats->Added, stats->Changed, stats->Removed, stats->Skipped);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t generate_tracks = 0;
+    uint32_t loads = 20;
+    int opt;
+    while ((opt = getopt(argc, argv, "g:r:")) != -1) {
+        switch (opt) {
+        case 'g':
+            generate_tracks = strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            loads = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (optind != argc - 1 || loads == 0) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    const char *root = argv[optind];
+    if (generate_tracks) {
+        double start = now_us();
+        if (!generate(root, generate_tracks)) {
+            return 1;
+        }
+        printf("generated %u tracks in %.0f ms\n", generate_tracks, (now_us() - start) / 1000);
+    }
+
+    bool ok = true;
+    char index_path[256];
+    snprintf(index_path, sizeof(index_path), "%s/.library.idx", root);
+
+    Media_Index cold;
+    Media_Scan_Stats stats;
+    if (!scan("cold", root, NULL, &cold, &stats)) {
+        return 1;
+    }
+    uint32_t errors = check_index(&cold, generate_tracks);
+    ok = ok && errors == 0 && (!generate_tracks || (cold.Count == generate_tracks && stats.Skipped == 0));
+
+    double start = now_us();
+    if (Media_Index_Save(&cold, index_path) != ESP_OK) {
+        fprintf(stderr, "save failed: %s\n", strerror(errno));
+        return 1;
+    }
+    double save_ms = (now_us() - start) / 1000;
+    struct stat st;
+    stat(index_path, &st);
+    printf("save       %6.1f ms  %ld bytes, %.1f per track\n", save_ms, (long)st.st_size,
+           cold.Count ? (double)st.st_size / cold.Count : 0.0);
+
+    Media_Index loaded = { 0 };
+    start = now_us();
+    for (uint32_t r = 0; r < loads; r++) {
+        Media_Index_Free(&loaded);
+        if (Media_Index_Load(index_path, &loaded) != ESP_OK) {
+            fprintf(stderr, "load failed\n");
+            return 1;
+        }
+    }
+    double load_ms = (now_us() - start) / 1000 / loads;
+    bool same = loaded.Count == cold.Count && loaded.String_Bytes == cold.String_Bytes &&
+                memcmp(loaded.Data, cold.Data, st.st_size) == 0;
+    ok = ok && same;
+    printf("load       %6.3f ms  mean of %u, %s the scan\n", load_ms, loads, same ? "same as" : "DIFFERS FROM");
+
+    // One flipped byte in the strings must fail the checksum
+    char corrupt_path[300];
+    snprintf(corrupt_path, sizeof(corrupt_path), "%s.corrupt", index_path);
+    uint8_t *bytes = malloc(st.st_size);
+    memcpy(bytes, loaded.Data, st.st_size);
+    bytes[st.st_size - 2] ^= 0x20;
+    FILE *fp = __real_fopen(corrupt_path, "wb");
+    fwrite(bytes, 1, st.st_size, fp);
+    fclose(fp);
+    free(bytes);
+    Media_Index corrupt;
+    esp_err_t corrupt_ret = Media_Index_Load(corrupt_path, &corrupt);
+    unlink(corrupt_path);
+    ok = ok && corrupt_ret == ESP_ERR_INVALID_CRC;
+    printf("corrupt    %s\n", corrupt_ret == ESP_ERR_INVALID_CRC ? "refused" : "ACCEPTED");
+
+    Media_Index warm;
+    if (!scan("unchanged", root, &loaded, &warm, &stats)) {
+        return 1;
+    }
+    ok = ok && stats.Added == 0 && stats.Changed == 0 && stats.Removed == 0 && warm.Count == cold.Count &&
+         memcmp(warm.Data, cold.Data, st.st_size) == 0;
+
+    // Touch 1%, remove one, add one
+    uint32_t tracks = cold.Count;
+    uint32_t touched = 0;
+    uint32_t removed = 0;
+    uint32_t added = 0;
+    if (generate_tracks) {
+        char path[256];
+        for (uint32_t t = 0; t < generate_tracks; t += 100) {
+            track_path(root, t, path, sizeof(path));
+            struct utimbuf times = { .actime = 1000000000, .modtime = 1000000000 };
+            touched += utime(path, &times) == 0;
+        }
+        track_path(root, 1, path, sizeof(path));
+        removed = unlink(path) == 0;
+        added = write_track(root, generate_tracks);
+    }
+    Media_Index changed;
+    if (!scan("changed", root, &warm, &changed, &stats)) {
+        return 1;
+    }
+    errors = check_index(&changed, generate_tracks);
+    ok = ok && errors == 0 && stats.Changed == touched && stats.Added == added && stats.Removed == removed &&
+         changed.Count == tracks - removed + added;
+    if (generate_tracks) {
+        char path[256];
+        track_path(root, 1, path, sizeof(path));
+        write_track(root, 1);                      // Back as generated for the next run
+        track_path(root, generate_tracks, path, sizeof(path));
+        unlink(path);
+    }
+
+    start = now_us();
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < changed.Count; i++) {
+        found += Media_Index_Find(&changed, Media_Index_String(&changed, changed.Tracks[i].Path)) == &changed.Tracks[i];
+    }
+    double find_us = changed.Count ? (now_us() - start) / changed.Count : 0;
+    ok = ok && found == changed.Count;
+    printf("find       %6.2f us  %u of %u found\n", find_us, found, changed.Count);
+
+    unlink(index_path);
+    Media_Index_Free(&cold);
+    Media_Index_Free(&loaded);
+    Media_Index_Free(&warm);
+    Media_Index_Free(&changed);
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
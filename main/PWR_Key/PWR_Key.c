@@ -38,6 +38,8 @@ void Restart(void)
 }
 void Shutdown(void)
 {
+  Set_Backlight(0);                               // Dark at once, the key can be let go
+  Shutdown_Run();                                 // Hooks within Shutdown_Budget_ms, see Shutdown.h
   gpio_set_level(PWR_Control_PIN, false);
   LCD_Backlight = 0;        
 }
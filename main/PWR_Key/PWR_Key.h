@@ -1,5 +1,6 @@
 #pragma once
 #include "ST7789.h"
+#include "Shutdown.h"
 
 #define PWR_KEY_Input_PIN   6
 #define PWR_Control_PIN     7
@@ -0,0 +1,122 @@
+#include "Card_Monitor.h"
+
+#include <string.h>
+
+void Card_Monitor_Init(Card_Monitor *Monitor, const Card_Ops *Ops, void *Context)
+{
+    memset(Monitor, 0, sizeof(*Monitor));
+    Monitor->Ops = Ops;
+    Monitor->Context = Context;
+    Monitor->State = Card_State_Settling;
+    Monitor->Check_Requested = true;
+}
+
+bool Card_Monitor_Subscribe(Card_Monitor *Monitor, Card_Listener Function, void *Context)
+{
+    if (Monitor->Subscriber_Count >= Card_Monitor_Subscribers) {
+        return false;
+    }
+    Monitor->Subscribers[Monitor->Subscriber_Count].Function = Function;
+    Monitor->Subscribers[Monitor->Subscriber_Count].Context = Context;
+    Monitor->Subscriber_Count++;
+    return true;
+}
+
+static void Notify(Card_Monitor *Monitor, Card_Event Event)
+{
+    for (uint8_t i = 0; i < Monitor->Subscriber_Count; i++) {
+        Monitor->Subscribers[i].Function(Event, Monitor->Subscribers[i].Context);
+    }
+}
+
+// Everyone lets go of their files first, the unmount comes after
+static void Remove(Card_Monitor *Monitor, Card_Event Event, Card_State State)
+{
+    Notify(Monitor, Event);
+    Monitor->Ops->Unmount(Monitor->Context);
+    Monitor->State = State;
+    Monitor->Misses = 0;
+    Monitor->Stats.Removals++;
+}
+
+static uint32_t Mount(Card_Monitor *Monitor)
+{
+    Card_Mount_Result result = Monitor->Ops->Mount(Monitor->Context);
+    if (result == Card_Mount_OK) {
+        Monitor->State = Card_State_Mounted;
+        Monitor->Tries = 0;
+        Monitor->Stats.Mounts++;
+        Notify(Monitor, Card_Event_Mounted);
+        return Card_Monitor_Poll_ms;
+    }
+    if (result == Card_Mount_Error) {
+        Monitor->Stats.Mount_Errors++;
+        if (++Monitor->Tries < Card_Monitor_Mount_Tries) {
+            return Card_Monitor_Settle_ms << Monitor->Tries;   // Stays settling, a slow card gets longer each time
+        }
+    }
+    Monitor->State = Card_State_Unusable;
+    Notify(Monitor, Card_Event_Unusable);
+    return Card_Monitor_Poll_ms;
+}
+
+uint32_t Card_Monitor_Poll(Card_Monitor *Monitor, uint32_t Now_ms)
+{
+    bool eject = Monitor->Eject_Requested && Monitor->State == Card_State_Mounted;
+    if (!eject && !Monitor->Check_Requested && (int32_t)(Now_ms - Monitor->Next_ms) < 0) {
+        return Monitor->Next_ms - Now_ms;
+    }
+    Monitor->Check_Requested = false;
+    Monitor->Eject_Requested = false;                       // Nothing to eject in the other states
+
+    uint32_t wait = Card_Monitor_Poll_ms;
+    switch (Monitor->State) {
+    case Card_State_Mounted:
+        if (eject && Monitor->Ops->Alive(Monitor->Context)) {
+            Remove(Monitor, Card_Event_Ejecting, Card_State_Ejected);
+        } else if (eject) {
+            Remove(Monitor, Card_Event_Lost, Card_State_Absent);   // Pulled before it could be ejected
+        } else if (Monitor->Ops->Alive(Monitor->Context)) {
+            Monitor->Stats.Glitches += Monitor->Misses;
+            Monitor->Misses = 0;
+        } else if (++Monitor->Misses >= Card_Monitor_Misses) {
+            Remove(Monitor, Card_Event_Lost, Card_State_Absent);
+        } else {
+            wait = Card_Monitor_Recheck_ms;
+        }
+        break;
+    case Card_State_Absent:
+        if (Monitor->Ops->Present(Monitor->Context)) {
+            Monitor->State = Card_State_Settling;
+            wait = Card_Monitor_Settle_ms;
+        }
+        break;
+    case Card_State_Settling:
+        if (!Monitor->Ops->Present(Monitor->Context)) {
+            Monitor->State = Card_State_Absent;             // Bounced, settles again from the start
+            Monitor->Tries = 0;
+        } else {
+            wait = Mount(Monitor);
+        }
+        break;
+    case Card_State_Unusable:
+    case Card_State_Ejected:
+        if (!Monitor->Ops->Present(Monitor->Context)) {
+            Monitor->State = Card_State_Absent;
+            Monitor->Tries = 0;
+        }
+        break;
+    }
+    Monitor->Next_ms = Now_ms + wait;
+    return wait;
+}
+
+void Card_Monitor_Check(Card_Monitor *Monitor)
+{
+    Monitor->Check_Requested = true;
+}
+
+void Card_Monitor_Eject(Card_Monitor *Monitor)
+{
+    Monitor->Eject_Requested = true;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// Card insertion and removal for SD_MMC, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// A mounted card is checked with CMD13 every Card_Monitor_Poll_ms and taken as gone after Card_Monitor_Misses
+// failures in a row, one bad answer is a glitch and not a removal. Without a card it asks whether one answers
+// and mounts it once it has kept answering for Card_Monitor_Settle_ms. A card that answers but holds no
+// filesystem is left alone until it is taken out, nothing here ever formats. Without a card detect pin a card
+// swapped within Card_Monitor_Poll_ms is taken for the one before.
+// Subscribers hear Lost and Ejecting before the unmount and have to be done with their files when they return.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define Card_Monitor_Poll_ms        1000                    // Between checks in any state
+#define Card_Monitor_Recheck_ms     100                     // After a failed CMD13
+#define Card_Monitor_Misses         3                       // Failed CMD13 in a row that mean the card is gone
+#define Card_Monitor_Settle_ms      300                     // Contacts bounce while a card goes in
+#define Card_Monitor_Mount_Tries    3                       // Mount errors before the card is taken as unusable
+#define Card_Monitor_Subscribers    8                       // Six in the firmware: SD log, music, mp3 index, library, logger, art
+
+typedef enum {
+    Card_State_Absent,
+    Card_State_Settling,                                    // Answers, mounted once Card_Monitor_Settle_ms has passed
+    Card_State_Mounted,
+    Card_State_Unusable,                                    // Answers but won't mount, until it is taken out
+    Card_State_Ejected,                                     // Unmounted on request, until it is taken out
+} Card_State;
+
+typedef enum {
+    Card_Event_Mounted,
+    Card_Event_Lost,                                        // Already gone, drop the files without writing
+    Card_Event_Ejecting,                                    // Still there, finish writing first
+    Card_Event_Unusable,
+} Card_Event;
+
+typedef enum {
+    Card_Mount_OK,
+    Card_Mount_Unformatted,                                 // No FAT on it, trying again won't help
+    Card_Mount_Error,                                       // Anything else, tried again
+} Card_Mount_Result;
+
+// Present is never called while a card is mounted and Alive only while one is
+typedef struct {
+    bool (*Present)(void *Context);                         // The card detect pin, or whether a card answers
+    bool (*Alive)(void *Context);                           // CMD13
+    Card_Mount_Result (*Mount)(void *Context);
+    void (*Unmount)(void *Context);
+} Card_Ops;
+
+typedef void (*Card_Listener)(Card_Event Event, void *Context);
+
+typedef struct {
+    uint32_t Mounts;
+    uint32_t Removals;                                      // Lost and ejected
+    uint32_t Glitches;                                      // Failed CMD13 that the next one answered
+    uint32_t Mount_Errors;
+} Card_Monitor_Stats;
+
+typedef struct {
+    const Card_Ops *Ops;
+    void *Context;
+    struct {
+        Card_Listener Function;
+        void *Context;
+    } Subscribers[Card_Monitor_Subscribers];
+    uint8_t Subscriber_Count;
+    Card_State State;
+    uint32_t Next_ms;                                       // When the next check is due
+    uint8_t Misses;
+    uint8_t Tries;
+    bool Check_Requested;
+    bool Eject_Requested;
+    Card_Monitor_Stats Stats;
+} Card_Monitor;
+
+// Settling and due at once, so the first poll mounts a card that is in at boot without waiting
+void Card_Monitor_Init(Card_Monitor *Monitor, const Card_Ops *Ops, void *Context);
+bool Card_Monitor_Subscribe(Card_Monitor *Monitor, Card_Listener Function, void *Context);   // False when full
+// Runs the check that is due and returns the ms until the next one. Ops and listeners run on the caller
+uint32_t Card_Monitor_Poll(Card_Monitor *Monitor, uint32_t Now_ms);
+void Card_Monitor_Check(Card_Monitor *Monitor);             // An I/O error was seen, the next poll checks at once
+void Card_Monitor_Eject(Card_Monitor *Monitor);             // Unmount at the next poll and leave the card be
@@ -0,0 +1,275 @@
+#include "Dir_Scan.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+
+static bool Is_Separator(char C)
+{
+    return C == ' ' || C == ',' || C == ';';
+}
+
+// ".mp3 .wav" or "mp3,wav", each kept with its dot
+static int Parse_Extensions(Dir_Scan *Scan, const char *Extensions)
+{
+    const char *p = Extensions;
+    while (p && *p) {
+        while (Is_Separator(*p)) {
+            p++;
+        }
+        const char *start = p;
+        while (*p && !Is_Separator(*p)) {
+            p++;
+        }
+        size_t length = p - start;
+        if (!length) {
+            break;
+        }
+        bool dot = start[0] == '.';
+        if (Scan->Extension_Count == Dir_Scan_Extensions_Max || length + !dot >= Dir_Scan_Extension_Bytes) {
+            return -EINVAL;
+        }
+        char *extension = Scan->Extensions[Scan->Extension_Count];
+        extension[0] = '.';
+        memcpy(extension + !dot, start, length);
+        extension[length + !dot] = '\0';
+        Scan->Extension_Lengths[Scan->Extension_Count++] = length + !dot;
+    }
+    return 0;
+}
+
+static bool Extension_Match(const Dir_Scan *Scan, const char *Name, size_t Length)
+{
+    if (!Scan->Extension_Count) {
+        return true;
+    }
+    for (uint8_t i = 0; i < Scan->Extension_Count; i++) {
+        size_t extension_length = Scan->Extension_Lengths[i];
+        if (Length > extension_length && strcasecmp(Name + Length - extension_length, Scan->Extensions[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Each * is taken as short as it can be and grown again when what follows it fails
+bool Dir_Scan_Match(const char *Pattern, const char *Name)
+{
+    const char *star = NULL;
+    const char *resume = NULL;
+    while (*Name) {
+        if (*Pattern == '*') {
+            star = Pattern++;
+            resume = Name;
+        } else if (*Pattern == '?' || (*Pattern && tolower((unsigned char)*Pattern) == tolower((unsigned char)*Name))) {
+            Pattern++;
+            Name++;
+        } else if (star) {
+            Pattern = star + 1;
+            Name = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (*Pattern == '*') {
+        Pattern++;
+    }
+    return *Pattern == '\0';
+}
+
+int Dir_Scan_Open(Dir_Scan *Scan, const char *Root, const Dir_Filter *Filter, Dir_Batch Batch, void *Context)
+{
+    memset(Scan, 0, sizeof(*Scan));
+    Scan->Level = -1;
+    Scan->Batch = Batch;
+    Scan->Context = Context;
+    Scan->Depth = Filter->Depth < Dir_Scan_Depth_Max ? Filter->Depth : Dir_Scan_Depth_Max;
+    Scan->Directories = Filter->Directories;
+    Scan->Hidden = Filter->Hidden;
+    if (Parse_Extensions(Scan, Filter->Extensions) != 0) {
+        return -EINVAL;
+    }
+    if (Filter->Pattern && strcmp(Filter->Pattern, "*") != 0) {
+        if (strlen(Filter->Pattern) >= sizeof(Scan->Pattern)) {
+            return -EINVAL;
+        }
+        strcpy(Scan->Pattern, Filter->Pattern);
+    }
+    Scan->Root_Length = strlen(Root);
+    while (Scan->Root_Length > 1 && Root[Scan->Root_Length - 1] == '/') {
+        Scan->Root_Length--;                                // Paths are joined with a slash of their own
+    }
+    if (Scan->Root_Length + 2 > Dir_Scan_Path_Max) {
+        return -ENAMETOOLONG;
+    }
+    memcpy(Scan->Path, Root, Scan->Root_Length);
+    Scan->Path[Scan->Root_Length] = '\0';
+    Scan->Open[0] = opendir(Scan->Path);
+    if (!Scan->Open[0]) {
+        return errno ? -errno : -ENOENT;
+    }
+    if (Scan->Root_Length == 1 && Scan->Path[0] == '/') {
+        Scan->Root_Length = 0;                              // The root's own slash joins "/" and the name
+    }
+    Scan->Level = 0;
+    Scan->Length[0] = Scan->Root_Length;
+    Scan->Stats.Directories = 1;
+    return 0;
+}
+
+static void Deliver(Dir_Scan *Scan)
+{
+    if (!Scan->Count) {
+        return;
+    }
+    Scan->Stats.Batches++;
+    if (!Scan->Batch(Scan->Entries, Scan->Count, &Scan->Stats, Scan->Context)) {
+        Scan->Stopped = true;
+    }
+    Scan->Count = 0;
+    Scan->Names_Used = 0;
+}
+
+// Path holds the entry, Length is where its name starts less the slash
+static void Add(Dir_Scan *Scan, size_t Length, size_t Name_Length, bool Directory)
+{
+    const char *relative = Scan->Path + Scan->Root_Length + 1;
+    size_t bytes = Length + 1 + Name_Length - Scan->Root_Length;    // With the terminator
+    if (Scan->Names_Used + bytes > sizeof(Scan->Names)) {
+        Deliver(Scan);
+        if (Scan->Stopped) {
+            return;
+        }
+    }
+    char *path = Scan->Names + Scan->Names_Used;
+    memcpy(path, relative, bytes);
+    Scan->Names_Used += bytes;
+    Scan->Entries[Scan->Count].Path = path;
+    Scan->Entries[Scan->Count].Name = bytes - 1 - Name_Length;
+    Scan->Entries[Scan->Count].Depth = Scan->Level;
+    Scan->Entries[Scan->Count].Directory = Directory;
+    Scan->Count++;
+    Scan->Stats.Matched++;
+    if (Scan->Count == Dir_Scan_Batch) {
+        Deliver(Scan);
+    }
+}
+
+// Path holds the entry already when this has to stat() it
+static bool Is_Directory(Dir_Scan *Scan, const struct dirent *Entry)
+{
+#ifdef DT_DIR
+    if (Entry->d_type != DT_UNKNOWN) {
+        return Entry->d_type == DT_DIR;
+    }
+#endif
+    struct stat st;
+    Scan->Stats.Stats++;
+    return stat(Scan->Path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+static bool Type_Known(const struct dirent *Entry)
+{
+#ifdef DT_DIR
+    return Entry->d_type != DT_UNKNOWN;
+#else
+    return false;
+#endif
+}
+
+bool Dir_Scan_Step(Dir_Scan *Scan, uint32_t Entries)
+{
+    for (uint32_t read = 0; Scan->Level >= 0 && !Scan->Stopped && read < Entries; read++) {
+        struct dirent *entry = readdir(Scan->Open[Scan->Level]);
+        if (!entry) {
+            closedir(Scan->Open[Scan->Level]);
+            Scan->Open[Scan->Level--] = NULL;
+            if (Scan->Level >= 0) {
+                Scan->Path[Scan->Length[Scan->Level]] = '\0';
+            }
+            continue;
+        }
+        Scan->Stats.Entries++;
+        const char *name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        if (!Scan->Hidden && (name[0] == '.' || strcmp(name, "System Volume Information") == 0)) {
+            continue;
+        }
+        size_t length = Scan->Length[Scan->Level];
+        size_t name_length = strlen(name);
+        bool fits = length + 1 + name_length < Dir_Scan_Path_Max;
+        if (fits && !Type_Known(entry)) {
+            Scan->Path[length] = '/';
+            memcpy(Scan->Path + length + 1, name, name_length + 1);
+        } else if (!fits) {
+            Scan->Stats.Skipped++;
+            continue;
+        }
+        // A file that isn't wanted costs nothing more than the compares
+        bool directory = Is_Directory(Scan, entry);
+        bool wanted = (directory ? Scan->Directories : Extension_Match(Scan, name, name_length)) &&
+                      (!Scan->Pattern[0] || Dir_Scan_Match(Scan->Pattern, name));
+        if (!wanted && !directory) {
+            Scan->Path[length] = '\0';
+            continue;
+        }
+        Scan->Path[length] = '/';
+        memcpy(Scan->Path + length + 1, name, name_length + 1);
+        if (wanted) {
+            Add(Scan, length, name_length, directory);
+        }
+        DIR *dir = NULL;
+        if (directory && Scan->Level < Scan->Depth) {
+            dir = opendir(Scan->Path);
+        } else if (directory) {
+            Scan->Stats.Skipped++;
+        }
+        if (dir) {
+            Scan->Open[++Scan->Level] = dir;
+            Scan->Length[Scan->Level] = length + 1 + name_length;
+            Scan->Stats.Directories++;
+        } else {
+            Scan->Path[length] = '\0';
+        }
+    }
+    if (Scan->Level < 0 && !Scan->Stopped) {
+        Deliver(Scan);
+    }
+    if (Scan->Stopped) {
+        Dir_Scan_Close(Scan);
+    }
+    return Scan->Level >= 0;
+}
+
+void Dir_Scan_Close(Dir_Scan *Scan)
+{
+    for (; Scan->Level >= 0; Scan->Level--) {
+        closedir(Scan->Open[Scan->Level]);
+        Scan->Open[Scan->Level] = NULL;
+    }
+    Scan->Count = 0;
+    Scan->Names_Used = 0;
+}
+
+int Dir_Scan_Run(const char *Root, const Dir_Filter *Filter, Dir_Batch Batch, void *Context, Dir_Scan_Stats *Stats)
+{
+    Dir_Scan *scan = malloc(sizeof(Dir_Scan));
+    if (!scan) {
+        return -ENOMEM;
+    }
+    int ret = Dir_Scan_Open(scan, Root, Filter, Batch, Context);
+    if (ret == 0) {
+        while (Dir_Scan_Step(scan, UINT32_MAX)) {
+        }
+    }
+    if (Stats) {
+        *Stats = scan->Stats;
+    }
+    free(scan);
+    return ret;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+// Directory listing for SD_MMC, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// Entries are handed over in batches of up to Dir_Scan_Batch with their path relative to the root, filtered by
+// an extension set and a name pattern, and a tree is walked down to a depth limit. Nothing is logged or formatted
+// per entry and nothing is stat()ed, readdir() says what is a directory on FAT. A scan runs in steps of a number
+// of entries, so one on the I/O task lets the reads queued behind it go in between, and each batch comes with
+// the counts so far for a progress display.
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Dir_Scan_Batch              32                      // Entries in one batch
+#define Dir_Scan_Batch_Bytes        2048                    // Of their paths, a batch goes early when these run out
+#define Dir_Scan_Path_Max           256                     // Root included, as FAT takes them
+#define Dir_Scan_Depth_Max          8                       // Directories below the root that can be walked
+#define Dir_Scan_Extensions_Max     8
+#define Dir_Scan_Extension_Bytes    8                       // The dot and the terminator included
+#define Dir_Scan_Pattern_Bytes      64
+
+typedef struct {
+    const char *Extensions;                                 // ".mp3 .wav", case ignored, NULL for any
+    const char *Pattern;                                    // Glob on the name with * and ?, case ignored, NULL for any
+    uint8_t Depth;                                          // Below the root, 0 lists the root alone
+    bool Directories;                                       // Hand over directories too, they are walked either way
+    bool Hidden;                                            // Names starting with a dot and System Volume Information
+} Dir_Filter;
+
+typedef struct {
+    const char *Path;                                       // Relative to the root, valid until the batch returns
+    uint16_t Name;                                          // Offset of the name in Path
+    uint8_t Depth;                                          // 0 for the root's own entries
+    bool Directory;
+} Dir_Entry;
+
+typedef struct {
+    uint32_t Directories;                                   // Opened
+    uint32_t Entries;                                       // Read from them
+    uint32_t Matched;                                       // Handed over
+    uint32_t Skipped;                                       // Path over Dir_Scan_Path_Max or deeper than Depth allows
+    uint32_t Stats;                                         // stat() for a file system that doesn't fill d_type
+    uint32_t Batches;
+} Dir_Scan_Stats;
+
+// Return false to stop the scan
+typedef bool (*Dir_Batch)(const Dir_Entry *Entries, uint32_t Count, const Dir_Scan_Stats *Progress, void *Context);
+
+typedef struct {
+    Dir_Batch Batch;
+    void *Context;
+    uint8_t Depth;
+    bool Directories;
+    bool Hidden;
+    uint8_t Extension_Count;
+    char Extensions[Dir_Scan_Extensions_Max][Dir_Scan_Extension_Bytes];
+    uint8_t Extension_Lengths[Dir_Scan_Extensions_Max];
+    char Pattern[Dir_Scan_Pattern_Bytes];                   // Empty for any
+    DIR *Open[Dir_Scan_Depth_Max + 1];                      // One per level being read
+    uint16_t Length[Dir_Scan_Depth_Max + 1];                // Of Path at each level
+    int8_t Level;                                           // -1 once done
+    bool Stopped;
+    size_t Root_Length;
+    char Path[Dir_Scan_Path_Max];
+    Dir_Entry Entries[Dir_Scan_Batch];
+    uint32_t Count;
+    uint32_t Names_Used;
+    char Names[Dir_Scan_Batch_Bytes];
+    Dir_Scan_Stats Stats;
+} Dir_Scan;
+
+// 0 or a negative errno: a missing root, one too long, or more extensions than fit. The filter is copied
+int Dir_Scan_Open(Dir_Scan *Scan, const char *Root, const Dir_Filter *Filter, Dir_Batch Batch, void *Context);
+// Reads up to Entries more and hands over what is batched once done. True while there is more to read
+bool Dir_Scan_Step(Dir_Scan *Scan, uint32_t Entries);
+void Dir_Scan_Close(Dir_Scan *Scan);                        // Early, nothing more is handed over
+int Dir_Scan_Run(const char *Root, const Dir_Filter *Filter, Dir_Batch Batch, void *Context, Dir_Scan_Stats *Stats);   // All of it here, Stats may be NULL
+bool Dir_Scan_Match(const char *Pattern, const char *Name); // The glob alone, exposed for the bench
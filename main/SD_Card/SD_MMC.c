@@ -1,114 +1,360 @@
 #include "SD_MMC.h"
 
-#define EXAMPLE_MAX_CHAR_SIZE    64
+#include <fcntl.h>
+#include <stdlib.h>
+#include "esp_heap_caps.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "File_IO.h"
+#include "Shutdown.h"
+
 #define MOUNT_POINT "/sdcard"
 
 static const char *SD_TAG = "SD";
 
 uint32_t Flash_Size = 0;
 uint32_t SDCard_Size = 0;
+SD_Bus_Mode SD_Mode = { 0 };
+
+// Fastest first. Cards without high speed run the 40 MHz steps at 20 MHz, the driver negotiates that itself
+static const struct {
+    uint8_t Width;
+    uint32_t Freq_kHz;
+} SD_Probe_Steps[] = {
+    { 4, SDMMC_FREQ_HIGHSPEED },
+    { 4, SDMMC_FREQ_DEFAULT },
+    { 1, SDMMC_FREQ_HIGHSPEED },
+    { 1, SDMMC_FREQ_DEFAULT },
+    { 1, 10000 },                                           // Long or noisy lines
+};
+
+static sdmmc_card_t *SD_Card = NULL;
+static Card_Monitor SD_Monitor;
+static SemaphoreHandle_t SD_Monitor_Mutex;
+static SemaphoreHandle_t SD_Unmounted;
+static TaskHandle_t SD_Monitor_Task_Handle;
+
+// A listing in progress holds directories open between its steps. Only touched on the I/O task
+typedef struct SD_Scan_Job {
+    struct SD_Scan_Job *Next;
+    Dir_Scan Scan;
+    const char *Root;
+    const Dir_Filter *Filter;
+    Dir_Batch Batch;
+    void *Context;
+    bool Opened;
+    bool Cancelled;                                         // The card went, its directories are closed
+} SD_Scan_Job;
+
+static SD_Scan_Job *SD_Scans = NULL;
+
+typedef enum {
+    SD_Bench_Seq_Write,                                     // The time the data takes to reach the card included
+    SD_Bench_Seq_Read,
+    SD_Bench_Random_Read,
+    SD_Bench_Random_Write,
+    SD_Bench_Phases
+} SD_Bench_Phase;
+
+// A run in progress holds the file open between its steps. Only touched on the I/O task
+typedef struct {
+    SD_Bench_Phase Phase;
+    uint32_t Step;                                          // Chunks or operations done in this phase
+    int Fd;
+    uint8_t *Buffer;
+    int64_t Busy_us;                                        // On the I/O task in this phase, not queued behind others
+    bool Started;
+    bool Cancelled;                                         // The card went, the file is closed
+    SD_Bench_Result *Result;
+} SD_Bench_Job;
+
+static SD_Bench_Job *SD_Bench_Running = NULL;
+
+#define SD_Notify_Check     (1 << 0)
+#define SD_Notify_Eject     (1 << 1)
+
+static sdmmc_slot_config_t SD_Slot_Config(uint8_t Width)
+{
+    // This initializes the slot without card detect (CD) and write protect (WP) signals.
+    // CONFIG_SD_Card_CD is read by SD_Present() instead, the host doesn't need it.
+    sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
+    slot_config.width = Width;
+    slot_config.clk = CONFIG_EXAMPLE_PIN_CLK;
+    slot_config.cmd = CONFIG_EXAMPLE_PIN_CMD;
+    slot_config.d0 = CONFIG_EXAMPLE_PIN_D0;
+    slot_config.d1 = CONFIG_EXAMPLE_PIN_D1;
+    slot_config.d2 = CONFIG_EXAMPLE_PIN_D2;
+    slot_config.d3 = CONFIG_EXAMPLE_PIN_D3;
 
+    // Enable internal pullups on enabled pins. The internal pullups are insufficient however, please make sure 10k external pullups are connected on the bus. This is for debug / example purpose only.
+    slot_config.flags |= SDMMC_SLOT_FLAG_INTERNAL_PULLUP;
+    return slot_config;
+}
 
-esp_err_t s_example_write_file(const char *path, char *data)
+static esp_err_t SD_Mount(uint8_t Width, uint32_t Freq_kHz)
 {
-    ESP_LOGI(SD_TAG, "Opening file %s", path);
-    FILE *f = fopen(path, "w");
-    if (f == NULL) {
-        ESP_LOGE(SD_TAG, "Failed to open file for writing");
-        return ESP_FAIL;
-    }
-    fprintf(f, data);
-    fclose(f);
-    ESP_LOGI(SD_TAG, "File written");
+    // Options for mounting the filesystem.
+    // Never formats: a card that glitched during the mount would be wiped. One without a filesystem is reported.
+    esp_vfs_fat_sdmmc_mount_config_t mount_config = {
+        .format_if_mount_failed = false,
+        .max_files = 5,
+        .allocation_unit_size = 16 * 1024
+    };
+    sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+    host.max_freq_khz = Freq_kHz;
+    sdmmc_slot_config_t slot_config = SD_Slot_Config(Width);
+    return esp_vfs_fat_sdmmc_mount(MOUNT_POINT, &host, &slot_config, &mount_config, &SD_Card);
+}
 
-    return ESP_OK;
+// Signal integrity errors show up as CRC errors, timeouts or data that differs between two reads.
+// ESP_ERR_NO_MEM says nothing about the bus
+static esp_err_t SD_Verify(void)
+{
+    size_t bytes = SD_Verify_Chunk_Sectors * SD_Card->csd.sector_size;
+    uint8_t *first = heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+    uint8_t *second = heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    if (first && second) {
+        ret = ESP_OK;
+        for (size_t sector = 0; sector < SD_Probe_Sectors && ret == ESP_OK; sector += SD_Verify_Chunk_Sectors) {
+            ret = sdmmc_read_sectors(SD_Card, first, sector, SD_Verify_Chunk_Sectors);
+            if (ret == ESP_OK) {
+                ret = sdmmc_read_sectors(SD_Card, second, sector, SD_Verify_Chunk_Sectors);
+            }
+            if (ret == ESP_OK && memcmp(first, second, bytes) != 0) {
+                ret = ESP_ERR_INVALID_CRC;
+            }
+        }
+    }
+    heap_caps_free(first);
+    heap_caps_free(second);
+    return ret;
 }
 
-esp_err_t s_example_read_file(const char *path)
+// Fastest bus mode that reads back clean, down to 1 line at 10 MHz
+static Card_Mount_Result SD_Probe(void *Context)
 {
-    ESP_LOGI(SD_TAG, "Reading file %s", path);
-    FILE *f = fopen(path, "r");
-    if (f == NULL) {
-        ESP_LOGE(SD_TAG, "Failed to open file for reading");
-        return ESP_FAIL;
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    bool four_lines = CONFIG_EXAMPLE_PIN_D1 >= 0 && CONFIG_EXAMPLE_PIN_D2 >= 0 && CONFIG_EXAMPLE_PIN_D3 >= 0;
+    ESP_LOGI(SD_TAG, "Initializing SD card");
+
+    // A mode with a bad bus can fail to mount a good filesystem, only the slowest one failing to means there is none
+    SD_Mode.Fallbacks = 0;
+    for (size_t i = 0; i < sizeof(SD_Probe_Steps) / sizeof(SD_Probe_Steps[0]); i++) {
+        if (SD_Probe_Steps[i].Width == 4 && !four_lines) {
+            continue;                                       // D1 to D3 are not wired on this board
+        }
+        ret = SD_Mount(SD_Probe_Steps[i].Width, SD_Probe_Steps[i].Freq_kHz);
+        if (ret == ESP_OK) {
+            ret = SD_Verify();
+            if (ret == ESP_ERR_NO_MEM) {
+                ESP_LOGW(SD_TAG, "No DMA memory to verify the bus, keeping this mode unverified");
+                ret = ESP_OK;
+            }
+            if (ret == ESP_OK) {
+                break;
+            }
+            esp_vfs_fat_sdcard_unmount(MOUNT_POINT, SD_Card);
+        }
+        ESP_LOGW(SD_TAG, "%d line bus at %lu kHz failed (%s)", SD_Probe_Steps[i].Width, SD_Probe_Steps[i].Freq_kHz,
+                 esp_err_to_name(ret));
+        SD_Mode.Fallbacks++;
     }
-    char line[EXAMPLE_MAX_CHAR_SIZE];
-    fgets(line, sizeof(line), f);
-    fclose(f);
 
-    // strip newline
-    char *pos = strchr(line, '\n');
-    if (pos) {
-        *pos = '\0';
+    if (ret != ESP_OK) {
+        SD_Mode.Width = 0;
+        if (ret == ESP_FAIL) {
+            ESP_LOGE(SD_TAG, "The card holds no FAT filesystem and is left as it is, format it on a computer");
+            return Card_Mount_Unformatted;
+        }
+        ESP_LOGE(SD_TAG, "Failed to initialize the card (%s). "
+                 "Make sure SD card lines have pull-up resistors in place.", esp_err_to_name(ret));
+        return Card_Mount_Error;
     }
-    ESP_LOGI(SD_TAG, "Read from file: '%s'", line);
+    SD_Mode.Width = 1 << SD_Card->log_bus_width;
+    SD_Mode.Freq_kHz = SD_Card->real_freq_khz;
+    SD_Mode.DDR = SD_Card->is_ddr;
+    ESP_LOGI(SD_TAG, "Filesystem mounted, %d line bus at %lu kHz%s, %d faster modes failed", SD_Mode.Width,
+             SD_Mode.Freq_kHz, SD_Mode.DDR ? " DDR" : "", SD_Mode.Fallbacks);
 
-    return ESP_OK;
+    // Card has been initialized, print its properties
+    sdmmc_card_print_info(stdout, SD_Card);
+    SDCard_Size = ((uint64_t) SD_Card->csd.capacity) * SD_Card->csd.sector_size / (1024 * 1024);
+    return Card_Mount_OK;
 }
 
-
-void SD_Init(void)
+// Without a card detect pin, whether a card gets through initialization at the probing clock. Only while
+// nothing is mounted, the host is brought up for it and down again
+static bool SD_Present(void *Context)
 {
-    esp_err_t ret;
-
-    // Options for mounting the filesystem.
-    // If format_if_mount_failed is set to true, SD card will be partitioned and formatted in case when mounting fails.  false true
-    esp_vfs_fat_sdmmc_mount_config_t mount_config = {
-        .format_if_mount_failed = true,           
-        .max_files = 5,
-        .allocation_unit_size = 16 * 1024
-    };
-    sdmmc_card_t *card;
-    const char mount_point[] = MOUNT_POINT;
-    ESP_LOGI(SD_TAG, "Initializing SD card");
-    
-    // Use settings defined above to initialize SD card and mount FAT filesystem.
-    // Note: esp_vfs_fat_sdmmc/sdspi_mount is all-in-one convenience functions.
-    // Please check its source code and implement error recovery when developing production applications.
-    ESP_LOGI(SD_TAG, "Using SPI peripheral");
-
-    // By default, SD card frequency is initialized to SDMMC_FREQ_DEFAULT (20MHz)
-    // For setting a specific frequency, use host.max_freq_khz (range 400kHz - 20MHz for SDSPI)
-    // Example: for fixed frequency of 10MHz, use host.max_freq_khz = 10000;
+#if CONFIG_SD_Card_CD >= 0
+    return gpio_get_level(CONFIG_SD_Card_CD) == 0;
+#else
     sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+    host.max_freq_khz = SDMMC_FREQ_PROBING;
+    sdmmc_slot_config_t slot_config = SD_Slot_Config(1);
+    sdmmc_card_t card;
+    bool present = false;
+    if (sdmmc_host_init() == ESP_OK) {
+        if (sdmmc_host_init_slot(host.slot, &slot_config) == ESP_OK) {
+            present = sdmmc_card_init(&host, &card) == ESP_OK;
+        }
+        sdmmc_host_deinit();
+    }
+    return present;
+#endif
+}
 
+static bool SD_Alive(void *Context)
+{
+    return sdmmc_get_status(SD_Card) == ESP_OK;             // CMD13, a few hundred us
+}
 
-    // This initializes the slot without card detect (CD) and write protect (WP) signals.
-    // Modify slot_config.gpio_cd and slot_config.gpio_wp if your board has these signals.
-    sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
-    slot_config.width = 1;          // 1-wire  / 4-wire   slot_config.width = 4;
+static int32_t SD_Unmount_Call(void *Context)
+{
+    for (SD_Scan_Job *job = SD_Scans; job; job = job->Next) {
+        Dir_Scan_Close(&job->Scan);                         // Not once the file system is gone
+        job->Cancelled = true;
+    }
+    if (SD_Bench_Running) {
+        if (SD_Bench_Running->Fd >= 0) {
+            close(SD_Bench_Running->Fd);
+            SD_Bench_Running->Fd = -1;
+        }
+        SD_Bench_Running->Cancelled = true;
+    }
+    if (SD_Card) {                                          // Unmounted here already if File_IO took too long
+        esp_vfs_fat_sdcard_unmount(MOUNT_POINT, SD_Card);
+        SD_Card = NULL;
+    }
+    return 0;
+}
 
-    slot_config.clk = CONFIG_EXAMPLE_PIN_CLK;
-    slot_config.cmd = CONFIG_EXAMPLE_PIN_CMD;
-    slot_config.d0 = CONFIG_EXAMPLE_PIN_D0;
-    slot_config.d1 = CONFIG_EXAMPLE_PIN_D1;
-    slot_config.d2 = CONFIG_EXAMPLE_PIN_D2;
-    slot_config.d3 = CONFIG_EXAMPLE_PIN_D3;
-    
-    // Enable internal pullups on enabled pins. The internal pullups are insufficient however, please make sure 10k external pullups are connected on the bus. This is for debug / example purpose only.
-    slot_config.flags |= SDMMC_SLOT_FLAG_INTERNAL_PULLUP;
+static void SD_Unmount_Done(void *Context, int32_t Result)
+{
+    xSemaphoreGive(SD_Unmounted);
+}
 
+// Listeners have closed their files by now. The unmount goes through File_IO behind whatever they left queued
+static void SD_Unmount(void *Context)
+{
+    SD_Mode.Width = 0;                                      // Nobody starts anything new from here
+    SDCard_Size = 0;
+    xSemaphoreTake(SD_Unmounted, 0);
+    if (!File_IO_Call(Io_Class_Log, SD_Unmount_Call, NULL, SD_Unmount_Done) ||
+        xSemaphoreTake(SD_Unmounted, pdMS_TO_TICKS(SD_Unmount_Timeout_ms)) != pdTRUE) {
+        ESP_LOGW(SD_TAG, "File IO didn't get to the unmount, unmounting here");
+        SD_Unmount_Call(NULL);
+    }
+    ESP_LOGI(SD_TAG, "Card unmounted");
+}
 
+static const Card_Ops SD_Ops = {
+    .Present = SD_Present,
+    .Alive = SD_Alive,
+    .Mount = SD_Probe,
+    .Unmount = SD_Unmount,
+};
 
-    ESP_LOGI(SD_TAG, "Mounting filesystem");
-    ret = esp_vfs_fat_sdmmc_mount(mount_point, &host, &slot_config, &mount_config, &card);
+static void SD_Log_Event(Card_Event Event, void *Context)
+{
+    static const char *Events[] = { "mounted", "lost", "ejecting", "unusable" };
+    ESP_LOGI(SD_TAG, "Card %s", Events[Event]);
+}
 
-    if (ret != ESP_OK) {
-        if (ret == ESP_FAIL) {
-            ESP_LOGE(SD_TAG, "Failed to mount filesystem. "
-                     "If you want the card to be formatted, set the CONFIG_EXAMPLE_FORMAT_IF_MOUNT_FAILED menuconfig option.");
-        } else {
-            ESP_LOGE(SD_TAG, "Failed to initialize the card (%s). "
-                     "Make sure SD card lines have pull-up resistors in place.", esp_err_to_name(ret));
+static void SD_Monitor_Task(void *arg)
+{
+    uint32_t wait = 0;
+    while (1) {
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, pdMS_TO_TICKS(wait));
+        xSemaphoreTake(SD_Monitor_Mutex, portMAX_DELAY);
+        if (bits & SD_Notify_Check) {
+            Card_Monitor_Check(&SD_Monitor);
+        }
+        if (bits & SD_Notify_Eject) {
+            Card_Monitor_Eject(&SD_Monitor);
         }
-        return;
+        wait = Card_Monitor_Poll(&SD_Monitor, esp_timer_get_time() / 1000);
+        xSemaphoreGive(SD_Monitor_Mutex);
     }
-    ESP_LOGI(SD_TAG, "Filesystem mounted");
+}
 
-    // Card has been initialized, print its properties
-    sdmmc_card_print_info(stdout, card);
-    SDCard_Size = ((uint64_t) card->csd.capacity) * card->csd.sector_size / (1024 * 1024);
+// The card is unmounted, FAT clean, before the power goes. The listeners' files are closed by then
+static bool SD_Shutdown(uint32_t Timeout_ms, void *Context)
+{
+    if (SD_State() != Card_State_Mounted) {
+        return true;
+    }
+    SD_Eject();
+    for (uint32_t waited = 0; waited < Timeout_ms && SD_State() == Card_State_Mounted; waited += 10) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return SD_State() != Card_State_Mounted;
+}
+
+void SD_Init(void)
+{
+#if CONFIG_SD_Card_CD >= 0
+    gpio_config_t cd_config = {
+        .pin_bit_mask = 1ULL << CONFIG_SD_Card_CD,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+    };
+    gpio_config(&cd_config);
+#endif
+    SD_Monitor_Mutex = xSemaphoreCreateMutex();
+    SD_Unmounted = xSemaphoreCreateBinary();
+    Card_Monitor_Init(&SD_Monitor, &SD_Ops, NULL);
+    Card_Monitor_Subscribe(&SD_Monitor, SD_Log_Event, NULL);
+    // The card that is in at boot is mounted here, before anyone who reads it starts
+    Card_Monitor_Poll(&SD_Monitor, esp_timer_get_time() / 1000);
+    if (!SD_Monitor_Mutex || !SD_Unmounted ||
+        xTaskCreatePinnedToCore(SD_Monitor_Task, "SD Monitor", 4096, NULL, 2, &SD_Monitor_Task_Handle, 0) != pdPASS) {
+        ESP_LOGE(SD_TAG, "Failed to create SD monitor task, cards won't be noticed coming and going");
+        SD_Monitor_Task_Handle = NULL;
+    }
+    Shutdown_Register("card", Shutdown_Phase_Unmount, SD_Shutdown_ms, SD_Shutdown, NULL);
+}
+
+bool SD_Subscribe(Card_Listener Function, void *Context)
+{
+    if (!SD_Monitor_Mutex) {
+        return false;
+    }
+    xSemaphoreTake(SD_Monitor_Mutex, portMAX_DELAY);
+    bool subscribed = Card_Monitor_Subscribe(&SD_Monitor, Function, Context);
+    xSemaphoreGive(SD_Monitor_Mutex);
+    if (!subscribed) {
+        ESP_LOGE(SD_TAG, "No room for another card listener, raise Card_Monitor_Subscribers");
+    }
+    return subscribed;
+}
+
+// Notifications rather than the mutex, a listener may be what calls these
+void SD_Check(void)
+{
+    if (SD_Monitor_Task_Handle) {
+        xTaskNotify(SD_Monitor_Task_Handle, SD_Notify_Check, eSetBits);
+    }
 }
+
+void SD_Eject(void)
+{
+    if (SD_Monitor_Task_Handle) {
+        xTaskNotify(SD_Monitor_Task_Handle, SD_Notify_Eject, eSetBits);
+    }
+}
+
+Card_State SD_State(void)
+{
+    return SD_Monitor.State;
+}
+
 void Flash_Searching(void)
 {
     if(esp_flash_get_physical_size(NULL, &Flash_Size) == ESP_OK)
@@ -124,65 +370,222 @@ void Flash_Searching(void)
 
 FILE* Open_File(const char *file_path) {
     ESP_LOGI(SD_TAG, "Attempting to open file: %s", file_path);
-    FILE *fp = fopen(file_path, "rb"); // Open the MP3 file in binary mode
+    FILE *fp = File_IO_Open_Stream(file_path, Io_Class_Audio); // Opened and read ahead on the I/O task, the caller never waits on FAT
     if (fp == NULL) {
         ESP_LOGE(SD_TAG, "Failed to open file %s. Error: %s", file_path, strerror(errno));
     }
-    else
-        printf("File %s was successfully opened. \r\n", file_path);
     return fp; 
 }
 
-#define MAX_FILE_NAME_SIZE 100  // Define maximum file name size
-#define MAX_PATH_SIZE 512      // Define a larger size for the full path
-uint16_t Folder_retrieval(const char* directory, const char* fileExtension, char File_Name[][MAX_FILE_NAME_SIZE], uint16_t maxFiles)    
+/*-------------------- Listing --------------------*/
+// One step per request, 1 while there is more, 0 once done or a negative errno
+static int32_t SD_Scan_Call(void *Context)
 {
-    DIR *dir = opendir(directory);  // Opens the specified directory
-    if (dir == NULL) {
-        ESP_LOGE(SD_TAG, "Path: <%s> does not exist", directory);  
-        return 0; 
+    SD_Scan_Job *job = Context;
+    if (!job->Opened) {
+        job->Opened = true;
+        int ret = SD_Mode.Width ? Dir_Scan_Open(&job->Scan, job->Root, job->Filter, job->Batch, job->Context) : -ENODEV;
+        if (ret != 0) {
+            return ret;
+        }
+        job->Next = SD_Scans;
+        SD_Scans = job;
     }
-
-    uint16_t fileCount = 0;  // File counter
-    struct dirent *entry;    // Directory entry pointer
-
-    // 遍历目录中的所有条目
-    while ((entry = readdir(dir)) != NULL && fileCount < maxFiles) {
-        // Skip "." and ".." Special directory
-        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-            continue;
+    bool more = !job->Cancelled && Dir_Scan_Step(&job->Scan, SD_Scan_Step_Entries);
+    if (!more) {
+        SD_Scan_Job **link = &SD_Scans;
+        while (*link != job) {
+            link = &(*link)->Next;
         }
+        *link = job->Next;
+    }
+    return job->Cancelled ? -ENODEV : more;
+}
 
-        const char *dot = strrchr(entry->d_name, '.');  
-        if (dot != NULL && dot != entry->d_name) {  
+int SD_Scan(const char *Root, const Dir_Filter *Filter, Io_Class Class, Dir_Batch Batch, void *Context, Dir_Scan_Stats *Stats)
+{
+    SD_Scan_Job *job = calloc(1, sizeof(SD_Scan_Job));
+    if (!job) {
+        return -ENOMEM;
+    }
+    job->Root = Root;
+    job->Filter = Filter;
+    job->Batch = Batch;
+    job->Context = Context;
+    int32_t ret;
+    do {
+        ret = File_IO_Call_Wait(Class, SD_Scan_Call, job);
+    } while (ret > 0);
+    if (Stats) {
+        *Stats = job->Scan.Stats;
+    }
+    free(job);
+    return ret;
+}
 
+/*-------------------- Benchmark --------------------*/
+static TaskHandle_t SD_Bench_Task_Handle = NULL;
+static SD_Bench_Result SD_Bench_Last;
+static volatile bool SD_Bench_Done = false;
 
-            if (strcasecmp(dot, fileExtension) == 0) { 
+static float SD_Rate(uint64_t Count, int64_t Elapsed_us)
+{
+    return Elapsed_us > 0 ? Count * 1e6f / Elapsed_us : 0.0f;
+}
 
-                strncpy(File_Name[fileCount], entry->d_name, MAX_FILE_NAME_SIZE - 1);
-                File_Name[fileCount][MAX_FILE_NAME_SIZE - 1] = '\0'; 
+static int32_t SD_Bench_Error(void)
+{
+    return errno ? -errno : -EIO;
+}
 
- 
-                char filePath[MAX_PATH_SIZE];
-                snprintf(filePath, MAX_PATH_SIZE, "%s/%s", directory, entry->d_name);
+// One chunk or SD_Bench_Step_Ops operations, 1 while there is more, 0 once done or a negative errno
+static int32_t SD_Bench_Step(SD_Bench_Job *Job)
+{
+    static const int Flags[SD_Bench_Phases] = { O_WRONLY | O_CREAT | O_TRUNC, O_RDONLY, O_RDONLY, O_RDWR };
+    const uint32_t blocks = SD_Bench_File_Bytes / SD_Bench_Random_Bytes;
+    int64_t start = esp_timer_get_time();
+    errno = 0;
+    if (Job->Fd < 0) {
+        Job->Fd = open(SD_Bench_File, Flags[Job->Phase], 0644);
+        if (Job->Fd < 0) {
+            return SD_Bench_Error();
+        }
+    }
 
-                printf("File found: %s\r\n", filePath); 
-                fileCount++;  
+    bool finished;
+    if (Job->Phase == SD_Bench_Seq_Write || Job->Phase == SD_Bench_Seq_Read) {
+        ssize_t done = (Job->Phase == SD_Bench_Seq_Write) ? write(Job->Fd, Job->Buffer, SD_Bench_Chunk_Bytes)
+                                                          : read(Job->Fd, Job->Buffer, SD_Bench_Chunk_Bytes);
+        if (done != SD_Bench_Chunk_Bytes) {
+            return SD_Bench_Error();
+        }
+        finished = ++Job->Step == SD_Bench_File_Bytes / SD_Bench_Chunk_Bytes;
+    } else {
+        for (int n = 0; n < SD_Bench_Step_Ops && Job->Step < SD_Bench_Random_Ops; n++, Job->Step++) {
+            off_t offset = (off_t)(esp_random() % blocks) * SD_Bench_Random_Bytes;
+            ssize_t done = -1;
+            if (lseek(Job->Fd, offset, SEEK_SET) == offset) {
+                done = (Job->Phase == SD_Bench_Random_Read) ? read(Job->Fd, Job->Buffer, SD_Bench_Random_Bytes)
+                                                            : write(Job->Fd, Job->Buffer, SD_Bench_Random_Bytes);
+            }
+            if (done != SD_Bench_Random_Bytes) {
+                return SD_Bench_Error();
             }
         }
-        else{
-            // If the extension name is not found, you can output debugging information
-            // printf("No extension found for file: %s\r\n", entry->d_name);
+        finished = Job->Step == SD_Bench_Random_Ops;
+    }
+    if (finished && Flags[Job->Phase] != O_RDONLY && fsync(Job->Fd) != 0) {
+        return SD_Bench_Error();
+    }
+    Job->Busy_us += esp_timer_get_time() - start;
+    if (!finished) {
+        return 1;
+    }
+
+    close(Job->Fd);
+    Job->Fd = -1;
+    SD_Bench_Result *result = Job->Result;
+    switch (Job->Phase) {
+        case SD_Bench_Seq_Write:    result->Seq_Write_KBps = SD_Rate(SD_Bench_File_Bytes / 1024, Job->Busy_us); break;
+        case SD_Bench_Seq_Read:     result->Seq_Read_KBps = SD_Rate(SD_Bench_File_Bytes / 1024, Job->Busy_us); break;
+        case SD_Bench_Random_Read:  result->Random_Read_IOPS = SD_Rate(SD_Bench_Random_Ops, Job->Busy_us); break;
+        default:                    result->Random_Write_IOPS = SD_Rate(SD_Bench_Random_Ops, Job->Busy_us); break;
+    }
+    Job->Busy_us = 0;
+    Job->Step = 0;
+    Job->Phase++;
+    return Job->Phase < SD_Bench_Phases;
+}
+
+static int32_t SD_Bench_Call(void *Context)
+{
+    SD_Bench_Job *job = Context;
+    if (!job->Started) {
+        job->Started = true;
+        if (!SD_Mode.Width) {
+            return -ENODEV;
         }
+        SD_Bench_Running = job;
+    }
+    return job->Cancelled ? -ENODEV : SD_Bench_Step(job);
+}
+
+static int32_t SD_Bench_Finish_Call(void *Context)
+{
+    SD_Bench_Job *job = Context;
+    if (job->Fd >= 0) {
+        close(job->Fd);
+        job->Fd = -1;
+    }
+    if (!job->Cancelled && SD_Mode.Width) {
+        unlink(SD_Bench_File);
+    }
+    if (SD_Bench_Running == job) {
+        SD_Bench_Running = NULL;
     }
+    return 0;
+}
 
-    closedir(dir);  // 
+// Through the filesystem, the way the player and the logs see the card. Writes one temporary file and deletes it.
+// Runs on the I/O task a step at a time, so the player keeps reading and an eject closes the file in between
+esp_err_t SD_Benchmark(SD_Bench_Result *Result)
+{
+    memset(Result, 0, sizeof(*Result));
+    if (SD_Mode.Width == 0) {
+        return Result->Result = ESP_ERR_INVALID_STATE;
+    }
+    SD_Bench_Job job = { .Fd = -1, .Result = Result };
+    job.Buffer = heap_caps_malloc(SD_Bench_Chunk_Bytes, MALLOC_CAP_DMA);
+    if (!job.Buffer) {
+        return Result->Result = ESP_ERR_NO_MEM;
+    }
+    esp_fill_random(job.Buffer, SD_Bench_Chunk_Bytes);
+
+    int32_t ret;
+    do {
+        ret = File_IO_Call_Wait(Io_Class_Log, SD_Bench_Call, &job);
+    } while (ret > 0);
+    File_IO_Call_Wait(Io_Class_Log, SD_Bench_Finish_Call, &job);
+    heap_caps_free(job.Buffer);
+
+    if (ret != 0) {
+        ESP_LOGE(SD_TAG, "Benchmark failed: %s", strerror(-ret));
+        return Result->Result = (ret == -ENODEV) ? ESP_ERR_INVALID_STATE : ESP_FAIL;
+    }
+    ESP_LOGI(SD_TAG, "Benchmark, %d line bus at %lu kHz: sequential write %.0f KB/s, read %.0f KB/s, "
+             "random %d byte write %.0f IOPS, read %.0f IOPS", SD_Mode.Width, SD_Mode.Freq_kHz,
+             Result->Seq_Write_KBps, Result->Seq_Read_KBps, SD_Bench_Random_Bytes,
+             Result->Random_Write_IOPS, Result->Random_Read_IOPS);
+    return Result->Result = ESP_OK;
+}
 
-    if (fileCount > 0) {
-        ESP_LOGI(SD_TAG, "Retrieved %d files with extension '%s'", fileCount, fileExtension);  // 
-    } else {
-        ESP_LOGW(SD_TAG, "No files with extension '%s' found in directory: %s", fileExtension, directory);  // 
+static void SD_Bench_Task(void *arg)
+{
+    SD_Benchmark(&SD_Bench_Last);
+    SD_Bench_Done = true;
+    SD_Bench_Task_Handle = NULL;
+    vTaskDelete(NULL);
+}
+
+void SD_Benchmark_Start(void)
+{
+    if (SD_Bench_Task_Handle) {
+        return;                                             // Still running
+    }
+    SD_Bench_Done = false;
+    if (xTaskCreatePinnedToCore(SD_Bench_Task, "SD Benchmark", 4096, NULL, 2, &SD_Bench_Task_Handle, 0) != pdPASS) {
+        SD_Bench_Task_Handle = NULL;
+        SD_Bench_Last.Result = ESP_ERR_NO_MEM;
+        SD_Bench_Done = true;
     }
+}
 
-    return fileCount;  
-}
\ No newline at end of file
+bool SD_Benchmark_Take(SD_Bench_Result *Result)
+{
+    if (!SD_Bench_Done) {
+        return false;
+    }
+    SD_Bench_Done = false;
+    *Result = SD_Bench_Last;
+    return true;
+}
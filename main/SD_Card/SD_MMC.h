@@ -12,6 +12,9 @@
 #include <errno.h>
 
 #include "esp_flash.h"    
+#include "Card_Monitor.h"
+#include "Dir_Scan.h"
+#include "Io_Queue.h"
 
 #define CONFIG_EXAMPLE_PIN_CLK  14
 #define CONFIG_EXAMPLE_PIN_CMD  17
@@ -21,17 +24,54 @@
 #define CONFIG_EXAMPLE_PIN_D3   -1  
 
 #define CONFIG_SD_Card_D3       21  
+#define CONFIG_SD_Card_CD       -1                          // No card detect pin on this board, a card is polled for
+
+#define SD_Probe_Sectors        64                          // Read twice and compared after each mode is brought up
+#define SD_Verify_Chunk_Sectors 8                           // at a time, DMA capable RAM is scarce
+#define SD_Unmount_Timeout_ms   2000                        // For File_IO to get through what is queued
+#define SD_Shutdown_ms          500                         // For the monitor to eject the card before the power goes
+#define SD_Scan_Step_Entries    64                          // Read per I/O request, what is queued behind goes in between
+#define SD_Bench_File           "/sdcard/.sd_bench.tmp"
+#define SD_Bench_File_Bytes     (4 * 1024 * 1024)           // Sequential pass
+#define SD_Bench_Chunk_Bytes    (32 * 1024)
+#define SD_Bench_Random_Bytes   4096
+#define SD_Bench_Random_Ops     256
+#define SD_Bench_Step_Ops       16                          // Random operations per I/O request, the player reads in between
+
+typedef struct {
+    uint8_t Width;                                          // Data lines in use, 0 while no card is mounted
+    uint32_t Freq_kHz;                                      // Clock the card runs at
+    bool DDR;
+    uint8_t Fallbacks;                                      // Faster modes that failed before this one
+} SD_Bus_Mode;
+
+typedef struct {
+    esp_err_t Result;
+    float Seq_Write_KBps;
+    float Seq_Read_KBps;
+    float Random_Write_IOPS;                                // SD_Bench_Random_Bytes each
+    float Random_Read_IOPS;
+} SD_Bench_Result;
 
 
 esp_err_t SD_Card_CS_EN(void);
 esp_err_t SD_Card_CS_Dis(void);
 
-esp_err_t s_example_write_file(const char *path, char *data);
-esp_err_t s_example_read_file(const char *path);
-
 extern uint32_t SDCard_Size;
 extern uint32_t Flash_Size;
-void SD_Init(void);
+extern SD_Bus_Mode SD_Mode;
+void SD_Init(void);                                         // Fastest bus mode that reads back clean, down to 1 line at 10 MHz
+// Cards coming and going after SD_Init(), see Card_Monitor.h. Listeners run on the SD monitor task and don't hear
+// Mounted for a card that was mounted before they subscribed, SD_Mode.Width tells them that
+bool SD_Subscribe(Card_Listener Function, void *Context);
+void SD_Check(void);                                        // After an I/O error, the card may be gone
+void SD_Eject(void);                                        // Finish with the card so it can be taken out
+Card_State SD_State(void);
+esp_err_t SD_Benchmark(SD_Bench_Result *Result);            // Takes seconds, not for the LVGL task. ESP_ERR_INVALID_STATE if the card went
+void SD_Benchmark_Start(void);                              // SD_Benchmark() in a task of its own
+bool SD_Benchmark_Take(SD_Bench_Result *Result);            // The result of the last start, once
 void Flash_Searching(void);
-FILE* Open_File(const char *file_path);
-uint16_t Folder_retrieval(const char* directory, const char* fileExtension, char File_Name[][100],uint16_t maxFiles);
\ No newline at end of file
+FILE* Open_File(const char *file_path);                     // Returns at once, a missing file shows as a read error
+// Lists Root on the I/O task in steps of SD_Scan_Step_Entries at Class, see Dir_Scan.h, and waits for the end. Batch
+// runs on the I/O task, keep it short. 0 or a negative errno, -ENODEV if the card went while it was listed
+int SD_Scan(const char *Root, const Dir_Filter *Filter, Io_Class Class, Dir_Batch Batch, void *Context, Dir_Scan_Stats *Stats);
\ No newline at end of file
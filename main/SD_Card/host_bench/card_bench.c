@@ -0,0 +1,464 @@
+/**
+ * Host bench for Card_Monitor, what SD_MMC does when a card comes and goes.
+ *
+ * The card is a simulated block device behind the same Card_Ops the firmware passes: a few
+ * sectors with a boot sector that does or does not carry a FAT signature, and faults that can
+ * be injected at any time:
+ *
+ *   pulled      the card is gone, CMD13 and init stop answering
+ *   bounce      for a while after going in, detection answers at random and mounts fail
+ *   glitch      the next few CMD13 fail with the card still there
+ *   mount       the next few mounts fail with read errors
+ *   blank       a card with no filesystem on it
+ *
+ * Two subscribers stand in for the player and the logger: one holds a file open while a card is
+ * mounted, the other writes on Ejecting and has to find the card still mounted. The ops check
+ * that Present is never called on a mounted card or Alive on an unmounted one, and that nothing
+ * is unmounted with a file still open. A blank card has to come out as blank as it went in.
+ *
+ * The checks run each fault on its own. The soak then runs -H hours of random pulls, inserts,
+ * glitches, ejects and blank cards and reports how long a removal and an insertion take to be
+ * noticed.
+ *
+ * usage: card_bench [-H hours] [-r seed]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Card_Monitor.h"
+
+#define USAGE "usage: %s [-H hours] [-r seed]\n"
+
+#define Sector_Bytes            512
+#define Sectors                 8
+
+static uint32_t failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+typedef struct {
+    uint8_t sectors[Sectors][Sector_Bytes];
+    bool inserted;
+    uint32_t bounce_until_ms;
+    uint32_t glitches;                                  // CMD13 that fail next
+    uint32_t mount_errors;                              // Mounts that fail next
+    bool mounted;
+    uint32_t mounts;
+    uint32_t mount_calls;
+    // Misuse seen by the ops
+    uint32_t present_mounted;
+    uint32_t alive_unmounted;
+    uint32_t unmount_open;
+} card_t;
+
+typedef struct {
+    uint32_t open_files;                                // Held by the player stand-in
+    uint32_t events[Card_Event_Unusable + 1];
+    uint32_t eject_writes_lost;                         // Ejecting came with the card already gone
+} subscribers_t;
+
+static uint32_t now_ms;
+static card_t card;
+static subscribers_t subs;
+static Card_Monitor monitor;
+
+static void card_format(card_t *c, bool fat)
+{
+    memset(c->sectors, 0, sizeof(c->sectors));
+    if (fat) {
+        memcpy(&c->sectors[0][3], "MSDOS5.0", 8);
+        c->sectors[0][510] = 0x55;
+        c->sectors[0][511] = 0xAA;
+    }
+}
+
+static void card_insert(bool fat, uint32_t bounce_ms)
+{
+    card_format(&card, fat);
+    card.inserted = true;
+    card.bounce_until_ms = now_ms + bounce_ms;
+}
+
+static bool bouncing(void)
+{
+    return (int32_t)(now_ms - card.bounce_until_ms) < 0;
+}
+
+static bool sim_present(void *context)
+{
+    card_t *c = context;
+    c->present_mounted += c->mounted;
+    if (!c->inserted) {
+        return false;
+    }
+    return bouncing() ? rand() & 1 : true;
+}
+
+static bool sim_alive(void *context)
+{
+    card_t *c = context;
+    c->alive_unmounted += !c->mounted;
+    if (!c->inserted) {
+        return false;
+    }
+    if (c->glitches) {
+        c->glitches--;
+        return false;
+    }
+    return true;
+}
+
+static Card_Mount_Result sim_mount(void *context)
+{
+    card_t *c = context;
+    c->mount_calls++;
+    if (!c->inserted || bouncing()) {
+        return Card_Mount_Error;
+    }
+    if (c->mount_errors) {
+        c->mount_errors--;
+        return Card_Mount_Error;
+    }
+    if (c->sectors[0][510] != 0x55 || c->sectors[0][511] != 0xAA) {
+        return Card_Mount_Unformatted;
+    }
+    c->mounted = true;
+    c->mounts++;
+    return Card_Mount_OK;
+}
+
+static void sim_unmount(void *context)
+{
+    card_t *c = context;
+    c->unmount_open += subs.open_files != 0;
+    c->mounted = false;
+}
+
+static const Card_Ops sim_ops = {
+    .Present = sim_present,
+    .Alive = sim_alive,
+    .Mount = sim_mount,
+    .Unmount = sim_unmount,
+};
+
+static void player(Card_Event event, void *context)
+{
+    subscribers_t *s = context;
+    s->events[event]++;
+    if (event == Card_Event_Mounted) {
+        s->open_files++;
+    } else if (event == Card_Event_Lost || event == Card_Event_Ejecting) {
+        s->open_files = 0;
+    }
+}
+
+static void logger(Card_Event event, void *context)
+{
+    subscribers_t *s = context;
+    if (event == Card_Event_Ejecting) {
+        s->eject_writes_lost += !card.inserted || !card.mounted;
+        card.sectors[1][0]++;                           // The last block, into a file
+    }
+}
+
+static void start(void)
+{
+    memset(&card, 0, sizeof(card));
+    memset(&subs, 0, sizeof(subs));
+    now_ms = 1000;
+    Card_Monitor_Init(&monitor, &sim_ops, &card);
+    CHECK(Card_Monitor_Subscribe(&monitor, player, &subs));
+    CHECK(Card_Monitor_Subscribe(&monitor, logger, &subs));
+}
+
+// Polls as the monitor task does, sleeping what each poll asks for
+static void advance(uint32_t ms)
+{
+    uint32_t end = now_ms + ms;
+    while (1) {
+        uint32_t wait = Card_Monitor_Poll(&monitor, now_ms);
+        if ((int32_t)(end - now_ms) < (int32_t)wait) {
+            now_ms = end;
+            return;
+        }
+        now_ms += wait;
+    }
+}
+
+// Until the monitor reaches State, the ms it took or UINT32_MAX
+static uint32_t until(Card_State state, uint32_t limit_ms)
+{
+    uint32_t begin = now_ms;
+    while (monitor.State != state) {
+        if (now_ms - begin >= limit_ms) {
+            return UINT32_MAX;
+        }
+        advance(10);
+    }
+    return now_ms - begin;
+}
+
+static void check_misuse(void)
+{
+    CHECK(card.present_mounted == 0);
+    CHECK(card.alive_unmounted == 0);
+    CHECK(card.unmount_open == 0);
+    CHECK(subs.open_files == (card.mounted ? 1 : 0));
+    CHECK(subs.eject_writes_lost == 0);
+}
+
+static void checks(void)
+{
+    const uint32_t remove_max = Card_Monitor_Poll_ms + (Card_Monitor_Misses - 1) * Card_Monitor_Recheck_ms;
+    const uint32_t insert_max = Card_Monitor_Poll_ms + Card_Monitor_Settle_ms;
+
+    // A card in at boot is mounted by the first poll
+    start();
+    card_insert(true, 0);
+    Card_Monitor_Poll(&monitor, now_ms);
+    CHECK(monitor.State == Card_State_Mounted && card.mounted);
+    CHECK(subs.events[Card_Event_Mounted] == 1);
+    check_misuse();
+
+    // None at boot, then one goes in
+    start();
+    advance(5000);
+    CHECK(monitor.State == Card_State_Absent);
+    CHECK(card.mount_calls == 0);
+    card_insert(true, 0);
+    CHECK(until(Card_State_Mounted, 10000) <= insert_max);
+    CHECK(subs.events[Card_Event_Mounted] == 1);
+    check_misuse();
+
+    // Pulled: Lost first, with the files closed before the unmount
+    card.inserted = false;
+    CHECK(until(Card_State_Absent, 10000) <= remove_max);
+    CHECK(subs.events[Card_Event_Lost] == 1 && !card.mounted);
+    CHECK(monitor.Stats.Removals == 1);
+    advance(30000);
+    CHECK(card.mount_calls == 1);                       // Nothing mounted while nothing answers
+    check_misuse();
+
+    // Glitches short of Card_Monitor_Misses are survived
+    start();
+    card_insert(true, 0);
+    advance(1000);
+    for (int i = 0; i < 20; i++) {
+        card.glitches = Card_Monitor_Misses - 1;
+        advance(5000);
+    }
+    CHECK(monitor.State == Card_State_Mounted);
+    CHECK(subs.events[Card_Event_Lost] == 0 && card.mounts == 1);
+    CHECK(monitor.Stats.Glitches == 20 * (Card_Monitor_Misses - 1));
+    card.glitches = Card_Monitor_Misses;                // A run that long is taken as removal, and it comes back
+    advance(3000);
+    CHECK(subs.events[Card_Event_Lost] == 1);
+    CHECK(until(Card_State_Mounted, 10000) != UINT32_MAX);
+    CHECK(card.mounts == 2);
+    check_misuse();
+
+    // An I/O error makes the next poll check at once
+    start();
+    card_insert(true, 0);
+    advance(500);
+    card.inserted = false;
+    Card_Monitor_Check(&monitor);
+    uint32_t begin = now_ms;
+    CHECK(until(Card_State_Absent, 10000) != UINT32_MAX);
+    CHECK(now_ms - begin <= (Card_Monitor_Misses - 1) * Card_Monitor_Recheck_ms + 10);
+    check_misuse();
+
+    // Contacts bouncing on the way in: one mount, after they settle
+    start();
+    advance(2000);
+    card_insert(true, 1500);
+    CHECK(until(Card_State_Mounted, 20000) != UINT32_MAX);
+    CHECK(now_ms >= card.bounce_until_ms);
+    CHECK(card.mounts == 1 && subs.events[Card_Event_Mounted] == 1);
+    advance(10000);
+    check_misuse();
+
+    // Mount errors are tried again, up to Card_Monitor_Mount_Tries
+    start();
+    advance(2000);
+    card.mount_errors = Card_Monitor_Mount_Tries - 1;
+    card_insert(true, 0);
+    CHECK(until(Card_State_Mounted, 20000) != UINT32_MAX);
+    CHECK(monitor.Stats.Mount_Errors == Card_Monitor_Mount_Tries - 1);
+    check_misuse();
+    start();
+    advance(2000);
+    card.mount_errors = Card_Monitor_Mount_Tries;
+    card_insert(true, 0);
+    CHECK(until(Card_State_Unusable, 20000) != UINT32_MAX);
+    CHECK(subs.events[Card_Event_Unusable] == 1);
+    advance(60000);
+    CHECK(card.mount_calls == Card_Monitor_Mount_Tries);   // Left alone until it is taken out
+    card.inserted = false;
+    advance(2000);
+    card_insert(true, 0);
+    CHECK(until(Card_State_Mounted, 10000) != UINT32_MAX);
+    check_misuse();
+
+    // A blank card is never formatted, it waits to be swapped for one that mounts
+    start();
+    card_insert(false, 0);
+    Card_Monitor_Poll(&monitor, now_ms);
+    CHECK(monitor.State == Card_State_Unusable);
+    CHECK(subs.events[Card_Event_Unusable] == 1);
+    advance(60000);
+    CHECK(card.mount_calls == 1);
+    for (int i = 0; i < Sector_Bytes; i++) {
+        CHECK(card.sectors[0][i] == 0);
+    }
+    card.inserted = false;
+    advance(2000);
+    card_insert(true, 0);
+    CHECK(until(Card_State_Mounted, 10000) != UINT32_MAX);
+    check_misuse();
+
+    // Eject: Ejecting with the card still in, then left alone until it is taken out
+    start();
+    card_insert(true, 0);
+    advance(3000);
+    Card_Monitor_Eject(&monitor);
+    Card_Monitor_Poll(&monitor, now_ms);
+    CHECK(monitor.State == Card_State_Ejected && !card.mounted);
+    CHECK(subs.events[Card_Event_Ejecting] == 1 && subs.events[Card_Event_Lost] == 0);
+    advance(30000);
+    CHECK(card.mounts == 1);
+    card.inserted = false;
+    CHECK(until(Card_State_Absent, 5000) != UINT32_MAX);
+    card_insert(true, 0);
+    CHECK(until(Card_State_Mounted, 10000) != UINT32_MAX);
+    CHECK(card.mounts == 2);
+    card.inserted = false;                              // Pulled before the eject was acted on, so lost after all
+    Card_Monitor_Eject(&monitor);
+    advance(0);
+    CHECK(monitor.State == Card_State_Absent && !card.mounted);
+    CHECK(subs.events[Card_Event_Ejecting] == 1 && subs.events[Card_Event_Lost] == 1);
+    card_insert(true, 0);
+    Card_Monitor_Eject(&monitor);                       // Only a mounted card is ejected, a stale request is dropped
+    advance(0);
+    CHECK(monitor.State != Card_State_Ejected);
+    CHECK(until(Card_State_Mounted, 10000) != UINT32_MAX);
+    check_misuse();
+
+    // Full subscriber list, start() takes two places
+    start();
+    for (int i = 2; i < Card_Monitor_Subscribers; i++) {
+        CHECK(Card_Monitor_Subscribe(&monitor, player, &subs));
+    }
+    CHECK(!Card_Monitor_Subscribe(&monitor, player, &subs));
+}
+
+static uint32_t random_ms(uint32_t low, uint32_t high)
+{
+    return low + (uint32_t)rand() % (high - low + 1);
+}
+
+static void soak(double hours)
+{
+    start();
+    card_insert(true, 0);
+    Card_Monitor_Poll(&monitor, now_ms);
+    uint64_t end = now_ms + (uint64_t)(hours * 3600000);
+    uint32_t pulls = 0, inserts = 0, glitch_runs = 0, ejects = 0, blanks = 0;
+    uint32_t remove_max = 0, insert_max = 0, spurious = 0;
+    uint64_t remove_sum = 0, insert_sum = 0;
+    while (now_ms < end) {
+        uint32_t lost = subs.events[Card_Event_Lost];
+        int fault = rand() % 100;
+        if (!card.inserted || monitor.State == Card_State_Ejected) {
+            if (card.inserted) {
+                card.inserted = false;                  // Taken out after the eject, no faster than a hand can
+                advance(random_ms(Card_Monitor_Poll_ms + 10, 5000));
+            }
+            bool blank = fault < 10;
+            blanks += blank;
+            inserts += !blank;
+            card_insert(!blank, fault < 40 ? random_ms(0, 800) : 0);
+            if (blank) {
+                advance(random_ms(5000, 60000));
+                CHECK(monitor.State == Card_State_Unusable);
+                card.inserted = false;
+            } else {
+                uint32_t took = until(Card_State_Mounted, 20000);
+                CHECK(took != UINT32_MAX);
+                if (took != UINT32_MAX) {
+                    uint32_t bounce = card.bounce_until_ms > now_ms - took ? card.bounce_until_ms - (now_ms - took) : 0;
+                    took = took > bounce ? took - bounce : 0;   // From the moment it could be read
+                    insert_sum += took;
+                    insert_max = took > insert_max ? took : insert_max;
+                }
+            }
+        } else if (fault < 20) {
+            pulls++;
+            card.inserted = false;
+            uint32_t took = until(Card_State_Absent, 20000);
+            CHECK(took != UINT32_MAX);
+            if (took != UINT32_MAX) {
+                remove_sum += took;
+                remove_max = took > remove_max ? took : remove_max;
+            }
+            lost++;
+        } else if (fault < 25) {
+            ejects++;
+            Card_Monitor_Eject(&monitor);
+            advance(0);
+            CHECK(monitor.State == Card_State_Ejected);
+        } else if (fault < 70) {
+            glitch_runs++;
+            card.glitches = random_ms(1, Card_Monitor_Misses - 1);
+        }
+        advance(random_ms(1000, 120000));
+        card.glitches = 0;
+        spurious += subs.events[Card_Event_Lost] - lost;
+        check_misuse();
+    }
+    CHECK(spurious == 0);
+    CHECK(remove_max <= Card_Monitor_Poll_ms + (Card_Monitor_Misses - 1) * Card_Monitor_Recheck_ms);
+    CHECK(insert_max <= Card_Monitor_Poll_ms + Card_Monitor_Settle_ms + (Card_Monitor_Settle_ms << 1));
+    printf("%.1f hours: %u pulls, %u inserts, %u blank cards, %u ejects, %u glitch runs, %u lost to glitches\n",
+           hours, pulls, inserts, blanks, ejects, glitch_runs, spurious);
+    printf("removal noticed in %.0f ms on average, %u ms at most\n", pulls ? (double)remove_sum / pulls : 0.0,
+           remove_max);
+    printf("insertion mounted in %.0f ms on average, %u ms at most\n", inserts ? (double)insert_sum / inserts : 0.0,
+           insert_max);
+    printf("%u mounts, %u removals, %u glitches survived, %u mount errors\n", monitor.Stats.Mounts,
+           monitor.Stats.Removals, monitor.Stats.Glitches, monitor.Stats.Mount_Errors);
+}
+
+int main(int argc, char **argv)
+{
+    double hours = 24;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-H") && i + 1 < argc) {
+            hours = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (hours <= 0) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    srand(seed);
+    checks();
+    soak(hours);
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,481 @@
+/**
+ * Host bench for Dir_Scan, how SD_MMC lists directories.
+ *
+ * The checks build a small tree in a temporary directory and list it with each filter: an
+ * extension set, a name pattern, the depth limit, hidden entries and directories, a path too long
+ * to take, a batch that stops the scan and a scan taken in small steps, which has to hand over the
+ * same entries as one taken in one go. Batches never hold more than Dir_Scan_Batch entries and
+ * nothing is stat()ed, the host's file systems fill d_type as FAT does. "/" as the root has to
+ * open its directories as "/name", FAT's VFS takes no "//name".
+ *
+ * The timing fills one directory with -n files with names -l characters long, a quarter of them
+ * tracks, and lists it three ways:
+ *
+ *   folder loop     what Folder_retrieval did: readdir, strrchr, snprintf of the path and a printf
+ *                   for each track, the printing into /dev/null here and at 115200 baud on the board
+ *   stat walk       readdir and a stat() of each entry, how a walker tells files from directories
+ *   Dir_Scan        batched, filtered on the extension, no stat
+ *
+ * and prints entries a second for each, plus the console time the folder loop costs on the board.
+ *
+ * usage: dir_bench [-n files] [-l name_length, 12 to 230] [-r rounds] [directory]
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Dir_Scan.h"
+
+#define USAGE "usage: %s [-n files] [-l name_length] [-r rounds] [directory]\n"
+
+#define Console_Baud            115200
+#define Bits_Per_Byte           10                          // Start and stop bit
+
+static uint32_t failures = 0;
+static uint32_t stat_calls = 0;
+static uint32_t double_slashes = 0;                         // Directories opened with "//" in the path
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+int __real_stat(const char *path, struct stat *st);
+
+int __wrap_stat(const char *path, struct stat *st)
+{
+    stat_calls++;
+    return __real_stat(path, st);
+}
+
+DIR *__real_opendir(const char *path);
+
+DIR *__wrap_opendir(const char *path)
+{
+    if (strstr(path, "//")) {
+        double_slashes++;
+    }
+    return __real_opendir(path);
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void make_file(const char *dir, const char *name)
+{
+    char path[1024 + Dir_Scan_Path_Max];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "can't create %s: %s\n", path, strerror(errno));
+        exit(2);
+    }
+    close(fd);
+}
+
+static void make_dir(const char *dir, const char *name)
+{
+    char path[1024 + Dir_Scan_Path_Max];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "can't create %s: %s\n", path, strerror(errno));
+        exit(2);
+    }
+}
+
+static void remove_tree(const char *path)
+{
+    DIR *dir = opendir(path);
+    if (!dir) {
+        unlink(path);
+        return;
+    }
+    struct dirent *entry;
+    char child[1024];
+    while ((entry = readdir(dir))) {
+        if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, "..")) {
+            snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+            remove_tree(child);
+        }
+    }
+    closedir(dir);
+    rmdir(path);
+}
+
+/* ---- Checks ---- */
+
+#define Listed_Max              64
+
+typedef struct {
+    char path[Dir_Scan_Path_Max];
+    bool directory;
+    uint8_t depth;
+} listed_t;
+
+typedef struct {
+    listed_t entries[Listed_Max];
+    uint32_t count;
+    uint32_t batches;
+    uint32_t biggest;                                   // Entries in one batch
+    uint32_t stop_after;                                // Entries, 0 for all
+    bool names_ok;                                      // Name points at the last component
+} listing_t;
+
+static bool collect(const Dir_Entry *entries, uint32_t count, const Dir_Scan_Stats *progress, void *context)
+{
+    listing_t *l = context;
+    l->batches++;
+    l->biggest = count > l->biggest ? count : l->biggest;
+    for (uint32_t i = 0; i < count; i++) {
+        const char *name = entries[i].Path + entries[i].Name;
+        if (strchr(name, '/') || (entries[i].Name && entries[i].Path[entries[i].Name - 1] != '/')) {
+            l->names_ok = false;
+        }
+        if (l->count < Listed_Max) {
+            strcpy(l->entries[l->count].path, entries[i].Path);
+            l->entries[l->count].directory = entries[i].Directory;
+            l->entries[l->count].depth = entries[i].Depth;
+        }
+        l->count++;
+    }
+    CHECK(progress->Matched == l->count);
+    return !l->stop_after || l->count < l->stop_after;
+}
+
+static int compare_paths(const void *a, const void *b)
+{
+    return strcmp(((const listed_t *)a)->path, ((const listed_t *)b)->path);
+}
+
+// Sorted, readdir order is the file system's
+static int list(const char *root, const Dir_Filter *filter, listing_t *l, Dir_Scan_Stats *stats, uint32_t step)
+{
+    uint32_t stop_after = l->stop_after;
+    memset(l, 0, sizeof(*l));
+    l->stop_after = stop_after;
+    l->names_ok = true;
+    int ret;
+    if (step) {
+        Dir_Scan *scan = malloc(sizeof(Dir_Scan));
+        ret = Dir_Scan_Open(scan, root, filter, collect, l);
+        while (ret == 0 && Dir_Scan_Step(scan, step)) {
+        }
+        *stats = scan->Stats;
+        free(scan);
+    } else {
+        ret = Dir_Scan_Run(root, filter, collect, l, stats);
+    }
+    qsort(l->entries, l->count < Listed_Max ? l->count : Listed_Max, sizeof(listed_t), compare_paths);
+    CHECK(l->names_ok);
+    CHECK(l->biggest <= Dir_Scan_Batch);
+    return ret;
+}
+
+static const listed_t *listed(const listing_t *l, const char *path)
+{
+    for (uint32_t i = 0; i < l->count && i < Listed_Max; i++) {
+        if (!strcmp(l->entries[i].path, path)) {
+            return &l->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void checks(void)
+{
+    char root[] = "/tmp/dir_bench.XXXXXX";
+    if (!mkdtemp(root)) {
+        fprintf(stderr, "can't create a temporary directory: %s\n", strerror(errno));
+        exit(2);
+    }
+    char path[1024];
+    make_file(root, "a.mp3");
+    make_file(root, "B.MP3");
+    make_file(root, "c.wav");
+    make_file(root, "notes.txt");
+    make_file(root, "mp3");
+    make_file(root, ".hidden.mp3");
+    make_dir(root, "Album");
+    make_dir(root, "System Volume Information");
+    make_file(root, "System Volume Information/x.mp3");
+    snprintf(path, sizeof(path), "%s/Album", root);
+    make_file(path, "01 Intro.mp3");
+    make_file(path, "02 Song.flac");
+    make_dir(path, "Disc 2");
+    snprintf(path, sizeof(path), "%s/Album/Disc 2", root);
+    make_file(path, "01 Outro.mp3");
+    char long_name[Dir_Scan_Path_Max];
+    memset(long_name, 'n', 240);
+    strcpy(long_name + 240, ".mp3");                    // Fits the host, not Dir_Scan_Path_Max under the root
+    make_file(path, long_name);
+
+    listing_t *l = calloc(1, sizeof(listing_t));
+    Dir_Scan_Stats stats;
+    stat_calls = 0;
+
+    // The root alone, one extension, case ignored, with and without its dot
+    Dir_Filter filter = { .Extensions = ".mp3" };
+    CHECK(list(root, &filter, l, &stats, 0) == 0);
+    CHECK(l->count == 2 && listed(l, "B.MP3") && listed(l, "a.mp3"));
+    CHECK(stats.Directories == 1 && stats.Skipped == 1 && stats.Stats == 0);     // Album, not walked
+    filter.Extensions = "mp3";
+    CHECK(list(root, &filter, l, &stats, 0) == 0 && l->count == 2);
+
+    // An extension set and the whole tree
+    filter = (Dir_Filter){ .Extensions = ".mp3, .wav;.flac", .Depth = Dir_Scan_Depth_Max };
+    CHECK(list(root, &filter, l, &stats, 0) == 0);
+    CHECK(l->count == 6);
+    CHECK(listed(l, "c.wav") && listed(l, "Album/02 Song.flac") && listed(l, "Album/Disc 2/01 Outro.mp3"));
+    CHECK(!listed(l, "notes.txt") && !listed(l, "mp3") && !listed(l, ".hidden.mp3"));
+    CHECK(stats.Directories == 3 && stats.Skipped == 1);    // The long name
+    CHECK(listed(l, "Album/01 Intro.mp3")->depth == 1 && listed(l, "a.mp3")->depth == 0);
+
+    // The depth limit, directories handed over too
+    filter = (Dir_Filter){ .Depth = 1, .Directories = true };
+    CHECK(list(root, &filter, l, &stats, 0) == 0);
+    CHECK(listed(l, "Album") && listed(l, "Album/Disc 2") && listed(l, "notes.txt"));
+    CHECK(!listed(l, "Album/Disc 2/01 Outro.mp3"));
+    CHECK(listed(l, "Album")->directory && listed(l, "Album")->depth == 0);
+    CHECK(!listed(l, "notes.txt")->directory && stats.Skipped == 1);            // Disc 2, not walked
+
+    // Hidden entries on request
+    filter = (Dir_Filter){ .Extensions = ".mp3", .Depth = 1, .Hidden = true };
+    CHECK(list(root, &filter, l, &stats, 0) == 0);
+    CHECK(listed(l, ".hidden.mp3") && listed(l, "System Volume Information/x.mp3"));
+
+    // A pattern on the name
+    filter = (Dir_Filter){ .Pattern = "0?*o*.MP3", .Depth = Dir_Scan_Depth_Max };
+    CHECK(list(root, &filter, l, &stats, 0) == 0);
+    CHECK(l->count == 2 && listed(l, "Album/01 Intro.mp3") && listed(l, "Album/Disc 2/01 Outro.mp3"));
+    CHECK(Dir_Scan_Match("*", ""));
+    CHECK(Dir_Scan_Match("a*b*c", "aXbYbZc"));
+    CHECK(!Dir_Scan_Match("a*b*c", "aXbYbZ"));
+    CHECK(Dir_Scan_Match("*.mp3", "x.mp3.mp3"));
+    CHECK(!Dir_Scan_Match("?", ""));
+    CHECK(Dir_Scan_Match("TRACK??.*", "track01.wav"));
+
+    // Small steps give what one go gives
+    filter = (Dir_Filter){ .Depth = Dir_Scan_Depth_Max, .Directories = true, .Hidden = true };
+    CHECK(list(root, &filter, l, &stats, 0) == 0);
+    listing_t *whole = malloc(sizeof(listing_t));
+    memcpy(whole, l, sizeof(listing_t));
+    for (uint32_t step = 1; step <= 4; step++) {
+        CHECK(list(root, &filter, l, &stats, step) == 0);
+        CHECK(l->count == whole->count && !memcmp(l->entries, whole->entries, sizeof(l->entries)));
+    }
+
+    // Bad arguments
+    snprintf(path, sizeof(path), "%s/missing", root);
+    CHECK(list(path, &filter, l, &stats, 0) == -ENOENT);
+    filter.Extensions = ".a .b .c .d .e .f .g .h .i";
+    CHECK(list(root, &filter, l, &stats, 0) == -EINVAL);
+    filter.Extensions = ".toolong";
+    CHECK(list(root, &filter, l, &stats, 0) == -EINVAL);
+    snprintf(path, sizeof(path), "%s/", root);          // A trailing slash changes nothing
+    filter = (Dir_Filter){ .Extensions = ".mp3" };
+    CHECK(list(path, &filter, l, &stats, 0) == 0 && listed(l, "a.mp3"));
+
+    // "/" as the root, down to the temporary directory. Its slash is the one paths are joined with
+    filter = (Dir_Filter){ .Pattern = strrchr(root, '/') + 1, .Depth = 1, .Directories = true };
+    CHECK(list("/", &filter, l, &stats, 0) == 0 && listed(l, root + 1));
+    CHECK(double_slashes == 0);
+
+    // Batches fill to Dir_Scan_Batch and go early once their paths run out
+    snprintf(path, sizeof(path), "%s/many", root);
+    make_dir(root, "many");
+    char name[Dir_Scan_Path_Max];
+    for (int i = 0; i < 100; i++) {
+        snprintf(name, sizeof(name), "%03d_%0150d.mp3", i, 0);
+        make_file(path, name);
+    }
+    filter = (Dir_Filter){ .Extensions = ".mp3" };
+    CHECK(list(path, &filter, l, &stats, 0) == 0);
+    CHECK(l->count == 100 && l->batches > 100 / Dir_Scan_Batch + 1);
+    uint32_t per_batch = Dir_Scan_Batch_Bytes / (strlen(name) + 1);
+    CHECK(l->biggest == per_batch);
+
+    // A batch that has enough stops it
+    l->stop_after = 40;
+    CHECK(list(path, &filter, l, &stats, 5) == 0);
+    uint32_t batches = (40 + per_batch - 1) / per_batch;
+    CHECK(l->batches == batches && l->count == batches * per_batch && stats.Matched == l->count);
+    l->stop_after = 0;
+
+    CHECK(stat_calls == 0);
+    free(whole);
+    free(l);
+    remove_tree(root);
+}
+
+/* ---- Timing ---- */
+
+static uint64_t console_bytes;
+static FILE *console;
+
+// Folder_retrieval before Dir_Scan, the printf going where the console would be
+static uint32_t folder_loop(const char *directory, const char *extension)
+{
+    DIR *dir = opendir(directory);
+    if (!dir) {
+        return 0;
+    }
+    uint32_t count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        const char *dot = strrchr(entry->d_name, '.');
+        if (dot != NULL && dot != entry->d_name && strcasecmp(dot, extension) == 0) {
+            char file_path[512];
+            snprintf(file_path, sizeof(file_path), "%s/%s", directory, entry->d_name);
+            console_bytes += fprintf(console, "File found: %s\r\n", file_path);
+            count++;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+static uint32_t stat_walk(const char *directory, const char *extension)
+{
+    DIR *dir = opendir(directory);
+    if (!dir) {
+        return 0;
+    }
+    uint32_t count = 0;
+    struct dirent *entry;
+    char file_path[512];
+    size_t extension_length = strlen(extension);
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(file_path, sizeof(file_path), "%s/%s", directory, entry->d_name);
+        struct stat st;
+        size_t length = strlen(entry->d_name);
+        if (stat(file_path, &st) == 0 && S_ISREG(st.st_mode) && length > extension_length &&
+            strcasecmp(entry->d_name + length - extension_length, extension) == 0) {
+            count++;
+        }
+    }
+    closedir(dir);
+    return count;
+}
+
+static bool count_batch(const Dir_Entry *entries, uint32_t count, const Dir_Scan_Stats *progress, void *context)
+{
+    (void)entries;
+    (void)progress;
+    *(uint32_t *)context += count;
+    return true;
+}
+
+static void timing(const char *directory, uint32_t files, uint32_t name_length, uint32_t rounds)
+{
+    char root[1024];
+    bool made = !directory;
+    if (made) {
+        strcpy(root, "/tmp/dir_bench.XXXXXX");
+        if (!mkdtemp(root)) {
+            fprintf(stderr, "can't create a temporary directory: %s\n", strerror(errno));
+            exit(2);
+        }
+        char *name = malloc(name_length + 1);
+        for (uint32_t i = 0; i < files; i++) {
+            int n = snprintf(name, name_length + 1, "%06u_", i);           // Long names need no unique tail
+            memset(name + n, 'a' + i % 26, name_length - n - 4);
+            strcpy(name + name_length - 4, i % 4 ? ".txt" : ".mp3");
+            make_file(root, name);
+        }
+        free(name);
+        directory = root;
+    }
+    console = fopen("/dev/null", "w");
+    Dir_Filter filter = { .Extensions = ".mp3" };
+    double best[3] = { 1e30, 1e30, 1e30 };
+    uint32_t found[3] = { 0 };
+    uint32_t stats_before = stat_calls;
+    Dir_Scan_Stats stats = { 0 };
+    for (uint32_t r = 0; r < rounds; r++) {
+        double t = now_us();
+        console_bytes = 0;
+        found[0] = folder_loop(directory, ".mp3");
+        t = now_us() - t;
+        best[0] = t < best[0] ? t : best[0];
+
+        t = now_us();
+        found[1] = stat_walk(directory, ".mp3");
+        t = now_us() - t;
+        best[1] = t < best[1] ? t : best[1];
+
+        t = now_us();
+        found[2] = 0;
+        stats_before = stat_calls;
+        CHECK(Dir_Scan_Run(directory, &filter, count_batch, &found[2], &stats) == 0);
+        t = now_us() - t;
+        best[2] = t < best[2] ? t : best[2];
+        CHECK(stat_calls == stats_before);
+    }
+    fclose(console);
+    CHECK(found[0] == found[2] && found[1] == found[2]);
+
+    uint32_t entries = stats.Entries;
+    printf("%u entries, %u tracks, best of %u\n", entries, found[2], rounds);
+    static const char *Ways[] = { "folder loop", "stat walk", "Dir_Scan" };
+    for (int w = 0; w < 3; w++) {
+        printf("%-12s %10.0f entries/s %8.2f ms\n", Ways[w], entries / best[w] * 1e6, best[w] / 1000);
+    }
+    printf("folder loop printed %llu bytes, %.1f s of console at %u baud on the board\n",
+           (unsigned long long)console_bytes, console_bytes * Bits_Per_Byte / (double)Console_Baud, Console_Baud);
+    printf("Dir_Scan handed over %u batches\n", stats.Batches);
+    if (made) {
+        remove_tree(root);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t files = 20000;
+    uint32_t name_length = 120;
+    uint32_t rounds = 5;
+    const char *directory = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            files = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-l") && i + 1 < argc) {
+            name_length = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            rounds = strtoul(argv[++i], NULL, 0);
+        } else if (argv[i][0] != '-' && !directory) {
+            directory = argv[i];
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (!files || name_length < 12 || name_length > 230 || !rounds) {   // Under Dir_Scan_Path_Max with the root
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    checks();
+    timing(directory, files, name_length, rounds);
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
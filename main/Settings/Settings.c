@@ -0,0 +1,219 @@
+#include "Settings.h"
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "Shutdown.h"
+
+static const char *TAG = "SETTINGS";
+
+// Where the Wi-Fi credentials were before the blob, read once when there is no blob yet and left in place
+#define Legacy_Wifi_Namespace   "wifi_cfg"
+#define Legacy_Wifi_Key_SSID    "ssid"
+#define Legacy_Wifi_Key_Pass    "pass"
+
+static Settings_Store Store;
+static Settings_Stats Stats = { 0 };
+static SemaphoreHandle_t Settings_Mutex = NULL;             // Store and Stats
+static SemaphoreHandle_t Commit_Mutex;                      // One commit at a time, so an older blob never lands last
+static nvs_handle_t Handle;
+static bool Handle_Open = false;
+
+static uint32_t Now_ms(void)
+{
+    return esp_timer_get_time() / 1000;
+}
+
+static bool Load_Legacy(void)
+{
+    nvs_handle_t legacy;
+    char ssid[33];
+    char password[65] = "";
+    if (nvs_open(Legacy_Wifi_Namespace, NVS_READONLY, &legacy) != ESP_OK) {
+        return false;
+    }
+    size_t length = sizeof(ssid);
+    bool found = nvs_get_str(legacy, Legacy_Wifi_Key_SSID, ssid, &length) == ESP_OK;
+    length = sizeof(password);
+    if (found && nvs_get_str(legacy, Legacy_Wifi_Key_Pass, password, &length) != ESP_OK) {
+        password[0] = '\0';
+    }
+    nvs_close(legacy);
+    if (found) {
+        Settings_Store_Set_String(&Store, Setting_Wifi_SSID, ssid, Now_ms());
+        Settings_Store_Set_String(&Store, Setting_Wifi_Password, password, Now_ms());
+    }
+    return found;
+}
+
+// Whatever the debounce still holds, before the power goes
+static bool Settings_Shutdown(uint32_t Timeout_ms, void *Context)
+{
+    return Settings_Flush();
+}
+
+void Settings_Init(void)
+{
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        ret = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(ret);
+
+    Settings_Store_Init(&Store);
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    Commit_Mutex = xSemaphoreCreateMutex();
+    if (!mutex || !Commit_Mutex) {
+        ESP_LOGE(TAG, "Out of memory, settings stay at their defaults");
+        return;
+    }
+    ret = nvs_open(Settings_Namespace, NVS_READWRITE, &Handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Can't open NVS (%s), settings won't be saved", esp_err_to_name(ret));
+    }
+    Handle_Open = ret == ESP_OK;
+
+    // The whole blob in one read, nothing is looked up key by key later
+    uint8_t blob[Settings_Blob_Max];
+    size_t bytes = sizeof(blob);
+    int64_t start = esp_timer_get_time();
+    ret = Handle_Open ? nvs_get_blob(Handle, Settings_Key, blob, &bytes) : ESP_ERR_NVS_INVALID_HANDLE;
+    Settings_Load_Result result = ret == ESP_OK ? Settings_Store_Load(&Store, blob, bytes) : Settings_Defaults;
+    int64_t took = esp_timer_get_time() - start;
+    if (result == Settings_Defaults && Load_Legacy()) {
+        result = Settings_Upgraded;
+    }
+    if (result == Settings_Upgraded) {
+        Settings_Store_Retry(&Store, Now_ms());             // Saved in the current form once due
+    }
+    static const char *Results[] = { "loaded", "upgraded", "at defaults" };
+    ESP_LOGI(TAG, "%u bytes %s in %lld us (%s): backlight %u, volume %u", ret == ESP_OK ? (unsigned)bytes : 0,
+             Results[result], took, esp_err_to_name(ret), Settings_Store_Get(&Store, Setting_Backlight),
+             Settings_Store_Get(&Store, Setting_Volume));
+    Settings_Mutex = mutex;                                 // Callers see defaults until this is set
+    Shutdown_Register("settings", Shutdown_Phase_Save, Settings_Shutdown_ms, Settings_Shutdown, NULL);
+}
+
+// Serialized under the mutex and written outside it, so a setter never waits on flash
+static bool Commit(void)
+{
+    uint8_t blob[Settings_Blob_Max];
+    xSemaphoreTake(Commit_Mutex, portMAX_DELAY);
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    bool dirty = Store.Dirty;
+    uint32_t changes = Store.Changes;
+    size_t bytes = Settings_Store_Save(&Store, blob, sizeof(blob));
+    Settings_Store_Saved(&Store);
+    xSemaphoreGive(Settings_Mutex);
+    if (!dirty) {
+        xSemaphoreGive(Commit_Mutex);
+        return true;                                        // Another commit got there first
+    }
+
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = bytes ? nvs_set_blob(Handle, Settings_Key, blob, bytes) : ESP_ERR_INVALID_SIZE;
+    if (ret == ESP_OK) {
+        ret = nvs_commit(Handle);
+    }
+    int64_t took = esp_timer_get_time() - start;
+
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    if (ret == ESP_OK) {
+        Stats.Commits++;
+        Stats.Commit_Bytes += bytes;
+        Stats.Commit_us += took;
+    } else {
+        Stats.Errors++;
+        Settings_Store_Retry(&Store, Now_ms());
+    }
+    Settings_Stats stats = Stats;
+    xSemaphoreGive(Settings_Mutex);
+    xSemaphoreGive(Commit_Mutex);
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Commit failed (%s), trying again later", esp_err_to_name(ret));
+        return false;
+    }
+    ESP_LOGI(TAG, "Committed %u bytes in %lld us for %lu changes, %lu changes in %lu commits since boot",
+             (unsigned)bytes, took, changes, stats.Changes, stats.Commits);
+    return true;
+}
+
+void Settings_Loop(void)
+{
+    if (!Settings_Mutex || !Handle_Open) {
+        return;
+    }
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    bool due = Settings_Store_Due(&Store, Now_ms());
+    xSemaphoreGive(Settings_Mutex);
+    if (due) {
+        Commit();
+    }
+}
+
+bool Settings_Flush(void)
+{
+    if (!Settings_Mutex || !Handle_Open) {
+        return false;
+    }
+    return Commit();
+}
+
+uint8_t Settings_Get(Setting_Id Id)
+{
+    if (!Settings_Mutex) {
+        return Settings_Table[Id].Default;
+    }
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    uint8_t value = Settings_Store_Get(&Store, Id);
+    xSemaphoreGive(Settings_Mutex);
+    return value;
+}
+
+void Settings_Get_String(Setting_Id Id, char *Value, size_t Size)
+{
+    if (!Settings_Mutex) {
+        Value[0] = '\0';
+        return;
+    }
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    strlcpy(Value, Settings_Store_Get_String(&Store, Id), Size);
+    xSemaphoreGive(Settings_Mutex);
+}
+
+void Settings_Set(Setting_Id Id, uint8_t Value)
+{
+    if (!Settings_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    Stats.Changes += Settings_Store_Set(&Store, Id, Value, Now_ms());
+    xSemaphoreGive(Settings_Mutex);
+}
+
+void Settings_Set_String(Setting_Id Id, const char *Value)
+{
+    if (!Settings_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    Stats.Changes += Settings_Store_Set_String(&Store, Id, Value, Now_ms());
+    xSemaphoreGive(Settings_Mutex);
+}
+
+void Settings_Get_Stats(Settings_Stats *Stats_Out)
+{
+    memset(Stats_Out, 0, sizeof(*Stats_Out));
+    if (!Settings_Mutex) {
+        return;
+    }
+    xSemaphoreTake(Settings_Mutex, portMAX_DELAY);
+    *Stats_Out = Stats;
+    xSemaphoreGive(Settings_Mutex);
+}
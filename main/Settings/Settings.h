@@ -0,0 +1,30 @@
+#pragma once
+
+// Settings kept across power cycles, read from NVS in one go at boot and written back as one blob a while after
+// they stop changing (Settings_Store.h). Setters only touch RAM, they are safe from any task including LVGL's.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Settings_Store.h"
+
+#define Settings_Namespace      "settings"
+#define Settings_Key            "blob"
+#define Settings_Shutdown_ms    200                         // An NVS commit of the blob, with room to spare
+
+typedef struct {
+    uint32_t Changes;                                       // Set calls that changed something
+    uint32_t Commits;                                       // Blobs written to NVS
+    uint32_t Commit_Bytes;
+    uint32_t Errors;
+    uint64_t Commit_us;
+} Settings_Stats;
+
+void Settings_Init(void);                                   // First thing in app_main, it brings up NVS for everyone
+void Settings_Loop(void);                                   // From Driver_Loop, commits what is due
+bool Settings_Flush(void);                                  // Commits now, true once nothing is left unsaved
+
+uint8_t Settings_Get(Setting_Id Id);
+void Settings_Get_String(Setting_Id Id, char *Value, size_t Size);
+void Settings_Set(Setting_Id Id, uint8_t Value);
+void Settings_Set_String(Setting_Id Id, const char *Value);
+void Settings_Get_Stats(Settings_Stats *Stats);
@@ -0,0 +1,157 @@
+#include "Settings_Store.h"
+
+#include <string.h>
+
+const Setting_Info Settings_Table[Settings_Count] = {
+    [Setting_Backlight]     = { Setting_U8, 0, 5, 100, 70 },    // Backlight_MAX, LCD_Backlight at boot
+    [Setting_Volume]        = { Setting_U8, 1, 0, 100, 98 },    // Volume_MAX, Volume at boot
+    [Setting_Wifi_SSID]     = { Setting_String, 2, 0, 33, 0 },
+    [Setting_Wifi_Password] = { Setting_String, 35, 0, 65, 0 },
+};
+
+static uint8_t Clamp(Setting_Id Id, uint8_t Value)
+{
+    const Setting_Info *info = &Settings_Table[Id];
+    return Value < info->Min ? info->Min : (Value > info->Max ? info->Max : Value);
+}
+
+void Settings_Store_Init(Settings_Store *Store)
+{
+    memset(Store, 0, sizeof(*Store));
+    for (int id = 0; id < Settings_Count; id++) {
+        if (Settings_Table[id].Type == Setting_U8) {
+            Store->Values[Settings_Table[id].Offset] = Settings_Table[id].Default;
+        }
+    }
+}
+
+Settings_Load_Result Settings_Store_Load(Settings_Store *Store, const uint8_t *Blob, size_t Bytes)
+{
+    Settings_Header header;
+    Settings_Store_Init(Store);
+    if (Bytes < sizeof(header)) {
+        return Settings_Defaults;
+    }
+    memcpy(&header, Blob, sizeof(header));
+    if (header.Magic != Settings_Magic || header.Bytes > Bytes - sizeof(header)) {
+        return Settings_Defaults;
+    }
+
+    // A cut entry ends the walk, the ones before it are kept
+    const uint8_t *entry = Blob + sizeof(header);
+    const uint8_t *end = entry + header.Bytes;
+    while (end - entry >= 2 && end - entry - 2 >= entry[1]) {
+        uint8_t id = entry[0];
+        uint8_t length = entry[1];
+        const uint8_t *value = entry + 2;
+        if (id >= Settings_Count) {
+            if (Store->Extra_Bytes + 2 + length <= Settings_Extra_Max) {
+                memcpy(Store->Extra + Store->Extra_Bytes, entry, 2 + length);
+                Store->Extra_Bytes += 2 + length;
+            }
+        } else if (Settings_Table[id].Type == Setting_U8) {
+            if (length == 1) {
+                Store->Values[Settings_Table[id].Offset] = Clamp(id, value[0]);
+            }
+        } else {
+            char *text = (char *)Store->Values + Settings_Table[id].Offset;
+            size_t copied = length < Settings_Table[id].Max ? length : Settings_Table[id].Max - 1u;
+            memcpy(text, value, copied);
+            text[copied] = '\0';
+        }
+        entry += 2 + length;
+    }
+
+    // Conversions for settings whose meaning changed go here, oldest first
+    return header.Version < Settings_Version ? Settings_Upgraded : Settings_Loaded;
+}
+
+size_t Settings_Store_Save(const Settings_Store *Store, uint8_t *Blob, size_t Max)
+{
+    Settings_Header header = { .Magic = Settings_Magic, .Version = Settings_Version };
+    size_t used = sizeof(header);
+    for (int id = 0; id < Settings_Count; id++) {
+        const uint8_t *value = Store->Values + Settings_Table[id].Offset;
+        size_t length = Settings_Table[id].Type == Setting_U8 ? 1 : strlen((const char *)value);
+        if (used + 2 + length > Max) {
+            return 0;
+        }
+        Blob[used] = id;
+        Blob[used + 1] = length;
+        memcpy(Blob + used + 2, value, length);
+        used += 2 + length;
+    }
+    if (used + Store->Extra_Bytes > Max) {
+        return 0;
+    }
+    memcpy(Blob + used, Store->Extra, Store->Extra_Bytes);
+    used += Store->Extra_Bytes;
+    header.Bytes = used - sizeof(header);
+    memcpy(Blob, &header, sizeof(header));
+    return used;
+}
+
+void Settings_Store_Saved(Settings_Store *Store)
+{
+    Store->Dirty = false;
+    Store->Changes = 0;
+}
+
+// Debounced from the last change, but no later than Settings_Delay_Max_ms after the first
+static void Changed(Settings_Store *Store, uint32_t Now_ms)
+{
+    if (!Store->Dirty) {
+        Store->Dirty = true;
+        Store->First_ms = Now_ms;
+    }
+    Store->Changes++;
+    uint32_t due = Now_ms + Settings_Debounce_ms;
+    uint32_t latest = Store->First_ms + Settings_Delay_Max_ms;
+    Store->Due_ms = (int32_t)(due - latest) > 0 ? latest : due;
+}
+
+void Settings_Store_Retry(Settings_Store *Store, uint32_t Now_ms)
+{
+    Changed(Store, Now_ms);
+}
+
+uint8_t Settings_Store_Get(const Settings_Store *Store, Setting_Id Id)
+{
+    return Store->Values[Settings_Table[Id].Offset];
+}
+
+const char *Settings_Store_Get_String(const Settings_Store *Store, Setting_Id Id)
+{
+    return (const char *)Store->Values + Settings_Table[Id].Offset;
+}
+
+bool Settings_Store_Set(Settings_Store *Store, Setting_Id Id, uint8_t Value, uint32_t Now_ms)
+{
+    uint8_t *stored = Store->Values + Settings_Table[Id].Offset;
+    Value = Clamp(Id, Value);
+    if (*stored == Value) {
+        return false;
+    }
+    *stored = Value;
+    Changed(Store, Now_ms);
+    return true;
+}
+
+bool Settings_Store_Set_String(Settings_Store *Store, Setting_Id Id, const char *Value, uint32_t Now_ms)
+{
+    char *stored = (char *)Store->Values + Settings_Table[Id].Offset;
+    const char *end = memchr(Value, '\0', Settings_Table[Id].Max - 1u);
+    size_t length = end ? (size_t)(end - Value) : Settings_Table[Id].Max - 1u;
+    if (strncmp(stored, Value, length) == 0 && stored[length] == '\0') {
+        return false;
+    }
+    memcpy(stored, Value, length);
+    stored[length] = '\0';
+    Changed(Store, Now_ms);
+    return true;
+}
+
+bool Settings_Store_Due(const Settings_Store *Store, uint32_t Now_ms)
+{
+    return Store->Dirty && (int32_t)(Now_ms - Store->Due_ms) >= 0;
+}
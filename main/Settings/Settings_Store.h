@@ -0,0 +1,79 @@
+#pragma once
+
+// The settings in RAM and their saved form, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// Everything is saved as one blob: a header, then an Id, a length and the value for each setting. A setting the
+// blob lacks keeps its default and one the firmware doesn't know is kept as it is and written back, so going to
+// older firmware and back loses nothing. Version is for a setting whose meaning changes, Load converts those.
+// A change is saved Settings_Debounce_ms after the last one, a slider dragged back and forth is one write, but no
+// later than Settings_Delay_Max_ms after the first so one that keeps moving is saved too.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Settings_Magic          0x31475453                  // "STG1"
+#define Settings_Version        1
+#define Settings_Blob_Max       256
+#define Settings_Extra_Max      64                          // Bytes of unknown settings kept from the loaded blob
+#define Settings_Values_Bytes   100                         // The last Offset in Settings_Table plus its Max
+#define Settings_Debounce_ms    2000
+#define Settings_Delay_Max_ms   10000
+
+// The Id is what the blob stores, append only and never renumbered
+typedef enum {
+    Setting_Backlight,                                      // 5 to Backlight_MAX, the slider's range
+    Setting_Volume,                                         // 0 to Volume_MAX
+    Setting_Wifi_SSID,
+    Setting_Wifi_Password,
+    Settings_Count
+} Setting_Id;
+
+typedef enum {
+    Setting_U8,
+    Setting_String,                                         // Max counts the terminator
+} Setting_Type;
+
+typedef struct {
+    uint8_t Type;
+    uint8_t Offset;                                         // Into Settings_Store.Values
+    uint8_t Min;
+    uint8_t Max;                                            // Highest value, or bytes of a string
+    uint8_t Default;
+} Setting_Info;
+
+typedef enum {
+    Settings_Loaded,
+    Settings_Upgraded,                                      // From an older Version, save it again
+    Settings_Defaults,                                      // Nothing usable, everything is at its default
+} Settings_Load_Result;
+
+typedef struct {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t Bytes;                                         // Entries after the header
+} Settings_Header;
+
+typedef struct {
+    uint8_t Values[Settings_Values_Bytes];
+    uint8_t Extra[Settings_Extra_Max];
+    uint8_t Extra_Bytes;
+    bool Dirty;
+    uint32_t First_ms;                                      // Of the changes not saved yet
+    uint32_t Due_ms;
+    uint32_t Changes;                                       // Since the last save
+} Settings_Store;
+
+extern const Setting_Info Settings_Table[Settings_Count];
+
+void Settings_Store_Init(Settings_Store *Store);            // All defaults
+Settings_Load_Result Settings_Store_Load(Settings_Store *Store, const uint8_t *Blob, size_t Bytes);
+size_t Settings_Store_Save(const Settings_Store *Store, uint8_t *Blob, size_t Max);   // Bytes, 0 if Max is short
+void Settings_Store_Saved(Settings_Store *Store);           // The blob from Save is on its way to flash
+void Settings_Store_Retry(Settings_Store *Store, uint32_t Now_ms);  // It didn't get there, save again later
+
+uint8_t Settings_Store_Get(const Settings_Store *Store, Setting_Id Id);
+const char *Settings_Store_Get_String(const Settings_Store *Store, Setting_Id Id);
+// Clamped to the setting's range or cut to its size. True if that changed anything, which schedules a save
+bool Settings_Store_Set(Settings_Store *Store, Setting_Id Id, uint8_t Value, uint32_t Now_ms);
+bool Settings_Store_Set_String(Settings_Store *Store, Setting_Id Id, const char *Value, uint32_t Now_ms);
+bool Settings_Store_Due(const Settings_Store *Store, uint32_t Now_ms);
@@ -0,0 +1,337 @@
+/**
+ * Host bench for Settings_Store, the settings blob Settings.c keeps in NVS.
+ *
+ * The checks cover the saved form: a round trip, a blob missing settings, one carrying settings
+ * this firmware doesn't know, cut and foreign blobs, values out of range, an older Version and
+ * strings too long for their slot. Then the debounce: when a change is due, and that a slider
+ * that never stops is still saved within Settings_Delay_Max_ms.
+ *
+ * The model then runs -d days of -n slider drags a day. A drag sends LV_EVENT_VALUE_CHANGED about
+ * every 30 ms for 0.3 to 2 s, and one in three follows the last within a few seconds, the user
+ * overshot and comes back. Each drag is saved four ways:
+ *
+ *   u8 per change       nvs_set_u8 and nvs_commit on every event, the key per setting way
+ *   blob per change     the whole blob on every event
+ *   debounced 1 s       the blob once nothing changed for 1 s
+ *   debounced 2 s       the blob once nothing changed for 2 s, Settings_Store as the firmware runs it
+ *
+ * NVS writes 32 byte entries, 126 to a 4 KB page, and a blob costs an index entry, a data header
+ * and its data. Once the partition (0x6000, 6 pages) is full every page's worth of entries costs
+ * an erase. The model prints entries, commits and erases a day, the years until a sector sees
+ * 100k erases, and the longest a change sat in RAM only.
+ *
+ * usage: settings_bench [-d days] [-n drags] [-r seed]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Settings_Store.h"
+
+#define USAGE "usage: %s [-d days] [-n drags] [-r seed]\n"
+
+#define Entry_Bytes             32
+#define Page_Entries            126
+#define Partition_Pages         6
+#define Erase_Cycles            100000.0
+#define Event_ms                30                          // LV_EVENT_VALUE_CHANGED while dragging
+#define Loop_ms                 100                         // Driver_Loop, where Settings_Loop runs
+
+static uint32_t failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static size_t Put_Header(uint8_t *Blob, uint16_t Version, size_t Bytes)
+{
+    Settings_Header header = { .Magic = Settings_Magic, .Version = Version, .Bytes = Bytes };
+    memcpy(Blob, &header, sizeof(header));
+    return sizeof(header) + Bytes;
+}
+
+static void check_schema(void)
+{
+    Settings_Store store, loaded;
+    uint8_t blob[Settings_Blob_Max];
+
+    // Round trip
+    Settings_Store_Init(&store);
+    CHECK(Settings_Store_Get(&store, Setting_Backlight) == 70);
+    CHECK(Settings_Store_Get(&store, Setting_Volume) == 98);
+    CHECK(Settings_Store_Get_String(&store, Setting_Wifi_SSID)[0] == '\0');
+    Settings_Store_Set(&store, Setting_Backlight, 40, 0);
+    Settings_Store_Set(&store, Setting_Volume, 12, 0);
+    Settings_Store_Set_String(&store, Setting_Wifi_SSID, "Home", 0);
+    Settings_Store_Set_String(&store, Setting_Wifi_Password, "secret pass", 0);
+    size_t bytes = Settings_Store_Save(&store, blob, sizeof(blob));
+    CHECK(bytes == sizeof(Settings_Header) + 3 + 3 + 6 + 13);
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Loaded);
+    CHECK(Settings_Store_Get(&loaded, Setting_Backlight) == 40);
+    CHECK(Settings_Store_Get(&loaded, Setting_Volume) == 12);
+    CHECK(!strcmp(Settings_Store_Get_String(&loaded, Setting_Wifi_SSID), "Home"));
+    CHECK(!strcmp(Settings_Store_Get_String(&loaded, Setting_Wifi_Password), "secret pass"));
+    CHECK(!loaded.Dirty);
+    CHECK(Settings_Store_Save(&store, blob, bytes - 1) == 0);
+
+    // A blob from before a setting existed
+    uint8_t *entry = blob + sizeof(Settings_Header);
+    entry[0] = Setting_Volume; entry[1] = 1; entry[2] = 33;
+    bytes = Put_Header(blob, Settings_Version, 3);
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Loaded);
+    CHECK(Settings_Store_Get(&loaded, Setting_Volume) == 33);
+    CHECK(Settings_Store_Get(&loaded, Setting_Backlight) == 70);
+
+    // One from newer firmware, the unknown setting goes back out as it came in
+    entry[3] = 200; entry[4] = 3; memcpy(entry + 5, "abc", 3);
+    entry[8] = Setting_Backlight; entry[9] = 1; entry[10] = 55;
+    bytes = Put_Header(blob, Settings_Version + 1, 11);
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Loaded);
+    CHECK(Settings_Store_Get(&loaded, Setting_Backlight) == 55);
+    CHECK(loaded.Extra_Bytes == 5);
+    Settings_Store_Set(&loaded, Setting_Volume, 10, 0);
+    bytes = Settings_Store_Save(&loaded, blob, sizeof(blob));
+    CHECK(bytes > 5 && !memcmp(blob + bytes - 5, "\xc8\x03" "abc", 5));
+    CHECK(Settings_Store_Load(&store, blob, bytes) == Settings_Loaded);
+    CHECK(store.Extra_Bytes == 5 && Settings_Store_Get(&store, Setting_Volume) == 10);
+
+    // Cut short, not ours, or nothing at all
+    CHECK(Settings_Store_Load(&loaded, blob, bytes - 1) == Settings_Defaults);
+    CHECK(Settings_Store_Get(&loaded, Setting_Volume) == 98);
+    CHECK(Settings_Store_Load(&loaded, blob, sizeof(Settings_Header) - 1) == Settings_Defaults);
+    CHECK(Settings_Store_Load(&loaded, blob, 0) == Settings_Defaults);
+    blob[0] ^= 0xff;
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Defaults);
+
+    // An entry running past the end is dropped, the ones before it are kept
+    entry[0] = Setting_Backlight; entry[1] = 1; entry[2] = 20;
+    entry[3] = Setting_Wifi_SSID; entry[4] = 10; memcpy(entry + 5, "net", 3);
+    bytes = Put_Header(blob, Settings_Version, 8);
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Loaded);
+    CHECK(Settings_Store_Get(&loaded, Setting_Backlight) == 20);
+    CHECK(Settings_Store_Get_String(&loaded, Setting_Wifi_SSID)[0] == '\0');
+
+    // Out of range is clamped, a wrong length ignored
+    entry[0] = Setting_Backlight; entry[1] = 1; entry[2] = 0;
+    entry[3] = Setting_Volume; entry[4] = 1; entry[5] = 250;
+    entry[6] = Setting_Backlight; entry[7] = 2; entry[8] = 60; entry[9] = 0;
+    bytes = Put_Header(blob, Settings_Version, 10);
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Loaded);
+    CHECK(Settings_Store_Get(&loaded, Setting_Backlight) == 5);
+    CHECK(Settings_Store_Get(&loaded, Setting_Volume) == 100);
+    CHECK(Settings_Store_Set(&loaded, Setting_Backlight, 255, 0));
+    CHECK(Settings_Store_Get(&loaded, Setting_Backlight) == 100);
+    CHECK(!Settings_Store_Set(&loaded, Setting_Backlight, 200, 0));
+
+    // An older Version is loaded and reported so it gets saved again
+    bytes = Put_Header(blob, Settings_Version - 1, 10);
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Upgraded);
+    CHECK(Settings_Store_Get(&loaded, Setting_Backlight) == 5);
+
+    // Strings are cut to their slot, set or loaded
+    char long_name[80];
+    memset(long_name, 'x', sizeof(long_name) - 1);
+    long_name[sizeof(long_name) - 1] = '\0';
+    Settings_Store_Init(&store);
+    CHECK(Settings_Store_Set_String(&store, Setting_Wifi_SSID, long_name, 0));
+    CHECK(strlen(Settings_Store_Get_String(&store, Setting_Wifi_SSID)) == 32);
+    CHECK(!Settings_Store_Set_String(&store, Setting_Wifi_SSID, long_name, 0));
+    CHECK(Settings_Store_Get_String(&store, Setting_Wifi_Password)[0] == '\0');
+    entry[0] = Setting_Wifi_SSID; entry[1] = 40; memset(entry + 2, 'y', 40);
+    bytes = Put_Header(blob, Settings_Version, 42);
+    CHECK(Settings_Store_Load(&loaded, blob, bytes) == Settings_Loaded);
+    CHECK(strlen(Settings_Store_Get_String(&loaded, Setting_Wifi_SSID)) == 32);
+
+    // The largest store still fits the blob
+    CHECK(Settings_Store_Set_String(&store, Setting_Wifi_Password, long_name, 0));
+    memset(store.Extra, 250, Settings_Extra_Max);
+    store.Extra[1] = Settings_Extra_Max - 2;
+    store.Extra_Bytes = Settings_Extra_Max;
+    CHECK(Settings_Store_Save(&store, blob, sizeof(blob)) > 0);
+}
+
+static void check_debounce(void)
+{
+    Settings_Store store;
+    Settings_Store_Init(&store);
+
+    CHECK(!Settings_Store_Set(&store, Setting_Volume, 98, 0));
+    CHECK(!Settings_Store_Due(&store, 100000));
+    CHECK(Settings_Store_Set(&store, Setting_Volume, 50, 1000));
+    CHECK(!Settings_Store_Due(&store, 1000 + Settings_Debounce_ms - 1));
+    CHECK(Settings_Store_Due(&store, 1000 + Settings_Debounce_ms));
+
+    // Each change pushes it back
+    CHECK(Settings_Store_Set(&store, Setting_Volume, 51, 2500));
+    CHECK(!Settings_Store_Due(&store, 1000 + Settings_Debounce_ms));
+    CHECK(Settings_Store_Due(&store, 2500 + Settings_Debounce_ms));
+    CHECK(store.Changes == 2);
+    Settings_Store_Saved(&store);
+    CHECK(!store.Dirty && store.Changes == 0 && !Settings_Store_Due(&store, 100000));
+
+    // A slider that never stops is saved anyway
+    uint32_t now = 50000;
+    uint32_t due_at = 0;
+    for (uint32_t i = 0; i < 2000 && !due_at; i++, now += Event_ms) {
+        Settings_Store_Set(&store, Setting_Backlight, 5 + i % 90, now);
+        if (Settings_Store_Due(&store, now)) {
+            due_at = now;
+        }
+    }
+    CHECK(due_at >= 50000 + Settings_Delay_Max_ms && due_at < 50000 + Settings_Delay_Max_ms + Event_ms);
+
+    // A failed write goes round again
+    Settings_Store_Saved(&store);
+    Settings_Store_Retry(&store, now);
+    CHECK(store.Dirty && !Settings_Store_Due(&store, now) && Settings_Store_Due(&store, now + Settings_Debounce_ms));
+
+    // Across the wrap of the ms counter
+    Settings_Store_Saved(&store);
+    now = 0xffffffffu - 500;
+    CHECK(Settings_Store_Set(&store, Setting_Volume, 7, now));
+    CHECK(!Settings_Store_Due(&store, now + 1000));
+    CHECK(Settings_Store_Due(&store, now + Settings_Debounce_ms));
+}
+
+typedef enum {
+    U8_Per_Change,
+    Blob_Per_Change,
+    Debounced_1s,
+    Debounced_2s,
+    Ways
+} Way;
+
+static const char *Way_Names[Ways] = { "u8 per change", "blob per change", "debounced 1 s", "debounced 2 s" };
+
+typedef struct {
+    uint64_t entries;
+    uint64_t commits;
+    uint32_t worst_ms;                                      // A change held in RAM only
+    uint32_t unsaved_since;                                 // First change not committed yet, 0 for none
+    uint32_t last_change;
+    bool dirty;
+} Way_Stats;
+
+static uint32_t Blob_Entries(size_t Bytes)
+{
+    return 2 + (Bytes + Entry_Bytes - 1) / Entry_Bytes;     // Index, data header, data
+}
+
+static void Commit_Way(Way_Stats *W, uint32_t Entries, uint32_t Now)
+{
+    W->entries += Entries;
+    W->commits++;
+    if (Now - W->unsaved_since > W->worst_ms) {
+        W->worst_ms = Now - W->unsaved_since;
+    }
+    W->dirty = false;
+}
+
+static double Uniform(double Low, double High)
+{
+    return Low + (High - Low) * rand() / RAND_MAX;
+}
+
+static void model(double Days, uint32_t Drags)
+{
+    Way_Stats ways[Ways] = { 0 };
+    Settings_Store store;
+    uint8_t blob[Settings_Blob_Max];
+    Settings_Store_Init(&store);
+    Settings_Store_Set_String(&store, Setting_Wifi_SSID, "SmartHome-5G", 0);
+    Settings_Store_Set_String(&store, Setting_Wifi_Password, "correct horse", 0);
+    Settings_Store_Saved(&store);
+    uint32_t blob_entries = Blob_Entries(Settings_Store_Save(&store, blob, sizeof(blob)));
+
+    uint64_t total = (uint64_t)(Days * Drags);
+    uint32_t mean_gap_ms = 86400000u / (Drags ? Drags : 1);
+    uint32_t now = 1000;
+    uint32_t next_loop = now;
+    uint64_t events = 0;
+    int value = 50;
+    for (uint64_t drag = 0; drag < total; drag++) {
+        Setting_Id id = rand() % 2 ? Setting_Backlight : Setting_Volume;
+        uint32_t gap = rand() % 3 == 0 ? (uint32_t)Uniform(500, 3000) : (uint32_t)(Uniform(0.2, 1.8) * mean_gap_ms);
+        uint32_t end = now + gap + (uint32_t)Uniform(300, 2000);
+        for (now += gap; (int32_t)(now - end) < 0; now += Event_ms) {
+            // Settings_Loop and the debounced ways see time pass between events
+            for (; (int32_t)(now - next_loop) >= 0; next_loop += Loop_ms) {
+                Way_Stats *fast = &ways[Debounced_1s];
+                if (fast->dirty && (next_loop - fast->last_change >= 1000 ||
+                                    next_loop - fast->unsaved_since >= Settings_Delay_Max_ms)) {
+                    Commit_Way(fast, blob_entries, next_loop);
+                }
+                if (Settings_Store_Due(&store, next_loop)) {
+                    Settings_Store_Saved(&store);
+                    Commit_Way(&ways[Debounced_2s], blob_entries, next_loop);
+                }
+            }
+            value += rand() % 7 - 3;
+            value = value < 5 ? 5 : (value > 100 ? 100 : value);
+            if (!Settings_Store_Set(&store, id, value, now)) {
+                continue;                                   // LVGL only sends VALUE_CHANGED when it changed
+            }
+            events++;
+            CHECK(store.Dirty && now - store.First_ms <= Settings_Delay_Max_ms + Loop_ms);
+            for (int w = 0; w < Ways; w++) {
+                if (!ways[w].dirty) {
+                    ways[w].unsaved_since = now;
+                    ways[w].dirty = true;
+                }
+                ways[w].last_change = now;
+            }
+            Commit_Way(&ways[U8_Per_Change], 1, now);
+            Commit_Way(&ways[Blob_Per_Change], blob_entries, now);
+        }
+    }
+
+    printf("%llu drags over %.1f days, %llu changes, blob %u entries\n", (unsigned long long)total, Days,
+           (unsigned long long)events, blob_entries);
+    printf("%-16s %12s %12s %10s %12s %10s\n", "", "entries/day", "commits/day", "erases/day", "years@100k",
+           "worst ms");
+    for (int w = 0; w < Ways; w++) {
+        double entries = ways[w].entries / Days;
+        double erases = entries / Page_Entries;
+        double years = erases > 0 ? Erase_Cycles * Partition_Pages / erases / 365 : 0;
+        printf("%-16s %12.0f %12.0f %10.2f %12.1f %10u\n", Way_Names[w], entries, ways[w].commits / Days, erases,
+               years, ways[w].worst_ms);
+    }
+    CHECK(ways[Debounced_2s].commits * 5 < ways[Blob_Per_Change].commits);
+    CHECK(ways[Debounced_2s].entries < ways[U8_Per_Change].entries);
+    CHECK(ways[Debounced_2s].worst_ms <= Settings_Delay_Max_ms + Loop_ms);
+}
+
+int main(int argc, char **argv)
+{
+    double days = 30;
+    uint32_t drags = 200;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+            days = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            drags = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (days <= 0 || drags == 0) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    srand(seed);
+    check_schema();
+    check_debounce();
+    model(days, drags);
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#include "Shutdown.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+static const char *TAG = "SHUTDOWN";
+
+static Shutdown_Plan Plan = { .Budget_ms = Shutdown_Budget_ms, .Running = -1 };    // Taking hooks before any Init
+static portMUX_TYPE Plan_Lock = portMUX_INITIALIZER_UNLOCKED;
+static bool Started = false;
+static SemaphoreHandle_t Finished;
+
+bool Shutdown_Register(const char *Name, Shutdown_Phase Phase, uint32_t Deadline_ms, Shutdown_Hook Hook, void *Context)
+{
+    taskENTER_CRITICAL(&Plan_Lock);
+    bool added = !Started && Shutdown_Plan_Add(&Plan, Name, Phase, Deadline_ms, Hook, Context);
+    uint32_t committed = Plan.Committed_ms;
+    taskEXIT_CRITICAL(&Plan_Lock);
+    if (!added) {
+        ESP_LOGE(TAG, "No room for %s (%lu ms), %lu of %lu ms taken", Name, Deadline_ms, committed,
+                 (uint32_t)Shutdown_Budget_ms);
+    }
+    return added;
+}
+
+static uint32_t Now_ms(void *Context)
+{
+    return esp_timer_get_time() / 1000;
+}
+
+static void Shutdown_Task(void *arg)
+{
+    Shutdown_Plan_Run(&Plan, Now_ms, NULL);
+    xSemaphoreGive(Finished);
+    vTaskDelete(NULL);
+}
+
+uint32_t Shutdown_Run(void)
+{
+    taskENTER_CRITICAL(&Plan_Lock);
+    bool first = !Started;
+    Started = true;                                         // Nothing is added or run again from here
+    taskEXIT_CRITICAL(&Plan_Lock);
+    if (!first) {
+        return 0;
+    }
+    int64_t start = esp_timer_get_time();
+    ESP_LOGI(TAG, "Running %u hooks, %lu of %lu ms taken", Plan.Count, Plan.Committed_ms, (uint32_t)Shutdown_Budget_ms);
+
+    // A task of its own, so a hook stuck on the card can't hold the power on
+    bool finished = true;
+    Finished = xSemaphoreCreateBinary();
+    if (Finished && xTaskCreatePinnedToCore(Shutdown_Task, "Shutdown", 4096, NULL, 3, NULL, 0) == pdPASS) {
+        finished = xSemaphoreTake(Finished, pdMS_TO_TICKS(Shutdown_Budget_ms + Shutdown_Grace_ms)) == pdTRUE;
+    } else {
+        ESP_LOGW(TAG, "No task for the hooks, running them here");
+        Shutdown_Plan_Run(&Plan, Now_ms, NULL);
+    }
+    uint32_t took = (esp_timer_get_time() - start) / 1000;
+
+    static const char *Results[] = { "not run", "done", "failed", "late", "skipped" };
+    for (uint8_t i = 0; i < Plan.Count; i++) {
+        const Shutdown_Entry *hook = &Plan.Hooks[i];
+        if (hook->Result == Shutdown_Done) {
+            ESP_LOGI(TAG, "%s done in %lu of %lu ms", hook->Name, hook->Took_ms, hook->Given_ms);
+        } else {
+            ESP_LOGW(TAG, "%s %s in %lu of %lu ms", hook->Name, Results[hook->Result], hook->Took_ms, hook->Given_ms);
+        }
+    }
+    int8_t running = Plan.Running;
+    if (!finished) {
+        ESP_LOGE(TAG, "%s still running after %lu ms, cutting the power anyway",
+                 running >= 0 ? Plan.Hooks[running].Name : "A hook", took);
+    } else {
+        ESP_LOGI(TAG, "Done in %lu of %lu ms", took, (uint32_t)Shutdown_Budget_ms);
+    }
+    return took;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// The power key's shutdown, see Shutdown_Plan.h. Modules add their hook from their Init, Shutdown() in PWR_Key
+// runs them and cuts the power once they are done or the budget and the grace after it have passed.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Shutdown_Plan.h"
+
+#define Shutdown_Budget_ms      2000                        // Hooks' deadlines together, from the long press on
+#define Shutdown_Grace_ms       200                         // For a hook that overruns, then the power goes anyway
+
+// Any time before the shutdown, no Init needed. False, and logged, if the deadline doesn't fit the budget
+bool Shutdown_Register(const char *Name, Shutdown_Phase Phase, uint32_t Deadline_ms, Shutdown_Hook Hook, void *Context);
+uint32_t Shutdown_Run(void);                                // Once, later calls return 0 at once. Milliseconds it took
@@ -0,0 +1,58 @@
+#include "Shutdown_Plan.h"
+
+#include <string.h>
+
+void Shutdown_Plan_Init(Shutdown_Plan *Plan, uint32_t Budget_ms)
+{
+    memset(Plan, 0, sizeof(*Plan));
+    Plan->Budget_ms = Budget_ms;
+    Plan->Running = -1;
+}
+
+bool Shutdown_Plan_Add(Shutdown_Plan *Plan, const char *Name, Shutdown_Phase Phase, uint32_t Deadline_ms,
+                       Shutdown_Hook Hook, void *Context)
+{
+    if (Plan->Count == Shutdown_Hooks_Max || Phase >= Shutdown_Phases || Deadline_ms > Plan->Budget_ms - Plan->Committed_ms) {
+        return false;
+    }
+    // After every hook of this phase or an earlier one
+    uint8_t at = Plan->Count;
+    while (at > 0 && Plan->Hooks[at - 1].Phase > Phase) {
+        Plan->Hooks[at] = Plan->Hooks[at - 1];
+        at--;
+    }
+    Shutdown_Entry *entry = &Plan->Hooks[at];
+    memset(entry, 0, sizeof(*entry));
+    entry->Name = Name;
+    entry->Hook = Hook;
+    entry->Context = Context;
+    entry->Phase = Phase;
+    entry->Deadline_ms = Deadline_ms;
+    Plan->Count++;
+    Plan->Committed_ms += Deadline_ms;
+    return true;
+}
+
+uint32_t Shutdown_Plan_Run(Shutdown_Plan *Plan, Shutdown_Clock Now, void *Clock_Context)
+{
+    uint32_t start = Now(Clock_Context);
+    for (uint8_t i = 0; i < Plan->Count; i++) {
+        Shutdown_Entry *entry = &Plan->Hooks[i];
+        uint32_t used = Now(Clock_Context) - start;
+        uint32_t left = used < Plan->Budget_ms ? Plan->Budget_ms - used : 0;
+        entry->Given_ms = entry->Deadline_ms < left ? entry->Deadline_ms : left;
+        entry->Took_ms = 0;
+        if (!entry->Given_ms) {
+            entry->Result = Shutdown_Skipped;
+            continue;
+        }
+        Plan->Running = i;
+        uint32_t begin = Now(Clock_Context);
+        bool done = entry->Hook(entry->Given_ms, entry->Context);
+        entry->Took_ms = Now(Clock_Context) - begin;
+        Plan->Running = -1;
+        entry->Result = !done ? Shutdown_Failed : (entry->Took_ms > entry->Given_ms ? Shutdown_Late : Shutdown_Done);
+    }
+    Plan->Took_ms = Now(Clock_Context) - start;
+    return Plan->Took_ms;
+}
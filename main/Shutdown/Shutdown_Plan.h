@@ -0,0 +1,59 @@
+#pragma once
+
+// What runs between the power key and the power going, independent of FreeRTOS so it also builds on the host,
+// see host_bench/. Subsystems add a hook with the time it needs, and hooks run by phase: what makes work stops
+// first, then the small state that matters most is saved, then buffers go to the card and the card is unmounted
+// last. A hook is only taken if its deadline still fits the budget, so one that keeps to its timeout never takes
+// time from the ones after it. A hook that overruns is let finish and the ones after it get what is left.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define Shutdown_Hooks_Max      8
+
+typedef enum {
+    Shutdown_Phase_Quiesce,                                 // Playback and capture stop, nothing new reaches the card
+    Shutdown_Phase_Save,                                    // Settings and other small state, in NVS
+    Shutdown_Phase_Flush,                                   // Buffered data to the card
+    Shutdown_Phase_Unmount,                                 // The card, so FAT is clean on the next mount
+    Shutdown_Phases
+} Shutdown_Phase;
+
+typedef enum {
+    Shutdown_Pending,
+    Shutdown_Done,
+    Shutdown_Failed,                                        // The hook returned false, its work may be lost
+    Shutdown_Late,                                          // Done, but after its share of the budget
+    Shutdown_Skipped,                                       // Nothing was left of the budget
+} Shutdown_Result;
+
+// True once done. Timeout_ms is this hook's share, the hook has to return within it
+typedef bool (*Shutdown_Hook)(uint32_t Timeout_ms, void *Context);
+typedef uint32_t (*Shutdown_Clock)(void *Context);          // Milliseconds, wrapping
+
+typedef struct {
+    const char *Name;
+    Shutdown_Hook Hook;
+    void *Context;
+    uint8_t Phase;
+    uint32_t Deadline_ms;
+    // From the last run
+    uint32_t Given_ms;
+    uint32_t Took_ms;
+    uint8_t Result;
+} Shutdown_Entry;
+
+typedef struct {
+    Shutdown_Entry Hooks[Shutdown_Hooks_Max];               // In phase order, then in the order they were added
+    uint8_t Count;
+    uint32_t Budget_ms;
+    uint32_t Committed_ms;                                  // Deadlines of the hooks taken
+    volatile int8_t Running;                                // Index of the hook running, -1 for none
+    uint32_t Took_ms;                                       // Of the last run
+} Shutdown_Plan;
+
+void Shutdown_Plan_Init(Shutdown_Plan *Plan, uint32_t Budget_ms);
+// False if the plan is full or Deadline_ms doesn't fit what is left of the budget
+bool Shutdown_Plan_Add(Shutdown_Plan *Plan, const char *Name, Shutdown_Phase Phase, uint32_t Deadline_ms,
+                       Shutdown_Hook Hook, void *Context);
+uint32_t Shutdown_Plan_Run(Shutdown_Plan *Plan, Shutdown_Clock Now, void *Clock_Context);   // Milliseconds it took
@@ -0,0 +1,252 @@
+/**
+ * Host bench for Shutdown_Plan, what runs between the power key and the power going.
+ *
+ * The clock is simulated: a hook moves it on by the time its work takes, or by its timeout if
+ * the work takes longer and the hook keeps to it. The checks cover the order hooks run in,
+ * which hooks the plan refuses, and what happens after a hook that fails or overruns: the
+ * ones after it get what is left of the budget, and none once it is gone.
+ *
+ * The soak then runs -n shutdowns with the firmware's hooks and their deadlines:
+ *
+ *   music       Quiesce  400 ms    the player stops, usually 30 to 150 ms
+ *   mp3 index   Quiesce  150 ms    the track index task, mostly idle, now and then cancelling a walk
+ *                                  at its next read or finishing a cache write, 10 to 60 ms
+ *   album art   Quiesce  150 ms    mostly idle, sometimes a cold load decoding a JPEG, 30 to 120 ms
+ *   settings    Save     200 ms    an NVS commit, 5 to 40 ms, sometimes a page erase of 60 ms
+ *   logger      Flush    600 ms    a block written and synced, 20 to 300 ms, now and then a card
+ *                                  that takes 1 to 3 s. Without a card it returns at once
+ *   card        Unmount  500 ms    the eject through the monitor, 20 to 200 ms
+ *
+ * Hooks keep to their timeouts, except that one run in Overrun_Every has a hook go over it by
+ * up to Overrun_Max_ms, a card stuck in a write. It prints how each hook ended, the longest
+ * shutdown with and without overruns, and how often the unmount was reached.
+ *
+ * usage: shutdown_bench [-n runs] [-r seed]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Shutdown_Plan.h"
+
+#define USAGE "usage: %s [-n runs] [-r seed]\n"
+
+#define Budget_ms               2000                        // Shutdown_Budget_ms
+#define Overrun_Every           50
+#define Overrun_Max_ms          400
+
+static uint32_t failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static uint32_t now_ms = 0xfffff000;                        // Wraps during the checks
+
+static uint32_t clock_now(void *context)
+{
+    (void)context;
+    return now_ms;
+}
+
+typedef struct {
+    uint32_t work_ms;                                       // What the hook's work takes
+    uint32_t overrun_ms;                                    // Past its timeout it keeps going for
+    bool fails;
+    uint32_t given_ms;                                      // What it was told
+    uint32_t order;                                         // When it ran, 0 for never
+} fake_t;
+
+static uint32_t ran = 0;
+
+static bool fake_hook(uint32_t timeout_ms, void *context)
+{
+    fake_t *f = context;
+    f->given_ms = timeout_ms;
+    f->order = ++ran;
+    if (f->work_ms <= timeout_ms) {
+        now_ms += f->work_ms;
+        return !f->fails;
+    }
+    now_ms += timeout_ms + f->overrun_ms;
+    return f->overrun_ms > 0 && !f->fails;                  // Finished late, or gave up at its timeout
+}
+
+static void checks(void)
+{
+    Shutdown_Plan plan;
+    fake_t music = { .work_ms = 100 }, settings = { .work_ms = 20 }, logger = { .work_ms = 200 }, card = { .work_ms = 50 };
+
+    // Phase order whatever order they came in, and the budget is what is handed out
+    Shutdown_Plan_Init(&plan, Budget_ms);
+    CHECK(Shutdown_Plan_Add(&plan, "card", Shutdown_Phase_Unmount, 500, fake_hook, &card));
+    CHECK(Shutdown_Plan_Add(&plan, "settings", Shutdown_Phase_Save, 300, fake_hook, &settings));
+    CHECK(Shutdown_Plan_Add(&plan, "logger", Shutdown_Phase_Flush, 700, fake_hook, &logger));
+    CHECK(!Shutdown_Plan_Add(&plan, "greedy", Shutdown_Phase_Flush, 501, fake_hook, NULL));
+    CHECK(!Shutdown_Plan_Add(&plan, "bad", Shutdown_Phases, 1, fake_hook, NULL));
+    CHECK(Shutdown_Plan_Add(&plan, "music", Shutdown_Phase_Quiesce, 500, fake_hook, &music));
+    CHECK(plan.Committed_ms == Budget_ms);
+    CHECK(!Shutdown_Plan_Add(&plan, "late", Shutdown_Phase_Unmount, 1, fake_hook, NULL));
+    CHECK(!strcmp(plan.Hooks[0].Name, "music") && !strcmp(plan.Hooks[3].Name, "card"));
+
+    ran = 0;
+    uint32_t took = Shutdown_Plan_Run(&plan, clock_now, NULL);
+    CHECK(took == 370);
+    CHECK(music.order == 1 && settings.order == 2 && logger.order == 3 && card.order == 4);
+    CHECK(music.given_ms == 500 && settings.given_ms == 300 && logger.given_ms == 700 && card.given_ms == 500);
+    for (int i = 0; i < plan.Count; i++) {
+        CHECK(plan.Hooks[i].Result == Shutdown_Done);
+    }
+    CHECK(plan.Hooks[2].Took_ms == 200 && plan.Running == -1);
+
+    // Same phase keeps the order they came in, and a full plan refuses more
+    Shutdown_Plan_Init(&plan, 100000);
+    fake_t many[Shutdown_Hooks_Max] = { 0 };
+    for (int i = 0; i < Shutdown_Hooks_Max; i++) {
+        CHECK(Shutdown_Plan_Add(&plan, "same", i % 2 ? Shutdown_Phase_Save : Shutdown_Phase_Flush, 10, fake_hook, &many[i]));
+    }
+    CHECK(!Shutdown_Plan_Add(&plan, "full", Shutdown_Phase_Save, 10, fake_hook, NULL));
+    ran = 0;
+    Shutdown_Plan_Run(&plan, clock_now, NULL);
+    for (int i = 0; i < Shutdown_Hooks_Max; i++) {
+        uint32_t expected = i % 2 ? (uint32_t)i / 2 + 1 : Shutdown_Hooks_Max / 2 + (uint32_t)i / 2 + 1;
+        CHECK(many[i].order == expected);
+    }
+
+    // A failure is reported and the rest still run
+    Shutdown_Plan_Init(&plan, Budget_ms);
+    settings = (fake_t){ .work_ms = 20, .fails = true };
+    logger = (fake_t){ .work_ms = 5000 };                   // Gives up at its timeout
+    card = (fake_t){ .work_ms = 50 };
+    Shutdown_Plan_Add(&plan, "settings", Shutdown_Phase_Save, 300, fake_hook, &settings);
+    Shutdown_Plan_Add(&plan, "logger", Shutdown_Phase_Flush, 700, fake_hook, &logger);
+    Shutdown_Plan_Add(&plan, "card", Shutdown_Phase_Unmount, 500, fake_hook, &card);
+    took = Shutdown_Plan_Run(&plan, clock_now, NULL);
+    CHECK(plan.Hooks[0].Result == Shutdown_Failed && plan.Hooks[1].Result == Shutdown_Failed);
+    CHECK(plan.Hooks[1].Took_ms == 700 && plan.Hooks[2].Result == Shutdown_Done && took == 770);
+
+    // An overrun takes from the ones after it, down to nothing
+    logger = (fake_t){ .work_ms = 5000, .overrun_ms = 1200 };
+    card = (fake_t){ .work_ms = 50 };
+    took = Shutdown_Plan_Run(&plan, clock_now, NULL);
+    CHECK(plan.Hooks[1].Result == Shutdown_Late && plan.Hooks[1].Took_ms == 1900);
+    CHECK(plan.Hooks[2].Given_ms == Budget_ms - 1920 && plan.Hooks[2].Result == Shutdown_Done);
+    logger.overrun_ms = 2000;
+    card.order = 0;
+    took = Shutdown_Plan_Run(&plan, clock_now, NULL);
+    CHECK(plan.Hooks[2].Result == Shutdown_Skipped && card.order == 0 && took == 2720);
+}
+
+typedef struct {
+    const char *name;
+    Shutdown_Phase phase;
+    uint32_t deadline_ms;
+    uint32_t results[Shutdown_Skipped + 1];
+    uint32_t worst_ms;
+} soak_hook_t;
+
+static uint32_t between(uint32_t low, uint32_t high)
+{
+    return low + rand() % (high - low + 1);
+}
+
+static void soak(uint32_t runs)
+{
+    soak_hook_t hooks[] = {
+        { .name = "music", .phase = Shutdown_Phase_Quiesce, .deadline_ms = 400 },
+        { .name = "mp3 index", .phase = Shutdown_Phase_Quiesce, .deadline_ms = 150 },
+        { .name = "album art", .phase = Shutdown_Phase_Quiesce, .deadline_ms = 150 },
+        { .name = "settings", .phase = Shutdown_Phase_Save, .deadline_ms = 200 },
+        { .name = "logger", .phase = Shutdown_Phase_Flush, .deadline_ms = 600 },
+        { .name = "card", .phase = Shutdown_Phase_Unmount, .deadline_ms = 500 },
+    };
+    enum { Hooks = sizeof(hooks) / sizeof(hooks[0]) };
+    fake_t fakes[Hooks];
+    uint32_t worst_clean = 0, worst_overrun = 0, unmounted = 0, overrun_runs = 0;
+
+    for (uint32_t run = 0; run < runs; run++) {
+        Shutdown_Plan plan;
+        Shutdown_Plan_Init(&plan, Budget_ms);
+        memset(fakes, 0, sizeof(fakes));
+        fakes[0].work_ms = between(30, 150);
+        fakes[1].work_ms = rand() % 20 ? 0 : between(10, 60);
+        fakes[2].work_ms = rand() % 10 ? 0 : between(30, 120);
+        fakes[3].work_ms = rand() % 10 ? between(5, 40) : 60;
+        fakes[4].work_ms = rand() % 20 ? between(20, 300) : between(1000, 3000);
+        fakes[5].work_ms = between(20, 200);
+        bool overrun = run % Overrun_Every == 0;
+        if (overrun) {
+            fake_t *stuck = &fakes[rand() % Hooks];
+            stuck->work_ms = UINT32_MAX;
+            stuck->overrun_ms = between(1, Overrun_Max_ms);
+            overrun_runs++;
+        }
+        for (int phase = Shutdown_Phases - 1; phase >= 0; phase--) {   // Backwards, the plan sorts them
+            for (int i = 0; i < Hooks; i++) {
+                if (hooks[i].phase == (Shutdown_Phase)phase) {
+                    CHECK(Shutdown_Plan_Add(&plan, hooks[i].name, hooks[i].phase, hooks[i].deadline_ms, fake_hook, &fakes[i]));
+                }
+            }
+        }
+        CHECK(plan.Count == Hooks && plan.Committed_ms == Budget_ms);   // Every hook fits, none to spare
+        uint32_t took = Shutdown_Plan_Run(&plan, clock_now, NULL);
+        for (int i = 0; i < Hooks; i++) {
+            const Shutdown_Entry *entry = &plan.Hooks[i];
+            soak_hook_t *hook = &hooks[i];                  // Same order, the table is in phase order
+            CHECK(!strcmp(entry->Name, hook->name));
+            hook->results[entry->Result]++;
+            hook->worst_ms = entry->Took_ms > hook->worst_ms ? entry->Took_ms : hook->worst_ms;
+        }
+        uint8_t card = plan.Hooks[Hooks - 1].Result;
+        unmounted += card == Shutdown_Done || card == Shutdown_Late;
+        if (overrun) {
+            worst_overrun = took > worst_overrun ? took : worst_overrun;
+            CHECK(took <= Budget_ms + Overrun_Max_ms);
+        } else {
+            worst_clean = took > worst_clean ? took : worst_clean;
+            CHECK(took <= Budget_ms);
+            CHECK(plan.Hooks[Hooks - 1].Result == Shutdown_Done);
+        }
+    }
+
+    printf("%u shutdowns, %u with a hook overrunning by up to %u ms\n", runs, overrun_runs, Overrun_Max_ms);
+    printf("%-10s %8s %6s %6s %6s %8s %8s\n", "", "deadline", "done", "failed", "late", "skipped", "worst ms");
+    for (size_t i = 0; i < sizeof(hooks) / sizeof(hooks[0]); i++) {
+        printf("%-10s %8u %6u %6u %6u %8u %8u\n", hooks[i].name, hooks[i].deadline_ms, hooks[i].results[Shutdown_Done],
+               hooks[i].results[Shutdown_Failed], hooks[i].results[Shutdown_Late], hooks[i].results[Shutdown_Skipped],
+               hooks[i].worst_ms);
+    }
+    printf("longest shutdown %u ms, %u ms with an overrun, budget %u ms\n", worst_clean, worst_overrun, Budget_ms);
+    printf("card unmounted in %.2f%% of shutdowns\n", 100.0 * unmounted / runs);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t runs = 100000;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            runs = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if (runs == 0) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    srand(seed);
+    checks();
+    soak(runs);
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
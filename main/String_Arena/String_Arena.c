@@ -0,0 +1,174 @@
+#include "String_Arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#endif
+
+#define Slots_Min               64
+
+// PSRAM first, internal RAM is kept for DMA buffers and stacks. The host only has realloc()
+static void *Arena_Realloc(void *Pointer, size_t Bytes)
+{
+#ifdef ESP_PLATFORM
+    void *moved = heap_caps_realloc(Pointer, Bytes, MALLOC_CAP_SPIRAM);
+    return moved ? moved : realloc(Pointer, Bytes);
+#else
+    return realloc(Pointer, Bytes);
+#endif
+}
+
+/** FNV-1a */
+static uint32_t Hash(const char *Text)
+{
+    uint32_t hash = 2166136261u;
+    while (*Text) {
+        hash ^= (uint8_t)*Text++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool Reserve(String_Arena *Arena, uint32_t Bytes)
+{
+    if (Bytes > UINT32_MAX - Arena->Used || (Arena->Max_Bytes && Arena->Used + Bytes > Arena->Max_Bytes)) {
+        return false;
+    }
+    uint32_t needed = Arena->Used + Bytes;
+    if (needed <= Arena->Capacity) {
+        return true;
+    }
+    // Doubling keeps the copies down to about the final size in total
+    uint32_t capacity = (Arena->Capacity > UINT32_MAX / 2) ? UINT32_MAX : Arena->Capacity * 2;
+    if (capacity < String_Arena_Grow_Min) {
+        capacity = String_Arena_Grow_Min;
+    }
+    if (capacity < needed) {
+        capacity = needed;
+    }
+    if (Arena->Max_Bytes && capacity > Arena->Max_Bytes) {
+        capacity = Arena->Max_Bytes;
+    }
+    char *data = Arena_Realloc(Arena->Data, capacity);
+    if (!data) {
+        return false;
+    }
+    Arena->Data = data;
+    Arena->Capacity = capacity;
+    return true;
+}
+
+static void Insert(String_Handle *Slots, uint32_t Slot_Count, const char *Text, String_Handle Handle)
+{
+    uint32_t mask = Slot_Count - 1;
+    uint32_t i = Hash(Text) & mask;
+    while (Slots[i] != String_Arena_None) {
+        i = (i + 1) & mask;
+    }
+    Slots[i] = Handle;
+}
+
+// Kept at most half full so probes stay short
+static bool Grow_Table(String_Arena *Arena)
+{
+    uint32_t count = Arena->Slot_Count ? Arena->Slot_Count * 2 : Slots_Min;
+    String_Handle *slots = Arena_Realloc(NULL, count * sizeof(String_Handle));
+    if (!slots) {
+        return false;
+    }
+    memset(slots, 0xFF, count * sizeof(String_Handle));
+    for (uint32_t i = 0; i < Arena->Slot_Count; i++) {
+        String_Handle handle = Arena->Slots[i];
+        if (handle != String_Arena_None) {
+            Insert(slots, count, Arena->Data + handle, handle);
+        }
+    }
+    free(Arena->Slots);
+    Arena->Slots = slots;
+    Arena->Slot_Count = count;
+    return true;
+}
+
+bool String_Arena_Init(String_Arena *Arena, uint32_t Initial_Bytes, uint32_t Max_Bytes)
+{
+    memset(Arena, 0, sizeof(*Arena));
+    Arena->Max_Bytes = Max_Bytes;
+    if (Max_Bytes && Initial_Bytes > Max_Bytes) {
+        Initial_Bytes = Max_Bytes;
+    }
+    Arena->Data = Arena_Realloc(NULL, Initial_Bytes ? Initial_Bytes : 1);
+    if (!Arena->Data) {
+        return false;
+    }
+    Arena->Capacity = Initial_Bytes ? Initial_Bytes : 1;
+    Arena->Data[0] = '\0';                                  // String_Arena_Empty
+    Arena->Used = 1;
+    return true;
+}
+
+void String_Arena_Free(String_Arena *Arena)
+{
+    free(Arena->Data);
+    free(Arena->Slots);
+    memset(Arena, 0, sizeof(*Arena));
+}
+
+void String_Arena_Reset(String_Arena *Arena)
+{
+    Arena->Used = 1;
+    if (Arena->Slots) {
+        memset(Arena->Slots, 0xFF, Arena->Slot_Count * sizeof(String_Handle));
+    }
+    Arena->Interned = 0;
+}
+
+String_Handle String_Arena_Add_Length(String_Arena *Arena, const char *Text, size_t Length)
+{
+    if (Length == 0) {
+        return String_Arena_Empty;
+    }
+    if (Length >= UINT32_MAX || !Reserve(Arena, Length + 1)) {
+        return String_Arena_None;
+    }
+    String_Handle handle = Arena->Used;
+    memcpy(Arena->Data + handle, Text, Length);
+    Arena->Data[handle + Length] = '\0';
+    Arena->Used += Length + 1;
+    return handle;
+}
+
+String_Handle String_Arena_Add(String_Arena *Arena, const char *Text)
+{
+    return String_Arena_Add_Length(Arena, Text, strlen(Text));
+}
+
+String_Handle String_Arena_Intern(String_Arena *Arena, const char *Text)
+{
+    if (!Text[0]) {
+        return String_Arena_Empty;
+    }
+    if ((Arena->Interned + 1) * 2 > Arena->Slot_Count && !Grow_Table(Arena)) {
+        return String_Arena_None;
+    }
+    uint32_t mask = Arena->Slot_Count - 1;
+    for (uint32_t i = Hash(Text) & mask;; i = (i + 1) & mask) {
+        String_Handle handle = Arena->Slots[i];
+        if (handle == String_Arena_None) {
+            handle = String_Arena_Add(Arena, Text);
+            if (handle != String_Arena_None) {
+                Arena->Slots[i] = handle;
+                Arena->Interned++;
+            }
+            return handle;
+        }
+        if (strcmp(Arena->Data + handle, Text) == 0) {
+            return handle;
+        }
+    }
+}
+
+size_t String_Arena_Memory(const String_Arena *Arena)
+{
+    return Arena->Capacity + Arena->Slot_Count * sizeof(String_Handle);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+// Strings packed one after another in a single growing buffer, independent of FreeRTOS so it also builds on
+// the host, see host_bench/. A string is named by its offset, a handle, so the buffer can move as it grows and
+// a block of them can be saved and loaded as it is. Memory follows what is stored, not a fixed slot size, and
+// a list of names is read front to back. Interning stores equal strings once, for tags many tracks share.
+// Strings are never freed one by one, only the whole arena is reset.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define String_Arena_Empty          0                       // Handle of the empty string, in every arena
+#define String_Arena_None           UINT32_MAX              // No handle, the arena is full or out of memory
+#define String_Arena_Grow_Min       4096
+
+typedef uint32_t String_Handle;
+
+typedef struct {
+    char *Data;                                             // PSRAM on the device
+    uint32_t Used;
+    uint32_t Capacity;
+    uint32_t Max_Bytes;                                     // Used never grows past this, 0 for no limit
+    String_Handle *Slots;                                   // Intern table, open addressing, String_Arena_None is free
+    uint32_t Slot_Count;                                    // Power of two, 0 until the first String_Arena_Intern()
+    uint32_t Interned;                                      // Distinct strings in the table
+} String_Arena;
+
+bool String_Arena_Init(String_Arena *Arena, uint32_t Initial_Bytes, uint32_t Max_Bytes);
+void String_Arena_Free(String_Arena *Arena);
+void String_Arena_Reset(String_Arena *Arena);               // Drops every string, keeps the memory
+String_Handle String_Arena_Add(String_Arena *Arena, const char *Text);                      // Always a new copy, Text not in the arena
+String_Handle String_Arena_Add_Length(String_Arena *Arena, const char *Text, size_t Length); // Text need not be terminated
+String_Handle String_Arena_Intern(String_Arena *Arena, const char *Text);                   // The same handle for equal strings
+size_t String_Arena_Memory(const String_Arena *Arena);      // Bytes allocated, buffer and intern table
+
+// Valid until the next string is added, the buffer may move
+static inline const char *String_Arena_Get(const String_Arena *Arena, String_Handle Handle)
+{
+    return Arena->Data + Handle;
+}
@@ -0,0 +1,392 @@
+/**
+ * Host checks for the string arena, and what it saves over the ways names were kept before.
+ *
+ * The checks cover the empty string handle, handles staying valid while the buffer grows,
+ * strings of any length and UTF-8 kept whole, interning across table growth, the size
+ * limit and reset. The run fails if any check does.
+ *
+ * The comparison stores the same file names three ways: fixed 100 byte slots as the music
+ * list had (char[100][100]), one malloc() per name, and the arena with a 4 byte handle per
+ * name. Names are generated, a mix of short names, long titles and CJK names, or read from
+ * the directories given, recursively. For each it reports the bytes taken, the names cut
+ * short, and the time to walk the whole list in order. Last it stores the artist tag of
+ * every track, once added and once interned.
+ *
+ * usage: arena_test [-n names] [directory...]
+ */
+
+#include <dirent.h>
+#include <malloc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "String_Arena.h"
+
+#define USAGE "usage: %s [-n names] [directory...]\n"
+
+#define SLOT_BYTES          100                     // The old fixed name size
+#define MALLOC_HEADER       8                       // glibc chunk header, on top of malloc_usable_size()
+#define WALK_ROUNDS         200
+
+static uint32_t failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*-------------------- checks --------------------*/
+
+static void check_basics(void)
+{
+    String_Arena arena;
+    CHECK(String_Arena_Init(&arena, 16, 0));
+    CHECK(strcmp(String_Arena_Get(&arena, String_Arena_Empty), "") == 0);
+    CHECK(String_Arena_Add(&arena, "") == String_Arena_Empty);
+    CHECK(String_Arena_Intern(&arena, "") == String_Arena_Empty);
+
+    String_Handle abc = String_Arena_Add(&arena, "abc");
+    String_Handle hello = String_Arena_Add_Length(&arena, "hello world", 5);
+    CHECK(abc != String_Arena_Empty && hello != abc);
+    CHECK(strcmp(String_Arena_Get(&arena, abc), "abc") == 0);
+    CHECK(strcmp(String_Arena_Get(&arena, hello), "hello") == 0);
+    CHECK(arena.Used == 1 + 4 + 6);
+
+    // Thousands of strings, the buffer moves many times and every handle still names its string
+    enum { COUNT = 20000 };
+    static String_Handle handles[COUNT];
+    char text[32];
+    for (int i = 0; i < COUNT; i++) {
+        snprintf(text, sizeof(text), "name %d", i);
+        handles[i] = String_Arena_Add(&arena, text);
+    }
+    bool all = true;
+    for (int i = 0; i < COUNT; i++) {
+        snprintf(text, sizeof(text), "name %d", i);
+        all = all && strcmp(String_Arena_Get(&arena, handles[i]), text) == 0;
+    }
+    CHECK(all);
+    CHECK(strcmp(String_Arena_Get(&arena, abc), "abc") == 0);
+
+    // No length limit, and UTF-8 is copied byte for byte, never cut inside a character
+    size_t long_bytes = 100000;
+    char *long_text = malloc(long_bytes + 1);
+    for (size_t i = 0; i < long_bytes; i++) {
+        long_text[i] = 'a' + i % 26;
+    }
+    long_text[long_bytes] = '\0';
+    String_Handle long_handle = String_Arena_Add(&arena, long_text);
+    CHECK(long_handle != String_Arena_None && strcmp(String_Arena_Get(&arena, long_handle), long_text) == 0);
+    free(long_text);
+    const char *utf8 = "周杰伦 - 晴天 (Live at the Taipei Arena, Remastered Edition) 周杰伦 - 晴天 (Live at the Taipei Arena).mp3";
+    CHECK(strlen(utf8) > SLOT_BYTES);
+    String_Handle utf8_handle = String_Arena_Add(&arena, utf8);
+    CHECK(strcmp(String_Arena_Get(&arena, utf8_handle), utf8) == 0);
+
+    // A copy of the buffer is the same set of strings, handles are offsets
+    char *copy = malloc(arena.Used);
+    memcpy(copy, arena.Data, arena.Used);
+    CHECK(strcmp(copy + utf8_handle, utf8) == 0 && strcmp(copy + handles[COUNT - 1], "name 19999") == 0);
+    free(copy);
+    String_Arena_Free(&arena);
+    CHECK(arena.Data == NULL && arena.Slots == NULL);
+}
+
+static void check_intern(void)
+{
+    String_Arena arena;
+    CHECK(String_Arena_Init(&arena, 0, 0));
+    String_Handle first = String_Arena_Intern(&arena, "Artist");
+    uint32_t used = arena.Used;
+    CHECK(String_Arena_Intern(&arena, "Artist") == first);
+    CHECK(arena.Used == used);
+    CHECK(String_Arena_Intern(&arena, "artist") != first);
+    CHECK(String_Arena_Add(&arena, "Artist") != first);     // Adding always copies
+
+    // The table grows many times, earlier strings keep their handles
+    enum { COUNT = 10000 };
+    static String_Handle handles[COUNT];
+    char text[32];
+    for (int i = 0; i < COUNT; i++) {
+        snprintf(text, sizeof(text), "album %d", i);
+        handles[i] = String_Arena_Intern(&arena, text);
+    }
+    uint32_t distinct = arena.Interned;
+    bool same = true;
+    for (int i = COUNT - 1; i >= 0; i--) {
+        snprintf(text, sizeof(text), "album %d", i);
+        same = same && String_Arena_Intern(&arena, text) == handles[i];
+    }
+    CHECK(same);
+    CHECK(arena.Interned == distinct && distinct == COUNT + 2);
+    CHECK(arena.Interned * 2 <= arena.Slot_Count);
+    CHECK(String_Arena_Intern(&arena, "Artist") == first);
+
+    // Reset drops everything but keeps the memory
+    size_t memory = String_Arena_Memory(&arena);
+    String_Arena_Reset(&arena);
+    CHECK(arena.Used == 1 && arena.Interned == 0);
+    CHECK(String_Arena_Memory(&arena) == memory);
+    String_Handle again = String_Arena_Intern(&arena, "album 5");
+    CHECK(again == 1 && strcmp(String_Arena_Get(&arena, again), "album 5") == 0);
+    CHECK(String_Arena_Intern(&arena, "album 5") == again);
+    String_Arena_Free(&arena);
+}
+
+static void check_limit(void)
+{
+    String_Arena arena;
+    CHECK(String_Arena_Init(&arena, 8, 64));
+    uint32_t added = 0;
+    while (String_Arena_Add(&arena, "0123456789") != String_Arena_None) {      // 11 bytes each
+        added++;
+    }
+    CHECK(added == 5);
+    CHECK(arena.Used == 56 && arena.Capacity <= 64);
+    String_Handle small = String_Arena_Add(&arena, "1234567");                 // Exactly fills it
+    CHECK(small != String_Arena_None && arena.Used == 64);
+    CHECK(String_Arena_Add(&arena, "x") == String_Arena_None);
+    CHECK(String_Arena_Intern(&arena, "y") == String_Arena_None);
+    CHECK(arena.Interned == 0);
+    CHECK(strcmp(String_Arena_Get(&arena, small), "1234567") == 0);
+    String_Arena_Free(&arena);
+}
+
+/*-------------------- comparison --------------------*/
+
+typedef struct {
+    char **names;
+    uint32_t count;
+    uint32_t capacity;
+} name_list_t;
+
+static void add_name(name_list_t *list, const char *name)
+{
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 1024;
+        list->names = realloc(list->names, list->capacity * sizeof(char *));
+    }
+    list->names[list->count++] = strdup(name);
+}
+
+// Short names, long titles and CJK names, about the mix of a real music card
+static void generate_names(name_list_t *list, uint32_t count)
+{
+    static const char *words[] = { "Love", "Night", "Blue", "Summer", "River", "Heart", "Dream", "Light", "Road", "Rain" };
+    static const char *cjk[] = { "晴天", "稻香", "夜曲", "青花瓷", "七里香", "告白气球", "发如雪", "简单爱" };
+    srand(1);
+    for (uint32_t i = 0; i < count; i++) {
+        char name[512];
+        int kind = rand() % 10;
+        if (kind < 4) {
+            snprintf(name, sizeof(name), "%02u %s.mp3", i % 20 + 1, words[rand() % 10]);
+        } else if (kind < 7) {
+            int n = snprintf(name, sizeof(name), "%02u - The %s", i % 20 + 1, words[rand() % 10]);
+            int extra = rand() % 14;
+            for (int w = 0; w < extra; w++) {
+                n += snprintf(name + n, sizeof(name) - n, " %s", words[rand() % 10]);
+            }
+            snprintf(name + n, sizeof(name) - n, " (Remastered).mp3");
+        } else {
+            int n = snprintf(name, sizeof(name), "%02u ", i % 20 + 1);
+            int parts = 1 + rand() % 8;
+            for (int w = 0; w < parts; w++) {
+                n += snprintf(name + n, sizeof(name) - n, "%s%s", w ? " " : "", cjk[rand() % 8]);
+            }
+            snprintf(name + n, sizeof(name) - n, ".mp3");
+        }
+        add_name(list, name);
+    }
+}
+
+static void read_names(name_list_t *list, const char *directory)
+{
+    DIR *dir = opendir(directory);
+    if (!dir) {
+        return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        add_name(list, entry->d_name);
+        if (entry->d_type == DT_DIR) {
+            char path[4096];
+            snprintf(path, sizeof(path), "%s/%s", directory, entry->d_name);
+            read_names(list, path);
+        }
+    }
+    closedir(dir);
+}
+
+static void compare(const name_list_t *list)
+{
+    uint32_t count = list->count;
+    size_t text = 0;
+    uint32_t cut = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        size_t length = strlen(list->names[i]);
+        text += length + 1;
+        cut += length >= SLOT_BYTES;
+    }
+
+    // Fixed slots, as LVGL_Music.c had them
+    char (*slots)[SLOT_BYTES] = malloc((size_t)count * SLOT_BYTES);
+    for (uint32_t i = 0; i < count; i++) {
+        strncpy(slots[i], list->names[i], SLOT_BYTES - 1);
+        slots[i][SLOT_BYTES - 1] = '\0';
+    }
+
+    // One allocation per name, interleaved with others as a scanner's would be
+    char **copies = malloc(count * sizeof(char *));
+    void **noise = malloc(count * sizeof(void *));
+    size_t heap = count * sizeof(char *);
+    for (uint32_t i = 0; i < count; i++) {
+        copies[i] = strdup(list->names[i]);
+        noise[i] = malloc(64 + i % 256);
+        heap += malloc_usable_size(copies[i]) + MALLOC_HEADER;
+    }
+
+    String_Arena arena;
+    String_Arena_Init(&arena, 0, 0);
+    String_Handle *handles = malloc(count * sizeof(String_Handle));
+    double start = now_us();
+    for (uint32_t i = 0; i < count; i++) {
+        handles[i] = String_Arena_Add(&arena, list->names[i]);
+    }
+    double add_us = now_us() - start;
+    size_t arena_bytes = String_Arena_Memory(&arena) + count * sizeof(String_Handle);
+
+    // Walk every list in order, as drawing or searching it does
+    size_t sum = 0;
+    start = now_us();
+    for (int r = 0; r < WALK_ROUNDS; r++) {
+        for (uint32_t i = 0; i < count; i++) {
+            sum += strlen(slots[i]);
+        }
+    }
+    double slots_us = (now_us() - start) / WALK_ROUNDS;
+    start = now_us();
+    for (int r = 0; r < WALK_ROUNDS; r++) {
+        for (uint32_t i = 0; i < count; i++) {
+            sum += strlen(copies[i]);
+        }
+    }
+    double heap_us = (now_us() - start) / WALK_ROUNDS;
+    start = now_us();
+    for (int r = 0; r < WALK_ROUNDS; r++) {
+        for (uint32_t i = 0; i < count; i++) {
+            sum += strlen(String_Arena_Get(&arena, handles[i]));
+        }
+    }
+    double arena_us = (now_us() - start) / WALK_ROUNDS;
+
+    printf("%u names, %zu bytes of text, %u longer than %u bytes\n", count, text, cut, SLOT_BYTES - 1);
+    printf("  fixed slots  %9zu bytes  %6.2f per name  %u cut short  walk %7.1f us\n", (size_t)count * SLOT_BYTES,
+           (double)SLOT_BYTES, cut, slots_us);
+    printf("  malloc each  %9zu bytes  %6.2f per name  0 cut short  walk %7.1f us\n", heap, (double)heap / count, heap_us);
+    printf("  arena        %9zu bytes  %6.2f per name  0 cut short  walk %7.1f us  add %.3f us per name  (%u used)\n",
+           arena_bytes, (double)arena_bytes / count, arena_us, add_us / count, arena.Used);
+    if (sum == 0) {
+        printf("\n");                               // Keeps the walks from being optimized away
+    }
+
+    bool same = true;
+    for (uint32_t i = 0; i < count; i++) {
+        same = same && strcmp(String_Arena_Get(&arena, handles[i]), list->names[i]) == 0;
+        free(copies[i]);
+        free(noise[i]);
+    }
+    CHECK(same);
+    free(slots);
+    free(copies);
+    free(noise);
+    free(handles);
+    String_Arena_Free(&arena);
+}
+
+// Artist tags: a few hundred artists over thousands of tracks
+static void compare_intern(uint32_t tracks)
+{
+    String_Arena added, interned;
+    String_Arena_Init(&added, 0, 0);
+    String_Arena_Init(&interned, 0, 0);
+    char artist[64];
+    for (uint32_t t = 0; t < tracks; t++) {
+        snprintf(artist, sizeof(artist), "Artist Name Number %u", t / 12 % 400);
+        String_Arena_Add(&added, artist);
+        String_Arena_Intern(&interned, artist);
+    }
+    printf("%u artist tags, %u distinct\n", tracks, interned.Interned);
+    printf("  added        %9zu bytes\n", String_Arena_Memory(&added));
+    printf("  interned     %9zu bytes  (%u used, %u table slots)\n", String_Arena_Memory(&interned), interned.Used,
+           interned.Slot_Count);
+    String_Arena_Free(&added);
+    String_Arena_Free(&interned);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t generated = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+        case 'n':
+            generated = strtoul(optarg, NULL, 0);
+            break;
+        default:
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+
+    check_basics();
+    check_intern();
+    check_limit();
+    printf("checks: %u failed\n", failures);
+
+    name_list_t list = { 0 };
+    for (int i = optind; i < argc; i++) {
+        read_names(&list, argv[i]);
+    }
+    if (optind == argc) {
+        uint32_t sizes[] = { 100, 1000, 5000 };
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            if (generated && sizes[s] != generated) {
+                continue;
+            }
+            list.count = 0;
+            generate_names(&list, sizes[s]);
+            compare(&list);
+        }
+        if (generated && generated != 100 && generated != 1000 && generated != 5000) {
+            list.count = 0;
+            generate_names(&list, generated);
+            compare(&list);
+        }
+    } else if (list.count) {
+        compare(&list);
+    }
+    compare_intern(5000);
+
+    for (uint32_t i = 0; i < list.count; i++) {
+        free(list.names[i]);
+    }
+    free(list.names);
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
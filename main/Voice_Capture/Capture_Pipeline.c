@@ -0,0 +1,228 @@
+#include "Capture_Pipeline.h"
+
+#include <string.h>
+
+#define Capture_DC_Pole         0.995f                  // High pass corner around 13 Hz at 16 kHz
+
+/*-------------------- Ring --------------------*/
+bool Capture_Ring_Init(Capture_Ring *Ring, Capture_Frame *Frames, uint32_t Count)
+{
+    if (!Frames || Count < 2 || (Count & (Count - 1))) {
+        return false;
+    }
+    memset(Ring, 0, sizeof(*Ring));
+    Ring->Frames = Frames;
+    Ring->Count = Count;
+    atomic_init(&Ring->Head, 0);
+    for (int c = 0; c < Capture_Max_Consumers; c++) {
+        atomic_init(&Ring->Consumers[c].Used, false);
+        atomic_init(&Ring->Consumers[c].Tail, 0);
+    }
+    return true;
+}
+
+// Consumers start with the next frame published, nothing older
+int Capture_Ring_Attach(Capture_Ring *Ring, Capture_Notify Notify, void *Arg)
+{
+    for (int c = 0; c < Capture_Max_Consumers; c++) {
+        Capture_Consumer *consumer = &Ring->Consumers[c];
+        if (atomic_load(&consumer->Used)) {
+            continue;
+        }
+        atomic_store(&consumer->Tail, atomic_load(&Ring->Head));
+        consumer->Overruns = 0;
+        consumer->Notify = Notify;
+        consumer->Arg = Arg;
+        atomic_store(&consumer->Used, true);
+        return c;
+    }
+    return -1;
+}
+
+void Capture_Ring_Detach(Capture_Ring *Ring, int Consumer)
+{
+    atomic_store(&Ring->Consumers[Consumer].Used, false);
+}
+
+Capture_Frame *Capture_Ring_Acquire(Capture_Ring *Ring)
+{
+    uint32_t head = atomic_load_explicit(&Ring->Head, memory_order_relaxed);
+    bool full = false;
+    for (int c = 0; c < Capture_Max_Consumers; c++) {
+        Capture_Consumer *consumer = &Ring->Consumers[c];
+        if (!atomic_load_explicit(&consumer->Used, memory_order_acquire)) {
+            continue;
+        }
+        if (head - (uint32_t)atomic_load_explicit(&consumer->Tail, memory_order_acquire) >= Ring->Count) {
+            consumer->Overruns++;
+            full = true;
+        }
+    }
+    if (full) {
+        Ring->Dropped++;
+        return NULL;
+    }
+    return &Ring->Frames[head & (Ring->Count - 1)];
+}
+
+void Capture_Ring_Publish(Capture_Ring *Ring)
+{
+    uint32_t head = atomic_load_explicit(&Ring->Head, memory_order_relaxed);
+    Ring->Frames[head & (Ring->Count - 1)].Sequence = head + Ring->Dropped;
+    atomic_store_explicit(&Ring->Head, head + 1, memory_order_release);
+    for (int c = 0; c < Capture_Max_Consumers; c++) {
+        Capture_Consumer *consumer = &Ring->Consumers[c];
+        if (atomic_load_explicit(&consumer->Used, memory_order_acquire) && consumer->Notify) {
+            consumer->Notify(consumer->Arg);
+        }
+    }
+}
+
+// The frame stays valid, and is not rewritten, until the consumer releases it
+const Capture_Frame *Capture_Ring_Peek(Capture_Ring *Ring, int Consumer)
+{
+    uint32_t tail = atomic_load_explicit(&Ring->Consumers[Consumer].Tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&Ring->Head, memory_order_acquire)) {
+        return NULL;
+    }
+    return &Ring->Frames[tail & (Ring->Count - 1)];
+}
+
+void Capture_Ring_Release(Capture_Ring *Ring, int Consumer)
+{
+    Capture_Consumer *consumer = &Ring->Consumers[Consumer];
+    uint32_t tail = atomic_load_explicit(&consumer->Tail, memory_order_relaxed);
+    atomic_store_explicit(&consumer->Tail, tail + 1, memory_order_release);
+}
+
+uint32_t Capture_Ring_Pending(Capture_Ring *Ring, int Consumer)
+{
+    return (uint32_t)atomic_load(&Ring->Head) - (uint32_t)atomic_load(&Ring->Consumers[Consumer].Tail);
+}
+
+/*-------------------- DC removal and gain --------------------*/
+void Capture_DSP_Init(Capture_DSP *DSP, bool Dc_Remove, uint16_t Gain)
+{
+    DSP->Dc_Remove = Dc_Remove;
+    DSP->Gain = Gain;
+    DSP->Dc_Input = 0.0f;
+    DSP->Dc_Output = 0.0f;
+}
+
+void Capture_DSP_Process(Capture_DSP *DSP, int16_t *Samples, size_t Count)
+{
+    if (DSP->Dc_Remove) {
+        float gain = DSP->Gain * (1.0f / Capture_Gain_Unity);
+        float x1 = DSP->Dc_Input;
+        float y1 = DSP->Dc_Output;
+        for (size_t n = 0; n < Count; n++) {
+            float x = Samples[n];
+            y1 = x - x1 + Capture_DC_Pole * y1;
+            x1 = x;
+            float v = y1 * gain;
+            Samples[n] = (v > 32767.0f) ? 32767 : (v < -32768.0f) ? -32768 : (int16_t)v;
+        }
+        DSP->Dc_Input = x1;
+        DSP->Dc_Output = y1;
+    } else if (DSP->Gain != Capture_Gain_Unity) {
+        for (size_t n = 0; n < Count; n++) {
+            int32_t v = (Samples[n] * (int32_t)DSP->Gain) >> 8;
+            Samples[n] = (v > 32767) ? 32767 : (v < -32768) ? -32768 : v;
+        }
+    }
+}
+
+/*-------------------- Pipeline --------------------*/
+bool Capture_Pipeline_Init(Capture_Pipeline *Pipeline, Capture_Frame *Frames, uint32_t Count)
+{
+    memset(Pipeline, 0, sizeof(*Pipeline));
+    if (!Capture_Ring_Init(&Pipeline->Ring, Frames, Count)) {
+        return false;
+    }
+    Capture_DSP_Init(&Pipeline->DSP, true, Capture_Gain_Unity);
+    return audio_resampler_init(&Pipeline->Resampler, 1, Capture_Rate) == ESP_OK;
+}
+
+// Only the filter bank is rebuilt when the rate changes, so this is cheap to call before every block
+bool Capture_Pipeline_Set_Input(Capture_Pipeline *Pipeline, uint32_t Rate, uint32_t Channels, uint32_t Channel)
+{
+    if (Channels == 0 || Channel >= Channels) {
+        return false;
+    }
+    if (audio_resampler_set_input_rate(&Pipeline->Resampler, Rate) != ESP_OK) {
+        return false;
+    }
+    Pipeline->Input_Rate = Rate;
+    Pipeline->Input_Channels = Channels;
+    Pipeline->Input_Channel = Channel;
+    return true;
+}
+
+void Capture_Pipeline_Reset(Capture_Pipeline *Pipeline)
+{
+    Pipeline->Current = NULL;
+    Pipeline->Fill = 0;
+    audio_resampler_reset(&Pipeline->Resampler);
+    Capture_DSP_Init(&Pipeline->DSP, Pipeline->DSP.Dc_Remove, Pipeline->DSP.Gain);
+}
+
+void Capture_Pipeline_Push(Capture_Pipeline *Pipeline, const int16_t *Input, size_t Frames)
+{
+    if (Pipeline->Input_Channels == 0) {
+        return;
+    }
+    bool passthrough = audio_resampler_is_passthrough(&Pipeline->Resampler);
+    while (Frames) {
+        size_t block = (Frames < Capture_Block_Frames) ? Frames : Capture_Block_Frames;
+        const int16_t *in = Input;
+        if (Pipeline->Input_Channels > 1) {
+            for (size_t n = 0; n < block; n++) {
+                Pipeline->Mono[n] = Input[n * Pipeline->Input_Channels + Pipeline->Input_Channel];
+            }
+            in = Pipeline->Mono;
+        }
+        Input += block * Pipeline->Input_Channels;
+        Frames -= block;
+
+        // Resample straight into the ring slot, consumers get that same memory
+        size_t left = block;
+        while (left) {
+            if (!Pipeline->Current) {
+                Pipeline->Current = Capture_Ring_Acquire(&Pipeline->Ring);
+                if (!Pipeline->Current) {
+                    Pipeline->Current = &Pipeline->Scratch;        // Keep the filters running through a drop
+                }
+                Pipeline->Fill = 0;
+            }
+            int16_t *out = Pipeline->Current->Samples + Pipeline->Fill;
+            size_t room = Capture_Frame_Samples - Pipeline->Fill;
+            size_t used = left;
+            size_t produced;
+            if (passthrough) {
+                produced = (left < room) ? left : room;
+                memcpy(out, in, produced * sizeof(int16_t));
+                used = produced;
+            } else {
+                produced = audio_resampler_process(&Pipeline->Resampler, in, &used, out, room);
+            }
+            in += used;
+            left -= used;
+            Pipeline->Fill += produced;
+            if (Pipeline->Fill == Capture_Frame_Samples) {
+                Capture_DSP_Process(&Pipeline->DSP, Pipeline->Current->Samples, Capture_Frame_Samples);
+                if (Pipeline->Echo) {
+                    Echo_Canceller_Process(Pipeline->Echo, Pipeline->Current->Samples, Capture_Frame_Samples);
+                }
+                if (Pipeline->Current != &Pipeline->Scratch) {
+                    Capture_Ring_Publish(&Pipeline->Ring);
+                }
+                Pipeline->Current = NULL;
+            }
+        }
+    }
+}
+
+void Capture_Pipeline_Free(Capture_Pipeline *Pipeline)
+{
+    audio_resampler_free(&Pipeline->Resampler);
+}
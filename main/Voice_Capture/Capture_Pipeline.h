@@ -0,0 +1,81 @@
+#pragma once
+
+// Microphone frames, independent of FreeRTOS and the I2S driver so it also builds on the host, see host_bench/
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "audio_resample.h"
+#include "Echo_Canceller.h"
+
+#define Capture_Rate                16000                   // Every consumer sees 16 kHz mono
+#define Capture_Frame_Samples       320                     // 20 ms
+#define Capture_Pool_Frames         16                      // Power of two, 320 ms of slack for slow consumers
+#define Capture_Max_Consumers       4
+#define Capture_Block_Frames        240                     // Input frames per read, one I2S DMA buffer
+#define Capture_Gain_Unity          256                     // Gain is Q8
+
+typedef struct {
+    uint32_t Sequence;                                      // Frames published before this one, gaps are drops
+    int16_t Samples[Capture_Frame_Samples];
+} Capture_Frame;
+
+typedef void (*Capture_Notify)(void *Arg);                  // Called by the writer after each frame, keep it short
+
+typedef struct {
+    atomic_bool Used;
+    atomic_uint_fast32_t Tail;                              // Sequence of the next frame to read
+    uint32_t Overruns;                                      // Frames dropped while this consumer was full
+    Capture_Notify Notify;
+    void *Arg;
+} Capture_Consumer;
+
+// Single writer, up to Capture_Max_Consumers readers. A slot is reused only once every consumer has released it;
+// when the slowest consumer is a whole pool behind the newest frame is dropped instead.
+typedef struct {
+    Capture_Frame *Frames;
+    uint32_t Count;
+    atomic_uint_fast32_t Head;                              // Sequence of the next frame to publish
+    uint32_t Dropped;
+    Capture_Consumer Consumers[Capture_Max_Consumers];
+} Capture_Ring;
+
+typedef struct {
+    bool Dc_Remove;
+    uint16_t Gain;                                          // Q8, Capture_Gain_Unity passes samples through
+    float Dc_Input;                                         // Previous input sample
+    float Dc_Output;                                        // Previous output
+} Capture_DSP;
+
+typedef struct {
+    Capture_Ring Ring;
+    Capture_DSP DSP;
+    Echo_Canceller *Echo;                                   // NULL leaves the speaker echo in
+    audio_resampler_t Resampler;
+    uint32_t Input_Rate;
+    uint32_t Input_Channels;
+    uint32_t Input_Channel;                                 // Slot the microphone is on
+    Capture_Frame *Current;                                 // Slot being filled, Scratch while the ring is full
+    size_t Fill;
+    Capture_Frame Scratch;
+    int16_t Mono[Capture_Block_Frames];
+} Capture_Pipeline;
+
+bool Capture_Ring_Init(Capture_Ring *Ring, Capture_Frame *Frames, uint32_t Count);
+int Capture_Ring_Attach(Capture_Ring *Ring, Capture_Notify Notify, void *Arg);        // Consumer id, -1 if all are taken
+void Capture_Ring_Detach(Capture_Ring *Ring, int Consumer);
+Capture_Frame *Capture_Ring_Acquire(Capture_Ring *Ring);                             // NULL when the frame has to be dropped
+void Capture_Ring_Publish(Capture_Ring *Ring);
+const Capture_Frame *Capture_Ring_Peek(Capture_Ring *Ring, int Consumer);            // Oldest unread frame, NULL if none
+void Capture_Ring_Release(Capture_Ring *Ring, int Consumer);
+uint32_t Capture_Ring_Pending(Capture_Ring *Ring, int Consumer);
+
+void Capture_DSP_Init(Capture_DSP *DSP, bool Dc_Remove, uint16_t Gain);
+void Capture_DSP_Process(Capture_DSP *DSP, int16_t *Samples, size_t Count);
+
+bool Capture_Pipeline_Init(Capture_Pipeline *Pipeline, Capture_Frame *Frames, uint32_t Count);
+bool Capture_Pipeline_Set_Input(Capture_Pipeline *Pipeline, uint32_t Rate, uint32_t Channels, uint32_t Channel);
+void Capture_Pipeline_Reset(Capture_Pipeline *Pipeline);                            // Drop a partial frame and the filter state
+void Capture_Pipeline_Push(Capture_Pipeline *Pipeline, const int16_t *Input, size_t Frames);    // Interleaved input frames
+void Capture_Pipeline_Free(Capture_Pipeline *Pipeline);
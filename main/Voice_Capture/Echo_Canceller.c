@@ -0,0 +1,317 @@
+#include "Echo_Canceller.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define Weight_Shift            28
+#define Gain_Shift              8                       // Extra bits of the per sample update gain
+#define Reference_Margin        256                     // Oldest samples, the writer may be overwriting them
+#define Regularization          ((int64_t)Echo_Taps * Echo_Min_Reference * Echo_Min_Reference)
+#define Clipped                 32000                   // Microphone level the echo path stops being linear at
+#define Dc_Pole                 32604                   // Q15, the 0.995 of Capture_DSP_Process()
+#define Copy_Blocks             2                       // Blocks the background filter has to win in a row
+#define Search_Blocks           10                      // Blocks without echo reduction before the delay is searched again
+
+static inline int16_t Clamp_Sample(int32_t Value)
+{
+    return (Value > 32767) ? 32767 : (Value < -32768) ? -32768 : Value;
+}
+
+static inline int32_t Clamp_Echo(int64_t Value)
+{
+    return (Value > 65535) ? 65535 : (Value < -65536) ? -65536 : (int32_t)Value;
+}
+
+// Zero for samples not written yet or already overwritten, the speaker was silent or is about to be
+static inline int16_t Reference_At(const Echo_Canceller *Echo, uint32_t Head, uint32_t Index)
+{
+    uint32_t age = Head - Index;
+    if (age == 0 || age > Echo_Reference_Samples - Reference_Margin) {
+        return 0;
+    }
+    return Echo->Reference[Index & (Echo_Reference_Samples - 1)];
+}
+
+void Echo_Canceller_Init(Echo_Canceller *Echo)
+{
+    memset(Echo, 0, sizeof(*Echo));
+    atomic_init(&Echo->Reference_Head, 0);
+    Echo_Canceller_Reset(Echo);
+}
+
+void Echo_Canceller_Reset(Echo_Canceller *Echo)
+{
+    Echo->Mic_Count = 0;
+    Echo->Locked = false;
+    Echo->Better_Blocks = 0;
+    Echo->Stuck_Blocks = 0;
+    Echo->Mic_Decimated_Count = 0;
+    Echo->Mic_Sum = 0;
+    Echo->Last_Head = atomic_load(&Echo->Reference_Head);
+    Echo->Reference_Running = 0;
+    Echo->Reference_Idle = 0;
+    Echo->Since_Search = Echo_Search_Interval;
+    Echo->Search_Lag = -1;
+    Echo->Pending = false;
+    Echo->Relocks = 0;
+    Echo->Far_Mic_Energy = 0;
+    Echo->Far_Error_Energy = 0;
+    Echo->Copies = 0;
+    Echo->Restores = 0;
+    Echo->Bypassed = 0;
+}
+
+void Echo_Canceller_Reference(Echo_Canceller *Echo, const int16_t *Samples, size_t Count)
+{
+    uint32_t head = atomic_load_explicit(&Echo->Reference_Head, memory_order_relaxed);
+    for (size_t n = 0; n < Count; n++) {
+        Echo->Reference[(head + n) & (Echo_Reference_Samples - 1)] = Samples[n];
+    }
+    atomic_store_explicit(&Echo->Reference_Head, head + Count, memory_order_release);
+}
+
+/*-------------------- Delay search --------------------*/
+static void Lock(Echo_Canceller *Echo, uint32_t Offset)
+{
+    if (!Echo->Locked) {
+        memset(Echo->Weights, 0, sizeof(Echo->Weights));   // Learned against another alignment
+        memset(Echo->Background, 0, sizeof(Echo->Background));
+    } else {
+        Echo->Relocks++;                                    // The echo path is the same, only shifted, keep it
+    }
+    Echo->Locked = true;
+    Echo->Offset = Offset;
+    memset(Echo->History, 0, sizeof(Echo->History));
+    Echo->Dc_Input = 0;
+    Echo->Dc_Output = 0;
+    Echo->History_Pos = 0;
+    Echo->Energy = 0;
+    Echo->Pending = false;
+}
+
+// Snapshots the newest microphone window and the reference it can echo, so the search can run over many blocks
+static void Search_Start(Echo_Canceller *Echo, uint32_t Head)
+{
+    // Means removed, an offset in either signal correlates at every lag
+    uint32_t first = Echo->Mic_Decimated_Count - Echo_Search_Window;
+    int32_t mean = 0;
+    for (int i = 0; i < Echo_Search_Window; i++) {
+        Echo->Search_Mic[i] = Echo->Mic_Decimated[(first + i) & (Echo_Search_Window - 1)];
+        mean += Echo->Search_Mic[i];
+    }
+    mean /= Echo_Search_Window;
+    Echo->Search_Mic_Energy = 0;
+    for (int i = 0; i < Echo_Search_Window; i++) {
+        Echo->Search_Mic[i] -= mean;
+        Echo->Search_Mic_Energy += Echo->Search_Mic[i] * Echo->Search_Mic[i];
+    }
+    uint32_t reference_start = Head - Echo_Search_Span * Echo_Search_Decimation;
+    mean = 0;
+    for (int j = 0; j < Echo_Search_Span; j++) {
+        int32_t sum = 0;
+        for (int q = 0; q < Echo_Search_Decimation; q++) {
+            sum += Reference_At(Echo, Head, reference_start + j * Echo_Search_Decimation + q);
+        }
+        Echo->Search_Reference[j] = sum / Echo_Search_Decimation;
+        mean += Echo->Search_Reference[j];
+    }
+    mean /= Echo_Search_Span;
+    Echo->Search_Reference_Energy = 0;
+    for (int j = 0; j < Echo_Search_Span; j++) {
+        Echo->Search_Reference[j] -= mean;
+        if (j < Echo_Search_Window) {
+            Echo->Search_Reference_Energy += Echo->Search_Reference[j] * Echo->Search_Reference[j];
+        }
+    }
+    Echo->Search_Origin = reference_start - first * Echo_Search_Decimation;
+    Echo->Search_Best_Score = 0.0f;
+    Echo->Search_Best_Lag = -1;
+    Echo->Search_Best_Coherence = 0.0f;
+    Echo->Search_Lag = 0;
+}
+
+static void Search_Finish(Echo_Canceller *Echo)
+{
+    Echo->Search_Lag = -1;
+    Echo->Since_Search = 0;
+    if (Echo->Search_Best_Lag < 0 || Echo->Search_Best_Coherence < Echo_Min_Coherence) {
+        // No echo to be found, or the near end drowned it, look again once the window has moved on
+        Echo->Since_Search = Echo_Search_Interval - Echo_Search_Window * Echo_Search_Decimation / 4;
+        return;
+    }
+    uint32_t offset = Echo->Search_Origin + Echo->Search_Best_Lag * Echo_Search_Decimation + Echo_Lead_Taps;
+    if (!Echo->Locked) {
+        Lock(Echo, offset);
+        return;
+    }
+    int32_t moved = (int32_t)(offset - Echo->Offset);
+    if (moved >= -Echo_Taps / 4 && moved <= Echo_Taps / 4) {
+        Echo->Pending = false;                              // Within what the filter tracks by itself
+    } else if (Echo->Pending && abs((int32_t)(offset - Echo->Pending_Offset)) <= 2 * Echo_Search_Decimation) {
+        Lock(Echo, offset);
+    } else {
+        Echo->Pending = true;
+        Echo->Pending_Offset = offset;
+        Echo->Since_Search = Echo_Search_Interval;          // Confirm it right away
+    }
+}
+
+// Echo_Search_Lags lags per block, the score is the echo power a lag explains
+static void Search_Step(Echo_Canceller *Echo)
+{
+    const int32_t last = Echo_Search_Span - Echo_Search_Window;
+    int32_t end = Echo->Search_Lag + Echo_Search_Lags;
+    if (end > last + 1) {
+        end = last + 1;
+    }
+    const int16_t *mic = Echo->Search_Mic;
+    for (int32_t lag = Echo->Search_Lag; lag < end; lag++) {
+        const int16_t *ref = Echo->Search_Reference + lag;
+        int64_t c = 0;
+        for (int i = 0; i < Echo_Search_Window; i++) {
+            c += mic[i] * ref[i];
+        }
+        if (Echo->Search_Reference_Energy > 0 && Echo->Search_Mic_Energy > 0) {
+            float score = (float)c * (float)c / (float)Echo->Search_Reference_Energy;
+            if (score > Echo->Search_Best_Score) {
+                Echo->Search_Best_Score = score;
+                Echo->Search_Best_Lag = lag;
+                Echo->Search_Best_Coherence = score / (float)Echo->Search_Mic_Energy;
+            }
+        }
+        if (lag < last) {
+            Echo->Search_Reference_Energy += ref[Echo_Search_Window] * ref[Echo_Search_Window] - ref[0] * ref[0];
+        }
+    }
+    Echo->Search_Lag = end;
+    if (end > last) {
+        Search_Finish(Echo);
+    }
+}
+
+/*-------------------- NLMS --------------------*/
+static void Process_Block(Echo_Canceller *Echo, int16_t *Samples, size_t Count)
+{
+    uint32_t head = atomic_load_explicit(&Echo->Reference_Head, memory_order_acquire);
+
+    for (size_t n = 0; n < Count; n++) {
+        Echo->Mic_Sum += Samples[n];                        // Before any echo is removed, the search needs it
+        if ((Echo->Mic_Count + n + 1) % Echo_Search_Decimation == 0) {
+            Echo->Mic_Decimated[Echo->Mic_Decimated_Count++ & (Echo_Search_Window - 1)] = Echo->Mic_Sum / Echo_Search_Decimation;
+            Echo->Mic_Sum = 0;
+        }
+    }
+    Echo->Reference_Idle = (head != Echo->Last_Head) ? 0 : Echo->Reference_Idle + Count;
+    if (Echo->Reference_Idle < Echo_Reference_Stall) {
+        Echo->Reference_Running += Count;
+    } else {
+        Echo->Reference_Running = 0;
+        Echo->Since_Search = Echo_Search_Interval;          // The speaker stopped, its next start may be elsewhere
+    }
+    Echo->Last_Head = head;
+    if (Echo->Search_Lag >= 0) {
+        Search_Step(Echo);
+    } else if (Echo->Since_Search >= Echo_Search_Interval && Echo->Mic_Decimated_Count >= Echo_Search_Window &&
+               Echo->Reference_Running >= Echo_Search_Window * Echo_Search_Decimation) {
+        Search_Start(Echo, head);
+    }
+    Echo->Since_Search += Count;
+
+    if (!Echo->Locked) {
+        Echo->Mic_Count += Count;
+        return;
+    }
+
+    int64_t mic_energy = 0, error_energy = 0, background_energy = 0, reference_energy = 0;
+    memcpy(Echo->Mic, Samples, Count * sizeof(int16_t));
+    for (size_t n = 0; n < Count; n++) {
+        int32_t input = Reference_At(Echo, head, Echo->Mic_Count + Echo->Offset);
+        Echo->Dc_Output = input - Echo->Dc_Input + ((Dc_Pole * Echo->Dc_Output) >> 15);
+        Echo->Dc_Input = input;
+        int16_t x = Clamp_Sample(Echo->Dc_Output);
+        uint32_t p = Echo->History_Pos;
+        int16_t old = Echo->History[p];
+        Echo->History[p] = x;
+        Echo->History[p + Echo_Taps] = x;
+        Echo->History_Pos = (p + 1 == Echo_Taps) ? 0 : p + 1;
+        Echo->Energy += x * x - old * old;
+        const int16_t *window = &Echo->History[p + 1];     // Oldest first, x is the last
+
+        int64_t acc = 0, background_acc = 0;
+        for (int k = 0; k < Echo_Taps; k++) {
+            acc += (int64_t)Echo->Weights[k] * window[k];
+            background_acc += (int64_t)Echo->Background[k] * window[k];
+        }
+        int32_t d = Samples[n];
+        int32_t e = d - Clamp_Echo(acc >> Weight_Shift);
+        int32_t background_e = d - Clamp_Echo(background_acc >> Weight_Shift);
+        Samples[n] = Clamp_Sample(e);
+
+        if (Echo->Energy >= Regularization && abs(d) < Clipped) {     // A clipped microphone is no echo path
+            // w += mu e x / |x|^2, as a Q(28 + Gain_Shift) gain per unit of reference
+            int64_t g = ((int64_t)Echo_Step * background_e << (Weight_Shift - 15 + Gain_Shift)) / (Echo->Energy + Regularization);
+            for (int k = 0; k < Echo_Taps; k++) {
+                Echo->Background[k] += (int32_t)((g * window[k]) >> Gain_Shift);
+            }
+        }
+        mic_energy += d * d;
+        error_energy += e * e;
+        background_energy += background_e * background_e;
+        reference_energy += x * x;
+        Echo->Mic_Count++;
+    }
+    if (error_energy > mic_energy) {
+        memcpy(Samples, Echo->Mic, Count * sizeof(int16_t));   // Never louder than no cancelling, the echo it expects is not there
+        error_energy = mic_energy;
+        Echo->Bypassed++;
+    }
+    if (reference_energy < (int64_t)Count * Echo_Min_Reference * Echo_Min_Reference) {
+        return;                                             // Nothing played, nothing to judge the filters by
+    }
+
+    // Near end speech throws the background filter off, so it only reaches the output once it clearly cancels
+    // better than the foreground, and starts over from the foreground once it does clearly worse
+    if (2 * background_energy < error_energy && 4 * background_energy < mic_energy) {
+        if (++Echo->Better_Blocks >= Copy_Blocks) {
+            memcpy(Echo->Weights, Echo->Background, sizeof(Echo->Weights));
+            Echo->Better_Blocks = 0;
+            Echo->Copies++;
+        }
+    } else {
+        Echo->Better_Blocks = 0;
+        if (background_energy > 4 * error_energy || background_energy > 2 * mic_energy) {
+            memcpy(Echo->Background, Echo->Weights, sizeof(Echo->Background));
+            Echo->Restores++;
+        }
+    }
+
+    // Neither filter gets anywhere for a while, the delay may have moved
+    if (4 * mic_energy < 5 * error_energy && 4 * mic_energy < 5 * background_energy) {
+        if (++Echo->Stuck_Blocks == Search_Blocks && Echo->Search_Lag < 0) {
+            Echo->Since_Search = Echo_Search_Interval;
+        }
+    } else {
+        Echo->Stuck_Blocks = 0;
+    }
+    Echo->Far_Mic_Energy += mic_energy;
+    Echo->Far_Error_Energy += error_energy;
+}
+
+void Echo_Canceller_Process(Echo_Canceller *Echo, int16_t *Samples, size_t Count)
+{
+    while (Count) {
+        size_t block = (Count < Echo_Block) ? Count : Echo_Block;
+        Process_Block(Echo, Samples, block);
+        Samples += block;
+        Count -= block;
+    }
+}
+
+float Echo_Canceller_Erle(const Echo_Canceller *Echo)
+{
+    if (Echo->Far_Error_Energy == 0) {
+        return 0.0f;
+    }
+    return 10.0f * log10f((float)Echo->Far_Mic_Energy / (float)Echo->Far_Error_Energy);
+}
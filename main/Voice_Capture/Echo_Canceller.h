@@ -0,0 +1,81 @@
+#pragma once
+
+// Speaker echo removal for the microphone, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// The speaker output, resampled to 16 kHz mono, is the reference. A coarse delay search lines it up with the
+// microphone, then a fixed point NLMS filter estimates the echo left and subtracts it. The filter adapts in the
+// background and only replaces the one in use when it cancels clearly better, so near end speech over the reply
+// does not throw the output off. The cost per block is fixed: both filters plus a slice of the delay search.
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Echo_Taps                   256                     // 16 ms of echo tail at 16 kHz
+#define Echo_Lead_Taps              32                      // Taps ahead of the delay found, covers its coarse steps
+#define Echo_Reference_Samples      16384                   // Power of two, 1 s of speaker output
+#define Echo_Step                   8192                    // NLMS step size of the background filter, Q15
+#define Echo_Block                  320                     // Samples the filters are judged over, 20 ms
+#define Echo_Min_Reference          512                     // RMS below which the reference counts as silence
+#define Echo_Reference_Stall        1600                    // Samples without a reference write before the speaker counts as stopped
+
+#define Echo_Search_Decimation      4                       // Delay search at 4 kHz
+#define Echo_Search_Window          1024                    // Decimated microphone samples correlated, 256 ms
+#define Echo_Search_Span            2048                    // Decimated reference samples searched, 512 ms
+#define Echo_Search_Lags            64                      // Tried per block, bounds the cost of a search
+#define Echo_Search_Interval        16000                   // Samples between searches, 1 s
+#define Echo_Min_Coherence          0.2f                    // Squared correlation a delay needs to be taken
+
+typedef struct {
+    // Writer side, the task playing the speaker output
+    int16_t Reference[Echo_Reference_Samples];
+    atomic_uint_fast32_t Reference_Head;                    // Samples written since Echo_Canceller_Init()
+
+    // Reader side, the capture task
+    uint32_t Mic_Count;                                     // Samples processed since the last reset
+    bool Locked;                                            // Offset is valid
+    uint32_t Offset;                                        // Reference index of the newest tap, minus Mic_Count
+    int32_t Weights[Echo_Taps];                             // Q28, oldest tap first, the foreground filter
+    int32_t Background[Echo_Taps];                          // Adapting all the time, copied over when it does better
+    int32_t Dc_Input;                                       // Reference DC blocker, as the microphone has one
+    int32_t Dc_Output;
+    int16_t History[2 * Echo_Taps];                         // Aligned reference, written twice so it is contiguous
+    uint32_t History_Pos;
+    int64_t Energy;                                         // Sum of squares over History
+    uint32_t Better_Blocks;                                 // In a row the background filter cancelled more
+    uint32_t Stuck_Blocks;                                  // In a row neither filter cancelled anything
+    int16_t Mic[Echo_Block];                                // The block as it came, in case cancelling makes it worse
+
+    int16_t Mic_Decimated[Echo_Search_Window];              // Newest raw microphone, circular
+    uint32_t Mic_Decimated_Count;
+    int32_t Mic_Sum;
+    uint32_t Last_Head;                                     // Reference_Head at the last block
+    uint32_t Reference_Running;                             // Samples the reference has kept advancing for
+    uint32_t Reference_Idle;                                // Since it last advanced, the player writes in bursts
+    uint32_t Since_Search;
+    int32_t Search_Lag;                                     // Next lag to try, -1 when no search runs
+    uint32_t Search_Origin;                                 // Reference index minus microphone index at lag 0
+    int16_t Search_Mic[Echo_Search_Window];
+    int16_t Search_Reference[Echo_Search_Span];
+    int64_t Search_Mic_Energy;
+    int64_t Search_Reference_Energy;                        // Over the window at Search_Lag
+    float Search_Best_Score;
+    int32_t Search_Best_Lag;
+    float Search_Best_Coherence;
+    bool Pending;                                           // A new delay waits to be seen twice
+    uint32_t Pending_Offset;
+
+    // Statistics
+    uint32_t Relocks;                                       // Delay changes after the first lock
+    uint64_t Far_Mic_Energy;                                // Over blocks the speaker played, ERLE is their ratio
+    uint64_t Far_Error_Energy;
+    uint32_t Copies;                                        // Background filter taken over
+    uint32_t Restores;                                      // Background filter thrown off, by double talk mostly
+    uint32_t Bypassed;                                      // Blocks passed through, cancelling made them louder
+} Echo_Canceller;
+
+void Echo_Canceller_Init(Echo_Canceller *Echo);
+void Echo_Canceller_Reset(Echo_Canceller *Echo);            // Reader side, when the microphone restarts
+void Echo_Canceller_Reference(Echo_Canceller *Echo, const int16_t *Samples, size_t Count);     // Writer side
+void Echo_Canceller_Process(Echo_Canceller *Echo, int16_t *Samples, size_t Count);             // In place, reader side
+float Echo_Canceller_Erle(const Echo_Canceller *Echo);      // dB while the speaker played since the last reset, near end speech included
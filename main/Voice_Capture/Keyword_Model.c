@@ -0,0 +1,1342 @@
+// Generated by host_bench/kws_train, do not edit. Trained on 96 streams, 72.0 minutes:
+// 458 of 459 wake words found, 0 false accepts at the threshold below
+
+#include "Keyword_Spotter.h"
+
+static const int8_t Hidden_Weights[Keyword_Hidden * Keyword_Inputs] = {
+    // Hidden unit 0
+    20, 9, 22, -23, -2, -7, -16, -21, -23, -33, -53, -76, -9, -10, -10, 11, 13, 47, 36, 62,
+    32, 23, -5, -16, -21, -7, -5, -12, -14, -21, -48, -50, -14, 20, -1, 5, 30, 27, 32, 44,
+    22, 16, -16, -32, -8, 11, 10, -10, -9, -17, -41, -57, -13, 14, -4, -4, 5, 28, 32, 46,
+    12, -3, -33, -49, 8, 17, 9, -5, -23, -11, -22, -70, -3, 11, -5, 1, 17, 33, 29, 41,
+    34, 22, -7, -48, 22, 26, -14, -19, -31, -1, -50, -77, -10, 13, -6, -5, 10, 19, 31, 23,
+    46, 13, -8, -5, 46, 42, 16, -17, -23, -1, -27, -58, -20, 0, -1, 8, 6, 29, 22, 41,
+    45, 37, 2, -6, 41, 19, 6, -15, -23, 1, -19, -59, -7, 8, 13, -8, 22, 19, 34, 46,
+    28, 41, 2, 1, 32, 9, 4, -29, -19, -4, -13, -42, -4, 6, 7, 19, 9, 28, 32, 42,
+    35, 41, 17, 10, 46, 11, 6, -4, -1, -19, -16, -36, 1, 18, -7, -5, 0, 4, 26, 26,
+    38, 34, 16, 6, 64, 21, -1, -15, -17, -14, -20, -42, -1, -1, -22, -32, -27, -36, -23, -27,
+    31, 26, 20, 8, 51, 14, -8, -9, -13, -6, -7, -8, 17, 0, -21, -45, -41, -36, -49, -68,
+    24, 17, 15, 18, 46, 25, -15, 16, 8, -9, -11, -25, 13, 15, -23, -25, -31, -54, -58, -53,
+    22, 22, 0, 13, 22, 0, -14, 5, -1, -6, 18, -9, 10, 11, -30, -34, -21, -45, -38, -59,
+    24, 5, 1, 6, 12, -8, -39, 1, 1, -9, 6, -35, 6, -5, -30, -40, -50, -39, -62, -57,
+    7, -1, 10, -7, -20, -32, -43, -13, -20, 3, 13, -15, 10, -8, -42, -34, -47, -41, -52, -53,
+    12, 0, 9, 2, -21, -16, -43, -12, -11, 5, 24, -21, 11, 2, -30, -30, -34, -42, -39, -27,
+    26, -10, -4, 6, -29, -44, -54, -20, -32, -2, -3, -16, 19, 15, -16, -32, -22, -22, -21, -25,
+    28, -7, -5, 19, -47, -55, -55, -24, -26, 0, 20, -15, 9, 10, -26, -23, -25, -23, -9, -22,
+    20, 1, 0, 7, -46, -49, -50, -20, -15, -2, 3, 4, 22, 26, -13, -8, -7, -17, -2, -19,
+    32, -7, -4, 8, -23, -54, -51, -29, -9, -2, 4, -5, 22, 7, 10, 11, -13, -6, 17, 7,
+    20, -1, 11, 10, -27, -51, -40, -35, -11, -6, -1, 7, 22, 30, 1, -3, -13, -3, 2, -14,
+    33, -5, 9, -6, -6, -38, -51, -20, -1, 2, 8, -2, 25, 20, -5, 1, 3, -4, 19, 13,
+    10, -10, 2, 6, 4, -36, -17, -7, -7, 4, 20, -13, 31, 14, 11, 3, 12, -1, 17, 8,
+    25, -5, 2, -8, -9, -23, -24, -5, 0, 26, -7, 3, 34, 17, 10, 18, 9, 6, 29, 17,
+    -7, -30, 3, 18, -6, -24, -2, -16, 10, 27, 7, 7, 31, 34, 25, 15, 24, 28, 43, 39,
+    19, -18, 6, 16, 15, -18, -4, 11, 10, 12, 11, 7, 23, 37, 8, 8, 21, 7, 27, 31,
+    17, -5, 29, 32, 27, 13, 15, 16, 14, 29, 32, 10, 28, 52, 13, 14, 17, 20, 31, 25,
+    5, -17, 30, 33, 27, 4, 30, 27, 41, 32, 18, 5, 37, 54, 23, 9, 17, 6, 16, 24,
+    1, -28, 11, 35, 54, 28, 40, 28, 29, 6, 2, -16, 20, 35, 18, 7, 19, 23, 9, 30,
+    -19, -31, -13, 26, 40, 44, 44, 31, 45, 6, 7, -22, 25, 36, -10, 6, 11, 11, 8, 20,
+    -47, -58, -21, 33, 51, 38, 32, 47, 32, 5, -13, -33, 16, 32, -14, -11, 2, 3, 9, 14,
+    -45, -71, -51, 20, 48, 46, 33, 28, 45, -1, -25, -45, 15, 3, -15, 8, 12, 16, -5, 32,
+    -34, -59, -26, 29, 35, 34, 14, 41, 36, 13, -12, -24, 28, 18, 1, -6, 1, 20, 14, 28,
+    -37, -63, -31, 17, 22, 20, 16, 29, 50, 22, -8, -28, 4, 17, 2, 4, 18, 4, -2, 6,
+    -30, -76, -38, 3, 14, 12, 15, 13, 36, 14, -6, -15, 5, 18, -8, -2, 11, 17, 24, 20,
+    -32, -55, -36, 20, 3, 9, 13, 2, 17, 11, -16, -22, 6, 26, 5, 14, 4, 12, 10, 32,
+    -41, -57, -29, 7, 19, 8, 6, 21, 33, -10, -1, -15, 6, 16, -8, -4, -2, 6, 13, 33,
+    -39, -59, -34, 17, -1, 8, -10, 29, 17, -7, -1, -25, 5, 12, -3, 4, -8, 6, 11, 16,
+    5, -24, -23, 22, 18, -16, -8, 4, 2, -3, -12, -19, 31, 12, -1, -7, -16, -10, -17, 13,
+    13, -11, 15, 34, 29, -12, -18, 8, 15, 22, 24, -9, 13, 32, -4, -21, -5, -6, 1, -12,
+    // Hidden unit 1
+    8, 28, 51, 41, 22, 11, -14, -7, -18, -16, -16, -37, 16, 25, 38, 40, 51, 54, 77, 79,
+    13, 23, 48, 31, 37, 19, 6, 0, 0, -22, -5, -39, 13, 39, 35, 34, 28, 56, 54, 72,
+    11, 31, 35, 46, 40, 32, 3, -23, -7, -5, -4, -29, 21, 54, 16, 36, 36, 36, 53, 65,
+    19, 26, 47, 41, 69, 40, 11, -12, -14, 7, -12, -27, 30, 40, 30, 22, 30, 40, 56, 60,
+    27, 37, 38, 47, 66, 27, -5, 0, -8, 6, -2, -44, 13, 51, 27, 15, 43, 60, 66, 66,
+    45, 33, 39, 32, 54, 47, 16, -18, -1, 4, -5, -39, 21, 34, 27, 25, 19, 38, 58, 52,
+    25, 40, 37, 37, 58, 21, -11, -21, -11, 8, -13, -33, 25, 37, 24, 15, 27, 33, 58, 64,
+    23, 55, 57, 55, 47, 14, -10, -24, -8, 7, 3, -22, 17, 29, 14, 6, 20, 18, 41, 60,
+    40, 52, 64, 61, 63, 22, 4, -11, -17, 7, 4, -18, 23, 41, 27, 17, 9, 9, 15, 32,
+    17, 36, 52, 54, 67, 36, 6, -1, -1, 8, 6, -18, 28, 15, -1, -3, -12, -12, -11, -13,
+    22, 39, 40, 48, 53, 27, -14, 1, -4, 16, 6, 3, 42, 27, 7, -6, -15, -5, -23, -23,
+    39, 52, 48, 48, 71, 31, -1, 19, 5, 15, 23, -3, 21, 42, -1, -4, -17, -5, -19, -9,
+    31, 32, 57, 54, 65, 21, 1, -6, 2, 18, 5, -5, 28, 28, -26, -8, -27, -19, -12, -35,
+    15, 24, 32, 51, 38, 14, -13, 8, -4, 15, 14, -17, 31, 25, -22, -27, -33, -42, -46, -47,
+    22, 25, 44, 54, 26, 22, -20, -4, 0, 13, 15, -26, 17, 5, -24, -20, -43, -29, -39, -35,
+    12, 22, 35, 40, 16, 16, -11, -31, -17, -21, -1, -27, 7, 13, -33, -31, -25, -40, -40, -47,
+    -2, 12, 23, 37, 7, -17, -28, -18, -15, -2, 8, -7, 12, 23, -28, -18, -20, -30, -33, -19,
+    -11, -1, 6, 14, -18, -23, -44, -36, -27, -11, -7, -22, 4, -10, -20, -34, -25, -43, -20, -26,
+    -6, -13, 6, 22, -8, -25, -37, -38, -24, -15, 0, -9, -3, -12, -24, -18, -17, -34, -28, -36,
+    -15, -38, -20, 7, -13, -44, -41, -41, -32, -38, -16, -20, 6, 5, -19, -32, -37, -31, -34, -29,
+    -23, -47, -18, -23, -37, -43, -63, -45, -51, -20, -33, -24, -2, -2, -29, -17, -35, -37, -27, -29,
+    -24, -38, -33, -14, -23, -59, -45, -43, -49, -36, -31, -22, -11, -12, -24, -25, -30, -31, -14, -10,
+    -12, -51, -19, -20, -26, -48, -31, -52, -33, -14, -11, -21, -2, 12, -25, -9, -2, -19, 3, 0,
+    -22, -50, -20, -10, -22, -35, -19, -31, -13, 6, -8, -29, 0, 9, -1, -8, 2, 0, 12, 16,
+    -26, -53, -25, -22, -9, -34, -10, -23, -16, -1, -13, -42, -6, -11, -5, 3, -9, -3, 9, 10,
+    -23, -31, -15, 0, -9, -8, -17, -18, -2, 7, -16, -40, -8, 16, -1, 1, -1, -2, 24, 21,
+    -20, -42, -18, 15, 10, 3, 1, 12, 17, 12, -9, -23, 12, 27, -13, 2, 10, 26, 26, 17,
+    -17, -28, -4, 3, 16, 13, 20, 27, 12, 16, -20, -41, 11, 29, -3, 2, 14, 20, 26, 26,
+    -27, -39, -10, 33, 28, 5, 16, 34, 17, 0, -23, -50, -3, 22, -14, -7, 16, 3, 21, 32,
+    -35, -39, -21, 19, 26, 16, 24, 25, 30, -5, -28, -50, -4, 13, -10, -14, 1, 0, 1, 9,
+    -34, -49, -12, 13, 20, 21, 8, 16, 32, 3, -31, -51, 2, 7, -24, -16, -4, -9, 5, 6,
+    -29, -48, -31, 14, 31, 19, 7, 15, 26, -13, -29, -42, -5, -7, -17, -27, -5, 6, 5, 8,
+    -15, -39, -23, 16, 18, 6, 28, 18, 16, -2, -18, -52, -1, 7, -14, -20, 3, 10, -7, 12,
+    -28, -49, -13, 15, 17, 9, 4, 13, 42, -4, -26, -26, -3, -1, -19, 1, -9, 5, 5, 21,
+    -26, -52, -23, -1, 23, 8, 6, 18, 28, -5, -27, -37, -7, 18, -7, -11, -10, 4, 1, 4,
+    -38, -39, -47, -7, 8, 8, -4, 6, 18, 0, -8, -37, 7, 15, -6, -9, -3, 6, 10, 7,
+    -58, -37, -33, 4, 9, 7, -7, 22, 4, -4, -15, -33, -2, 16, -11, -15, 0, 9, 10, 9,
+    -39, -45, -45, -12, 0, -8, -18, 0, -2, -19, -25, -20, -2, 1, 2, -19, -15, -12, -3, 4,
+    -51, -57, -40, -22, -10, -18, -11, 2, -11, -7, -8, -45, -8, -5, -20, -14, -12, -10, -7, -5,
+    -34, -30, -25, 3, -13, -15, -25, -21, 6, -21, -16, -13, -1, 13, 0, -16, -17, -18, -3, 7,
+    // Hidden unit 2
+    -7, 7, -10, -55, -45, -24, -12, -11, -27, -23, -60, -70, -27, -10, -3, -5, 12, 15, 17, 39,
+    -4, -16, -8, -59, -45, -24, -17, -2, 7, -17, -23, -63, -4, 7, -25, -3, 13, 3, 15, 28,
+    -13, -4, -39, -63, -54, -13, -12, -6, -3, -4, -21, -62, 1, -18, -17, -22, 2, 4, 5, 8,
+    -15, -20, -45, -77, -31, -10, 15, -3, 1, -6, -17, -74, -25, -5, -29, -22, 2, -5, 3, 5,
+    -21, -3, -60, -85, -17, -1, -12, -20, -12, -11, -20, -78, -38, 0, -29, -33, -18, -9, -2, 0,
+    -10, -4, -46, -68, -2, 12, -8, -8, -6, -2, -24, -77, -33, -9, -36, -20, -33, -5, 0, -6,
+    -14, -11, -54, -56, 15, 10, -10, -11, 0, -1, -24, -73, -20, -16, -40, -37, -25, -12, -8, 3,
+    -18, -20, -38, -28, 30, 3, -12, -26, -12, -1, -26, -73, -34, -35, -49, -34, -32, -22, -28, -27,
+    -15, -13, -47, -49, 12, -5, -15, -34, -21, -13, -35, -78, -45, -51, -54, -64, -44, -54, -58, -35,
+    -25, -19, -38, -41, 25, 9, -11, -42, -26, -20, -18, -56, -28, -44, -63, -67, -56, -52, -68, -58,
+    -24, -36, -21, -11, 22, 0, -25, -32, -18, -36, -30, -48, -14, -27, -67, -52, -62, -63, -58, -72,
+    -34, -25, -17, -16, 32, -3, -47, -18, -22, -34, -24, -35, -22, -28, -56, -49, -64, -61, -52, -67,
+    -42, -35, -21, -9, 6, -23, -44, -19, -11, -12, -7, -24, -11, -19, -44, -42, -43, -42, -48, -44,
+    -43, -34, -25, -17, -9, -16, -51, -26, -18, -13, -10, -41, 4, -3, -37, -44, -25, -36, -42, -46,
+    -42, -37, -22, 3, -15, -21, -39, -10, -9, -12, 11, -34, 4, -3, -28, -18, -32, -34, -34, -46,
+    -35, -18, -23, -10, -1, -23, -45, -23, -21, -10, 17, -26, 4, 2, -7, -17, -23, -33, -39, -22,
+    -36, -16, -12, -10, -14, -31, -40, -6, -11, 11, 4, -26, -4, 21, -4, -11, -20, -25, -9, -16,
+    1, -19, -2, 18, -11, -46, -60, -15, -4, 6, 24, -14, 21, 28, -2, -2, 12, 14, 3, 20,
+    10, 0, 21, 6, -15, -47, -37, 4, 9, 19, 36, 12, 23, 29, 8, 7, 20, 13, 25, 27,
+    9, -4, 17, 16, -1, -17, -49, 1, -9, 13, 40, 2, 45, 32, 21, 7, 5, 22, 25, 19,
+    17, 18, 26, 17, 11, -33, -49, -1, 1, 29, 21, 22, 50, 57, 32, 26, 36, 24, 44, 38,
+    8, 10, 26, 16, 13, -30, -36, -4, -5, 25, 30, 5, 51, 50, 27, 30, 25, 30, 45, 47,
+    31, 14, 28, 11, -2, -19, -40, -5, -5, 22, 17, -4, 34, 38, 8, 10, 18, 20, 32, 38,
+    38, 18, 35, 4, 20, -28, -25, -2, -14, 32, 15, 0, 33, 41, 15, 20, 20, 13, 30, 27,
+    22, 14, 38, 15, 9, -33, -23, -1, -6, 10, 16, 13, 54, 38, 38, 34, 18, 43, 38, 43,
+    36, 30, 38, 9, 2, -24, -34, -9, -7, 6, 24, 16, 54, 40, 22, 19, 11, 10, 38, 27,
+    35, 33, 59, 21, 1, -22, -21, -20, 0, 21, 22, 28, 43, 38, 7, 9, 25, 16, 14, 36,
+    39, 40, 46, 25, 10, -5, -3, -14, 11, 9, 41, 3, 32, 39, 30, 6, 27, 24, 31, 26,
+    56, 24, 58, 36, 15, -8, -11, -11, 23, 6, 30, 12, 47, 41, 4, 0, 24, 21, 31, 21,
+    40, 41, 53, 35, 34, 17, -13, 4, 17, 18, 44, 4, 40, 46, 12, 5, 19, 11, 28, 38,
+    45, 34, 62, 32, 24, 17, -7, 12, 27, 20, 49, 23, 53, 41, 20, 18, 19, 26, 20, 33,
+    61, 54, 51, 42, 46, 36, 12, 19, 28, 30, 49, 14, 58, 44, 9, 15, 25, 29, 16, 19,
+    37, 55, 72, 43, 41, -1, -1, 16, 6, 27, 41, -9, 33, 38, -3, 7, 1, 3, 9, 16,
+    23, 43, 54, 26, 10, -6, -21, 10, 25, 20, 25, -6, 34, 15, -17, -10, -9, -12, 9, 18,
+    21, 23, 39, 42, 4, 11, -12, 8, 26, 18, 23, -13, 14, 23, -11, -9, 6, 7, -8, -1,
+    30, 29, 32, 49, 2, 10, 7, 5, 26, 3, 25, -13, 22, 27, 3, 3, -7, 3, 10, 8,
+    4, 9, 42, 28, 14, 7, -9, 14, 10, 25, 20, -13, 35, 15, -14, 13, 12, 7, 15, 37,
+    -13, 16, 15, 36, 20, -11, -21, 4, 15, 22, 16, -9, 17, 21, 11, 17, 12, 4, 18, 10,
+    -5, 0, 7, 37, 1, 4, -9, 11, 27, 3, 12, -7, 14, 27, 11, 1, 0, -2, -2, 14,
+    32, 35, 45, 43, 34, 18, 1, 22, 28, 28, 25, -1, 20, 21, 19, 5, 11, 22, 19, 16,
+    // Hidden unit 3
+    33, 20, 5, -11, -10, 8, -4, -9, -9, -4, -5, -20, -3, 3, -3, 0, 11, 9, 32, 15,
+    8, -10, -5, -12, -13, -20, -21, -5, 1, -29, -10, -24, 7, 2, 6, -4, 4, 12, 27, 24,
+    6, 3, 3, -12, -7, -20, -13, -5, -12, -14, -27, -13, -9, 13, 3, 12, 8, 21, 28, 32,
+    -7, -15, -24, -14, -13, -8, -23, -6, -7, -6, -8, -21, -3, -3, 3, 16, 11, 28, 30, 24,
+    11, -10, -10, -12, 0, -13, -17, -15, -11, -19, 1, -26, 12, 22, 21, 34, 24, 44, 35, 39,
+    7, -20, -5, -15, -20, -13, -12, 1, -7, -13, -16, -18, 7, 11, 8, 9, 26, 20, 38, 39,
+    -8, -21, -10, -20, 0, -5, -3, 7, -9, -3, -11, -8, 3, 18, 23, 26, 25, 20, 46, 49,
+    -15, -23, -27, -35, -25, -14, -15, -10, -15, -44, -43, -31, -30, 5, -3, 10, 22, 25, 32, 32,
+    -26, -25, -13, -15, -23, -16, -32, -12, -31, -46, -40, -46, -19, -5, -15, -1, -11, 9, 9, 6,
+    -9, -26, -24, -2, -15, -9, -12, 0, -20, -47, -38, -21, -14, -18, -7, -5, -13, 7, 18, 15,
+    -9, -39, -15, -29, -36, -28, -7, 14, 1, -24, -7, -12, 0, 1, 19, 10, 25, 15, 16, 18,
+    -39, -33, -47, -45, -27, -21, -24, 3, -8, -32, -38, -14, -17, -20, -5, -3, 10, 15, 16, 20,
+    -8, -29, -23, -36, -25, -16, -7, -10, -16, -9, -14, -28, 9, 9, 10, 15, 0, 16, 2, 12,
+    -12, -38, -56, -39, -33, -22, -34, -23, -24, -19, 4, -10, -8, -10, -6, 0, 14, 4, 9, 12,
+    -33, -36, -51, -42, -22, -25, -32, -28, -37, -38, -6, -9, -12, -13, -3, 5, -2, 3, 8, 5,
+    -25, -44, -51, -31, -27, -44, -38, -28, -43, -45, -25, -20, -26, -11, -22, -18, -2, 6, 4, -4,
+    -40, -50, -60, -51, -64, -68, -33, -31, -52, -25, -25, -18, -20, -14, -26, -4, -13, 12, 15, 6,
+    -26, -46, -52, -36, -42, -68, -51, -53, -49, -26, -17, -12, -26, -12, -20, -10, 3, -3, 5, 4,
+    -12, -37, -56, -41, -40, -47, -44, -42, -41, -8, -2, -7, -2, -17, -1, 1, 8, 7, 23, 17,
+    -26, -16, -23, -24, -34, -48, -30, -31, -29, -12, 8, 2, 8, 6, 14, 17, 18, 22, 27, 32,
+    -22, -10, -14, -29, -41, -40, -34, -16, -33, -8, 12, 10, 10, 5, 18, 25, 12, 26, 15, 37,
+    -5, -18, -35, -28, -50, -32, -25, -41, -7, 0, 28, -6, 22, 13, 19, 22, 18, 29, 33, 39,
+    2, -18, -28, -30, -25, -37, -16, -19, -29, -16, -2, -13, -1, -13, -19, -18, -18, 3, 16, 13,
+    11, -10, -23, -14, -24, -37, -20, -20, 2, 13, 33, 16, 21, 17, 23, 13, 29, 37, 37, 41,
+    -19, -29, -25, -28, -37, -35, -43, -18, -9, 11, 22, 5, 22, 26, 20, 14, 19, 42, 43, 34,
+    -4, -31, -8, -35, -45, -51, -29, -30, -18, 5, 0, -10, -1, 23, 19, 33, 36, 27, 38, 37,
+    -3, -10, -7, -16, -31, -28, -29, -29, -7, 8, 3, -18, -4, -7, 8, 17, 6, 31, 31, 25,
+    12, -14, -12, -7, -29, -32, -33, -26, -12, -12, 10, -10, -2, 12, -10, 18, 19, 29, 15, 12,
+    3, -3, 8, -3, -10, -20, -29, -16, 11, 6, 8, -15, 5, 8, 3, 6, 14, 18, 9, 16,
+    5, -9, -8, -11, 7, -12, -6, 12, 7, 7, -4, -22, 6, -9, 3, 16, 16, 17, 7, 4,
+    -6, -28, -14, 4, -7, -8, 1, 7, 25, -10, -28, -13, 2, -10, 4, 4, 8, 4, 16, 9,
+    -26, -20, -32, -7, -24, -22, -14, -2, 8, -11, -27, -12, -13, -19, 0, 7, -4, -3, 14, 7,
+    -20, -34, -26, -26, -31, -21, -23, -8, 11, -14, -13, -37, -22, -13, -20, -5, -10, 5, 9, 17,
+    -23, -34, -20, -32, -28, -23, -11, -1, -4, -11, -27, -21, -29, 0, -21, -3, 12, 1, -3, 10,
+    -10, -39, -11, -14, -12, -21, -1, -2, -1, -13, -7, -7, -12, 1, -4, 11, 9, 1, 6, 21,
+    -3, -30, -3, -5, 1, 3, -8, 5, 10, -10, 1, 5, -3, -3, 4, 0, -1, 19, 2, 21,
+    -7, -36, -27, -20, -14, -8, -9, -5, -8, 2, 1, -8, -11, -8, 3, 7, 12, 17, 14, 6,
+    -23, -16, -9, -6, -1, -6, -14, -14, -7, 7, -5, -16, -10, 8, 13, 2, 18, 14, 7, 13,
+    3, -4, -3, -13, 9, 6, 3, -6, 3, 15, 10, -2, 8, 3, -7, 10, 18, 1, 6, 8,
+    20, -7, 16, 15, -2, 9, -11, -5, 17, -1, 8, -16, -3, 12, 13, 7, -2, 10, 15, 12,
+    // Hidden unit 4
+    39, 22, 12, 21, 29, 6, -9, -4, -18, -12, -37, -56, -16, 22, 5, 13, 24, 26, 24, 23,
+    31, 15, -4, 1, 22, 15, -2, -12, -2, -11, -25, -37, 3, 15, -10, -3, -4, 2, 8, 12,
+    17, 13, -10, -10, 12, 18, -15, -25, -11, -4, -19, -33, -3, -6, -9, 1, 6, 7, 27, 23,
+    16, 4, -9, -22, 31, 19, 1, -23, -11, -13, -12, -43, -21, 8, 5, -13, -6, 8, 21, 18,
+    33, 19, 15, -14, 45, 16, -15, -16, -12, -2, -22, -49, -15, 21, 4, -6, -4, 16, 17, 8,
+    59, 46, 28, 5, 46, 48, 5, 0, -15, -6, -20, -33, -16, 13, 19, 0, 6, 17, 8, 20,
+    46, 46, 31, 19, 56, 48, -1, -18, -4, 5, -5, -14, 8, 9, 3, 0, 15, 9, 19, 28,
+    64, 48, 47, 39, 47, 38, -8, -12, 6, 6, 11, -25, -2, 21, 24, 17, 17, 8, 20, 32,
+    48, 55, 34, 48, 60, 8, -3, -4, 7, 1, -3, -11, 17, 28, 27, 11, 24, 9, 22, 29,
+    49, 47, 41, 13, 46, 26, -3, -4, -12, -2, 3, -17, 23, 26, 27, 1, 18, -1, 0, 13,
+    46, 27, 29, 18, 40, 6, 1, -5, -4, 5, 4, -10, 33, 33, 17, 1, 24, 13, 15, 16,
+    42, 25, 18, 2, 13, -9, -17, -10, 9, 15, 11, 1, 41, 32, 27, 28, 23, 19, 14, 28,
+    31, 10, 15, 12, 22, 4, -9, -3, -7, 19, 26, 9, 33, 39, 36, 38, 34, 43, 39, 27,
+    29, 18, 2, 10, 6, -20, -16, 10, 3, 5, 24, 3, 21, 34, 31, 32, 38, 41, 38, 21,
+    18, 5, 17, -3, -1, -5, -15, 1, 0, 10, 27, 17, 31, 32, 24, 24, 34, 39, 32, 35,
+    14, 15, 0, -6, -26, -22, -34, -9, -16, 12, 34, 15, 23, 43, 20, 23, 28, 26, 32, 42,
+    20, 20, -1, 14, -20, -18, -30, -11, -8, 17, 31, 8, 35, 36, 15, 21, 20, 33, 37, 30,
+    13, 10, 21, 18, -24, -32, -29, -15, 0, 17, 32, -2, 19, 35, 4, 4, 21, 31, 42, 28,
+    25, -1, 19, 22, -6, -9, -1, -14, -1, 13, 17, 5, 11, 40, 23, 20, 7, 6, 25, 14,
+    36, 0, 13, 6, 7, 5, -24, -19, -1, 7, 8, 10, 20, 22, 5, 10, 12, -3, 13, 9,
+    44, 19, 14, 15, 5, -6, -9, -12, 2, 4, 9, -6, 21, 22, 21, 10, 3, -6, -8, 11,
+    41, -1, 29, 17, 28, 7, -4, -1, 3, 8, 3, -21, 6, 8, 13, 2, -5, 0, 1, 11,
+    35, 9, 25, 26, 27, 9, 3, 12, 13, 20, -8, -26, 3, 19, -6, -5, -4, -8, 8, 0,
+    22, 0, 15, 41, 50, 19, 29, 4, 11, 8, -2, -27, 10, 5, -6, -12, -19, -18, -1, -2,
+    12, -22, 8, 34, 22, 14, 31, 12, 13, 10, -8, -12, -13, 10, -20, -9, -23, -13, -11, -10,
+    -9, -23, -16, 32, 41, 23, 44, 22, 16, 13, -24, -33, 0, 5, -16, -29, -24, -19, -4, -14,
+    2, -35, -15, 31, 28, 25, 20, 9, 10, -3, -21, -20, -9, -9, -15, -16, -13, -29, -28, -3,
+    -27, -48, -38, 14, 31, 19, 28, 13, 28, -13, -39, -40, 2, 3, -15, -27, -30, -21, -23, -15,
+    -43, -73, -44, 24, 31, 17, 31, 31, 20, -16, -35, -60, -10, -13, -34, -42, -35, -28, -37, -20,
+    -54, -82, -69, -7, 27, 22, 19, 40, 15, -25, -49, -68, -17, -24, -42, -31, -26, -39, -40, -31,
+    -72, -105, -88, -15, 18, 5, 14, 17, 2, -34, -59, -88, -32, -31, -45, -42, -46, -48, -33, -33,
+    -81, -127, -109, -28, 7, 5, 9, 27, 5, -43, -64, -75, -36, -42, -28, -43, -27, -34, -25, -21,
+    -56, -115, -88, -26, 12, 11, 4, 15, 9, -16, -42, -50, -29, -23, -40, -28, -19, -24, -16, -24,
+    -47, -93, -64, -19, 15, 6, 23, 4, 11, 0, -32, -43, -15, -8, -21, -27, -8, -23, -25, -5,
+    -58, -78, -67, 1, 3, 2, 1, 7, 17, -4, -45, -41, -14, -15, -14, -21, -14, -8, -7, -1,
+    -57, -60, -61, -3, -5, -1, 8, 3, 24, -8, -26, -31, -9, 4, -8, -11, -13, -18, -9, -4,
+    -43, -59, -56, -14, 2, -2, -7, 2, 1, -22, -29, -21, -11, -9, -22, -5, -1, -11, 15, 5,
+    -21, -58, -65, -7, -3, -11, -12, -4, 12, -29, -30, -19, -9, 14, -13, -16, -6, -6, -5, 11,
+    -18, -55, -54, -6, -1, -20, -14, 4, -3, -4, -25, -30, 2, -1, -27, -13, -34, -25, -22, -1,
+    -4, -17, -16, -13, -11, -11, -18, -13, -10, -4, -22, -31, -26, -2, -12, -25, -37, -19, -29, -16,
+    // Hidden unit 5
+    2, -39, -76, -62, -58, -27, -15, -6, 10, 28, 22, 37, 12, -10, -2, -1, -8, -22, -11, -25,
+    -1, -32, -50, -60, -26, -12, 17, 13, 3, 21, 28, 30, 3, -3, -1, -13, -7, -30, -33, -21,
+    -13, -28, -55, -39, -23, -17, -3, 0, 27, 27, 23, 29, 4, -14, 8, 1, -21, -17, -24, -36,
+    -6, -1, -67, -45, -29, -19, 13, -4, 39, 33, 47, 54, 27, 1, 6, -7, -15, -19, -27, -24,
+    -1, -10, -42, -12, -3, 5, 36, 30, 44, 69, 73, 88, 45, 17, 10, 2, -16, -26, -22, -26,
+    -16, -25, -36, -3, -1, -12, 25, 32, 31, 56, 69, 94, 42, 23, -6, 2, 6, -23, -23, -20,
+    -18, -15, -41, -4, 3, 2, 23, 31, 36, 42, 42, 73, 40, 5, 7, -10, -15, -31, -24, -36,
+    -20, -24, -15, -2, -6, -22, 20, 40, 34, 50, 48, 70, 31, -9, -2, 4, -20, -26, -35, -48,
+    -17, -7, 13, 38, -3, 6, 5, 30, 43, 56, 68, 76, 44, 10, -6, -13, -24, -34, -26, -37,
+    -9, 8, 34, 63, 17, 8, 14, 36, 35, 44, 62, 75, 41, 11, 28, 13, 6, -11, -16, -33,
+    -1, -16, 29, 50, 13, -2, 23, 28, 31, 25, 40, 62, 13, 0, 14, 19, 7, -1, -17, -15,
+    -27, 2, 25, 34, 4, 5, 19, -7, 4, 2, 25, 26, 1, -9, 2, 14, 0, 3, -13, -14,
+    -11, 4, 34, 42, 5, -20, 3, -12, -37, -19, 3, 13, -25, -19, -14, 0, -6, -11, -21, -23,
+    -9, 15, 35, 48, 6, -8, 2, -17, -41, -31, 7, 24, 4, -1, -10, -8, 1, -20, -4, -13,
+    -15, 16, 33, 28, -11, -17, 1, -21, -34, -18, 2, 25, -20, -8, 6, -5, -1, -11, -19, -5,
+    -7, -2, 18, 3, -21, -18, -26, -16, -14, -21, -6, 1, -15, -8, -4, 6, 3, -7, -2, -2,
+    -1, 0, 2, 14, -21, -21, -36, -28, -22, -19, -6, 11, -14, 0, 4, 18, 25, 19, 5, 1,
+    -3, 3, 17, -25, -47, -29, -16, -24, -2, -20, -4, 16, -5, -5, -1, 14, 6, -3, 8, 17,
+    24, -3, -1, -13, -46, -3, 9, -14, 12, -11, -13, 8, 2, -17, 9, 4, 18, 8, 3, 29,
+    19, 13, -8, -14, -24, 8, 36, -6, 7, -3, -17, 8, -9, -9, 13, 2, 21, 23, 18, 29,
+    -1, -7, -29, -41, -23, 18, 33, -10, 4, -6, -14, -14, -34, -23, 8, -7, 0, 6, 14, 5,
+    -1, -2, -21, -25, 11, 5, 22, 7, 6, 15, -11, -15, -15, -19, -9, -2, 13, 6, -1, 3,
+    -23, -4, -28, -29, 11, 39, 23, 25, 6, 5, -13, -7, -25, 4, 5, 17, 19, 13, 26, 28,
+    -44, -37, -42, -16, 18, 47, 23, 32, 10, 1, -20, -12, -27, -3, 25, 23, 19, 25, 4, 11,
+    -28, -27, -34, -30, 33, 45, 36, 44, 25, 9, -28, -19, -40, -27, -4, -18, -10, -4, -11, -25,
+    -60, -45, -37, -6, 37, 55, 38, 30, 21, -7, -6, -18, -17, -17, 0, -15, 2, -14, -22, -30,
+    -55, -38, -42, -28, 26, 49, 28, 37, 35, 11, -19, -29, -28, -13, -4, -4, 8, -3, -24, -14,
+    -46, -46, -35, -26, 21, 49, 9, 18, 27, -8, -4, -5, -31, -20, 12, 1, -7, 5, -5, -22,
+    -21, -16, -31, -14, 5, 20, 19, 21, 26, 8, -11, -6, -15, -14, -1, 6, 6, 10, -2, -10,
+    -14, -6, -12, 7, -6, 21, 4, 5, 13, 5, -1, 7, -6, -10, 7, 10, -2, -7, -4, -14,
+    6, -3, -4, -20, -19, -6, -20, -27, -6, -20, -9, 16, -16, -27, 0, 6, -17, -3, -14, -3,
+    11, 35, 14, -3, -37, -31, -41, -40, -44, -38, -28, 22, -8, -20, -5, -7, -14, -11, 3, -23,
+    34, 45, 39, 20, -22, -6, -49, -38, -23, -35, -4, 31, 15, -7, 15, 12, -7, 6, 0, 11,
+    32, 46, 45, 7, -26, -23, -14, -20, -31, -16, 18, 16, 6, -4, 19, 7, -5, -6, 11, -6,
+    51, 49, 46, 4, -9, -22, -46, -29, -44, -17, 10, 19, 7, -10, 6, -11, -1, 8, -11, -2,
+    53, 60, 41, 0, -14, -35, -46, -34, -49, -22, 8, 6, -4, -16, 21, 5, -8, -3, -1, -9,
+    31, 56, 41, -1, -14, -24, -21, -23, -36, -11, 21, 26, -21, -26, 17, 1, -3, 2, 7, -19,
+    53, 52, 62, 20, -17, -13, -6, -29, -32, -6, 7, 29, 5, 1, 21, -7, 5, 15, -9, -12,
+    27, 38, 47, -8, -21, -19, -3, -9, -17, 3, 8, 13, -7, 11, 14, 4, -11, -5, -10, -26,
+    -2, -22, -31, -13, -36, 0, -3, -13, -36, -8, -16, 3, -2, -32, -5, -6, 2, -13, -3, -32,
+    // Hidden unit 6
+    0, -25, -76, -64, -56, -13, -2, 4, 14, 29, 45, 51, 22, 0, -16, -7, -21, -20, -25, -27,
+    -17, -33, -45, -45, -23, -10, 12, -4, 9, 39, 41, 48, 8, -11, -11, -16, -10, -24, -22, -34,
+    -2, -27, -71, -36, -22, -11, 10, 19, 41, 45, 62, 61, 4, 6, 15, -18, 5, -16, -21, -19,
+    -24, -4, -41, -18, -20, -1, 3, 28, 29, 59, 64, 88, 35, 3, 6, 2, -14, -12, -34, -25,
+    -23, -26, -47, -12, -8, 9, 18, 44, 58, 66, 85, 85, 43, 14, -4, -4, -10, -10, -40, -26,
+    -30, -33, -13, 23, -6, -6, 10, 36, 36, 57, 81, 85, 50, 3, 9, 8, -8, -26, -31, -40,
+    -25, -24, -10, 18, -9, 1, 19, 30, 34, 54, 56, 78, 43, -5, 7, -3, 4, -28, -41, -28,
+    -16, -17, 17, 36, -12, -6, 12, 37, 32, 35, 55, 75, 43, 3, -8, 5, -16, -31, -42, -33,
+    4, -12, 16, 61, 5, 4, 20, 40, 31, 53, 60, 73, 29, 0, -1, -12, -21, -15, -20, -43,
+    8, -2, 33, 60, 4, 14, 13, 37, 34, 36, 57, 66, 29, 11, 22, 18, 3, -5, -29, -27,
+    5, -5, 25, 70, -4, -1, 22, 31, 11, 28, 44, 38, 7, 5, 14, -3, -8, -6, -7, -31,
+    -11, 0, 44, 48, 2, -10, -2, 5, -16, -12, 11, 32, -4, -28, 1, 1, -8, -4, -33, -17,
+    -13, -9, 43, 24, -7, -14, -2, -8, -49, -25, 6, 20, -25, -31, -3, -7, -9, -5, -24, -17,
+    0, 15, 23, 37, -15, -6, -9, -13, -31, -17, 9, 26, -4, -24, -10, -2, -9, -16, -24, -4,
+    -14, 12, 14, 0, -14, -9, -2, -21, -21, -24, 4, 23, -16, -19, 11, 1, 7, 7, 16, 17,
+    -5, 5, 15, -7, -23, -34, -19, -33, -16, -18, -20, 10, -15, -9, 3, 3, 21, 7, 8, 3,
+    -1, 11, 16, 7, -28, -32, -8, -26, -22, -14, -9, 3, -19, -8, -7, 17, 9, 8, 17, 11,
+    -10, 14, -1, -32, -45, -15, -7, -8, -6, -12, -15, -3, -4, -10, -3, 13, 17, 12, 16, 9,
+    7, 17, -14, -18, -17, 2, 25, -8, 9, 5, -22, 5, -10, -14, -13, 12, 11, 18, -6, 15,
+    -3, 9, -1, -28, -6, 25, 36, -2, 10, -3, -23, 5, -9, -20, -3, 16, 23, 14, 16, 15,
+    -1, 4, -25, -39, -1, 19, 34, 9, 4, -5, -16, -16, -26, -39, 2, -11, 8, 15, 16, 18,
+    -17, -9, -14, -16, 14, 27, 42, 23, 22, -10, -29, -9, -37, -36, -14, -8, 6, 11, 2, 3,
+    -9, -19, -26, -15, 27, 39, 43, 15, 2, -6, -16, -5, -26, -16, 13, 8, 2, 16, 10, 9,
+    -35, -48, -46, -29, 12, 39, 20, 33, 1, 3, -24, -1, -39, -26, 13, 10, 12, 18, 5, 15,
+    -38, -52, -36, -16, 39, 57, 28, 33, 10, 7, -11, -24, -32, -34, -13, -6, -2, -17, -16, -16,
+    -46, -34, -27, -27, 25, 51, 26, 45, 27, 8, 2, -21, -25, -20, -12, -10, 5, 5, -15, -17,
+    -29, -27, -39, -17, 36, 41, 20, 40, 24, 15, -11, -7, -26, -18, -5, 2, 6, -10, -21, -28,
+    -34, -20, -14, -9, 12, 30, 20, 24, 6, 11, 1, -4, -15, -24, -8, 5, -10, 3, -9, -18,
+    -1, 7, -3, -7, -2, 8, -3, -6, 6, 9, 7, 1, -9, -3, 5, 7, -7, 3, -8, -10,
+    7, 19, -1, -15, 3, -5, -11, -1, -12, 6, -8, 18, -25, -6, 11, 6, 2, -16, -5, -15,
+    7, 8, 0, -19, -27, -32, -24, -14, -20, -29, -15, 17, -16, -34, -5, 4, -13, 1, -14, -14,
+    16, 34, 26, -15, -26, -33, -35, -23, -43, -13, 2, 23, -18, -14, -13, -9, -14, -8, 4, -24,
+    32, 67, 51, 5, -26, -12, -30, -23, -35, -22, 11, 28, 3, -12, 26, 15, -4, -7, -2, -6,
+    43, 73, 49, 9, -23, -16, -29, -27, -42, -33, 4, 20, -2, -9, 18, 9, -4, -1, 2, -19,
+    35, 65, 38, 9, -21, -12, -41, -24, -51, -20, 7, 21, -1, -5, 13, -4, 6, -3, 0, 1,
+    47, 66, 54, 14, -2, -29, -28, -47, -34, -1, -8, 14, -19, -27, 21, 6, -1, 12, -10, -18,
+    44, 65, 59, 10, -5, -9, -12, -27, -33, -9, 11, 12, -22, -22, 14, 12, -2, 7, -16, -7,
+    35, 57, 47, 7, -7, 2, -7, -30, -27, -6, 18, 15, -19, -3, 20, 7, -11, -1, -8, -24,
+    19, 26, 13, -10, -10, -9, 11, -23, -10, -1, 6, 14, -20, -5, 13, 13, -4, 5, 5, -18,
+    -2, -9, -22, -31, -35, -15, -17, -10, -30, -10, -20, -11, -24, -21, -13, -4, -13, -14, -27, -27,
+    // Hidden unit 7
+    8, -22, -53, -43, -48, -43, -6, -1, 8, 3, -12, -15, -15, -19, -20, -6, 8, -14, -13, -22,
+    13, -11, -43, -45, -37, -20, 1, 1, 8, -8, -14, -6, -21, -17, -8, -11, -11, -5, -19, -15,
+    11, -7, -47, -54, -41, -36, 7, 17, 12, -22, -6, 1, -27, -19, -7, -14, -2, -18, -21, -26,
+    12, 1, -61, -69, -50, -32, -3, -6, 6, -3, -7, -9, -5, -23, -23, -14, -5, -31, -17, -18,
+    9, -23, -55, -56, -37, 0, 4, 7, 20, 15, 9, 33, -8, -23, -17, -28, -24, -17, -31, -41,
+    -7, -28, -39, -28, -36, 0, 13, 16, 45, 34, 54, 48, 17, -5, -6, -17, 5, -18, -39, -44,
+    -20, -16, -46, -39, -38, 13, 30, 49, 46, 46, 65, 76, 29, 19, 15, 11, 2, -15, -44, -23,
+    -18, -28, -52, -60, -31, 3, 27, 48, 65, 74, 80, 89, 45, 23, 9, 0, -26, -34, -52, -52,
+    -18, -7, -46, -27, -8, 15, 24, 64, 51, 71, 83, 96, 54, 17, -3, -1, -20, -22, -34, -47,
+    -4, -10, -13, 15, 22, 1, 26, 63, 58, 74, 87, 91, 48, 39, 14, 16, -3, -7, -22, -27,
+    -3, -12, -26, 21, 25, 4, 31, 28, 35, 58, 54, 59, 26, 26, 26, 2, 13, 0, -15, -22,
+    -26, -28, 15, 21, 20, -8, 6, 17, -2, 16, 29, 28, 6, 0, 8, 3, 4, -13, -7, -25,
+    -11, 11, 20, 45, 8, -10, 0, -9, -41, -27, 20, 12, -36, -24, -10, 6, -7, -10, -29, -35,
+    3, 20, 57, 56, 13, -2, -3, -12, -21, -28, 22, 37, -5, -10, 9, 3, -7, -18, -5, -26,
+    6, 22, 47, 51, 18, -21, -9, -16, -38, -36, 2, 34, 7, 3, 0, 7, -6, -10, -4, -20,
+    11, 24, 50, 42, -4, -31, -18, -30, -42, -41, 3, 27, -15, -11, -3, 2, 6, -16, -12, -4,
+    8, 23, 42, 39, -24, -35, -26, -25, -29, -9, 15, 14, 24, -5, 16, 4, 5, 7, -26, -11,
+    2, 25, 13, 10, -43, -32, -13, -4, -3, -15, 4, 12, 10, -1, 15, 7, 14, 3, -5, 3,
+    5, 22, 12, -10, -52, -34, -3, 6, -6, 6, 0, 12, 5, 6, 5, 26, 19, 23, -3, 20,
+    12, 26, 13, -14, -31, -15, -5, -10, -8, -4, -4, 10, 11, -16, 1, -4, 20, 19, 3, 7,
+    8, 8, -20, -42, -42, -7, 0, -12, 12, -3, -16, -7, -6, -10, -4, -10, 10, 17, 4, 14,
+    -5, -10, -3, -37, -41, -16, 16, -7, 6, 14, -8, -16, -12, -18, -2, -7, 0, 16, 17, 17,
+    2, -12, -20, -33, -19, -11, 13, 7, -3, 12, -16, 8, -18, 1, 14, 26, 35, 40, 48, 49,
+    -18, -42, -33, -35, 1, 9, 10, 25, 3, -8, -7, 1, -5, -6, 23, 29, 27, 26, 17, 40,
+    -30, -29, -25, -27, 29, 46, 30, 45, 21, 9, -16, -24, -30, -27, 0, -12, -3, 1, -20, -21,
+    -30, -34, -17, -4, 47, 58, 27, 60, 32, 13, -17, -26, -28, -13, 9, -4, -10, -2, -7, -27,
+    -43, -55, -38, -12, 53, 73, 57, 59, 51, 10, -18, -19, -27, -7, 1, -1, -2, -11, -26, -24,
+    -49, -45, -27, -24, 49, 59, 26, 42, 39, 8, -25, -28, -16, -14, 20, 15, 12, -3, -3, -8,
+    -46, -37, -53, -34, 17, 52, 40, 43, 40, 33, -14, -3, -9, -5, 25, 8, -6, 9, -9, -7,
+    -30, -33, -40, -28, 20, 33, 16, 29, 32, 10, 1, 0, -15, -1, 17, 12, -3, 5, -7, -5,
+    -21, -55, -58, -56, -22, -9, -2, -1, 3, 1, -3, 0, -26, -11, -14, -7, -14, -2, 0, -17,
+    -12, 17, 8, -22, -42, -28, -28, -22, -19, -29, -11, 17, 0, -12, 1, -13, -6, -16, -19, -21,
+    14, 51, 49, 1, -8, -20, -32, -30, -23, -15, 14, 48, 23, 8, 32, 8, 2, 16, 2, 2,
+    35, 45, 37, 0, -13, -35, -32, -29, -30, -43, 8, 23, 25, 4, 32, 1, 14, -2, 11, 3,
+    27, 42, 43, -9, -20, -29, -56, -21, -30, -35, 16, 28, 9, 7, 3, 6, -6, 5, -1, 8,
+    33, 54, 29, -12, -29, -35, -39, -43, -50, -32, -1, 22, 4, -20, 11, -9, -12, -8, 8, -8,
+    33, 43, 40, -15, -33, -55, -56, -40, -51, -17, 10, 20, -10, -10, 6, -11, -8, -1, 6, -12,
+    41, 59, 42, -2, -25, -31, -29, -35, -18, -11, 14, 20, 0, -8, 21, -11, -13, 2, -9, -12,
+    32, 46, 18, -5, -52, -8, -1, -21, -17, -6, 21, 23, 16, 19, 9, 0, 4, 9, 7, -10,
+    -11, -12, -5, -32, -37, 6, -13, -7, -14, -10, -16, 12, -8, -19, 4, -16, -14, -25, -8, -22,
+    // Hidden unit 8
+    -16, -34, -51, -38, -29, -20, -7, 11, 20, 16, 18, 20, -7, -10, -2, -6, -3, -16, -9, -15,
+    4, -11, -36, -8, -5, 5, 9, 7, 33, 15, 23, 42, 6, 15, 8, 14, 18, 0, -2, -6,
+    -14, -21, -47, -17, 2, 6, 10, 13, 31, 27, 29, 45, -1, 5, 19, 12, 4, 2, 2, -15,
+    -11, -23, -38, -9, -2, 12, 19, 25, 39, 26, 26, 56, 5, 1, 21, 10, 0, -4, 2, -4,
+    -30, -28, -27, 3, 3, 14, 28, 18, 34, 48, 40, 46, 29, -5, -4, -5, 0, -5, -18, -21,
+    -20, -22, -10, -2, 12, 7, 8, 28, 36, 28, 45, 62, 31, 10, 3, -9, -2, -3, -25, -28,
+    -24, -27, -18, 10, 14, 3, 21, 13, 31, 24, 50, 57, 14, -4, 10, 3, 2, -22, -31, -25,
+    -29, -30, -13, 10, 8, 11, 22, 27, 10, 16, 24, 52, 21, -5, 1, 4, -10, -21, -39, -29,
+    -29, -25, 2, 23, 11, -8, 22, 19, 7, 39, 28, 43, 24, -8, 7, 8, 4, -23, -10, -22,
+    -26, -13, 13, 17, 12, 2, 17, 5, 7, 16, 33, 44, 25, 10, 21, -1, 7, -4, -8, -8,
+    -9, -8, 33, 29, 12, -14, 19, 5, -8, 2, 27, 47, 7, 10, 2, -2, 10, 2, 5, -9,
+    -32, 13, 35, 31, 7, -15, -2, 0, -11, -11, 16, 24, -5, -8, 7, 10, -7, -1, -6, -2,
+    -26, -13, 13, 11, -12, -34, -9, -19, -31, -9, -2, 16, -5, -16, 6, 2, 3, -10, -12, 1,
+    -12, -1, 17, 5, -33, -32, -30, -11, -27, -21, -9, 7, -9, -7, 0, 5, 1, 5, -7, -7,
+    -32, -26, 18, -9, -41, -51, -25, -11, -27, -7, 7, 1, -16, -18, 13, 20, 18, 1, 7, 12,
+    -22, -25, -8, -10, -59, -52, -32, -28, -28, -17, -6, 6, 0, -24, 3, 2, 14, 2, 18, 12,
+    -27, -21, -1, -11, -48, -22, -24, -22, -20, -22, -17, 7, -9, -10, 7, 14, 1, -5, 9, 15,
+    -16, -17, -13, -30, -47, -23, -13, -27, 7, -19, -9, 19, 2, -5, -1, 18, 6, 6, 15, 10,
+    -13, -6, -23, -16, -22, 9, 4, 15, 7, 1, -19, -2, -12, 3, 16, 10, 23, 16, 23, 30,
+    6, -11, -19, -13, -12, -1, 11, 17, 10, -8, -4, 12, -1, -17, 1, 16, 25, 20, 18, 13,
+    4, -3, -9, -33, -10, 3, 19, 2, 13, 8, -10, -2, -26, -14, -4, -2, 13, 6, 11, 12,
+    -13, -23, -36, -25, 1, 31, 35, 25, 26, -5, -1, 1, -9, 4, 6, 13, 9, 20, 10, 28,
+    -23, -30, -42, -33, 2, 18, 25, 38, 34, 6, -19, 5, -23, 11, 36, 21, 30, 23, 13, 14,
+    -43, -55, -41, -19, 24, 34, 29, 33, 26, -11, -13, -6, -8, -15, 4, 1, 19, 11, 13, 3,
+    -56, -40, -27, -22, 22, 25, 9, 26, 23, 0, -22, -9, -35, -12, -8, 4, -11, 7, -10, -9,
+    -62, -43, -50, -24, 9, 29, 2, 30, 15, 18, -12, -9, -16, -13, 7, -8, 13, 6, 0, -11,
+    -33, -21, -40, -24, 15, 25, -4, 26, 21, 13, -9, -7, -26, 0, -3, 4, 8, 6, -10, 4,
+    -31, -3, -20, -15, 7, 10, 10, 8, 2, 7, 1, -6, 0, -14, 10, -2, 3, -3, 8, -11,
+    -19, 16, -14, 9, -1, 18, 15, 5, 15, 2, 9, 20, 12, -2, 6, -2, 15, 8, 5, 7,
+    10, 12, 18, 16, -1, -8, -10, -11, 2, 9, 16, 22, 13, 4, 22, 12, 5, 12, 12, 7,
+    12, 3, 11, -6, -16, -14, -23, -9, -23, -10, 1, 10, 1, 0, 7, 7, -1, 15, 3, -5,
+    13, 28, 32, 0, -31, -37, -33, -31, -22, -22, -4, 28, 20, 6, 19, 7, -5, 2, 3, -8,
+    2, 43, 32, 5, -33, -12, -40, -23, -33, -29, 12, 43, 33, 21, 28, 21, 25, 19, 20, 10,
+    -2, 37, 17, -8, -36, -32, -21, -34, -29, -29, 2, 35, 17, -12, 14, 15, 19, 8, 23, 11,
+    3, 25, 29, -12, -35, -32, -25, -26, -29, -24, -8, 23, 5, 8, 9, 7, 10, 5, 4, 0,
+    3, 30, 24, -4, -46, -45, -34, -43, -31, -18, 5, 13, 9, -1, 17, 16, 14, 19, -2, 8,
+    8, 20, 11, -20, -41, -28, -22, -35, -9, -7, 0, 23, 1, -6, 20, 4, -3, -2, 11, 8,
+    1, 11, 12, -11, -25, -29, -12, -25, -16, -8, 3, 27, 8, -4, 20, -1, -9, 18, -1, -5,
+    -1, 0, -9, -3, -17, -21, -4, -18, -10, -7, 3, 14, -1, -1, 18, 12, -2, -5, 5, 1,
+    -28, -28, -29, -27, -36, -19, -19, -6, -19, -17, -6, 12, -3, -6, 6, -1, -7, -2, -7, -19,
+    // Hidden unit 9
+    -61, -43, -33, 4, 15, -11, -4, 5, 3, 32, 71, 82, 9, 1, 1, -2, -5, -32, -20, -33,
+    -40, -31, -15, 28, 11, -4, 1, -6, 3, 25, 46, 74, 9, 2, 17, -2, 9, -20, -13, -16,
+    -27, -39, -6, 27, 2, -10, 7, 18, -3, 22, 39, 86, 7, -8, 18, 11, 8, 5, -2, -18,
+    -39, -34, 22, 45, -10, -31, -4, 12, 9, 19, 42, 79, 27, 3, 36, 13, 4, -7, -12, -12,
+    -28, -28, 23, 45, -30, -36, 25, 16, 12, 18, 60, 88, 20, -2, 30, 27, 21, 12, 1, -5,
+    -44, -23, 23, 42, -27, -11, 10, 35, 10, 26, 49, 93, 32, 0, 35, 21, 25, 13, -12, -12,
+    -33, -18, 16, 33, -14, -24, 6, 14, 24, 13, 38, 61, 11, 17, 9, 16, 6, 0, -9, 0,
+    -32, -7, 32, 31, -28, -10, 21, 22, 19, 18, 42, 73, 35, 2, 23, 1, 5, 5, -14, -29,
+    -32, -22, 9, 18, -25, -4, -11, 0, 8, 7, 15, 36, 2, -6, -1, 16, 12, -7, -14, -17,
+    -33, -22, 14, 7, -39, -23, -25, -21, -18, -2, -18, 10, -15, -22, 1, 20, 9, 27, 7, 18,
+    -28, -14, 6, -2, -24, -26, -23, -11, -27, -19, -14, -13, -27, -27, -7, -3, 11, 11, 16, 18,
+    -9, -6, 11, 1, -31, -12, -3, -32, -10, 6, -13, 8, -13, -12, -9, 7, -10, -4, -1, 9,
+    -21, -4, 1, -9, -17, -15, 4, -2, -9, -12, -26, 12, -19, -9, 4, -5, 13, 4, 9, -1,
+    -17, -15, 3, -17, -25, -1, 16, -10, 15, 9, -24, 3, -29, -30, 7, 16, 4, 12, 9, 3,
+    -30, -8, -1, -26, -23, -5, 14, -3, 15, 4, -39, -7, -43, -33, -1, -1, 17, -2, 6, 15,
+    -25, -4, -20, -42, -15, 6, 31, 16, 33, 4, -31, 4, -28, -30, -1, 10, -5, 8, 4, 3,
+    -43, -24, -23, -31, -16, 30, 30, 4, 23, 8, -27, -6, -22, -24, 2, 19, 7, 13, 10, 20,
+    -21, -24, -27, -64, 3, 19, 46, 30, 23, 13, -22, -4, -26, -23, 27, 5, 16, 13, 5, 7,
+    -36, -26, -36, -47, 1, 18, 34, 21, 28, -2, -20, -18, -36, -20, 0, 14, 2, 19, 16, 12,
+    -46, -15, -42, -38, 3, 28, 23, 24, 15, 1, -29, -3, -38, -20, 12, 19, 8, 30, 10, 12,
+    -54, -27, -42, -24, -6, 23, 36, 28, 20, -15, -14, -13, -35, -20, 0, -1, 15, 13, 9, 10,
+    -53, -29, -22, -4, -1, 18, 36, 24, 22, 1, -7, 13, -22, -15, 1, 11, 2, 22, 5, 5,
+    -21, -2, -17, -20, 14, 24, 25, 11, -1, -8, -23, 23, -10, -17, 5, 15, 10, 9, 5, -14,
+    -17, 21, 0, 9, 14, 23, -4, 20, 8, -22, -12, 28, -21, -12, 11, -15, 1, -3, -32, -17,
+    -6, 35, 21, 2, 17, 12, 1, 13, 1, -15, 6, 42, 8, -9, 3, 11, -3, -13, -25, -11,
+    6, 41, 10, -7, -10, 10, -2, 11, -4, -25, -7, 28, -11, -19, 6, 16, 15, 9, 2, 1,
+    8, 33, 23, 11, -20, -10, -16, -13, -30, -17, -4, 21, 0, -19, 14, 20, 9, 4, -4, 1,
+    16, 43, 15, -8, -37, -31, -26, -36, -27, -23, -8, 44, -5, -9, 11, 1, 6, 1, 8, 5,
+    30, 49, 15, -3, -28, -36, -45, -40, -33, -28, -2, 40, 7, -3, 16, 18, 21, 5, -5, 12,
+    31, 38, 24, -8, -34, -31, -28, -38, -39, -11, 7, 46, -9, -12, 25, 8, 2, 9, 7, 6,
+    49, 53, 48, -12, -25, -29, -30, -43, -35, -15, 15, 49, -11, -10, 22, 34, 10, 13, 20, 14,
+    44, 51, 54, -5, -26, -33, -18, -38, -36, -6, 27, 47, 7, -2, 22, 29, 16, 3, 13, -8,
+    -12, 29, 1, -32, -35, -10, -5, -31, -22, 11, 20, 27, -1, 9, 29, 7, 13, 5, 3, 3,
+    -11, 22, -8, -17, -31, -2, -10, -8, -28, 12, 2, 26, -8, -8, 27, 17, 14, 2, 21, -1,
+    3, 35, 10, -32, -19, -4, 3, -9, -33, -1, 0, 9, -8, -17, 13, 12, -2, 14, 6, 5,
+    -12, 14, -4, -32, -23, -24, -10, -9, -26, -3, -9, 20, -8, 0, 17, 12, 12, 6, -12, 1,
+    -5, 5, -10, -19, -23, -9, 5, -10, 1, 10, -16, 6, -15, -19, 4, 16, 12, 12, -5, -20,
+    -18, -3, -14, -27, -15, 2, 9, -8, -13, -7, 1, 7, 3, -4, 11, -8, 0, -2, 12, 3,
+    -21, -21, -14, -20, -10, -8, -5, 0, 6, -3, 8, 9, -7, -7, 13, 1, 16, 2, -1, -8,
+    -47, -26, -33, -36, -25, -4, 12, -9, -10, -13, -16, 13, -20, -2, -3, 3, 10, -7, -4, -15,
+    // Hidden unit 10
+    63, 62, 58, 40, 47, 23, 3, -13, -9, -39, -37, -52, -2, 14, 23, 9, 38, 44, 38, 34,
+    69, 53, 70, 50, 43, 22, 22, 8, -2, -23, -26, -24, 27, 20, 14, 16, 15, 35, 36, 49,
+    53, 64, 56, 29, 38, 12, 22, 2, -8, -12, -10, -29, 16, 28, 3, 15, 20, 32, 23, 43,
+    61, 51, 49, 29, 42, 31, 23, -5, 3, 10, -2, -31, 10, 18, 15, 0, 3, 21, 31, 21,
+    71, 55, 44, 17, 54, 35, 19, 13, -9, 0, -5, -43, 7, 20, 3, 5, -3, 28, 26, 21,
+    67, 46, 31, 9, 43, 41, 11, -4, -10, -10, -20, -43, 0, 24, 2, -8, -4, 23, 31, 20,
+    49, 32, 12, 0, 43, 22, 1, -8, -18, 0, -14, -44, 12, 22, -9, -5, -9, 16, 15, 21,
+    42, 47, 18, 2, 30, 22, -1, -7, -14, -6, -7, -36, -8, 23, 13, -15, -2, 11, 18, 30,
+    18, 18, 15, 3, 28, -8, 3, -3, -9, -11, -17, -29, -2, 22, 6, 12, 18, 15, 11, 31,
+    12, 25, 1, -5, 17, 1, 3, -10, -16, -13, -2, -14, 10, 12, -4, 7, -1, 8, 6, -1,
+    11, 18, 4, -17, 26, 0, -9, -15, -7, -3, -4, -19, 21, 20, -12, -9, -8, -9, -6, -7,
+    13, 17, -9, -2, 29, 6, -12, 4, 8, 11, 22, 3, 6, 23, -1, 10, -8, -13, -13, -6,
+    0, -12, -4, 13, 22, 7, -8, 13, 16, 22, 3, -4, 19, 21, -11, 5, -7, -4, -18, -13,
+    10, -12, -3, -6, 10, 1, -28, -5, -9, 14, -8, -19, 5, 3, -15, -12, -24, -7, -10, -18,
+    6, -16, 5, 10, -11, 3, -21, -8, -1, -1, 8, 7, 20, 19, -5, -4, -11, -24, -7, -9,
+    12, -5, 14, 6, 4, -5, -24, 0, -4, 2, -1, -15, 8, 12, -22, -29, -22, -24, -28, -23,
+    30, -18, 2, 16, -1, -19, -15, -25, -13, 0, 6, -24, 6, 14, -31, -28, -27, -42, -37, -29,
+    4, -13, 2, 8, -4, -20, -13, -12, -17, 8, 2, -27, -5, -8, -35, -34, -13, -22, -17, -22,
+    26, -6, 4, 0, -6, -30, -15, -10, -16, -6, 5, -6, 13, -1, -20, -16, -21, -22, -5, -19,
+    16, -9, 11, 21, 0, -22, -16, -21, -21, -17, 13, 2, 10, 16, -1, 1, -4, -17, 3, -14,
+    21, 8, 15, 29, -6, -16, -36, -30, -18, 3, -7, -10, 21, 13, -22, -19, -25, -25, -7, -14,
+    16, -2, 24, 35, 17, -21, -33, -6, -19, -11, -13, -19, 23, 22, -15, -19, -11, -27, -5, -10,
+    7, -21, 11, 24, 11, -7, -17, -7, -7, 3, -24, -20, 7, 3, -17, -26, -24, -33, -19, -8,
+    10, -27, -29, 12, 5, -22, -18, -19, -10, -16, -13, -23, -6, -4, -19, -31, -24, -12, -1, -23,
+    -18, -44, -46, -20, -8, -23, -9, -25, -23, 1, -17, -16, -5, -9, -7, -10, -12, -19, -1, 1,
+    -18, -63, -61, -26, -20, -33, -15, -18, -19, -8, -38, -27, -14, -18, -24, 0, 4, -8, 3, 9,
+    -28, -79, -72, -32, -33, -29, -37, -14, -11, -27, -39, -42, -26, -2, -11, -3, -3, -13, -8, 22,
+    -40, -77, -73, -40, -23, -29, -43, -30, -10, -28, -46, -57, -31, -12, -16, -18, -21, 2, -4, 3,
+    -54, -86, -72, -47, -24, -13, -22, -21, -1, -12, -34, -46, -24, -20, -14, -13, -1, -8, -2, 14,
+    -49, -89, -78, -25, -17, -20, -13, -1, 6, -11, -31, -58, -13, 2, -31, -17, 1, 11, -2, 12,
+    -52, -72, -59, -23, -10, -4, 2, -11, 2, -9, -22, -43, -14, -7, -13, -11, -5, 10, 0, 21,
+    -38, -53, -36, 2, -3, 19, -2, -7, 6, 7, -3, -32, 5, 3, -3, 13, 14, 8, 24, 19,
+    -12, -47, -15, 14, 20, 9, -1, 3, 4, 23, 1, -17, 27, 40, -8, 14, 16, 20, 17, 22,
+    -7, -37, -8, 18, 15, 2, 6, 6, 16, 8, 6, -30, 35, 27, 6, 11, 16, 21, 24, 41,
+    -4, -16, 1, 10, 12, 6, 0, -5, 27, 25, 18, -21, 11, 34, 3, 6, 20, 23, 16, 28,
+    -17, -27, 6, 36, 0, 13, 10, -7, 3, 6, 1, -17, 21, 30, 14, 1, 17, 20, 31, 38,
+    -6, -6, -3, 22, 14, 11, 2, 12, 13, -5, 28, 5, 38, 47, 9, 10, 15, 34, 33, 50,
+    17, 1, 8, 8, 21, -9, -9, -1, 25, 6, 9, 5, 30, 45, 23, 22, 20, 14, 19, 34,
+    26, 11, 24, 34, 16, -6, -28, 10, 16, 11, 15, 0, 22, 18, 9, -10, 0, 4, 7, 12,
+    35, 30, 14, 23, 2, -17, -22, -5, 5, 20, 13, 11, 20, 31, 6, -1, 4, -1, 7, 8,
+    // Hidden unit 11
+    56, 30, 24, 9, -7, 4, -11, -1, 2, -35, -30, -44, -27, -24, -25, -32, -15, -8, -19, -13,
+    41, 19, 31, -11, 0, -8, -2, -4, -18, -20, -29, -41, -13, -23, -19, -16, -31, -22, -12, -2,
+    49, 34, 20, -2, 7, -5, -17, -4, 6, -29, -35, -59, -26, -23, -25, -7, -29, -4, -16, 0,
+    35, 5, 8, 0, -11, 7, -6, -9, -7, -15, -32, -36, -21, -20, -13, -5, -18, -2, 3, -3,
+    30, 24, -2, -25, -8, -15, -16, -7, -32, -35, -40, -61, -47, -33, -41, -12, -6, -20, -10, -9,
+    35, 15, -17, -26, -15, -18, -18, -21, -15, -34, -43, -69, -38, -35, -28, -27, -26, -2, -7, -1,
+    39, -7, -13, -33, -11, -25, -18, -9, -14, -39, -40, -66, -44, -22, -33, -26, -12, 2, 4, 18,
+    35, 4, -21, -17, -12, -2, -24, -4, -14, -27, -38, -42, -36, -10, -12, -16, 11, 0, 10, 21,
+    21, -12, -20, -49, -21, -15, -26, -16, -31, -37, -48, -61, -42, -28, -22, -4, 0, -4, 16, 17,
+    20, 0, -23, -21, 0, -1, -9, -15, -20, -32, -33, -33, -27, -16, -15, -7, -19, 4, -8, 13,
+    39, 8, -22, -22, -15, 5, -8, -16, -24, -26, -16, -30, -16, -8, -15, -23, -19, -10, 2, 4,
+    26, 19, -5, -15, -4, -10, -17, -12, -6, -31, -24, -34, -15, -24, -20, -23, -16, -5, -7, -8,
+    32, 15, 3, -16, 11, -8, -8, 8, 12, -9, -3, -22, -1, -4, -17, -1, -1, -10, 10, -1,
+    40, 2, -11, -2, -4, -13, -19, 6, 0, -7, -3, -25, -7, -20, -8, -7, -4, -7, -15, 3,
+    33, 18, -5, -5, 1, -15, -27, 1, -14, -3, 7, -5, 4, -8, -18, -16, -10, 2, 0, 4,
+    33, -5, -2, -8, 6, -9, -21, -23, -14, -19, -11, -6, -1, -24, -15, -9, -11, 1, -3, -2,
+    32, 8, 21, 20, 5, 11, -16, -3, -21, -13, -7, -5, -24, -10, -32, -20, -28, -21, -14, -14,
+    52, 25, 31, 39, 28, 10, 1, -12, -8, -16, 0, -1, -7, -18, -43, -20, -26, -29, -26, -23,
+    52, 20, 41, 28, 20, 4, 8, -4, -7, -14, 23, -11, 16, 0, -17, -22, -26, -20, -15, -33,
+    64, 41, 48, 41, 20, 19, 13, -17, -1, -17, 6, 4, -5, -10, -30, -21, -21, -38, -35, -26,
+    58, 49, 40, 62, 38, 28, 15, -4, 1, 4, 8, -1, 7, 5, -10, -15, -33, -36, -14, -33,
+    50, 24, 25, 23, 20, -1, -9, -12, -4, 6, 1, -18, -14, -18, -42, -46, -41, -35, -35, -39,
+    15, 4, 15, 3, 4, -18, 2, -25, -7, -15, -22, -43, -39, -37, -41, -30, -49, -37, -38, -38,
+    10, -13, -29, -17, -23, -33, -20, -29, -16, -28, -29, -34, -30, -49, -42, -36, -42, -29, -21, -39,
+    5, -16, -19, -31, -54, -55, -58, -37, -33, -12, -41, -43, -24, -48, -44, -27, -27, -15, -1, -14,
+    -11, -39, -25, -39, -56, -66, -56, -58, -13, -18, -31, -49, -30, -28, -33, -13, -26, -5, -10, 12,
+    -7, -32, -20, -33, -34, -52, -42, -51, -14, -20, -23, -34, -38, -34, -29, -18, -21, 2, 4, 9,
+    4, -27, -19, -20, -31, -46, -50, -34, -6, -5, -29, -30, -21, -43, -47, -18, -23, -7, -13, -11,
+    3, -12, 1, -9, -4, -38, -16, -18, -8, -15, -29, -48, -15, -25, -33, -30, -9, -5, -2, 4,
+    0, -18, -25, -5, -8, -4, -24, 2, 17, 9, -23, -34, -16, -13, -23, -22, 3, -5, 3, 11,
+    -1, -15, -10, -3, 15, 4, -4, 11, 23, 18, -11, -28, -8, -10, -31, -16, 6, -4, 9, 7,
+    -12, -25, -31, 8, 21, 4, -2, 20, 29, 10, -28, -40, -1, -10, -20, 5, 9, -9, -7, -4,
+    4, -14, -10, 9, -11, -11, -10, 17, 10, -4, -5, -31, -37, -19, -45, -13, -14, -25, -3, 4,
+    13, -19, -14, -12, -3, -11, -1, 18, 20, -11, -13, -31, -38, -25, -47, -19, -27, -20, -12, -9,
+    8, -23, -23, 1, 17, 8, 26, 19, 22, 6, -17, -21, -22, -22, -33, -30, -12, -27, -15, -13,
+    34, 5, 10, 37, 41, 21, 30, 14, 19, 19, -4, -12, -18, -2, -22, -15, -16, -17, -6, -15,
+    26, 11, 19, 36, 37, 28, 21, 30, 16, 20, -6, -29, -10, 10, -5, -11, -15, -10, -8, 6,
+    44, 16, 10, 38, 26, 28, 21, 12, 24, 9, -2, -19, -14, -6, -4, -17, -7, -22, -12, 4,
+    69, 30, 25, 39, 48, 29, 29, 13, 32, 24, 14, -27, 6, 3, -6, -5, 3, -6, -2, -11,
+    63, 28, 47, 51, 39, 30, 27, 36, 39, 36, 3, 8, 2, 2, 4, 6, 4, 9, 4, 11,
+    // Hidden unit 12
+    30, 5, 2, -25, -18, -5, -8, -11, -13, -24, -48, -52, -9, -9, 6, 5, 13, 26, 34, 23,
+    35, -2, -23, -46, -30, -9, -6, -20, -9, -26, -43, -58, -33, -16, -20, -13, 1, 20, 11, 19,
+    13, 2, -20, -48, -37, -3, -13, -5, -5, -22, -43, -64, -28, 3, -15, 5, -7, 21, 28, 24,
+    7, 6, -36, -61, -18, 3, -1, -21, -1, -16, -37, -49, -32, -4, -20, -5, -4, 14, 3, 28,
+    34, -1, -19, -63, -13, -4, -8, -12, -1, -21, -33, -33, -7, -9, 6, -5, 11, 15, 9, 21,
+    13, -2, -30, -55, -11, 15, 16, 14, 4, -23, -37, -52, -22, -1, -7, -3, 11, 6, 4, 3,
+    0, 8, -29, -44, -4, 3, 10, -13, -8, -15, -44, -45, -29, -3, -15, -1, -7, 7, 15, 20,
+    12, 11, -28, -23, -7, -17, -12, -6, 2, -10, -19, -51, -29, 1, -20, -20, -11, -11, 2, 8,
+    15, -14, -20, -26, -8, -9, -11, -6, -13, -42, -49, -44, -39, -24, -28, -19, -28, -17, -12, -13,
+    16, 5, -28, -31, 6, -22, -5, -15, -32, -32, -40, -38, -19, -23, -22, -31, -12, -16, -29, -17,
+    21, 7, -20, -24, -16, -23, -18, -7, -13, -28, -19, -44, -33, -18, -31, -21, -27, -15, -23, -31,
+    9, -9, -10, -19, -3, -16, -15, 2, -11, -15, -14, -27, -11, -7, -17, -24, -11, -29, -17, -16,
+    1, -15, -5, -12, -21, -17, -24, -18, -17, 3, -10, -28, -18, -18, -2, -22, 2, -10, -18, -18,
+    6, -10, -11, -17, -23, -15, -28, 7, 4, 2, -5, -25, -11, 12, -12, -15, 1, -20, -9, 0,
+    12, -7, -7, -2, -13, -26, -34, -6, 5, 6, 14, -6, 3, 14, -6, -5, -16, -14, -6, -1,
+    13, 5, 20, 8, -24, 2, -21, -7, 4, 0, 26, 3, -1, 33, 11, -6, 13, 6, 9, 17,
+    50, 22, 20, 7, -9, -12, -8, 14, 21, 30, 28, 13, 27, 39, 18, 13, 7, 13, 17, 21,
+    34, 27, 41, 24, 2, -5, -4, -3, 19, 41, 44, 17, 37, 26, 15, 21, 29, 28, 35, 21,
+    46, 27, 28, 30, -17, 0, -17, 3, 36, 35, 45, 17, 41, 49, 26, 36, 31, 23, 43, 39,
+    67, 18, 53, 27, 14, -7, -1, 4, 12, 16, 41, 23, 28, 49, 33, 20, 20, 19, 42, 42,
+    68, 38, 36, 26, 1, 6, -14, 11, 7, 24, 31, 24, 48, 44, 37, 29, 28, 21, 28, 23,
+    71, 47, 50, 34, 1, 11, -9, 7, 14, 17, 10, 3, 44, 38, 17, 23, 17, 6, 25, 13,
+    52, 24, 41, 43, 26, -5, 13, 7, 3, 12, 15, -10, 30, 21, 15, 17, 17, 19, 7, 5,
+    21, 8, 10, 8, 3, 4, 7, 0, 5, 11, 12, 1, 10, 24, 2, -6, 6, 6, 18, 9,
+    23, -22, 3, 18, 6, -6, 6, -13, 12, -4, 16, 11, 26, 7, 11, 18, 20, 15, 27, 21,
+    -3, -37, -19, 20, 11, -3, 6, -10, -4, 1, -3, 5, 11, 5, 3, 10, 12, 9, 8, 22,
+    8, -22, 10, 20, 23, 8, 8, 15, 0, 1, -7, 16, 21, 26, 15, 8, 11, 21, 14, 13,
+    3, -32, 6, 24, 47, 23, 17, 24, 6, 1, 7, 15, 6, 10, 14, 0, 18, 18, 10, 28,
+    -8, -31, 7, 29, 34, 39, 39, 24, 25, -7, -5, 2, 15, 30, 18, -2, 10, 18, 21, 27,
+    -21, -34, -11, 21, 45, 39, 39, 29, 16, 0, 2, -7, 21, 22, -4, 2, -2, 21, 17, 30,
+    -27, -52, -35, 16, 53, 40, 32, 44, 29, 1, -13, -6, 24, 18, 1, -1, 15, 4, 10, 10,
+    -30, -45, -33, 33, 64, 60, 29, 30, 42, -15, -16, 5, 27, 10, 11, 11, -1, 13, 6, 11,
+    0, -39, 0, 15, 44, 15, 15, 32, 12, 11, -11, -21, 8, 9, -2, 6, 0, -3, 6, 21,
+    -19, -37, -7, 13, 15, 15, 6, 25, 18, 4, -20, -23, 0, -13, 1, -13, -9, -3, 6, 16,
+    -12, -43, -28, -13, 4, -5, 3, 9, 21, 6, -11, -33, -1, -6, -16, -4, -4, -11, 1, -11,
+    -12, -49, -27, -7, -10, 6, -6, -3, 5, -8, -9, -21, -16, -16, -20, -23, -10, -14, -2, 4,
+    -28, -35, -36, -13, -8, -7, 2, 1, 10, 0, -21, -32, -6, -14, -13, -19, -15, -9, 12, 1,
+    -8, -33, -25, -6, -1, -17, -20, -5, 4, -19, -30, -16, 0, 0, -3, 2, -5, -16, 3, -5,
+    8, -10, -22, 6, -1, -19, -12, -8, 1, -10, -24, -18, -14, -6, -21, -24, -26, -8, -7, -5,
+    32, -1, 5, 22, 6, 4, -9, 16, 17, -3, 4, -24, -8, -12, -8, -7, -19, 7, -4, -6,
+    // Hidden unit 13
+    -37, -28, -18, 23, 14, 10, -9, -20, -8, -11, 41, 79, -8, 1, 9, 6, 8, -13, -13, -16,
+    -41, -32, 16, 35, 33, 4, 16, 1, 4, -1, 38, 85, 3, 11, 34, 12, 20, 6, -6, -13,
+    -23, -27, 16, 22, 12, 1, 27, 14, -9, -16, 18, 82, 15, -3, 41, 28, 9, 25, 10, -4,
+    -33, -17, 21, 32, -4, -12, 1, 17, -20, -24, 12, 81, 8, -8, 42, 15, 8, 8, 4, -10,
+    -71, -50, -5, 2, -21, -28, 7, 15, -5, -7, 23, 83, 5, -1, 15, 15, -1, -16, -2, -27,
+    -55, -33, 21, 17, -7, 2, 13, 28, 12, -3, 29, 71, 7, -3, 35, 28, 10, 1, -5, -15,
+    -53, -7, 17, 13, -18, -8, 28, 35, 7, 6, 23, 77, 31, 20, 26, 23, 9, 15, 12, -17,
+    -47, -13, 11, -8, -11, -14, 4, 17, -6, -15, 27, 77, 40, 20, 45, 19, 7, 20, 8, -3,
+    -41, -28, 13, 13, -6, -30, -13, -22, -18, 3, 2, 53, 33, 34, 48, 32, 34, 30, 23, 10,
+    -68, -38, -12, 23, -12, -29, -28, -22, -33, -11, -15, 9, -10, -18, 15, 5, 16, 7, -1, 7,
+    -43, -17, 6, 23, -9, -11, 7, -16, -12, -7, -12, 19, -6, 0, 6, -3, -8, 1, -14, 6,
+    -38, 1, 5, 23, -1, 7, 28, 0, 5, 3, 1, -6, -13, -11, 0, 15, -7, 0, -11, -11,
+    -46, -18, -3, 1, -10, -3, 12, 0, 2, -12, 4, 25, 8, 11, 34, 24, 28, 19, 15, 19,
+    -48, -30, -17, -9, -32, -11, 4, 1, 0, -14, -26, 5, 3, 9, 18, 19, 4, 20, 18, 24,
+    -55, -22, -6, -20, -27, 20, 23, 23, 28, -12, -37, -4, -31, -21, 7, 0, 0, 5, 11, -11,
+    -21, -16, -14, -42, -14, 13, 17, 20, 31, 11, -33, -20, -40, -5, 5, -15, 4, 5, -2, 3,
+    -30, -12, -15, -13, 5, 26, 33, 41, 58, 22, -46, -19, -35, -12, 18, -10, -6, -2, -5, 4,
+    -24, -37, -33, -51, 12, 42, 44, 52, 40, -13, -27, -7, -27, -7, 10, 2, 14, 2, 11, 1,
+    -54, -25, -42, -49, -9, 19, 25, 31, 22, 2, -36, -18, -19, 5, 13, -3, 0, 4, 20, -1,
+    -49, -36, -49, -34, -21, 3, 17, 37, 38, 16, -12, 3, -26, 3, 18, 23, 13, 18, 15, 18,
+    -68, -9, -10, -32, -15, 16, 24, 34, 38, -4, -37, -7, -27, -13, 8, 5, 10, 9, 12, -5,
+    -44, 3, 6, 10, 19, 54, 50, 78, 47, -5, -10, 28, -7, 16, 25, 22, 13, 18, -1, -11,
+    -45, -5, -17, -1, -7, 8, 28, 36, 6, -27, -22, 6, -10, 0, 13, -9, -13, -3, -17, -28,
+    -52, 16, 15, 17, 22, 19, 22, 27, 8, -25, -18, 38, -22, 3, 14, 6, -6, -2, -12, -4,
+    -17, 26, 18, -2, 3, 30, 1, 18, 12, -9, 4, 55, 8, 16, 28, 15, 20, 1, -3, 3,
+    -1, 15, 3, -5, -12, 0, -16, 3, -15, -36, -1, 51, -9, 20, 18, 11, 17, 8, 7, 0,
+    1, 16, 5, 7, -29, -28, -30, -27, -31, -36, 1, 39, -15, 9, 24, 23, -4, -6, -2, -6,
+    9, 20, 11, 12, -33, -17, -24, -51, -49, -34, -4, 48, 3, -9, 16, 12, 4, 2, 7, 2,
+    15, 14, 21, -2, -28, -28, -32, -36, -51, -43, 3, 57, 1, 0, 30, 27, 5, -3, 9, 4,
+    35, 36, 38, 3, -15, -33, -41, -58, -42, -18, 35, 83, 9, 16, 44, 28, 27, 23, 3, -1,
+    29, 49, 30, 5, -6, 1, -9, -40, -31, -9, 49, 90, 20, 43, 60, 39, 36, 32, 36, 23,
+    19, 34, 47, 6, -18, -34, -22, -26, -33, 9, 58, 85, 15, 41, 56, 39, 28, 22, 29, 1,
+    -27, -11, -12, -35, -25, -30, -39, -28, -36, 0, 1, 17, -8, -13, 14, 9, -1, -1, -4, -5,
+    -17, -17, -27, -36, -24, -12, -11, -41, -25, 7, -3, 20, -11, -1, 1, 0, 8, -5, 13, 1,
+    -25, -19, -12, -37, -31, -14, -11, -25, -29, -14, 2, 1, -6, -18, 15, 15, -4, 0, -3, -7,
+    -39, -16, -20, -19, -28, -22, -20, -31, -16, -11, -23, -12, -17, -18, 8, -3, -10, -9, 9, -9,
+    -24, 5, 2, -21, -16, -16, -12, -13, -11, -3, -3, 4, -1, -13, 8, 2, -10, 0, -8, -3,
+    -36, -29, -16, -13, -10, -23, -8, 0, -9, -8, -3, 12, 1, -9, -8, -8, 7, -5, -7, -8,
+    -47, -13, -14, -31, -30, -8, -15, -6, -20, -3, -8, 8, 10, 12, 7, -9, 1, 0, 9, 7,
+    -52, -28, -14, -17, -7, -18, -6, 3, -19, -22, 3, 15, 4, 7, 8, 8, -7, -8, 4, 8,
+    // Hidden unit 14
+    43, 35, 15, 9, 7, 11, -9, -14, -18, -34, -53, -71, -6, 2, -15, -13, -10, 8, 4, 11,
+    47, 19, 2, -15, 10, 0, 1, -4, -16, -10, -26, -36, -8, 15, -18, -5, 8, 1, 1, 10,
+    41, 13, 10, -17, 3, 21, -4, -13, -14, -13, -34, -51, 3, -8, -27, -4, -12, -9, 1, 6,
+    47, 19, 9, -27, 30, 31, 11, -11, -13, -2, -29, -52, -18, -3, -28, -15, -6, -1, -2, 6,
+    55, 34, -7, -1, 48, 36, 5, -13, -24, 1, -28, -61, -25, 6, -11, -9, -7, 0, -6, 12,
+    59, 37, -1, -1, 55, 27, 13, -1, -17, -13, -35, -60, -15, 3, -22, -17, -7, -26, -6, -1,
+    45, 51, 14, 7, 49, 38, 10, -1, -13, -16, -21, -40, -6, -9, -9, -31, -22, -22, -10, -3,
+    36, 36, 12, 12, 41, 32, -6, -25, -3, -12, -21, -52, -28, -6, -11, -31, -24, -12, -2, -14,
+    40, 16, 15, 15, 43, 1, -3, 4, -18, -26, -24, -27, -13, -6, -33, -9, -27, -27, -21, -6,
+    29, 16, 19, 11, 33, 3, -1, -14, -28, -30, -25, -27, -9, -16, -21, -23, -28, -39, -17, -35,
+    25, 14, -3, -8, 13, -10, -22, -7, -19, -20, -8, -11, 4, -15, -21, -18, -31, -40, -22, -37,
+    10, -4, -16, -8, 21, -14, -13, 7, -6, -13, 7, -6, 12, 5, -2, -9, -6, -9, -14, -25,
+    -3, -17, -5, -9, 0, -16, -6, -4, 7, -3, 26, 11, 15, 7, 7, 11, -8, 3, 1, -16,
+    4, -24, -12, -12, -18, -2, -18, 9, 2, 5, 13, -13, 31, 15, -8, -2, 2, -7, 2, 4,
+    3, -23, -14, -19, -11, -9, -24, 2, -8, -1, 15, 11, 16, 23, 2, 16, 5, 17, -3, -3,
+    1, -7, 0, -3, -27, -14, -22, -7, -5, 3, 31, 21, 19, 36, 4, 5, 28, 27, 18, 29,
+    15, -14, 8, 2, -31, -25, -30, -10, -5, 14, 21, -6, 34, 27, 6, -1, 4, 10, 22, 22,
+    34, 2, 9, 21, -16, -30, -36, -3, -11, 2, 24, -10, 24, 40, 14, 17, -1, 5, 23, 18,
+    29, 0, 24, 8, -1, -26, -28, 9, -3, 15, 16, 17, 35, 43, 2, 23, 24, 4, 16, 22,
+    59, 7, 40, 18, -1, -4, -5, -9, 11, -2, 10, 13, 33, 20, 4, 1, 8, -7, 16, 4,
+    48, 33, 38, 40, 13, -11, -10, -4, 1, 7, 19, -4, 35, 27, -4, 9, -1, -16, -13, -2,
+    39, 25, 33, 31, 27, 3, -11, 1, 9, 6, 7, -9, 25, 12, 3, 6, -10, -11, 8, 6,
+    45, -4, 29, 19, 12, -14, -5, 5, -1, 15, -12, -26, 17, 2, -13, -10, -12, -25, -16, -26,
+    19, -2, -6, 4, -1, 7, -16, -14, -4, -7, -18, -28, 3, 4, -6, -23, -7, -26, -4, -21,
+    2, -17, -19, 3, 11, -5, -8, -26, 1, -4, -3, -1, 2, -6, -14, -10, -6, -8, -1, -9,
+    4, -37, -15, 12, -6, 0, 1, 4, 17, 21, -5, -6, 12, 8, -3, 4, -6, 6, 16, 11,
+    1, -38, -21, 1, 9, 2, 14, 0, 14, 11, 12, -7, 11, 21, 1, 6, 19, 8, 10, 22,
+    1, -40, -3, 23, 26, 10, 11, 16, 20, 15, 1, -1, 10, 26, 0, 15, 2, -6, 8, 19,
+    -9, -39, -1, 26, 41, 29, 19, 35, 35, 16, 9, -32, 16, 28, 14, 8, -5, 3, 11, 28,
+    -17, -49, -16, 9, 28, 25, 42, 36, 40, 5, 3, -22, 19, 17, -10, 3, 6, 8, 4, 25,
+    -24, -63, -28, 14, 43, 40, 24, 49, 33, -3, -12, -31, 21, 10, -3, -14, 15, 13, -5, 10,
+    -35, -75, -46, 28, 33, 43, 26, 31, 43, -5, -19, -29, 9, 14, 2, 2, -4, 18, 4, 17,
+    -22, -58, -39, 2, 33, 22, 14, 30, 24, 2, -23, -30, 3, 16, -2, -1, -1, 14, 5, 3,
+    -29, -64, -41, -2, 28, 13, 5, 28, 26, 3, -31, -26, 14, 1, -15, 1, -2, -10, 8, 20,
+    -20, -64, -48, 14, 2, 15, 14, 21, 26, -13, -15, -32, -7, 7, 7, 7, 15, -6, 16, 11,
+    -25, -45, -33, 2, 1, 21, 16, 4, 19, -8, -17, -33, -3, 7, -8, 1, 15, -1, 18, 12,
+    -23, -40, -18, 8, 10, 4, 0, 0, 6, 0, -8, -19, 10, 26, -11, 8, 8, 16, 11, 37,
+    -19, -29, -21, 16, 7, 8, -4, 18, 14, -18, -22, -17, 12, 13, 13, 8, 7, 12, 9, 29,
+    0, -26, -17, 10, 14, -7, -18, 1, 9, -8, -7, -14, 9, 26, 12, 7, 4, -2, 1, 17,
+    32, 5, 2, 35, 30, -12, -7, -1, 7, 12, 12, 5, 21, 11, 15, -5, -1, 6, -6, 11,
+    // Hidden unit 15
+    22, 23, 27, 1, 5, -4, 6, 3, -21, -37, -39, -68, -20, -23, -17, -24, -19, 2, 12, 19,
+    22, 15, 13, -12, 2, 1, 11, 7, -22, -24, -26, -51, -20, -11, -29, -18, -4, -18, -5, 9,
+    18, 18, -6, -34, 7, 18, -2, -9, -7, -19, -27, -41, -18, -14, -30, -3, -1, -1, 0, -8,
+    5, 18, -16, -43, 22, 4, -1, 9, -14, -15, -26, -52, -9, -5, -23, -25, -8, -7, -8, 9,
+    20, 24, -26, -34, 28, 15, 9, 11, 6, -3, -27, -45, -20, -12, -21, -11, -14, -5, -9, 5,
+    4, 17, -30, -41, 26, 26, 20, -8, 7, 0, -33, -40, -14, 4, -12, -8, -8, 2, 20, 18,
+    7, 3, -43, -51, 12, 1, 9, -1, 1, -11, -28, -46, -13, -13, -9, 4, 5, -5, 14, 16,
+    9, 5, -37, -34, 20, -5, 0, -21, -12, 6, -17, -39, -8, 3, 0, -2, 20, 18, 21, 36,
+    13, 2, -27, -16, 1, 1, 5, 0, -9, -33, -28, -44, 3, 11, -4, -4, -2, 3, 23, 24,
+    -5, -10, -13, -29, -3, -17, -7, -21, -15, -27, -21, -24, 4, 1, 9, 7, -1, 8, 8, 15,
+    -4, -12, -23, -31, -5, -24, -26, -17, -21, -31, -1, -22, 14, 11, -10, 3, 8, 6, 6, 4,
+    -6, 1, -6, -3, 1, 7, -12, -3, 8, 6, 11, -8, 29, 31, 3, 0, 0, -4, 25, 9,
+    4, 6, 12, -9, 10, 13, -8, 9, 12, 7, 19, 24, 36, 40, 25, 21, 29, 32, 25, 13,
+    25, 14, 25, 9, 4, 5, -5, 13, 22, 10, 35, 18, 53, 48, 29, 20, 24, 36, 28, 32,
+    22, 15, 11, 20, -4, 9, 1, 19, 19, 22, 35, 2, 26, 24, 13, 13, 15, 8, 1, 5,
+    20, 10, 20, 12, 7, 13, 3, -5, 12, 5, 29, 9, 43, 40, 12, 4, 13, -7, -5, 2,
+    38, 30, 30, 31, -1, 22, -19, 12, -6, 23, 18, -13, 36, 30, -1, 7, 13, 9, 5, -3,
+    37, 23, 40, 49, 23, -5, -19, 11, 6, 25, 19, 10, 44, 33, 14, -4, 11, 11, 10, 3,
+    33, 26, 33, 33, 11, 13, 3, -1, 3, 23, 34, -5, 24, 25, -2, -2, 11, -5, 6, -8,
+    36, 29, 51, 53, 23, 17, 6, 1, 9, 15, 34, 10, 35, 39, -2, -3, 1, 2, 10, 3,
+    40, 24, 44, 57, 49, 20, -6, 5, 11, 15, 11, 8, 25, 31, -6, -3, -20, -13, -11, -17,
+    35, 8, 19, 37, 37, 15, 6, 21, 6, 5, 6, -11, 21, 4, -6, -5, -23, -37, -11, -23,
+    26, -8, 17, 14, 33, 1, -5, -2, 9, -1, 4, -34, 7, -2, -23, -20, -13, -31, -29, -8,
+    7, -22, -6, -7, 19, -4, 2, 0, -6, 2, -14, -33, 7, -14, -21, -14, -22, -19, -8, -22,
+    -22, -44, -33, -10, 4, -5, -10, -6, 2, 7, -22, -6, 5, 7, 2, -16, -6, -7, 12, 1,
+    -19, -56, -54, -25, 6, -13, -2, -5, 4, -7, -13, -12, -12, 2, -16, -16, 7, 6, 15, 7,
+    -13, -49, -33, -5, -9, -20, -24, -6, 6, -2, -12, -32, 0, -3, -9, -15, 7, -2, 14, 15,
+    -23, -58, -40, -10, -10, -16, -10, 8, -1, -7, -16, -17, 6, 10, -9, -6, -4, -9, 21, 4,
+    -14, -55, -34, 2, 3, 11, 8, 16, 21, -4, -4, -28, 27, 21, 8, -7, 9, 5, 9, 29,
+    -24, -43, -28, 10, 26, 16, 28, 23, 13, 0, -5, -32, 16, 15, -1, 0, -1, 15, 10, 21,
+    -29, -48, -24, 14, 13, 30, 7, 17, 26, 2, 4, -13, 28, 23, 14, -4, 2, 9, 4, 18,
+    -19, -53, -24, -5, 23, 24, 7, 23, 23, 3, -16, -22, 21, 13, 1, 8, 10, 20, 5, 9,
+    -10, -49, -23, 1, 28, 14, 10, 17, 24, 3, -11, -10, 20, 18, -17, -2, -2, 5, -9, 3,
+    -4, -39, -22, 2, 23, 17, 6, 19, 35, 14, -7, -4, -1, 2, -20, 1, -1, -7, -8, 7,
+    -2, -34, -11, 22, 12, 4, 16, 7, 30, 17, 5, -18, 3, 24, -18, -12, 7, -12, 2, 2,
+    -8, -26, -1, 6, 0, 28, 15, 18, 18, 12, -2, -15, 3, 13, 4, 8, 15, 12, -1, 7,
+    -10, -19, -1, 33, 9, 1, -2, 12, 29, 18, -10, -28, -3, 3, -1, -20, -11, -5, 14, 10,
+    -4, -9, -11, 19, 14, -4, -1, 16, 21, -8, 0, -10, -2, 14, 5, -7, -13, -9, -14, 1,
+    1, -16, -17, 21, 15, 2, -4, -2, 22, 17, -15, -22, 1, 3, -4, -15, -12, -19, -24, -14,
+    31, -7, 16, 12, 4, -14, -7, 7, 6, -1, 5, -5, 13, 2, -3, -28, -8, -2, -20, -12,
+    // Hidden unit 16
+    37, 41, 20, 15, 7, 22, -6, -15, -6, -30, -39, -54, -23, -1, 7, 9, 8, 14, 18, 25,
+    41, 28, 28, 2, 0, -2, 12, 1, -6, -24, -19, -33, -5, 9, -6, -10, 2, 15, 3, 18,
+    47, 20, 18, -7, 10, 13, 15, -10, -1, -28, -24, -30, -2, 12, -10, -13, -9, 2, 17, 1,
+    38, 23, 11, -8, 33, 10, 8, -13, -5, -10, -26, -36, -17, -11, -14, -5, -4, -5, 0, 8,
+    39, 37, 11, -3, 33, 0, -17, -18, -13, -9, -39, -56, -32, -4, -14, -24, -16, 2, -9, 5,
+    49, 32, 11, -17, 22, 32, 1, -11, 2, -24, -20, -54, -32, -3, -20, -7, -25, -12, -8, -4,
+    40, 37, 11, 6, 19, 7, 0, 13, -2, -8, -18, -27, -18, 5, -12, -17, -4, -9, -2, 4,
+    39, 30, -16, 2, 12, 2, 2, -11, -12, -18, -14, -44, -25, -6, 1, -19, -14, -4, 1, -4,
+    35, 6, 7, -27, 13, -12, 11, -10, -20, -23, -17, -26, -23, -12, -10, -27, -23, -7, -11, -1,
+    24, 28, -3, -31, 6, -17, -5, -21, -14, -18, -27, -35, -33, -4, -8, -26, -23, -7, -16, -17,
+    15, 15, -4, -26, 0, 0, -12, -2, -17, -11, -5, -2, -12, 0, -19, -16, -4, -27, -24, -11,
+    10, 7, -22, -17, 2, -10, -20, 0, 1, -12, -13, -2, 1, 3, -3, 4, 9, -12, 5, -11,
+    6, -10, -29, -42, -19, -19, -20, 3, -2, 3, 15, 2, 12, 5, 3, -3, 10, 5, 0, 10,
+    8, -6, -12, -15, -29, -30, -42, 9, 7, 0, 8, 1, 9, 22, 8, 19, 10, 11, 12, 28,
+    -3, -20, -21, -22, -34, -5, -27, 1, -6, 14, 22, 9, 5, 4, 3, 25, 12, 9, 32, 26,
+    15, -16, -5, -19, -20, -18, -9, -11, 3, -9, 13, 12, 25, 38, 18, 24, 8, 12, 28, 27,
+    23, 2, 0, -20, -24, -20, -12, 7, 6, 4, 22, 12, 19, 38, 14, 9, 24, 32, 35, 19,
+    20, -7, 18, 4, -15, 1, -23, -15, 1, 18, 25, 9, 26, 19, 26, 28, 21, 26, 26, 34,
+    37, 20, 13, 22, 6, -14, -8, 9, 12, 19, 28, -5, 21, 35, 13, 18, 30, 30, 45, 26,
+    52, 31, 43, 17, 11, 3, -11, 13, 21, 15, 37, 25, 46, 29, 25, 23, 22, 2, 16, 10,
+    64, 45, 42, 56, 22, 24, -7, 13, 10, 5, 8, 12, 28, 35, 18, 5, 8, -7, 11, 12,
+    67, 53, 71, 60, 33, 34, 14, 21, 10, 6, 1, 9, 24, 30, 13, 12, 7, -7, -1, 9,
+    49, 38, 42, 56, 52, 30, 16, 25, 24, 33, 24, 10, 12, 9, 2, -10, -9, -19, -9, -17,
+    45, 26, 42, 50, 30, 33, 27, 12, 29, 18, 7, 7, 27, 19, -4, -4, -4, -7, -4, -21,
+    4, -6, 13, 25, 16, 5, 8, 6, 5, -1, 6, -10, 3, 8, -8, -30, -17, -15, -9, -13,
+    -9, -28, -10, 18, 20, 15, 13, 11, -3, 3, -21, -8, 3, 0, -5, -16, -8, -27, -15, -3,
+    -25, -59, -23, 4, 9, 0, 4, 3, 12, -21, -20, -3, -2, 9, -6, -10, 2, -17, -23, 7,
+    -34, -58, -45, -15, 2, 7, -5, 5, 14, -8, -28, -16, 2, -7, 4, -9, 2, 1, -17, -8,
+    -40, -91, -65, -8, 17, 16, 20, 0, 4, -18, -27, -22, -13, -12, -19, -12, 1, 0, -13, 19,
+    -68, -110, -89, -29, -1, 11, -9, 5, 9, -21, -33, -40, -13, -10, 0, -13, 5, 0, -3, 11,
+    -78, -99, -90, -47, -5, 7, 2, 16, 5, -20, -30, -27, -7, 6, -4, -4, -5, 9, 3, 11,
+    -68, -110, -99, -19, 7, 3, -7, 10, 12, -28, -31, -17, 0, -4, -5, 7, 14, 11, 22, 26,
+    -47, -76, -72, -17, 2, -12, -9, 2, 9, -3, -22, -13, -8, 2, -3, 11, 4, 15, -1, 11,
+    -30, -68, -58, -14, 2, 10, -12, -1, 6, -3, -21, -13, -6, 6, -7, -6, 16, 13, 20, 17,
+    -22, -56, -44, -13, 6, 12, -11, 11, 15, 0, 3, -18, 0, 20, 8, 2, 5, 12, 21, 12,
+    -10, -48, -36, 6, 2, 10, 4, 3, 23, 0, -8, -4, 15, 1, 3, 1, -3, 9, 18, 20,
+    -7, -21, -7, 33, 25, 1, -6, 3, 5, -2, -6, -12, 7, 22, 3, 6, -9, -3, 10, 16,
+    12, -7, -10, 32, 24, 15, -2, 22, 21, 4, 2, -13, 5, 22, -8, -8, 1, 8, 4, 7,
+    34, 8, 21, 41, 33, 11, -2, 7, 24, 2, 9, -15, 8, 10, -16, -7, -9, -17, -5, -8,
+    49, 41, 57, 53, 39, 1, 12, 2, 14, 23, 18, -8, 5, 5, -6, -21, -8, 2, 0, 3,
+    // Hidden unit 17
+    -30, -23, -9, 42, 24, 15, 9, 18, 45, 54, 92, 112, 46, 22, 13, 10, 2, -21, -36, -29,
+    -24, 1, 16, 51, 32, 27, 9, 6, 23, 42, 47, 89, 34, -7, 3, -2, -3, -22, -35, -33,
+    -11, -15, 35, 77, 24, 9, -7, 3, 11, 47, 62, 95, 19, 13, 13, 3, 1, -7, -27, -9,
+    -17, 5, 44, 88, 20, -11, 0, 22, 17, 40, 51, 94, 40, 6, 18, 4, 3, -7, -6, -11,
+    -15, 7, 55, 79, -14, -3, 8, 14, 13, 22, 49, 69, 34, -2, 20, 21, 13, -4, 6, -20,
+    -27, -19, 55, 56, -5, -26, -23, 4, 2, 5, 20, 54, 20, -14, 6, 16, -6, -2, 2, -12,
+    -20, 0, 43, 47, -12, -31, -15, -6, -6, -21, 4, 35, 4, -9, -6, 9, 3, -5, -14, -25,
+    -13, -13, 38, 47, -11, -13, -2, -13, -29, -46, -26, 23, -8, -11, 0, -2, -11, -1, -8, -15,
+    1, -20, 33, 30, -9, 2, -3, -7, -26, -27, -15, 0, -6, -10, -9, 14, -6, -8, 8, -5,
+    -10, 0, 11, 30, -25, -13, -14, -9, -17, -10, -29, -12, -14, -21, -4, 14, 4, 6, 1, 26,
+    -7, 7, 14, -8, -43, -16, -6, -17, -15, -14, -42, -16, -27, -20, 13, -3, 2, 18, 22, 29,
+    1, 6, -11, -22, -37, -11, 15, -25, -4, -17, -16, -11, -13, -33, -14, -5, 3, 4, 8, 4,
+    3, 3, -19, -34, -25, 12, 26, 0, 12, -4, -39, -8, -26, -27, 8, -4, -1, -5, 12, 20,
+    1, -3, -24, -36, -30, 22, 21, -7, 9, -2, -17, -12, -17, -30, -7, -5, 17, -3, 26, 6,
+    -5, -24, -46, -40, -5, 20, 30, 15, 8, 11, -35, -12, -24, -30, 7, 7, 18, 24, 9, 12,
+    -5, -7, -51, -56, -2, 21, 33, 5, 19, -1, -23, 5, -26, -19, -5, 12, 3, 14, 8, 21,
+    -20, -20, -30, -37, 8, 24, 41, 9, 28, 5, -30, 1, -26, -38, 13, 5, 10, 16, 7, 8,
+    -18, -8, -32, -37, 30, 35, 44, 17, 15, -16, -35, -4, -24, -24, 14, -3, -6, 12, 5, 23,
+    -37, -9, -24, -10, 31, 47, 42, 4, -7, -20, -24, -11, -30, -37, 1, -8, 4, 12, -3, 8,
+    -45, -16, -15, -20, 33, 32, 48, 3, 9, -2, -7, -6, -31, -32, -14, 5, 1, -8, 1, 8,
+    -42, -21, -25, -7, 19, 37, 41, 14, 6, 3, 0, 1, -31, -22, -15, -6, 2, 0, -16, -9,
+    -20, -6, -17, 0, 13, 42, 50, 12, 9, 6, 4, 6, -37, -32, -4, -6, 1, 4, -24, -13,
+    -13, 20, -11, 0, 12, 16, 20, 2, -6, -7, -5, 24, -23, -21, -10, -17, -18, -16, -19, -11,
+    12, 41, 20, 0, -7, 22, 13, -2, 8, -16, 11, 25, -20, -21, 8, -13, -2, -7, -33, -20,
+    13, 31, 29, 3, -1, 9, 0, -6, -19, -4, 0, 21, -1, -19, -1, 11, -4, -2, -28, -20,
+    24, 43, 24, -11, -36, -6, -32, -23, -20, -18, 14, 13, -17, -18, 0, 6, 4, 0, -13, -7,
+    16, 62, 18, -4, -25, -18, -25, -25, -31, -21, -3, 23, -2, -32, 4, 3, 0, -8, -9, -6,
+    35, 50, 25, -2, -42, -24, -35, -47, -37, -11, 14, 20, -15, -21, 5, -2, 12, -3, 2, -9,
+    44, 50, 33, -3, -33, -36, -38, -40, -58, -10, 9, 30, 1, -12, 10, 14, -11, 3, 8, -23,
+    51, 80, 42, 20, -29, -17, -33, -31, -32, -3, -1, 31, -5, -33, 8, 16, 6, -3, 0, -20,
+    68, 90, 65, 25, -22, -27, -14, -48, -29, 2, 21, 32, 0, -12, 10, 16, 6, 15, 0, -6,
+    48, 69, 37, 3, -14, -10, -6, -40, -20, 3, 13, 20, -18, 0, 23, 9, 13, 7, 12, -8,
+    22, 20, 4, -10, -25, -6, -2, -21, -22, -5, -4, 16, -27, -21, 1, 11, -2, -1, 7, 0,
+    4, 6, -21, -27, -30, -3, -10, -25, -35, -8, -8, 12, -8, -16, 16, 1, -12, -4, 14, -10,
+    7, 13, 2, -18, 4, -15, 14, -11, -25, -8, 2, 16, -18, -23, 1, 3, 9, 0, -9, 0,
+    18, -3, -13, -29, -2, -12, -11, 8, -16, -7, -9, 2, -9, -9, 10, 4, -1, 12, -6, -3,
+    13, -6, 4, -29, -8, 12, 17, 10, -5, 1, -20, 23, -10, -4, 9, 5, -7, -7, 1, -12,
+    3, -11, 0, -23, 3, 15, 8, -11, -5, -1, -7, -2, -7, -9, -8, -4, 2, -7, 0, -19,
+    -15, -2, 3, -36, -5, 12, 16, -11, -10, -6, 5, 8, -27, -8, 11, 1, -1, 0, 5, -11,
+    -27, -24, -28, -34, -20, 4, 10, 2, -2, -16, -3, 18, -5, -23, 5, 5, -2, -9, -6, 9,
+    // Hidden unit 18
+    -17, 0, -4, -30, -30, -1, 0, 0, -8, -8, -30, -48, -16, -8, -2, -16, -10, 13, 14, 9,
+    -14, 2, -35, -51, -54, -27, -11, 0, 5, -6, -22, -39, -14, -30, -19, -25, -24, 5, -5, 0,
+    -6, -23, -50, -57, -41, -7, -20, -8, -2, -14, -30, -46, -34, -8, -5, -25, -2, 5, 19, 10,
+    -24, -30, -43, -66, -27, -23, -18, 9, 14, 0, -14, -36, -34, -4, 1, -12, -10, -4, -3, 4,
+    -37, -29, -42, -66, -28, -7, -32, 4, -5, -4, -18, -37, -5, -1, 3, 11, -1, 10, 29, 18,
+    -33, -32, -66, -56, -16, -12, 4, 10, 0, 1, -8, -4, 0, 12, 2, 8, 19, 16, 26, 46,
+    -44, -53, -66, -64, -26, -20, -18, 9, -1, -7, -2, -19, -2, 4, 26, 29, 21, 27, 42, 44,
+    -49, -41, -60, -51, -26, -18, 0, -19, 1, 11, 5, -8, 12, 28, 39, 48, 44, 63, 50, 58,
+    -55, -72, -74, -84, -39, -37, -43, -29, -25, -25, -19, -7, 1, 23, 18, 42, 46, 68, 69, 76,
+    -64, -65, -77, -64, -39, -42, -22, -18, -22, -13, -18, -8, 3, 24, 38, 41, 56, 70, 68, 66,
+    -43, -46, -38, -35, -16, -28, -26, -20, -9, -5, 10, 8, 19, 44, 45, 56, 78, 96, 84, 84,
+    -20, -42, -51, -21, -29, -26, -33, 1, -41, -11, 12, 25, 31, 37, 57, 64, 71, 80, 78, 82,
+    -22, -21, -24, -23, 0, -28, -14, -8, -17, 3, 14, 13, 34, 28, 48, 52, 52, 52, 76, 61,
+    9, -1, -14, -4, 4, -1, -4, 1, 9, 25, 28, 7, 47, 40, 33, 38, 58, 62, 65, 52,
+    35, 10, 28, 27, 31, -6, -5, 5, 8, 22, 15, 21, 47, 27, 31, 39, 48, 46, 34, 59,
+    70, 40, 58, 55, 43, 19, 11, 2, 11, 6, 12, -9, 32, 31, 13, 5, 21, 28, 31, 26,
+    39, 44, 65, 70, 59, 12, 6, 18, 4, 32, 10, 8, 20, 19, -5, 16, 16, 25, 28, 21,
+    55, 60, 75, 70, 45, 15, -8, 8, 10, 22, 20, -11, 20, 16, -9, 2, 0, 5, 5, -2,
+    77, 62, 82, 64, 61, 28, -12, 20, 18, 22, 7, -11, 1, 11, -1, -3, -21, -2, 5, -3,
+    79, 69, 75, 64, 57, 39, -3, 10, 11, 10, 26, -5, 21, 17, -13, -20, 3, -6, -3, 17,
+    57, 77, 72, 98, 76, 29, 8, 7, 3, 21, 29, 0, 17, 5, 0, -2, -2, -6, 15, 10,
+    40, 43, 43, 59, 58, 25, 23, 16, -3, 18, 21, -4, 16, 12, 0, 4, -1, 7, 1, 6,
+    16, 16, 18, 34, 36, 19, 23, 8, 9, 9, -8, -18, 9, -9, -8, -18, -28, -25, -7, -2,
+    1, -9, -7, -14, 21, 3, 12, 5, -12, 1, -11, -25, -24, -19, -30, -9, -32, -20, -5, -3,
+    -34, -36, -15, -37, -36, -41, 2, -4, 1, -2, -25, -38, -16, -7, 0, 4, 6, 14, 13, 18,
+    -16, -46, -34, -41, -34, -36, -9, -8, -10, -3, -27, -39, -17, -27, -23, -9, -18, -9, 16, 2,
+    -6, -27, -38, -48, -40, -41, -26, -18, -13, -1, -37, -31, -7, -9, -7, -9, 0, 9, 7, 13,
+    -15, -25, -40, -53, -41, -35, -21, -11, -9, -16, -19, -27, -5, -6, -9, -1, -14, 4, 9, 7,
+    -4, -18, -10, -23, -3, -19, -19, -1, -10, -16, -19, -25, -4, -11, -26, -27, 1, 7, 9, 13,
+    3, 6, -5, -22, -2, -14, -25, -3, -3, 0, -7, -36, -8, -6, -16, -7, 5, -14, -3, -10,
+    4, -3, 2, -14, -8, -9, 8, 21, 18, 13, 0, -10, 3, -2, -25, -3, 2, 9, -11, 5,
+    2, -12, -8, -3, 23, 20, 5, 22, 15, 11, 8, -19, 1, -8, -19, 2, -7, 1, -13, 0,
+    8, -13, 4, -5, 7, -5, -23, 14, 12, -4, 5, -28, -24, -18, -31, -30, -5, -13, -24, -2,
+    17, 15, 23, 7, 10, -10, -19, -8, 10, -1, -12, -26, -25, -27, -33, -32, -9, -10, -13, -29,
+    29, 18, 10, 9, -4, -13, -24, -2, 13, -4, -9, -30, -28, -18, -20, -17, -22, -13, -23, -6,
+    14, 6, 28, 4, -5, -10, -16, 2, 4, -1, -8, -20, -23, -10, -24, -22, -23, -24, -9, -22,
+    -3, 1, 1, 14, 5, 0, 1, -6, 12, 5, 7, -32, -14, -7, -24, -21, -19, -13, -9, 2,
+    -9, -7, 8, -3, 6, -12, -26, -7, -1, -20, -16, -32, -28, -30, -34, -14, -11, -18, -23, -15,
+    -9, -19, -8, -5, -7, -31, -26, -21, 2, -18, -30, -48, -19, -30, -34, -6, -14, 2, -7, -6,
+    -7, -23, -11, -29, -18, -21, -14, 5, -3, -13, -33, -45, -13, -25, -9, -3, 5, 13, 0, 3,
+    // Hidden unit 19
+    4, 21, 1, -36, -29, -23, -2, -19, -21, -35, -42, -58, -33, -23, -17, -8, -4, 9, 13, 15,
+    -14, 8, -9, -49, -50, -15, -20, 0, -10, -32, -52, -39, -26, -32, -18, -8, -4, 6, 10, -1,
+    -14, -14, -28, -62, -46, -21, -28, -2, -25, -41, -39, -45, -32, -13, -19, -25, -13, -7, -5, 0,
+    -11, -11, -32, -63, -39, -31, -4, -8, -23, -41, -45, -62, -27, -19, -31, -9, -12, 5, -7, 0,
+    -20, 8, -22, -57, -33, -3, 4, -15, -10, -25, -40, -43, -32, -7, -13, -15, 1, -8, 3, 3,
+    -4, -7, -26, -40, -8, -6, 7, -1, -9, -27, -26, -44, -31, -19, -11, -14, 3, -1, 23, 14,
+    14, 17, -21, -35, -29, 4, 12, 17, -10, -22, -35, -32, -7, 8, 8, -4, 0, 14, 15, 5,
+    -8, -21, -35, -29, -2, -9, -25, -19, -12, -33, -47, -43, -42, -25, -4, -10, -1, 2, 0, 10,
+    1, 19, -12, -13, -22, -16, -20, -3, -22, -37, -55, -51, -28, -6, -21, -6, 0, 1, -4, 6,
+    12, 15, -27, -18, 4, 3, 4, -20, -25, -35, -41, -47, -13, -9, -16, -14, -24, -9, -7, 6,
+    20, 26, 2, -18, 11, 6, 8, 3, 2, -13, -11, -3, -5, -3, 3, -5, 6, -3, -1, 2,
+    1, 33, -3, -14, -2, -8, -3, -1, 9, -25, -4, -18, -8, 5, -3, -13, -13, -14, 9, 9,
+    28, 37, 0, -8, -10, -7, 1, 7, 21, 12, 6, 13, 22, 12, 15, 22, 17, 21, 18, 15,
+    20, 15, -7, -2, 4, -14, 0, 9, 0, -4, -7, -3, 20, 2, 3, 9, 10, -1, -7, 12,
+    29, 27, 11, 2, -16, 0, -12, 3, -7, 0, -15, -13, 10, 2, -16, -3, -2, -9, -20, 4,
+    15, 15, -1, -3, -23, -26, -18, -12, -6, 3, -14, -22, -2, -16, -9, -13, -23, -13, -9, -7,
+    27, 5, -7, -11, -28, -22, -34, -17, -22, -3, -16, -21, -10, -26, -23, -21, -30, -15, -22, -14,
+    21, 11, 15, -8, -13, -50, -30, -36, -21, -14, 3, -16, -20, -29, -37, -25, -26, -7, -11, -24,
+    21, -10, -7, -8, -38, -34, -48, -19, -28, -3, -11, -10, -13, -11, -6, -23, -6, -2, 5, -7,
+    6, -16, 1, -20, -25, -33, -33, -14, -10, -3, 17, -2, -5, -9, -10, 3, 3, -1, -2, 7,
+    23, 29, 22, 3, -18, -26, -23, -17, -12, 8, 5, -2, -6, -10, -3, 3, -8, -14, -5, -13,
+    11, 27, 26, 17, 11, 3, 4, 13, -4, 20, 11, 13, -2, 3, -6, -8, -11, 0, -2, -5,
+    24, 20, 13, -2, -4, 3, -1, -5, 11, 5, -3, -14, -8, -30, -21, -38, -38, -18, -33, -26,
+    21, -11, 6, -12, 6, -11, -9, -10, -5, 1, 3, -19, -5, 2, -24, -25, -16, -24, -8, -17,
+    -2, -22, -17, -17, -16, -27, -7, -5, -4, -3, -13, -7, -4, -8, -2, -20, -13, -10, 10, 1,
+    -3, -25, -39, -18, -34, -34, 3, -9, 3, -17, -25, -22, 6, -19, -15, -4, -12, 1, -6, 8,
+    -23, -63, -58, -40, -25, -10, -20, -2, -14, -16, -20, -1, 1, -14, -22, -7, -8, -10, 2, 6,
+    -33, -50, -57, -37, -16, -33, -13, -12, -15, -28, -13, -11, -18, -20, -11, -8, -4, 6, 12, -7,
+    -30, -45, -36, -25, -1, -8, -3, 5, -10, -14, -26, -14, -16, -19, -8, -5, -7, -1, -10, -1,
+    -37, -51, -49, -37, -14, -7, 6, -4, -2, -6, -15, -18, -6, -20, -12, -16, 5, -7, 15, 15,
+    -59, -77, -54, -42, -24, -2, -1, 14, 8, 9, -14, -4, -3, -8, -6, -9, 18, 19, 22, 16,
+    -55, -86, -77, -43, -7, -2, 16, 15, 30, 12, -11, -15, -11, -23, -7, 8, 10, 12, 19, 18,
+    -49, -63, -47, -30, -9, -3, 14, 10, 7, 14, -22, -36, -45, -37, -32, -24, -6, -19, -14, 5,
+    -21, -54, -55, -18, 6, 21, 14, 18, 28, 4, -16, -22, -22, -11, -26, -8, -3, -12, 5, 4,
+    -17, -50, -32, -10, 8, 9, 12, 24, 33, 19, -24, -40, -35, 3, -10, -6, -20, -18, -17, 7,
+    -17, -14, -23, 11, 32, 25, 33, 10, 23, 11, -16, -13, -11, 2, -16, 0, -9, -15, -13, 6,
+    -8, -29, -18, 16, 37, 40, 26, 16, 24, 34, -5, -22, -19, -8, -9, -15, -4, -4, -2, 14,
+    -3, -21, -12, 15, 31, 44, 26, 24, 34, 12, -5, -13, -16, -1, -6, 2, -18, -1, -2, 4,
+    21, -3, 12, 26, 39, 26, 30, 37, 28, 25, -6, -30, -5, -16, -20, 2, -13, -3, -7, 7,
+    47, 43, 58, 51, 49, 24, 20, 22, 27, 25, 5, -17, 4, 10, 2, 9, 4, 4, -6, 0,
+    // Hidden unit 20
+    -50, -25, -7, 3, -2, -8, -10, -37, -31, 2, 24, 64, -8, -11, 10, -7, -13, -17, -14, -9,
+    -26, -16, 3, 29, 28, 5, 21, 0, -19, 13, 29, 96, 18, 14, 45, 23, -1, 13, 4, 2,
+    -10, -22, 0, 10, 13, 3, 6, -2, -19, -8, 7, 94, 25, 7, 40, 10, -1, 18, 4, 0,
+    -30, -20, 20, 19, -25, -28, 11, -3, -18, -27, 22, 88, 3, 7, 32, 10, 12, 6, -3, -2,
+    -36, -37, 11, 16, -37, -31, 12, 5, -30, -20, 14, 61, -9, -10, 6, -10, -6, -3, -13, -16,
+    -41, -29, 12, 15, -7, -7, 21, 16, -6, 1, 21, 58, -1, -9, 36, 20, 15, 14, -12, -8,
+    -33, -15, 24, 10, -18, -9, 33, 30, 1, 11, 42, 73, 21, 4, 30, 16, 6, -14, -3, -21,
+    -31, -17, 2, 21, -12, 7, 17, 20, 8, 1, 31, 87, 45, 1, 42, 18, 19, 5, 5, -17,
+    -37, -19, 24, 15, -21, -20, -10, -20, -5, 18, 15, 47, 22, 27, 38, 32, 20, 16, 15, 8,
+    -33, -39, -3, -2, -34, -32, -32, -24, -25, -27, -21, 7, -23, -12, 14, 7, 15, 1, -2, 1,
+    -23, 4, 27, 9, -6, -6, 1, -25, -10, -37, -29, -5, -28, -19, -2, -5, -8, -20, -16, -8,
+    -29, -10, 35, 30, -8, -5, -3, -10, 6, -12, -6, -5, -21, -12, 1, -1, -8, -12, -10, -17,
+    -32, -16, 18, -4, -17, -5, 6, -8, 10, -15, -5, 6, -2, 15, 23, 4, 19, 21, 11, 2,
+    -18, -18, 6, -13, -10, -10, -9, -11, -4, -21, -45, -1, -28, -22, 1, 3, 6, 14, 18, 12,
+    -37, -32, 7, -14, -13, 9, 8, 5, 33, -10, -43, -16, -30, -17, -11, -13, -16, -13, -8, -14,
+    -19, 0, -12, -18, -8, 15, 6, 41, 42, -5, -48, -21, -36, 4, 10, -19, -9, -8, -1, -11,
+    -18, -16, -14, -31, 5, 18, 14, 29, 61, 2, -47, -20, -29, -19, -9, -6, -3, -16, -12, -9,
+    -3, -11, -8, -29, 12, 35, 11, 42, 51, 3, -44, -11, -27, -10, 4, 5, 11, 16, 11, 5,
+    -35, -41, -43, -53, -9, 7, 14, 25, 26, -11, -46, -15, -36, -4, -3, 5, -4, 1, -4, 10,
+    -34, -35, -41, -42, -14, 3, 4, 29, 22, -5, -25, -6, -30, -10, 19, 2, 1, 17, 4, 2,
+    -34, -17, -22, -30, -6, -5, 35, 41, 42, -15, -27, -18, -43, -7, 5, 5, -1, -6, -4, 12,
+    -37, -13, 8, 15, 23, 38, 36, 54, 37, -20, -18, 4, -11, 14, 37, 14, 6, -2, 9, 0,
+    -44, -4, -6, -3, 5, 8, 10, 20, 16, -24, -32, 10, -3, 1, 28, -2, 12, 7, -11, -4,
+    -39, 3, 3, 4, 6, 2, -1, 6, -8, -38, -25, 11, -17, 8, 6, -1, -22, -13, -30, -33,
+    -9, 13, 28, 16, 7, 9, 20, 24, -15, -32, -1, 38, -1, 16, 37, 10, -10, -9, -4, -19,
+    4, 26, 17, -9, 4, 10, -10, -10, -25, -41, 2, 62, 3, 14, 19, 3, -5, 8, -9, -3,
+    11, 16, 22, 4, -21, -18, -28, -37, -45, -30, -23, 55, -16, 1, 30, 9, 8, -15, -5, -16,
+    4, 29, 29, 5, -1, -19, -22, -28, -31, -39, -10, 45, -7, 8, 12, 7, -10, -5, -1, -10,
+    12, 20, 13, -13, -29, -33, -39, -37, -44, -40, -5, 53, -6, -5, 35, 2, 10, -6, 4, 0,
+    30, 33, 29, -10, -28, -20, -62, -43, -73, -33, 24, 58, 15, 0, 31, 9, 12, 9, -2, 1,
+    40, 17, 24, 9, -12, -21, -29, -45, -39, 3, 39, 65, 16, 35, 52, 28, 16, 27, 19, 18,
+    29, 41, 47, -2, -17, -34, -25, -43, -41, 10, 60, 60, 28, 27, 35, 18, 18, 21, 10, 6,
+    -9, -8, -3, -46, -27, -25, -20, -24, -35, 3, 1, 20, -8, 11, 25, -6, -8, -11, -2, -7,
+    -9, 3, -17, -40, -33, -11, -8, -33, -28, -11, 3, 4, -10, -4, 13, 6, 6, -12, -12, -12,
+    -4, 7, 4, -35, -16, -17, -17, -38, -29, -15, -8, -9, -8, 1, 11, -10, -8, -4, -2, 1,
+    -25, -14, -30, -42, -38, -28, -18, -37, -27, -9, -28, -9, -31, -11, 4, -3, -24, -12, -12, -22,
+    -20, 13, -5, -22, -8, -15, -14, -19, -14, -19, -14, 1, -3, -21, -2, -13, -23, -3, -19, -15,
+    -44, -28, -13, -7, -10, -9, 0, -18, -18, -15, -8, 0, -15, -12, -14, -12, 0, -12, -4, -11,
+    -56, -19, -17, -26, -13, -19, -30, -9, -23, -10, -8, 2, 5, -12, -1, -18, -16, -13, -7, -18,
+    -33, -4, -11, -7, -9, -27, -14, -8, -16, -16, -15, 8, -25, -2, -11, 0, -10, -12, -13, -14,
+    // Hidden unit 21
+    -28, -42, -50, -19, -12, -20, -1, -6, 16, 19, 49, 51, 7, -12, 4, 0, -13, -39, -40, -37,
+    -39, -40, -20, 10, 2, -10, -13, 0, -5, 16, 33, 42, 9, -20, -11, 6, -10, -30, -18, -36,
+    -23, -18, -3, 5, -4, -17, -8, -1, 12, 19, 18, 60, 1, -10, 8, 7, -4, -7, -19, -31,
+    -14, -16, -4, 24, -10, -23, -13, -8, 12, 19, 30, 61, 2, 3, -3, -3, -11, -23, -20, -27,
+    -33, -37, -2, 15, -32, -28, -1, -4, 16, 6, 35, 57, 6, -21, 1, 2, -12, -13, -33, -35,
+    -24, -32, 8, 4, -32, -38, -21, 2, -17, 4, 15, 43, 10, -28, -5, -22, -24, -9, -41, -43,
+    -13, -27, -8, 12, -40, -22, -11, -4, 1, -2, 4, 33, 4, -33, -3, -9, -14, -30, -26, -37,
+    2, -21, 8, 19, -27, -28, -7, 21, 0, 13, 24, 39, 12, -24, 8, 2, 1, -16, -24, -30,
+    9, 7, 19, 28, -4, -1, 27, 27, 39, 41, 43, 64, 15, 12, 22, 6, 11, 3, -12, -22,
+    -9, 6, 19, 20, -13, 3, 25, 20, 17, 26, 41, 46, 23, 23, 29, 11, 20, 8, 18, 24,
+    2, -8, 23, 19, -14, -11, 3, 16, 7, 16, 3, 33, 6, -7, 5, 5, 8, 7, 0, 3,
+    -7, 0, 10, 16, -9, -15, 14, -5, 10, 3, -5, 12, -5, -19, 5, -14, -22, 2, 2, -9,
+    1, -5, 7, 3, 0, 1, 23, -12, 12, -5, -3, 7, -16, -12, -3, 5, 4, -14, -17, 3,
+    -10, 8, 8, 3, -9, -4, 10, -15, -5, 5, -7, 23, -21, -14, 13, 22, 6, -4, 8, 19,
+    -7, -16, -9, -9, -19, -9, 20, -5, 1, -7, -8, 0, -30, -4, 18, 8, 6, 18, 14, 3,
+    -9, 6, 3, -10, -9, -3, 18, 9, 17, 14, -8, 15, -18, -10, 5, 12, 10, 16, 4, 16,
+    -12, -1, 5, -6, -1, 1, 23, -6, 4, -8, -4, 18, -23, -9, 19, 20, 30, 9, 17, 19,
+    -9, -4, -3, -14, 11, 24, 39, 8, 4, -14, -5, 22, -19, -6, 24, 15, 2, 15, 13, 4,
+    -15, -9, -12, -8, 7, 27, 23, -6, 11, -16, -12, -2, -10, -32, 10, -10, 2, 0, -2, 2,
+    -20, -7, -15, -19, -2, 6, 24, -14, -10, -8, -27, -11, -32, -30, -17, -19, -7, 1, -18, -10,
+    -25, -22, -22, -42, -14, 5, 14, -6, 2, -22, -27, -14, -44, -35, -8, 2, 7, 5, -7, -2,
+    -13, -27, -30, -15, -11, 16, 30, 10, 6, -21, -3, -9, -36, -24, 2, -7, -5, -9, -13, -3,
+    -15, 0, -20, -25, -11, 13, 3, -6, 6, -19, -11, 13, 3, -10, 20, 24, 29, 11, 28, 23,
+    -10, -8, -25, -10, 0, 30, 9, -12, 7, -2, -11, 21, -7, -7, 1, 21, 10, 23, 4, 4,
+    -13, 15, -6, 4, 8, 29, 31, 9, 14, -8, 0, 2, -10, -9, 4, -9, 3, -18, -23, -16,
+    -4, 23, 15, 6, -4, 16, 7, 16, 5, -2, 11, 13, 1, -3, 5, 7, 2, -2, -13, -23,
+    8, 28, 9, -7, 9, 11, 12, 21, -4, -12, 6, 12, -6, -15, 19, 23, 12, -1, -9, 1,
+    0, 25, -5, -6, -8, 10, 11, -3, -4, -6, 8, 31, -13, -7, 12, 25, 22, 0, 5, 5,
+    11, 17, -4, -14, -18, -18, -13, -15, -15, 8, -14, 25, -9, -7, 11, 19, 16, 4, 0, -11,
+    30, 31, 2, -9, -15, -17, -8, -32, -25, -2, -1, 16, -13, -11, 15, 23, -1, 7, -12, -4,
+    13, 22, 14, -21, -34, -24, -24, -25, -30, -2, -11, 17, -27, -34, 12, 5, -3, -3, -11, -4,
+    30, 41, 31, -21, -50, -45, -24, -35, -49, -9, -17, 13, -27, -13, -3, 1, -9, -5, -11, -17,
+    34, 35, 24, -5, -33, -17, -11, -23, -27, -21, -14, 18, -13, -11, 27, 3, 4, 5, 2, 8,
+    33, 33, 6, -18, -31, -9, -3, -12, -29, -12, -2, 29, -16, -10, 12, 6, 13, 10, 9, 5,
+    25, 33, 22, -2, -16, -13, -13, -20, -33, -17, 4, 14, -4, 2, 11, 16, 14, 12, -4, 7,
+    37, 31, 22, 7, -3, -13, 4, -14, -4, 7, -1, 21, -12, -2, 6, 13, 8, 11, 4, 0,
+    42, 42, 23, 3, 1, -1, 3, -4, 6, 10, 22, 18, -6, 3, 12, 22, 3, -5, 5, -17,
+    31, 28, 30, 7, -5, 10, 4, -11, -3, 1, 18, 34, 9, -1, 13, 18, 3, 15, -8, -16,
+    21, 33, 13, -2, -15, 11, 1, 14, -9, -9, 6, 24, -5, 1, 15, 8, 1, -2, 5, -9,
+    -9, 1, -10, -26, -10, -3, -5, -1, -22, -18, -9, 17, -18, -10, -9, -10, 8, -16, -13, -9,
+    // Hidden unit 22
+    -23, -6, 15, 43, 32, 13, 24, 22, 23, 52, 89, 108, 48, 15, 19, 8, -4, -16, -33, -37,
+    -17, -15, 27, 64, 55, 12, 0, 13, 22, 38, 48, 75, 22, -5, 2, 14, -10, -7, -16, -15,
+    -10, 1, 38, 76, 31, 6, -8, 8, 13, 32, 41, 88, 30, 9, 27, 17, 8, 1, -18, -10,
+    -4, -8, 56, 87, 24, -13, -8, 30, 20, 22, 36, 69, 37, 1, 16, 26, 5, -5, 1, -6,
+    -20, 9, 59, 84, -15, -5, 2, 7, 11, 6, 28, 68, 18, -1, 11, 9, 10, 1, -9, -24,
+    -23, -19, 55, 57, -22, -32, -30, -11, -14, -32, 3, 37, -6, -9, 2, 4, 10, 5, -4, -4,
+    -21, -3, 49, 44, -20, -34, -28, -19, -16, -35, -27, 9, -20, -19, 2, -9, -5, -16, -23, -20,
+    -1, -12, 41, 41, -29, -9, -1, -10, -38, -37, -20, 5, -15, -13, -18, 0, 6, 11, -10, -14,
+    -2, -13, 29, 38, -24, 7, -7, -20, -24, -23, -20, -4, -20, -19, 4, 5, -2, 2, 0, 3,
+    -15, -5, 20, 13, -46, -7, -16, -12, -22, -23, -41, -22, -24, -15, -7, 7, -3, 20, 7, 30,
+    -16, -3, 7, -2, -41, 0, 10, -15, -11, -20, -31, -20, -20, -29, 14, 15, 22, 10, 23, 23,
+    -5, -13, -3, -35, -47, -5, 17, -21, -6, -15, -12, 0, -29, -31, -8, -11, 1, 12, 14, 9,
+    -1, 2, -13, -45, -33, 17, 17, 3, 6, -14, -38, -7, -23, -16, -9, -10, 2, 2, 4, 19,
+    -10, -9, -40, -41, -22, 22, 35, -14, 14, -3, -27, -17, -23, -26, 12, 7, 1, 11, 14, 25,
+    -9, -13, -54, -54, -18, 11, 43, 6, 17, 9, -28, -23, -30, -28, -10, 12, 24, 8, 21, 15,
+    -12, -4, -45, -37, -9, 12, 27, 10, 31, 7, -20, -1, -24, -32, 9, 11, 5, 25, 28, 7,
+    -31, -23, -23, -31, 21, 32, 43, 8, 8, 7, -28, -9, -38, -23, 2, 16, -2, 3, 24, 10,
+    -17, -15, -33, -21, 45, 48, 44, 25, 21, 3, -34, 13, -22, -18, -1, -3, -2, -2, 12, 24,
+    -19, -15, -21, -10, 31, 42, 34, 10, 8, -13, -20, -2, -27, -24, -7, -5, -5, -4, -9, 6,
+    -26, -22, -25, -13, 29, 39, 38, 16, -1, -7, -5, -2, -42, -27, -15, -5, -4, 5, -27, -11,
+    -45, -9, -13, 2, 27, 26, 41, 17, 13, -3, -11, 4, -19, -40, -16, 1, 7, 0, -14, -12,
+    -22, -3, -20, -8, 1, 33, 26, 10, 12, -6, 19, -3, -19, -13, -6, 1, 5, -4, -30, -25,
+    -22, 19, 8, -9, 5, 21, 12, 4, -1, -18, -1, 7, -7, -20, 5, -16, -19, -15, -27, -24,
+    4, 39, 14, 2, -6, 6, 1, -21, -2, -16, 6, 15, -10, -6, -7, 5, 1, -17, -15, -13,
+    14, 47, 17, 4, -19, -1, -16, -23, -24, -6, 19, 28, -12, -17, -4, -5, -1, 2, -28, -10,
+    20, 54, 31, -2, -44, -15, -17, -25, -23, -22, 19, 22, -11, -7, 4, 5, -5, -2, 3, -9,
+    39, 66, 17, -4, -33, -35, -18, -22, -31, -13, 21, 14, -18, -25, -8, 16, 2, -8, -7, -1,
+    26, 65, 18, 1, -30, -41, -14, -25, -28, 4, 20, 25, -2, -17, -3, 0, -2, 9, -8, -5,
+    31, 70, 30, -5, -41, -38, -46, -38, -48, -3, 4, 25, -14, -30, 5, 12, -10, -11, 2, -17,
+    47, 69, 44, 17, -13, -15, -23, -32, -40, 4, 2, 30, -12, -19, 5, 0, 10, -8, 9, -4,
+    52, 71, 62, 32, -19, -21, -9, -33, -32, 11, 11, 35, 1, -10, 18, 16, -5, -3, 3, 8,
+    43, 51, 43, 9, -30, -9, -1, -18, -36, 20, 7, 14, -8, -3, 15, 12, -1, -10, 19, -8,
+    28, 21, 5, -27, -22, -1, -10, -30, -22, -9, -8, 13, -24, -11, 7, -4, 4, 9, 8, -5,
+    7, -6, -14, -30, -21, -11, 7, -22, -20, -4, -5, 12, -16, -20, -3, 1, 1, 1, 5, -1,
+    1, 9, -23, -20, 5, -12, 0, -18, -29, 4, -12, 21, -18, -16, 12, -1, 15, -5, -1, 4,
+    -7, -8, -8, -31, 0, 7, 1, 6, -23, 0, -20, 13, -2, 2, 3, 12, 8, 1, -3, -25,
+    -9, 4, 3, -33, 2, 10, 14, -1, -10, 5, -2, 21, -3, -10, 4, 20, -4, -3, -10, -17,
+    -9, 3, 2, -10, -15, -2, 15, -9, -10, 11, 0, 3, -3, -9, -1, 5, -5, 6, -7, -9,
+    -24, -15, 2, -20, -13, 6, 21, -2, -8, -1, -4, 15, -23, -7, -1, 6, 10, 11, 16, 6,
+    -22, -11, -19, -21, -16, -2, 7, -8, -11, -17, -3, 12, -12, -22, -10, -5, 3, 1, 8, 0,
+    // Hidden unit 23
+    -10, 9, 8, -19, -19, -15, 10, -5, -15, -23, -33, -52, -23, -26, -14, -6, -21, 8, -2, -8,
+    -1, 5, -18, -31, -35, -20, -4, 18, -6, -27, -17, -36, -25, -13, -11, -20, -15, 6, 2, -10,
+    -20, -12, -25, -40, -25, -18, 1, 7, -10, -11, -37, -44, -34, -21, -20, -12, -4, -10, 0, 5,
+    -26, -14, -38, -52, -31, -6, -6, 1, -3, -7, -19, -32, -23, -11, -13, -1, -3, -4, 12, -6,
+    -21, -29, -44, -47, -12, -19, -31, -13, -19, -19, -26, -43, -30, -12, -9, -11, -1, 1, 4, 5,
+    -15, -27, -44, -60, -27, -20, -17, -8, -11, -24, -25, -34, -16, -4, 8, 4, 14, 21, 17, 35,
+    -19, -32, -38, -35, -23, -8, -24, -20, -5, -21, -16, -15, -21, 4, 7, 24, 32, 34, 29, 50,
+    -15, -28, -44, -29, -2, -3, 6, -11, 8, -5, -9, -4, -1, 32, 33, 44, 59, 58, 75, 78,
+    -23, -23, -44, -24, -15, -11, -5, 3, -11, -18, -6, -5, 11, 29, 41, 52, 71, 70, 68, 86,
+    -30, -9, -45, -39, -27, -22, -17, -14, -12, -14, -4, 1, 8, 33, 37, 43, 64, 58, 76, 75,
+    -6, -10, -21, -30, -5, -27, -7, -4, -4, -5, -5, 10, 24, 47, 47, 54, 70, 76, 83, 78,
+    5, -2, -9, -19, 8, -18, -22, -3, -20, -9, 9, -5, 8, 37, 29, 46, 57, 44, 49, 44,
+    25, 5, -8, -1, -4, 6, 2, 24, 0, 12, 19, 9, 43, 44, 35, 45, 38, 47, 47, 54,
+    39, 4, 20, 14, 21, 2, -6, 5, 22, 24, 3, -2, 37, 25, 22, 10, 18, 24, 35, 23,
+    38, 19, 39, 25, 13, 3, 3, 28, 15, 7, 26, 2, 12, 18, -6, -1, 9, 10, 14, 21,
+    50, 41, 52, 32, 32, 33, 6, 20, 20, 17, 6, -8, 6, 13, 4, -2, -11, -6, -9, 14,
+    37, 34, 38, 43, 25, 29, 11, 9, 15, 26, 19, -4, 5, 9, -4, -7, -13, -2, -11, -4,
+    35, 49, 54, 41, 19, 4, -6, 16, 13, 7, 11, -8, 8, 17, -3, -9, -21, -1, -10, 1,
+    43, 45, 47, 50, 17, 3, -5, 10, 23, 11, 0, -6, -8, 0, -10, -20, -2, -12, -9, -1,
+    38, 32, 42, 27, 21, 6, -11, 7, 1, 19, 3, -12, -16, -12, -5, -25, -11, -19, 0, -23,
+    44, 37, 58, 34, 33, 13, 12, 6, 22, 19, 19, -9, 15, 22, -5, 5, -2, -15, 6, -15,
+    23, 7, 12, 17, 15, 11, -10, -8, -5, 6, -2, 2, 9, 11, -13, -11, -15, -7, 3, 6,
+    1, -11, 6, 2, -1, -22, 0, -19, -18, 1, -4, -14, -5, -23, -8, -21, -11, -14, -18, -1,
+    -16, -19, -19, -9, -8, -17, -14, -11, -22, -14, -13, -16, -17, -6, -21, -17, -10, -23, -6, -14,
+    -23, -37, -8, -30, -28, -32, -2, -12, -28, -34, -11, -22, 2, -12, 4, 2, 8, 11, 19, 20,
+    -6, -20, -31, -32, -22, -30, -5, -25, -12, -7, -15, -14, 5, -18, -6, -7, 0, -7, 17, 15,
+    10, -11, 9, 0, -11, -25, -17, -3, -18, -2, -7, 1, 7, -2, -9, -1, 7, 14, -4, -1,
+    15, -13, 12, 6, -7, -20, -14, -7, -15, -14, 7, -3, -1, 7, -3, -1, -10, 1, -8, 10,
+    13, -13, 6, 11, -3, -1, 2, 17, -5, -18, -17, -3, -6, -10, -24, -23, 0, -14, 5, 11,
+    3, 2, 9, 7, -7, -16, -4, 7, 8, -7, -13, -22, 12, 10, -2, -19, 4, -5, 8, 10,
+    -12, -8, -3, 18, 9, -12, 10, 18, 22, 7, 0, -2, 8, -3, -3, -11, -2, -2, -6, 5,
+    -12, -13, -12, 17, 17, 19, 22, 35, 36, 5, -8, -16, -4, 2, 2, -15, -4, 1, -16, 1,
+    1, -19, 9, 16, 16, 3, 7, 17, 7, 15, -11, -33, -18, -14, -19, -12, -9, -13, -14, -14,
+    21, 2, 14, 0, 10, 11, -4, 27, 22, 7, -1, -21, -14, -27, -31, -28, -11, -7, -22, -4,
+    15, 12, 18, 12, 17, 14, 3, 13, 16, 2, 11, -28, -11, 5, -17, -24, -22, -5, -4, -7,
+    16, 1, 22, 9, 19, 17, 9, 13, 16, 17, -10, -29, -11, -17, -12, -17, -12, -17, -3, -5,
+    -4, 3, -6, 21, 19, 19, 5, 10, 20, 8, 1, -18, -11, -9, -7, 3, -17, -11, -1, -10,
+    -1, -19, -9, 15, 7, 16, 3, 26, 25, 7, -18, -17, -9, -2, -13, -2, -2, -1, 6, 13,
+    7, -19, -12, 8, 22, 2, 8, 7, 16, 9, -5, -34, -15, -7, -14, -6, -6, -1, 0, 0,
+    38, 23, 9, 13, 13, 12, -6, 6, 21, 15, -5, -10, -13, -12, -12, -1, -10, -5, 4, 14,
+    // Hidden unit 24
+    -29, -14, 6, 39, 43, 20, 24, 11, 25, 63, 82, 108, 45, 17, 6, -1, -3, -16, -27, -27,
+    -20, -6, 36, 64, 49, 11, 17, 7, 25, 60, 58, 84, 17, 5, 6, 15, -16, -15, -31, -21,
+    -29, 4, 29, 92, 24, 10, 11, 8, 18, 42, 57, 91, 24, 3, 26, 15, 15, -6, -13, -22,
+    -24, 6, 58, 86, 16, 4, -2, 17, 8, 36, 34, 89, 36, 17, 30, 8, 7, -10, 2, -21,
+    -27, 5, 63, 89, -14, -27, -6, 17, -4, -3, 30, 71, 23, -5, 16, 22, 3, -1, -10, -17,
+    -13, -9, 48, 60, -23, -34, -28, -6, -7, -20, 9, 41, -7, -17, 5, 2, 2, 9, -1, -19,
+    -14, -14, 45, 60, -27, -16, -15, -8, -15, -36, -22, 25, -20, -23, -13, 1, -11, -17, -13, -17,
+    -5, -8, 58, 31, -26, -4, -5, -12, -40, -43, -26, 24, -22, -19, -12, 6, -4, -2, -9, -13,
+    -2, -4, 24, 37, -16, -6, -12, -23, -9, -17, -31, 7, -20, -28, -2, 6, 17, 10, -7, 8,
+    -17, -4, 13, 8, -43, -20, -19, -19, -23, -28, -24, -5, -20, -18, -2, -2, 14, 6, 10, 9,
+    -11, 6, 5, -19, -37, -9, -3, 2, -16, -8, -31, -23, -31, -27, 10, 14, 10, 13, 11, 33,
+    12, -4, -18, -26, -37, -9, 17, -19, 4, -13, -12, -11, -30, -27, -14, -2, -3, 14, 0, 22,
+    1, 1, -30, -35, -43, 12, 17, -11, 5, -4, -24, -13, -22, -28, 2, -5, -11, -10, 10, 24,
+    1, -4, -55, -52, -23, 7, 42, -8, 9, 5, -16, -6, -31, -25, 10, 0, 5, 13, 9, 15,
+    -3, -16, -52, -53, -7, 13, 43, 9, 28, 1, -33, -17, -23, -33, -4, 12, 5, 18, 19, 20,
+    -15, -11, -38, -51, -1, 11, 37, 20, 29, -1, -35, -3, -41, -19, 10, 10, 12, 3, 23, 25,
+    -22, -7, -31, -21, 22, 35, 54, 11, 11, -5, -31, -8, -37, -27, 11, -1, 9, 15, 22, 13,
+    -29, -2, -36, -43, 26, 52, 52, 22, 8, -2, -16, 3, -28, -21, 16, 0, 5, 5, 13, 19,
+    -33, -5, -30, -4, 43, 51, 40, 11, 16, -2, -28, -3, -30, -24, -12, -7, -7, -7, 3, -1,
+    -33, -16, -20, -5, 28, 38, 37, 22, -3, 4, -27, -4, -26, -34, -3, -12, -7, 2, -26, -6,
+    -34, -19, -24, -8, 23, 47, 40, 20, 8, -9, 4, 8, -44, -25, -1, -9, 1, -17, -27, -15,
+    -34, -3, -19, -3, 10, 37, 36, 4, 9, -5, 2, 0, -34, -16, -12, -1, 8, 5, -17, -25,
+    -15, 17, 6, -7, 2, 27, 17, -9, -3, -2, -10, 26, -7, -24, -6, -5, -8, -7, -9, -29,
+    0, 33, 24, 6, -7, 14, -9, -7, -6, -19, 17, 24, -22, -14, 3, -7, -7, -14, -27, -24,
+    25, 55, 29, 15, -13, 3, -9, -23, -22, -19, 2, 12, -1, -11, -9, 4, -6, 0, -21, -21,
+    13, 48, 27, -7, -34, -28, -32, -36, -32, -22, 7, 11, 2, -7, -7, 11, -9, 1, 2, -2,
+    30, 72, 34, 1, -43, -34, -16, -45, -36, -17, 6, 21, 2, -28, -6, 16, -3, -7, 12, -20,
+    29, 63, 37, 16, -40, -42, -22, -39, -47, -10, 11, 22, -2, -10, -8, -7, 14, 1, 6, -7,
+    51, 77, 38, 2, -45, -38, -40, -48, -44, 1, 5, 23, -8, -25, 12, 9, -8, -1, -8, -9,
+    60, 74, 41, 24, -20, -31, -31, -28, -49, -6, -2, 35, -16, -13, 19, 5, 0, -1, 11, -10,
+    54, 82, 54, 14, -1, -11, -16, -46, -39, 8, 23, 39, -6, -14, 7, 16, 12, 2, 5, -6,
+    57, 57, 38, 4, -24, -14, -20, -26, -22, 9, 15, 35, -22, 2, 7, 14, 7, 9, 16, -7,
+    21, 36, -11, -21, -22, -14, -6, -17, -34, 7, 7, 21, -26, -27, 14, 9, 7, 0, 11, -13,
+    -3, 10, -9, -18, -25, -5, 0, -2, -36, 4, -11, 4, -25, -19, -3, 3, 8, -7, 11, -17,
+    5, 3, -12, -32, 6, -8, -1, -6, -15, 5, 0, 10, -19, -9, 4, 3, 11, 3, -1, -11,
+    -3, -8, -14, -26, 2, -2, 3, 1, -12, 12, -4, 14, -23, 0, 7, 4, 11, -11, -13, -20,
+    -10, 3, -20, -23, -11, 0, 21, -2, -9, 5, -1, 20, -5, -14, 6, 7, 1, 2, -1, -18,
+    -14, -11, -10, -13, 5, 8, 21, -8, -21, 12, -4, 9, -4, -20, -6, 3, 7, 3, -6, -13,
+    -13, -13, -17, -36, -2, 8, -1, 2, -6, -5, -14, 29, -17, -26, 0, 13, -4, -6, 12, -6,
+    -18, -14, -17, -31, -15, 1, 13, -6, -3, -18, -14, 11, -29, -12, -19, -1, 11, 7, 12, 4,
+    // Hidden unit 25
+    -6, -15, -7, 4, 6, 8, -16, -35, -11, -20, -37, -58, 7, 31, 5, 19, 41, 47, 57, 63,
+    11, -7, 0, -12, 14, 9, -28, -31, -10, 11, 1, -44, 15, 37, 0, 30, 28, 38, 35, 37,
+    8, -4, -4, -5, 20, 22, -22, -30, -18, 18, -14, -48, 34, 26, 9, 20, 7, 20, 31, 46,
+    8, 3, -1, 19, 38, 26, -6, -19, 1, 28, 14, -36, 45, 52, 9, 10, 0, 39, 24, 35,
+    29, 10, 17, 16, 64, 61, 5, -34, -3, 27, -7, -42, 23, 61, 20, 16, 17, 32, 34, 30,
+    13, 42, 21, 33, 73, 62, 3, -20, -14, 36, 7, -51, 30, 49, 12, 13, 10, 33, 40, 41,
+    28, 17, 22, 32, 70, 38, 1, -29, -23, 16, 6, -32, 18, 48, 25, 12, 11, 38, 57, 51,
+    17, 21, 22, 38, 58, 27, -6, -34, -13, 28, 8, -44, 40, 53, 16, 19, 32, 22, 37, 71,
+    -1, 20, 23, 22, 48, 21, -4, -33, -18, 16, 12, -20, 35, 42, 22, 13, 29, 29, 25, 43,
+    -2, 4, 8, 23, 53, 18, -20, -39, -31, 9, 30, 2, 36, 55, 21, 20, 6, 10, 8, 15,
+    1, -20, -11, -4, 36, 0, -27, -39, -15, 2, 16, 0, 46, 42, -2, 3, -18, 1, -4, 4,
+    -14, -26, -4, -20, 19, -1, -26, -11, -17, -4, 22, -7, 31, 49, 1, 11, 3, 5, 6, 19,
+    -16, -30, -8, -26, 11, 9, -23, -30, -21, 6, 27, -26, 28, 38, 10, 17, 16, 17, 8, -8,
+    -22, -39, -22, -15, 1, -15, -23, -15, -27, -9, 12, -12, 41, 29, 10, 13, -5, 4, -7, -13,
+    -22, -27, -19, -1, 18, 3, -25, -30, -13, 7, 47, -6, 46, 43, -1, 2, 7, 5, 0, -11,
+    -24, -34, -1, 11, 33, 11, -25, -15, -35, 8, 20, -6, 53, 46, -1, -7, -3, 0, -3, -10,
+    -7, -23, 1, 28, 30, -1, -21, -15, -15, -9, 11, -27, 46, 52, -4, 16, 8, 4, 8, 13,
+    -17, -22, -2, 29, 7, 4, -26, -19, -10, -2, 15, -13, 56, 64, -13, 6, 5, 9, 14, 15,
+    -9, -21, 20, 42, 30, -3, -23, -3, -14, -1, 11, -15, 58, 34, 10, -11, -14, -21, -11, -14,
+    11, -2, 27, 46, 30, 9, -22, -3, -5, -2, -1, -18, 33, 47, -20, -2, -19, -40, -9, -20,
+    16, -11, 23, 51, 38, -11, -35, -18, -12, 3, -13, -4, 49, 39, -2, -8, -18, -21, -10, -22,
+    18, -6, 33, 37, 45, -3, -21, -8, -12, -1, 0, -16, 39, 30, -9, -27, -31, -24, -4, -28,
+    16, 5, 46, 57, 47, -1, -8, 7, -3, 8, -12, -20, 34, 31, -14, -17, -34, -36, -6, -19,
+    27, 0, 36, 63, 65, 22, 9, 9, 12, 22, 3, -20, 27, 31, -5, -19, -25, -29, -10, -12,
+    -5, 3, 13, 46, 44, 22, 12, 1, 24, 11, -18, -35, 33, 37, -9, -24, -20, -10, 15, -5,
+    10, -16, 3, 50, 54, 10, 2, 2, 13, 8, -18, -39, 16, 26, -2, -7, -6, -20, -13, -5,
+    5, -29, 12, 22, 39, 26, 4, -2, 22, 14, -18, -44, 21, 26, -14, -21, -4, -21, -9, -7,
+    -4, -20, 5, 33, 60, 19, 16, 27, 22, 16, -13, -37, 18, 16, -21, -15, -23, -16, -18, -11,
+    -8, -12, -8, 24, 31, 41, 21, 14, 23, 3, -9, -67, 1, 32, -28, -40, -43, -33, -17, -1,
+    -28, -40, -23, 15, 46, 38, 35, 34, 27, -12, -20, -61, -1, 10, -40, -34, -40, -31, -39, -27,
+    -36, -32, -23, 23, 33, 40, 17, 23, 14, -14, -23, -70, 5, 12, -34, -53, -45, -37, -50, -27,
+    -30, -35, -33, 31, 46, 26, 3, 33, 28, -3, -40, -77, 6, 9, -30, -38, -37, -17, -21, -12,
+    -24, -34, -16, 45, 35, 20, 8, 18, 9, -9, -25, -52, 15, 16, -24, -25, -30, -8, -30, -8,
+    -26, -39, 4, 36, 12, 2, -11, 0, 12, -5, -15, -46, 4, 10, -33, -26, -8, -22, -17, -7,
+    -39, -26, -19, 20, -4, 5, -13, 5, -2, -19, -18, -28, -2, 9, -25, -20, -14, -10, -16, -14,
+    -26, -25, -14, 26, 9, 0, -10, -6, -3, -23, -18, -40, 9, 10, -16, -24, -16, -12, -22, -10,
+    -28, -28, -21, 13, -19, -16, -22, -25, -9, -21, -38, -44, -6, 7, -22, -27, -38, -9, -9, -5,
+    -36, -48, -37, -1, -23, -31, -28, -21, -27, -25, -36, -40, -15, -19, -39, -33, -38, -28, -21, -7,
+    -48, -51, -53, -41, -48, -39, -48, -44, -43, -44, -34, -75, -39, -16, -49, -58, -58, -53, -42, -35,
+    -46, -63, -36, -49, -54, -51, -56, -61, -44, -31, -23, -59, -30, -33, -49, -55, -51, -48, -52, -41,
+    // Hidden unit 26
+    -14, -16, -14, 27, 22, 9, 2, 5, 19, 59, 68, 84, 38, 7, 4, 14, -11, -28, -24, -24,
+    -32, -17, 9, 38, 30, 12, -4, -4, 17, 35, 43, 58, 22, -3, 3, 9, 1, -14, -34, -24,
+    -25, -15, 11, 53, 17, 3, -4, 10, 20, 23, 50, 69, 23, 1, 17, -7, 1, -6, -12, -22,
+    -19, -8, 43, 61, 4, -17, -10, 22, 28, 33, 41, 65, 30, -8, 27, 15, 10, -8, -5, -25,
+    -16, -4, 29, 76, -9, -6, 9, 28, 25, 37, 48, 75, 29, 8, 12, 9, 8, -17, -16, -26,
+    -14, -18, 45, 53, -24, -12, -7, 17, 25, 36, 52, 82, 33, 3, 25, 10, 8, -1, 0, -23,
+    -9, 3, 51, 52, -9, 6, -3, 10, 11, 22, 47, 80, 21, -1, 17, 7, 16, -3, -19, -2,
+    -1, 3, 45, 41, -6, -5, 21, 34, -3, 3, 22, 70, 32, 12, 7, -3, 11, 3, -13, -21,
+    1, -13, 20, 45, -17, -10, -4, 12, -11, 5, -8, 40, -5, -12, -8, 11, 2, 6, -4, -12,
+    -7, -20, 25, 18, -25, -7, -18, -15, -10, 3, -14, -12, -12, -25, -1, 0, -13, 15, -2, 0,
+    -1, -9, 1, 10, -37, 1, 2, -24, -20, -22, -27, -10, -24, -32, -5, -3, 3, 13, 7, 11,
+    0, -14, 13, -1, -39, -17, 9, -25, -16, -15, -8, -11, -28, -21, 4, -7, -7, -12, 8, 4,
+    -6, 3, 0, -5, -17, -8, 25, -20, -14, -22, -12, -6, -32, -30, -1, -1, 5, 4, 10, 20,
+    -8, -3, -18, -16, -28, 17, 29, -22, -3, -15, -8, 6, -34, -32, 10, -2, 10, 4, 4, 23,
+    -13, -12, -24, -18, -13, -1, 39, -10, 7, -2, -22, 2, -16, -17, -7, 6, 16, 1, 18, 12,
+    -9, -8, -32, -37, -13, 22, 29, 0, 9, 3, -24, -12, -24, -31, -10, -6, 4, 11, 23, 8,
+    -20, -23, -16, -20, 9, 21, 35, 10, 6, 3, -21, -6, -15, -36, -3, 9, 13, 9, 0, 9,
+    -25, -9, -23, -45, 11, 28, 45, 1, 6, -15, -36, 6, -34, -23, 9, 2, 15, -2, -2, 2,
+    -35, -14, -16, -28, 14, 28, 39, 0, -5, -12, -22, 4, -18, -29, -1, -9, 5, -1, 0, 13,
+    -28, -6, -26, -30, 27, 27, 41, 14, -3, -1, -15, -7, -36, -30, -6, 12, 12, 0, -3, -5,
+    -25, -13, -18, -21, -2, 30, 46, 21, -3, -4, -10, -5, -38, -27, -10, 4, 18, 24, 6, 5,
+    -16, -22, -20, -17, 11, 35, 25, 0, 19, 1, 1, 2, -34, -15, 11, -12, 6, -1, -9, 1,
+    -14, 1, -10, -11, 16, 24, 20, 4, -4, -21, -1, 5, -17, -21, -8, 1, -5, -13, -13, -15,
+    -7, 35, 14, 0, 13, 27, 17, 1, -8, -16, -3, 11, -35, -21, 0, -11, -12, -1, -36, -16,
+    17, 42, 6, 7, 5, 22, -1, -2, -1, -9, 9, 7, -3, -2, 3, 0, -3, -8, -31, -26,
+    11, 31, 18, -7, 5, 13, -18, -14, -19, -19, -1, 8, 1, -24, 4, -7, -14, 5, -12, -17,
+    11, 42, 29, 5, -7, -11, -12, -10, -17, -11, 0, 14, -24, -25, -11, 7, -8, -10, 2, -22,
+    24, 40, 7, 8, -26, -7, -18, -19, -33, -9, -6, 22, -2, -25, -6, 5, -2, -5, -15, -8,
+    17, 48, 10, 3, -38, -43, -33, -44, -48, -14, -3, 31, -15, -18, 1, -4, 0, -9, 4, -13,
+    45, 57, 34, 8, -28, -40, -26, -48, -47, -11, 9, 22, -22, -12, 7, -2, 2, 8, -1, -10,
+    59, 77, 42, 4, -27, -13, -23, -27, -26, -8, 22, 36, 2, -16, 13, 16, -1, 15, 7, -6,
+    39, 78, 46, 9, -24, -14, -14, -25, -36, 19, 21, 35, -3, -4, 2, 8, 9, -12, 14, -6,
+    33, 34, 25, -18, -25, -17, -11, -15, -20, 2, -2, 32, -15, -24, 13, 12, -8, 2, 6, -16,
+    28, 29, -2, -10, -10, -17, 3, -11, -42, -10, -5, 14, -23, -17, 11, 9, -9, -1, 14, -3,
+    6, 31, 17, -8, 2, -5, -10, -8, -25, 0, 9, 28, -12, -15, 7, 14, 10, 8, -4, -5,
+    23, 26, 6, -32, -5, -17, -10, -18, -10, 7, -16, 8, -18, -8, 5, 9, 12, -3, 1, -21,
+    9, 27, 8, -26, -14, -10, 9, -14, -20, -3, -1, 8, -10, -7, 8, 14, -4, 0, -13, -15,
+    0, 0, -7, -21, -25, -5, 16, -11, -4, 1, -9, 3, -12, -15, -14, -5, -10, -3, -9, -20,
+    -17, 1, -19, -37, -27, 8, 6, -15, -15, -14, -18, 5, -27, -17, -1, 5, -2, 5, -3, -2,
+    -39, -29, -30, -33, -27, 1, 19, -5, -13, -20, -12, 8, -14, -28, -15, 8, 13, 9, 3, 6,
+    // Hidden unit 27
+    14, -35, -71, -67, -62, -26, 0, -7, 16, -3, 22, 15, 6, -13, -16, -8, -19, -14, -16, -4,
+    6, -32, -42, -39, -31, -8, 12, 8, 15, 9, 1, 3, -7, -12, 0, -9, -14, -6, -28, -26,
+    13, -30, -58, -57, -25, -19, -9, -2, 7, 0, 15, 16, -10, -4, -2, 4, -2, -9, -31, -19,
+    -7, -5, -47, -54, -42, -13, 12, 14, 22, 43, 30, 45, 18, -11, 0, -15, -7, -14, -27, -27,
+    11, -15, -51, -27, 3, 18, 36, 37, 49, 54, 50, 74, 48, 9, 5, 6, -17, -11, -21, -23,
+    -7, -25, -38, -23, -18, 11, 12, 25, 30, 53, 49, 68, 46, 12, -8, -3, 0, -9, -30, -24,
+    -15, -21, -31, -9, -7, -11, 15, 24, 36, 32, 46, 55, 37, -6, -6, -12, -11, -23, -25, -28,
+    -37, -39, -42, -18, -6, -1, 12, 39, 36, 34, 65, 64, 27, -13, 1, -9, -7, -28, -42, -37,
+    -14, -12, 2, 20, 15, 16, 15, 43, 51, 59, 78, 85, 34, 14, 10, -10, -3, -31, -44, -30,
+    9, 11, 19, 42, 19, 10, 30, 48, 41, 56, 61, 73, 43, 34, 23, 15, 16, -14, -20, -27,
+    -4, -17, 15, 55, 10, -5, 25, 40, 18, 38, 60, 64, 20, 18, 22, 21, -5, -2, -10, -32,
+    -19, 0, 19, 37, 7, -5, 21, -3, 7, 8, 26, 36, 14, -2, 14, 9, -8, -4, -2, -11,
+    -25, 6, 46, 41, 13, -14, 1, -18, -37, -29, 3, 19, -19, -24, -7, 5, -17, -26, -27, -24,
+    -2, 3, 42, 49, 1, -21, 1, -15, -26, -29, 11, 35, -2, -7, -9, 1, -12, -10, -7, -7,
+    -8, 2, 50, 25, 2, -14, -11, -10, -36, -21, 5, 34, -8, 1, 13, 3, -2, 1, -7, -15,
+    1, 0, 17, 17, -9, -25, -17, -15, -26, -31, -6, 14, -6, -15, -4, 10, -7, -5, -18, -8,
+    5, 1, 22, 24, -26, -39, -19, -21, -24, -8, 0, 15, -2, -8, 15, 11, 7, 1, -3, 0,
+    10, 10, 6, -3, -36, -21, -18, -20, -18, -23, -3, 9, 17, 5, 10, 13, 19, 15, 4, 0,
+    5, 5, -2, -13, -45, -6, 12, -20, 6, 4, -9, 23, 1, -8, 10, 17, 24, 29, 6, 24,
+    8, 25, -7, -23, -34, -7, 12, 9, 1, 0, 0, 8, 4, -12, 10, 0, 14, 24, 14, 23,
+    -8, -1, -9, -31, -33, -9, 14, -4, 16, 0, -18, 1, -14, -10, -4, -13, 1, 19, 14, -4,
+    7, -20, -14, -33, -1, 16, 28, 9, -2, -3, -10, -15, -9, -29, -15, -1, 10, -1, 9, 0,
+    -3, -15, -20, -18, 8, 27, 39, 25, 14, 1, -19, -13, -13, -7, 25, 17, 25, 21, 30, 32,
+    -20, -43, -33, -33, 5, 32, 27, 23, 20, -8, -17, -1, -11, -6, 27, 10, 26, 21, 23, 27,
+    -45, -30, -43, -23, 30, 47, 16, 40, 28, -11, -14, -31, -43, -12, -8, -16, -5, -8, -25, -24,
+    -36, -42, -28, -18, 24, 56, 41, 40, 19, -6, -23, -8, -36, -10, -8, 5, -10, 2, -16, -25,
+    -57, -52, -34, -24, 47, 65, 41, 44, 40, 4, -21, -32, -30, -21, 5, -1, -2, -7, -15, -17,
+    -32, -58, -30, -21, 35, 45, 26, 32, 31, 0, -12, -17, -17, -5, 1, 0, 8, 0, -10, 1,
+    -38, -35, -27, -18, 18, 40, 28, 10, 32, 17, -2, -2, 1, 0, 17, 22, -4, 9, 8, -15,
+    -19, -21, -25, 3, 2, 19, 15, 10, 10, 1, 5, 7, -17, -2, 7, 15, 6, -3, -13, -13,
+    -14, -9, -28, -16, -18, -11, -10, -25, 0, -9, -14, 7, -19, -3, 3, -2, -10, -7, -10, -20,
+    2, 13, 12, -11, -40, -34, -36, -29, -25, -34, -27, 5, -11, -8, -5, 0, -19, -1, -16, 0,
+    21, 54, 56, 16, -19, -23, -28, -33, -37, -18, 10, 37, 21, 14, 10, 17, 1, 15, 6, 12,
+    25, 63, 44, 7, -6, -25, -32, -36, -41, -27, 18, 19, 25, 9, 15, 15, 12, -7, -6, -4,
+    32, 55, 34, 13, -16, -43, -29, -25, -53, -31, -9, 33, 24, -3, 10, 0, -3, -4, -4, -9,
+    36, 42, 51, 9, -25, -38, -37, -52, -49, -40, -2, 6, 1, -13, 21, -5, -3, -3, 4, -6,
+    28, 56, 38, -8, -32, -40, -46, -44, -38, -29, 5, 31, -5, -8, 16, 4, -3, -7, 3, -9,
+    55, 53, 53, 7, -13, -17, -25, -27, -33, -12, 9, 13, 2, -12, 13, -1, -6, 6, 6, -8,
+    28, 36, 29, -6, -23, -9, -12, -20, -8, 5, 17, 15, -4, -2, 13, 11, -10, -6, 10, -6,
+    7, -12, -15, -30, -32, -4, -18, -21, -20, -3, -19, 3, -14, -27, 4, 4, -15, -21, -3, -19,
+    // Hidden unit 28
+    -31, -19, -12, 17, 16, -3, 10, 19, 33, 55, 70, 88, 42, 8, 10, 16, -1, -39, -23, -40,
+    -18, -22, 1, 35, 27, 11, -2, 6, 21, 39, 52, 77, 10, -14, 13, -5, 1, -6, -32, -18,
+    -7, -5, 25, 48, 28, -1, 0, 9, 37, 34, 57, 88, 14, 14, 23, 11, 11, -19, -21, -14,
+    -21, 3, 35, 64, -5, -1, 12, 30, 25, 37, 37, 82, 24, 16, 20, 4, 15, -3, -1, -27,
+    -10, -8, 28, 67, -10, 9, 25, 26, 26, 44, 54, 96, 31, 21, 6, 20, 8, -1, -20, -8,
+    -25, -2, 36, 63, -3, -8, 4, 9, 28, 27, 49, 92, 38, 5, 10, 18, 2, 2, -12, -17,
+    -11, -5, 37, 57, -17, 3, 9, 30, 30, 17, 43, 77, 25, 7, 5, 8, 3, -1, -19, -18,
+    -5, -13, 55, 45, -19, 11, 18, 39, 16, 8, 46, 78, 28, 2, 16, 16, -8, -3, -18, -30,
+    -5, 9, 28, 31, -18, 16, 3, 20, 7, 36, 37, 51, 6, -14, 11, 1, 6, -16, -10, -25,
+    -19, -14, 32, 39, -25, 7, 5, 18, 18, 28, 20, 29, 7, 2, 18, 7, 10, 13, -10, -4,
+    -12, 3, 2, 19, -40, 7, 6, 2, -1, 7, 12, 34, 6, -15, 19, 10, 8, 14, 17, 19,
+    0, -3, -1, 2, -24, -9, 18, -37, -20, -4, -1, 12, -9, -18, -1, -3, -3, 2, 0, 17,
+    3, -14, 6, 9, -19, -8, -1, -27, -14, -8, -28, -1, -29, -25, 2, 0, -8, -11, 7, 15,
+    -12, -7, 1, -12, -5, 6, 33, -17, -17, -11, -13, 7, -27, -26, 9, 11, 13, 10, 23, 10,
+    -11, -8, -15, -8, 3, 3, 32, -4, -11, -13, -13, -6, -17, -25, 6, -4, 26, 3, 30, 8,
+    -17, -3, -12, -8, 7, 10, 30, -2, -6, -5, -25, 9, -12, -27, 0, 14, 6, 12, 17, 15,
+    -15, -7, -20, -16, 12, 6, 19, -4, 13, -2, -15, 5, -23, -20, -1, 25, 22, 5, 10, 14,
+    -26, 1, -21, -15, 24, 34, 46, -3, 4, -18, -25, 24, -15, -10, 9, 3, 18, 7, -1, 8,
+    -26, -3, -11, -6, 16, 38, 44, 15, 7, -6, -13, 18, -21, -28, 7, -1, 0, 13, -5, 7,
+    -33, 4, -29, -20, 22, 39, 41, 20, 8, -2, -3, 10, -13, -34, -2, 9, 2, 15, 9, 12,
+    -37, -3, -26, -15, 23, 39, 49, 28, 20, 15, 3, -1, -16, -16, 10, 6, 17, 19, 0, 14,
+    -24, -18, -24, -25, 2, 39, 36, 18, 24, 0, -3, -8, -25, -24, -3, -14, 5, 13, -8, 0,
+    -18, 9, -16, -4, 3, 27, 25, 5, 6, -8, 0, 12, -14, -34, 0, 2, 2, -10, -8, -7,
+    -13, 22, -12, 11, 6, 35, 0, 23, 0, -11, 2, -2, -21, -29, -4, 9, 8, 8, -8, 2,
+    18, 27, 5, 9, 11, 28, 12, 14, -8, -7, -4, -5, -17, -15, -4, 5, 10, 7, -21, -25,
+    11, 25, 10, -8, 3, 35, -14, 22, -6, -2, -4, -9, -20, -22, -1, 13, -7, -4, -3, -21,
+    17, 46, 9, 4, -5, 10, 2, -6, -12, -11, 9, -1, -14, -7, -14, -2, -12, -14, -8, -7,
+    6, 47, 23, -5, -21, 13, -15, 2, -15, -11, -6, 3, -15, -16, 6, 9, -4, 13, 4, -4,
+    33, 58, 7, 8, -19, -17, -26, -32, -28, -9, 3, 18, -6, -19, 1, 17, 6, -4, 5, -19,
+    28, 52, 37, -2, -5, -21, -22, -32, -24, 1, -3, 22, -13, -10, 3, 15, -9, -2, -6, -9,
+    58, 83, 37, 0, -18, -27, -18, -33, -37, -3, 10, 31, -9, -21, 23, 22, 2, -3, 5, 3,
+    51, 79, 35, -12, -21, -31, -13, -26, -27, 12, 0, 24, 2, -2, 23, 13, -2, 0, 14, -11,
+    30, 59, 16, 2, -21, -15, -23, -37, -43, -20, 17, 33, -8, -14, 14, 3, -12, -1, 16, -11,
+    24, 38, 29, -2, -16, -5, -7, -22, -32, -9, 5, 22, -1, -11, 19, 17, -1, 10, 15, -2,
+    29, 61, 35, -11, -4, -12, -10, -14, -37, -9, 0, 40, 6, -11, 20, 2, 12, 3, -7, 11,
+    26, 56, 29, 1, -8, -9, -9, -10, -31, 10, -1, 29, -19, -13, 3, -1, 1, 3, -2, -8,
+    25, 26, 31, -24, -18, -1, -6, -13, -27, -12, 4, 21, -20, -8, -2, 8, 14, -1, -5, -21,
+    17, 22, 13, -21, -8, 1, 8, -23, -26, 13, 6, 2, -13, -27, -5, 7, 4, 12, -12, -2,
+    -10, 0, -1, -28, -18, 1, 12, 0, -21, -12, -2, 9, -15, -22, 1, 13, 0, -5, 7, 4,
+    -29, -17, -36, -45, -24, -10, 14, -1, -24, -9, -20, -8, -13, -10, -3, 6, 16, 4, 12, -7,
+    // Hidden unit 29
+    40, 30, 22, -25, -14, 8, -6, 3, -32, -58, -59, -62, -48, -20, -11, -7, 3, 3, 22, 7,
+    29, 25, 1, -48, -33, -21, -2, 15, 1, -44, -40, -64, -35, -8, -6, -1, 9, 10, 16, 11,
+    17, 2, -23, -58, -33, -13, 6, -3, -15, -24, -45, -59, -23, -26, -14, -5, 2, 7, 11, 4,
+    25, 1, -45, -67, -10, 7, -2, 4, -24, -27, -46, -60, -39, -17, -7, 3, -8, 14, 18, 22,
+    30, 9, -28, -63, -28, -4, -3, 4, -29, -36, -57, -57, -44, -17, 7, 0, 11, 8, 26, 30,
+    23, 7, -47, -57, -3, 7, 2, 26, -7, -17, -50, -59, -35, -11, 0, 15, 4, 13, 36, 32,
+    18, 13, -35, -46, -3, -9, 13, 2, 6, -32, -48, -52, -18, 8, 8, 12, 17, 26, 36, 35,
+    34, 22, -23, -26, 0, 5, -3, 4, 0, -12, -45, -56, -35, 4, 19, 12, 16, 30, 35, 30,
+    17, 6, -12, -44, -11, -14, 9, -1, 2, -31, -47, -38, -34, -11, -7, 9, -5, 4, 8, 17,
+    18, 24, -13, -26, 0, -12, 12, 1, -7, -37, -41, -36, -21, -5, -12, -21, -4, -4, -3, -11,
+    31, 34, -2, -14, 26, 1, -11, 6, -3, -6, -24, -29, -23, -19, -26, -31, -20, -21, -27, -17,
+    34, 47, 22, 9, 29, 15, 10, 37, 22, 13, 0, 2, 0, -8, -15, -19, -16, -16, -11, -32,
+    42, 37, 23, 7, 23, 10, 7, 29, 27, 17, 7, 4, 15, 14, -8, -22, -8, -19, -15, -13,
+    46, 23, 16, -4, 6, 2, -19, 26, 10, 4, 19, -13, 4, 0, -4, -10, -13, -1, -22, -34,
+    29, 20, 18, 13, -16, -14, -11, 19, 18, -1, 7, -1, 3, -7, -23, -26, -25, -36, -27, -38,
+    36, 12, 12, -11, -29, -25, -26, 7, -5, -12, 12, -16, 11, -1, -5, -27, -20, -13, -28, -34,
+    46, 24, 16, -2, -33, -25, -30, -8, -8, 5, 8, 4, -7, -13, -17, -27, -27, -20, -23, -18,
+    27, 22, 6, -10, -43, -40, -41, -8, 0, 9, 2, -1, -19, -4, -24, -16, -14, -2, -4, -13,
+    44, 14, 5, -6, -31, -46, -36, 5, -6, 6, 20, -13, -10, -4, -5, -14, 7, 3, 4, -4,
+    43, 8, 16, -16, -47, -34, -38, -18, -3, 2, 19, 15, 12, 5, 5, 15, 9, 10, 12, 18,
+    52, 38, 39, 18, -9, -31, -24, -15, 17, 5, 8, 14, 27, 37, 18, 21, -6, -9, -1, 16,
+    48, 22, 37, 15, 7, -1, -12, 18, 5, 20, 30, 21, 23, 37, 14, 14, 21, 1, 26, 20,
+    23, 3, 11, -1, -14, -14, 7, -1, 11, 9, 17, -1, 11, 18, 9, 0, 8, 3, 0, 14,
+    9, -10, -10, -10, 0, -29, 0, 4, 21, 7, 3, 20, 9, 15, 0, 1, 15, 0, 14, 16,
+    -23, -30, -29, -16, -32, -31, 2, 0, 7, 23, 28, 21, 4, 9, 7, 3, 27, 25, 37, 33,
+    -15, -48, -49, -20, -20, -28, 15, -18, 9, 18, 17, 16, 1, 3, 0, 17, 17, 27, 35, 29,
+    -2, -40, -29, -28, -17, -23, -7, 7, 16, 12, 9, 17, 26, 18, 19, 9, 12, 26, 18, 22,
+    -23, -42, -33, -10, -5, -8, -8, 2, 27, -4, 11, 0, 11, 11, 15, 17, 17, 7, 16, 26,
+    -22, -70, -51, -11, 3, 0, 12, 15, 28, 1, -1, -3, 0, -2, -10, 8, 19, 14, 18, 29,
+    -45, -71, -55, -19, 3, 14, 9, 23, 12, -9, -2, -11, 9, 8, -2, 10, 11, 5, 8, 33,
+    -54, -98, -74, -22, 0, 5, 20, 24, 33, 5, -1, -12, 7, -1, 10, 6, 12, 14, 15, 24,
+    -62, -87, -73, -23, 26, 38, 33, 27, 45, 13, -8, -12, 0, 1, -5, 12, 21, 25, 0, 14,
+    -44, -77, -64, -15, 20, 19, 32, 46, 25, 10, -14, -10, 6, -5, -9, -6, 9, 13, -8, 10,
+    -24, -51, -53, 0, 13, 30, 17, 42, 44, 29, -5, -10, -2, 5, 10, 14, 19, 15, 7, 12,
+    -19, -66, -33, 13, 33, 34, 44, 48, 53, 21, -5, -6, -2, 13, 5, 3, 20, 12, 15, 5,
+    -14, -41, -40, 25, 40, 51, 48, 26, 47, 23, 12, 8, 2, 20, 2, 5, 4, 9, -1, 15,
+    -9, -24, -20, 45, 58, 35, 42, 52, 58, 24, -3, -7, 23, 21, 5, 3, 13, 25, 10, 29,
+    6, -13, -20, 46, 47, 44, 37, 67, 42, 23, 4, -6, 13, 15, 8, 19, 4, 18, 16, 23,
+    43, 20, 15, 57, 85, 36, 29, 42, 35, 33, 16, 12, 32, 31, 12, 2, 21, 16, 16, 16,
+    65, 58, 64, 90, 87, 44, 32, 37, 50, 47, 48, 19, 42, 32, 20, 6, 11, 24, 2, 21,
+    // Hidden unit 30
+    -9, -48, -23, -19, -15, -17, -33, -34, -43, -23, -14, 19, -23, -15, 1, -18, -14, -11, -19, -27,
+    13, -38, -14, 2, -4, -16, -3, -13, -21, -19, -3, 55, -16, -2, 10, -8, -5, -8, -20, -11,
+    10, -21, -17, -6, -22, -3, 18, -9, -43, -35, -9, 60, -13, -7, -4, 6, 4, -10, -9, -20,
+    2, -22, 2, -3, -27, -15, 5, -18, -30, -44, -14, 60, -14, -17, 16, -13, -20, -13, -30, -23,
+    -12, -38, -22, -14, -49, -31, -14, -12, -28, -37, -13, 36, -20, -27, -5, -22, -31, -25, -38, -47,
+    -14, -27, -13, -24, -31, -26, -1, 0, -20, -22, 10, 34, -24, -23, 8, -5, -17, -14, -31, -30,
+    -11, -27, -15, -12, -10, -2, 18, 12, -8, -15, 0, 30, 5, -14, 11, -9, -27, -16, -27, -28,
+    -32, -27, -11, -11, -8, -16, -6, -16, -11, -16, -8, 37, 3, -20, 6, 1, -20, -16, -21, -30,
+    -49, -18, -13, -4, -19, -9, 0, -10, 1, 27, 25, 63, 31, 37, 49, 5, 15, -7, -2, -19,
+    -40, -40, 1, 5, -24, -12, 0, 7, -7, -2, 7, 24, 17, 10, 12, -2, 3, 11, 1, -8,
+    -28, 8, 9, 19, 11, 20, 0, -5, 13, -11, 7, 32, 3, -5, 16, -2, -10, 1, -4, -16,
+    -34, 2, 21, 18, 3, -16, 25, 2, 5, 18, 18, 11, -8, 11, 3, 8, -7, 3, -7, -8,
+    -36, -29, -6, 0, -1, -11, 4, 1, -11, -24, 9, -1, -13, 23, 19, 28, 23, 22, 6, -3,
+    -20, -16, -1, -8, -7, -40, -27, 2, -21, -30, -9, 13, -10, -6, 15, 6, 24, 20, 19, 9,
+    -48, -30, 7, -6, -11, -11, -2, 2, 12, -19, -25, -3, -45, -11, -2, -13, -14, 0, -4, -1,
+    -18, 2, 10, -14, -10, 11, 14, 21, 37, -17, -27, -5, -17, -3, 19, -4, -13, -2, -17, -24,
+    -18, -6, 0, 6, 1, -1, 28, 31, 52, -13, -29, -8, -22, -4, 24, 5, -8, -5, -9, -9,
+    -5, -14, 4, -26, -4, 10, 8, 46, 54, -9, -25, -1, -13, 19, 20, 9, 9, 18, 7, 0,
+    -28, -18, -9, -37, -22, -4, 8, 47, 35, -13, -37, 4, -21, 0, 27, 9, 7, 23, 11, 14,
+    -5, -18, -12, -30, -10, -2, 2, 7, 19, -27, -41, 1, -17, -3, 19, 3, 2, -9, 7, 5,
+    2, -37, -15, -53, -28, -32, -14, -5, -4, -37, -54, -31, -52, -14, 1, -21, -3, -17, -19, -5,
+    -17, -19, -14, -7, 3, 8, 11, 25, 2, -20, -26, -6, -24, -13, 11, -6, -12, -16, -11, -15,
+    -28, -28, -27, -33, -28, -14, 1, 28, 12, -16, -21, 6, 14, 30, 26, 31, 12, 6, 10, 9,
+    -37, -24, -13, -22, 4, -10, -6, 20, 7, -22, -30, 20, -13, 15, 21, -2, -2, 8, -11, 2,
+    -25, 10, -6, 6, 11, 21, 25, -6, 2, -29, -27, 23, -22, 15, 29, -17, -18, -21, -29, -26,
+    -13, 19, 1, -6, 24, 24, 10, 14, 5, -24, 1, 57, -21, 13, 22, 19, 17, 11, -1, -4,
+    15, 1, 15, 2, 4, 18, -2, -3, -5, -21, 4, 38, 6, 21, 40, 8, 5, 4, -10, -11,
+    7, 5, 1, -2, 9, 11, -7, -15, -7, -29, 9, 54, -1, 15, 27, 5, 3, 11, -12, -1,
+    6, 18, -2, 8, 9, 1, -8, 2, -21, -23, 2, 48, -4, 23, 48, 17, 17, 12, -1, 1,
+    26, 6, 10, 9, 0, 12, -27, -14, -30, -6, 38, 55, 6, 25, 55, 18, 24, 10, 11, 5,
+    25, 3, 3, 1, 15, 25, -23, -48, -40, -14, 12, 39, 10, 20, 29, 21, 0, -12, -11, -16,
+    19, 43, 52, 12, -30, -32, -33, -56, -62, -26, 37, 51, 7, 14, 26, 6, -16, -6, -19, -9,
+    1, 12, 4, -20, -34, -36, -26, -48, -48, -35, 8, 43, 32, 23, 34, 26, 7, -6, 7, 0,
+    -2, -1, -8, -22, -44, -34, -50, -36, -36, -19, 6, 11, 12, -16, 20, 2, -10, -6, -7, -2,
+    14, 7, -6, -33, -40, -33, -34, -38, -32, -41, -7, -4, -6, -17, -8, -1, 1, -15, -14, -13,
+    -12, -10, -32, -38, -43, -49, -47, -58, -38, -43, -21, -14, -20, -18, 0, -9, -9, -19, -5, -29,
+    -13, 18, -10, -10, -24, -30, -48, -34, -52, -34, 1, -3, 4, -15, -11, -15, -4, -3, -9, -20,
+    -9, 7, -15, -18, -39, -35, -25, -29, -30, -35, 1, 4, -10, -14, 1, -7, -11, -7, 1, -7,
+    -13, 2, -9, -11, -27, -38, -21, -34, -48, -49, 4, 25, 11, 5, 11, 2, -5, -7, -11, -18,
+    -17, 2, -10, -2, -30, -31, -33, -41, -50, -39, -8, 4, -10, -24, -21, -22, -30, -20, -36, -21,
+    // Hidden unit 31
+    21, 31, 2, -28, -37, -2, -11, 9, -22, -48, -69, -71, -41, -12, -7, -22, -6, 5, 7, 19,
+    24, 9, -19, -60, -51, -33, -2, 8, -7, -36, -35, -56, -44, -21, -21, -6, -13, -2, 10, 10,
+    23, -1, -24, -79, -32, -26, -6, 4, -13, -32, -37, -72, -24, -20, -15, -15, -9, 8, 7, 4,
+    25, -9, -44, -85, -32, -20, 4, -11, -30, -47, -50, -55, -46, -16, -24, -6, -14, 2, 11, 15,
+    23, -1, -49, -68, -25, -6, -5, -4, -27, -35, -65, -67, -42, -25, -18, -1, -8, 4, 10, 2,
+    31, 6, -51, -78, -19, 1, 11, -1, -2, -33, -41, -49, -44, -19, -6, 10, 10, 11, 20, 12,
+    36, 2, -37, -61, -24, -11, 12, 1, -9, -16, -45, -39, -30, -17, -4, 10, 8, 26, 13, 28,
+    25, 21, -38, -38, -1, 3, 19, 14, 8, -9, -21, -49, -14, 10, 13, 12, 29, 24, 23, 35,
+    36, 9, -34, -24, -4, 3, 22, 14, -12, -30, -39, -34, -12, -2, 12, 16, 15, 26, 12, 34,
+    27, 15, -25, -42, -9, -8, -9, -9, -2, -28, -22, -29, -23, 0, 10, 11, 2, 11, 2, 19,
+    35, 20, -1, -21, -3, -6, -3, 5, 1, -17, -24, -14, -15, 7, -16, -2, -8, -7, -7, 7,
+    32, 30, 3, -6, 24, 8, -5, 17, 3, -5, -10, -12, -4, -3, -12, -11, 4, 4, 8, 1,
+    33, 34, 14, 4, -3, -3, 7, 34, 33, 25, 9, 10, 35, 7, 10, 13, 23, 13, 21, 12,
+    44, 19, 6, 8, 10, -13, -15, 9, 24, 3, 19, 9, 1, -1, -7, -2, -11, 2, -3, 11,
+    43, 19, 2, 3, -13, -10, -14, 28, 12, 20, 18, -9, 19, 6, -3, -9, -7, -10, -11, -7,
+    53, 25, 26, -6, -13, -3, -9, 9, 2, -5, 6, 11, 11, 12, -3, -13, -19, -3, -8, -4,
+    44, 30, 21, 0, -18, -34, -27, 4, -3, 14, 14, -11, -3, -6, -23, -14, -6, 1, 0, -17,
+    52, 29, 26, 2, -26, -35, -34, -18, 5, 21, 13, -1, 2, 5, -12, -7, -5, -20, -13, -4,
+    52, 42, 22, 16, -16, -25, -33, -11, -7, 7, 10, -9, -15, -4, 1, -2, -5, -27, -11, -7,
+    67, 26, 35, 17, -6, -31, -15, -8, -1, 16, 13, 13, 9, 7, -7, -5, -16, 0, -12, -4,
+    66, 56, 46, 39, 0, -7, -14, -2, 2, 8, 28, 15, 6, 11, -3, 0, -16, -14, -9, -20,
+    59, 49, 45, 25, 4, -2, -3, -2, 7, 2, 14, 16, 22, 16, 14, 1, -2, -14, 13, -7,
+    36, 13, 7, 14, -1, -17, 9, -3, 18, 10, 19, 8, 0, 13, -11, 10, 3, -7, -3, -2,
+    18, -5, 11, -13, 2, -26, 15, -12, 8, 18, 4, 3, 1, 11, -19, -5, -2, -6, -2, -14,
+    -10, -34, -25, -2, -17, -11, 4, -12, 3, 14, 6, 16, 1, 5, 12, 5, 3, 7, 8, 23,
+    5, -40, -37, -23, -19, -18, 12, -10, 13, 23, 3, 4, 12, 14, 11, 8, 6, 13, 2, 27,
+    14, -19, -24, -10, -23, -12, -3, -5, 13, 9, 14, 3, 21, 3, 1, -12, 14, 4, 20, 12,
+    6, -40, -12, 0, 3, -3, -1, 1, 24, 7, 11, 3, 2, 0, 6, -7, -7, -6, 16, 13,
+    -21, -32, -18, 9, 8, 1, 32, 20, 25, 7, -5, 4, 3, 12, -15, -17, 14, -3, 14, 5,
+    -18, -62, -39, -17, -4, 16, 6, 20, 8, 8, -10, -25, 2, 10, -14, 5, -1, -3, 9, 13,
+    -37, -52, -39, -12, 18, 22, 15, 36, 38, 8, -5, -9, 21, -1, 4, 2, 1, -3, 13, 22,
+    -41, -69, -50, -6, 36, 50, 36, 36, 38, 12, 4, -3, 5, -7, 9, 5, 6, 9, 10, 9,
+    -14, -43, -30, 13, 26, 14, 32, 40, 40, 13, 9, -20, -2, 6, 1, -6, 5, 10, -11, 8,
+    -2, -34, -33, 8, 16, 20, 13, 30, 47, 15, -8, -19, 8, -3, 7, 8, 13, -8, -15, 4,
+    -5, -33, -26, 17, 33, 27, 38, 34, 50, 28, 1, -4, -6, 5, 9, 0, -3, 1, 7, -10,
+    -11, -30, -15, 27, 19, 31, 28, 23, 56, 36, 2, -5, 2, 17, 7, 10, 3, -6, 2, 19,
+    -10, -32, -21, 32, 42, 48, 25, 39, 50, 35, 3, -10, 4, 23, 11, 15, 4, 15, 3, 10,
+    16, -17, -3, 28, 60, 44, 33, 53, 47, 10, 1, 0, 28, 17, 2, 9, 16, 4, 16, 21,
+    43, 15, 4, 42, 57, 34, 38, 36, 45, 27, 10, 8, 31, 26, -2, 12, 14, 5, 4, 19,
+    86, 70, 65, 71, 65, 44, 31, 37, 50, 45, 35, 24, 33, 18, 26, 16, 15, 22, 4, 30,
+};
+
+static const int32_t Hidden_Bias[Keyword_Hidden] = {
+    10599, 8218, 8944, 5065, 10631, -5839, -7189, -5301,
+    -5745, -9016, 10911, 8291, 9069, -5874, 9286, 8227,
+    10525, -8457, 6750, 7580, -5402, -7751, -8168, 5591,
+    -8416, 8598, -8700, -5105, -9523, 9738, -4370, 9515,
+};
+
+static const int8_t Output_Weights[Keyword_Hidden] = {
+    -15, -98, -127, -39, -74, 22, 33, 36, 10, 8, -61, -15, -6, 10, -4, -7,
+    -55, 15, -53, -12, 28, -1, 13, -13, 34, -35, 6, 23, 23, -47, 25, -22,
+};
+
+const Keyword_Model Keyword_Model_Default = {
+    .Name = "keyword",
+    .Feature_Offset = 8246,
+    .Hidden_Weights = Hidden_Weights,
+    .Hidden_Bias = Hidden_Bias,
+    .Hidden_Shift = 12,
+    .Output_Weights = Output_Weights,
+    .Output_Bias = -199,
+    .Threshold = 557,
+};
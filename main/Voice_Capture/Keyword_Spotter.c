@@ -0,0 +1,197 @@
+#include "Keyword_Spotter.h"
+
+#include <math.h>
+#include <string.h>
+
+#define Bins                    (Keyword_Window / 2 + 1)
+#define No_Band                 0xFF
+#define Energy_Floor            (1u << 16)                  // About -110 dBFS, silence is not minus infinity
+
+// Shared by every spotter, built by the first Keyword_Spotter_Init()
+static bool Tables_Ready = false;
+static int16_t Hann[Keyword_Window];                        // Q15
+static int16_t Cos[Keyword_Window / 2];                     // Q15 twiddles
+static int16_t Sin[Keyword_Window / 2];
+static uint16_t Reversed[Keyword_Window];
+static uint8_t Bin_Band[Bins];                              // Band whose rising edge the bin is on
+static uint16_t Bin_Weight[Bins];                           // Q15 for Bin_Band, the rest goes to the band below
+
+static float Mel(float Hz)
+{
+    return 2595.0f * log10f(1.0f + Hz / 700.0f);
+}
+
+static void Build_Tables(void)
+{
+    int bits = 0;
+    while ((1 << bits) < Keyword_Window) {
+        bits++;
+    }
+    for (int n = 0; n < Keyword_Window; n++) {
+        Hann[n] = (int16_t)lrintf(32767.0f * (0.5f - 0.5f * cosf(2.0f * (float)M_PI * n / Keyword_Window)));
+        uint16_t r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= ((n >> b) & 1) << (bits - 1 - b);
+        }
+        Reversed[n] = r;
+    }
+    for (int k = 0; k < Keyword_Window / 2; k++) {
+        Cos[k] = (int16_t)lrintf(32767.0f * cosf(2.0f * (float)M_PI * k / Keyword_Window));
+        Sin[k] = (int16_t)lrintf(32767.0f * sinf(2.0f * (float)M_PI * k / Keyword_Window));
+    }
+    // Triangles between Keyword_Bands + 2 points evenly spaced in mel, band b peaks at point b + 1
+    float low = Mel(Keyword_Low_Hz);
+    float step = (Mel(Keyword_High_Hz) - low) / (Keyword_Bands + 1);
+    for (int k = 0; k < Bins; k++) {
+        float position = (Mel((float)k * Keyword_Rate / Keyword_Window) - low) / step;
+        if (position < 0.0f || position >= Keyword_Bands + 1) {
+            Bin_Band[k] = No_Band;
+            Bin_Weight[k] = 0;
+            continue;
+        }
+        int point = (int)position;
+        Bin_Band[k] = point;
+        Bin_Weight[k] = (uint16_t)lrintf(32767.0f * (position - point));
+    }
+    Tables_Ready = true;
+}
+
+// In place, radix 2. Inputs below 2^19 cannot overflow: nine stages grow them to 2^28 at most
+static void FFT(int32_t *Re, int32_t *Im)
+{
+    for (int n = 0; n < Keyword_Window; n++) {
+        int r = Reversed[n];
+        if (r > n) {
+            int32_t t = Re[n];
+            Re[n] = Re[r];
+            Re[r] = t;
+            t = Im[n];
+            Im[n] = Im[r];
+            Im[r] = t;
+        }
+    }
+    for (int half = 1; half < Keyword_Window; half *= 2) {
+        int stride = Keyword_Window / (2 * half);
+        for (int k = 0; k < half; k++) {
+            int32_t c = Cos[k * stride];
+            int32_t s = -Sin[k * stride];
+            for (int i = k; i < Keyword_Window; i += 2 * half) {
+                int j = i + half;
+                int32_t re = (int32_t)(((int64_t)Re[j] * c - (int64_t)Im[j] * s) >> 15);
+                int32_t im = (int32_t)(((int64_t)Re[j] * s + (int64_t)Im[j] * c) >> 15);
+                Re[j] = Re[i] - re;
+                Im[j] = Im[i] - im;
+                Re[i] += re;
+                Im[i] += im;
+            }
+        }
+    }
+}
+
+// log2 in Q8, within 0.01 octave, the approximation Voice_Activity uses
+static int32_t Log2_Q8(uint64_t x)
+{
+    int msb = 63 - __builtin_clzll(x);
+    int32_t f = (msb >= 8) ? (int32_t)(x >> (msb - 8)) & 0xFF : (int32_t)(x << (8 - msb)) & 0xFF;
+    return msb * 256 + f + ((f * (256 - f) * 87) >> 16);
+}
+
+void Keyword_Spotter_Init(Keyword_Spotter *Kws, const Keyword_Model *Model)
+{
+    if (!Tables_Ready) {
+        Build_Tables();
+    }
+    Kws->Model = Model;
+    Kws->Detections = 0;
+    Keyword_Spotter_Reset(Kws);
+}
+
+void Keyword_Spotter_Reset(Keyword_Spotter *Kws)
+{
+    memset(Kws->Samples, 0, sizeof(Kws->Samples));
+    memset(Kws->Features, 0, sizeof(Kws->Features));
+    memset(Kws->Scores, 0, sizeof(Kws->Scores));
+    Kws->Rows = 0;
+    Kws->Score = 0;
+    Kws->Refractory = 0;
+}
+
+void Keyword_Spotter_Analyze(Keyword_Spotter *Kws, const int16_t *Samples, int32_t Log_Mel[Keyword_Bands])
+{
+    memmove(Kws->Samples, Kws->Samples + Keyword_Hop, (Keyword_Window - Keyword_Hop) * sizeof(int16_t));
+    memcpy(Kws->Samples + Keyword_Window - Keyword_Hop, Samples, Keyword_Hop * sizeof(int16_t));
+    for (int n = 0; n < Keyword_Window; n++) {
+        Kws->Re[n] = ((Kws->Samples[n] * Hann[n]) >> 15) * 16;      // Four bits of headroom the FFT keeps
+        Kws->Im[n] = 0;
+    }
+    FFT(Kws->Re, Kws->Im);
+
+    uint64_t energy[Keyword_Bands + 1] = { 0 };             // The extra band takes the falling edge of the last
+    for (int k = 0; k < Bins; k++) {
+        if (Bin_Band[k] == No_Band) {
+            continue;
+        }
+        uint64_t power = ((uint64_t)((int64_t)Kws->Re[k] * Kws->Re[k]) + (uint64_t)((int64_t)Kws->Im[k] * Kws->Im[k])) >> 16;
+        int band = Bin_Band[k];
+        energy[band] += power * Bin_Weight[k];
+        if (band > 0) {
+            energy[band - 1] += power * (32767 - Bin_Weight[k]);
+        }
+    }
+    for (int b = 0; b < Keyword_Bands; b++) {
+        Log_Mel[b] = Log2_Q8(energy[b] + Energy_Floor);
+    }
+}
+
+int32_t Keyword_Spotter_Score(const Keyword_Model *Model, const int8_t Features[Keyword_Inputs])
+{
+    int32_t score = Model->Output_Bias;
+    const int8_t *w = Model->Hidden_Weights;
+    for (int h = 0; h < Keyword_Hidden; h++, w += Keyword_Inputs) {
+        int32_t sum = Model->Hidden_Bias[h];
+        for (int i = 0; i < Keyword_Inputs; i++) {
+            sum += w[i] * Features[i];
+        }
+        if (sum <= 0) {
+            continue;                                       // ReLU
+        }
+        sum >>= Model->Hidden_Shift;
+        score += Model->Output_Weights[h] * (sum > 127 ? 127 : sum);
+    }
+    return score;
+}
+
+bool Keyword_Spotter_Process(Keyword_Spotter *Kws, const int16_t *Samples)
+{
+    int32_t log_mel[Keyword_Bands];
+    Keyword_Spotter_Analyze(Kws, Samples, log_mel);
+
+    memmove(Kws->Features, Kws->Features + Keyword_Bands, Keyword_Inputs - Keyword_Bands);
+    int8_t *row = Kws->Features + Keyword_Inputs - Keyword_Bands;
+    for (int b = 0; b < Keyword_Bands; b++) {
+        int32_t f = (log_mel[b] - Kws->Model->Feature_Offset) >> Keyword_Feature_Shift;
+        row[b] = (f < -128) ? -128 : (f > 127) ? 127 : f;
+    }
+    Kws->Rows++;
+    if (Kws->Refractory) {
+        Kws->Refractory--;
+    }
+    // The window starts out half silence, which a trained model has never seen
+    if (Kws->Rows < Keyword_Frames) {
+        return false;
+    }
+
+    memmove(Kws->Scores, Kws->Scores + 1, (Keyword_Smoothing - 1) * sizeof(int32_t));
+    Kws->Scores[Keyword_Smoothing - 1] = Keyword_Spotter_Score(Kws->Model, Kws->Features);
+    int32_t sum = 0;
+    for (int s = 0; s < Keyword_Smoothing; s++) {
+        sum += Kws->Scores[s];
+    }
+    Kws->Score = sum / Keyword_Smoothing;
+    if (Kws->Rows < Keyword_Frames + Keyword_Smoothing - 1 || Kws->Refractory || Kws->Score < Kws->Model->Threshold) {
+        return false;
+    }
+    Kws->Refractory = Keyword_Refractory;
+    Kws->Detections++;
+    return true;
+}
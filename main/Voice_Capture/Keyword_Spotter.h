@@ -0,0 +1,58 @@
+#pragma once
+
+// Wake word detection on capture frames, independent of FreeRTOS so it also builds on the host, see host_bench/.
+// Every frame becomes one row of log mel energies in fixed point, and a small int8 network scores the last
+// Keyword_Frames rows at once. The network is trained on the host by kws_train, which writes Keyword_Model.c.
+// The cost per frame is fixed: one 512 point FFT and one pass through the network.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Keyword_Hop                 320                     // Capture_Frame_Samples, one row per frame
+#define Keyword_Window              512                     // FFT size, 32 ms at 16 kHz
+#define Keyword_Bands               20                      // Mel bands
+#define Keyword_Low_Hz              100
+#define Keyword_High_Hz             7000
+#define Keyword_Frames              40                      // Rows scored at once, 800 ms covers the whole word
+#define Keyword_Inputs              (Keyword_Frames * Keyword_Bands)
+#define Keyword_Hidden              32
+#define Keyword_Feature_Shift       5                       // Log2 Q8 energies to int8 features, 1/8 octave steps
+#define Keyword_Smoothing           3                       // Scores averaged before the threshold
+#define Keyword_Refractory          50                      // Frames after a detection before the next one, 1 s
+#define Keyword_Rate                16000                   // Capture_Rate
+
+// Weights are int8, a hidden unit is its sum shifted down to int8 again, the score is in units of the output sum
+typedef struct {
+    const char *Name;
+    int32_t Feature_Offset;                                 // Log2 energy, Q8, taken as feature 0
+    const int8_t *Hidden_Weights;                           // [Keyword_Hidden][Keyword_Inputs], oldest row first
+    const int32_t *Hidden_Bias;
+    uint8_t Hidden_Shift;
+    const int8_t *Output_Weights;                           // [Keyword_Hidden]
+    int32_t Output_Bias;
+    int32_t Threshold;                                      // Smoothed score a detection needs
+} Keyword_Model;
+
+extern const Keyword_Model Keyword_Model_Default;           // Keyword_Model.c, generated
+
+typedef struct {
+    const Keyword_Model *Model;
+    int16_t Samples[Keyword_Window];                        // Newest Keyword_Window samples, oldest first
+    int32_t Re[Keyword_Window];
+    int32_t Im[Keyword_Window];
+    int8_t Features[Keyword_Inputs];                        // Newest Keyword_Frames rows, oldest first
+    uint32_t Rows;                                          // Since the last reset, scoring waits for a full window
+    int32_t Scores[Keyword_Smoothing];
+    int32_t Score;                                          // Last smoothed score
+    uint32_t Refractory;
+    uint32_t Detections;
+} Keyword_Spotter;
+
+void Keyword_Spotter_Init(Keyword_Spotter *Kws, const Keyword_Model *Model);
+void Keyword_Spotter_Reset(Keyword_Spotter *Kws);
+bool Keyword_Spotter_Process(Keyword_Spotter *Kws, const int16_t *Samples);         // Keyword_Hop samples, true on a detection
+
+// The steps of Keyword_Spotter_Process(), for the trainer
+void Keyword_Spotter_Analyze(Keyword_Spotter *Kws, const int16_t *Samples, int32_t Log_Mel[Keyword_Bands]);    // Log2 energies, Q8
+int32_t Keyword_Spotter_Score(const Keyword_Model *Model, const int8_t Features[Keyword_Inputs]);
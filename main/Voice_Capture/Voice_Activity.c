@@ -0,0 +1,129 @@
+#include "Voice_Activity.h"
+
+#include <math.h>
+#include <string.h>
+
+#define Level_Silence           (-120 * 256)
+#define Level_Unknown           INT32_MAX
+
+// 10 * log10(power / full scale) in Q8, within 0.05 dB
+static int32_t Level_dBFS(uint32_t Power)
+{
+    if (Power == 0) {
+        return Level_Silence;
+    }
+    int msb = 31 - __builtin_clz(Power);
+    int32_t f = (msb >= 8) ? (Power >> (msb - 8)) & 0xFF : (Power << (8 - msb)) & 0xFF;
+    int32_t log2 = msb * 256 + f + ((f * (256 - f) * 87) >> 16);   // log2(1 + f) ~ f + 0.34 f (1 - f)
+    return ((log2 - 30 * 256) * 771) >> 8;                          // Full scale power is 2^30, 3.01 dB per octave
+}
+
+// Minimum statistics: speech always has gaps between words, noise does not, so the quietest recent frame is noise
+static void Track_Floor(Voice_Activity *VAD, uint32_t ms)
+{
+    if (VAD->Level < VAD->Current_Min) {
+        VAD->Current_Min = VAD->Level;
+    }
+    VAD->Block_Elapsed_ms += ms;
+    if (VAD->Block_Elapsed_ms >= Voice_Activity_Floor_Block_ms) {
+        VAD->Block_Min[VAD->Block] = VAD->Current_Min;
+        VAD->Block = (VAD->Block + 1) % Voice_Activity_Floor_Blocks;
+        VAD->Block_Elapsed_ms = 0;
+        VAD->Current_Min = Level_Unknown;
+    }
+    int32_t floor = VAD->Current_Min;
+    for (int b = 0; b < Voice_Activity_Floor_Blocks; b++) {
+        if (VAD->Block_Min[b] < floor) {
+            floor = VAD->Block_Min[b];
+        }
+    }
+    VAD->Floor = floor;
+}
+
+void Voice_Activity_Default_Config(Voice_Activity_Config *Config)
+{
+    Config->Threshold_dB = Voice_Activity_Threshold_dB;
+    Config->Hangover_ms = Voice_Activity_Hangover_ms;
+    Config->Onset_ms = Voice_Activity_Onset_ms;
+    Config->Min_Level_dBFS = Voice_Activity_Min_Level_dBFS;
+}
+
+void Voice_Activity_Init(Voice_Activity *VAD, const Voice_Activity_Config *Config)
+{
+    memset(VAD, 0, sizeof(*VAD));
+    if (Config) {
+        VAD->Config = *Config;
+    } else {
+        Voice_Activity_Default_Config(&VAD->Config);
+    }
+    VAD->Level = Level_Silence;
+    VAD->Floor = Level_Silence;
+    VAD->Current_Min = Level_Unknown;
+    for (int b = 0; b < Voice_Activity_Floor_Blocks; b++) {
+        VAD->Block_Min[b] = Level_Unknown;
+    }
+    // RBJ cookbook high pass, Q = 1/sqrt(2)
+    float w = 2.0f * (float)M_PI * Voice_Activity_High_Pass_Hz / Voice_Activity_Rate;
+    float alpha = sinf(w) / (2.0f * 0.70710678f);
+    float a0 = 1.0f + alpha;
+    VAD->B0 = (1.0f + cosf(w)) / 2.0f / a0;
+    VAD->B1 = -(1.0f + cosf(w)) / a0;
+    VAD->A1 = -2.0f * cosf(w) / a0;
+    VAD->A2 = (1.0f - alpha) / a0;
+}
+
+Voice_Activity_Event Voice_Activity_Process(Voice_Activity *VAD, const int16_t *Samples, size_t Count)
+{
+    if (Count == 0) {
+        return Voice_Activity_None;
+    }
+    float energy = 0.0f;
+    float x1 = VAD->X1, x2 = VAD->X2, y1 = VAD->Y1, y2 = VAD->Y2;
+    uint32_t crossings = 0;
+    for (size_t n = 0; n < Count; n++) {
+        int32_t x = Samples[n];
+        float y = VAD->B0 * (x + x2) + VAD->B1 * x1 - VAD->A1 * y1 - VAD->A2 * y2;
+        crossings += (y < 0.0f) != (y1 < 0.0f);            // High passed, a DC offset would hide them
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        energy += y * y;
+    }
+    VAD->X1 = x1;
+    VAD->X2 = x2;
+    VAD->Y1 = y1;
+    VAD->Y2 = y2;
+    uint32_t ms = Count * 1000 / Voice_Activity_Rate;
+    float power = energy / Count;
+    VAD->Level = Level_dBFS(power < 4294967295.0f ? (uint32_t)power : UINT32_MAX);
+    VAD->Crossings = crossings;
+    Track_Floor(VAD, ms);
+
+    int32_t threshold = VAD->Config.Threshold_dB * 256;
+    if (VAD->Speech) {
+        threshold /= 2;                                     // Hysteresis, trailing syllables are quieter
+    }
+    bool speech = VAD->Elapsed_ms >= Voice_Activity_Settle_ms &&
+                  VAD->Level >= VAD->Config.Min_Level_dBFS * 256 &&
+                  VAD->Level - VAD->Floor >= threshold &&
+                  crossings * 1000 >= 2 * Voice_Activity_Min_Crossing_Hz * ms;
+    VAD->Elapsed_ms += ms;
+
+    if (!VAD->Speech) {
+        VAD->Run_ms = speech ? VAD->Run_ms + ms : 0;
+        if (VAD->Run_ms >= VAD->Config.Onset_ms) {
+            VAD->Speech = true;
+            VAD->Run_ms = 0;
+            return Voice_Activity_Speech_Start;
+        }
+    } else {
+        VAD->Run_ms = speech ? 0 : VAD->Run_ms + ms;
+        if (VAD->Run_ms >= VAD->Config.Hangover_ms) {
+            VAD->Speech = false;
+            VAD->Run_ms = 0;
+            return Voice_Activity_Speech_End;
+        }
+    }
+    return Voice_Activity_None;
+}
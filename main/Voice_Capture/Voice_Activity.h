@@ -0,0 +1,53 @@
+#pragma once
+
+// Streaming voice activity detection on capture frames: high passed frame energy against the minimum of the last
+// couple of seconds, with zero crossings to reject rumble. Free of FreeRTOS, so host_bench/ scores it against
+// labelled clips.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Voice_Activity_Threshold_dB     9                   // Frame level above the noise floor that counts as speech
+#define Voice_Activity_Hangover_ms      800                 // Quiet time after speech before it is declared over
+#define Voice_Activity_Onset_ms         60                  // Speech time before it is declared started
+#define Voice_Activity_Min_Level_dBFS   -55                 // Quieter frames are never speech
+#define Voice_Activity_Settle_ms        100                 // Noise floor is learned, speech is not reported
+#define Voice_Activity_Floor_Blocks     8                   // The floor is the quietest frame of this many blocks
+#define Voice_Activity_Floor_Block_ms   250                 // so it follows a noise step within 2 s
+#define Voice_Activity_Min_Crossing_Hz  100                 // Frames with a lower zero crossing rate are never speech
+#define Voice_Activity_High_Pass_Hz     200                 // Fans, hum and knocks sit below, the first formant above
+#define Voice_Activity_Rate             16000               // Capture_Rate
+
+typedef enum {
+    Voice_Activity_None = 0,
+    Voice_Activity_Speech_Start,
+    Voice_Activity_Speech_End,
+} Voice_Activity_Event;
+
+typedef struct {
+    int16_t Threshold_dB;
+    uint16_t Hangover_ms;
+    uint16_t Onset_ms;
+    int16_t Min_Level_dBFS;
+} Voice_Activity_Config;
+
+typedef struct {
+    Voice_Activity_Config Config;
+    int32_t Floor;                                          // Noise floor, dBFS Q8
+    int32_t Block_Min[Voice_Activity_Floor_Blocks];
+    int32_t Current_Min;
+    uint16_t Block_Elapsed_ms;
+    uint8_t Block;
+    float B0, B1, A1, A2;                                   // Butterworth high pass, B2 == B0
+    float X1, X2, Y1, Y2;                                   // Y1 is also the last sample for the zero crossings
+    int32_t Level;                                          // Last frame, dBFS Q8
+    uint16_t Crossings;                                     // Last frame, zero crossings
+    bool Speech;
+    uint16_t Run_ms;                                        // Speech while idle, quiet while in speech
+    uint32_t Elapsed_ms;
+} Voice_Activity;
+
+void Voice_Activity_Default_Config(Voice_Activity_Config *Config);
+void Voice_Activity_Init(Voice_Activity *VAD, const Voice_Activity_Config *Config);    // NULL for the defaults
+Voice_Activity_Event Voice_Activity_Process(Voice_Activity *VAD, const int16_t *Samples, size_t Count);
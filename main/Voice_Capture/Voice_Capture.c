@@ -0,0 +1,514 @@
+#include "Voice_Capture.h"
+
+#include <string.h>
+
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "PCM5101.h"
+#include "ai_chat_ui.h"
+
+static const char *TAG = "VOICE CAPTURE";
+
+#define Voice_Capture_Read_Timeout  100                     // ms, bounds how long Voice_Capture_Stop() takes effect
+
+static Capture_Frame Frames[Capture_Pool_Frames];           // Preallocated, consumers read these slots in place
+static Capture_Pipeline Pipeline;
+static int16_t Block[Capture_Block_Frames * Audio_Capture_Channels];
+static TaskHandle_t Voice_Capture_Task_Handle;
+static bool Initialized = false;
+
+static volatile bool Listen = false;                        // Voice_Capture_Start() to Voice_Capture_Stop()
+static volatile bool Run = false;                           // The capture task reads the microphone
+static bool Listening = false;                              // The capture task's view of Listen, the consumers follow it
+static volatile bool DSP_Dc_Remove = true;                  // Applied by the capture task between blocks
+static volatile uint16_t DSP_Gain = Capture_Gain_Unity;
+
+static uint32_t Read_Errors = 0;
+static uint32_t Max_Read_us = 0;
+
+static Voice_Activity VAD;                                  // Runs in the capture task, see Voice_Activity_Notify()
+static Voice_Activity_Config VAD_Config;
+static volatile bool VAD_Config_Changed = false;
+static int VAD_Consumer = -1;
+static QueueHandle_t VAD_Events;
+static bool VAD_Heard = false;
+static bool VAD_Timed_Out = false;
+static uint64_t VAD_Busy_Cycles = 0;
+static uint32_t VAD_Frames = 0;
+
+static Voice_Encoder Encoder;                               // Also runs in the capture task, see Voice_Encoder_Notify()
+static int Encoder_Consumer = -1;
+static QueueHandle_t Packets;
+static uint32_t Packets_Sent = 0;
+static uint32_t Packets_Dropped = 0;
+static uint64_t Encoder_Busy_Cycles = 0;
+static uint32_t Encoder_Frames = 0;
+static volatile bool Upload_Enabled = false;                // An uploader drains Packets, see Voice_Capture_Set_Upload()
+static bool Uploading = false;                              // Upload_Enabled as the current listen began
+
+static Echo_Canceller *Echo;                                // Fed by Echo_Reference_Tap(), run by the pipeline
+static volatile bool Echo_Enabled = true;
+static audio_resampler_t Echo_Resampler;                    // Speaker output down to Capture_Rate, in the writing task
+static uint32_t Echo_Rate = 0;
+static int16_t Echo_Mono[Voice_Capture_Tap_Frames];
+static int16_t Echo_Reference[Voice_Capture_Tap_Frames];
+static uint64_t Pipeline_Busy_Cycles = 0;
+
+static Keyword_Spotter Kws;                                 // Runs in the capture task between listens, see Keyword_Notify()
+static int Kws_Consumer = -1;
+static volatile bool Wake_Enabled = false;                  // Capture keeps running while nobody listens
+static atomic_bool Wake_Heard;
+static uint64_t Kws_Busy_Cycles = 0;
+static uint32_t Kws_Frames = 0;
+static uint32_t Wake_Words = 0;
+
+// Counters when the current listen began, for its log
+static struct {
+    uint32_t Frames;
+    uint32_t Dropped;
+    uint32_t Packets;
+    uint32_t Packets_Dropped;
+    int64_t Time_us;
+} Listen_Start;
+
+static void VAD_Post(Voice_Activity_Event Event)
+{
+    if (xQueueSend(VAD_Events, &Event, 0) != pdPASS) {
+        ESP_LOGW(TAG, "Speech event %d lost", Event);
+    }
+}
+
+// Called by the pipeline after each frame it publishes, so detection adds no task and no latency
+static void Voice_Activity_Notify(void *arg)
+{
+    const Capture_Frame *frame;
+    while ((frame = Capture_Ring_Peek(&Pipeline.Ring, VAD_Consumer))) {
+        if (!Listening) {
+            Capture_Ring_Release(&Pipeline.Ring, VAD_Consumer);
+            continue;
+        }
+        uint32_t start = esp_cpu_get_cycle_count();
+        Voice_Activity_Event event = Voice_Activity_Process(&VAD, frame->Samples, Capture_Frame_Samples);
+        VAD_Busy_Cycles += esp_cpu_get_cycle_count() - start;
+        VAD_Frames++;
+        Capture_Ring_Release(&Pipeline.Ring, VAD_Consumer);
+
+        if (event == Voice_Activity_Speech_Start) {
+            VAD_Heard = true;
+            ESP_LOGI(TAG, "Speech started at %lu ms", VAD.Elapsed_ms);
+            VAD_Post(event);
+        } else if (event == Voice_Activity_Speech_End) {
+            ESP_LOGI(TAG, "Speech ended at %lu ms", VAD.Elapsed_ms);
+            VAD_Post(event);
+        } else if (!VAD_Heard && !VAD_Timed_Out && VAD.Elapsed_ms >= Voice_Capture_No_Speech_ms) {
+            ESP_LOGI(TAG, "No speech in %d ms", Voice_Capture_No_Speech_ms);
+            VAD_Timed_Out = true;
+            VAD_Post(Voice_Activity_Speech_End);
+        }
+    }
+}
+
+// Packets are copied into the queue, so the uploader holds at most Voice_Capture_Packet_Depth of them
+static void Voice_Packet_Queue(const Voice_Packet *Packet, void *arg)
+{
+    if (xQueueSend(Packets, Packet, 0) == pdPASS) {
+        Packets_Sent++;
+    } else {
+        Packets_Dropped++;
+    }
+}
+
+static void Voice_Encoder_Notify(void *arg)
+{
+    const Capture_Frame *frame;
+    while ((frame = Capture_Ring_Peek(&Pipeline.Ring, Encoder_Consumer))) {
+        if (!Listening || !Uploading) {
+            Capture_Ring_Release(&Pipeline.Ring, Encoder_Consumer);
+            continue;
+        }
+        uint32_t start = esp_cpu_get_cycle_count();
+        Voice_Encoder_Push(&Encoder, frame->Samples, Capture_Frame_Samples);
+        Encoder_Busy_Cycles += esp_cpu_get_cycle_count() - start;
+        Encoder_Frames++;
+        Capture_Ring_Release(&Pipeline.Ring, Encoder_Consumer);
+    }
+}
+
+// Only between listens: the command after the wake word goes to the uploader, not back into the spotter
+static void Keyword_Notify(void *arg)
+{
+    const Capture_Frame *frame;
+    while ((frame = Capture_Ring_Peek(&Pipeline.Ring, Kws_Consumer))) {
+        if (Listening || !Wake_Enabled) {
+            Capture_Ring_Release(&Pipeline.Ring, Kws_Consumer);
+            continue;
+        }
+        uint32_t start = esp_cpu_get_cycle_count();
+        bool detected = Keyword_Spotter_Process(&Kws, frame->Samples);
+        Kws_Busy_Cycles += esp_cpu_get_cycle_count() - start;
+        Kws_Frames++;
+        Capture_Ring_Release(&Pipeline.Ring, Kws_Consumer);
+
+        if (detected) {
+            Wake_Words++;
+            ESP_LOGI(TAG, "Wake word \"%s\", score %ld of %ld, %llu cycles per frame", Kws.Model->Name, Kws.Score,
+                     Kws.Model->Threshold, Kws_Busy_Cycles / Kws_Frames);
+            Voice_Capture_Start();                          // Listening starts with the next frame, nothing said after the word is lost
+            atomic_store(&Wake_Heard, true);
+        }
+    }
+}
+
+// Runs in whichever task writes the speaker, the player or Voice_Stream, which never write at the same time
+static void Echo_Reference_Tap(const int16_t *Samples, size_t Frames, uint32_t Rate)
+{
+    if (!Run || !Pipeline.Echo) {
+        return;                                             // Reference from before the start is only silence to the canceller
+    }
+    if (Rate != Echo_Rate) {
+        if (audio_resampler_set_input_rate(&Echo_Resampler, Rate) != ESP_OK) {
+            return;
+        }
+        Echo_Rate = Rate;
+    }
+    bool passthrough = audio_resampler_is_passthrough(&Echo_Resampler);
+    while (Frames) {
+        size_t block = (Frames < Voice_Capture_Tap_Frames) ? Frames : Voice_Capture_Tap_Frames;
+        for (size_t n = 0; n < block; n++) {
+            Echo_Mono[n] = (Samples[2 * n] + Samples[2 * n + 1]) / 2;      // What both speakers play, the microphone hears the sum
+        }
+        Samples += block * 2;
+        Frames -= block;
+
+        const int16_t *in = Echo_Mono;
+        size_t left = block;
+        while (left) {
+            size_t used = left;
+            size_t produced;
+            if (passthrough) {
+                memcpy(Echo_Reference, in, left * sizeof(int16_t));
+                produced = left;
+            } else {
+                produced = audio_resampler_process(&Echo_Resampler, in, &used, Echo_Reference, Voice_Capture_Tap_Frames);
+            }
+            Echo_Canceller_Reference(Echo, Echo_Reference, produced);
+            if (used == 0) {
+                break;
+            }
+            in += used;
+            left -= used;
+        }
+    }
+}
+
+// Keeps the filter across listens, it only starts over when echo cancelling is switched
+static void Echo_Select(void)
+{
+    Echo_Canceller *echo = (Echo && Echo_Enabled) ? Echo : NULL;
+    if (echo != Pipeline.Echo) {
+        if (echo) {
+            Echo_Canceller_Reset(echo);
+        }
+        Pipeline.Echo = echo;
+    }
+}
+
+static void Listen_Begin(void)
+{
+    Echo_Select();
+    if (VAD_Config_Changed) {
+        VAD_Config_Changed = false;
+        Voice_Activity_Init(&VAD, &VAD_Config);
+    } else {
+        Voice_Activity_Init(&VAD, &VAD.Config);
+    }
+    VAD_Heard = false;
+    VAD_Timed_Out = false;
+    VAD_Busy_Cycles = 0;
+    VAD_Frames = 0;
+    Encoder_Busy_Cycles = 0;
+    Encoder_Frames = 0;
+    Pipeline_Busy_Cycles = 0;
+    Listen_Start.Frames = atomic_load(&Pipeline.Ring.Head);
+    Listen_Start.Dropped = Pipeline.Ring.Dropped;
+    Listen_Start.Packets = Packets_Sent;
+    Listen_Start.Packets_Dropped = Packets_Dropped;
+    Listen_Start.Time_us = esp_timer_get_time();
+    xQueueReset(Packets);                                   // Also for listens the wake word starts, packets of the last one mean nothing now
+    Uploading = Upload_Enabled;
+    Listening = true;
+}
+
+static void Listen_End(void)
+{
+    Listening = false;
+    if (Uploading) {
+        Voice_Encoder_Finish(&Encoder);                     // The uploader sees Voice_Packet_Last
+        Uploading = false;
+    }
+    Keyword_Spotter_Reset(&Kws);                            // The spotter starts over on what comes after the command
+    uint32_t captured = atomic_load(&Pipeline.Ring.Head) - Listen_Start.Frames;
+    ESP_LOGI(TAG, "Captured %lu frames in %lld ms, %lu dropped, longest read %lu us",
+             captured, (esp_timer_get_time() - Listen_Start.Time_us) / 1000,
+             Pipeline.Ring.Dropped - Listen_Start.Dropped, Max_Read_us);
+    if (captured) {
+        ESP_LOGI(TAG, "Pipeline: %llu cycles per frame, echo cancelling %s",
+                 (Pipeline_Busy_Cycles - VAD_Busy_Cycles - Encoder_Busy_Cycles) / captured, Pipeline.Echo ? "on" : "off");
+    }
+    if (Pipeline.Echo) {
+        ESP_LOGI(TAG, "Echo cancelling: %.1f dB ERLE, delay %s, %lu relocks, %lu blocks bypassed",
+                 Echo_Canceller_Erle(Echo), Echo->Locked ? "found" : "not found", Echo->Relocks, Echo->Bypassed);
+    }
+    if (VAD_Frames) {
+        ESP_LOGI(TAG, "Voice activity detection: %llu cycles per frame",
+                 VAD_Busy_Cycles / VAD_Frames);
+    }
+    if (Encoder_Frames) {
+        ESP_LOGI(TAG, "Encoder: %llu cycles per frame, %lu packets, %lu dropped",
+                 Encoder_Busy_Cycles / Encoder_Frames, Packets_Sent - Listen_Start.Packets,
+                 Packets_Dropped - Listen_Start.Packets_Dropped);
+    }
+}
+
+// Runs while someone listens, and all the time the wake word is on. Listens start and end between two reads
+static void Voice_Capture_Task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!Listen && !Wake_Enabled) {
+            continue;
+        }
+        esp_err_t ret = Audio_Capture_Enable(true);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to enable I2S RX: %s", esp_err_to_name(ret));
+            Listen = false;
+            continue;
+        }
+        Capture_Pipeline_Reset(&Pipeline);
+        Pipeline.Echo = NULL;
+        Echo_Select();
+        Keyword_Spotter_Reset(&Kws);
+        Run = true;
+        int64_t last = esp_timer_get_time();
+
+        while (Listen || Wake_Enabled) {
+            if (Listen != Listening) {
+                if (Listen) {
+                    Listen_Begin();
+                } else {
+                    Listen_End();
+                }
+            }
+            size_t bytes = 0;
+            ret = Audio_Capture_Read(Block, sizeof(Block), &bytes, Voice_Capture_Read_Timeout);
+            int64_t now = esp_timer_get_time();
+            if (now - last > Max_Read_us) {
+                Max_Read_us = now - last;
+            }
+            last = now;
+            if (ret != ESP_OK) {
+                Read_Errors++;
+            }
+            // The player may change the shared clock between tracks, follow it
+            if (!Capture_Pipeline_Set_Input(&Pipeline, Audio_Capture_Rate(), Audio_Capture_Channels, Voice_Capture_Channel)) {
+                ESP_LOGE(TAG, "Unsupported capture rate %lu Hz", Audio_Capture_Rate());
+                Listen = false;
+                Wake_Enabled = false;
+                break;
+            }
+            Pipeline.DSP.Dc_Remove = DSP_Dc_Remove;
+            Pipeline.DSP.Gain = DSP_Gain;
+            uint32_t push_start = esp_cpu_get_cycle_count();
+            Capture_Pipeline_Push(&Pipeline, Block, bytes / (Audio_Capture_Channels * sizeof(int16_t)));
+            Pipeline_Busy_Cycles += esp_cpu_get_cycle_count() - push_start;     // Consumers included, taken out in Listen_End()
+        }
+
+        Run = false;
+        if (Listening) {
+            Listen_End();
+        }
+        Audio_Capture_Enable(false);
+    }
+}
+
+/*-------------------- AI chat voice button --------------------*/
+static void Voice_Button_Start(void)
+{
+    Voice_Capture_Start();
+}
+
+// Also called when voice activity detection hears the end of speech, see voice_event_timer_cb()
+static void Voice_Button_Stop(void)
+{
+    Voice_Capture_Stop();
+    ai_chat_ui_set_voice_state(AI_VOICE_IDLE);              // Nothing turns the speech into a reply yet, hand the button back
+}
+
+static void Voice_Button_Cleanup(void)
+{
+    Voice_Capture_Stop();
+}
+
+void Voice_Capture_Init(void)
+{
+    if (!Capture_Pipeline_Init(&Pipeline, Frames, Capture_Pool_Frames)) {
+        ESP_LOGE(TAG, "Failed to initialize the capture pipeline");
+        return;
+    }
+    Voice_Activity_Init(&VAD, NULL);
+    VAD_Events = xQueueCreate(Voice_Capture_Event_Depth, sizeof(Voice_Activity_Event));
+    VAD_Consumer = Capture_Ring_Attach(&Pipeline.Ring, Voice_Activity_Notify, NULL);
+    if (!VAD_Events || VAD_Consumer < 0) {
+        ESP_LOGE(TAG, "Failed to set up voice activity detection");
+        return;
+    }
+    Voice_Encoder_Init(&Encoder, Voice_Packet_Queue, NULL);
+    Packets = xQueueCreate(Voice_Capture_Packet_Depth, sizeof(Voice_Packet));
+    Encoder_Consumer = Capture_Ring_Attach(&Pipeline.Ring, Voice_Encoder_Notify, NULL);
+    if (!Packets || Encoder_Consumer < 0) {
+        ESP_LOGE(TAG, "Failed to set up the upload encoder");
+        return;
+    }
+    // Internal RAM if it fits, the filters touch every weight for every sample
+    Echo = heap_caps_malloc(sizeof(Echo_Canceller), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!Echo) {
+        Echo = heap_caps_malloc(sizeof(Echo_Canceller), MALLOC_CAP_SPIRAM);
+    }
+    Keyword_Spotter_Init(&Kws, &Keyword_Model_Default);
+    Kws_Consumer = Capture_Ring_Attach(&Pipeline.Ring, Keyword_Notify, NULL);
+    if (Kws_Consumer < 0) {
+        ESP_LOGW(TAG, "No consumer left for the wake word");
+    }
+    if (Echo && audio_resampler_init(&Echo_Resampler, 1, Capture_Rate) == ESP_OK) {
+        Echo_Canceller_Init(Echo);
+        Audio_Set_Output_Tap(Echo_Reference_Tap);
+    } else {
+        ESP_LOGW(TAG, "No echo cancelling, the microphone hears the speaker");
+        heap_caps_free(Echo);
+        Echo = NULL;
+    }
+    if (xTaskCreatePinnedToCore(Voice_Capture_Task, "Voice Capture", 4096, NULL, 4, &Voice_Capture_Task_Handle, 1) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create voice capture task");
+        return;
+    }
+    Initialized = true;
+    ai_chat_ui_register_voice_start_callback(Voice_Button_Start);
+    ai_chat_ui_register_voice_stop_callback(Voice_Button_Stop);
+    ai_chat_ui_register_voice_cleanup_callback(Voice_Button_Cleanup);
+    if (BSP_I2S_DSIN == GPIO_NUM_NC) {
+        ESP_LOGW(TAG, "No microphone on the I2S data input, capture reads silence and the wake word stays off");
+    } else {
+        Voice_Capture_Set_Wake_Word(true);
+    }
+}
+
+void Voice_Capture_Start(void)
+{
+    if (!Initialized) {
+        return;
+    }
+    xQueueReset(VAD_Events);                                // Events of the last capture mean nothing now
+    Listen = true;
+    xTaskNotifyGive(Voice_Capture_Task_Handle);
+}
+
+// Takes effect when the read in progress returns, at most Voice_Capture_Read_Timeout later
+void Voice_Capture_Stop(void)
+{
+    Listen = false;
+}
+
+bool Voice_Capture_Running(void)
+{
+    return Listen;
+}
+
+void Voice_Capture_Set_Wake_Word(bool Enable)
+{
+    if (!Initialized || Kws_Consumer < 0) {
+        return;
+    }
+    Wake_Enabled = Enable;
+    ESP_LOGI(TAG, "Wake word \"%s\" %s", Kws.Model->Name, Enable ? "on" : "off");
+    if (Enable) {
+        xTaskNotifyGive(Voice_Capture_Task_Handle);
+    }
+}
+
+bool Voice_Capture_Take_Wake(void)
+{
+    return atomic_exchange(&Wake_Heard, false);
+}
+
+void Voice_Capture_Set_DSP(bool Dc_Remove, uint16_t Gain)
+{
+    DSP_Dc_Remove = Dc_Remove;
+    DSP_Gain = Gain;
+}
+
+void Voice_Capture_Set_AEC(bool Enable)
+{
+    Echo_Enabled = Enable;
+}
+
+void Voice_Capture_Set_VAD(const Voice_Activity_Config *Config)
+{
+    VAD_Config = *Config;
+    VAD_Config_Changed = true;
+}
+
+bool Voice_Capture_Take_Event(Voice_Activity_Event *Event)
+{
+    return Initialized && xQueueReceive(VAD_Events, Event, 0) == pdPASS;
+}
+
+void Voice_Capture_Set_Upload(bool Enable)
+{
+    Upload_Enabled = Enable;
+}
+
+bool Voice_Capture_Take_Packet(Voice_Packet *Packet, uint32_t Timeout_ms)
+{
+    return Initialized && xQueueReceive(Packets, Packet, pdMS_TO_TICKS(Timeout_ms)) == pdPASS;
+}
+
+int Voice_Capture_Attach(Capture_Notify Notify, void *Arg)
+{
+    return Initialized ? Capture_Ring_Attach(&Pipeline.Ring, Notify, Arg) : -1;
+}
+
+void Voice_Capture_Detach(int Consumer)
+{
+    Capture_Ring_Detach(&Pipeline.Ring, Consumer);
+}
+
+const Capture_Frame *Voice_Capture_Peek(int Consumer)
+{
+    return Capture_Ring_Peek(&Pipeline.Ring, Consumer);
+}
+
+void Voice_Capture_Release(int Consumer)
+{
+    Capture_Ring_Release(&Pipeline.Ring, Consumer);
+}
+
+uint32_t Voice_Capture_Overruns(int Consumer)
+{
+    return Pipeline.Ring.Consumers[Consumer].Overruns;
+}
+
+void Voice_Capture_Get_Stats(Voice_Capture_Stats *Stats)
+{
+    Stats->Frames = atomic_load(&Pipeline.Ring.Head);
+    Stats->Dropped = Pipeline.Ring.Dropped;
+    Stats->Read_Errors = Read_Errors;
+    Stats->Max_Read_us = Max_Read_us;
+    Stats->Packets = Packets_Sent;
+    Stats->Packets_Dropped = Packets_Dropped;
+    Stats->Wake_Words = Wake_Words;
+}
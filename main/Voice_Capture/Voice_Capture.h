@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "Capture_Pipeline.h"
+#include "Voice_Activity.h"
+#include "Voice_Encoder.h"
+#include "Keyword_Spotter.h"
+
+#define Voice_Capture_Channel       0                       // I2S slot the microphone is on
+#define Voice_Capture_No_Speech_ms  8000                    // Listening ends with a speech end event if nobody speaks
+#define Voice_Capture_Event_Depth   4
+#define Voice_Capture_Packet_Depth  16                      // Upload packets queued, about 0.5 s of speech
+#define Voice_Capture_Tap_Frames    256                     // Speaker frames resampled at a time for the echo reference
+
+typedef struct {
+    uint32_t Frames;                                        // Published since Voice_Capture_Init()
+    uint32_t Dropped;                                       // Frames no slot was free for
+    uint32_t Read_Errors;
+    uint32_t Max_Read_us;                                   // Longest gap between two reads returning
+    uint32_t Packets;                                       // Upload packets encoded
+    uint32_t Packets_Dropped;                               // because the uploader fell Voice_Capture_Packet_Depth behind
+    uint32_t Wake_Words;                                    // Heard since Voice_Capture_Init()
+} Voice_Capture_Stats;
+
+void Voice_Capture_Init(void);                              // Also backs the voice button of the AI chat screen
+void Voice_Capture_Start(void);
+void Voice_Capture_Stop(void);
+bool Voice_Capture_Running(void);                           // Listening, from Voice_Capture_Start() or the wake word to Voice_Capture_Stop()
+void Voice_Capture_Set_DSP(bool Dc_Remove, uint16_t Gain);  // Gain is Q8, Capture_Gain_Unity is 0 dB
+void Voice_Capture_Set_VAD(const Voice_Activity_Config *Config);   // Hangover and thresholds, from the next start
+void Voice_Capture_Set_AEC(bool Enable);                    // Cancel the speaker echo, so listening works over a reply. From the next start
+void Voice_Capture_Set_Wake_Word(bool Enable);              // Capture runs all the time and the wake word starts listening. On with a microphone
+bool Voice_Capture_Take_Wake(void);                         // The wake word was heard since the last call, listening has already started
+bool Voice_Capture_Take_Event(Voice_Activity_Event *Event);        // Speech start and end of the current capture
+void Voice_Capture_Set_Upload(bool Enable);                 // On while an uploader drains Voice_Capture_Take_Packet(), from the next start. Off, nothing is encoded
+bool Voice_Capture_Take_Packet(Voice_Packet *Packet, uint32_t Timeout_ms);     // Encoded speech for the uploader
+
+// Frames are shared, not copied: Peek returns the slot itself, which stays valid until Release
+int Voice_Capture_Attach(Capture_Notify Notify, void *Arg);     // Consumer id, -1 if none is free
+void Voice_Capture_Detach(int Consumer);
+const Capture_Frame *Voice_Capture_Peek(int Consumer);
+void Voice_Capture_Release(int Consumer);
+uint32_t Voice_Capture_Overruns(int Consumer);
+void Voice_Capture_Get_Stats(Voice_Capture_Stats *Stats);
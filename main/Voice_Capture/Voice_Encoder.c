@@ -0,0 +1,137 @@
+#include "Voice_Encoder.h"
+
+#include <string.h>
+
+static const int16_t Step_Table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+
+static const int8_t Index_Table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+static inline int32_t Clamp_Sample(int32_t Value)
+{
+    return (Value > 32767) ? 32767 : (Value < -32768) ? -32768 : Value;
+}
+
+static inline int32_t Clamp_Index(int32_t Index)
+{
+    return (Index < 0) ? 0 : (Index > 88) ? 88 : Index;
+}
+
+// Reconstruct exactly as the decoder will, so the predictor never drifts from it
+static inline uint8_t Encode_Sample(int32_t *Predictor, int32_t *Index, int32_t Sample)
+{
+    int32_t step = Step_Table[*Index];
+    int32_t diff = Sample - *Predictor;
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    int32_t delta = step >> 3;
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+        delta += step;
+    }
+    if (diff >= step >> 1) {
+        code |= 2;
+        diff -= step >> 1;
+        delta += step >> 1;
+    }
+    if (diff >= step >> 2) {
+        code |= 1;
+        delta += step >> 2;
+    }
+    *Predictor = Clamp_Sample((code & 8) ? *Predictor - delta : *Predictor + delta);
+    *Index = Clamp_Index(*Index + Index_Table[code]);
+    return code;
+}
+
+static inline int32_t Decode_Sample(int32_t *Predictor, int32_t *Index, uint8_t Code)
+{
+    int32_t step = Step_Table[*Index];
+    int32_t delta = step >> 3;
+    if (Code & 4) delta += step;
+    if (Code & 2) delta += step >> 1;
+    if (Code & 1) delta += step >> 2;
+    *Predictor = Clamp_Sample((Code & 8) ? *Predictor - delta : *Predictor + delta);
+    *Index = Clamp_Index(*Index + Index_Table[Code]);
+    return *Predictor;
+}
+
+static void Send_Packet(Voice_Encoder *Encoder, uint8_t Flags)
+{
+    Voice_Packet *packet = &Encoder->Packet;
+    packet->Sequence = Encoder->Sequence++;
+    packet->Codec = Voice_Codec_IMA_ADPCM;
+    packet->Flags = Flags;
+    packet->Samples = Encoder->Fill;
+    packet->Bytes = (Encoder->Fill == 0) ? 0 : 4 + Encoder->Fill / 2;      // Header sample plus whole nibble pairs
+    if (Encoder->Sink) {
+        Encoder->Sink(packet, Encoder->Arg);
+    }
+    Encoder->Fill = 0;
+}
+
+void Voice_Encoder_Init(Voice_Encoder *Encoder, Voice_Packet_Sink Sink, void *Arg)
+{
+    memset(Encoder, 0, sizeof(*Encoder));
+    Encoder->Sink = Sink;
+    Encoder->Arg = Arg;
+}
+
+void Voice_Encoder_Push(Voice_Encoder *Encoder, const int16_t *Samples, size_t Count)
+{
+    uint8_t *block = Encoder->Packet.Block;
+    for (size_t n = 0; n < Count; n++) {
+        int32_t x = Samples[n];
+        if (Encoder->Fill == 0) {
+            // The block header carries the first sample verbatim and the step index to continue with
+            Encoder->Predictor = x;
+            block[0] = x & 0xFF;
+            block[1] = (x >> 8) & 0xFF;
+            block[2] = Encoder->Index;
+            block[3] = 0;
+            memset(block + 4, 0, Voice_Encoder_Block_Bytes - 4);
+        } else {
+            uint8_t code = Encode_Sample(&Encoder->Predictor, &Encoder->Index, x);
+            uint32_t nibble = Encoder->Fill - 1;
+            block[4 + nibble / 2] |= (nibble & 1) ? code << 4 : code;
+        }
+        if (++Encoder->Fill == Voice_Encoder_Block_Samples) {
+            Send_Packet(Encoder, 0);
+        }
+    }
+}
+
+void Voice_Encoder_Finish(Voice_Encoder *Encoder)
+{
+    Send_Packet(Encoder, Voice_Packet_Last);                            // Possibly empty, it still marks the end
+    Encoder->Sequence = 0;
+    Encoder->Index = 0;
+}
+
+size_t Voice_Packet_Decode(const Voice_Packet *Packet, int16_t *Samples)
+{
+    if (Packet->Codec != Voice_Codec_IMA_ADPCM || Packet->Samples == 0 || Packet->Samples > Voice_Encoder_Block_Samples) {
+        return 0;
+    }
+    const uint8_t *block = Packet->Block;
+    int32_t predictor = (int16_t)(block[0] | block[1] << 8);
+    int32_t index = Clamp_Index(block[2]);
+    Samples[0] = predictor;
+    for (uint32_t n = 1; n < Packet->Samples; n++) {
+        uint32_t nibble = n - 1;
+        uint8_t code = (nibble & 1) ? block[4 + nibble / 2] >> 4 : block[4 + nibble / 2] & 0x0F;
+        Samples[n] = Decode_Sample(&predictor, &index, code);
+    }
+    return Packet->Samples;
+}
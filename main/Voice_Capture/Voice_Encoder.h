@@ -0,0 +1,43 @@
+#pragma once
+
+// Incremental voice encoder for upload: capture frames in, fixed size packets out. Each packet carries one
+// Microsoft IMA ADPCM block (adpcm_ima_wav), 4:1 at 16 kHz, and decodes on its own, so a lost packet costs
+// 32 ms of audio and nothing after it. Free of FreeRTOS, see host_bench/ for ratio and speed.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Voice_Encoder_Block_Bytes       256                 // IMA ADPCM block align, 4 byte header and 504 nibbles
+#define Voice_Encoder_Block_Samples     ((Voice_Encoder_Block_Bytes - 4) * 2 + 1)     // 505, 31.6 ms at 16 kHz
+
+#define Voice_Codec_IMA_ADPCM           1                   // Packet Codec values, leaves room for others
+
+#define Voice_Packet_Last               0x01                // Flags, the end of the utterance
+
+// Sent as is, little endian, 8 byte header and a block that is only short in the last packet
+typedef struct {
+    uint16_t Sequence;                                      // Restarts at 0 every utterance
+    uint8_t Codec;
+    uint8_t Flags;
+    uint16_t Samples;                                       // Samples the block decodes to
+    uint16_t Bytes;                                         // Valid bytes of Block
+    uint8_t Block[Voice_Encoder_Block_Bytes];
+} Voice_Packet;
+
+typedef void (*Voice_Packet_Sink)(const Voice_Packet *Packet, void *Arg);
+
+typedef struct {
+    Voice_Packet_Sink Sink;
+    void *Arg;
+    int32_t Predictor;
+    int32_t Index;                                          // Step table index, carried from block to block
+    uint16_t Fill;                                          // Samples in the packet being built
+    uint16_t Sequence;
+    Voice_Packet Packet;
+} Voice_Encoder;
+
+void Voice_Encoder_Init(Voice_Encoder *Encoder, Voice_Packet_Sink Sink, void *Arg);
+void Voice_Encoder_Push(Voice_Encoder *Encoder, const int16_t *Samples, size_t Count);    // Calls Sink per full packet
+void Voice_Encoder_Finish(Voice_Encoder *Encoder);          // Sends the last packet, then starts a new utterance
+size_t Voice_Packet_Decode(const Voice_Packet *Packet, int16_t *Samples);   // Up to Voice_Encoder_Block_Samples
@@ -0,0 +1,93 @@
+#include "bench_io.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t le32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+static uint16_t le16(const uint8_t *p) { return p[0] | p[1] << 8; }
+
+bool wav_read(const char *path, wav_t *wav)
+{
+    FILE *fp = fopen(path, "rb");
+    if(!fp) {
+        return false;
+    }
+    uint8_t header[12];
+    bool ok = fread(header, 1, 12, fp) == 12 && !memcmp(header, "RIFF", 4) && !memcmp(header + 8, "WAVE", 4);
+    bool fmt = false;
+    memset(wav, 0, sizeof(*wav));
+    while(ok) {
+        uint8_t chunk[8];
+        if(fread(chunk, 1, 8, fp) != 8) {
+            ok = false;
+            break;
+        }
+        uint32_t size = le32(chunk + 4);
+        if(!memcmp(chunk, "fmt ", 4)) {
+            uint8_t f[16];
+            ok = size >= 16 && fread(f, 1, 16, fp) == 16;
+            ok = ok && le16(f) == 1 && le16(f + 14) == 16;      // 16 bit PCM only
+            wav->channels = le16(f + 2);
+            wav->rate = le32(f + 4);
+            fmt = true;
+            fseek(fp, (size - 16 + 1) & ~1u, SEEK_CUR);
+        } else if(!memcmp(chunk, "data", 4) && fmt) {
+            wav->frames = size / (2 * wav->channels);
+            wav->samples = malloc(wav->frames * wav->channels * 2 + 1);
+            wav->frames = fread(wav->samples, 2 * wav->channels, wav->frames, fp);
+            break;
+        } else {
+            fseek(fp, (size + 1) & ~1u, SEEK_CUR);
+        }
+    }
+    fclose(fp);
+    return ok && wav->samples && wav->channels;
+}
+
+void wav_write(const char *path, const int16_t *samples, size_t count, uint32_t rate)
+{
+    FILE *fp = fopen(path, "wb");
+    if(!fp) {
+        fprintf(stderr, "can't write %s\n", path);
+        return;
+    }
+    uint32_t data = count * 2;
+    uint8_t h[44] = "RIFF\0\0\0\0WAVEfmt \x10\0\0\0\x01\0\x01\0\0\0\0\0\0\0\0\0\x02\0\x10\0data";
+    uint32_t riff = 36 + data, byte_rate = rate * 2;
+    memcpy(h + 4, &riff, 4);
+    memcpy(h + 24, &rate, 4);
+    memcpy(h + 28, &byte_rate, 4);
+    memcpy(h + 40, &data, 4);
+    fwrite(h, 1, 44, fp);
+    fwrite(samples, 2, count, fp);
+    fclose(fp);
+}
+
+int read_labels(const char *wav_path, segment_t *labels, int max, const char *name)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s", wav_path);
+    char *dot = strrchr(path, '.');
+    if(!dot || strlen(dot) < 4) {
+        return -1;
+    }
+    strcpy(dot, ".lab");
+    FILE *fp = fopen(path, "r");
+    if(!fp) {
+        return -1;
+    }
+    int count = 0;
+    double start, end;
+    char line[256], label[64];
+    while(count < max && fgets(line, sizeof(line), fp)) {
+        int fields = sscanf(line, "%lf %lf %63s", &start, &end, label);
+        if(fields >= 2 && (!name || (fields == 3 && !strcmp(label, name)))) {
+            labels[count].start_ms = start * 1000 + 0.5;
+            labels[count].end_ms = end * 1000 + 0.5;
+            count++;
+        }
+    }
+    fclose(fp);
+    return count;
+}
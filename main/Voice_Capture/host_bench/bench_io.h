@@ -0,0 +1,27 @@
+#pragma once
+
+// Files the host benches share: 16 bit PCM wav and Audacity label tracks
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_SEGMENTS    128
+
+typedef struct {
+    uint32_t rate;
+    uint32_t channels;
+    int16_t *samples;       // interleaved
+    size_t frames;
+} wav_t;
+
+typedef struct {
+    uint32_t start_ms;
+    uint32_t end_ms;
+} segment_t;
+
+bool wav_read(const char *path, wav_t *wav);        // free(wav->samples) when done
+void wav_write(const char *path, const int16_t *samples, size_t count, uint32_t rate);
+
+// <clip>.lab next to <clip>.wav, only the labels called name unless it is NULL. -1 without a label file
+int read_labels(const char *wav_path, segment_t *labels, int max, const char *name);
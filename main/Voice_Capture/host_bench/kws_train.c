@@ -0,0 +1,509 @@
+/**
+ * Trains the wake word network of Keyword_Spotter and writes it out as Keyword_Model.c.
+ *
+ * The streams are 16 kHz mono wav files with a .lab next to them that labels every wake
+ * word keyword (see make_keyword_clips.py). They go through the capture DSP and the
+ * spotter's own fixed point front end, so the network learns the features the device
+ * computes. A window whose newest row ends just after a wake word is a positive, one
+ * that ends anywhere else a negative, including the windows that hold only the start of
+ * the word. Windows ending a little early or late are left out, firing there is fine.
+ *
+ * The network is trained in float with every feature window shifted by a random level,
+ * then quantized to int8. The threshold is the lowest smoothed score that keeps false
+ * accepts on the training streams at or below -f per hour, replayed through the
+ * quantized model exactly as Keyword_Spotter_Process() scores it.
+ *
+ * usage: kws_train [-o Keyword_Model.c] [-n name] [-e epochs] [-f false accepts/hour] [-s seed] train.wav...
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench_io.h"
+#include "Capture_Pipeline.h"
+#include "Keyword_Spotter.h"
+
+#define USAGE "usage: %s [-o Keyword_Model.c] [-n name] [-e epochs] [-f false accepts/hour] [-s seed] train.wav...\n"
+
+#define FRAME_MS        (Keyword_Hop * 1000 / Keyword_Rate)
+#define EARLY_MS        150     // before the end of a wake word, windows are left out
+#define LATE_MS         160     // after it windows are positives, then left out up to
+#define IGNORE_MS       300
+#define HIT_EARLY_MS    300     // a detection from this far into the word
+#define HIT_LATE_MS     500     // to this long after it is a hit
+#define LEVEL_SPREAD    16      // feature steps of random level per window, 6 dB
+#define BATCH           64
+#define INPUT_SCALE     (1.0f / 64)
+
+static struct {
+    const char *out_path;
+    const char *name;
+    int epochs;
+    double false_per_hour;
+    uint32_t seed;
+} opt = { "Keyword_Model.c", "keyword", 30, 1.0, 1 };
+
+void host_bench_log(char level, const char *tag, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%c %s: ", level, tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static float rng_uniform(void)
+{
+    return (rng() >> 8) * (1.0f / 16777216);
+}
+
+/*-------------------- streams --------------------*/
+
+typedef struct {
+    const char *path;
+    int32_t *log_mel;       // [rows][Keyword_Bands]
+    int8_t *features;
+    uint32_t rows;
+    segment_t keywords[MAX_SEGMENTS];
+    int count;
+} stream_t;
+
+typedef struct {
+    const int8_t *window;   // Keyword_Inputs features, oldest row first
+    bool positive;
+} example_t;
+
+static bool load(stream_t *s, const char *path)
+{
+    wav_t wav;
+    if(!wav_read(path, &wav) || wav.rate != Keyword_Rate || wav.channels != 1) {
+        fprintf(stderr, "%s: not a 16 kHz mono 16 bit wav file\n", path);
+        free(wav.samples);
+        return false;
+    }
+    s->path = path;
+    s->count = read_labels(path, s->keywords, MAX_SEGMENTS, "keyword");
+    if(s->count < 0) {
+        fprintf(stderr, "%s: no .lab file\n", path);
+        free(wav.samples);
+        return false;
+    }
+    Capture_DSP dsp;
+    Capture_DSP_Init(&dsp, true, Capture_Gain_Unity);       // what the capture task does before the spotter
+    Capture_DSP_Process(&dsp, wav.samples, wav.frames);
+
+    static const Keyword_Model front_end = { 0 };          // only the features are wanted
+    static Keyword_Spotter kws;
+    Keyword_Spotter_Init(&kws, &front_end);
+    s->rows = wav.frames / Keyword_Hop;
+    s->log_mel = malloc((size_t)s->rows * Keyword_Bands * sizeof(int32_t));
+    s->features = malloc((size_t)s->rows * Keyword_Bands);
+    for(uint32_t r = 0; r < s->rows; r++) {
+        Keyword_Spotter_Analyze(&kws, wav.samples + (size_t)r * Keyword_Hop, s->log_mel + (size_t)r * Keyword_Bands);
+    }
+    free(wav.samples);
+    return true;
+}
+
+static void quantize_features(stream_t *s, int32_t offset)
+{
+    for(size_t i = 0; i < (size_t)s->rows * Keyword_Bands; i++) {
+        int32_t f = (s->log_mel[i] - offset) >> Keyword_Feature_Shift;
+        s->features[i] = f < -128 ? -128 : f > 127 ? 127 : f;
+    }
+}
+
+// 1 positive, 0 negative, -1 left out, for the window whose newest row is row
+static int label(const stream_t *s, uint32_t row)
+{
+    int32_t end_ms = (row + 1) * FRAME_MS;
+    int result = 0;
+    for(int k = 0; k < s->count; k++) {
+        int32_t after = end_ms - (int32_t)s->keywords[k].end_ms;
+        if(after >= 0 && after <= LATE_MS) {
+            return 1;
+        }
+        if(after >= -EARLY_MS && after <= IGNORE_MS) {
+            result = -1;
+        }
+    }
+    return result;
+}
+
+/*-------------------- network --------------------*/
+
+typedef struct {
+    float w1[Keyword_Hidden][Keyword_Inputs];
+    float b1[Keyword_Hidden];
+    float w2[Keyword_Hidden];
+    float b2;
+} net_t;
+
+static net_t net, grad, adam_m, adam_v;
+
+static float forward(const float *x, float *hidden)
+{
+    float out = net.b2;
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        float sum = net.b1[h];
+        for(int i = 0; i < Keyword_Inputs; i++) {
+            sum += net.w1[h][i] * x[i];
+        }
+        hidden[h] = sum > 0 ? sum : 0;
+        out += net.w2[h] * hidden[h];
+    }
+    return out;
+}
+
+static void window_input(const example_t *e, int shift, float *x)
+{
+    for(int i = 0; i < Keyword_Inputs; i++) {
+        int f = e->window[i] + shift;
+        x[i] = (f < -128 ? -128 : f > 127 ? 127 : f) * INPUT_SCALE;
+    }
+}
+
+static void adam_step(float *p, float *g, float *m, float *v, size_t n, float rate, int t)
+{
+    const float b1 = 0.9f, b2 = 0.999f;
+    float c1 = 1 - powf(b1, t), c2 = 1 - powf(b2, t);
+    for(size_t i = 0; i < n; i++) {
+        m[i] = b1 * m[i] + (1 - b1) * g[i];
+        v[i] = b2 * v[i] + (1 - b2) * g[i] * g[i];
+        p[i] -= rate * (m[i] / c1) / (sqrtf(v[i] / c2) + 1e-8f);
+        g[i] = 0;
+    }
+}
+
+static void train(example_t *examples, size_t count, size_t positives)
+{
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        for(int i = 0; i < Keyword_Inputs; i++) {
+            net.w1[h][i] = (rng_uniform() * 2 - 1) * sqrtf(6.0f / Keyword_Inputs);
+        }
+        net.w2[h] = (rng_uniform() * 2 - 1) * sqrtf(6.0f / Keyword_Hidden);
+    }
+    float pos_weight = (float)(count - positives) / (positives ? positives : 1) / 4;
+    float x[Keyword_Inputs], hidden[Keyword_Hidden];
+    int step = 0;
+    for(int epoch = 0; epoch < opt.epochs; epoch++) {
+        for(size_t i = count - 1; i > 0; i--) {
+            size_t j = rng() % (i + 1);
+            example_t t = examples[i];
+            examples[i] = examples[j];
+            examples[j] = t;
+        }
+        double loss = 0;
+        uint32_t errors = 0;
+        float rate = 1e-3f * (epoch < opt.epochs * 2 / 3 ? 1.0f : 0.2f);
+        for(size_t n = 0; n < count; n++) {
+            const example_t *e = &examples[n];
+            window_input(e, (int)(rng() % (2 * LEVEL_SPREAD + 1)) - LEVEL_SPREAD, x);
+            float z = forward(x, hidden);
+            float p = 1 / (1 + expf(-z));
+            float weight = e->positive ? pos_weight : 1;
+            float d = weight * (p - e->positive);
+            loss += weight * (e->positive ? -logf(p + 1e-7f) : -logf(1 - p + 1e-7f));
+            errors += (z > 0) != e->positive;
+            grad.b2 += d;
+            for(int h = 0; h < Keyword_Hidden; h++) {
+                grad.w2[h] += d * hidden[h];
+                if(hidden[h] <= 0) {
+                    continue;
+                }
+                float dh = d * net.w2[h];
+                grad.b1[h] += dh;
+                for(int i = 0; i < Keyword_Inputs; i++) {
+                    grad.w1[h][i] += dh * x[i];
+                }
+            }
+            if(n % BATCH == BATCH - 1 || n == count - 1) {
+                step++;
+                adam_step((float *)&net, (float *)&grad, (float *)&adam_m, (float *)&adam_v, sizeof(net_t) / sizeof(float),
+                          rate, step);
+            }
+        }
+        fprintf(stderr, "epoch %d: loss %.4f, %u of %zu windows wrong\n", epoch + 1, loss / count, (unsigned)errors, count);
+    }
+}
+
+/*-------------------- quantization --------------------*/
+
+static int8_t q_w1[Keyword_Hidden * Keyword_Inputs];
+static int32_t q_b1[Keyword_Hidden];
+static int8_t q_w2[Keyword_Hidden];
+
+static int8_t clamp8(float v)
+{
+    long q = lrintf(v);
+    return q < -127 ? -127 : q > 127 ? 127 : q;
+}
+
+// Returns output units per logit
+static double quantize(Keyword_Model *model, const example_t *examples, size_t count)
+{
+    float max1 = 0, max2 = 0;
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        for(int i = 0; i < Keyword_Inputs; i++) {
+            max1 = fmaxf(max1, fabsf(net.w1[h][i]));
+        }
+        max2 = fmaxf(max2, fabsf(net.w2[h]));
+    }
+    // hidden sums are features times weights, features are x / INPUT_SCALE
+    double s1 = 127 / max1, a1 = s1 / INPUT_SCALE;
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        for(int i = 0; i < Keyword_Inputs; i++) {
+            q_w1[h * Keyword_Inputs + i] = clamp8(net.w1[h][i] * s1);
+        }
+        q_b1[h] = lrint(net.b1[h] * a1);
+    }
+    // the shift takes the largest hidden sum seen on positives, leaving a little to clip, to int8
+    int32_t largest = 1;
+    for(size_t n = 0; n < count; n++) {
+        if(!examples[n].positive) {
+            continue;
+        }
+        for(int h = 0; h < Keyword_Hidden; h++) {
+            int32_t sum = q_b1[h];
+            for(int i = 0; i < Keyword_Inputs; i++) {
+                sum += q_w1[h * Keyword_Inputs + i] * examples[n].window[i];
+            }
+            largest = sum > largest ? sum : largest;
+        }
+    }
+    int shift = 0;
+    while((largest >> shift) > 127 * 5 / 4) {
+        shift++;
+    }
+    double a2 = a1 / (1 << shift);
+    double s2 = 127 / max2;
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        q_w2[h] = clamp8(net.w2[h] * s2);
+    }
+    model->Name = opt.name;
+    model->Hidden_Weights = q_w1;
+    model->Hidden_Bias = q_b1;
+    model->Hidden_Shift = shift;
+    model->Output_Weights = q_w2;
+    model->Output_Bias = lrint(net.b2 * s2 * a2);
+    return s2 * a2;
+}
+
+/*-------------------- threshold --------------------*/
+
+typedef struct {
+    int32_t *scores;        // smoothed, per row, INT32_MIN until the window is full
+} replay_t;
+
+// Scores every row the way Keyword_Spotter_Process() does, so the threshold is applied to the same numbers
+static void replay(const stream_t *s, const Keyword_Model *model, replay_t *r)
+{
+    r->scores = malloc(s->rows * sizeof(int32_t));
+    int32_t recent[Keyword_Smoothing] = { 0 };
+    for(uint32_t row = 0; row < s->rows; row++) {
+        r->scores[row] = INT32_MIN;
+        if(row + 1 < Keyword_Frames) {
+            continue;
+        }
+        memmove(recent, recent + 1, (Keyword_Smoothing - 1) * sizeof(int32_t));
+        recent[Keyword_Smoothing - 1] = Keyword_Spotter_Score(model, s->features + (size_t)(row + 1 - Keyword_Frames) * Keyword_Bands);
+        if(row + 1 < Keyword_Frames + Keyword_Smoothing - 1) {
+            continue;
+        }
+        int32_t sum = 0;
+        for(int k = 0; k < Keyword_Smoothing; k++) {
+            sum += recent[k];
+        }
+        r->scores[row] = sum / Keyword_Smoothing;
+    }
+}
+
+static void detect(const stream_t *s, const replay_t *r, int32_t threshold, uint32_t *hits, uint32_t *false_accepts)
+{
+    bool found[MAX_SEGMENTS] = { false };
+    uint32_t refractory = 0;
+    for(uint32_t row = 0; row < s->rows; row++) {
+        if(refractory) {
+            refractory--;
+        }
+        if(refractory || r->scores[row] == INT32_MIN || r->scores[row] < threshold) {
+            continue;
+        }
+        refractory = Keyword_Refractory;
+        int32_t at = (row + 1) * FRAME_MS;
+        int k = 0;
+        while(k < s->count && !(at >= (int32_t)s->keywords[k].start_ms + HIT_EARLY_MS &&
+                                at <= (int32_t)s->keywords[k].end_ms + HIT_LATE_MS)) {
+            k++;
+        }
+        if(k == s->count) {
+            (*false_accepts)++;
+        } else if(!found[k]) {
+            found[k] = true;
+            (*hits)++;
+        }
+    }
+}
+
+/*-------------------- output --------------------*/
+
+static bool write_model(const Keyword_Model *model, int files, uint32_t keywords, uint32_t hits, uint32_t false_accepts,
+                        double hours)
+{
+    FILE *fp = fopen(opt.out_path, "w");
+    if(!fp) {
+        fprintf(stderr, "can't write %s\n", opt.out_path);
+        return false;
+    }
+    fprintf(fp, "// Generated by host_bench/kws_train, do not edit. Trained on %d streams, %.1f minutes:\n", files, hours * 60);
+    fprintf(fp, "// %u of %u wake words found, %u false accepts at the threshold below\n\n", (unsigned)hits, (unsigned)keywords,
+            (unsigned)false_accepts);
+    fprintf(fp, "#include \"Keyword_Spotter.h\"\n\n");
+    fprintf(fp, "static const int8_t Hidden_Weights[Keyword_Hidden * Keyword_Inputs] = {\n");
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        fprintf(fp, "    // Hidden unit %d\n", h);
+        for(int f = 0; f < Keyword_Frames; f++) {
+            fprintf(fp, "   ");
+            for(int b = 0; b < Keyword_Bands; b++) {
+                fprintf(fp, " %d,", model->Hidden_Weights[h * Keyword_Inputs + f * Keyword_Bands + b]);
+            }
+            fprintf(fp, "\n");
+        }
+    }
+    fprintf(fp, "};\n\nstatic const int32_t Hidden_Bias[Keyword_Hidden] = {\n");
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        fprintf(fp, "%s%ld,%s", h % 8 ? " " : "    ", (long)model->Hidden_Bias[h], h % 8 == 7 ? "\n" : "");
+    }
+    fprintf(fp, "};\n\nstatic const int8_t Output_Weights[Keyword_Hidden] = {\n");
+    for(int h = 0; h < Keyword_Hidden; h++) {
+        fprintf(fp, "%s%d,%s", h % 16 ? " " : "    ", model->Output_Weights[h], h % 16 == 15 ? "\n" : "");
+    }
+    fprintf(fp, "};\n\nconst Keyword_Model Keyword_Model_Default = {\n");
+    fprintf(fp, "    .Name = \"%s\",\n", model->Name);
+    fprintf(fp, "    .Feature_Offset = %ld,\n", (long)model->Feature_Offset);
+    fprintf(fp, "    .Hidden_Weights = Hidden_Weights,\n");
+    fprintf(fp, "    .Hidden_Bias = Hidden_Bias,\n");
+    fprintf(fp, "    .Hidden_Shift = %u,\n", (unsigned)model->Hidden_Shift);
+    fprintf(fp, "    .Output_Weights = Output_Weights,\n");
+    fprintf(fp, "    .Output_Bias = %ld,\n", (long)model->Output_Bias);
+    fprintf(fp, "    .Threshold = %ld,\n", (long)model->Threshold);
+    fprintf(fp, "};\n");
+    fclose(fp);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int c;
+    while((c = getopt(argc, argv, "o:n:e:f:s:")) != -1) {
+        switch(c) {
+        case 'o': opt.out_path = optarg; break;
+        case 'n': opt.name = optarg; break;
+        case 'e': opt.epochs = atoi(optarg); break;
+        case 'f': opt.false_per_hour = atof(optarg); break;
+        case 's': opt.seed = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if(optind >= argc) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    rng_state = opt.seed ? opt.seed : 1;
+
+    int files = argc - optind;
+    stream_t *streams = calloc(files, sizeof(stream_t));
+    double sum = 0, hours = 0;
+    size_t values = 0;
+    uint32_t keywords = 0;
+    for(int i = 0; i < files; i++) {
+        if(!load(&streams[i], argv[optind + i])) {
+            return 1;
+        }
+        for(size_t n = 0; n < (size_t)streams[i].rows * Keyword_Bands; n++) {
+            sum += streams[i].log_mel[n];
+        }
+        values += (size_t)streams[i].rows * Keyword_Bands;
+        keywords += streams[i].count;
+        hours += streams[i].rows * FRAME_MS / 3.6e6;
+    }
+    // feature 0 is the mean log energy, the int8 range spans 16 octaves around it
+    Keyword_Model model = { .Feature_Offset = lrint(sum / (values ? values : 1)) };
+
+    size_t count = 0, positives = 0;
+    for(int i = 0; i < files; i++) {
+        quantize_features(&streams[i], model.Feature_Offset);
+        count += streams[i].rows;
+    }
+    example_t *examples = malloc(count * sizeof(example_t));
+    count = 0;
+    for(int i = 0; i < files; i++) {
+        for(uint32_t row = Keyword_Frames - 1; row < streams[i].rows; row++) {
+            int l = label(&streams[i], row);
+            if(l < 0) {
+                continue;
+            }
+            examples[count].window = streams[i].features + (size_t)(row + 1 - Keyword_Frames) * Keyword_Bands;
+            examples[count].positive = l;
+            positives += l;
+            count++;
+        }
+    }
+    printf("%d streams, %.1f minutes, %u wake words, %zu windows, %zu positive\n", files, hours * 60, (unsigned)keywords, count,
+           positives);
+    if(!positives) {
+        fprintf(stderr, "no keyword labels\n");
+        return 1;
+    }
+    train(examples, count, positives);
+    double scale = quantize(&model, examples, count);
+
+    replay_t *replays = calloc(files, sizeof(replay_t));
+    int32_t low = INT32_MAX, high = INT32_MIN;
+    for(int i = 0; i < files; i++) {
+        replay(&streams[i], &model, &replays[i]);
+        for(uint32_t row = 0; row < streams[i].rows; row++) {
+            if(replays[i].scores[row] != INT32_MIN) {
+                low = replays[i].scores[row] < low ? replays[i].scores[row] : low;
+                high = replays[i].scores[row] > high ? replays[i].scores[row] : high;
+            }
+        }
+    }
+    // lowest threshold within the false accept budget, stepping a hundredth of the score range
+    uint32_t hits = 0, false_accepts = 0;
+    int32_t step = (high - low) / 100 > 1 ? (high - low) / 100 : 1;
+    for(int32_t threshold = low; threshold <= high; threshold += step) {
+        hits = false_accepts = 0;
+        for(int i = 0; i < files; i++) {
+            detect(&streams[i], &replays[i], threshold, &hits, &false_accepts);
+        }
+        model.Threshold = threshold;
+        if(false_accepts <= opt.false_per_hour * hours) {
+            break;
+        }
+    }
+    printf("quantized: hidden shift %u, threshold %ld (%.2f logit), %u of %u found, %u false accepts (%.1f per hour)\n",
+           (unsigned)model.Hidden_Shift, (long)model.Threshold, model.Threshold / scale, (unsigned)hits, (unsigned)keywords,
+           (unsigned)false_accepts, false_accepts / hours);
+    return write_model(&model, files, keywords, hits, false_accepts, hours) ? 0 : 1;
+}
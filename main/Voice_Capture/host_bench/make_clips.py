@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""
+Generate labelled test clips for the voice activity detector in voice_bench.
+
+    make_clips.py <output dir>
+
+Each clip is 16 kHz mono: noise, an utterance, more noise and usually a second
+utterance. The speech is synthetic, pulse trains through formant resonators for the
+vowels and shaped noise for the fricatives, grouped into syllables and words with the
+pauses of natural speech, so the detector sees realistic gaps it must bridge. Next to
+every <clip>.wav a <clip>.lab in Audacity label format gives the start and end of each
+utterance in seconds. Recordings labelled the same way can be scored alongside them.
+"""
+
+import math
+import os
+import random
+import struct
+import sys
+import wave
+
+RATE = 16000
+SPEECH_DBFS = -26.0         # active speech level
+
+CLIPS = [
+    # name, noise, SNR dB, utterances, extra
+    ('quiet-white-40db', 'white', 40, 2, None),
+    ('white-20db', 'white', 20, 2, None),
+    ('white-10db', 'white', 10, 2, None),
+    ('pink-15db', 'pink', 15, 2, None),
+    ('fan-10db', 'fan', 10, 2, None),
+    ('hum-30db', 'hum', 30, 2, None),
+    ('thumps-20db', 'white', 20, 1, 'thumps'),
+    ('noise-step-15db', 'fan', 15, 1, 'step'),
+    ('long-pauses-20db', 'pink', 20, 1, 'pauses'),
+]
+
+
+def resonator(x, freq, bandwidth):
+    r = math.exp(-math.pi * bandwidth / RATE)
+    a1 = 2 * r * math.cos(2 * math.pi * freq / RATE)
+    a2 = -r * r
+    gain = 1 - r
+    y1 = y2 = 0.0
+    out = []
+    for v in x:
+        y = gain * v + a1 * y1 + a2 * y2
+        out.append(y)
+        y2, y1 = y1, y
+    return out
+
+
+def envelope(n, attack, release):
+    a = max(1, int(attack * RATE))
+    r = max(1, int(release * RATE))
+    env = []
+    for i in range(n):
+        e = 1.0
+        if i < a:
+            e = 0.5 - 0.5 * math.cos(math.pi * i / a)
+        if n - i < r:
+            e *= 0.5 - 0.5 * math.cos(math.pi * (n - i) / r)
+        env.append(e)
+    return env
+
+
+def vowel(rng, seconds):
+    n = int(seconds * RATE)
+    f0 = rng.uniform(100, 220)
+    drift = rng.uniform(-0.25, 0.1)
+    excitation = []
+    phase = 0.0
+    for i in range(n):
+        f = f0 * (1 + drift * i / n)
+        phase += f / RATE
+        if phase >= 1.0:
+            phase -= 1.0
+            excitation.append(1.0)
+        else:
+            excitation.append(0.02 * rng.uniform(-1, 1))
+    f1, f2 = rng.uniform(300, 800), rng.uniform(900, 2200)
+    y = [a + 0.5 * b + 0.25 * c for a, b, c in zip(resonator(excitation, f1, 80),
+                                                   resonator(excitation, f2, 120),
+                                                   resonator(excitation, 2600, 200))]
+    return [v * e for v, e in zip(y, envelope(n, 0.03, 0.06))]
+
+
+def fricative(rng, seconds):
+    n = int(seconds * RATE)
+    x = [rng.gauss(0, 1) for _ in range(n + 2)]
+    y = [x[i + 2] - 2 * x[i + 1] + x[i] for i in range(n)]      # second difference, a gentle high pass
+    return [0.08 * v * e for v, e in zip(y, envelope(n, 0.02, 0.03))]
+
+
+def utterance(rng, long_pauses):
+    out = []
+    for word in range(rng.randint(3, 7)):
+        if word:
+            pause = rng.uniform(0.25, 0.40) if long_pauses else rng.uniform(0.08, 0.25)
+            out += [0.0] * int(pause * RATE)
+        for syllable in range(rng.randint(1, 3)):
+            if syllable:
+                out += [0.0] * int(rng.uniform(0.02, 0.06) * RATE)
+            if rng.random() < 0.35:
+                out += fricative(rng, rng.uniform(0.06, 0.14))
+            out += vowel(rng, rng.uniform(0.12, 0.28))
+    # leave the label tight around the sound, not the silence the envelopes end in
+    threshold = 1e-3 * max(abs(v) for v in out)
+    first = next(i for i, v in enumerate(out) if abs(v) > threshold)
+    last = len(out) - next(i for i, v in enumerate(reversed(out)) if abs(v) > threshold)
+    return out[first:last]
+
+
+def active_rms(x):
+    frame = RATE // 50
+    levels = [sum(v * v for v in x[i:i + frame]) / frame for i in range(0, len(x) - frame, frame)]
+    levels.sort()
+    loud = levels[len(levels) // 2:]                            # ignore the pauses
+    return math.sqrt(sum(loud) / len(loud))
+
+
+def noise(rng, kind, n):
+    if kind == 'white':
+        return [rng.gauss(0, 1) for _ in range(n)]
+    if kind == 'pink':                                          # Paul Kellet's economy filter
+        b0 = b1 = b2 = 0.0
+        out = []
+        for _ in range(n):
+            w = rng.gauss(0, 1)
+            b0 = 0.99765 * b0 + w * 0.0990460
+            b1 = 0.96300 * b1 + w * 0.2965164
+            b2 = 0.57000 * b2 + w * 1.0526913
+            out.append((b0 + b1 + b2 + w * 0.1848) / 3.5)
+        return out
+    if kind == 'fan':                                           # low passed, with a blade tone
+        y = 0.0
+        out = []
+        for i in range(n):
+            y = 0.9 * y + 0.1 * rng.gauss(0, 1)
+            out.append(3 * y + 0.2 * math.sin(2 * math.pi * 120 * i / RATE))
+        return out
+    if kind == 'hum':                                           # mains and harmonics
+        return [sum(math.sin(2 * math.pi * 50 * h * i / RATE) / h for h in (1, 2, 3)) + 0.05 * rng.gauss(0, 1)
+                for i in range(n)]
+    raise ValueError(kind)
+
+
+def rms(x):
+    return math.sqrt(sum(v * v for v in x) / len(x))
+
+
+def make_clip(path, index, kind, snr, count, extra):
+    rng = random.Random(index)
+    speech_gain = 10 ** (SPEECH_DBFS / 20) * 32768
+    parts = [[0.0] * int(rng.uniform(1.0, 2.0) * RATE)]
+    labels = []
+    pos = len(parts[0])
+    for u in range(count):
+        if u:
+            gap = [0.0] * int(rng.uniform(2.0, 3.0) * RATE)
+            parts.append(gap)
+            pos += len(gap)
+        speech = utterance(rng, extra == 'pauses')
+        scale = speech_gain / active_rms(speech)
+        speech = [v * scale for v in speech]
+        labels.append((pos / RATE, (pos + len(speech)) / RATE))
+        parts.append(speech)
+        pos += len(speech)
+    parts.append([0.0] * int(3.0 * RATE))
+    signal = [v for part in parts for v in part]
+
+    n = len(signal)
+    bed = noise(rng, kind, n)
+    noise_gain = speech_gain * 10 ** (-snr / 20) / rms(bed)
+    if extra == 'step':                                         # the fan starts half way through the lead in
+        start = int(labels[0][0] * RATE / 2)
+        bed = [0.05 * v if i < start else v for i, v in enumerate(bed)]
+    mix = [s + noise_gain * b for s, b in zip(signal, bed)]
+    if extra == 'thumps':                                       # knocks on the table, loud but below 100 Hz
+        for t in (0.4, 0.8, labels[0][1] + 1.0, labels[0][1] + 2.0):
+            at = int(t * RATE)
+            for i in range(int(0.15 * RATE)):
+                if at + i < n:
+                    mix[at + i] += 6000 * math.exp(-i / (0.03 * RATE)) * math.sin(2 * math.pi * 40 * i / RATE)
+
+    with wave.open(path + '.wav', 'wb') as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(RATE)
+        w.writeframes(b''.join(struct.pack('<h', max(-32768, min(32767, int(round(v))))) for v in mix))
+    with open(path + '.lab', 'w') as f:
+        for start, end in labels:
+            f.write('%.3f\t%.3f\tspeech\n' % (start, end))
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        sys.exit(2)
+    out = sys.argv[1]
+    os.makedirs(out, exist_ok=True)
+    for index, (name, kind, snr, count, extra) in enumerate(CLIPS):
+        make_clip(os.path.join(out, name), index, kind, snr, count, extra)
+        print(name)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+Generate microphone and speaker reference pairs for the echo canceller in voice_bench.
+
+    make_echo_pairs.py <output dir>
+
+For every scenario <pair>.wav is what the microphone hears: the far end reply played
+through a simulated speaker and room, near end speech in some scenarios, and a noise bed.
+<pair>.ref.wav is the reference the firmware feeds the canceller, the reply as written
+to I2S, and <pair>.near.wav the near end speech alone. <pair>.lab labels the near end
+speech in Audacity label format. All three are 16 kHz mono.
+
+The room is a sparse impulse response: the direct path after a short acoustic delay and
+reflections decaying over the tail. Scenarios cover a tail longer than the filter, echo
+louder than the reply, double talk, a speaker nonlinearity and an output underrun that
+drops 80 ms from the reference, which moves the delay the canceller has to find.
+"""
+
+import math
+import os
+import random
+import struct
+import sys
+import wave
+
+from make_clips import RATE, active_rms, noise, utterance
+
+REPLY_DBFS = -20.0          # far end level written to the speaker
+NEAR_DBFS = -30.0           # near end speech at the microphone
+
+PAIRS = [
+    # name, acoustic delay ms, tail ms, echo gain, near end, extra
+    ('direct', 12, 10, 0.5, False, None),
+    ('reverb', 12, 60, 0.5, False, None),
+    ('loud', 8, 10, 2.0, False, None),
+    ('double-talk', 12, 10, 0.5, True, None),
+    ('underrun', 12, 10, 0.5, False, 'gap'),
+    ('clipping', 12, 10, 0.5, False, 'clip'),
+    ('noisy', 12, 10, 0.5, False, 'noise'),
+]
+
+
+def room(rng, delay_ms, tail_ms, gain):
+    taps = {int(delay_ms * RATE / 1000): gain}
+    tail = int(tail_ms * RATE / 1000)
+    for _ in range(48):                                 # reflections, an exponential decay over the tail
+        t = rng.uniform(0.05, 1.0)
+        at = int(delay_ms * RATE / 1000) + 1 + int(t * tail)
+        taps[at] = taps.get(at, 0.0) + gain * 0.35 * math.exp(-4 * t) * rng.choice((-1, 1))
+    return sorted(taps.items())
+
+
+def convolve(x, taps):
+    y = [0.0] * len(x)
+    for lag, h in taps:
+        for i in range(lag, len(x)):
+            y[i] += h * x[i - lag]
+    return y
+
+
+def speech(rng, seconds, dbfs, gaps):
+    out = [0.0] * int(0.3 * RATE)
+    while len(out) < seconds * RATE:
+        u = utterance(rng, False)
+        scale = 10 ** (dbfs / 20) * 32768 / active_rms(u)
+        out += [v * scale for v in u]
+        out += [0.0] * int(rng.uniform(*gaps) * RATE)
+    return out[:int(seconds * RATE)]
+
+
+def write(path, x):
+    with wave.open(path, 'wb') as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(RATE)
+        w.writeframes(b''.join(struct.pack('<h', max(-32768, min(32767, int(round(v))))) for v in x))
+
+
+def make_pair(path, index, delay_ms, tail_ms, gain, near_end, extra):
+    rng = random.Random(100 + index)
+    seconds = 8.0
+    n = int(seconds * RATE)
+    reply = speech(rng, seconds, REPLY_DBFS, (0.1, 0.4))
+    played = reply
+    reference = reply
+    if extra == 'gap':                                  # the writer fell behind, I2S played zeros it never saw
+        at, gap = int(4.0 * RATE), int(0.08 * RATE)
+        played = reply[:at] + [0.0] * gap + reply[at:n - gap]
+        reference = reply[:n - gap]
+    speaker = played
+    if extra == 'clip':
+        speaker = [20000 * math.tanh(v / 12000) for v in played]
+    echo = convolve(speaker, room(rng, delay_ms, tail_ms, gain))
+
+    near = [0.0] * n
+    labels = []
+    if near_end:
+        for start in (2.5, 5.5):                        # both over the reply, one long enough to matter
+            u = utterance(rng, False)
+            scale = 10 ** (NEAR_DBFS / 20) * 32768 / active_rms(u)
+            at = int(start * RATE)
+            for i, v in enumerate(u[:n - at]):
+                near[at + i] = v * scale
+            labels.append((start, min(seconds, start + len(u) / RATE)))
+
+    level = 10 ** (-40 / 20) * 32768 if extra == 'noise' else 10 ** (-70 / 20) * 32768
+    bed = noise(rng, 'fan' if extra == 'noise' else 'white', n)
+    bed_rms = math.sqrt(sum(v * v for v in bed) / n)
+    mic = [e + s + level * b / bed_rms for e, s, b in zip(echo, near, bed)]
+
+    write(path + '.wav', mic)
+    write(path + '.ref.wav', reference)
+    write(path + '.near.wav', near)
+    with open(path + '.lab', 'w') as f:
+        for start, end in labels:
+            f.write('%.3f\t%.3f\tnear\n' % (start, end))
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        sys.exit(2)
+    out = sys.argv[1]
+    os.makedirs(out, exist_ok=True)
+    for index, pair in enumerate(PAIRS):
+        make_pair(os.path.join(out, pair[0]), index, *pair[1:])
+        print(pair[0])
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""
+Generate labelled streams for the wake word spotter, to train it with kws_train and
+score it with voice_bench -k.
+
+    make_keyword_clips.py <output dir>
+
+Writes <output dir>/train/ and <output dir>/test/, different speakers and noise in each.
+Every stream is 16 kHz mono: a noise bed with the wake word, other speech, and near
+misses (the word cut short, its syllables reordered, a vowel changed) at random gaps.
+Half the wake words run straight into a command, the way people talk to the device.
+Next to every <stream>.wav a <stream>.lab in Audacity label format gives the start and
+end of each wake word, labelled keyword, and of the other speech, labelled speech.
+
+The wake word is synthetic, three syllables with gliding formants, said by speakers
+with different pitch, vocal tract length, tempo and level. Recordings of the real word
+labelled the same way drop into either directory.
+"""
+
+import math
+import os
+import random
+import struct
+import sys
+import wave
+
+from make_clips import RATE, SPEECH_DBFS, active_rms, envelope, fricative, noise, rms, utterance
+
+# syllables of the wake word: onset, seconds, F1 and F2 glides in Hz
+SYLLABLES = [
+    ('breath', 0.20, (650, 420), (1700, 2300)),
+    ('burst', 0.15, (780, 740), (1250, 1150)),
+    (None, 0.20, (360, 330), (2250, 1900)),
+]
+
+STREAMS = {
+    # directory: streams, seconds each, first seed
+    'train': (96, 45, 1000),
+    'test': (16, 60, 5000),
+}
+
+
+def glide_resonator(x, f_from, f_to, bandwidth):
+    r = math.exp(-math.pi * bandwidth / RATE)
+    y1 = y2 = 0.0
+    out = []
+    n = len(x)
+    for i, v in enumerate(x):
+        f = f_from + (f_to - f_from) * i / n
+        y = (1 - r) * v + 2 * r * math.cos(2 * math.pi * f / RATE) * y1 - r * r * y2
+        out.append(y)
+        y2, y1 = y1, y
+    return out
+
+
+def voiced(rng, speaker, seconds, f1, f2, fall):
+    n = int(seconds * speaker['tempo'] * RATE)
+    excitation = []
+    phase = 0.0
+    for i in range(n):
+        phase += speaker['f0'] * (1 - fall * i / n) / RATE
+        if phase >= 1.0:
+            phase -= 1.0
+            excitation.append(1.0)
+        else:
+            excitation.append(0.02 * rng.uniform(-1, 1))
+    scale = speaker['tract']
+    jitter = [rng.uniform(0.95, 1.05) for _ in range(4)]
+    y = [a + 0.5 * b + 0.25 * c for a, b, c in zip(
+        glide_resonator(excitation, f1[0] * scale * jitter[0], f1[1] * scale * jitter[1], 80),
+        glide_resonator(excitation, f2[0] * scale * jitter[2], f2[1] * scale * jitter[3], 120),
+        glide_resonator(excitation, 2700 * scale, 2700 * scale, 200))]
+    return [v * e for v, e in zip(y, envelope(n, 0.03, 0.05))]
+
+
+def onset(rng, kind):
+    if kind == 'breath':                                        # a soft h, noise through the vowel's own resonance
+        x = [rng.gauss(0, 1) for _ in range(int(0.06 * RATE))]
+        y = glide_resonator(x, 1800, 2200, 600)
+        return [0.3 * v * e for v, e in zip(y, envelope(len(y), 0.02, 0.01))]
+    if kind == 'burst':                                         # a k, a short click and a gap before voicing
+        return [0.0] * int(0.04 * RATE) + fricative(rng, 0.025) + [0.0] * int(0.01 * RATE)
+    return []
+
+
+def keyword(rng, speaker, syllables=SYLLABLES):
+    out = []
+    for index, (start, seconds, f1, f2) in enumerate(syllables):
+        if index:
+            out += [0.0] * int(rng.uniform(0.01, 0.04) * RATE)
+        out += onset(rng, start)
+        out += voiced(rng, speaker, seconds, f1, f2, 0.15 if index == len(syllables) - 1 else 0.0)
+    return out
+
+
+def near_miss(rng, speaker):
+    kind = rng.choice(['cut', 'tail', 'reorder', 'vowel'])
+    if kind == 'cut':
+        return keyword(rng, speaker, SYLLABLES[:2])
+    if kind == 'tail':
+        return keyword(rng, speaker, SYLLABLES[1:])
+    if kind == 'reorder':
+        return keyword(rng, speaker, [SYLLABLES[2], SYLLABLES[0], SYLLABLES[1]])
+    changed = list(SYLLABLES)
+    changed[2] = (None, 0.20, (700, 650), (1100, 1000))
+    return keyword(rng, speaker, changed)
+
+
+def make_stream(path, seed, seconds):
+    rng = random.Random(seed)
+    speakers = [{'f0': rng.uniform(95, 250), 'tract': rng.uniform(0.85, 1.2), 'tempo': rng.uniform(0.8, 1.2)}
+                for _ in range(3)]
+    speech_gain = 10 ** (SPEECH_DBFS / 20) * 32768
+    n = int(seconds * RATE)
+    signal = [0.0] * n
+    labels = []
+    pos = int(rng.uniform(0.5, 1.5) * RATE)
+    while True:
+        speaker = rng.choice(speakers)
+        pick = rng.random()
+        parts = []
+        if pick < 0.4:
+            parts.append(('keyword', keyword(rng, speaker)))
+            if rng.random() < 0.5:                              # the command right after
+                parts.append(('speech', [0.0] * int(rng.uniform(0.05, 0.3) * RATE) + utterance(rng, False)))
+        elif pick < 0.6:
+            parts.append(('speech', near_miss(rng, speaker)))
+        else:
+            parts.append(('speech', utterance(rng, False)))
+        level = speech_gain * 10 ** (rng.uniform(-8, 6) / 20)
+        total = sum(len(p) for _, p in parts)
+        if pos + total + RATE // 2 > n:
+            break
+        for name, part in parts:
+            scale = level / active_rms([v for v in part if v] or [1.0])
+            lead = next((i for i, v in enumerate(part) if v), 0)
+            for i, v in enumerate(part):
+                signal[pos + i] += v * scale
+            labels.append(((pos + lead) / RATE, (pos + len(part)) / RATE, name))
+            pos += len(part)
+        pos += int(rng.uniform(0.4, 2.0) * RATE)
+
+    kind = rng.choice(['white', 'pink', 'fan', 'hum'])
+    snr = rng.uniform(5, 30)
+    bed = noise(rng, kind, n)
+    noise_gain = speech_gain * 10 ** (-snr / 20) / rms(bed)
+    mix = [s + noise_gain * b for s, b in zip(signal, bed)]
+
+    with wave.open(path + '.wav', 'wb') as w:
+        w.setnchannels(1)
+        w.setsampwidth(2)
+        w.setframerate(RATE)
+        w.writeframes(b''.join(struct.pack('<h', max(-32768, min(32767, int(round(v))))) for v in mix))
+    with open(path + '.lab', 'w') as f:
+        for start, end, name in labels:
+            f.write('%.3f\t%.3f\t%s\n' % (start, end, name))
+    return kind, snr, sum(1 for label in labels if label[2] == 'keyword')
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        sys.exit(2)
+    for directory, (count, seconds, seed) in STREAMS.items():
+        out = os.path.join(sys.argv[1], directory)
+        os.makedirs(out, exist_ok=True)
+        for index in range(count):
+            name = 'stream-%02d' % (index + 1)
+            kind, snr, keywords = make_stream(os.path.join(out, name), seed + index, seconds)
+            print('%s/%s: %s %.0f dB, %d keywords' % (directory, name, kind, snr, keywords))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,694 @@
+/**
+ * Host bench for the capture pipeline, a wav file stands in for the microphone.
+ *
+ * The file is pushed in Capture_Block_Frames blocks, the size the capture task reads
+ * from I2S, and two consumers drain the ring: one after every block and one only every
+ * -s blocks, which is how overruns are provoked. Each consumer checks the frame sequence
+ * numbers against the drop counters, so the run fails if a frame goes missing unnoticed.
+ *
+ * With -v the fast consumer also runs the voice activity detector. When a clip has a
+ * .lab file next to it (see make_clips.py) each labelled utterance is matched with the
+ * speech the detector found, and the start and end latencies are reported; the end
+ * latency is how long after the last word the recording would stop.
+ *
+ * With -e the fast consumer also feeds the upload encoder; the packets are decoded again
+ * to report the compression ratio, encode time per frame and the SNR of the round trip.
+ *
+ * With -a the pipeline also cancels speaker echo, with <clip>.ref.wav as the reference (see
+ * make_echo_pairs.py). The reference is fed in player sized bursts, -d ms ahead of the
+ * microphone like the I2S TX queue keeps it. Reported are the echo return loss enhancement
+ * (ERLE) where only the far end plays, how soon it passes 10 dB, and with <clip>.near.wav the
+ * near end to residual ratio before and after cancelling where the near end talks.
+ *
+ * With -k the fast consumer also runs the wake word spotter. Detections are matched with
+ * the keyword labels of the .lab file (see make_keyword_clips.py): a detection from 300 ms
+ * into a wake word to 500 ms after it is a hit, any other a false accept. Reported are the
+ * misses, false accepts per hour, how long after the word the detection came and the time
+ * per frame, the budget the spotter takes of the capture core.
+ *
+ * usage: voice_bench [-s slow] [-g gain] [-c channel] [-n] [-o out.wav] [-v] [-h hangover] [-t threshold] [-e]
+ *                    [-a] [-d lead] [-k] input.wav...
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench_io.h"
+#include "Capture_Pipeline.h"
+#include "Voice_Activity.h"
+#include "Voice_Encoder.h"
+#include "Echo_Canceller.h"
+#include "Keyword_Spotter.h"
+
+#define USAGE "usage: %s [-s slow] [-g gain] [-c channel] [-n] [-o out.wav] [-v] [-h hangover] [-t threshold] [-e] [-a] [-d lead] [-k] input.wav...\n"
+
+static struct {
+    uint32_t slow;
+    uint32_t channel;
+    uint16_t gain;
+    bool dc_remove;
+    const char *out_path;
+    bool vad;
+    Voice_Activity_Config vad_config;
+    bool encode;
+    bool echo;
+    uint32_t echo_lead_ms;
+    bool kws;
+} opt;
+
+void host_bench_log(char level, const char *tag, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%c %s: ", level, tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*-------------------- voice activity --------------------*/
+
+#define NOT_ENDED       UINT32_MAX
+
+typedef struct {
+    Voice_Activity vad;
+    segment_t found[MAX_SEGMENTS];  // times the events were raised
+    int count;
+    double busy;
+    uint32_t frames;
+} vad_run_t;
+
+static struct {
+    uint32_t utterances, missed, unended, false_starts, splits, matched;
+    double start_sum, end_sum, end_max, busy;
+    uint32_t frames;
+} vad_total;
+
+static void vad_frame(vad_run_t *v, const Capture_Frame *frame)
+{
+    double start = now_us();
+    Voice_Activity_Event event = Voice_Activity_Process(&v->vad, frame->Samples, Capture_Frame_Samples);
+    v->busy += now_us() - start;
+    v->frames++;
+    uint32_t at = (frame->Sequence + 1) * (Capture_Frame_Samples * 1000 / Capture_Rate);    // end of the frame
+    if(event == Voice_Activity_Speech_Start && v->count < MAX_SEGMENTS) {
+        v->found[v->count].start_ms = at;
+        v->found[v->count].end_ms = NOT_ENDED;
+        v->count++;
+    } else if(event == Voice_Activity_Speech_End && v->count) {
+        v->found[v->count - 1].end_ms = at;
+    }
+}
+
+static void vad_score(const char *path, vad_run_t *v, uint32_t clip_ms)
+{
+    printf("  vad: %.2f us/frame, %d speech segments\n", v->busy / (v->frames ? v->frames : 1), v->count);
+    vad_total.busy += v->busy;
+    vad_total.frames += v->frames;
+
+    segment_t labels[MAX_SEGMENTS];
+    int count = read_labels(path, labels, MAX_SEGMENTS, NULL);
+    if(count < 0) {
+        for(int j = 0; j < v->count; j++) {
+            printf("    %.2f - %.2f s\n", v->found[j].start_ms / 1000.0,
+                   (v->found[j].end_ms == NOT_ENDED ? clip_ms : v->found[j].end_ms) / 1000.0);
+        }
+        return;
+    }
+
+    // a detection covers an utterance when the speech it was raised for overlaps the label
+    bool used[MAX_SEGMENTS] = { false };
+    for(int i = 0; i < count; i++) {
+        int first = -1, last = -1;
+        for(int j = 0; j < v->count; j++) {
+            uint32_t start = v->found[j].start_ms - v->vad.Config.Onset_ms;
+            uint32_t end = v->found[j].end_ms == NOT_ENDED ? clip_ms : v->found[j].end_ms;
+            if(start < labels[i].end_ms && end > labels[i].start_ms) {
+                first = first < 0 ? j : first;
+                last = j;
+                used[j] = true;
+            }
+        }
+        vad_total.utterances++;
+        if(first < 0) {
+            printf("    utterance %d (%.2f - %.2f s): missed\n", i + 1, labels[i].start_ms / 1000.0,
+                   labels[i].end_ms / 1000.0);
+            vad_total.missed++;
+            continue;
+        }
+        int start_latency = (int)v->found[first].start_ms - (int)labels[i].start_ms;
+        vad_total.splits += last - first;
+        if(v->found[last].end_ms == NOT_ENDED) {
+            printf("    utterance %d: start %+d ms, never ended\n", i + 1, start_latency);
+            vad_total.unended++;
+            continue;
+        }
+        int end_latency = (int)v->found[last].end_ms - (int)labels[i].end_ms;
+        printf("    utterance %d: start %+d ms, end %+d ms%s\n", i + 1, start_latency, end_latency,
+               last > first ? ", split" : "");
+        vad_total.matched++;
+        vad_total.start_sum += start_latency;
+        vad_total.end_sum += end_latency;
+        if(end_latency > vad_total.end_max) {
+            vad_total.end_max = end_latency;
+        }
+    }
+    for(int j = 0; j < v->count; j++) {
+        if(!used[j]) {
+            printf("    false start at %.2f s\n", v->found[j].start_ms / 1000.0);
+            vad_total.false_starts++;
+        }
+    }
+}
+
+/*-------------------- upload encoder --------------------*/
+
+typedef struct {
+    Voice_Encoder encoder;
+    int16_t *decoded;
+    size_t decoded_count;
+    size_t capacity;
+    uint32_t packets;
+    uint32_t wire_bytes;    // header and valid block bytes
+    bool bad_sequence;
+    bool last_seen;
+    double busy;
+    uint32_t frames;
+} enc_run_t;
+
+static struct {
+    double pcm_bytes, wire_bytes, busy, noise, signal;
+    uint32_t frames;
+} enc_total;
+
+static void enc_sink(const Voice_Packet *packet, void *arg)
+{
+    enc_run_t *e = arg;
+    if(packet->Sequence != e->packets || e->last_seen) {
+        e->bad_sequence = true;
+    }
+    e->last_seen = packet->Flags & Voice_Packet_Last;
+    e->packets++;
+    e->wire_bytes += offsetof(Voice_Packet, Block) + packet->Bytes;
+    if(e->decoded_count + Voice_Encoder_Block_Samples <= e->capacity) {
+        e->decoded_count += Voice_Packet_Decode(packet, e->decoded + e->decoded_count);
+    }
+}
+
+static void enc_frame(enc_run_t *e, const Capture_Frame *frame)
+{
+    double start = now_us();
+    Voice_Encoder_Push(&e->encoder, frame->Samples, Capture_Frame_Samples);
+    e->busy += now_us() - start;
+    e->frames++;
+}
+
+static bool enc_score(enc_run_t *e, const int16_t *pcm, size_t count)
+{
+    Voice_Encoder_Finish(&e->encoder);
+    double signal = 0, noise = 0;
+    for(size_t n = 0; n < count && n < e->decoded_count; n++) {
+        double d = (double)pcm[n] - e->decoded[n];
+        signal += (double)pcm[n] * pcm[n];
+        noise += d * d;
+    }
+    bool ok = e->decoded_count == count && !e->bad_sequence && e->last_seen;
+    printf("  adpcm: %u packets, %.2f:1, %.1f KB/s, %.2f us/frame, snr %.1f dB%s\n", (unsigned)e->packets,
+           count * 2.0 / e->wire_bytes, e->wire_bytes * (double)Capture_Rate / count / 1000,
+           e->busy / (e->frames ? e->frames : 1), 10 * log10(signal / (noise ? noise : 1)),
+           ok ? "" : ", FAILED: packets do not decode to the frames");
+    enc_total.pcm_bytes += count * 2.0;
+    enc_total.wire_bytes += e->wire_bytes;
+    enc_total.busy += e->busy;
+    enc_total.frames += e->frames;
+    enc_total.signal += signal;
+    enc_total.noise += noise;
+    return ok;
+}
+
+/*-------------------- echo canceller --------------------*/
+
+#define ECHO_BURST      418     // 16 kHz samples per write of a 1152 frame mp3 frame at 44.1 kHz
+
+static struct {
+    double far_mic, far_out, steady_mic, steady_out, near_before, residual_before, residual_after;
+    uint32_t files, converged;
+    double converge_ms;
+} echo_total;
+
+// With .wav replaced by suffix
+static bool sibling(const char *wav_path, const char *suffix, wav_t *wav)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s", wav_path);
+    char *dot = strrchr(path, '.');
+    if(!dot || strlen(dot) < 4 || dot - path + strlen(suffix) >= sizeof(path)) {
+        return false;
+    }
+    strcpy(dot, suffix);
+    return wav_read(path, wav) && wav->rate == Capture_Rate && wav->channels == 1;
+}
+
+static void echo_feed(Echo_Canceller *echo, const wav_t *ref, size_t *fed, size_t mic_through)
+{
+    size_t target = mic_through + opt.echo_lead_ms * Capture_Rate / 1000;
+    while(*fed < target && *fed < ref->frames) {
+        size_t n = ref->frames - *fed < ECHO_BURST ? ref->frames - *fed : ECHO_BURST;
+        Echo_Canceller_Reference(echo, ref->samples + *fed, n);
+        *fed += n;
+    }
+}
+
+// 20 ms frames where the near end is silent and echo is audible measure ERLE, the rest how the near end survived
+static void echo_score(const Echo_Canceller *echo, const wav_t *mic, const int16_t *out, size_t count, const wav_t *near)
+{
+    const size_t frame = Capture_Frame_Samples;
+    const double audible = pow(10, -50 / 10.0) * 32768.0 * 32768.0 * frame;
+    double far_mic = 0, far_out = 0, steady_mic = 0, steady_out = 0, near_sig = 0, before = 0, after = 0;
+    double window_mic = 0, window_out = 0, converged_ms = -1, first_echo_ms = -1;
+    uint32_t window = 0;
+    for(size_t f = 0; (f + 1) * frame <= count && (f + 1) * frame <= mic->frames; f++) {
+        double m = 0, o = 0, s = 0, rb = 0, ra = 0;
+        for(size_t i = f * frame; i < (f + 1) * frame; i++) {
+            double v = near && i < near->frames ? near->samples[i] : 0;
+            m += (double)mic->samples[i] * mic->samples[i];
+            o += (double)out[i] * out[i];
+            s += v * v;
+            rb += (mic->samples[i] - v) * (mic->samples[i] - v);
+            ra += (out[i] - v) * (out[i] - v);
+        }
+        double at_ms = f * 20.0;
+        if(s > 0) {
+            near_sig += s;
+            before += rb;
+            after += ra;
+            continue;
+        }
+        if(m < audible) {
+            continue;
+        }
+        if(first_echo_ms < 0) {
+            first_echo_ms = at_ms;
+        }
+        if(at_ms >= 1000) {                     // give the delay search and the filter a second
+            far_mic += m;
+            far_out += o;
+        }
+        if(at_ms >= 3000) {                     // and what is left once they settled
+            steady_mic += m;
+            steady_out += o;
+        }
+        window_mic += m;
+        window_out += o;
+        if(++window == 25) {                    // half a second of echo
+            if(converged_ms < 0 && window_mic > 10 * window_out) {
+                converged_ms = at_ms - first_echo_ms;
+            }
+            window = 0;
+            window_mic = window_out = 0;
+        }
+    }
+    printf("  echo: erle %.1f dB after 1 s, %.1f dB after 3 s, 10 dB %s", 10 * log10(far_mic / (far_out ? far_out : 1)),
+           10 * log10(steady_mic / (steady_out ? steady_out : 1)), converged_ms < 0 ? "never" : "");
+    if(converged_ms >= 0) {
+        printf("within %.0f ms", converged_ms);
+        echo_total.converged++;
+        echo_total.converge_ms += converged_ms;
+    }
+    printf(", delay %s, %u relocks\n        filter copies %u, restores %u, blocks bypassed %u",
+           echo->Locked ? "locked" : "not found", (unsigned)echo->Relocks, (unsigned)echo->Copies,
+           (unsigned)echo->Restores, (unsigned)echo->Bypassed);
+    if(near_sig > 0) {
+        printf("\n        near end to residual %.1f dB -> %.1f dB", 10 * log10(near_sig / before), 10 * log10(near_sig / after));
+        echo_total.near_before += near_sig;
+        echo_total.residual_before += before;
+        echo_total.residual_after += after;
+    }
+    printf("\n");
+    echo_total.files++;
+    echo_total.far_mic += far_mic;
+    echo_total.far_out += far_out;
+    echo_total.steady_mic += steady_mic;
+    echo_total.steady_out += steady_out;
+}
+
+/*-------------------- wake word --------------------*/
+
+#define KWS_HIT_EARLY_MS    300
+#define KWS_HIT_LATE_MS     500
+
+typedef struct {
+    Keyword_Spotter kws;
+    uint32_t found_ms[MAX_SEGMENTS];
+    int count;
+    double busy;
+    uint32_t frames;
+} kws_run_t;
+
+static struct {
+    uint32_t keywords, hits, false_accepts, frames;
+    double latency_sum, latency_max, busy, seconds;
+} kws_total;
+
+static void kws_frame(kws_run_t *k, const Capture_Frame *frame)
+{
+    double start = now_us();
+    bool detected = Keyword_Spotter_Process(&k->kws, frame->Samples);
+    k->busy += now_us() - start;
+    k->frames++;
+    if(detected && k->count < MAX_SEGMENTS) {
+        k->found_ms[k->count++] = (frame->Sequence + 1) * (Capture_Frame_Samples * 1000 / Capture_Rate);
+    }
+}
+
+static void kws_score(const char *path, kws_run_t *k, double seconds)
+{
+    printf("  kws: %.2f us/frame, %d detections\n", k->busy / (k->frames ? k->frames : 1), k->count);
+    kws_total.busy += k->busy;
+    kws_total.frames += k->frames;
+    kws_total.seconds += seconds;
+
+    segment_t labels[MAX_SEGMENTS];
+    int count = read_labels(path, labels, MAX_SEGMENTS, "keyword");
+    if(count < 0) {
+        for(int j = 0; j < k->count; j++) {
+            printf("    wake word at %.2f s\n", k->found_ms[j] / 1000.0);
+        }
+        return;
+    }
+    bool used[MAX_SEGMENTS] = { false };
+    for(int i = 0; i < count; i++) {
+        int found = -1;
+        for(int j = 0; j < k->count && found < 0; j++) {
+            if(!used[j] && k->found_ms[j] >= labels[i].start_ms + KWS_HIT_EARLY_MS &&
+               k->found_ms[j] <= labels[i].end_ms + KWS_HIT_LATE_MS) {
+                found = j;
+            }
+        }
+        kws_total.keywords++;
+        if(found < 0) {
+            printf("    wake word %d (%.2f - %.2f s): missed\n", i + 1, labels[i].start_ms / 1000.0, labels[i].end_ms / 1000.0);
+            continue;
+        }
+        used[found] = true;
+        int latency = (int)k->found_ms[found] - (int)labels[i].end_ms;
+        kws_total.hits++;
+        kws_total.latency_sum += latency;
+        if(latency > kws_total.latency_max) {
+            kws_total.latency_max = latency;
+        }
+    }
+    for(int j = 0; j < k->count; j++) {
+        if(!used[j]) {
+            printf("    false accept at %.2f s\n", k->found_ms[j] / 1000.0);
+            kws_total.false_accepts++;
+        }
+    }
+}
+
+/*-------------------- consumers --------------------*/
+
+typedef struct {
+    vad_run_t *vad;
+    enc_run_t *enc;
+    kws_run_t *kws;
+} stages_t;
+
+typedef struct {
+    int id;
+    uint32_t period;        // drain every period blocks
+    uint32_t frames;
+    uint32_t gaps;          // frames missing from the sequence
+    uint32_t next;
+    uint32_t max_pending;
+    bool foreign;           // a frame was not a pool slot
+} consumer_t;
+
+static void drain(Capture_Pipeline *p, consumer_t *c, int16_t *out, size_t *out_count, const stages_t *stages)
+{
+    uint32_t pending = Capture_Ring_Pending(&p->Ring, c->id);
+    if(pending > c->max_pending) {
+        c->max_pending = pending;
+    }
+    const Capture_Frame *frame;
+    while((frame = Capture_Ring_Peek(&p->Ring, c->id))) {
+        if(frame < p->Ring.Frames || frame >= p->Ring.Frames + p->Ring.Count) {
+            c->foreign = true;
+        }
+        c->gaps += frame->Sequence - c->next;
+        c->next = frame->Sequence + 1;
+        if(out) {
+            memcpy(out + *out_count, frame->Samples, sizeof(frame->Samples));
+            *out_count += Capture_Frame_Samples;
+        }
+        if(stages && stages->vad) {
+            vad_frame(stages->vad, frame);
+        }
+        if(stages && stages->enc) {
+            enc_frame(stages->enc, frame);
+        }
+        if(stages && stages->kws) {
+            kws_frame(stages->kws, frame);
+        }
+        c->frames++;
+        Capture_Ring_Release(&p->Ring, c->id);
+    }
+}
+
+static bool run(const char *path)
+{
+    uint32_t channel = opt.channel;
+    wav_t wav;
+    if(!wav_read(path, &wav)) {
+        fprintf(stderr, "%s: not a 16 bit PCM wav file\n", path);
+        return false;
+    }
+    if(channel >= wav.channels) {
+        channel = 0;
+    }
+
+    static Capture_Frame frames[Capture_Pool_Frames];
+    Capture_Pipeline *p = malloc(sizeof(Capture_Pipeline));
+    if(!Capture_Pipeline_Init(p, frames, Capture_Pool_Frames) ||
+       !Capture_Pipeline_Set_Input(p, wav.rate, wav.channels, channel)) {
+        fprintf(stderr, "%s: unsupported input %u Hz\n", path, (unsigned)wav.rate);
+        free(wav.samples);
+        free(p);
+        return false;
+    }
+    p->DSP.Dc_Remove = opt.dc_remove;
+    p->DSP.Gain = opt.gain;
+
+    wav_t ref = { 0 }, near = { 0 };
+    bool has_near = false;
+    size_t ref_fed = 0;
+    if(opt.echo) {
+        if(!sibling(path, ".ref.wav", &ref) || wav.rate != Capture_Rate) {
+            fprintf(stderr, "%s: echo cancelling needs 16 kHz audio and a 16 kHz mono .ref.wav\n", path);
+            Capture_Pipeline_Free(p);
+            free(p);
+            free(wav.samples);
+            return false;
+        }
+        has_near = sibling(path, ".near.wav", &near);
+        p->Echo = malloc(sizeof(Echo_Canceller));
+        Echo_Canceller_Init(p->Echo);
+    }
+
+    consumer_t fast = { .id = Capture_Ring_Attach(&p->Ring, NULL, NULL), .period = 1 };
+    consumer_t lazy = { .id = opt.slow ? Capture_Ring_Attach(&p->Ring, NULL, NULL) : -1, .period = opt.slow };
+    size_t out_capacity = (size_t)((double)wav.frames * Capture_Rate / wav.rate) + Capture_Frame_Samples;
+    int16_t *out = malloc(out_capacity * sizeof(int16_t));
+
+    stages_t stages = { NULL, NULL, NULL };
+    if(opt.vad) {
+        stages.vad = calloc(1, sizeof(vad_run_t));
+        Voice_Activity_Init(&stages.vad->vad, &opt.vad_config);
+    }
+    if(opt.encode) {
+        stages.enc = calloc(1, sizeof(enc_run_t));
+        stages.enc->capacity = out_capacity + Voice_Encoder_Block_Samples;
+        stages.enc->decoded = malloc(stages.enc->capacity * sizeof(int16_t));
+        Voice_Encoder_Init(&stages.enc->encoder, enc_sink, stages.enc);
+    }
+    if(opt.kws) {
+        stages.kws = calloc(1, sizeof(kws_run_t));
+        Keyword_Spotter_Init(&stages.kws->kws, &Keyword_Model_Default);
+    }
+    size_t out_count = 0;
+
+    double busy = 0, worst = 0;
+    uint32_t blocks = 0;
+    for(size_t pos = 0; pos < wav.frames; pos += Capture_Block_Frames, blocks++) {
+        size_t n = wav.frames - pos < Capture_Block_Frames ? wav.frames - pos : Capture_Block_Frames;
+        if(p->Echo) {
+            echo_feed(p->Echo, &ref, &ref_fed, pos + n);
+        }
+        double start = now_us();
+        Capture_Pipeline_Push(p, wav.samples + pos * wav.channels, n);
+        double t = now_us() - start;
+        busy += t;
+        if(t > worst) {
+            worst = t;
+        }
+        drain(p, &fast, out, &out_count, &stages);
+        if(lazy.id >= 0 && blocks % lazy.period == lazy.period - 1) {
+            drain(p, &lazy, NULL, NULL, NULL);
+        }
+    }
+    if(lazy.id >= 0) {
+        drain(p, &lazy, NULL, NULL, NULL);
+    }
+
+    // statistics of the chosen input channel against the frames the consumers saw
+    double in_sum = 0, out_sum = 0, out_sq = 0;
+    uint32_t clipped = 0;
+    for(size_t n = 0; n < wav.frames; n++) {
+        in_sum += wav.samples[n * wav.channels + channel];
+    }
+    size_t settled = out_count > Capture_Rate ? Capture_Rate / 2 : 0;  // skip the high pass settling
+    for(size_t n = settled; n < out_count; n++) {
+        out_sum += out[n];
+        out_sq += (double)out[n] * out[n];
+        clipped += out[n] == 32767 || out[n] == -32768;
+    }
+    size_t measured = out_count - settled ? out_count - settled : 1;
+
+    // every drop is a gap in the sequence, or came after the last frame published
+    uint32_t published = (uint32_t)atomic_load(&p->Ring.Head);
+    uint32_t produced = published + p->Ring.Dropped;
+    bool ok = !fast.foreign && !lazy.foreign && fast.frames == published &&
+              fast.gaps + (produced - fast.next) == p->Ring.Dropped &&
+              (lazy.id < 0 || lazy.gaps + (produced - lazy.next) == p->Ring.Dropped);
+    double audio_s = (double)wav.frames / wav.rate;
+    printf("%s: %u Hz x%u -> %u frames (%.1f s)\n", path, (unsigned)wav.rate, (unsigned)wav.channels,
+           (unsigned)published, audio_s);
+    printf("  %.2f us/frame, worst block %.1f us, %.0fx real time\n",
+           busy / (published ? published : 1), worst, audio_s * 1e6 / (busy ? busy : 1));
+    printf("  dc in %.1f out %.1f, rms out %.1f, %u clipped\n",
+           in_sum / (wav.frames ? wav.frames : 1), out_sum / measured, sqrt(out_sq / measured), (unsigned)clipped);
+    printf("  dropped %u, fast: overruns %u, gaps %u, max pending %u",
+           (unsigned)p->Ring.Dropped, (unsigned)p->Ring.Consumers[fast.id].Overruns, (unsigned)fast.gaps,
+           (unsigned)fast.max_pending);
+    if(lazy.id >= 0) {
+        printf("; slow: overruns %u, gaps %u, max pending %u", (unsigned)p->Ring.Consumers[lazy.id].Overruns,
+               (unsigned)lazy.gaps, (unsigned)lazy.max_pending);
+    }
+    printf("\n  %s\n", ok ? "ok" : "FAILED: sequence numbers disagree with the drop counters");
+    if(stages.vad) {
+        vad_score(path, stages.vad, (uint32_t)(audio_s * 1000));
+        free(stages.vad);
+    }
+    if(stages.kws) {
+        kws_score(path, stages.kws, audio_s);
+        free(stages.kws);
+    }
+    if(stages.enc) {
+        ok &= enc_score(stages.enc, out, out_count);
+        free(stages.enc->decoded);
+        free(stages.enc);
+    }
+
+    if(p->Echo) {
+        echo_score(p->Echo, &wav, out, out_count, has_near ? &near : NULL);
+        free(p->Echo);
+        free(ref.samples);
+        free(near.samples);
+    }
+
+    if(opt.out_path) {
+        wav_write(opt.out_path, out, out_count, Capture_Rate);
+    }
+    Capture_Pipeline_Free(p);
+    free(p);
+    free(out);
+    free(wav.samples);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    opt.gain = Capture_Gain_Unity;
+    opt.dc_remove = true;
+    Voice_Activity_Default_Config(&opt.vad_config);
+    int c;
+    opt.echo_lead_ms = 75;
+    while((c = getopt(argc, argv, "s:g:c:no:vh:t:ead:k")) != -1) {
+        switch(c) {
+        case 's': opt.slow = atoi(optarg); break;
+        case 'g': opt.gain = atoi(optarg); break;
+        case 'c': opt.channel = atoi(optarg); break;
+        case 'n': opt.dc_remove = false; break;
+        case 'o': opt.out_path = optarg; break;
+        case 'v': opt.vad = true; break;
+        case 'h': opt.vad = true; opt.vad_config.Hangover_ms = atoi(optarg); break;
+        case 't': opt.vad = true; opt.vad_config.Threshold_dB = atoi(optarg); break;
+        case 'e': opt.encode = true; break;
+        case 'a': opt.echo = true; break;
+        case 'd': opt.echo = true; opt.echo_lead_ms = atoi(optarg); break;
+        case 'k': opt.kws = true; break;
+        default:
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+    if(optind >= argc) {
+        fprintf(stderr, USAGE, argv[0]);
+        return 2;
+    }
+    bool ok = true;
+    for(int i = optind; i < argc; i++) {
+        ok &= run(argv[i]);
+    }
+    if(vad_total.utterances) {
+        printf("vad, threshold %d dB, hangover %u ms: %u utterances, %u missed, %u never ended, %u split, %u false starts\n",
+               opt.vad_config.Threshold_dB, (unsigned)opt.vad_config.Hangover_ms, (unsigned)vad_total.utterances, (unsigned)vad_total.missed,
+               (unsigned)vad_total.unended, (unsigned)vad_total.splits, (unsigned)vad_total.false_starts);
+        if(vad_total.matched) {
+            printf("  start %+.0f ms mean, end %+.0f ms mean, %+.0f ms worst, %.2f us/frame\n",
+                   vad_total.start_sum / vad_total.matched, vad_total.end_sum / vad_total.matched,
+                   vad_total.end_max, vad_total.busy / vad_total.frames);
+        }
+    }
+    if(enc_total.frames) {
+        printf("adpcm: %.2f:1, %.2f us/frame, snr %.1f dB over all files\n", enc_total.pcm_bytes / enc_total.wire_bytes,
+               enc_total.busy / enc_total.frames, 10 * log10(enc_total.signal / (enc_total.noise ? enc_total.noise : 1)));
+    }
+    if(kws_total.keywords || kws_total.frames) {
+        double hours = kws_total.seconds / 3600;
+        printf("kws, model %s: %u of %u wake words found, %u false accepts in %.1f min (%.1f per hour)\n",
+               Keyword_Model_Default.Name, (unsigned)kws_total.hits, (unsigned)kws_total.keywords,
+               (unsigned)kws_total.false_accepts, kws_total.seconds / 60, kws_total.false_accepts / (hours ? hours : 1));
+        printf("  detected %+.0f ms mean, %+.0f ms worst after the word, %.2f us/frame\n",
+               kws_total.latency_sum / (kws_total.hits ? kws_total.hits : 1), kws_total.latency_max,
+               kws_total.busy / (kws_total.frames ? kws_total.frames : 1));
+    }
+    if(echo_total.files) {
+        printf("echo: erle %.1f dB after 1 s, %.1f dB after 3 s over all files, 10 dB within %.0f ms mean in %u of %u",
+               10 * log10(echo_total.far_mic / (echo_total.far_out ? echo_total.far_out : 1)),
+               10 * log10(echo_total.steady_mic / (echo_total.steady_out ? echo_total.steady_out : 1)),
+               echo_total.converge_ms / (echo_total.converged ? echo_total.converged : 1),
+               (unsigned)echo_total.converged, (unsigned)echo_total.files);
+        if(echo_total.near_before > 0) {
+            printf(", near end to residual %.1f dB -> %.1f dB", 10 * log10(echo_total.near_before / echo_total.residual_before),
+                   10 * log10(echo_total.near_before / echo_total.residual_after));
+        }
+        printf("\n");
+    }
+    return ok ? 0 : 1;
+}
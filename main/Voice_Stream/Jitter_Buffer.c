@@ -0,0 +1,111 @@
+#include "Jitter_Buffer.h"
+
+#include <string.h>
+
+bool Jitter_Buffer_Init(Jitter_Buffer *Buffer, uint8_t *Data, uint32_t Size)
+{
+    if (!Data || Size < 2 || (Size & 1)) {
+        return false;
+    }
+    memset(Buffer, 0, sizeof(*Buffer));
+    Buffer->Data = Data;
+    Buffer->Size = Size;
+    atomic_init(&Buffer->Head, 0);
+    atomic_init(&Buffer->Tail, 0);
+    atomic_init(&Buffer->Ended, false);
+    return true;
+}
+
+void Jitter_Buffer_Reset(Jitter_Buffer *Buffer, uint32_t Prebuffer_Samples)
+{
+    atomic_store(&Buffer->Head, 0);
+    atomic_store(&Buffer->Tail, 0);
+    atomic_store(&Buffer->Ended, false);
+    uint32_t prebuffer = Prebuffer_Samples * sizeof(int16_t);
+    Buffer->Prebuffer = (prebuffer > Buffer->Size) ? Buffer->Size : prebuffer;     // A full buffer always starts
+    Buffer->Started = false;
+    Buffer->Starved = false;
+    Buffer->Underruns = 0;
+    Buffer->Silence = 0;
+}
+
+size_t Jitter_Buffer_Write(Jitter_Buffer *Buffer, const void *Data, size_t Bytes)
+{
+    uint32_t head = atomic_load_explicit(&Buffer->Head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&Buffer->Tail, memory_order_acquire);
+    uint32_t space = Buffer->Size - (head - tail);
+    if (Bytes > space) {
+        Bytes = space;
+    }
+    uint32_t offset = head % Buffer->Size;
+    uint32_t first = Buffer->Size - offset;
+    if (first > Bytes) {
+        first = Bytes;
+    }
+    memcpy(Buffer->Data + offset, Data, first);
+    memcpy(Buffer->Data, (const uint8_t *)Data + first, Bytes - first);
+    atomic_store_explicit(&Buffer->Head, head + Bytes, memory_order_release);
+    return Bytes;
+}
+
+void Jitter_Buffer_End(Jitter_Buffer *Buffer)
+{
+    atomic_store_explicit(&Buffer->Ended, true, memory_order_release);
+}
+
+uint32_t Jitter_Buffer_Level(Jitter_Buffer *Buffer)
+{
+    uint32_t head = atomic_load_explicit(&Buffer->Head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&Buffer->Tail, memory_order_relaxed);
+    return (head - tail) / sizeof(int16_t);                 // Half a sample stays until its other byte arrives
+}
+
+uint32_t Jitter_Buffer_Space(Jitter_Buffer *Buffer)
+{
+    uint32_t head = atomic_load_explicit(&Buffer->Head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&Buffer->Tail, memory_order_acquire);
+    return Buffer->Size - (head - tail);
+}
+
+// Short blocks are never held back once playing: the samples there are play now and silence fills the rest,
+// so a late chunk stretches the reply by the gap instead of restarting the prebuffer
+Jitter_Buffer_State Jitter_Buffer_Read(Jitter_Buffer *Buffer, int16_t *Samples, size_t Count)
+{
+    bool ended = atomic_load_explicit(&Buffer->Ended, memory_order_acquire);    // Before Head, so no sample is missed
+    uint32_t level = Jitter_Buffer_Level(Buffer);
+    if (!Buffer->Started) {
+        if ((level == 0 || level * sizeof(int16_t) < Buffer->Prebuffer) && !ended) {
+            memset(Samples, 0, Count * sizeof(int16_t));
+            return Jitter_Buffer_Buffering;
+        }
+        Buffer->Started = true;
+    }
+    if (level == 0 && ended) {
+        memset(Samples, 0, Count * sizeof(int16_t));
+        return Jitter_Buffer_Drained;
+    }
+
+    size_t take = (level < Count) ? level : Count;
+    uint32_t tail = atomic_load_explicit(&Buffer->Tail, memory_order_relaxed);
+    uint32_t offset = tail % Buffer->Size;
+    uint32_t bytes = take * sizeof(int16_t);
+    uint32_t first = Buffer->Size - offset;
+    if (first > bytes) {
+        first = bytes;
+    }
+    memcpy(Samples, Buffer->Data + offset, first);
+    memcpy((uint8_t *)Samples + first, Buffer->Data, bytes - first);
+    atomic_store_explicit(&Buffer->Tail, tail + bytes, memory_order_release);
+    memset(Samples + take, 0, (Count - take) * sizeof(int16_t));
+
+    if (take == Count || ended) {
+        Buffer->Starved = false;
+        return Jitter_Buffer_Playing;
+    }
+    if (!Buffer->Starved) {
+        Buffer->Underruns++;
+    }
+    Buffer->Starved = true;
+    Buffer->Silence += Count - take;
+    return Jitter_Buffer_Underrun;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// Reply audio between the network and the speaker, independent of FreeRTOS so it also builds on the host,
+// see host_bench/. One writer appends chunks as they arrive, one reader pulls fixed blocks at the output rate.
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    Jitter_Buffer_Buffering,                                // Silence, the prebuffer is not full yet
+    Jitter_Buffer_Playing,                                  // Samples, padded with silence only at the end
+    Jitter_Buffer_Underrun,                                 // Samples ran out mid reply, the rest of the block is silence
+    Jitter_Buffer_Drained,                                  // The reply has ended and every sample was read
+} Jitter_Buffer_State;
+
+// Bytes are 16 bit little endian mono samples. Chunks may split a sample, Head only counts whole ones to the reader.
+typedef struct {
+    uint8_t *Data;
+    uint32_t Size;                                          // Bytes, even
+    atomic_uint_fast32_t Head;                              // Bytes written since the reply began
+    atomic_uint_fast32_t Tail;                              // Bytes read, always even
+    atomic_bool Ended;                                      // No more chunks for this reply
+    uint32_t Prebuffer;                                     // Bytes to hold before playing starts
+    bool Started;                                           // Reader side, the prebuffer was reached once
+    bool Starved;                                           // Reader side, the last block ran short
+    uint32_t Underruns;                                     // Times the samples ran out mid reply
+    uint32_t Silence;                                       // Samples of silence stretched into the reply
+} Jitter_Buffer;
+
+bool Jitter_Buffer_Init(Jitter_Buffer *Buffer, uint8_t *Data, uint32_t Size);
+void Jitter_Buffer_Reset(Jitter_Buffer *Buffer, uint32_t Prebuffer_Samples);      // Between replies, while neither side runs
+size_t Jitter_Buffer_Write(Jitter_Buffer *Buffer, const void *Data, size_t Bytes);  // Bytes taken, short when full
+void Jitter_Buffer_End(Jitter_Buffer *Buffer);
+Jitter_Buffer_State Jitter_Buffer_Read(Jitter_Buffer *Buffer, int16_t *Samples, size_t Count);  // Always fills Count
+uint32_t Jitter_Buffer_Level(Jitter_Buffer *Buffer);        // Whole samples waiting to be read
+uint32_t Jitter_Buffer_Space(Jitter_Buffer *Buffer);        // Bytes a write would take now
@@ -0,0 +1,278 @@
+#include "Voice_Stream.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "audio_resample.h"
+#include "PCM5101.h"
+
+static const char *TAG = "VOICE STREAM";
+
+#define Voice_Stream_Max_Rate       48000
+#define Voice_Stream_Block_Samples  (Voice_Stream_Max_Rate * Voice_Stream_Block_ms / 1000)
+#define Voice_Stream_Out_Frames     512                     // Resampler output per pass, stereo after the gain
+#define Voice_Stream_Write_Timeout  100                     // ms, bounds how long Voice_Stream_Abort() takes effect
+
+static Jitter_Buffer Buffer;
+static audio_resampler_t Resampler;
+static uint32_t Output_Rate = 0;
+static int16_t Block[Voice_Stream_Block_Samples];
+static int16_t Mono[Voice_Stream_Out_Frames];
+static int16_t Stereo[Voice_Stream_Out_Frames * 2];
+static TaskHandle_t Voice_Stream_Task_Handle;
+static QueueHandle_t Events;
+static bool Initialized = false;
+
+static volatile bool Active = false;                        // Cleared to stop the reply playing
+static volatile bool Busy = false;                          // A reply is between Voice_Stream_Begin() and its end
+static uint32_t Stream_Rate = 16000;
+static uint32_t Block_Samples = 0;
+static volatile uint32_t Prebuffer_ms = Voice_Stream_Prebuffer_ms;
+static bool Music_Held = false;                             // The music was playing when the reply paused it
+static volatile bool Replacing = false;                     // Voice_Stream_Begin() ends the reply, the music stays paused for the next
+
+static int64_t Begin_us = 0;
+static int64_t First_Chunk_us = 0;                          // 0 until it happens
+static int64_t First_Audio_us = 0;
+static int64_t Writer_Wait_us = 0;
+static Voice_Stream_Stats Last_Stats;
+
+static void Post_Event(Voice_Stream_Event Event)
+{
+    if (xQueueSend(Events, &Event, 0) != pdPASS) {
+        ESP_LOGW(TAG, "Event queue full, event %d lost", Event);
+    }
+}
+
+// Mono reply samples to the stereo 16 bit the I2S port runs at, with the music volume
+static void Play_Block(const int16_t *Samples, size_t Count)
+{
+    int32_t gain = (int32_t)Volume * 32768 / Volume_MAX;    // Q15, same curve as Volume_adjustment()
+    while (Count > 0 && Active) {
+        size_t consumed = Count;
+        size_t frames;
+        if (audio_resampler_is_passthrough(&Resampler)) {
+            frames = consumed = (Count < Voice_Stream_Out_Frames) ? Count : Voice_Stream_Out_Frames;
+            memcpy(Mono, Samples, frames * sizeof(int16_t));
+        } else {
+            frames = audio_resampler_process(&Resampler, Samples, &consumed, Mono, Voice_Stream_Out_Frames);
+        }
+        Samples += consumed;
+        Count -= consumed;
+        for (size_t n = 0; n < frames; n++) {
+            int16_t s = (Mono[n] * gain) >> 15;
+            Stereo[2 * n] = s;
+            Stereo[2 * n + 1] = s;
+        }
+        // A timeout wrote part of the block, the rest follows once I2S frees room
+        const int16_t *out = Stereo;
+        size_t left = frames * 2 * sizeof(int16_t);
+        while (left > 0 && Active) {
+            size_t written = 0;
+            esp_err_t ret = Audio_Stream_Write(out, left, &written, Voice_Stream_Write_Timeout);
+            out += written / sizeof(int16_t);
+            left -= written;
+            if (ret != ESP_OK && ret != ESP_ERR_TIMEOUT) {
+                ESP_LOGE(TAG, "I2S write failed: %s", esp_err_to_name(ret));
+                Active = false;
+            }
+        }
+    }
+}
+
+static void Music_Release(void)
+{
+    if (Music_Held) {
+        Music_Held = false;
+        Music_resume();
+    }
+}
+
+static void Voice_Stream_Task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!Busy) {
+            continue;
+        }
+        bool speaking = false;
+        Jitter_Buffer_State state = Jitter_Buffer_Buffering;
+        while (Active) {
+            state = Jitter_Buffer_Read(&Buffer, Block, Block_Samples);
+            if (state == Jitter_Buffer_Drained) {
+                break;
+            }
+            if (state == Jitter_Buffer_Buffering) {
+                // Nothing is written yet, I2S plays its auto cleared buffers, so no silence queues up ahead of the reply
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Voice_Stream_Block_ms));
+                continue;
+            }
+            if (!speaking) {
+                speaking = true;
+                First_Audio_us = esp_timer_get_time();
+                Post_Event(Voice_Stream_Speaking);
+            }
+            Play_Block(Block, Block_Samples);               // Paces the loop at the output rate, underruns included
+        }
+
+        Last_Stats.First_Chunk_ms = First_Chunk_us ? (First_Chunk_us - Begin_us) / 1000 : 0;
+        Last_Stats.First_Audio_ms = First_Audio_us ? (First_Audio_us - Begin_us) / 1000 : 0;
+        Last_Stats.Duration_ms = (uint64_t)atomic_load(&Buffer.Tail) / sizeof(int16_t) * 1000 / Stream_Rate;
+        Last_Stats.Underruns = Buffer.Underruns;
+        Last_Stats.Silence_ms = (uint64_t)Buffer.Silence * 1000 / Stream_Rate;
+        Last_Stats.Writer_Wait_ms = Writer_Wait_us / 1000;
+        ESP_LOGI(TAG, "Reply %s: first chunk %lu ms, first audio %lu ms, %lu ms played, %lu underruns stretching %lu ms, writers waited %lu ms",
+                 (state == Jitter_Buffer_Drained) ? "done" : "aborted",
+                 Last_Stats.First_Chunk_ms, Last_Stats.First_Audio_ms, Last_Stats.Duration_ms,
+                 Last_Stats.Underruns, Last_Stats.Silence_ms, Last_Stats.Writer_Wait_ms);
+        Active = false;
+        if (!Replacing) {
+            Music_Release();
+        }
+        Busy = false;
+        Post_Event(Voice_Stream_Finished);
+    }
+}
+
+void Voice_Stream_Init(void)
+{
+    uint8_t *data = heap_caps_malloc(Voice_Stream_Buffer_Bytes, MALLOC_CAP_SPIRAM);
+    if (!data || !Jitter_Buffer_Init(&Buffer, data, Voice_Stream_Buffer_Bytes)) {
+        ESP_LOGE(TAG, "Failed to allocate the reply buffer");
+        free(data);
+        return;
+    }
+    Output_Rate = Audio_Stream_Rate();
+    if (audio_resampler_init(&Resampler, 1, Output_Rate) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize the resampler");
+        return;
+    }
+    Events = xQueueCreate(Voice_Stream_Event_Depth, sizeof(Voice_Stream_Event));
+    if (!Events) {
+        ESP_LOGE(TAG, "Failed to create event queue");
+        return;
+    }
+    // Above the player, which is paused while a reply plays, and next to voice capture on core 1
+    if (xTaskCreatePinnedToCore(Voice_Stream_Task, "Voice Stream", 4096, NULL, 4, &Voice_Stream_Task_Handle, 1) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create voice stream task");
+        return;
+    }
+    Initialized = true;
+}
+
+bool Voice_Stream_Begin(uint32_t Rate)
+{
+    if (!Initialized || Rate == 0 || Rate > Voice_Stream_Max_Rate) {
+        return false;
+    }
+    Replacing = true;
+    Voice_Stream_Abort();
+    for (int waited = 0; Busy; waited += Voice_Stream_Block_ms) {
+        if (waited >= 2 * Voice_Stream_Write_Timeout) {
+            ESP_LOGE(TAG, "The last reply did not stop");
+            Replacing = false;
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(Voice_Stream_Block_ms));
+    }
+    Replacing = false;
+    if (!Music_Held) {
+        Music_Held = audio_player_get_state() == AUDIO_PLAYER_STATE_PLAYING;
+    }
+    Music_pause();                                          // The player and the reply share the I2S TX channel
+
+    // The player may have changed the clock for the last track, follow it
+    uint32_t output_rate = Audio_Stream_Rate();
+    if (output_rate != Output_Rate) {
+        audio_resampler_free(&Resampler);
+        if (audio_resampler_init(&Resampler, 1, output_rate) != ESP_OK) {
+            ESP_LOGE(TAG, "Unsupported output rate %lu Hz", output_rate);
+            Music_Release();
+            return false;
+        }
+        Output_Rate = output_rate;
+    }
+    if (audio_resampler_set_input_rate(&Resampler, Rate) != ESP_OK) {
+        ESP_LOGE(TAG, "Unsupported reply rate %lu Hz", Rate);
+        Music_Release();
+        return false;
+    }
+    audio_resampler_reset(&Resampler);
+
+    Stream_Rate = Rate;
+    Block_Samples = Rate * Voice_Stream_Block_ms / 1000;
+    Jitter_Buffer_Reset(&Buffer, Prebuffer_ms * Rate / 1000);
+    Begin_us = esp_timer_get_time();
+    First_Chunk_us = 0;
+    First_Audio_us = 0;
+    Writer_Wait_us = 0;
+    Active = true;                                          // Before Busy, the task takes a Busy reply as started
+    Busy = true;
+    xTaskNotifyGive(Voice_Stream_Task_Handle);
+    return true;
+}
+
+// Waits for room while the reply plays, in Voice_Stream_Block_ms steps, the rate the reader frees it at
+size_t Voice_Stream_Write(const void *Data, size_t Bytes, uint32_t Timeout_ms)
+{
+    size_t total = 0;
+    uint32_t waited = 0;
+    while (Active) {
+        if (!First_Chunk_us && Bytes > 0) {
+            First_Chunk_us = esp_timer_get_time();
+        }
+        size_t n = Jitter_Buffer_Write(&Buffer, (const uint8_t *)Data + total, Bytes - total);
+        total += n;
+        if (n > 0) {
+            xTaskNotifyGive(Voice_Stream_Task_Handle);      // Wakes the task while it waits for the prebuffer
+        }
+        if (total == Bytes || waited >= Timeout_ms) {
+            break;
+        }
+        int64_t start = esp_timer_get_time();
+        vTaskDelay(pdMS_TO_TICKS(Voice_Stream_Block_ms));
+        Writer_Wait_us += esp_timer_get_time() - start;
+        waited += Voice_Stream_Block_ms;
+    }
+    return total;
+}
+
+void Voice_Stream_End(void)
+{
+    if (!Initialized) {
+        return;
+    }
+    Jitter_Buffer_End(&Buffer);
+    xTaskNotifyGive(Voice_Stream_Task_Handle);              // A reply shorter than the prebuffer starts now
+}
+
+// Takes effect when the I2S write in progress returns, at most Voice_Stream_Write_Timeout later
+void Voice_Stream_Abort(void)
+{
+    Active = false;
+}
+
+bool Voice_Stream_Playing(void)
+{
+    return Busy;
+}
+
+void Voice_Stream_Set_Prebuffer(uint32_t ms)
+{
+    Prebuffer_ms = ms;
+}
+
+bool Voice_Stream_Take_Event(Voice_Stream_Event *Event)
+{
+    return Initialized && xQueueReceive(Events, Event, 0) == pdPASS;
+}
+
+void Voice_Stream_Get_Stats(Voice_Stream_Stats *Stats)
+{
+    *Stats = Last_Stats;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Push mode playback of AI replies: the network task appends chunks as they arrive and playback starts once
+// Voice_Stream_Prebuffer_ms is buffered, long before the reply is complete. Late chunks stretch the reply with
+// silence instead of restarting it.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "Jitter_Buffer.h"
+
+#define Voice_Stream_Buffer_Bytes   (256 * 1024)            // PSRAM, 8 s at 16 kHz, the writer waits when it is full
+#define Voice_Stream_Prebuffer_ms   200                     // Default, see host_bench/ for the trade off
+#define Voice_Stream_Block_ms       10                      // Read from the buffer per I2S write
+#define Voice_Stream_Event_Depth    4
+
+typedef enum {
+    Voice_Stream_Speaking,                                  // The first samples of the reply reached I2S
+    Voice_Stream_Finished,                                  // Drained or aborted
+} Voice_Stream_Event;
+
+typedef struct {
+    uint32_t First_Chunk_ms;                                // From Voice_Stream_Begin() to the first byte written
+    uint32_t First_Audio_ms;                                // to the first samples handed to I2S
+    uint32_t Duration_ms;                                   // Reply audio played, without stretched silence
+    uint32_t Underruns;
+    uint32_t Silence_ms;                                    // Stretched into the reply by the underruns
+    uint32_t Writer_Wait_ms;                                // Writers blocked on a full buffer
+} Voice_Stream_Stats;
+
+void Voice_Stream_Init(void);
+bool Voice_Stream_Begin(uint32_t Rate);                     // 16 bit mono, pauses the music until the reply ends, ends any reply playing
+size_t Voice_Stream_Write(const void *Data, size_t Bytes, uint32_t Timeout_ms);  // Bytes taken, any chunk size
+void Voice_Stream_End(void);                                // Everything was written, play out what is left
+void Voice_Stream_Abort(void);                              // Stop now, drop what is buffered
+bool Voice_Stream_Playing(void);
+void Voice_Stream_Set_Prebuffer(uint32_t ms);               // From the next reply
+bool Voice_Stream_Take_Event(Voice_Stream_Event *Event);
+void Voice_Stream_Get_Stats(Voice_Stream_Stats *Stats);     // Of the last reply
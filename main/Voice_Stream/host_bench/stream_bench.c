@@ -0,0 +1,333 @@
+/**
+ * Host bench for reply streaming, tts_server.py stands in for the TTS server.
+ *
+ * Each run requests a reply and appends the chunks to a Jitter_Buffer as they arrive,
+ * the way the network task feeds Voice_Stream_Write(). A second thread stands in for the
+ * I2S output: it waits for the prebuffer, then reads one Voice_Stream_Block_ms block per
+ * block period on a fixed clock, underruns included. Reported per prebuffer setting:
+ *
+ *   first chunk   request to the first byte of audio
+ *   first audio   request to the first block played, the time to first audio
+ *   complete      request to the last byte, when download-then-play could start
+ *   underruns     times playback ran dry, and the silence stretched into the reply
+ *
+ * The played samples are compared with the received ones, so the run fails if the buffer
+ * loses, repeats or reorders anything, odd sized chunks included.
+ *
+ * Run i of -n uses stall seed i, so every prebuffer setting sees the same network.
+ *
+ * usage: stream_bench [-H host] [-P port] [-q query] [-p prebuffer,...] [-n runs]
+ */
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Jitter_Buffer.h"
+
+#define USAGE "usage: %s [-H host] [-P port] [-q query] [-p prebuffer,...] [-n runs]\n"
+
+#define Buffer_Bytes            (256 * 1024)            // Voice_Stream_Buffer_Bytes
+#define Block_ms                10                      // Voice_Stream_Block_ms
+#define Max_Prebuffers          16
+
+static struct {
+    const char *host;
+    const char *port;
+    const char *query;
+    uint32_t prebuffer_ms[Max_Prebuffers];
+    int prebuffers;
+    int runs;
+} opt = { "127.0.0.1", "8765", "", { 0, 100, 200, 400, 800 }, 5, 1 };
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void sleep_until_ms(double t)
+{
+    struct timespec ts = { (time_t)(t / 1e3), (long)((t - (time_t)(t / 1e3) * 1e3) * 1e6) };
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t cap;
+} bytes_t;
+
+static void bytes_append(bytes_t *b, const void *data, size_t len)
+{
+    if(b->len + len > b->cap) {
+        b->cap = (b->len + len) * 2;
+        b->data = realloc(b->data, b->cap);
+    }
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+}
+
+/*-------------------- http --------------------*/
+
+typedef struct {
+    int fd;
+    uint8_t buf[4096];
+    size_t pos;
+    size_t len;
+} conn_t;
+
+static int conn_getc(conn_t *c)
+{
+    if(c->pos == c->len) {
+        ssize_t n = recv(c->fd, c->buf, sizeof(c->buf), 0);
+        if(n <= 0) {
+            return -1;
+        }
+        c->pos = 0;
+        c->len = n;
+    }
+    return c->buf[c->pos++];
+}
+
+static bool conn_line(conn_t *c, char *line, size_t size)
+{
+    size_t n = 0;
+    int ch;
+    while((ch = conn_getc(c)) >= 0 && ch != '\n') {
+        if(ch != '\r' && n + 1 < size) {
+            line[n++] = ch;
+        }
+    }
+    line[n] = 0;
+    return ch == '\n';
+}
+
+// Whatever the connection has buffered of the next up to len bytes, at least one
+static size_t conn_read(conn_t *c, uint8_t *out, size_t len)
+{
+    if(c->pos == c->len) {
+        ssize_t n = recv(c->fd, c->buf, sizeof(c->buf), 0);
+        if(n <= 0) {
+            return 0;
+        }
+        c->pos = 0;
+        c->len = n;
+    }
+    size_t n = c->len - c->pos;
+    if(n > len) {
+        n = len;
+    }
+    memcpy(out, c->buf + c->pos, n);
+    c->pos += n;
+    return n;
+}
+
+static bool http_get(conn_t *c, int seed, uint32_t *rate)
+{
+    struct addrinfo hints = { .ai_family = AF_INET, .ai_socktype = SOCK_STREAM }, *ai;
+    if(getaddrinfo(opt.host, opt.port, &hints, &ai) != 0) {
+        fprintf(stderr, "can't resolve %s\n", opt.host);
+        return false;
+    }
+    c->fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if(c->fd < 0 || connect(c->fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+        fprintf(stderr, "can't connect to %s:%s, is tts_server.py running?\n", opt.host, opt.port);
+        freeaddrinfo(ai);
+        return false;
+    }
+    freeaddrinfo(ai);
+    c->pos = c->len = 0;
+
+    char req[512];
+    int n = snprintf(req, sizeof(req), "GET /reply?%s&seed=%d HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n\r\n",
+                     opt.query, seed, opt.host);
+    if(send(c->fd, req, n, 0) != n) {
+        return false;
+    }
+    char line[256];
+    bool chunked = false;
+    *rate = 0;
+    if(!conn_line(c, line, sizeof(line)) || strncmp(line, "HTTP/1.1 200", 12) != 0) {
+        fprintf(stderr, "server said: %s\n", line);
+        return false;
+    }
+    while(conn_line(c, line, sizeof(line)) && line[0]) {
+        if(strncasecmp(line, "X-Sample-Rate:", 14) == 0) {
+            *rate = strtoul(line + 14, NULL, 10);
+        } else if(strncasecmp(line, "Transfer-Encoding:", 18) == 0 && strstr(line, "chunked")) {
+            chunked = true;
+        }
+    }
+    if(!chunked || *rate == 0) {
+        fprintf(stderr, "expected a chunked reply with X-Sample-Rate\n");
+        return false;
+    }
+    return true;
+}
+
+/*-------------------- output --------------------*/
+
+typedef struct {
+    Jitter_Buffer *buffer;
+    uint32_t rate;
+    double first_audio;         // ms, 0 until played
+    double drained;
+    bytes_t played;
+} output_t;
+
+// Stands in for the Voice Stream task: poll while buffering, one block per period once playing
+static void *output_thread(void *arg)
+{
+    output_t *o = arg;
+    uint32_t count = o->rate * Block_ms / 1000;
+    int16_t *block = malloc(count * sizeof(int16_t));
+    double next = 0;
+    while(1) {
+        uint32_t tail = atomic_load(&o->buffer->Tail);
+        Jitter_Buffer_State state = Jitter_Buffer_Read(o->buffer, block, count);
+        if(state == Jitter_Buffer_Drained) {
+            break;
+        }
+        if(state == Jitter_Buffer_Buffering) {
+            sleep_until_ms(now_ms() + 1);                   // The task is woken by every write
+            continue;
+        }
+        if(o->first_audio == 0) {
+            o->first_audio = next = now_ms();
+        }
+        bytes_append(&o->played, block, (uint32_t)atomic_load(&o->buffer->Tail) - tail);
+        next += Block_ms;
+        sleep_until_ms(next);                               // I2S takes a block per period
+    }
+    o->drained = now_ms();
+    free(block);
+    return NULL;
+}
+
+/*-------------------- run --------------------*/
+
+typedef struct {
+    double first_chunk, first_audio, complete, duration, stretched, played_for;
+    uint32_t underruns;
+    double writer_wait;
+} result_t;
+
+static bool run(uint32_t prebuffer_ms, int seed, result_t *r)
+{
+    static uint8_t storage[Buffer_Bytes];
+    Jitter_Buffer buffer;
+    Jitter_Buffer_Init(&buffer, storage, sizeof(storage));
+    conn_t *c = calloc(1, sizeof(*c));
+    output_t o = { .buffer = &buffer };
+    bytes_t received = { 0 };
+    memset(r, 0, sizeof(*r));
+    bool ok = false;
+    pthread_t thread;
+
+    double start = now_ms();
+    if(!http_get(c, seed, &o.rate)) {
+        goto out;
+    }
+    Jitter_Buffer_Reset(&buffer, prebuffer_ms * o.rate / 1000);
+    pthread_create(&thread, NULL, output_thread, &o);
+
+    char line[64];
+    uint8_t data[2048];
+    while(conn_line(c, line, sizeof(line))) {
+        size_t left = strtoul(line, NULL, 16);
+        if(left == 0) {
+            break;
+        }
+        while(left > 0) {
+            size_t n = conn_read(c, data, left < sizeof(data) ? left : sizeof(data));
+            if(n == 0) {
+                break;
+            }
+            if(r->first_chunk == 0) {
+                r->first_chunk = now_ms() - start;
+            }
+            bytes_append(&received, data, n);
+            left -= n;
+            size_t done = 0;
+            while((done += Jitter_Buffer_Write(&buffer, data + done, n - done)) < n) {
+                double t = now_ms();
+                sleep_until_ms(t + Block_ms);                   // Voice_Stream_Write() waits the same way
+                r->writer_wait += now_ms() - t;
+            }
+        }
+        conn_line(c, line, sizeof(line));                       // CRLF after the chunk data
+    }
+    r->complete = now_ms() - start;
+    Jitter_Buffer_End(&buffer);
+    pthread_join(thread, NULL);
+
+    size_t expected = received.len & ~(size_t)1;
+    ok = o.played.len == expected && memcmp(o.played.data, received.data, expected) == 0;
+    r->first_audio = o.first_audio - start;
+    r->duration = expected / 2 * 1000.0 / o.rate;
+    r->underruns = buffer.Underruns;
+    r->stretched = buffer.Silence * 1000.0 / o.rate;
+    r->played_for = o.drained - o.first_audio;
+    if(!ok) {
+        fprintf(stderr, "played %zu bytes of %zu, %s\n", o.played.len, expected,
+                o.played.len == expected ? "contents differ" : "length differs");
+    }
+out:
+    if(c->fd > 0) {
+        close(c->fd);
+    }
+    free(c);
+    free(received.data);
+    free(o.played.data);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int c;
+    while((c = getopt(argc, argv, "H:P:q:p:n:")) != -1) {
+        switch(c) {
+        case 'H': opt.host = optarg; break;
+        case 'P': opt.port = optarg; break;
+        case 'q': opt.query = optarg; break;
+        case 'p':
+            opt.prebuffers = 0;
+            for(char *s = strtok(optarg, ","); s && opt.prebuffers < Max_Prebuffers; s = strtok(NULL, ",")) {
+                opt.prebuffer_ms[opt.prebuffers++] = atoi(s);
+            }
+            break;
+        case 'n': opt.runs = atoi(optarg); break;
+        default:
+            fprintf(stderr, USAGE, argv[0]);
+            return 2;
+        }
+    }
+
+    bool ok = true;
+    printf("reply %s\n", opt.query[0] ? opt.query : "(server defaults)");
+    printf("prebuffer  first chunk  first audio   complete  underruns  stretched  played for / reply\n");
+    for(int p = 0; p < opt.prebuffers; p++) {
+        for(int i = 0; i < opt.runs; i++) {
+            result_t r;
+            if(!run(opt.prebuffer_ms[p], i + 1, &r)) {
+                ok = false;
+                continue;
+            }
+            printf("%6u ms  %8.0f ms  %8.0f ms  %6.0f ms  %9u  %6.0f ms  %7.0f / %.0f ms%s\n",
+                   (unsigned)opt.prebuffer_ms[p], r.first_chunk, r.first_audio, r.complete, (unsigned)r.underruns,
+                   r.stretched, r.played_for, r.duration, r.writer_wait > 0 ? ", writer waited" : "");
+        }
+    }
+    printf("%s\n", ok ? "ok" : "FAILED: played samples differ from the received ones");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the TTS server, for measuring time to first audio with stream_bench.
+
+    tts_server.py [--port 8765] [--wav reply.wav]
+
+GET /reply streams 16 bit mono little endian PCM with chunked transfer encoding, the
+sample rate in the X-Sample-Rate header. The reply is the --wav file (16 bit mono) or a
+synthetic 6 s one at 16 kHz. Chunks are paced the way a synthesizer produces them, the
+query string sets the model:
+
+    first_ms      synthesis latency before the first chunk            (default 400)
+    rtf           generation speed, multiples of real time            (default 2.0)
+    chunk_ms      audio per chunk                                     (default 120)
+    stall_ms      extra delay of a stalled chunk, every later one     (default 0)
+    stall_p       probability that a chunk stalls                     (default 0.0)
+    odd           1 to send odd sized chunks that split samples       (default 0)
+    seed          for the stalls                                      (default 1)
+
+A stall delays every later chunk too, the way a slow network or synthesizer does.
+"""
+
+import argparse
+import math
+import random
+import struct
+import sys
+import time
+import wave
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+RATE = 16000
+
+
+def synthetic_reply():
+    # Vowel like harmonics in words of 200-500 ms with short pauses, enough to hear gaps
+    rng = random.Random(7)
+    samples = []
+    while len(samples) < 6 * RATE:
+        n = int(rng.uniform(0.2, 0.5) * RATE)
+        f0 = rng.uniform(110, 220)
+        for i in range(n):
+            env = math.sin(math.pi * i / n)
+            v = sum(math.sin(2 * math.pi * f0 * k * i / RATE) / k for k in range(1, 6))
+            samples.append(int(6000 * env * v))
+        samples.extend([0] * int(rng.uniform(0.05, 0.15) * RATE))
+    return RATE, struct.pack('<%dh' % len(samples), *samples)
+
+
+def load_wav(path):
+    with wave.open(path, 'rb') as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2:
+            sys.exit('%s: need 16 bit mono' % path)
+        return w.getframerate(), w.readframes(w.getnframes())
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def log_message(self, fmt, *args):
+        sys.stderr.write('tts_server: ' + fmt % args + '\n')
+
+    def do_GET(self):
+        url = urlparse(self.path)
+        if url.path != '/reply':
+            self.send_error(404)
+            return
+        q = {k: v[-1] for k, v in parse_qs(url.query).items()}
+        first_ms = float(q.get('first_ms', 400))
+        rtf = float(q.get('rtf', 2.0))
+        chunk_ms = float(q.get('chunk_ms', 120))
+        stall_ms = float(q.get('stall_ms', 0))
+        stall_p = float(q.get('stall_p', 0.0))
+        odd = q.get('odd', '0') == '1'
+        rng = random.Random(int(q.get('seed', 1)))
+
+        rate, pcm = self.server.reply
+        chunk = max(2, int(rate * chunk_ms / 1000) * 2) + (1 if odd else 0)
+        self.send_response(200)
+        self.send_header('Content-Type', 'application/octet-stream')
+        self.send_header('Transfer-Encoding', 'chunked')
+        self.send_header('X-Sample-Rate', str(rate))
+        self.end_headers()
+        self.wfile.flush()
+
+        start = time.monotonic()
+        due = first_ms / 1000
+        try:
+            for pos in range(0, len(pcm), chunk):
+                if stall_p and rng.random() < stall_p:
+                    due += stall_ms / 1000
+                delay = start + due - time.monotonic()
+                if delay > 0:
+                    time.sleep(delay)
+                data = pcm[pos:pos + chunk]
+                self.wfile.write(b'%x\r\n' % len(data) + data + b'\r\n')
+                self.wfile.flush()
+                due += len(data) / 2 / rate / rtf
+            self.wfile.write(b'0\r\n\r\n')
+            self.wfile.flush()
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--port', type=int, default=8765)
+    parser.add_argument('--wav')
+    args = parser.parse_args()
+    server = ThreadingHTTPServer(('127.0.0.1', args.port), Handler)
+    server.reply = load_wav(args.wav) if args.wav else synthetic_reply()
+    print('tts_server: %d ms reply at %d Hz on port %d' % (len(server.reply[1]) * 500 // server.reply[0],
+          server.reply[0], args.port), flush=True)
+    server.serve_forever()
+
+
+if __name__ == '__main__':
+    main()
@@ -1,9 +1,6 @@
 #include "Wireless.h"
 #include <ctype.h>
 
-#define WIFI_PROV_NAMESPACE      "wifi_cfg"
-#define WIFI_PROV_KEY_SSID       "ssid"
-#define WIFI_PROV_KEY_PASS       "pass"
 #define WIFI_PROV_AP_SSID        "SmartHome-Setup"
 #define WIFI_PROV_AP_PASS        "12345678"
 #define WIFI_PROV_AP_CHANNEL     1
@@ -41,13 +38,7 @@ static void ip_event_handler(void *arg, esp_event_base_t event_base, int32_t eve
 
 void Wireless_Init(void)
 {
-    esp_err_t ret = nvs_flash_init();
-    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        ret = nvs_flash_init();
-    }
-    ESP_ERROR_CHECK(ret);
-
+    // NVS is up already, Settings_Init() brings it up first thing
     xTaskCreatePinnedToCore(
         WIFI_Init,
         "WIFI task",
@@ -163,36 +154,16 @@ static void wifi_start_sta(const char *ssid, const char *password)
 
 static bool wifi_credentials_load(char *ssid, size_t ssid_len, char *password, size_t pass_len)
 {
-    nvs_handle_t handle;
-    if (nvs_open(WIFI_PROV_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
-        return false;
-    }
-
-    size_t len = ssid_len;
-    esp_err_t err = nvs_get_str(handle, WIFI_PROV_KEY_SSID, ssid, &len);
-    if (err != ESP_OK) {
-        nvs_close(handle);
-        return false;
-    }
-
-    len = pass_len;
-    err = nvs_get_str(handle, WIFI_PROV_KEY_PASS, password, &len);
-    nvs_close(handle);
-    if (err != ESP_OK) {
-        return false;
-    }
+    Settings_Get_String(Setting_Wifi_SSID, ssid, ssid_len);
+    Settings_Get_String(Setting_Wifi_Password, password, pass_len);
     return strlen(ssid) > 0;
 }
 
 static esp_err_t wifi_credentials_save(const char *ssid, const char *password)
 {
-    nvs_handle_t handle;
-    ESP_ERROR_CHECK(nvs_open(WIFI_PROV_NAMESPACE, NVS_READWRITE, &handle));
-    ESP_ERROR_CHECK(nvs_set_str(handle, WIFI_PROV_KEY_SSID, ssid));
-    ESP_ERROR_CHECK(nvs_set_str(handle, WIFI_PROV_KEY_PASS, password));
-    esp_err_t err = nvs_commit(handle);
-    nvs_close(handle);
-    return err;
+    Settings_Set_String(Setting_Wifi_SSID, ssid);
+    Settings_Set_String(Setting_Wifi_Password, password);
+    return Settings_Flush() ? ESP_OK : ESP_FAIL;            // Not debounced, the board may be unplugged right after
 }
 
 static void url_decode(char *dst, const char *src, size_t len)
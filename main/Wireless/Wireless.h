@@ -16,6 +16,7 @@
 #include "esp_bt.h"
 #include "esp_gap_ble_api.h"
 #include "esp_bt_main.h"
+#include "Settings.h"
 
 
 extern uint16_t BLE_NUM;
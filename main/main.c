@@ -7,6 +7,14 @@
 #include "BAT_Driver.h"
 #include "PWR_Key.h"
 #include "PCM5101.h"
+#include "Album_Art.h"
+#include "Media_Library.h"
+#include "Asset_Store.h"
+#include "File_IO.h"
+#include "Data_Logger.h"
+#include "Settings.h"
+#include "Voice_Capture.h"
+#include "Voice_Stream.h"
 #include "smart_ui_data.h"
 void Driver_Loop(void *parameter)
 {
@@ -16,7 +24,9 @@ void Driver_Loop(void *parameter)
         QMI8658_Loop();
         PCF85063_Loop();
         BAT_Get_Volts();
+        Data_Logger_Sample();
         PWR_Loop();
+        Settings_Loop();
         vTaskDelay(pdMS_TO_TICKS(100));
     }
     vTaskDelete(NULL);
@@ -40,11 +50,19 @@ void Driver_Init(void)
 }
 void app_main(void)
 {
+    Settings_Init();
     Driver_Init();
 
     SD_Init();
+    File_IO_Init();
+    Data_Logger_Init();
+    Asset_Store_Init();
     LCD_Init();
     Audio_Init();
+    Media_Library_Init();
+    Album_Art_Init();
+    Voice_Capture_Init();
+    Voice_Stream_Init();
     // Play_Music("/sdcard","AAA.mp3");
     LVGL_Init();   // returns the screen object
 
@@ -59,6 +77,7 @@ void app_main(void)
     while (1) {
         // raise the task priority of LVGL and/or reduce the handler period can improve the performance
         vTaskDelay(pdMS_TO_TICKS(10));
+        LVGL_Frame_Tick();
         // The task running lv_timer_handler should have lower priority than that running `lv_tick_inc`
         lv_timer_handler();
     }